@@ -0,0 +1,144 @@
+/**
+ * @file benchmarks/benchmark_utils.cpp
+ * @brief Utilities shared by benchmarks.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+#include "benchmark_utils.h"
+
+namespace retdec {
+namespace benchmarks {
+
+/**
+ * Get path to the input file given in an environment variable.
+ * @param state Benchmark state, the benchmark is skipped if there is no file
+ * @param path Into this parameter the path is stored
+ * @param envVar Name of the environment variable with the path
+ * @return @c true if path was set, @c false otherwise
+ */
+bool getBenchmarkFile(
+		benchmark::State& state,
+		std::string& path,
+		const char* envVar)
+{
+	const char* envPath = std::getenv(envVar);
+	if (envPath == nullptr || *envPath == '\0')
+	{
+		state.SkipWithError((std::string(envVar) + " is not set").c_str());
+		return false;
+	}
+
+	path = envPath;
+	return true;
+}
+
+/**
+ * Get paths to all the files in a directory given in an environment variable.
+ * Subdirectories are not searched.
+ * @param state Benchmark state, the benchmark is skipped if there is no file
+ * @param paths Into this parameter the sorted paths are stored
+ * @param envVar Name of the environment variable with the directory
+ * @return @c true if at least one path was set, @c false otherwise
+ */
+bool getBenchmarkFiles(
+		benchmark::State& state,
+		std::vector<std::string>& paths,
+		const char* envVar)
+{
+	std::string dir;
+	if (!getBenchmarkFile(state, dir, envVar))
+	{
+		return false;
+	}
+
+	std::error_code ec;
+	for (const auto& entry : std::filesystem::directory_iterator(dir, ec))
+	{
+		if (entry.is_regular_file(ec))
+		{
+			paths.push_back(entry.path().string());
+		}
+	}
+	if (paths.empty())
+	{
+		state.SkipWithError(("no files in " + std::string(envVar)).c_str());
+		return false;
+	}
+
+	std::sort(paths.begin(), paths.end());
+	return true;
+}
+
+/**
+ * Read the whole file into memory, so that benchmarks do not measure the disk.
+ * @param state Benchmark state, the benchmark is skipped if the file cannot
+ *              be read
+ * @param path Path to the file
+ * @param bytes Into this parameter the content of the file is stored
+ * @return @c true if the file was read, @c false otherwise
+ */
+bool readBenchmarkFile(
+		benchmark::State& state,
+		const std::string& path,
+		std::vector<std::uint8_t>& bytes)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		state.SkipWithError(("unable to read " + path).c_str());
+		return false;
+	}
+
+	bytes.assign(
+			std::istreambuf_iterator<char>(file),
+			std::istreambuf_iterator<char>());
+	return true;
+}
+
+/**
+ * Create data of the given size that compress about as well as sections of
+ * executables: short tokens from a small vocabulary are repeated with
+ * a skewed distribution and interleaved with random bytes. The data are the
+ * same in every run.
+ * @param size Size of the data
+ * @return The data
+ */
+std::vector<std::uint8_t> makeCompressibleData(std::size_t size)
+{
+	std::mt19937 gen(0);
+	std::vector<std::vector<std::uint8_t>> tokens(64);
+	for (auto& token : tokens)
+	{
+		token.resize(4 + gen() % 5);
+		for (auto& b : token)
+		{
+			b = static_cast<std::uint8_t>(gen());
+		}
+	}
+
+	std::geometric_distribution<std::size_t> pick(0.1);
+	std::vector<std::uint8_t> data;
+	data.reserve(size + 8);
+	while (data.size() < size)
+	{
+		if (gen() % 10 == 0)
+		{
+			data.push_back(static_cast<std::uint8_t>(gen()));
+			continue;
+		}
+		const auto& token = tokens[pick(gen) % tokens.size()];
+		data.insert(data.end(), token.begin(), token.end());
+	}
+	data.resize(size);
+	return data;
+}
+
+} // namespace benchmarks
+} // namespace retdec
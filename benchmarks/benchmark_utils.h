@@ -0,0 +1,56 @@
+/**
+ * @file benchmarks/benchmark_utils.h
+ * @brief Utilities shared by benchmarks.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef BENCHMARKS_BENCHMARK_UTILS_H
+#define BENCHMARKS_BENCHMARK_UTILS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace retdec {
+namespace benchmarks {
+
+/**
+ * Name of the environment variable holding a path to the input binary used
+ * by benchmarks that need a real file (e.g. a large unstripped executable).
+ */
+constexpr const char* BENCHMARK_FILE_ENV_VAR = "RETDEC_BENCHMARK_FILE";
+
+/**
+ * Name of the environment variable holding a path to the LLVM IR module
+ * (e.g. the @c .ll output of bin2llvmir for a large binary) used by
+ * benchmarks of LLVM IR passes.
+ */
+constexpr const char* BENCHMARK_IR_FILE_ENV_VAR = "RETDEC_BENCHMARK_IR_FILE";
+
+/**
+ * Name of the environment variable holding a path to a directory with input
+ * binaries used by benchmarks that need real files of several kinds (e.g.
+ * one or more executables of every supported file format).
+ */
+constexpr const char* BENCHMARK_DIR_ENV_VAR = "RETDEC_BENCHMARK_DIR";
+
+bool getBenchmarkFile(
+		benchmark::State& state,
+		std::string& path,
+		const char* envVar = BENCHMARK_FILE_ENV_VAR);
+bool getBenchmarkFiles(
+		benchmark::State& state,
+		std::vector<std::string>& paths,
+		const char* envVar = BENCHMARK_DIR_ENV_VAR);
+bool readBenchmarkFile(
+		benchmark::State& state,
+		const std::string& path,
+		std::vector<std::uint8_t>& bytes);
+std::vector<std::uint8_t> makeCompressibleData(std::size_t size);
+
+} // namespace benchmarks
+} // namespace retdec
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * @file benchmarks/bin2llvmir/analyses_benchmarks.cpp
+ * @brief Benchmarks of reaching definitions analysis and symbolic trees.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/InstIterator.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include "benchmark_utils.h"
+#include "retdec/bin2llvmir/analyses/reaching_definitions.h"
+#include "retdec/bin2llvmir/analyses/symbolic_tree.h"
+
+using namespace retdec::bin2llvmir;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/**
+ * Number of global variables standing for registers in generated LLVM IR.
+ */
+const std::size_t REGS = 8;
+
+/**
+ * Create LLVM IR of a function with @a blocks basic blocks in the form
+ * produced by the decoder: register globals are loaded, combined, and stored
+ * back in every block. Blocks are connected by forward conditional branches
+ * and there is a single back edge, so that definitions flow over joins.
+ */
+std::string makeModule(std::size_t blocks)
+{
+	std::ostringstream ir;
+	for (std::size_t r = 0; r < REGS; ++r)
+	{
+		ir << "@r" << r << " = global i32 0\n";
+	}
+	ir << "define i32 @func() {\n";
+	ir << "entry:\n";
+	ir << "  br label %bb0\n";
+	for (std::size_t i = 0; i < blocks; ++i)
+	{
+		const auto a = i % REGS;
+		const auto b = (i + 3) % REGS;
+		const auto c = (i + 5) % REGS;
+		ir << "bb" << i << ":\n";
+		ir << "  %a" << i << " = load i32, i32* @r" << a << "\n";
+		ir << "  %b" << i << " = load i32, i32* @r" << b << "\n";
+		ir << "  %c" << i << " = add i32 %a" << i << ", %b" << i << "\n";
+		ir << "  %d" << i << " = mul i32 %c" << i << ", " << i + 1 << "\n";
+		ir << "  store i32 %d" << i << ", i32* @r" << c << "\n";
+		ir << "  %e" << i << " = xor i32 %d" << i << ", %a" << i << "\n";
+		ir << "  store i32 %e" << i << ", i32* @r" << a << "\n";
+		ir << "  %f" << i << " = icmp slt i32 %e" << i << ", %b" << i << "\n";
+		const auto skip = i + 2 <= blocks ? i + 2 : blocks;
+		ir << "  br i1 %f" << i << ", label %bb" << i + 1
+				<< ", label %bb" << skip << "\n";
+	}
+	ir << "bb" << blocks << ":\n";
+	ir << "  %ret = load i32, i32* @r0\n";
+	ir << "  %cond = icmp eq i32 %ret, 0\n";
+	ir << "  br i1 %cond, label %bb0, label %exit\n";
+	ir << "exit:\n";
+	ir << "  ret i32 %ret\n";
+	ir << "}\n";
+	return ir.str();
+}
+
+/**
+ * Parse LLVM IR of a module with @a blocks basic blocks (see @c makeModule()).
+ */
+std::unique_ptr<llvm::Module> parseModule(
+		llvm::LLVMContext& context,
+		std::size_t blocks)
+{
+	llvm::SMDiagnostic err;
+	return llvm::parseAssemblyString(makeModule(blocks), err, context);
+}
+
+/**
+ * Get value operands of all the stores in the module, i.e. the values
+ * symbolic trees are typically built for.
+ */
+std::vector<llvm::Value*> getStoredValues(llvm::Module& module)
+{
+	std::vector<llvm::Value*> values;
+	for (llvm::Function& f : module)
+	{
+		for (auto& i : llvm::instructions(f))
+		{
+			if (auto* s = llvm::dyn_cast<llvm::StoreInst>(&i))
+			{
+				values.push_back(s->getValueOperand());
+			}
+		}
+	}
+	return values;
+}
+
+} // anonymous namespace
+
+/**
+ * Run reaching definitions analysis on a synthetic function.
+ */
+static void BM_ReachingDefinitionsAnalysis(benchmark::State& state)
+{
+	const auto blocks = static_cast<std::size_t>(state.range(0));
+	llvm::LLVMContext context;
+	auto module = parseModule(context, blocks);
+
+	for (auto _ : state)
+	{
+		ReachingDefinitionsAnalysis rda;
+		benchmark::DoNotOptimize(rda.runOnModule(*module));
+	}
+	state.SetItemsProcessed(state.iterations() * blocks);
+}
+BENCHMARK(BM_ReachingDefinitionsAnalysis)
+	->RangeMultiplier(10)->Range(10, 10000)
+	->Unit(benchmark::kMillisecond);
+
+/**
+ * Load the LLVM IR module from @c RETDEC_BENCHMARK_IR_FILE (ideally the
+ * output of bin2llvmir for a large binary) and run reaching definitions
+ * analysis on it.
+ */
+static void BM_ReachingDefinitionsAnalysisInFile(benchmark::State& state)
+{
+	std::string path;
+	if (!getBenchmarkFile(state, path, BENCHMARK_IR_FILE_ENV_VAR))
+	{
+		return;
+	}
+
+	llvm::LLVMContext context;
+	llvm::SMDiagnostic err;
+	auto module = llvm::parseIRFile(path, err, context);
+	if (!module)
+	{
+		state.SkipWithError("unable to load RETDEC_BENCHMARK_IR_FILE");
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		ReachingDefinitionsAnalysis rda;
+		benchmark::DoNotOptimize(rda.runOnModule(*module));
+	}
+	state.SetItemsProcessed(state.iterations() * module->getInstructionCount());
+}
+BENCHMARK(BM_ReachingDefinitionsAnalysisInFile)
+	->Unit(benchmark::kMillisecond);
+
+/**
+ * Construct symbolic trees of all the stored values in a synthetic function
+ * using a precomputed reaching definitions analysis.
+ */
+static void BM_SymbolicTreePrecomputedRda(benchmark::State& state)
+{
+	const auto blocks = static_cast<std::size_t>(state.range(0));
+	llvm::LLVMContext context;
+	auto module = parseModule(context, blocks);
+	ReachingDefinitionsAnalysis rda;
+	rda.runOnModule(*module);
+	const auto values = getStoredValues(*module);
+
+	for (auto _ : state)
+	{
+		for (auto* v : values)
+		{
+			auto root = SymbolicTree::PrecomputedRda(rda, v);
+			benchmark::DoNotOptimize(root.value);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_SymbolicTreePrecomputedRda)
+	->RangeMultiplier(10)->Range(10, 1000)
+	->Unit(benchmark::kMillisecond);
+
+/**
+ * Construct symbolic trees of all the stored values in a synthetic function
+ * using only linear control flow backtracking.
+ */
+static void BM_SymbolicTreeLinear(benchmark::State& state)
+{
+	const auto blocks = static_cast<std::size_t>(state.range(0));
+	llvm::LLVMContext context;
+	auto module = parseModule(context, blocks);
+	const auto values = getStoredValues(*module);
+
+	for (auto _ : state)
+	{
+		for (auto* v : values)
+		{
+			auto root = SymbolicTree::Linear(v);
+			benchmark::DoNotOptimize(root.value);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * values.size());
+}
+BENCHMARK(BM_SymbolicTreeLinear)
+	->RangeMultiplier(10)->Range(10, 1000)
+	->Unit(benchmark::kMillisecond);
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,150 @@
+/**
+ * @file benchmarks/bin2llvmir/config_benchmarks.cpp
+ * @brief Benchmarks of function lookups in the bin2llvmir config.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include "retdec/bin2llvmir/providers/config.h"
+
+using namespace retdec::bin2llvmir;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/**
+ * Module with @a n functions and a config describing them, the same way as
+ * in the module decoded from a binary with @a n functions.
+ */
+class ConfigWithFunctions
+{
+	public:
+		ConfigWithFunctions(std::size_t n) :
+				module(std::make_unique<llvm::Module>("benchmark", context)),
+				config(Config::empty(module.get()))
+		{
+			auto* type = llvm::FunctionType::get(
+					llvm::Type::getVoidTy(context),
+					false);
+
+			for (std::size_t i = 0; i < n; ++i)
+			{
+				common::Address addr = 0x401000 + i * 0x40;
+				std::string name = "function_" + addr.toHexString();
+
+				functions.push_back(llvm::Function::Create(
+						type,
+						llvm::GlobalValue::ExternalLinkage,
+						name,
+						module.get()));
+				addresses.push_back(addr);
+
+				common::Function cf(name);
+				cf.setStartEnd(addr, addr + 0x40);
+				config.getConfig().functions.insert(cf);
+			}
+		}
+
+	public:
+		llvm::LLVMContext context;
+		std::unique_ptr<llvm::Module> module;
+		Config config;
+		std::vector<llvm::Function*> functions;
+		std::vector<common::Address> addresses;
+};
+
+} // anonymous namespace
+
+/**
+ * Get config functions by their start addresses.
+ */
+static void BM_ConfigGetConfigFunctionByAddress(benchmark::State& state)
+{
+	ConfigWithFunctions c(state.range(0));
+
+	std::size_t i = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(c.config.getConfigFunction(c.addresses[i]));
+		i = (i + 1) % c.addresses.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConfigGetConfigFunctionByAddress)
+	->Arg(1000)->Arg(10000)->Arg(50000);
+
+/**
+ * Get config functions of LLVM functions.
+ */
+static void BM_ConfigGetConfigFunctionByLlvmFunction(benchmark::State& state)
+{
+	ConfigWithFunctions c(state.range(0));
+
+	std::size_t i = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(c.config.getConfigFunction(c.functions[i]));
+		i = (i + 1) % c.functions.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConfigGetConfigFunctionByLlvmFunction)
+	->Arg(1000)->Arg(10000)->Arg(50000);
+
+/**
+ * Get LLVM functions by their start addresses.
+ */
+static void BM_ConfigGetLlvmFunction(benchmark::State& state)
+{
+	ConfigWithFunctions c(state.range(0));
+
+	std::size_t i = 0;
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(c.config.getLlvmFunction(c.addresses[i]));
+		i = (i + 1) % c.addresses.size();
+	}
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ConfigGetLlvmFunction)
+	->Arg(1000)->Arg(10000)->Arg(50000);
+
+/**
+ * Insert functions into config and look each of them up by its start address
+ * right after it is inserted, as the decoder does.
+ */
+static void BM_ConfigInsertAndGetFunction(benchmark::State& state)
+{
+	const auto n = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state)
+	{
+		common::FunctionContainer functions;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			common::Address addr = 0x401000 + i * 0x40;
+			common::Function cf("function_" + addr.toHexString());
+			cf.setStartEnd(addr, addr + 0x40);
+			functions.insert(cf);
+			benchmark::DoNotOptimize(functions.getFunctionByStartAddress(addr));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ConfigInsertAndGetFunction)
+	->Arg(1000)->Arg(10000)->Arg(50000)
+	->Unit(benchmark::kMillisecond);
+
+} // namespace benchmarks
+} // namespace retdec
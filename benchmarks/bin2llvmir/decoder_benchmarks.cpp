@@ -0,0 +1,140 @@
+/**
+ * @file benchmarks/bin2llvmir/decoder_benchmarks.cpp
+ * @brief Benchmarks of register value forwarding done by the decoder.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include "retdec/bin2llvmir/optimizations/decoder/decoder.h"
+#include "retdec/bin2llvmir/providers/abi/abi.h"
+#include "retdec/bin2llvmir/providers/config.h"
+
+using namespace retdec::bin2llvmir;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/**
+ * Create LLVM IR of a function with @a blocks basic blocks in the form
+ * produced by the decoder: every translated instruction loads its operands
+ * from registers and stores its result and flags back. Each block ends with
+ * a call, which stops the forwarding.
+ */
+std::string makeModule(std::size_t blocks)
+{
+	std::ostringstream ir;
+	ir << "@eax = global i32 0\n";
+	ir << "@ebx = global i32 0\n";
+	ir << "@ecx = global i32 0\n";
+	ir << "@zf = global i1 false\n";
+	ir << "@sf = global i1 false\n";
+	ir << "declare void @ext()\n";
+	ir << "define void @func() {\n";
+	ir << "entry:\n";
+	ir << "  br label %bb0\n";
+	for (std::size_t i = 0; i < blocks; ++i)
+	{
+		ir << "bb" << i << ":\n";
+		// add eax, ebx; sub ecx, eax; xor eax, ecx; and ebx, eax
+		const char* insns[][3] = {
+				{"add", "eax", "ebx"},
+				{"sub", "ecx", "eax"},
+				{"xor", "eax", "ecx"},
+				{"and", "ebx", "eax"}};
+		std::size_t j = 0;
+		for (auto& insn : insns)
+		{
+			auto v = "%v" + std::to_string(i) + "_" + std::to_string(j++);
+			ir << "  " << v << "a = load i32, i32* @" << insn[1] << "\n";
+			ir << "  " << v << "b = load i32, i32* @" << insn[2] << "\n";
+			ir << "  " << v << " = " << insn[0] << " i32 "
+					<< v << "a, " << v << "b\n";
+			ir << "  " << v << "z = icmp eq i32 " << v << ", 0\n";
+			ir << "  store i1 " << v << "z, i1* @zf\n";
+			ir << "  " << v << "s = icmp slt i32 " << v << ", 0\n";
+			ir << "  store i1 " << v << "s, i1* @sf\n";
+			ir << "  store i32 " << v << ", i32* @" << insn[1] << "\n";
+		}
+		ir << "  call void @ext()\n";
+		ir << "  br label %bb" << i + 1 << "\n";
+	}
+	ir << "bb" << blocks << ":\n";
+	ir << "  ret void\n";
+	ir << "}\n";
+	return ir.str();
+}
+
+/**
+ * Create ABI for the x86 registers used in the module from makeModule().
+ */
+Abi* addAbi(llvm::Module& module)
+{
+	auto c = config::Config::fromJsonString(R"({
+		"architecture" : {
+			"bitSize" : 32,
+			"endian" : "little",
+			"name" : "x86"
+		}
+	})");
+	auto* config = ConfigProvider::addConfig(&module, c);
+	auto* abi = AbiProvider::addAbi(&module, config);
+	abi->addRegister(X86_REG_EAX, module.getGlobalVariable("eax"));
+	abi->addRegister(X86_REG_EBX, module.getGlobalVariable("ebx"));
+	abi->addRegister(X86_REG_ECX, module.getGlobalVariable("ecx"));
+	abi->addRegister(X86_REG_ZF, module.getGlobalVariable("zf"));
+	abi->addRegister(X86_REG_SF, module.getGlobalVariable("sf"));
+	return abi;
+}
+
+} // anonymous namespace
+
+/**
+ * Forward register values in a synthetic decoded function. Counters show
+ * the number of instructions before and after the forwarding.
+ */
+static void BM_DecoderForwardRegisterValues(benchmark::State& state)
+{
+	const auto blocks = static_cast<std::size_t>(state.range(0));
+	const std::string ir = makeModule(blocks);
+
+	std::size_t before = 0;
+	std::size_t after = 0;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		llvm::LLVMContext context;
+		llvm::SMDiagnostic err;
+		auto module = llvm::parseAssemblyString(ir, err, context);
+		auto* abi = addAbi(*module);
+		Decoder decoder;
+		before = module->getInstructionCount();
+		state.ResumeTiming();
+
+		decoder.forwardRegisterValues(*module, abi);
+
+		state.PauseTiming();
+		after = module->getInstructionCount();
+		AbiProvider::clear();
+		ConfigProvider::clear();
+		module.reset();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * blocks);
+	state.counters["instructionsBefore"] = before;
+	state.counters["instructionsAfter"] = after;
+}
+BENCHMARK(BM_DecoderForwardRegisterValues)->RangeMultiplier(10)->Range(10, 10000);
+
+} // namespace benchmarks
+} // namespace retdec
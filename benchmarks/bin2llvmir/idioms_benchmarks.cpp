@@ -0,0 +1,150 @@
+/**
+ * @file benchmarks/bin2llvmir/idioms_benchmarks.cpp
+ * @brief Benchmarks of instruction idioms analysis.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include "benchmark_utils.h"
+#include "retdec/bin2llvmir/optimizations/idioms/idioms_analysis.h"
+
+using namespace retdec::bin2llvmir;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/**
+ * Create LLVM IR of a function with @a blocks basic blocks. Every block
+ * contains a few ordinary instructions and a few simple idioms.
+ */
+std::string makeFunction(std::size_t blocks)
+{
+	std::ostringstream ir;
+	ir << "define i32 @func(i32 %x, i32 %y) {\n";
+	ir << "entry:\n";
+	ir << "  br label %bb0\n";
+	for (std::size_t i = 0; i < blocks; ++i)
+	{
+		ir << "bb" << i << ":\n";
+		ir << "  %a" << i << " = add i32 %x, " << i << "\n";
+		ir << "  %b" << i << " = mul i32 %a" << i << ", 3\n";
+		ir << "  %c" << i << " = xor i32 %b" << i << ", %y\n";
+		ir << "  %d" << i << " = shl i32 %c" << i << ", 2\n";
+		ir << "  %e" << i << " = lshr i32 %d" << i << ", 4\n";
+		ir << "  %f" << i << " = sub i32 %e" << i << ", %x\n";
+		ir << "  %g" << i << " = or i32 %f" << i << ", %y\n";
+		ir << "  %h" << i << " = icmp slt i32 %g" << i << ", %x\n";
+		ir << "  br i1 %h" << i << ", label %bb" << i + 1
+				<< ", label %bb" << i + 1 << "\n";
+	}
+	ir << "bb" << blocks << ":\n";
+	ir << "  ret i32 %x\n";
+	ir << "}\n";
+	return ir.str();
+}
+
+/**
+ * Run idioms analysis on all functions of the module.
+ */
+std::size_t runIdioms(llvm::Module& module, CC_compiler cc, CC_arch arch)
+{
+	IdiomsAnalysis idioms(&module, cc, arch);
+
+	std::size_t changes = 0;
+	for (llvm::Function& f : module)
+	{
+		if (!f.isDeclaration() && idioms.doAnalysis(f, nullptr))
+		{
+			++changes;
+		}
+	}
+	return changes;
+}
+
+} // anonymous namespace
+
+/**
+ * Run idioms analysis with all idioms enabled on a synthetic function.
+ */
+static void BM_IdiomsAnalysis(benchmark::State& state)
+{
+	const auto blocks = static_cast<std::size_t>(state.range(0));
+	const std::string ir = makeFunction(blocks);
+
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		llvm::LLVMContext context;
+		llvm::SMDiagnostic err;
+		auto module = llvm::parseAssemblyString(ir, err, context);
+		state.ResumeTiming();
+
+		benchmark::DoNotOptimize(runIdioms(*module, CC_ANY, ARCH_ANY));
+
+		state.PauseTiming();
+		module.reset();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * blocks);
+}
+BENCHMARK(BM_IdiomsAnalysis)->RangeMultiplier(10)->Range(10, 10000);
+
+/**
+ * Load the LLVM IR module from @c RETDEC_BENCHMARK_IR_FILE (ideally the
+ * output of bin2llvmir for a large optimized binary) and run idioms analysis
+ * on all of its functions. Arguments are the compiler and the architecture
+ * (see idioms_types.h).
+ */
+static void BM_IdiomsAnalysisInFile(benchmark::State& state)
+{
+	std::string path;
+	if (!getBenchmarkFile(state, path, BENCHMARK_IR_FILE_ENV_VAR))
+	{
+		return;
+	}
+
+	const auto cc = static_cast<CC_compiler>(state.range(0));
+	const auto arch = static_cast<CC_arch>(state.range(1));
+	std::size_t instructions = 0;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		llvm::LLVMContext context;
+		llvm::SMDiagnostic err;
+		auto module = llvm::parseIRFile(path, err, context);
+		if (!module)
+		{
+			state.SkipWithError("unable to load RETDEC_BENCHMARK_IR_FILE");
+			return;
+		}
+		instructions = module->getInstructionCount();
+		state.ResumeTiming();
+
+		benchmark::DoNotOptimize(runIdioms(*module, cc, arch));
+
+		state.PauseTiming();
+		module.reset();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * instructions);
+}
+BENCHMARK(BM_IdiomsAnalysisInFile)
+	->Args({CC_ANY, ARCH_ANY})
+	->Args({CC_VStudio, ARCH_x86})
+	->Args({CC_GCC, ARCH_ARM})
+	->Unit(benchmark::kMillisecond);
+
+} // namespace benchmarks
+} // namespace retdec
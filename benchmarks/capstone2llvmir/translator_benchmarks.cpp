@@ -0,0 +1,193 @@
+/**
+ * @file benchmarks/capstone2llvmir/translator_benchmarks.cpp
+ * @brief Benchmarks of translation of machine code into LLVM IR.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include "retdec/capstone2llvmir/capstone2llvmir.h"
+
+using namespace retdec::capstone2llvmir;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+using TranslatorFactory = std::unique_ptr<Capstone2LlvmIrTranslator> (*)(
+		llvm::Module*,
+		cs_mode);
+
+//
+// Typical function prologues, bodies and epilogues: stack frame set-up,
+// loads, stores, arithmetic, comparisons, and returns.
+//
+
+/// push ebp; mov ebp, esp; sub esp, 0x10; mov eax, [ebp+8]; add eax, ebx;
+/// xor ecx, ecx; cmp eax, ecx; imul eax, ecx; mov [ebp-4], eax; leave; ret
+const std::vector<std::uint8_t> X86_CODE = {
+	0x55, 0x89, 0xe5, 0x83, 0xec, 0x10, 0x8b, 0x45, 0x08, 0x01, 0xd8,
+	0x31, 0xc9, 0x39, 0xc8, 0x0f, 0xaf, 0xc1, 0x89, 0x45, 0xfc, 0xc9,
+	0xc3
+};
+
+/// push rbp; mov rbp, rsp; sub rsp, 0x10; mov rax, [rbp-8]; add rax, rbx;
+/// xor ecx, ecx; cmp rax, rcx; imul rax, rcx; mov [rbp-0x10], rax; leave; ret
+const std::vector<std::uint8_t> X86_64_CODE = {
+	0x55, 0x48, 0x89, 0xe5, 0x48, 0x83, 0xec, 0x10, 0x48, 0x8b, 0x45,
+	0xf8, 0x48, 0x01, 0xd8, 0x31, 0xc9, 0x48, 0x39, 0xc8, 0x48, 0x0f,
+	0xaf, 0xc1, 0x48, 0x89, 0x45, 0xf0, 0xc9, 0xc3
+};
+
+/// push {fp, lr}; add fp, sp, #4; sub sp, sp, #8; add r0, r1, r2;
+/// mul r0, r1, r0; cmp r0, #0; ldr r0, [r1]; str r0, [r2]; pop {fp, pc}
+const std::vector<std::uint8_t> ARM_CODE = {
+	0x00, 0x48, 0x2d, 0xe9, 0x04, 0xb0, 0x8d, 0xe2, 0x08, 0xd0, 0x4d,
+	0xe2, 0x02, 0x00, 0x81, 0xe0, 0x91, 0x00, 0x00, 0xe0, 0x00, 0x00,
+	0x50, 0xe3, 0x00, 0x00, 0x91, 0xe5, 0x00, 0x00, 0x82, 0xe5, 0x00,
+	0x88, 0xbd, 0xe8
+};
+
+/// stp x29, x30, [sp, #-16]!; mov x29, sp; add x0, x1, x2;
+/// mul x0, x1, x2; ldr x0, [x1]; str x0, [x2]; cmp x1, x2;
+/// ldp x29, x30, [sp], #16; ret
+const std::vector<std::uint8_t> ARM64_CODE = {
+	0xfd, 0x7b, 0xbf, 0xa9, 0xfd, 0x03, 0x00, 0x91, 0x20, 0x00, 0x02,
+	0x8b, 0x20, 0x7c, 0x02, 0x9b, 0x20, 0x00, 0x40, 0xf9, 0x40, 0x00,
+	0x00, 0xf9, 0x3f, 0x00, 0x02, 0xeb, 0xfd, 0x7b, 0xc1, 0xa8, 0xc0,
+	0x03, 0x5f, 0xd6
+};
+
+/// addiu sp, sp, -32; sw ra, 28(sp); addu v0, a0, a1; mult a1, a2;
+/// mflo v0; lw v0, 0(a0); sw v0, 4(a0); lw ra, 28(sp); jr ra;
+/// addiu sp, sp, 32 (big endian)
+const std::vector<std::uint8_t> MIPS_CODE = {
+	0x27, 0xbd, 0xff, 0xe0, 0xaf, 0xbf, 0x00, 0x1c, 0x00, 0x85, 0x10,
+	0x21, 0x00, 0xa6, 0x00, 0x18, 0x00, 0x00, 0x10, 0x12, 0x8c, 0x82,
+	0x00, 0x00, 0xac, 0x82, 0x00, 0x04, 0x8f, 0xbf, 0x00, 0x1c, 0x03,
+	0xe0, 0x00, 0x08, 0x27, 0xbd, 0x00, 0x20
+};
+
+/// stwu r1, -16(r1); mflr r0; add r3, r3, r4; mullw r3, r3, r4;
+/// lwz r3, 0(r4); stw r3, 4(r4); cmpw r3, r4; mtlr r0; addi r1, r1, 16;
+/// blr (big endian)
+const std::vector<std::uint8_t> PPC_CODE = {
+	0x94, 0x21, 0xff, 0xf0, 0x7c, 0x08, 0x02, 0xa6, 0x7c, 0x63, 0x22,
+	0x14, 0x7c, 0x63, 0x21, 0xd6, 0x80, 0x64, 0x00, 0x00, 0x90, 0x64,
+	0x00, 0x04, 0x7c, 0x03, 0x20, 0x00, 0x7c, 0x08, 0x03, 0xa6, 0x38,
+	0x21, 0x00, 0x10, 0x4e, 0x80, 0x00, 0x20
+};
+
+/**
+ * Repeat @a code until the result has at least @a size bytes.
+ */
+std::vector<std::uint8_t> repeatCode(
+		const std::vector<std::uint8_t>& code,
+		std::size_t size)
+{
+	std::vector<std::uint8_t> ret;
+	while (ret.size() < size)
+	{
+		ret.insert(ret.end(), code.begin(), code.end());
+	}
+	return ret;
+}
+
+} // anonymous namespace
+
+/**
+ * Translate the given code (repeated up to the given number of bytes)
+ * instruction by instruction into a new function, as the decoder does.
+ */
+static void BM_Capstone2LlvmIrTranslateOne(
+		benchmark::State& state,
+		TranslatorFactory factory,
+		cs_mode mode,
+		const std::vector<std::uint8_t>& code)
+{
+	llvm::LLVMContext context;
+	llvm::Module module("benchmark", context);
+	auto translator = factory(&module, mode);
+	if (!translator)
+	{
+		state.SkipWithError("unable to create the translator");
+		return;
+	}
+
+	const auto bytes = repeatCode(code, state.range(0));
+	auto* type = llvm::FunctionType::get(llvm::Type::getVoidTy(context), false);
+	std::vector<cs_insn*> insns;
+	std::size_t instructions = 0;
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		auto* f = llvm::Function::Create(
+				type,
+				llvm::GlobalValue::ExternalLinkage,
+				"function",
+				&module);
+		llvm::IRBuilder<> irb(llvm::BasicBlock::Create(context, "", f));
+		irb.SetInsertPoint(irb.CreateRetVoid());
+		state.ResumeTiming();
+
+		const std::uint8_t* b = bytes.data();
+		std::size_t size = bytes.size();
+		common::Address addr = 0x1000;
+		while (size > 0)
+		{
+			auto res = translator->translateOne(b, size, addr, irb);
+			if (res.failed())
+			{
+				break;
+			}
+			insns.push_back(res.capstoneInsn);
+		}
+
+		state.PauseTiming();
+		for (auto* i : insns)
+		{
+			cs_free(i, 1);
+		}
+		instructions += insns.size();
+		insns.clear();
+		f->eraseFromParent();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(instructions);
+	state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK_CAPTURE(BM_Capstone2LlvmIrTranslateOne, x86,
+		&Capstone2LlvmIrTranslator::createX86_32,
+		CS_MODE_LITTLE_ENDIAN, X86_CODE)
+	->Arg(4096);
+BENCHMARK_CAPTURE(BM_Capstone2LlvmIrTranslateOne, x86_64,
+		&Capstone2LlvmIrTranslator::createX86_64,
+		CS_MODE_LITTLE_ENDIAN, X86_64_CODE)
+	->Arg(4096);
+BENCHMARK_CAPTURE(BM_Capstone2LlvmIrTranslateOne, arm,
+		&Capstone2LlvmIrTranslator::createArm,
+		CS_MODE_LITTLE_ENDIAN, ARM_CODE)
+	->Arg(4096);
+BENCHMARK_CAPTURE(BM_Capstone2LlvmIrTranslateOne, arm64,
+		&Capstone2LlvmIrTranslator::createArm64,
+		CS_MODE_LITTLE_ENDIAN, ARM64_CODE)
+	->Arg(4096);
+BENCHMARK_CAPTURE(BM_Capstone2LlvmIrTranslateOne, mips,
+		&Capstone2LlvmIrTranslator::createMips32,
+		CS_MODE_BIG_ENDIAN, MIPS_CODE)
+	->Arg(4096);
+BENCHMARK_CAPTURE(BM_Capstone2LlvmIrTranslateOne, powerpc,
+		&Capstone2LlvmIrTranslator::createPpc32,
+		CS_MODE_BIG_ENDIAN, PPC_CODE)
+	->Arg(4096);
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,86 @@
+/**
+ * @file benchmarks/demangler/demangler_benchmarks.cpp
+ * @brief Benchmarks of demangling of symbol names.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "retdec/demangler/borland_demangler.h"
+#include "retdec/demangler/itanium_demangler.h"
+#include "retdec/demangler/microsoft_demangler.h"
+
+using namespace retdec::demangler;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+const std::vector<std::string> ITANIUM_NAMES = {
+	"_Z3fooi",
+	"_ZN5cGram11bagrneplaveEPKN5cName6type_tES3_",
+	"_ZNKSt5dequeIN5cGram7gelem_tESaIS1_EE5beginEv",
+	"_ZNSt6vectorIiSaIiEE9push_backERKi",
+	"_ZNSt8_Rb_treeISsSt4pairIKSsiESt10_Select1stIS2_ESt4lessISsESaIS2_EE"
+		"16_M_insert_uniqueERKS2_",
+};
+
+const std::vector<std::string> MICROSOFT_NAMES = {
+	"?foo@@YAHH@Z",
+	"??_DcGram@@UAEPAXI@Z",
+	"?erase@?$vector@IV?$allocator@I@std@@@std@@QAE?AV?$_Vector_iterator"
+		"@IV?$allocator@I@std@@@2@V32@0@Z",
+	"??1?$map@V?$basic_string@DU?$char_traits@D@std@@V?$allocator@D@2@@std"
+		"@@_NU?$less@V?$basic_string@DU?$char_traits@D@std@@V?$allocator@D"
+		"@2@@std@@@2@V?$allocator@U?$pair@V?$basic_string@DU?$char_traits@D"
+		"@std@@V?$allocator@D@2@@std@@_N@std@@@2@@std@@QAE@XZ",
+};
+
+const std::vector<std::string> BORLAND_NAMES = {
+	"@myFunc_fastcall_$qqrv",
+	"@myFunc_s_$q60std@%basic_string$c19std@%char_traits$c%17std"
+		"@%allocator$c%%t1t1",
+	"@Foo@$bctr$qv",
+};
+
+template <typename D>
+std::unique_ptr<Demangler> createDemangler()
+{
+	return std::make_unique<D>();
+}
+
+} // anonymous namespace
+
+/**
+ * Demangle the given names with the demangler created by @a create.
+ */
+static void BM_Demangle(
+		benchmark::State& state,
+		std::unique_ptr<Demangler> (*create)(),
+		const std::vector<std::string>& names)
+{
+	auto demangler = create();
+
+	for (auto _ : state)
+	{
+		for (const auto& name : names)
+		{
+			benchmark::DoNotOptimize(demangler->demangleToString(name));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * names.size());
+}
+BENCHMARK_CAPTURE(BM_Demangle, itanium,
+		&createDemangler<ItaniumDemangler>, ITANIUM_NAMES);
+BENCHMARK_CAPTURE(BM_Demangle, microsoft,
+		&createDemangler<MicrosoftDemangler>, MICROSOFT_NAMES);
+BENCHMARK_CAPTURE(BM_Demangle, borland,
+		&createDemangler<BorlandDemangler>, BORLAND_NAMES);
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,150 @@
+/**
+ * @file benchmarks/fileformat/file_format_benchmarks.cpp
+ * @brief Benchmarks of loading of files in all supported formats.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_utils.h"
+#include "retdec/fileformat/format_factory.h"
+#include "retdec/fileformat/utils/format_detection.h"
+
+using namespace retdec::fileformat;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/**
+ * Read all the files of format @a format from @c RETDEC_BENCHMARK_DIR.
+ * @return @c true if there is at least one such file, @c false otherwise
+ *         (the benchmark is skipped then).
+ */
+bool readFilesOfFormat(
+		benchmark::State& state,
+		Format format,
+		std::vector<std::vector<std::uint8_t>>& files)
+{
+	std::vector<std::string> paths;
+	if (!getBenchmarkFiles(state, paths))
+	{
+		return false;
+	}
+
+	for (const auto& path : paths)
+	{
+		if (detectFileFormat(path) != format)
+		{
+			continue;
+		}
+
+		std::vector<std::uint8_t> bytes;
+		if (!readBenchmarkFile(state, path, bytes))
+		{
+			return false;
+		}
+		files.push_back(std::move(bytes));
+	}
+
+	if (files.empty())
+	{
+		state.SkipWithError("no file of this format in RETDEC_BENCHMARK_DIR");
+		return false;
+	}
+	return true;
+}
+
+} // anonymous namespace
+
+/**
+ * Load all the files of the given format from @c RETDEC_BENCHMARK_DIR (read
+ * into memory beforehand) with the given load flags.
+ */
+static void BM_FileFormatLoad(
+		benchmark::State& state,
+		Format format,
+		LoadFlags flags)
+{
+	std::vector<std::vector<std::uint8_t>> files;
+	if (!readFilesOfFormat(state, format, files))
+	{
+		return;
+	}
+
+	std::size_t bytes = 0;
+	for (const auto& file : files)
+	{
+		bytes += file.size();
+	}
+
+	for (auto _ : state)
+	{
+		for (const auto& file : files)
+		{
+			auto ff = createFileFormat(file.data(), file.size(), false, flags);
+			benchmark::DoNotOptimize(ff.get());
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * files.size());
+	state.SetBytesProcessed(state.iterations() * bytes);
+}
+BENCHMARK_CAPTURE(BM_FileFormatLoad, pe, Format::PE, LoadFlags::NONE)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FileFormatLoad, pe_no_hashes, Format::PE,
+		LoadFlags::NO_FILE_HASHES)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FileFormatLoad, elf, Format::ELF, LoadFlags::NONE)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FileFormatLoad, elf_no_hashes, Format::ELF,
+		LoadFlags::NO_FILE_HASHES)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FileFormatLoad, macho, Format::MACHO, LoadFlags::NONE)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FileFormatLoad, coff, Format::COFF, LoadFlags::NONE)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_FileFormatLoad, intel_hex, Format::INTEL_HEX,
+		LoadFlags::NONE)
+	->Unit(benchmark::kMillisecond);
+
+/**
+ * Detect the format of all the files from @c RETDEC_BENCHMARK_DIR (read into
+ * memory beforehand).
+ */
+static void BM_FileFormatDetect(benchmark::State& state)
+{
+	std::vector<std::string> paths;
+	if (!getBenchmarkFiles(state, paths))
+	{
+		return;
+	}
+
+	std::vector<std::vector<std::uint8_t>> files;
+	for (const auto& path : paths)
+	{
+		std::vector<std::uint8_t> bytes;
+		if (!readBenchmarkFile(state, path, bytes))
+		{
+			return;
+		}
+		files.push_back(std::move(bytes));
+	}
+
+	for (auto _ : state)
+	{
+		for (const auto& file : files)
+		{
+			benchmark::DoNotOptimize(detectFileFormat(file.data(), file.size()));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * files.size());
+}
+BENCHMARK(BM_FileFormatDetect);
+
+} // namespace benchmarks
+} // namespace retdec
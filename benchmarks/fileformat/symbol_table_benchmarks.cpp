@@ -0,0 +1,166 @@
+/**
+ * @file benchmarks/fileformat/symbol_table_benchmarks.cpp
+ * @brief Benchmarks of symbol, import and export table lookups.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_utils.h"
+#include "retdec/fileformat/format_factory.h"
+#include "retdec/fileformat/types/export_table/export_table.h"
+#include "retdec/fileformat/types/import_table/import_table.h"
+#include "retdec/fileformat/types/symbol_table/symbol_table.h"
+
+using namespace retdec::fileformat;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+std::string makeName(std::size_t i)
+{
+	return "_ZN9namespace5Class8method" + std::to_string(i) + "Ev";
+}
+
+unsigned long long makeAddress(std::size_t i)
+{
+	return 0x400000 + i * 0x10;
+}
+
+} // anonymous namespace
+
+/**
+ * Look up every symbol of a synthetic table by name and by address.
+ */
+static void BM_SymbolTableLookup(benchmark::State& state)
+{
+	const auto n = static_cast<std::size_t>(state.range(0));
+	SymbolTable table;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		auto symbol = std::make_shared<Symbol>();
+		symbol->setName(makeName(i));
+		symbol->setIndex(i);
+		symbol->setAddress(makeAddress(i));
+		table.addSymbol(std::move(symbol));
+	}
+
+	const SymbolTable& cTable = table;
+	for (auto _ : state)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			benchmark::DoNotOptimize(cTable.getSymbol(makeName(i)));
+			benchmark::DoNotOptimize(cTable.getSymbolOnAddress(makeAddress(i)));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_SymbolTableLookup)->RangeMultiplier(10)->Range(100, 100000);
+
+/**
+ * Look up every import of a synthetic table by name and by address.
+ */
+static void BM_ImportTableLookup(benchmark::State& state)
+{
+	const auto n = static_cast<std::size_t>(state.range(0));
+	ImportTable table;
+	table.addLibrary("library.dll");
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		auto import = std::make_unique<Import>();
+		import->setName(makeName(i));
+		import->setAddress(makeAddress(i));
+		table.addImport(std::move(import));
+	}
+
+	for (auto _ : state)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			benchmark::DoNotOptimize(table.getImport(makeName(i)));
+			benchmark::DoNotOptimize(table.getImportOnAddress(makeAddress(i)));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ImportTableLookup)->RangeMultiplier(10)->Range(100, 100000);
+
+/**
+ * Look up every export of a synthetic table by name and by address.
+ */
+static void BM_ExportTableLookup(benchmark::State& state)
+{
+	const auto n = static_cast<std::size_t>(state.range(0));
+	ExportTable table;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		Export exp;
+		exp.setName(makeName(i));
+		exp.setAddress(makeAddress(i));
+		table.addExport(exp);
+	}
+
+	for (auto _ : state)
+	{
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			benchmark::DoNotOptimize(table.getExport(makeName(i)));
+			benchmark::DoNotOptimize(table.getExportOnAddress(makeAddress(i)));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ExportTableLookup)->RangeMultiplier(10)->Range(100, 100000);
+
+/**
+ * Load the binary from @c RETDEC_BENCHMARK_FILE (ideally a large unstripped
+ * executable) and look up all of its symbols by name and by address, the
+ * same way the names provider in bin2llvmir does.
+ */
+static void BM_SymbolTableLookupInFile(benchmark::State& state)
+{
+	std::string path;
+	if (!getBenchmarkFile(state, path))
+	{
+		return;
+	}
+
+	auto file = createFileFormat(path, false, LoadFlags::NO_FILE_HASHES);
+	if (!file || !file->isInValidState())
+	{
+		state.SkipWithError("unable to load RETDEC_BENCHMARK_FILE");
+		return;
+	}
+
+	std::size_t lookups = 0;
+	for (auto _ : state)
+	{
+		lookups = 0;
+		for (const auto* table : file->getSymbolTables())
+		{
+			const SymbolTable& cTable = *table;
+			for (const auto& symbol : cTable)
+			{
+				unsigned long long address = 0;
+				benchmark::DoNotOptimize(cTable.getSymbol(symbol->getName()));
+				if (symbol->getAddress(address))
+				{
+					benchmark::DoNotOptimize(cTable.getSymbolOnAddress(address));
+				}
+				++lookups;
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * lookups);
+}
+BENCHMARK(BM_SymbolTableLookupInFile)->Unit(benchmark::kMillisecond);
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,227 @@
+/**
+ * @file benchmarks/llvmir2hll/optimizer_benchmarks.cpp
+ * @brief Benchmarks of optimizers of the backend IR.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include "retdec/llvmir2hll/analysis/alias_analysis/alias_analyses/simple_alias_analysis.h"
+#include "retdec/llvmir2hll/analysis/value_analysis.h"
+#include "retdec/llvmir2hll/config/configs/json_config.h"
+#include "retdec/llvmir2hll/evaluator/arithm_expr_evaluators/c_arithm_expr_evaluator.h"
+#include "retdec/llvmir2hll/ir/add_op_expr.h"
+#include "retdec/llvmir2hll/ir/assign_stmt.h"
+#include "retdec/llvmir2hll/ir/const_int.h"
+#include "retdec/llvmir2hll/ir/function_builder.h"
+#include "retdec/llvmir2hll/ir/gt_op_expr.h"
+#include "retdec/llvmir2hll/ir/if_stmt.h"
+#include "retdec/llvmir2hll/ir/int_type.h"
+#include "retdec/llvmir2hll/ir/module.h"
+#include "retdec/llvmir2hll/ir/mul_op_expr.h"
+#include "retdec/llvmir2hll/ir/return_stmt.h"
+#include "retdec/llvmir2hll/ir/var_def_stmt.h"
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/llvmir2hll/obtainer/call_info_obtainers/optim_call_info_obtainer.h"
+#include "retdec/llvmir2hll/optimizer/optimizers/copy_propagation_optimizer.h"
+#include "retdec/llvmir2hll/optimizer/optimizers/dead_code_optimizer.h"
+#include "retdec/llvmir2hll/optimizer/optimizers/dead_local_assign_optimizer.h"
+#include "retdec/llvmir2hll/optimizer/optimizers/simple_copy_propagation_optimizer.h"
+#include "retdec/llvmir2hll/optimizer/optimizers/simplify_arithm_expr_optimizer.h"
+#include "retdec/llvmir2hll/optimizer/optimizers/var_def_stmt_optimizer.h"
+#include "retdec/llvmir2hll/semantics/semantics/default_semantics.h"
+
+using namespace retdec::llvmir2hll;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/**
+ * Number of long-living local variables in generated functions.
+ */
+const std::size_t VARS = 8;
+
+/**
+ * Create a module with a single function with @a blocks blocks of
+ * statements in the form produced by the conversion from LLVM IR: every
+ * block computes temporaries from a long-living variable, stores the result
+ * into another one, and conditionally into a global variable, i.e.
+ * @code
+ * t_i = v_(i % 8) + i;
+ * u_i = t_i * 3;
+ * v_((i + 1) % 8) = u_i;
+ * if (u_i > i) {
+ *     g = u_i;
+ * }
+ * @endcode
+ */
+ShPtr<Module> makeModule(const llvm::Module* llvmModule, std::size_t blocks)
+{
+	auto module = std::make_shared<Module>(
+			llvmModule,
+			llvmModule->getModuleIdentifier(),
+			DefaultSemantics::create(),
+			ShPtr<Config>(JSONConfig::empty()));
+
+	auto type = IntType::create(32);
+	auto g = Variable::create("g", type);
+	module->addGlobalVar(g, ConstInt::create(0, 32));
+
+	std::vector<ShPtr<Variable>> vars;
+	for (std::size_t i = 0; i < VARS; ++i)
+	{
+		vars.push_back(Variable::create("v" + std::to_string(i), type));
+	}
+
+	// The body is built from its end.
+	ShPtr<Statement> body = ReturnStmt::create(vars[0]);
+	std::vector<ShPtr<Variable>> temps;
+	for (std::size_t i = blocks; i-- > 0; )
+	{
+		auto t = Variable::create("t" + std::to_string(i), type);
+		auto u = Variable::create("u" + std::to_string(i), type);
+		temps.push_back(t);
+		temps.push_back(u);
+
+		auto c = ConstInt::create(i, 32);
+		body = IfStmt::create(
+				GtOpExpr::create(u, c),
+				AssignStmt::create(g, u),
+				body);
+		body = AssignStmt::create(vars[(i + 1) % VARS], u, body);
+		body = AssignStmt::create(
+				u,
+				MulOpExpr::create(t, ConstInt::create(3, 32)),
+				body);
+		body = AssignStmt::create(
+				t,
+				AddOpExpr::create(vars[i % VARS], c),
+				body);
+	}
+	for (auto& t : temps)
+	{
+		body = VarDefStmt::create(t, nullptr, body);
+	}
+	for (auto& v : vars)
+	{
+		body = VarDefStmt::create(v, ConstInt::create(0, 32), body);
+	}
+
+	FunctionBuilder builder("func");
+	builder.definitionWithBody(body).withRetType(type);
+	for (auto& v : vars)
+	{
+		builder.withLocalVar(v);
+	}
+	for (auto& t : temps)
+	{
+		builder.withLocalVar(t);
+	}
+	module->addFunc(builder.build());
+	return module;
+}
+
+/**
+ * Create a value analysis of @a module.
+ */
+ShPtr<ValueAnalysis> createValueAnalysis(ShPtr<Module> module)
+{
+	auto aliasAnalysis = SimpleAliasAnalysis::create();
+	aliasAnalysis->init(module);
+	return ValueAnalysis::create(aliasAnalysis, true);
+}
+
+void runCopyPropagation(ShPtr<Module> module)
+{
+	Optimizer::optimize<CopyPropagationOptimizer>(module,
+			createValueAnalysis(module), OptimCallInfoObtainer::create());
+}
+
+void runSimpleCopyPropagation(ShPtr<Module> module)
+{
+	Optimizer::optimize<SimpleCopyPropagationOptimizer>(module,
+			createValueAnalysis(module), OptimCallInfoObtainer::create());
+}
+
+void runDeadLocalAssign(ShPtr<Module> module)
+{
+	Optimizer::optimize<DeadLocalAssignOptimizer>(module,
+			createValueAnalysis(module));
+}
+
+void runVarDefStmt(ShPtr<Module> module)
+{
+	Optimizer::optimize<VarDefStmtOptimizer>(module,
+			createValueAnalysis(module));
+}
+
+void runSimplifyArithmExpr(ShPtr<Module> module)
+{
+	Optimizer::optimize<SimplifyArithmExprOptimizer>(module,
+			CArithmExprEvaluator::create());
+}
+
+void runDeadCode(ShPtr<Module> module)
+{
+	Optimizer::optimize<DeadCodeOptimizer>(module,
+			CArithmExprEvaluator::create());
+}
+
+} // anonymous namespace
+
+/**
+ * Run the given optimizer (including the analyses it needs) on a generated
+ * function with the given number of blocks of statements.
+ */
+static void BM_Optimizer(
+		benchmark::State& state,
+		void (*optimize)(ShPtr<Module>))
+{
+	const auto blocks = static_cast<std::size_t>(state.range(0));
+	llvm::LLVMContext context;
+	llvm::Module llvmModule("benchmark", context);
+
+	for (auto _ : state)
+	{
+		// Optimizers modify the module, so a fresh one is needed every time.
+		state.PauseTiming();
+		auto module = makeModule(&llvmModule, blocks);
+		state.ResumeTiming();
+
+		optimize(module);
+
+		state.PauseTiming();
+		module.reset();
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * blocks);
+}
+BENCHMARK_CAPTURE(BM_Optimizer, CopyPropagation, &runCopyPropagation)
+	->RangeMultiplier(10)->Range(10, 1000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Optimizer, SimpleCopyPropagation,
+		&runSimpleCopyPropagation)
+	->RangeMultiplier(10)->Range(10, 1000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Optimizer, DeadLocalAssign, &runDeadLocalAssign)
+	->RangeMultiplier(10)->Range(10, 1000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Optimizer, VarDefStmt, &runVarDefStmt)
+	->RangeMultiplier(10)->Range(10, 1000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Optimizer, SimplifyArithmExpr, &runSimplifyArithmExpr)
+	->RangeMultiplier(10)->Range(10, 1000)
+	->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_Optimizer, DeadCode, &runDeadCode)
+	->RangeMultiplier(10)->Range(10, 1000)
+	->Unit(benchmark::kMillisecond);
+
+} // namespace benchmarks
+} // namespace retdec
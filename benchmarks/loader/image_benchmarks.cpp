@@ -0,0 +1,155 @@
+/**
+ * @file benchmarks/loader/image_benchmarks.cpp
+ * @brief Benchmarks of reads from the loaded image.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_utils.h"
+#include "retdec/loader/image_factory.h"
+
+using namespace retdec::loader;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/**
+ * Load the image of the binary from @c RETDEC_BENCHMARK_FILE.
+ * @return The image, or @c nullptr if it cannot be loaded (the benchmark is
+ *         skipped then).
+ */
+std::unique_ptr<Image> loadImage(benchmark::State& state)
+{
+	std::string path;
+	if (!getBenchmarkFile(state, path))
+	{
+		return nullptr;
+	}
+
+	auto image = createImage(path);
+	if (!image)
+	{
+		state.SkipWithError("unable to load RETDEC_BENCHMARK_FILE");
+	}
+	return image;
+}
+
+} // anonymous namespace
+
+/**
+ * Load the image of the binary from @c RETDEC_BENCHMARK_FILE and read all the
+ * words of all of its segments, as the decoder and data analyses do.
+ */
+static void BM_ImageReadWords(benchmark::State& state)
+{
+	auto image = loadImage(state);
+	if (!image)
+	{
+		return;
+	}
+
+	const auto wordLength = image->getWordLength();
+	std::size_t words = 0;
+	for (auto _ : state)
+	{
+		words = 0;
+		for (const auto& seg : image->getSegments())
+		{
+			for (auto a = seg->getAddress();
+					a + wordLength <= seg->getEndAddress();
+					a += wordLength)
+			{
+				std::uint64_t word = 0;
+				benchmark::DoNotOptimize(image->getWord(a, word));
+				++words;
+			}
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * words);
+}
+BENCHMARK(BM_ImageReadWords)->Unit(benchmark::kMillisecond);
+
+/**
+ * Load the image of the binary from @c RETDEC_BENCHMARK_FILE and read all of
+ * its segments in chunks of the given size.
+ */
+static void BM_ImageReadBytes(benchmark::State& state)
+{
+	auto image = loadImage(state);
+	if (!image)
+	{
+		return;
+	}
+
+	const auto chunk = static_cast<std::uint64_t>(state.range(0));
+	std::vector<std::uint8_t> bytes;
+	std::uint64_t size = 0;
+	for (auto _ : state)
+	{
+		size = 0;
+		for (const auto& seg : image->getSegments())
+		{
+			for (auto a = seg->getAddress();
+					a + chunk <= seg->getEndAddress();
+					a += chunk)
+			{
+				benchmark::DoNotOptimize(image->getXBytes(a, chunk, bytes));
+				size += chunk;
+			}
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_ImageReadBytes)
+	->Arg(16)->Arg(256)->Arg(4096)
+	->Unit(benchmark::kMillisecond);
+
+/**
+ * Load the image of the binary from @c RETDEC_BENCHMARK_FILE and look up the
+ * segments of addresses spread over all of its segments.
+ */
+static void BM_ImageGetSegmentFromAddress(benchmark::State& state)
+{
+	auto image = loadImage(state);
+	if (!image)
+	{
+		return;
+	}
+
+	std::vector<std::uint64_t> addresses;
+	for (const auto& seg : image->getSegments())
+	{
+		const auto step = seg->getSize() / 64 + 1;
+		for (auto a = seg->getAddress(); a < seg->getEndAddress(); a += step)
+		{
+			addresses.push_back(a);
+		}
+	}
+	if (addresses.empty())
+	{
+		state.SkipWithError("RETDEC_BENCHMARK_FILE has no segments");
+		return;
+	}
+
+	const Image& cImage = *image;
+	for (auto _ : state)
+	{
+		for (auto a : addresses)
+		{
+			benchmark::DoNotOptimize(cImage.getSegmentFromAddress(a));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * addresses.size());
+}
+BENCHMARK(BM_ImageGetSegmentFromAddress);
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,179 @@
+/**
+ * @file benchmarks/unpacker/decompression_benchmarks.cpp
+ * @brief Benchmarks of NRV decompression.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmark_utils.h"
+#include "retdec/unpacker/decompression/nrv/bit_parsers.h"
+#include "retdec/unpacker/decompression/nrv/nrv2b_data.h"
+
+using namespace retdec::unpacker;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/**
+ * Simple greedy NRV2B compressor producing the bit stream expected by
+ * @c Nrv2bData with @c BitParser8. It is not as good as the one in UPX, but
+ * the decompressor has to do the same kind of work on its output.
+ */
+class Nrv2bEncoder
+{
+	public:
+		std::vector<std::uint8_t> compress(const std::vector<std::uint8_t>& in)
+		{
+			const std::size_t maxDist = 0x10000;
+			const std::size_t maxLen = 0x100;
+
+			std::unordered_map<std::uint32_t, std::size_t> lastPos;
+			std::size_t lastDist = 1;
+			std::size_t i = 0;
+			while (i < in.size())
+			{
+				std::size_t len = 0;
+				std::size_t dist = 0;
+				if (i + 3 <= in.size())
+				{
+					auto it = lastPos.find(key(in, i));
+					if (it != lastPos.end() && i - it->second <= maxDist)
+					{
+						dist = i - it->second;
+						while (i + len < in.size()
+								&& len < maxLen
+								&& in[i + len] == in[i + len - dist])
+						{
+							++len;
+						}
+					}
+					lastPos[key(in, i)] = i;
+				}
+
+				if (len < 3 + (dist > 0xD00 ? 1 : 0))
+				{
+					putBit(1);
+					_out.push_back(in[i++]);
+					continue;
+				}
+
+				putBit(0);
+				if (dist == lastDist)
+				{
+					putGamma(2);
+				}
+				else
+				{
+					const auto off = dist - 1;
+					putGamma(static_cast<std::uint32_t>((off >> 8) + 3));
+					_out.push_back(static_cast<std::uint8_t>(off & 0xFF));
+					lastDist = dist;
+				}
+
+				const auto count = len - 1 - (dist > 0xD00 ? 1 : 0);
+				if (count <= 3)
+				{
+					putBit((count >> 1) & 1);
+					putBit(count & 1);
+				}
+				else
+				{
+					putBit(0);
+					putBit(0);
+					putGamma(static_cast<std::uint32_t>(count - 2));
+				}
+
+				for (std::size_t j = 1; j < len && i + j + 3 <= in.size(); ++j)
+				{
+					lastPos[key(in, i + j)] = i + j;
+				}
+				i += len;
+			}
+
+			// End of stream.
+			putBit(0);
+			putGamma(0x1000002);
+			_out.push_back(0xFF);
+			return std::move(_out);
+		}
+
+	private:
+		static std::uint32_t key(
+				const std::vector<std::uint8_t>& in,
+				std::size_t i)
+		{
+			return in[i] | (in[i + 1] << 8) | (in[i + 2] << 16);
+		}
+
+		void putBit(unsigned bit)
+		{
+			if (_bitCount == 8)
+			{
+				_bitPos = _out.size();
+				_out.push_back(0);
+				_bitCount = 0;
+			}
+			if (bit)
+			{
+				_out[_bitPos] |= 0x80 >> _bitCount;
+			}
+			++_bitCount;
+		}
+
+		void putGamma(std::uint32_t value)
+		{
+			int top = 31;
+			while (!((value >> top) & 1))
+			{
+				--top;
+			}
+			for (int i = top - 1; i >= 0; --i)
+			{
+				putBit((value >> i) & 1);
+				putBit(i == 0);
+			}
+		}
+
+	private:
+		std::vector<std::uint8_t> _out;
+		std::size_t _bitPos = 0;
+		unsigned _bitCount = 8;
+};
+
+} // anonymous namespace
+
+/**
+ * Decompress NRV2B compressed data of the given (decompressed) size.
+ */
+static void BM_Nrv2bDecompress(benchmark::State& state)
+{
+	const auto data = makeCompressibleData(state.range(0));
+	const DynamicBuffer packed(Nrv2bEncoder().compress(data));
+
+	for (auto _ : state)
+	{
+		BitParser8 bitParser;
+		Nrv2bData nrv(packed, &bitParser);
+		DynamicBuffer unpacked(data.size());
+		if (!nrv.decompress(unpacked))
+		{
+			state.SkipWithError("unable to decompress the data");
+			return;
+		}
+		benchmark::DoNotOptimize(unpacked.getRawBuffer());
+	}
+	state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_Nrv2bDecompress)
+	->RangeMultiplier(16)->Range(1 << 12, 1 << 24)
+	->Unit(benchmark::kMicrosecond);
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,105 @@
+/**
+ * @file benchmarks/unpacker/lzma_benchmarks.cpp
+ * @brief Benchmarks of LZMA decompression.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <lzma.h>
+
+#include "benchmark_utils.h"
+#include "retdec/unpacker/decompression/lzma/lzma_data.h"
+
+using namespace retdec::unpacker;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/**
+ * LZMA properties, the defaults used by UPX and MPRESS.
+ */
+const std::uint32_t LZMA_LC = 3;
+const std::uint32_t LZMA_LP = 0;
+const std::uint32_t LZMA_PB = 2;
+
+/**
+ * Compress the given data into a raw LZMA stream (no header) using liblzma.
+ * @return Compressed data, or an empty vector if the compression failed.
+ */
+std::vector<std::uint8_t> compressLzma(const std::vector<std::uint8_t>& data)
+{
+	lzma_options_lzma options;
+	if (lzma_lzma_preset(&options, LZMA_PRESET_DEFAULT))
+	{
+		return {};
+	}
+	options.lc = LZMA_LC;
+	options.lp = LZMA_LP;
+	options.pb = LZMA_PB;
+
+	lzma_filter filters[] = {
+		{LZMA_FILTER_LZMA1, &options},
+		{LZMA_VLI_UNKNOWN, nullptr}
+	};
+	lzma_stream stream = LZMA_STREAM_INIT;
+	if (lzma_raw_encoder(&stream, filters) != LZMA_OK)
+	{
+		return {};
+	}
+
+	std::vector<std::uint8_t> packed(data.size() + data.size() / 2 + 1024);
+	stream.next_in = data.data();
+	stream.avail_in = data.size();
+	stream.next_out = packed.data();
+	stream.avail_out = packed.size();
+	const auto ret = lzma_code(&stream, LZMA_FINISH);
+	packed.resize(stream.total_out);
+	lzma_end(&stream);
+
+	if (ret != LZMA_STREAM_END)
+	{
+		return {};
+	}
+	return packed;
+}
+
+} // anonymous namespace
+
+/**
+ * Decompress LZMA compressed data of the given (decompressed) size.
+ */
+static void BM_LzmaDecompress(benchmark::State& state)
+{
+	const auto data = makeCompressibleData(state.range(0));
+	const auto packedData = compressLzma(data);
+	if (packedData.empty())
+	{
+		state.SkipWithError("unable to compress the data");
+		return;
+	}
+	const DynamicBuffer packed(packedData);
+
+	for (auto _ : state)
+	{
+		LzmaData lzma(packed, LZMA_PB, LZMA_LP, LZMA_LC);
+		DynamicBuffer unpacked(data.size());
+		if (!lzma.decompress(unpacked))
+		{
+			state.SkipWithError("unable to decompress the data");
+			return;
+		}
+		benchmark::DoNotOptimize(unpacked.getRawBuffer());
+	}
+	state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_LzmaDecompress)
+	->RangeMultiplier(16)->Range(1 << 12, 1 << 24)
+	->Unit(benchmark::kMicrosecond);
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,175 @@
+/**
+ * @file benchmarks/yaracpp/yara_detector_benchmarks.cpp
+ * @brief Benchmarks of YARA rules compilation and scanning.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "retdec/yaracpp/yara_detector.h"
+
+using namespace retdec::yaracpp;
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/**
+ * Size of the scanned buffer.
+ */
+const std::size_t BUFFER_SIZE = 1024 * 1024;
+
+/**
+ * Get a hexadecimal pattern (without the separating spaces) of rule @a i.
+ */
+std::vector<std::uint8_t> makePattern(std::size_t i)
+{
+	std::vector<std::uint8_t> pattern;
+	std::mt19937 gen(static_cast<std::mt19937::result_type>(i));
+	for (std::size_t j = 0; j < 12; ++j)
+	{
+		pattern.push_back(static_cast<std::uint8_t>(gen()));
+	}
+	return pattern;
+}
+
+/**
+ * Create @a count rules in the style of signature databases: every rule has
+ * a hexadecimal string with a wildcard and a jump, a text string, and a
+ * condition combining them.
+ */
+std::string makeRules(std::size_t count)
+{
+	std::ostringstream rules;
+	rules << std::hex << std::setfill('0');
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const auto pattern = makePattern(i);
+		rules << "rule rule_" << std::dec << i << std::hex << "\n";
+		rules << "{\n";
+		rules << "\tmeta:\n";
+		rules << "\t\tdescription = \"synthetic rule " << std::dec << i
+				<< std::hex << "\"\n";
+		rules << "\tstrings:\n";
+		rules << "\t\t$h = {";
+		for (std::size_t j = 0; j < pattern.size(); ++j)
+		{
+			if (j == 4)
+			{
+				rules << " ??";
+				continue;
+			}
+			else if (j == 8)
+			{
+				rules << " [0-4]";
+			}
+			rules << " " << std::setw(2) << unsigned(pattern[j]);
+		}
+		rules << " }\n";
+		rules << "\t\t$s = \"synthetic_string_" << std::dec << i << std::hex
+				<< "\"\n";
+		rules << "\tcondition:\n";
+		rules << "\t\t$h or $s\n";
+		rules << "}\n";
+	}
+	return rules.str();
+}
+
+/**
+ * Create a buffer of random bytes with the patterns of every tenth rule
+ * (see @c makeRules()) planted in it.
+ */
+std::vector<std::uint8_t> makeBuffer(std::size_t rules)
+{
+	std::vector<std::uint8_t> bytes(BUFFER_SIZE);
+	std::mt19937 gen(0);
+	for (auto& b : bytes)
+	{
+		b = static_cast<std::uint8_t>(gen());
+	}
+
+	for (std::size_t i = 0; i < rules; i += 10)
+	{
+		auto pattern = makePattern(i);
+		// The wildcard in the hexadecimal string matches the planted byte
+		// and the jump matches as empty.
+		const auto offset = (i * 7919) % (BUFFER_SIZE - 2 * pattern.size());
+		std::copy(pattern.begin(), pattern.end(), bytes.begin() + offset);
+	}
+	return bytes;
+}
+
+} // anonymous namespace
+
+/**
+ * Compile the given number of rules.
+ */
+static void BM_YaraDetectorCompile(benchmark::State& state)
+{
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const std::string rules = makeRules(count);
+
+	for (auto _ : state)
+	{
+		YaraDetector detector;
+		detector.addRules(rules.c_str());
+		benchmark::DoNotOptimize(detector.compileRules());
+	}
+	state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_YaraDetectorCompile)
+	->RangeMultiplier(10)->Range(10, 1000)
+	->Unit(benchmark::kMillisecond);
+
+/**
+ * Scan an in-memory buffer with the given number of compiled rules.
+ */
+static void BM_YaraDetectorAnalyze(benchmark::State& state)
+{
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const std::string rules = makeRules(count);
+	auto bytes = makeBuffer(count);
+
+	for (auto _ : state)
+	{
+		// Detected rules are accumulated in the detector, so a fresh one
+		// is needed for every scan.
+		state.PauseTiming();
+		auto detector = std::make_unique<YaraDetector>();
+		detector->addRules(rules.c_str());
+		if (!detector->compileRules())
+		{
+			state.SkipWithError("unable to compile the rules");
+			return;
+		}
+		state.ResumeTiming();
+
+		benchmark::DoNotOptimize(detector->analyze(bytes));
+
+		state.PauseTiming();
+		if (detector->getDetectedRules().empty())
+		{
+			state.SkipWithError("no rule was detected");
+			return;
+		}
+		detector.reset();
+		state.ResumeTiming();
+	}
+	state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(BM_YaraDetectorAnalyze)
+	->RangeMultiplier(10)->Range(10, 1000)
+	->Unit(benchmark::kMillisecond);
+
+} // namespace benchmarks
+} // namespace retdec
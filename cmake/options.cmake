@@ -3,6 +3,7 @@
 #
 option(RETDEC_DOC "Build public API documentation (requires Doxygen)." OFF)
 option(RETDEC_TESTS "Build tests." OFF)
+option(RETDEC_BENCHMARKS "Build benchmarks (requires Google Benchmark)." OFF)
 option(RETDEC_DEV_TOOLS "Build dev tools." OFF)
 option(RETDEC_COMPILE_YARA "Compile YARA rules at installation." ON)
 option(RETDEC_MSVC_STATIC_RUNTIME "Use a multi-threaded statically-linked runtime library." OFF)
@@ -19,6 +20,7 @@ option(RETDEC_ENABLE_COMMON "" OFF)
 option(RETDEC_ENABLE_CONFIG "" OFF)
 option(RETDEC_ENABLE_CPDETECT "" OFF)
 option(RETDEC_ENABLE_CTYPES "" OFF)
+option(RETDEC_ENABLE_CTYPESCOMPILERTOOL "" OFF)
 option(RETDEC_ENABLE_CTYPESPARSER "" OFF)
 option(RETDEC_ENABLE_DEBUGFORMAT "" OFF)
 option(RETDEC_ENABLE_DEMANGLER "" OFF)
@@ -76,6 +78,7 @@ foreach(t ${RETDEC_ENABLE})
 	set_if_equal(${t} "config" RETDEC_ENABLE_CONFIG)
 	set_if_equal(${t} "cpdetect" RETDEC_ENABLE_CPDETECT)
 	set_if_equal(${t} "ctypes" RETDEC_ENABLE_CTYPES)
+	set_if_equal(${t} "ctypescompilertool" RETDEC_ENABLE_CTYPESCOMPILERTOOL)
 	set_if_equal(${t} "ctypesparser" RETDEC_ENABLE_CTYPESPARSER)
 	set_if_equal(${t} "debugformat" RETDEC_ENABLE_DEBUGFORMAT)
 	set_if_equal(${t} "demangler" RETDEC_ENABLE_DEMANGLER)
@@ -118,6 +121,7 @@ if (RETDEC_ENABLE_AR_EXTRACTOR
 	OR RETDEC_ENABLE_CONFIG
 	OR RETDEC_ENABLE_CPDETECT
 	OR RETDEC_ENABLE_CTYPES
+	OR RETDEC_ENABLE_CTYPESCOMPILERTOOL
 	OR RETDEC_ENABLE_CTYPESPARSER
 	OR RETDEC_ENABLE_DEBUGFORMAT
 	OR RETDEC_ENABLE_DEMANGLER
@@ -188,6 +192,9 @@ if(RETDEC_DEV_TOOLS)
 			RETDEC_ENABLE_ALL)
 endif()
 
+set_if_at_least_one_set(RETDEC_ENABLE_CTYPESCOMPILERTOOL
+		RETDEC_ENABLE_ALL)
+
 if(RETDEC_DEV_TOOLS)
 	set_if_at_least_one_set(RETDEC_ENABLE_DEMANGLERTOOL
 			RETDEC_ENABLE_ALL)
@@ -287,6 +294,7 @@ set_if_at_least_one_set(RETDEC_ENABLE_DEMANGLER
 set_if_at_least_one_set(RETDEC_ENABLE_CTYPESPARSER
 		RETDEC_ENABLE_ALL
 		RETDEC_ENABLE_BIN2LLVMIR
+		RETDEC_ENABLE_CTYPESCOMPILERTOOL
 		RETDEC_ENABLE_DEMANGLER)
 
 set_if_at_least_one_set(RETDEC_ENABLE_CTYPES
@@ -360,6 +368,7 @@ set_if_at_least_one_set(RETDEC_ENABLE_UTILS
 		RETDEC_ENABLE_CONFIG
 		RETDEC_ENABLE_COMMON
 		RETDEC_ENABLE_CTYPES
+		RETDEC_ENABLE_CTYPESCOMPILERTOOL
 		RETDEC_ENABLE_CTYPESPARSER
 		RETDEC_ENABLE_FILEFORMAT
 		RETDEC_ENABLE_FILEINFO
@@ -391,18 +400,27 @@ set_if_all_set(RETDEC_ENABLE_CAPSTONE2LLVMIR_TESTS
 set_if_all_set(RETDEC_ENABLE_CONFIG_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_CONFIG)
+set_if_all_set(RETDEC_ENABLE_CPDETECT_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_CPDETECT)
 set_if_all_set(RETDEC_ENABLE_CTYPES_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_CTYPES)
 set_if_all_set(RETDEC_ENABLE_CTYPESPARSER_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_CTYPESPARSER)
+set_if_all_set(RETDEC_ENABLE_DEBUGFORMAT_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_DEBUGFORMAT)
 set_if_all_set(RETDEC_ENABLE_DEMANGLER_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_DEMANGLER)
 set_if_all_set(RETDEC_ENABLE_FILEFORMAT_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_FILEFORMAT)
+set_if_all_set(RETDEC_ENABLE_FILEINFO_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_FILEINFO)
 set_if_all_set(RETDEC_ENABLE_LLVMIR_EMUL_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_LLVMIR_EMUL)
@@ -412,6 +430,15 @@ set_if_all_set(RETDEC_ENABLE_LLVMIR2HLL_TESTS
 set_if_all_set(RETDEC_ENABLE_LOADER_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_LOADER)
+set_if_all_set(RETDEC_ENABLE_PAT2YARA_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_PAT2YARA)
+set_if_all_set(RETDEC_ENABLE_RETDEC_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_RETDEC)
+set_if_all_set(RETDEC_ENABLE_RETDEC_DECOMPILER_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_RETDEC_DECOMPILER)
 set_if_all_set(RETDEC_ENABLE_SERDES_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_SERDES)
@@ -424,6 +451,35 @@ set_if_all_set(RETDEC_ENABLE_COMMON_TESTS
 set_if_all_set(RETDEC_ENABLE_UTILS_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_UTILS)
+set_if_all_set(RETDEC_ENABLE_YARACPP_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_YARACPP)
+
+# benchmarks
+set_if_all_set(RETDEC_ENABLE_BIN2LLVMIR_BENCHMARKS
+		RETDEC_BENCHMARKS
+		RETDEC_ENABLE_BIN2LLVMIR)
+set_if_all_set(RETDEC_ENABLE_FILEFORMAT_BENCHMARKS
+		RETDEC_BENCHMARKS
+		RETDEC_ENABLE_FILEFORMAT)
+set_if_all_set(RETDEC_ENABLE_CAPSTONE2LLVMIR_BENCHMARKS
+		RETDEC_BENCHMARKS
+		RETDEC_ENABLE_CAPSTONE2LLVMIR)
+set_if_all_set(RETDEC_ENABLE_DEMANGLER_BENCHMARKS
+		RETDEC_BENCHMARKS
+		RETDEC_ENABLE_DEMANGLER)
+set_if_all_set(RETDEC_ENABLE_LLVMIR2HLL_BENCHMARKS
+		RETDEC_BENCHMARKS
+		RETDEC_ENABLE_LLVMIR2HLL)
+set_if_all_set(RETDEC_ENABLE_LOADER_BENCHMARKS
+		RETDEC_BENCHMARKS
+		RETDEC_ENABLE_LOADER)
+set_if_all_set(RETDEC_ENABLE_UNPACKER_BENCHMARKS
+		RETDEC_BENCHMARKS
+		RETDEC_ENABLE_UNPACKER)
+set_if_all_set(RETDEC_ENABLE_YARACPP_BENCHMARKS
+		RETDEC_BENCHMARKS
+		RETDEC_ENABLE_YARACPP)
 
 # src depending on tests
 set_if_at_least_one_set(RETDEC_ENABLE_LLVMIR_EMUL
@@ -442,16 +498,23 @@ set_if_at_least_one_set(RETDEC_ENABLE_GOOGLETEST
 		RETDEC_ENABLE_CAPSTONE2LLVMIR_TESTS
 		RETDEC_ENABLE_COMMON_TESTS
 		RETDEC_ENABLE_CONFIG_TESTS
+		RETDEC_ENABLE_CPDETECT_TESTS
 		RETDEC_ENABLE_CTYPES_TESTS
 		RETDEC_ENABLE_CTYPESPARSER_TESTS
+		RETDEC_ENABLE_DEBUGFORMAT_TESTS
 		RETDEC_ENABLE_DEMANGLER_TESTS
 		RETDEC_ENABLE_FILEFORMAT_TESTS
+		RETDEC_ENABLE_FILEINFO_TESTS
 		RETDEC_ENABLE_LLVMIR_EMUL_TESTS
 		RETDEC_ENABLE_LLVMIR2HLL_TESTS
 		RETDEC_ENABLE_LOADER_TESTS
+		RETDEC_ENABLE_PAT2YARA_TESTS
+		RETDEC_ENABLE_RETDEC_TESTS
+		RETDEC_ENABLE_RETDEC_DECOMPILER_TESTS
 		RETDEC_ENABLE_SERDES_TESTS
 		RETDEC_ENABLE_UNPACKER_TESTS
-		RETDEC_ENABLE_UTILS_TESTS)
+		RETDEC_ENABLE_UTILS_TESTS
+		RETDEC_ENABLE_YARACPP_TESTS)
 
 set_if_at_least_one_set(RETDEC_ENABLE_KEYSTONE
 		RETDEC_ENABLE_CAPSTONE2LLVMIRTOOL
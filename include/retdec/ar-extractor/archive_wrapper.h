@@ -19,6 +19,15 @@
 namespace retdec {
 namespace ar_extractor {
 
+/**
+ * Object file stored in archive.
+ */
+struct ArchiveObject
+{
+	std::string name;    ///< Name of object (or 'invalid_name').
+	llvm::StringRef data; ///< Content of object in archive buffer.
+};
+
 /**
  * Class for reading archives using llvm::Archive.
  */
@@ -57,6 +66,12 @@ class ArchiveWrapper : private retdec::utils::NonCopyable
 			const std::string &outputPath = "") const;
 		/// @}
 
+		/// @brief In-memory access methods.
+		/// @{
+		bool getObjects(std::vector<ArchiveObject> &result,
+			std::string &errorMessage) const;
+		/// @}
+
 	private:
 		/// LLVM archive parser.
 		std::unique_ptr<llvm::object::Archive> archive;
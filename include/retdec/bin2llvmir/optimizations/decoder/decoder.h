@@ -53,6 +53,12 @@ class Decoder : public llvm::ModulePass
 				NameContainer* n,
 				Abi* a);
 
+	// Register value forwarding, also usable without the decoding.
+	//
+	public:
+		void forwardRegisterValues(llvm::Module& m, Abi* a);
+		bool isForwardableRegister(llvm::Value* reg);
+
 	private:
 		using ByteData = typename std::pair<const std::uint8_t*, std::size_t>;
 
@@ -128,6 +134,7 @@ class Decoder : public llvm::ModulePass
 
 		void resolvePseudoCalls();
 		void finalizePseudoCalls();
+		void forwardRegisterValues();
 
 	// Basic block related methods.
 	//
@@ -8,6 +8,7 @@
 #define RETDEC_BIN2LLVMIR_OPTIMIZATIONS_IDIOMS_IDIOMS_ANALYSIS_H
 
 #include <cstdio>
+#include <vector>
 
 #include <llvm/ADT/Statistic.h>
 #include <llvm/IR/BasicBlock.h>
@@ -43,12 +44,44 @@ public:
 	IdiomsAnalysis(llvm::Module * M, CC_compiler cc, CC_arch arch)
 	{
 		init(M, cc, arch);
+		initBasicBlockIdioms();
 	}
 	virtual bool doAnalysis(llvm::Function & f, llvm::Pass * p) override;
 
 private:
+	/// Instruction idiom exchanger called on a root of the idiom.
+	using Exchanger = llvm::Instruction * (IdiomsAnalysis::*)(llvm::BasicBlock::iterator) const;
+
+	/// Shape of the root instruction of an idiom.
+	enum class IdiomShape {
+		ANY,  ///< Any instruction with the root opcode.
+		BOOL  ///< Instruction with the root opcode producing i1.
+	};
+
+	/**
+	 * @brief Basic-block instruction idiom.
+	 *
+	 * Exchanger of the idiom rejects every instruction which does not have
+	 * the given opcode and shape, so it is called only on such instructions.
+	 */
+	struct BasicBlockIdiom {
+		Exchanger exchanger;
+		unsigned opcode;
+		IdiomShape shape;
+		const char * fname;
+	};
+
+	void initBasicBlockIdioms();
+	void addBasicBlockIdiom(Exchanger exchanger, unsigned opcode,
+		const char * fname, IdiomShape shape = IdiomShape::ANY);
+
 	bool analyse(llvm::Function & f, llvm::Pass * p, int (IdiomsAnalysis::*exchanger)(llvm::Function &, llvm::Pass *) const, const char * fname);
-	bool analyse(llvm::BasicBlock & bb, llvm::Instruction * (IdiomsAnalysis::*exchanger)(llvm::BasicBlock::iterator) const, const char * fname);
+	bool analyse(llvm::BasicBlock & bb);
+	void exchange(llvm::Instruction * insn, llvm::Instruction * res);
+
+	/// Basic-block idioms enabled for the compiler and architecture, in the
+	/// order in which they have to be exchanged.
+	std::vector<BasicBlockIdiom> m_bbIdioms;
 };
 
 } // namespace bin2llvmir
@@ -53,7 +53,18 @@ class ParamReturn : public llvm::ModulePass
 	// Collection of functions.
 	//
 	private:
+		/// Entries whose data are collected from a single function.
+		struct FunctionData
+		{
+			/// Entry of the function itself, if there is one.
+			DataFlowEntry* definition = nullptr;
+			/// Entries of calls in the function, as the entries of the
+			/// called values and indexes of the calls in them.
+			std::vector<std::pair<DataFlowEntry*, std::size_t>> calls;
+		};
+
 		void collectAllCalls();
+		void collectFunctionData(const FunctionData& data) const;
 
 		DataFlowEntry createDataFlowEntry(llvm::Value* calledValue) const;
 
@@ -67,7 +78,7 @@ class ParamReturn : public llvm::ModulePass
 	// Collection of functions usage data.
 	//
 	private:
-		void addDataFromCall(DataFlowEntry *dataflow, llvm::CallInst *call) const;
+		std::size_t addDataFromCall(DataFlowEntry *dataflow, llvm::CallInst *call) const;
 
 	// Optimizations.
 	//
@@ -7,13 +7,16 @@
 #ifndef RETDEC_BIN2LLVMIR_OPTIMIZATIONS_SIMPLE_TYPES_SIMPLE_TYPES_H
 #define RETDEC_BIN2LLVMIR_OPTIMIZATIONS_SIMPLE_TYPES_SIMPLE_TYPES_H
 
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <map>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Module.h>
 #include <llvm/Pass.h>
@@ -29,6 +32,7 @@ class TypeEntry;
 class EquationEntry;
 class EqSet;
 class EqSetContainer;
+class IrModifier;
 
 /**
  * Priority of data type sources.
@@ -144,12 +148,26 @@ class EqSet
 
 		friend std::ostream& operator<<(std::ostream& out, const EqSet& eq);
 
+		static eSourcePriority getPriority(Config* config, llvm::Value* v);
+		static void joinType(
+				llvm::Module* module,
+				TypeEntry& masterType,
+				llvm::Type* t,
+				eSourcePriority p);
+		static void applyType(
+				IrModifier& irModif,
+				Config* config,
+				FileImage* objf,
+				const ValueEntry& vs,
+				const TypeEntry& masterType,
+				std::unordered_set<llvm::Instruction*>& instToErase);
+
 	private:
-		llvm::Type* getHigherPriorityType(
+		static llvm::Type* getHigherPriorityType(
 				llvm::Module* module,
 				llvm::Type* t1,
 				llvm::Type* t2);
-		llvm::Type* getHigherPriorityTypePrivate(
+		static llvm::Type* getHigherPriorityTypePrivate(
 				llvm::Module* module,
 				llvm::Type* t1,
 				llvm::Type* t2,
@@ -190,6 +208,71 @@ class EqSetContainer
 		std::list<EqSet> eqSets;
 };
 
+/**
+ * Equivalence classes of values kept in a disjoint-set forest.
+ *
+ * This is an alternative to @c EqSetContainer. Values get dense IDs, classes
+ * are merged whenever two of their values are found to be equivalent, and
+ * each class keeps only the type it gets (i.e. the join of the types of its
+ * values and of the types added to it), not the sets of all its values and
+ * types.
+ */
+class TypeClasses
+{
+	public:
+		using Id = std::uint32_t;
+
+	public:
+		bool contains(llvm::Value* v) const;
+		Id insert(
+				llvm::Module* module,
+				Config* config,
+				llvm::Value* v,
+				bool* inserted = nullptr);
+		void insert(
+				llvm::Module* module,
+				Id id,
+				llvm::Type* t,
+				eSourcePriority p = eSourcePriority::PRIORITY_NONE);
+		Id find(Id id);
+		void unite(llvm::Module* module, Id id1, Id id2);
+
+		const TypeEntry& getType(Id id);
+		bool isTrivial(Id id);
+		std::size_t size() const;
+		void clear();
+
+		void apply(
+				llvm::Module* module,
+				Config* config,
+				FileImage* objf,
+				std::unordered_set<llvm::Instruction*>& instToErase);
+
+	private:
+		/// State of a class, valid only for the class representative.
+		struct ClassInfo
+		{
+			/// Type of the entire class.
+			TypeEntry type;
+			/// The first type added to the class without a value.
+			llvm::Type* firstType = nullptr;
+			/// Number of values in the class.
+			std::uint32_t values = 0;
+			/// Have different types been added to the class without values?
+			bool moreTypes = false;
+		};
+
+	private:
+		/// Mapping of values to their IDs.
+		llvm::DenseMap<llvm::Value*, Id> ids;
+		/// Values and their priorities, indexed by their IDs.
+		std::vector<ValueEntry> values;
+		/// Parents in the disjoint-set forest, indexed by IDs.
+		std::vector<Id> parents;
+		/// Class states, indexed by IDs of class representatives.
+		std::vector<ClassInfo> classes;
+};
+
 using ValueMap = std::unordered_map<llvm::Value*, EqSet*>;
 using ValuePair = std::pair<llvm::Value*, llvm::Value*>;
 using ValuePairList = std::list<ValuePair>;
@@ -210,12 +293,17 @@ class SimpleTypesAnalysis : public llvm::ModulePass
 		void buildEqSets(llvm::Module& M);
 		void buildEquations();
 		void processRoot(llvm::Value* root);
+		void processRootUnionFind(llvm::Value* root);
 		void processValue(std::queue<llvm::Value*>& toProcess, EqSet& eqSet);
-		void processUse(llvm::Value* c, llvm::Value* x, std::queue<llvm::Value*>& toProcess, EqSet& eqSet);
+		void processUse(llvm::Value* c, llvm::Value* x, std::queue<llvm::Value*>& toProcess, std::vector<TypeEntry>& types);
 		void eraseObsoleteInstructions();
 		void setGlobalConstants();
 
 	private:
+		/// Use @c TypeClasses instead of @c EqSetContainer.
+		bool unionFind = false;
+		TypeClasses typeClasses;
+
 		ValueMap processedObjs;
 		EqSetContainer eqSets;
 		ValuePairList val2PtrVal;
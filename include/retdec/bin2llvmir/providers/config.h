@@ -8,6 +8,7 @@
 #define RETDEC_BIN2LLVMIR_PROVIDERS_CONFIG_H
 
 #include <optional>
+#include <unordered_map>
 
 #include "retdec/config/config.h"
 
@@ -196,6 +197,13 @@ class Config
 
 		std::map<IntrinsicFunctionCreatorPtr, llvm::Function*> _intrinsicFunctions;
 		std::set<llvm::Function*> _pseudoAsmFunctions;
+
+		/// Cache of config functions found for LLVM functions. It is dropped
+		/// whenever a function is erased from the config, renamed LLVM
+		/// functions are detected by comparing names.
+		std::unordered_map<const llvm::Function*, retdec::common::Function*> _llvm2function;
+		/// Erase count of config functions when @c _llvm2function was valid.
+		std::size_t _llvm2functionEraseCount = 0;
 };
 
 class ConfigProvider
@@ -43,7 +43,9 @@ class DebugFormatProvider
 				llvm::Module* m,
 				retdec::loader::Image* objf,
 				const std::string& pdbFile,
-				Demangler* demangler);
+				Demangler* demangler,
+				const retdec::common::AddressRangeContainer& dwarfRanges
+						= retdec::common::AddressRangeContainer());
 
 		static DebugFormat* getDebugFormat(llvm::Module* m);
 		static bool getDebugFormat(llvm::Module* m, DebugFormat*& df);
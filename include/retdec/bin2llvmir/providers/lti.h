@@ -13,6 +13,7 @@
 #include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/fileimage.h"
 #include "retdec/ctypesparser/type_config.h"
+#include "retdec/ctypesparser/type_library.h"
 
 namespace retdec {
 namespace bin2llvmir {
@@ -41,7 +42,20 @@ class Lti
 		llvm::Function* getLlvmFunction(const std::string& name);
 
 	private:
+		/**
+		 * Precompiled type library whose functions are parsed on demand.
+		 */
+		struct LtiLibrary
+		{
+			std::unique_ptr<ctypesparser::TypeLibrary> library;
+			ctypesparser::JSONCTypesParser parser;
+			std::string callConvention;
+		};
+
+	private:
+		void loadLtiFiles(const std::vector<std::string>& filePaths);
 		void loadLtiFile(const std::string& filePath);
+		bool loadLtiLibrary(const std::string& filePath);
 		llvm::Type* getLlvmType(std::shared_ptr<retdec::ctypes::Type> type);
 
 	private:
@@ -51,6 +65,7 @@ class Lti
 		retdec::loader::Image* _image = nullptr;
 		std::unique_ptr<retdec::ctypes::Module> _ltiModule;
 		ctypesparser::JSONCTypesParser _ltiParser;
+		std::vector<LtiLibrary> _ltiLibraries;
 };
 
 class LtiProvider
@@ -8,6 +8,7 @@
 #define RETDEC_BIN2LLVMIR_PROVIDERS_NAMES_H
 
 #include <map>
+#include <memory>
 #include <set>
 
 #include "retdec/bin2llvmir/providers/config.h"
@@ -16,6 +17,7 @@
 #include "retdec/bin2llvmir/providers/fileimage.h"
 #include "retdec/bin2llvmir/providers/lti.h"
 #include "retdec/common/address.h"
+#include "retdec/fileformat/utils/ordinal_database.h"
 
 namespace retdec {
 namespace bin2llvmir {
@@ -178,6 +180,8 @@ class NameContainer
 		std::string getNameFromImportLibAndOrd(
 				const std::string& libName,
 				int ord);
+		std::string getImportOrdsArch() const;
+		const retdec::fileformat::OrdinalDatabase* getOrdinalDatabase();
 		bool loadImportOrds(const std::string& libName);
 
 	private:
@@ -193,6 +197,9 @@ class NameContainer
 		std::map<retdec::common::Address, Names> _data;
 		/// <library name without suffix ".dll", map with ordinals>
 		std::map<std::string, ImportOrdMap> _dllOrds;
+		/// Packed ordinal number database, if there is one.
+		std::unique_ptr<retdec::fileformat::OrdinalDatabase> _ordinalDatabase;
+		bool _ordinalDatabaseLoaded = false;
 };
 
 /**
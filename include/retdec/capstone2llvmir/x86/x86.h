@@ -23,6 +23,20 @@ namespace capstone2llvmir {
 class Capstone2LlvmIrTranslatorX86 : virtual public Capstone2LlvmIrTranslator
 {
 	public:
+		/**
+		 * Should the translator remove status flag (CF, PF, AF, ZF, SF, OF)
+		 * stores that are overwritten before they are read?
+		 * True -> when a flag is stored, the previous store of the same flag
+		 * (and its computation, if not used otherwise) is removed, provided
+		 * that it was generated for a previous instruction in the same basic
+		 * block and that the flag is not read nor any call is made in between.
+		 * False -> all the flag stores are kept.
+		 *
+		 * Default value: false.
+		 */
+		virtual void setLazyFlags(bool f) = 0;
+		virtual bool isLazyFlags() const = 0;
+
 		/**
 		 * Is the passed LLVM function @p f the special pseudo function
 		 * whose call represents a store of fp value to the x87 fpu stack slot?
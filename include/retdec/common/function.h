@@ -7,6 +7,7 @@
 #ifndef RETDEC_COMMON_FUNCTION_H
 #define RETDEC_COMMON_FUNCTION_H
 
+#include <map>
 #include <set>
 #include <string>
 
@@ -205,11 +206,37 @@ struct FunctionAddressCompare
 class FunctionContainer : public std::set<Function, FunctionNameCompare>
 {
 	public:
+		FunctionContainer();
+		FunctionContainer(const FunctionContainer& o);
+		FunctionContainer& operator=(const FunctionContainer& o);
+
 		bool hasFunction(const std::string& name);
 		const Function* getFunctionByName(const std::string& name) const;
 		const Function* getFunctionByStartAddress(
 				const retdec::common::Address& addr) const;
 		const Function* getFunctionByRealName(const std::string& name) const;
+
+		std::size_t getEraseCount() const;
+
+		/// @name Reimplemented base container methods.
+		///
+		/// They need to be reimplemented to modify both underlying container
+		/// and @c _addr2functions map.
+		/// @{
+		std::pair<iterator,bool> insert(const Function& e);
+		std::pair<iterator,bool> insert(iterator, const Function& e);
+		void clear();
+		size_t erase(const Function& val);
+		/// @}
+
+	private:
+		/// Map allows fast function search by start address. Start address
+		/// is not unique, all functions starting on it are kept.
+		std::multimap<retdec::common::Address, const Function*> _addr2functions;
+		/// Number of erase operations (including clear and assignment).
+		/// Pointers to the contained functions stay valid as long as it does
+		/// not change.
+		std::size_t _eraseCount = 0;
 };
 
 // TODO:
@@ -31,6 +31,8 @@ class Parameters
 		bool isKeepAllFunctions() const;
 		bool isSelectedDecodeOnly() const;
 		bool isDetectStaticCode() const;
+		bool isForwardRegisterValues() const;
+		bool isSimpleTypesUnionFind() const;
 		bool isTimeout() const;
 		bool isMaxMemoryLimitHalfRam() const;
 		bool isBackendNoOpts() const;
@@ -59,12 +61,17 @@ class Parameters
 		void setOutputLlvmirFile(const std::string& file);
 		void setOutputConfigFile(const std::string& file);
 		void setOutputUnpackedFile(const std::string& file);
+		void setCheckpointFile(const std::string& file);
+		void setResumeFile(const std::string& file);
 		void setOutputFormat(const std::string& format);
 		void setLogFile(const std::string& file);
 		void setErrFile(const std::string& file);
 		void setMaxMemoryLimit(uint64_t limit);
 		void setIsMaxMemoryLimitHalfRam(bool f);
+		void setMaxThreads(uint64_t threads);
 		void setTimeout(uint64_t seconds);
+		void setLlvmPassesFunctionSizeLimit(uint64_t instructions);
+		void setLlvmPassesFunctionTimeLimit(uint64_t milliseconds);
 		void setEntryPoint(const retdec::common::Address& a);
 		void setMainAddress(const retdec::common::Address& a);
 		void setSectionVMA(const retdec::common::Address& a);
@@ -72,7 +79,11 @@ class Parameters
 		void setBackendEnabledOpts(const std::string& o);
 		void setBackendCallInfoObtainer(const std::string& val);
 		void setBackendVarRenamer(const std::string& val);
+		void setBackendFuncCacheDir(const std::string& dir);
+		void setBackendFuncCacheMaxSize(uint64_t size);
 		void setIsDetectStaticCode(bool b);
+		void setIsForwardRegisterValues(bool b);
+		void setIsSimpleTypesUnionFind(bool b);
 		void setIsBackendNoOpts(bool b);
 		void setIsBackendEmitCfg(bool b);
 		void setIsBackendEmitCg(bool b);
@@ -96,11 +107,16 @@ class Parameters
 		const std::string& getOutputLlvmirFile() const;
 		const std::string& getOutputConfigFile() const;
 		const std::string& getOutputUnpackedFile() const;
+		const std::string& getCheckpointFile() const;
+		const std::string& getResumeFile() const;
 		const std::string& getOutputFormat() const;
 		const std::string& getLogFile() const;
 		const std::string& getErrFile() const;
 		uint64_t getMaxMemoryLimit() const;
+		uint64_t getMaxThreads() const;
 		uint64_t getTimeout() const;
+		uint64_t getLlvmPassesFunctionSizeLimit() const;
+		uint64_t getLlvmPassesFunctionTimeLimit() const;
 		retdec::common::Address getEntryPoint() const;
 		retdec::common::Address getMainAddress() const;
 		retdec::common::Address getSectionVMA() const;
@@ -108,6 +124,8 @@ class Parameters
 		const std::string& getBackendEnabledOpts() const;
 		const std::string& getBackendCallInfoObtainer() const;
 		const std::string& getBackendVarRenamer() const;
+		const std::string& getBackendFuncCacheDir() const;
+		uint64_t getBackendFuncCacheMaxSize() const;
 		/// @}
 
 		void fixRelativePaths(const std::string& configPath);
@@ -161,14 +179,36 @@ class Parameters
 		std::string _outputLlFile;
 		std::string _outputConfigFile;
 		std::string _outputUnpackedFile;
+		/// Store the LLVM module (bitcode) and the config right before the
+		/// conversion of LLVM IR into HLL into this file (and into this file
+		/// with the .config.json suffix).
+		std::string _checkpointFile;
+		/// Do not decode nor optimize the input. Load the LLVM module and
+		/// the config from a checkpoint file and only convert it into HLL.
+		std::string _resumeFile;
 		std::string _outputFormat;
 		std::string _logFile;
 		std::string _errFile;
 		uint64_t _maxMemoryLimit = 0;
 		bool _maxMemoryLimitHalfRam = true;
+		/// Maximal number of threads used by analyses which run in parallel
+		/// (0 means number of CPUs, 1 turns threading off).
+		uint64_t _maxThreads = 0;
 		uint64_t _timeout = 0;
 
+		/// Functions with more instructions are optimized only by a cheap
+		/// subset of LLVM passes (0 means no limit).
+		uint64_t _llvmPassesFunctionSizeLimit = 0;
+		/// Functions whose optimization by a group of LLVM passes takes
+		/// longer (in milliseconds) are optimized only by a cheap subset of
+		/// the remaining LLVM passes (0 means no limit).
+		uint64_t _llvmPassesFunctionTimeLimit = 0;
+
 		bool _detectStaticCode = true;
+		/// Forward register values within basic blocks right after decoding.
+		bool _forwardRegisterValues = false;
+		/// Solve simple types with union-find instead of equivalence sets.
+		bool _simpleTypesUnionFind = false;
 		std::string _backendDisabledOpts;
 		std::string _backendEnabledOpts;
 		std::string _backendCallInfoObtainer = "optim";
@@ -184,6 +224,12 @@ class Parameters
 		bool _backendNoCompoundOperators = false;
 		bool _backendNoSymbolicNames = false;
 
+		/// Directory of the on-disk cache of the emitted output of
+		/// functions. If empty, the cache is not used.
+		std::string _backendFuncCacheDir;
+		/// Maximal size of the cache in bytes (0 means no limit).
+		uint64_t _backendFuncCacheMaxSize = 1024 * 1024 * 1024;
+
 		retdec::common::Address _entryPoint;
 		retdec::common::Address _mainAddress;
 		retdec::common::Address _sectionVMA;
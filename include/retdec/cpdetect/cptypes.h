@@ -12,6 +12,14 @@
 
 #include "retdec/cpdetect/settings.h"
 #include "retdec/fileformat/fftypes.h"
+#include "retdec/fileformat/utils/entropy.h"
+
+namespace retdec {
+namespace yaracpp {
+class YaraRulesCache;
+class YaraScanSession;
+} // namespace yaracpp
+} // namespace retdec
 
 namespace retdec {
 namespace cpdetect {
@@ -115,6 +123,11 @@ struct DetectParams
 
 	std::size_t epBytesCount;
 
+	/// compiled signatures shared by detections of several files (optional)
+	yaracpp::YaraRulesCache *rulesCache = nullptr;
+	/// scan of the file shared with other YARA rule sets (optional)
+	yaracpp::YaraScanSession *scanSession = nullptr;
+
 	DetectParams(
 			SearchType searchType_,
 			bool internal_,
@@ -202,6 +215,9 @@ struct ToolInformation
 	/// length of the file overlay. 0 if no overlay
 	size_t overlaySize = 0;
 
+	/// entropy profile of the file content. Empty if not computed
+	retdec::fileformat::EntropyProfile entropyProfile;
+
 	/// @c false if file has no or invalid EP section
 	bool entryPointSection = false;
 	/// entry point section
@@ -235,6 +251,7 @@ struct ToolInformation
 	/// @{
 	bool isReliableResult(std::size_t resultIndex) const;
 	bool hasReliableResult() const;
+	bool hasPackedEntropyProfile() const;
 	Packed isPacked() const;
 	/// @}
 };
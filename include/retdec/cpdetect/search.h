@@ -7,7 +7,10 @@
 #ifndef RETDEC_CPDETECT_SEARCH_H
 #define RETDEC_CPDETECT_SEARCH_H
 
+#include <string_view>
+
 #include "retdec/cpdetect/cptypes.h"
+#include "retdec/cpdetect/signature_matcher.h"
 #include "retdec/fileformat/file_format/file_format.h"
 
 namespace retdec {
@@ -39,12 +42,21 @@ class Search
 				std::size_t getBytesAfter() const;
 				/// @}
 		};
+
+		/**
+		 * Area of file in which signature is searched
+		 */
+		struct Area
+		{
+			std::size_t startOffset; ///< start offset in file (in bytes)
+			std::size_t stopOffset;  ///< stop offset in file (in bytes)
+		};
 	private:
 		retdec::fileformat::FileFormat &parser;
-		/// content of file in hexadecimal string representation
-		std::string nibbles;
-		/// content of file as plain string
-		std::string plain;
+		/// content of big endian file with bytes of each word swapped
+		std::vector<std::uint8_t> littleEndianBytes;
+		/// matcher of signatures over content of file in little endian
+		SignatureMatcher matcher;
 		/// representation of supported relative jumps
 		std::vector<RelativeJump> jumps;
 		/// average length of one slash representation
@@ -60,6 +72,16 @@ class Search
 		bool haveSlashes() const;
 		std::size_t nibblesFromBytes(std::size_t nBytes) const;
 		std::size_t bytesFromNibbles(std::size_t nNibbles) const;
+		bool getSearchArea(
+				const std::string &signPattern,
+				CompiledSignature::Mode mode,
+				const Area &area,
+				std::size_t &firstNibble,
+				std::size_t &lastNibble) const;
+		std::vector<unsigned long long> findSignatures(
+				const std::vector<std::string> &signPatterns,
+				const std::vector<Area> &areas,
+				CompiledSignature::Mode mode) const;
 		/// @}
 	public:
 		Search(retdec::fileformat::FileFormat &fileParser);
@@ -72,8 +94,8 @@ class Search
 
 		/// @name Getters
 		/// @{
-		const std::string& getNibbles() const;
-		const std::string& getPlainString() const;
+		std::string getNibbles() const;
+		std::string_view getPlainString() const;
 		/// @}
 
 		/// @name Jump methods
@@ -96,6 +118,13 @@ class Search
 				const std::string &signPattern,
 				std::size_t startOffset,
 				std::size_t stopOffset) const;
+		std::vector<unsigned long long> findUnslashedSignatures(
+				const std::vector<std::string> &signPatterns,
+				std::size_t startOffset,
+				std::size_t stopOffset) const;
+		std::vector<unsigned long long> findSlashedSignatures(
+				const std::vector<std::string> &signPatterns,
+				const std::vector<Area> &areas) const;
 		unsigned long long exactComparison(
 				const std::string &signPattern,
 				std::size_t fileOffset,
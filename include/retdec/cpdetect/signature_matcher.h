@@ -0,0 +1,226 @@
+/**
+ * @file include/retdec/cpdetect/signature_matcher.h
+ * @brief Matching of signature patterns against raw bytes.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_CPDETECT_SIGNATURE_MATCHER_H
+#define RETDEC_CPDETECT_SIGNATURE_MATCHER_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "retdec/cpdetect/cptypes.h"
+
+namespace retdec {
+namespace cpdetect {
+
+/**
+ * Signature pattern (see signature.h) compiled for comparison with raw bytes
+ *
+ * Positions in file are expressed in nibbles, the same way as in the
+ * hexadecimal representation of the file. Each run of nibbles between two
+ * slashes is compiled into a chunk of values and masks for both parities of
+ * its starting nibble, so a chunk can be compared with file content byte by
+ * byte even if it does not start on a byte boundary.
+ */
+class CompiledSignature
+{
+	public:
+		/**
+		 * Interpretation of special characters in pattern
+		 */
+		enum class Mode
+		{
+			/// ';' ends the pattern and '/' is a relative jump
+			EXACT,
+			/// ';' is a variable nibble and '/' never matches
+			UNSLASHED
+		};
+
+		/**
+		 * Run of nibbles without relative jumps
+		 */
+		class Chunk
+		{
+			public:
+				/// values of bytes for chunk starting on even/odd nibble
+				std::array<std::vector<std::uint8_t>, 2> values;
+				/// masks of significant bits for chunk starting on
+				/// even/odd nibble
+				std::array<std::vector<std::uint8_t>, 2> masks;
+				/// number of nibbles in chunk
+				std::size_t nibbles = 0;
+				/// number of significant nibbles in chunk
+				std::size_t significant = 0;
+				/// @c false if chunk contains character which never matches
+				bool matchable = true;
+		};
+	private:
+		/// chunks separated by slashes
+		std::vector<Chunk> chunks;
+	public:
+		CompiledSignature(const std::string &pattern, Mode mode);
+
+		/// @name Getters
+		/// @{
+		const std::vector<Chunk>& getChunks() const;
+		std::size_t getNumberOfSlashes() const;
+		bool isMatchable() const;
+		/// @}
+};
+
+/**
+ * Comparison of compiled signatures with content of file
+ */
+class SignatureMatcher
+{
+	public:
+		/**
+		 * Compiled representation of relative jump
+		 */
+		class Jump
+		{
+			public:
+				/// compiled representation of '/' in file
+				CompiledSignature::Chunk slash;
+				/// number of bytes after slash for read
+				std::size_t bytesAfter = 0;
+		};
+	private:
+		/// content of file
+		const std::uint8_t *data = nullptr;
+		/// size of content of file in bytes
+		std::size_t size = 0;
+		/// supported relative jumps
+		std::vector<Jump> jumps;
+		/// average length of one slash representation
+		std::size_t averageSlashLen = 0;
+
+		/// @name Auxiliary methods
+		/// @{
+		bool readJumpOffset(
+				const Jump &jump,
+				std::size_t byteOffset,
+				std::int64_t &value) const;
+		/// @}
+	public:
+		SignatureMatcher() = default;
+		SignatureMatcher(const std::uint8_t *fileData, std::size_t fileSize);
+
+		/// @name Setters
+		/// @{
+		void addJump(const std::string &slash, std::size_t bytesAfter);
+		void setAverageSlashLength(std::size_t length);
+		/// @}
+
+		/// @name Getters
+		/// @{
+		const std::uint8_t* getData() const;
+		std::size_t getSize() const;
+		const std::vector<Jump>& getJumps() const;
+		std::size_t getNumberOfNibbles() const;
+		/// @}
+
+		/// @name Matching methods
+		/// @{
+		bool matchChunk(
+				const CompiledSignature::Chunk &chunk,
+				std::size_t nibbleOffset) const;
+		std::size_t countSameNibbles(
+				const CompiledSignature::Chunk &chunk,
+				std::size_t nibbleOffset) const;
+		const Jump* findJump(
+				std::size_t nibbleOffset,
+				std::size_t byteOffset,
+				std::int64_t &moveSize) const;
+		bool match(
+				const CompiledSignature &signature,
+				std::size_t nibbleOffset) const;
+		bool similarity(
+				const CompiledSignature &signature,
+				std::size_t nibbleOffset,
+				Similarity &sim) const;
+		/// @}
+};
+
+/**
+ * Aho-Corasick automaton for finding of many signatures in one pass
+ *
+ * The longest run of fully specified bytes at the start of each signature
+ * (before its first slash) is used as an anchor. Scanning of file reports
+ * all offsets on which anchors occur. Signatures without anchor are not
+ * reported by scanning and must be compared on each offset separately.
+ */
+class SignatureAutomaton
+{
+	public:
+		/// Callback for possible occurrence of signature. Parameters are
+		/// index of signature and offset of its start in nibbles.
+		using Callback = std::function<void(std::size_t, std::size_t)>;
+	private:
+		/**
+		 * Anchor of one signature
+		 */
+		struct Anchor
+		{
+			/// index of signature
+			std::size_t signature;
+			/// parity of the first nibble of signature
+			std::size_t parity;
+			/// number of bytes between start of signature and end of anchor
+			std::size_t end;
+		};
+
+		/**
+		 * State of automaton
+		 */
+		struct State
+		{
+			/// transitions sorted by byte
+			std::vector<std::pair<std::uint8_t, std::size_t>> next;
+			/// failure transition
+			std::size_t fail = 0;
+			/// anchors ending in this state (including failure states)
+			std::vector<Anchor> anchors;
+		};
+
+		/// states of automaton, the first one is initial
+		std::vector<State> states;
+		/// indexes of matchable signatures without anchor
+		std::vector<std::size_t> unanchored;
+
+		/// @name Auxiliary methods
+		/// @{
+		std::size_t findTransition(std::size_t state, std::uint8_t c) const;
+		void addAnchor(
+				const std::uint8_t *anchor,
+				std::size_t length,
+				const Anchor &info);
+		void buildFailureTransitions();
+		/// @}
+	public:
+		SignatureAutomaton(const std::vector<CompiledSignature> &signatures);
+
+		/// @name Getters
+		/// @{
+		const std::vector<std::size_t>& getUnanchoredSignatures() const;
+		/// @}
+
+		/// @name Search methods
+		/// @{
+		void scan(
+				const std::uint8_t *data,
+				std::size_t startOffset,
+				std::size_t stopOffset,
+				const Callback &callback) const;
+		/// @}
+};
+
+} // namespace cpdetect
+} // namespace retdec
+
+#endif
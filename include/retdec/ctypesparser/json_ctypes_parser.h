@@ -9,11 +9,14 @@
 
 #include <functional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <rapidjson/document.h>
 
 #include "retdec/ctypesparser/ctypes_parser.h"
+#include "retdec/ctypesparser/type_library.h"
 
 namespace retdec {
 namespace ctypesparser {
@@ -36,6 +39,12 @@ class JSONCTypesParser: public CTypesParser
 			std::unique_ptr<retdec::ctypes::Module> &module,
 			const TypeWidths &typeWidths = {},
 			const retdec::ctypes::CallConvention &callConvention = retdec::ctypes::CallConvention());
+		std::shared_ptr<retdec::ctypes::Function> parseFunctionInto(
+			const TypeLibrary &library,
+			const std::string &name,
+			std::unique_ptr<retdec::ctypes::Module> &module,
+			const TypeWidths &typeWidths = {},
+			const retdec::ctypes::CallConvention &callConvention = retdec::ctypes::CallConvention());
 
 	private:
 		std::string loadJson(std::istream &stream) const;
@@ -44,6 +53,8 @@ class JSONCTypesParser: public CTypesParser
 			const std::unique_ptr<rapidjson::Document> &root,
 			std::unique_ptr<retdec::ctypes::Module> &module);
 		void addTypesToMap(const rapidjson::Value &types);
+		const rapidjson::Value &parseLibraryRecord(std::string_view record);
+		const rapidjson::Value &getJsonType(const std::string &typeKey);
 
 		/// @name Parsing methods.
 		/// @{
@@ -137,6 +148,12 @@ class JSONCTypesParser: public CTypesParser
 		/// Map used to store pointers to JSON types (to speedup the parsing).
 		TypesMap typesMap;
 
+		/// Library the types are taken from instead of @c typesMap.
+		const TypeLibrary *typesLibrary = nullptr;
+
+		/// Records from @c typesLibrary needed by the function being parsed.
+		std::vector<std::unique_ptr<rapidjson::Document>> libraryRecords;
+
 		/// Call convention used when JSON does not contain one.
 		retdec::ctypes::CallConvention defaultCallConv;
 };
@@ -0,0 +1,85 @@
+/**
+* @file include/retdec/ctypesparser/type_library.h
+* @brief Precompiled library of C-types.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_CTYPESPARSER_TYPE_LIBRARY_H
+#define RETDEC_CTYPESPARSER_TYPE_LIBRARY_H
+
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace retdec {
+namespace ctypesparser {
+
+/**
+* @brief Precompiled binary form of C-types in JSON.
+*
+* The library contains the same functions and types as the JSON it was
+* compiled from, but each of them is stored as a separate record that can be
+* found by its name through a sorted index. Only the records that are
+* actually needed have to be parsed (see
+* JSONCTypesParser::parseFunctionInto()).
+*
+* Layout of the library (all numbers are 32-bit little-endian, all offsets
+* are from the start of the library, so it may be mapped to memory as it is):
+* @code
+* magic "RDTL", version, function count, type count
+* function index: {name offset, name size, record offset, record size}...
+* type index:     {name offset, name size, record offset, record size}...
+* names and records (minified JSON objects)
+* @endcode
+* Both indexes are sorted by names. If a name occurs more than once in the
+* JSON, only its first occurrence is kept, the same way as by the JSON parser.
+*/
+class TypeLibrary
+{
+	public:
+		/// Extension of files with precompiled type libraries.
+		static const std::string FILE_EXTENSION;
+
+	public:
+		static void compile(std::istream &json, std::ostream &library);
+		static std::unique_ptr<TypeLibrary> fromFile(const std::string &path);
+		static std::unique_ptr<TypeLibrary> fromBuffer(std::string buffer);
+		static std::string getLibraryPath(const std::string &jsonPath);
+
+		std::size_t getFunctionCount() const;
+		std::size_t getTypeCount() const;
+		bool hasFunction(const std::string &name) const;
+		bool getFunction(const std::string &name, std::string_view &record) const;
+		bool getType(const std::string &key, std::string_view &record) const;
+
+	private:
+		explicit TypeLibrary(std::string buffer);
+
+		std::uint32_t readU32(std::size_t offset) const;
+		std::string_view readString(std::size_t offset, std::size_t size) const;
+		std::string_view getName(std::size_t indexOffset, std::size_t i) const;
+		bool find(
+			std::size_t indexOffset,
+			std::size_t count,
+			const std::string &name,
+			std::string_view &record
+		) const;
+
+	private:
+		/// Whole library.
+		std::string data;
+
+		/// Number of functions in the library.
+		std::size_t functionCount = 0;
+
+		/// Number of types in the library.
+		std::size_t typeCount = 0;
+};
+
+} // namespace ctypesparser
+} // namespace retdec
+
+#endif
@@ -14,6 +14,7 @@
 #include <llvm/Support/Format.h>
 #include <llvm/Support/MemoryBuffer.h>
 
+#include "retdec/common/address.h"
 #include "retdec/common/function.h"
 #include "retdec/common/object.h"
 #include "retdec/common/type.h"
@@ -36,11 +37,15 @@ class DebugFormat
 
 	public:
 		DebugFormat();
+		explicit DebugFormat(
+				const retdec::common::AddressRangeContainer& dwarfRanges);
 		DebugFormat(
 				retdec::loader::Image* inFile,
 				const std::string& pdbFile,
 				SymbolTable* symtab,
-				retdec::demangler::Demangler* demangler
+				retdec::demangler::Demangler* demangler,
+				const retdec::common::AddressRangeContainer& dwarfRanges
+						= retdec::common::AddressRangeContainer()
 		);
 
 		retdec::common::Function* getFunction(retdec::common::Address a);
@@ -48,6 +53,30 @@ class DebugFormat
 
 		bool hasInformation() const;
 
+		void loadDwarf(llvm::DWARFContext& context);
+
+	private:
+		/**
+		 * DWARF information extracted from a single compilation unit.
+		 * Units are processed in parallel, each one into its own instance,
+		 * and the results are merged in the order of units.
+		 */
+		struct DwarfUnit
+		{
+			/// Compilation unit.
+			llvm::DWARFUnit* unit = nullptr;
+			/// Line table of the unit, parsed before the extraction.
+			const llvm::DWARFDebugLine::LineTable* lines = nullptr;
+			/// Dwarf named types cache (DIE offset to type).
+			std::map<uint64_t, std::string> dieOff2type;
+			/// Named types defined in the unit.
+			retdec::common::TypeContainer types;
+			/// Functions with their linkage names (demangled on merge).
+			std::vector<std::pair<retdec::common::Function, std::string>> functions;
+			/// Global variables.
+			std::vector<retdec::common::Object> globals;
+		};
+
 	private:
 		void loadPdb();
 		void loadPdbTypes();
@@ -56,14 +85,22 @@ class DebugFormat
 		retdec::common::Type loadPdbType(retdec::pdbparser::PDBTypeDef* type);
 
 		void loadDwarf();
-		void loadDwarf_CU(llvm::DWARFDie die);
-		retdec::common::Function loadDwarf_subprogram(llvm::DWARFDie die);
-		std::string loadDwarf_type(llvm::DWARFDie die);
-		std::string _loadDwarf_type(llvm::DWARFDie die);
+		bool isDwarfUnitSelected(llvm::DWARFDie die) const;
+		void loadDwarf_CU(DwarfUnit& cu, llvm::DWARFDie die) const;
+		void mergeDwarf_CU(DwarfUnit& cu);
+		retdec::common::Function loadDwarf_subprogram(
+				DwarfUnit& cu,
+				llvm::DWARFDie die,
+				std::string& linkageName) const;
+		std::string loadDwarf_type(DwarfUnit& cu, llvm::DWARFDie die) const;
+		std::string _loadDwarf_type(DwarfUnit& cu, llvm::DWARFDie die) const;
 		retdec::common::Object loadDwarf_formal_parameter(
+				DwarfUnit& cu,
 				llvm::DWARFDie die,
-				unsigned argCntr);
-		retdec::common::Object loadDwarf_variable(llvm::DWARFDie die);
+				unsigned argCntr) const;
+		retdec::common::Object loadDwarf_variable(
+				DwarfUnit& cu,
+				llvm::DWARFDie die) const;
 
 		void loadSymtab();
 
@@ -79,8 +116,9 @@ class DebugFormat
 		/// Demangler.
 		retdec::demangler::Demangler* _demangler = nullptr;
 
-		/// Dwarf named types cache.
-		std::map<std::pair<llvm::DWARFUnit*, uint32_t>, std::string> dieOff2type;
+		/// If not empty, only DWARF units and functions overlapping these
+		/// ranges are loaded.
+		retdec::common::AddressRangeContainer _dwarfRanges;
 
 	public:
 		retdec::common::GlobalVarContainer globals;
@@ -70,7 +70,14 @@ enum LoadFlags
 	NONE              = 0,
 	NO_FILE_HASHES    = 1,
 	NO_VERBOSE_HASHES = 2,
-	DETECT_STRINGS    = 4
+	DETECT_STRINGS    = 4,
+	NO_RICH_HEADER    = 8,
+	NO_IMPORTS        = 16,
+	NO_EXPORTS        = 32,
+	NO_RESOURCES      = 64,
+	NO_CERTIFICATES   = 128,
+	NO_DOTNET         = 256,
+	NO_ANOMALIES      = 512
 };
 
 } // namespace fileformat
@@ -19,6 +19,7 @@
 #include "retdec/utils/non_copyable.h"
 #include "retdec/fileformat/fftypes.h"
 #include "retdec/fileformat/utils/byte_array_buffer.h"
+#include "retdec/fileformat/utils/entropy.h"
 
 namespace retdec {
 namespace fileformat {
@@ -94,6 +95,7 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		std::optional<bool> signatureVerified;                            ///< indicates whether the signature is present and also verified
 		retdec::common::RangeContainer<std::uint64_t> nonDecodableRanges;  ///< Address ranges which should not be decoded for instructions.
 		std::vector<std::pair<std::string, std::string>> anomalies;       ///< file format anomalies
+		EntropyProfile entropyProfile;                                    ///< entropy profile of file content with default window size and stride
 
 		/// @name Clear methods
 		/// @{
@@ -103,6 +105,7 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		/// @name Protected detection methods
 		/// @{
 		void computeSectionTableHashes();
+		void computeHashesAndEntropyProfile();
 		/// @}
 
 		/// @name Setters
@@ -203,6 +206,8 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		std::size_t getLoadedFileLength() const;
 		std::size_t getOverlaySize() const;
 		bool getOverlayEntropy(double &res) const;
+		bool getEntropyProfile(EntropyProfile &res, std::size_t windowSize = DEFAULT_ENTROPY_WINDOW_SIZE,
+			std::size_t stride = DEFAULT_ENTROPY_STRIDE) const;
 		std::size_t nibblesFromBytes(std::size_t bytes) const;
 		std::size_t bytesFromNibbles(std::size_t nibbles) const;
 		std::size_t bytesFromNibblesRounded(std::size_t nibbles) const;
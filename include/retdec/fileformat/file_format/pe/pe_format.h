@@ -7,6 +7,9 @@
 #ifndef RETDEC_FILEFORMAT_FILE_FORMAT_PE_PE_FORMAT_H
 #define RETDEC_FILEFORMAT_FILE_FORMAT_PE_PE_FORMAT_H
 
+#include <memory>
+#include <unordered_set>
+
 #include "retdec/fileformat/file_format/file_format.h"
 #include "retdec/fileformat/file_format/pe/pe_format_parser.h"
 #include "retdec/fileformat/types/dotnet_headers/blob_stream.h"
@@ -44,7 +47,7 @@ class PeFormat : public FileFormat
 		std::string typeRefHashSha256;                             ///< .NET typeref table hash as SHA256
 		VisualBasicInfo visualBasicInfo;                           ///< visual basic header information
 
-		std::unordered_set<std::string> dllList;                   ///< Override set of DLLs for checking dependency missing
+		std::shared_ptr<const std::unordered_set<std::string>> dllList; ///< Override set of DLLs for checking dependency missing
 		bool errorLoadingDllList;                                  ///< If true, then an error happened while loading DLL list
 
 		/// @name Initialization methods
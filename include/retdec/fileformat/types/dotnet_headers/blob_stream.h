@@ -7,28 +7,33 @@
 #ifndef RETDEC_FILEFORMAT_TYPES_DOTNET_HEADERS_BLOB_STREAM_H
 #define RETDEC_FILEFORMAT_TYPES_DOTNET_HEADERS_BLOB_STREAM_H
 
-#include <unordered_map>
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringRef.h>
 
 #include "retdec/fileformat/types/dotnet_headers/stream.h"
 
 namespace retdec {
 namespace fileformat {
 
+/**
+ * Blob stream. Elements are not copied out of the file, they are
+ * decoded on demand directly from the content of the stream.
+ */
 class BlobStream : public Stream
 {
 	private:
-		std::unordered_map<std::size_t, std::vector<std::uint8_t>> elements;
+		llvm::StringRef data; ///< content of the stream
 	public:
 		BlobStream(std::uint64_t streamOffset, std::uint64_t streamSize);
 
 		/// @name Getters
 		/// @{
-		std::vector<std::uint8_t> getElement(std::size_t offset) const;
+		llvm::ArrayRef<std::uint8_t> getElement(std::size_t offset) const;
 		/// @}
 
-		/// @name Element methods
+		/// @name Setters
 		/// @{
-		void addElement(std::size_t offset, const std::vector<std::uint8_t>& data);
+		void setData(llvm::StringRef streamData);
 		/// @}
 };
 
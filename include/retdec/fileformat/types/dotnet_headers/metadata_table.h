@@ -7,12 +7,17 @@
 #ifndef RETDEC_FILEFORMAT_TYPES_DOTNET_HEADERS_METADATA_TABLE_H
 #define RETDEC_FILEFORMAT_TYPES_DOTNET_HEADERS_METADATA_TABLE_H
 
+#include <cstdint>
+#include <exception>
 #include <string>
 #include <vector>
 
 namespace retdec {
 namespace fileformat {
 
+class FileFormat;
+class MetadataStream;
+
 enum class MetadataTableType
 {
 	Module = 0,
@@ -81,31 +86,88 @@ class BaseMetadataTable
 		/// @}
 };
 
+class InvalidDotnetRecordError : public std::exception
+{
+public:
+	InvalidDotnetRecordError() noexcept {}
+	InvalidDotnetRecordError(const InvalidDotnetRecordError&) noexcept = default;
+
+	virtual const char* what() const noexcept { return "Invalid .NET record"; }
+};
+
 /**
  * Metadata table representation with rows of generic type.
+ *
+ * Rows are not decoded when the table is parsed. Table only remembers where
+ * its rows are located and every row is decoded on its first access.
  */
 template <typename T>
 class MetadataTable : public BaseMetadataTable
 {
 	private:
-		std::vector<T> rows;
+		enum class RowState : std::uint8_t
+		{
+			NotLoaded,
+			Loaded,
+			Invalid
+		};
+
+		const FileFormat* file = nullptr;          ///< file rows are decoded from
+		const MetadataStream* stream = nullptr;    ///< stream with sizes of indexes
+		std::uint64_t address = 0;                 ///< address of the first row
+		std::uint64_t rowSize = 0;                 ///< size of one row in bytes
+		std::size_t numberOfRows = 0;              ///< number of rows present in the file
+		mutable std::vector<T> rows;               ///< cache of decoded rows
+		mutable std::vector<RowState> rowStates;   ///< decoding state of rows in cache
 	public:
 		MetadataTable(MetadataTableType tableType, std::uint32_t tableSize) : BaseMetadataTable(tableType, tableSize) {}
 
 		/// @name Getters
 		/// @{
-		std::size_t getNumberOfRows() const { return rows.size(); }
-		const T* getRow(std::size_t index) const { return index - 1 >= rows.size() ? nullptr : &rows[index - 1]; }
-		auto begin() const { return rows.begin(); }
-		auto end() const { return rows.end(); }
+		std::size_t getNumberOfRows() const { return numberOfRows; }
+		std::uint64_t getRowSize() const { return rowSize; }
+		const T* getRow(std::size_t index) const
+		{
+			if (index == 0 || index > numberOfRows)
+				return nullptr;
+
+			if (rows.empty())
+			{
+				rows.resize(numberOfRows);
+				rowStates.assign(numberOfRows, RowState::NotLoaded);
+			}
+
+			auto& state = rowStates[index - 1];
+			if (state == RowState::NotLoaded)
+			{
+				auto rowAddress = address + (index - 1) * rowSize;
+				try
+				{
+					rows[index - 1].load(file, stream, rowAddress);
+					state = RowState::Loaded;
+				}
+				catch (const InvalidDotnetRecordError&)
+				{
+					state = RowState::Invalid;
+				}
+			}
+
+			return state == RowState::Loaded ? &rows[index - 1] : nullptr;
+		}
 		/// @}
 
 		/// @name Row methods
 		/// @{
-		template <typename U>
-		void addRow(U&& row)
+		void setRows(const FileFormat* rowsFile, const MetadataStream* rowsStream, std::uint64_t rowsAddress,
+				std::uint64_t sizeOfRow, std::size_t rowsCount)
 		{
-			rows.push_back(std::forward<U>(row));
+			file = rowsFile;
+			stream = rowsStream;
+			address = rowsAddress;
+			rowSize = sizeOfRow;
+			numberOfRows = rowsCount;
+			rows.clear();
+			rowStates.clear();
 		}
 		/// @}
 };
@@ -551,15 +551,6 @@ struct TypeDefOrMethodDef : public CompoundIndex
 // Table records
 //
 
-class InvalidDotnetRecordError : public std::exception
-{
-public:
-	InvalidDotnetRecordError() noexcept {}
-	InvalidDotnetRecordError(const InvalidDotnetRecordError&) noexcept = default;
-
-	virtual const char* what() const noexcept { return "Invalid .NET record"; }
-};
-
 /**
  * Base record type
  */
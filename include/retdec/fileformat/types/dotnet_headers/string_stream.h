@@ -7,28 +7,33 @@
 #ifndef RETDEC_FILEFORMAT_TYPES_DOTNET_HEADERS_STRING_STREAM_H
 #define RETDEC_FILEFORMAT_TYPES_DOTNET_HEADERS_STRING_STREAM_H
 
-#include <map>
+#include <llvm/ADT/StringRef.h>
 
 #include "retdec/fileformat/types/dotnet_headers/stream.h"
 
 namespace retdec {
 namespace fileformat {
 
+/**
+ * String stream. Strings are not copied out of the file, they are
+ * read on demand directly from the content of the stream.
+ */
 class StringStream : public Stream
 {
 	private:
-		std::map<std::size_t, std::string> strings;
+		llvm::StringRef data; ///< content of the stream
 	public:
 		StringStream(std::uint64_t streamOffset, std::uint64_t streamSize);
 
 		/// @name Getters
 		/// @{
 		bool getString(std::size_t offset, std::string& result) const;
+		bool getStringRef(std::size_t offset, llvm::StringRef& result) const;
 		/// @}
 
-		/// @name String methods
+		/// @name Setters
 		/// @{
-		void addString(std::size_t offset, const std::string& string);
+		void setData(llvm::StringRef streamData);
 		/// @}
 };
 
@@ -7,6 +7,7 @@
 #ifndef RETDEC_FILEFORMAT_TYPES_EXPORT_TABLE_EXPORT_TABLE_H
 #define RETDEC_FILEFORMAT_TYPES_EXPORT_TABLE_EXPORT_TABLE_H
 
+#include <unordered_map>
 #include <vector>
 
 #include "retdec/fileformat/types/export_table/export.h"
@@ -25,6 +26,17 @@ class ExportTable
 		std::string expHashCrc32;                   ///< exphash CRC32
 		std::string expHashMd5;                     ///< exphash MD5
 		std::string expHashSha256;                  ///< exphash SHA256
+
+		/// @name Lookup indexes
+		/// Indexes are built lazily on the first lookup and dropped whenever
+		/// the table is modified.
+		/// @{
+		mutable std::unordered_map<std::string, std::size_t> nameIndex;
+		mutable std::unordered_map<unsigned long long, std::size_t> addressIndex;
+		mutable bool indexesValid = false;
+		void buildIndexes() const;
+		void invalidateIndexes();
+		/// @}
 	public:
 		/// @name Getters
 		/// @{
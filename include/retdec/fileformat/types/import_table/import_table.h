@@ -8,9 +8,11 @@
 #define RETDEC_FILEFORMAT_TYPES_IMPORT_TABLE_IMPORT_TABLE_H
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "retdec/fileformat/types/import_table/import.h"
+#include "retdec/utils/const_pointee_iterator.h"
 
 namespace retdec {
 namespace fileformat {
@@ -21,13 +23,26 @@ namespace fileformat {
 class ImportTable
 {
 	private:
-		using importsIterator = std::vector<std::unique_ptr<Import>>::const_iterator;
+		using importsIterator = retdec::utils::ConstPointeeIterator<
+				std::vector<std::unique_ptr<Import>>::const_iterator,
+				const Import*>;
 		std::vector<std::string> libraries;           ///< name of libraries
 		std::vector<std::string> missingDeps;         ///< missing dependencies
 		std::vector<std::unique_ptr<Import>> imports; ///< stored imports
 		std::string impHashCrc32;                     ///< imphash CRC32
 		std::string impHashMd5;                       ///< imphash MD5
 		std::string impHashSha256;                    ///< imphash SHA256
+
+		/// @name Lookup indexes
+		/// Indexes are built lazily on the first lookup and dropped whenever
+		/// the table is modified. Iterators give only const access to imports.
+		/// @{
+		mutable std::unordered_map<std::string, std::size_t> nameIndex;
+		mutable std::unordered_map<unsigned long long, std::size_t> addressIndex;
+		mutable bool indexesValid = false;
+		void buildIndexes() const;
+		void invalidateIndexes();
+		/// @}
 	public:
 		/// @name Getters
 		/// @{
@@ -54,7 +54,7 @@ class SecSeg
 		bool loaded = false;                  ///< @c true if content of section or segment was successfully loaded from input file
 		bool isEntropyValid = false;          ///< @c true if entropy has been computed
 
-		void computeHashes();
+		void computeHashesAndEntropy();
 	public:
 		virtual ~SecSeg() = default;
 
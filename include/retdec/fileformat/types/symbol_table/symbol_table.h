@@ -8,9 +8,11 @@
 #define RETDEC_FILEFORMAT_TYPES_SYMBOL_TABLE_SYMBOL_TABLE_H
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "retdec/fileformat/types/symbol_table/symbol.h"
+#include "retdec/utils/const_pointee_iterator.h"
 
 namespace retdec {
 namespace fileformat {
@@ -21,10 +23,25 @@ namespace fileformat {
 class SymbolTable
 {
 	private:
-		using symbolsConstIterator = std::vector<std::shared_ptr<Symbol>>::const_iterator;
+		using symbolsConstIterator = retdec::utils::ConstPointeeIterator<
+				std::vector<std::shared_ptr<Symbol>>::const_iterator,
+				std::shared_ptr<const Symbol>>;
 		using symbolsIterator = std::vector<std::shared_ptr<Symbol>>::iterator;
 		std::vector<std::shared_ptr<Symbol>> table; ///< stored symbols
 		std::string name;                           ///< name of symbol table
+
+		/// @name Lookup indexes
+		/// Indexes are built lazily on the first lookup and dropped whenever
+		/// the table or its symbols may be modified, i.e. by all the non-const
+		/// methods. Const iterators give only const access to symbols.
+		/// @{
+		mutable std::unordered_map<std::string, std::size_t> nameIndex;
+		mutable std::unordered_map<unsigned long long, std::size_t> addressIndex;
+		mutable std::unordered_map<std::size_t, std::size_t> symbolIndexIndex;
+		mutable bool indexesValid = false;
+		void buildIndexes() const;
+		void invalidateIndexes();
+		/// @}
 	public:
 		/// @name Const getters
 		/// @{
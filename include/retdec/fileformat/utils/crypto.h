@@ -8,6 +8,7 @@
 #define RETDEC_FILEFORMAT_UTILS_CRYPTO_H
 
 #include <cstdint>
+#include <memory>
 #include <string>
 
 namespace retdec {
@@ -18,6 +19,28 @@ std::string getMd5(const unsigned char *data, std::uint64_t length);
 std::string getSha1(const unsigned char *data, std::uint64_t length);
 std::string getSha256(const unsigned char *data, std::uint64_t length);
 
+/// Size of parts in which data are hashed if they are processed also in other ways
+constexpr std::uint64_t HASHED_PART_SIZE = 64 * 1024;
+
+/**
+ * Computation of CRC32, MD5 and SHA256 of data given by parts
+ *
+ * This allows other processing of the same data (e.g. computation of their
+ * histogram) while their part is in cache.
+ */
+class DataHasher
+{
+	private:
+		struct Contexts;
+		std::unique_ptr<Contexts> contexts; ///< states of hash functions
+	public:
+		DataHasher();
+		~DataHasher();
+
+		void add(const unsigned char *data, std::uint64_t length);
+		void getHashes(std::string &crc32, std::string &md5, std::string &sha256);
+};
+
 } // namespace fileformat
 } // namespace retdec
 
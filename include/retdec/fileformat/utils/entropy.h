@@ -0,0 +1,78 @@
+/**
+ * @file include/retdec/fileformat/utils/entropy.h
+ * @brief Byte histograms and entropy of data.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_FILEFORMAT_UTILS_ENTROPY_H
+#define RETDEC_FILEFORMAT_UTILS_ENTROPY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace retdec {
+namespace fileformat {
+
+/// Number of occurrences of every byte value
+using ByteHistogram = std::array<std::uint64_t, 256>;
+
+/// Default size of windows of entropy profiles
+constexpr std::size_t DEFAULT_ENTROPY_WINDOW_SIZE = 4096;
+/// Default distance between starts of windows of entropy profiles
+constexpr std::size_t DEFAULT_ENTROPY_STRIDE = 2048;
+
+/**
+ * Entropy of windows of data
+ *
+ * Window @c i covers data <tt>[i * stride, i * stride + windowSize)</tt>.
+ * Data shorter than the window size are covered by one window.
+ */
+struct EntropyProfile
+{
+	std::size_t windowSize = 0;   ///< size of windows
+	std::size_t stride = 0;       ///< distance between starts of windows
+	std::vector<double> entropy;  ///< entropy of windows in <0,8>
+
+	bool empty() const;
+	double getMax() const;
+	std::size_t getNumberOfWindowsAbove(double threshold) const;
+	void clear();
+};
+
+/**
+ * Computation of entropy profile of data which become available
+ * gradually (e.g. during another pass over them)
+ */
+class EntropyProfiler
+{
+	private:
+		const std::uint8_t *data = nullptr;  ///< profiled data
+		std::size_t dataLen = 0;             ///< length of @c data
+		std::size_t window = 0;              ///< size of windows (@c 0 if nothing is profiled)
+		EntropyProfile profile;              ///< computed profile
+		ByteHistogram counts{};              ///< histogram of current window
+		std::vector<double> weights;         ///< <tt>c * log2(c)</tt> for counts up to window size
+		std::size_t windowStart = 0;         ///< start of current window
+		std::size_t windowEnd = 0;           ///< end of current window (@c 0 if there is none)
+
+		double getWeight(std::uint64_t count) const;
+		double getWindowEntropy() const;
+	public:
+		EntropyProfiler(const std::uint8_t *profiledData, std::size_t profiledDataLen,
+			std::size_t windowSize, std::size_t stride);
+
+		void processUntil(std::size_t offset);
+		const EntropyProfile& getProfile() const;
+};
+
+void addToByteHistogram(ByteHistogram &histogram, const std::uint8_t *data, std::size_t dataLen);
+double computeHistogramEntropy(const ByteHistogram &histogram);
+EntropyProfile computeEntropyProfile(const std::uint8_t *data, std::size_t dataLen,
+	std::size_t windowSize = DEFAULT_ENTROPY_WINDOW_SIZE, std::size_t stride = DEFAULT_ENTROPY_STRIDE);
+
+} // namespace fileformat
+} // namespace retdec
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * @file include/retdec/fileformat/utils/ordinal_database.h
+ * @brief Packed database of names of functions imported by ordinal numbers.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_FILEFORMAT_UTILS_ORDINAL_DATABASE_H
+#define RETDEC_FILEFORMAT_UTILS_ORDINAL_DATABASE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace llvm {
+class MemoryBuffer;
+} // namespace llvm
+
+namespace retdec {
+namespace fileformat {
+
+/**
+ * Names of functions exported by libraries under ordinal numbers, packed by
+ * support/pack-ordinals.py from the <arch>/<library>.ord files.
+ *
+ * Layout of the database (all numbers are 32-bit little-endian, all offsets
+ * are from the start of the database, so it is mapped to memory as it is):
+ * @code
+ * magic "RDOD", version, library count, entry count
+ * libraries: {key offset, key size, first entry, entry count}...
+ * entries:   {ordinal, name offset, name size}...
+ * keys and names
+ * @endcode
+ * Libraries are sorted by their keys "<arch>/<library>", where library is
+ * in lower case and without the ".dll" suffix. Entries of each library are
+ * sorted by ordinals, so each lookup consists of two binary searches.
+ */
+class OrdinalDatabase
+{
+	public:
+		/// Name of the database in the ordinals directory.
+		static const std::string FILE_NAME;
+
+	public:
+		~OrdinalDatabase();
+
+		static std::unique_ptr<OrdinalDatabase> fromFile(const std::string &path);
+		static std::unique_ptr<OrdinalDatabase> fromBuffer(const std::string &buffer);
+
+		std::size_t getNumberOfLibraries() const;
+		std::size_t getNumberOfEntries() const;
+		bool hasLibrary(const std::string &arch, const std::string &library) const;
+		bool getName(const std::string &arch, const std::string &library, std::uint32_t ordinal, std::string &name) const;
+
+	private:
+		explicit OrdinalDatabase(std::unique_ptr<llvm::MemoryBuffer> buffer);
+
+		bool load();
+		std::uint32_t readU32(std::size_t offset) const;
+		std::string_view readString(std::size_t offset, std::size_t length) const;
+		bool findLibrary(const std::string &arch, const std::string &library, std::size_t &index) const;
+
+	private:
+		/// Whole database.
+		std::unique_ptr<llvm::MemoryBuffer> buffer;
+		/// Start of the database.
+		const char *data = nullptr;
+		/// Size of the database.
+		std::size_t size = 0;
+		/// Number of libraries in the database.
+		std::size_t libraryCount = 0;
+		/// Number of entries of all libraries in the database.
+		std::size_t entryCount = 0;
+};
+
+} // namespace fileformat
+} // namespace retdec
+
+#endif
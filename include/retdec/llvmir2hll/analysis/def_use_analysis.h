@@ -14,6 +14,7 @@
 
 #include "retdec/llvmir2hll/graphs/cfg/cfg.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
+#include "retdec/llvmir2hll/support/var_bit_set.h"
 #include "retdec/utils/non_copyable.h"
 
 namespace retdec {
@@ -58,6 +59,10 @@ public:
 	/// CFG of @c func.
 	ShPtr<CFG> cfg;
 
+	/// Numbering of variables in @c func, used to represent sets of variables
+	/// during the computation of the chains.
+	VarNumbering varIds;
+
 	/// A function that returns whether the given variable should be included
 	/// in def-use chains.
 	std::function<bool (ShPtr<Variable>)> shouldBeIncluded;
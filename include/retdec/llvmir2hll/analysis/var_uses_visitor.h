@@ -8,10 +8,12 @@
 #define RETDEC_LLVMIR2HLL_ANALYSIS_VAR_USES_VISITOR_H
 
 #include <map>
+#include <vector>
 
 #include "retdec/llvmir2hll/analysis/value_analysis.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 #include "retdec/llvmir2hll/support/types.h"
+#include "retdec/llvmir2hll/support/var_bit_set.h"
 #include "retdec/llvmir2hll/support/visitors/ordered_all_visitor.h"
 #include "retdec/utils/non_copyable.h"
 
@@ -71,13 +73,30 @@ public:
 		bool enableCaching = false, ShPtr<Module> module = nullptr);
 
 private:
-	/// Mapping of a variable into its uses.
-	// Note: Using a hash table (i.e. std::unordered_map) does not
-	//       significantly speeds up the execution.
-	using VarUsesMap = std::map<ShPtr<Variable>, ShPtr<VarUses>>;
+	/// IDs of variables.
+	using VarIdVector = std::vector<VarNumbering::Id>;
+
+	/// Cached uses of variables in a function.
+	// Variables are numbered densely per function, so the uses of a variable
+	// are found by indexing a vector. Moreover, for every statement, the IDs
+	// of variables whose uses contain the statement are stored, so when a
+	// statement is changed or removed, only the uses of these variables have
+	// to be updated (instead of the uses of all variables in the function).
+	struct FuncVarUses {
+		/// Numbering of variables in the function.
+		VarNumbering varIds;
+
+		/// Uses of variables, indexed by their IDs. Variables whose uses
+		/// have not been cached have null uses.
+		std::vector<ShPtr<VarUses>> uses;
+
+		/// Mapping of a statement into the IDs of variables whose uses
+		/// contain the statement.
+		std::map<ShPtr<Statement>, VarIdVector> stmtVarIds;
+	};
 
 	/// Mapping of a function into uses of its variables.
-	using FuncVarUsesMap = std::map<ShPtr<Function>, VarUsesMap>;
+	using FuncVarUsesMap = std::map<ShPtr<Function>, FuncVarUses>;
 
 private:
 	VarUsesVisitor(ShPtr<ValueAnalysis> va, bool enableCaching = false);
@@ -86,6 +105,18 @@ private:
 	void findAndStoreUses(ShPtr<Statement> stmt);
 	void dumpCache();
 
+	/// @name Cache Maintenance
+	/// @{
+	VarNumbering::Id getOrCreateCachedUses(FuncVarUses &funcUses,
+		ShPtr<Variable> var, ShPtr<Function> func);
+	VarNumbering::Id findCachedUses(const FuncVarUses &funcUses,
+		ShPtr<Variable> var) const;
+	void storeCachedUses(FuncVarUses &funcUses, ShPtr<VarUses> varUses);
+	void addCachedUse(FuncVarUses &funcUses, VarNumbering::Id id,
+		ShPtr<Statement> stmt, bool direct);
+	void removeCachedUses(FuncVarUses &funcUses, ShPtr<Statement> stmt);
+	/// @}
+
 	/// @name Visitor Interface
 	/// @{
 	using OrderedAllVisitor::visit;
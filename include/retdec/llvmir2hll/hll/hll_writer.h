@@ -26,6 +26,7 @@ namespace llvmir2hll {
 
 class BinaryOpExpr;
 class BracketManager;
+class FuncOutputCache;
 class UnaryOpExpr;
 
 /**
@@ -55,6 +56,8 @@ public:
 	void setOptionUseCompoundOperators(bool use = true);
 	/// @}
 
+	void setFuncOutputCache(ShPtr<FuncOutputCache> cache);
+
 protected:
 	HLLWriter(llvm::raw_ostream &out, const std::string& outputFormat = "");
 
@@ -205,6 +208,9 @@ protected:
 	/// Counter for goto labels for the current function.
 	std::size_t currFuncGotoLabelCounter;
 
+	/// Cache of the emitted output of functions (if any).
+	ShPtr<FuncOutputCache> funcOutputCache;
+
 private:
 	/// @name Emission of Meta-Information
 	/// @{
@@ -0,0 +1,126 @@
+/**
+* @file include/retdec/llvmir2hll/hll/output_managers/recording_manager.h
+* @brief An output manager that records tokens passed to another manager.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_LLVMIR2HLL_HLL_OUTPUT_MANAGERS_RECORDING_MANAGER_H
+#define RETDEC_LLVMIR2HLL_HLL_OUTPUT_MANAGERS_RECORDING_MANAGER_H
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "retdec/llvmir2hll/hll/output_manager.h"
+
+namespace retdec {
+namespace llvmir2hll {
+
+/**
+* @brief A single token passed to an output manager.
+*/
+struct OutputToken
+{
+	/// Kinds of tokens (one per token method of OutputManager).
+	enum class Kind
+	{
+		NewLine,
+		Space,
+		Punctuation,
+		Operator,
+		GlobalVariableId,
+		LocalVariableId,
+		MemberId,
+		LabelId,
+		FunctionId,
+		ParameterId,
+		Keyword,
+		DataType,
+		Preprocessor,
+		Include,
+		ConstantBool,
+		ConstantInt,
+		ConstantFloat,
+		ConstantString,
+		ConstantSymbol,
+		ConstantPointer,
+		Comment,
+		CommentModifier,
+		AddressPush,
+		AddressPop
+	};
+
+	/// Marks tokens whose value is not a reference to a symbol.
+	static constexpr std::size_t NO_SYMBOL = std::numeric_limits<std::size_t>::max();
+
+	Kind kind;
+	/// Value of the token. Addresses are stored as decimal numbers, an
+	/// undefined address as an empty string.
+	std::string value;
+	/// Index of a symbol whose name replaces @c value when the token is
+	/// replayed (see FuncOutputCache).
+	std::size_t symbol = NO_SYMBOL;
+};
+
+/// A sequence of tokens.
+using OutputTokens = std::vector<OutputToken>;
+
+/**
+* @brief Output manager that passes all tokens to another output manager and
+*        records them.
+*
+* The recorded tokens can be later passed to an arbitrary output manager by
+* replay(), which produces the same output as the original sequence of calls.
+*/
+class RecordingOutputManager : public OutputManager
+{
+	public:
+		RecordingOutputManager(OutputManager& target);
+
+	public:
+		virtual void newLine() override;
+		virtual void space(const std::string& space = " ") override;
+		virtual void punctuation(char p) override;
+		virtual void operatorX(const std::string& op) override;
+		virtual void globalVariableId(const std::string& id) override;
+		virtual void localVariableId(const std::string& id) override;
+		virtual void memberId(const std::string& id) override;
+		virtual void labelId(const std::string& id) override;
+		virtual void functionId(const std::string& id) override;
+		virtual void parameterId(const std::string& id) override;
+		virtual void keyword(const std::string& k) override;
+		virtual void dataType(const std::string& t) override;
+		virtual void preprocessor(const std::string& p) override;
+		virtual void include(const std::string& i) override;
+		virtual void constantBool(const std::string& c) override;
+		virtual void constantInt(const std::string& c) override;
+		virtual void constantFloat(const std::string& c) override;
+		virtual void constantString(const std::string& c) override;
+		virtual void constantSymbol(const std::string& c) override;
+		virtual void constantPointer(const std::string& c) override;
+		virtual void comment(const std::string& comment) override;
+
+	public:
+		virtual void commentModifier() override;
+		virtual void addressPush(Address a) override;
+		virtual void addressPop() override;
+
+	public:
+		const OutputTokens& getTokens() const;
+
+		static void replay(const OutputToken& token, OutputManager& out);
+		static void replay(const OutputTokens& tokens, OutputManager& out);
+
+	private:
+		void record(OutputToken::Kind kind, const std::string& value = "");
+
+	private:
+		OutputManager& _target;
+		OutputTokens _tokens;
+};
+
+} // namespace llvmir2hll
+} // namespace retdec
+
+#endif
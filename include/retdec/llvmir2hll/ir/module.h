@@ -111,6 +111,9 @@ public:
 	bool hasInstructionIdiomFuncs() const;
 	FuncSet getInstructionIdiomFuncs() const;
 
+	void excludeFuncFromOptimizations(ShPtr<Function> func);
+	bool isFuncExcludedFromOptimizations(ShPtr<Function> func) const;
+
 	bool isExportedFunc(ShPtr<Function> func) const;
 
 	std::string getRealNameForFunc(ShPtr<Function> func) const;
@@ -205,6 +208,9 @@ private:
 	/// Mapping of a variable into its name in the debug information.
 	VarStringMap debugVarNameMap;
 
+	/// Functions whose bodies are not changed by optimizations.
+	FuncSet funcsExcludedFromOptimizations;
+
 private:
 	bool hasFuncSatisfyingPredicate(
 		std::function<bool (ShPtr<Function>)> pred
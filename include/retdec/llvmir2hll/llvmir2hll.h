@@ -63,6 +63,7 @@
 #include "retdec/llvmir2hll/support/const_symbol_converter.h"
 #include "retdec/llvmir2hll/support/debug.h"
 #include "retdec/llvmir2hll/support/expr_types_fixer.h"
+#include "retdec/llvmir2hll/support/func_output_cache.h"
 #include "retdec/llvmir2hll/support/library_funcs_remover.h"
 #include "retdec/llvmir2hll/support/unreachable_code_in_cfg_remover.h"
 #include "retdec/llvmir2hll/utils/ir.h"
@@ -124,8 +125,10 @@ private:
 	void fixSignedUnsignedTypes();
 	void convertLLVMIntrinsicFunctions();
 	void obtainDebugInfo();
+	void lookUpCachedFuncs();
 	void initAliasAnalysis();
 	void runOptimizations();
+	void restoreCachedFuncs();
 	void renameVariables();
 	void convertConstantsToSymbolicNames();
 	void validateResultingModule();
@@ -139,6 +142,8 @@ private:
 	llvmir2hll::StringSet parseListOfOpts(
 			const std::string &opts) const;
 	std::string getTypeOfRunOptimizations() const;
+	bool canUseFuncOutputCache() const;
+	std::string getFuncOutputCacheContext() const;
 	llvmir2hll::StringVector getIdsOfPatternFindersToBeRun() const;
 	llvmir2hll::PatternFinderRunner::PatternFinders instantiatePatternFinders(
 		const llvmir2hll::StringVector &pfsIds);
@@ -176,6 +181,9 @@ private:
 	/// The used renamer of variables.
 	ShPtr<llvmir2hll::VarRenamer> varRenamer;
 
+	/// The used cache of the emitted output of functions (if any).
+	ShPtr<llvmir2hll::FuncOutputCache> funcOutputCache;
+
 	/// Output file stream.
 	std::unique_ptr<llvm::ToolOutputFile> outFile;
 
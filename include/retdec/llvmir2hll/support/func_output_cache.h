@@ -0,0 +1,168 @@
+/**
+* @file include/retdec/llvmir2hll/support/func_output_cache.h
+* @brief An on-disk cache of the emitted output of functions.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_LLVMIR2HLL_SUPPORT_FUNC_OUTPUT_CACHE_H
+#define RETDEC_LLVMIR2HLL_SUPPORT_FUNC_OUTPUT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "retdec/llvmir2hll/hll/output_managers/recording_manager.h"
+#include "retdec/llvmir2hll/support/smart_ptr.h"
+#include "retdec/llvmir2hll/support/types.h"
+#include "retdec/utils/non_copyable.h"
+
+namespace llvm {
+
+class Function;
+
+} // namespace llvm
+
+namespace retdec {
+namespace llvmir2hll {
+
+class Expression;
+class Function;
+class Module;
+class OutputManager;
+class Variable;
+
+/**
+* @brief An on-disk cache of the emitted output of functions.
+*
+* Every function definition is identified by a key, which is a hash of
+*  - the LLVM IR of the function, normalized so that it does not depend on the
+*    names of the referenced global objects, on addresses inside the function
+*    or on metadata,
+*  - the contents of the referenced constant global variables,
+*  - the LLVM IR of all the functions it (transitively) calls because the
+*    optimizations of the function depend on what they do,
+*  - a context describing everything else that affects the output (decompiler
+*    version, architecture, target HLL, back-end parameters).
+*
+* When a function is found in the cache, it is excluded from optimizations
+* (its body is still visible to analyses of other functions) and the writer
+* replays the cached tokens instead of emitting the function.
+* Names of the referenced global variables and functions are substituted with
+* their current names and addresses are relocated to the current position of
+* the function.
+*
+* The total size of the cache directory is kept under the given limit by
+* removing the least recently used entries (see evict()).
+*/
+class FuncOutputCache: private retdec::utils::NonCopyable {
+public:
+	/**
+	* @brief Cached output of a single function.
+	*/
+	struct Entry {
+		/// Address of the first byte of the function.
+		std::uint64_t startAddress = 0;
+		/// End address of the function.
+		std::uint64_t endAddress = 0;
+		/// Emitted tokens.
+		OutputTokens tokens;
+	};
+
+	/**
+	* @brief Statistics about the usage of the cache.
+	*/
+	struct Statistics {
+		/// Number of functions found in the cache.
+		std::size_t hits = 0;
+		/// Number of functions not found in the cache.
+		std::size_t misses = 0;
+		/// Number of functions that cannot be cached.
+		std::size_t uncacheable = 0;
+		/// Number of entries written into the cache.
+		std::size_t stores = 0;
+		/// Number of entries removed from the cache by evict().
+		std::size_t evictions = 0;
+		/// Number of bytes read from the cache.
+		std::uintmax_t bytesRead = 0;
+		/// Number of bytes written into the cache.
+		std::uintmax_t bytesWritten = 0;
+		/// Size of the cache after the last call to evict().
+		std::uintmax_t size = 0;
+	};
+
+public:
+	FuncOutputCache(const std::string &dir, std::uintmax_t maxSize,
+		const std::string &context);
+
+	/// @name Module-level interface
+	/// @{
+	void lookUp(ShPtr<Module> module);
+	void excludeCachedFuncs(ShPtr<Module> module);
+	void restoreCachedSymbols(ShPtr<Module> module);
+	bool hasCachedOutput(ShPtr<Function> func) const;
+	bool isCacheable(ShPtr<Function> func) const;
+	void emitCachedOutput(ShPtr<Function> func, OutputManager &out) const;
+	void storeOutput(ShPtr<Function> func, const OutputTokens &tokens);
+	/// @}
+
+	/// @name Storage
+	/// @{
+	bool load(const std::string &key, Entry &entry);
+	bool save(const std::string &key, const Entry &entry);
+	void evict();
+	const Statistics &getStatistics() const;
+	/// @}
+
+	static std::string computeKey(const llvm::Function &func,
+		std::uint64_t startAddress, std::uint64_t endAddress,
+		const std::string &context,
+		const std::function<bool (const std::string &)> &isSymbol,
+		StringVector &symbolNames);
+	static std::map<const llvm::Function *, std::string> computeCalleeKeys(
+		const std::map<const llvm::Function *, std::string> &ownKeys);
+
+private:
+	/// A global variable or a function referenced from a cached function.
+	struct Symbol {
+		ShPtr<Variable> var;
+		ShPtr<Expression> varInit;
+		ShPtr<Function> func;
+	};
+
+	/// Information about a function that can be cached.
+	struct CachedFunc {
+		std::string key;
+		std::vector<Symbol> symbols;
+		bool hit = false;
+		Entry entry;
+	};
+
+private:
+	std::string getEntryPath(const std::string &key) const;
+	std::string getSymbolName(const Symbol &symbol) const;
+
+private:
+	/// Directory with the cached entries.
+	std::string dir;
+
+	/// Maximal size of the cache in bytes (0 means no limit).
+	std::uintmax_t maxSize;
+
+	/// Description of everything that affects the output besides the
+	/// function itself.
+	std::string context;
+
+	/// Functions that can be cached.
+	std::map<ShPtr<Function>, CachedFunc> funcs;
+
+	/// Statistics.
+	Statistics stats;
+};
+
+} // namespace llvmir2hll
+} // namespace retdec
+
+#endif
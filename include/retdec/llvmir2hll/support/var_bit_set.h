@@ -0,0 +1,115 @@
+/**
+* @file include/retdec/llvmir2hll/support/var_bit_set.h
+* @brief Dense numbering of variables and bit sets of numbered variables.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_LLVMIR2HLL_SUPPORT_VAR_BIT_SET_H
+#define RETDEC_LLVMIR2HLL_SUPPORT_VAR_BIT_SET_H
+
+#include <cstddef>
+#include <unordered_map>
+
+#include <llvm/ADT/BitVector.h>
+
+#include "retdec/llvmir2hll/support/smart_ptr.h"
+#include "retdec/llvmir2hll/support/types.h"
+
+namespace retdec {
+namespace llvmir2hll {
+
+class Variable;
+
+/**
+* @brief Dense numbering of variables.
+*
+* Variables get consecutive IDs, starting from zero, in the order in which they
+* are numbered. A numbering is meant to be used for the variables of a single
+* function (including the global variables used in it), so sets of these
+* variables can be represented by small bit sets (see VarBitSet).
+*
+* Instances of this class have value object semantics.
+*/
+class VarNumbering {
+public:
+	/// ID of a variable.
+	using Id = std::size_t;
+
+	/// ID returned for variables that have not been numbered.
+	static const Id NO_ID;
+
+public:
+	Id getId(const ShPtr<Variable> &var);
+	Id findId(const ShPtr<Variable> &var) const;
+	bool hasId(const ShPtr<Variable> &var) const;
+	const ShPtr<Variable> &getVar(Id id) const;
+	std::size_t size() const;
+	void clear();
+
+private:
+	/// Mapping of a variable into its ID.
+	// Raw pointers are used as keys to avoid reference counting when looking
+	// up variables; the variables are kept alive by vars.
+	std::unordered_map<const Variable *, Id> ids;
+
+	/// Numbered variables, indexed by their IDs.
+	VarVector vars;
+};
+
+/**
+* @brief A set of variables numbered by a VarNumbering, represented by bits.
+*
+* Unions, intersections, and differences of these sets are computed word by
+* word, without any allocations of tree nodes or reference counting of the
+* variables. To convert a set from or to VarSet, use fromVarSet() and
+* toVarSet().
+*
+* Instances of this class have value object semantics.
+*/
+class VarBitSet {
+public:
+	/// ID of a variable.
+	using Id = VarNumbering::Id;
+
+	/// Iterator over IDs in the set (in ascending order).
+	using id_iterator = llvm::BitVector::const_set_bits_iterator;
+
+public:
+	static VarBitSet fromVarSet(const VarSet &vars, VarNumbering &numbering);
+	VarSet toVarSet(const VarNumbering &numbering) const;
+
+	bool operator==(const VarBitSet &other) const;
+	bool operator!=(const VarBitSet &other) const;
+
+	bool insert(Id id);
+	bool insert(const ShPtr<Variable> &var, VarNumbering &numbering);
+	bool erase(Id id);
+	bool contains(Id id) const;
+	bool contains(const ShPtr<Variable> &var,
+		const VarNumbering &numbering) const;
+	bool empty() const;
+	std::size_t size() const;
+	void clear();
+
+	/// @name Set Operations
+	/// @{
+	bool unionWith(const VarBitSet &other);
+	bool intersectWith(const VarBitSet &other);
+	bool subtract(const VarBitSet &other);
+	bool intersects(const VarBitSet &other) const;
+	bool isSubsetOf(const VarBitSet &other) const;
+	/// @}
+
+	id_iterator id_begin() const;
+	id_iterator id_end() const;
+
+private:
+	/// Bits of the set; the i-th bit is set if the variable with ID i is in
+	/// the set. Bits past the end are considered to be unset.
+	llvm::BitVector bits;
+};
+
+} // namespace llvmir2hll
+} // namespace retdec
+
+#endif
@@ -30,6 +30,33 @@ struct LlvmModuleContextPair
 	std::unique_ptr<llvm::LLVMContext> context;
 };
 
+/**
+ * Receiver of functions and basic blocks found by the disassembly.
+ * For every function, visitFunction() is called first, then visitBasicBlock()
+ * for all its basic blocks ordered by their addresses, and visitFunctionEnd()
+ * at last. Functions are visited in the order of the LLVM module.
+ */
+class DisassemblyVisitor
+{
+	public:
+		virtual ~DisassemblyVisitor() = default;
+
+		/**
+		 * \param f Function with everything but its basic blocks.
+		 */
+		virtual void visitFunction(const retdec::common::Function& f) {}
+		/**
+		 * \param bb Basic block of the last visited function. If the LLVM IR
+		 *           is not kept, its instructions are valid only during this
+		 *           call.
+		 */
+		virtual void visitBasicBlock(const retdec::common::BasicBlock& bb) {}
+		/**
+		 * \param f The same function as in the last visitFunction() call.
+		 */
+		virtual void visitFunctionEnd(const retdec::common::Function& f) {}
+};
+
 /**
  * \param[in]  inputPath Path the the input file to disassemble.
  * \param[out] fs        Set of functions to fill.
@@ -41,16 +68,60 @@ LlvmModuleContextPair disassemble(
 		retdec::common::FunctionSet* fs = nullptr
 );
 
+/**
+ * Disassemble the input file and stream its functions and basic blocks to
+ * \p visitor one by one, without collecting them in a set.
+ * \param[in] inputPath  Path the the input file to disassemble.
+ * \param[in] visitor    Receiver of the functions and basic blocks.
+ * \param[in] keepLlvmIr If \c false, the LLVM IR of every function is
+ *                       dropped right after the function is visited, and the
+ *                       whole LLVM module at the end. This keeps the memory
+ *                       usage low for users that want only the disassembly
+ *                       and control flow.
+ * \return Pointer to LLVM module created by the disassembly, or \c nullptr
+ *         if the disassembly failed or \p keepLlvmIr is \c false.
+ */
+LlvmModuleContextPair disassemble(
+		const std::string& inputPath,
+		DisassemblyVisitor& visitor,
+		bool keepLlvmIr = true
+);
+
 /**
  * Run a decompilation according to a \p config configuration.
  * If \p outString is set, decompilation output will be returned
  * in this string. Otherwise, output file is expected to be set in \p config.
+ * If a checkpoint file is set in \p config, the LLVM module and the config
+ * are stored into it right before the conversion into HLL. If a resume file
+ * is set, they are loaded from it and only the conversion into HLL is run.
  */
 bool decompile(
 		retdec::config::Config& config,
 		std::string* outString = nullptr
 );
 
+/**
+ * Step of the LLVM pass pipeline run by decompile().
+ */
+struct LlvmPassStep
+{
+	/// Arguments of the passes (e.g. \c instcombine) in the order they run.
+	std::vector<std::string> passes;
+	/// If \c true, \c passes are function-level LLVM passes run function by
+	/// function within the function budget. Otherwise, \c passes contains
+	/// one pass run on the whole module.
+	bool functionGroup = false;
+};
+
+/**
+ * Split LLVM passes from \p params into steps of the pass pipeline run by
+ * decompile(). If both LLVM function limits are 0 (no budget), every pass is
+ * a step of its own, in the same order as in \p params.
+ */
+std::vector<LlvmPassStep> getLlvmPassSteps(
+		const retdec::config::Parameters& params
+);
+
 } // namespace retdec
 
 #endif
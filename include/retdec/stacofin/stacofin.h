@@ -18,9 +18,15 @@
 #include "retdec/common/address.h"
 
 namespace retdec {
+namespace fileformat {
+	class FileFormat;
+} // namespace fileformat
 namespace loader {
 	class Image;
 } // namespace loader
+namespace yaracpp {
+	class YaraRule;
+} // namespace yaracpp
 
 namespace stacofin {
 
@@ -158,6 +164,11 @@ class Finder
 		using ByteData = typename std::pair<const std::uint8_t*, std::size_t>;
 
 	private:
+		void addDetections(
+				const retdec::fileformat::FileFormat& fileFormat,
+				const std::string& yaraFile,
+				const std::vector<retdec::yaracpp::YaraRule>& detectedRules);
+
 		bool initDisassembler();
 		void solveReferences();
 
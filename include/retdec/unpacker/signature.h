@@ -148,6 +148,7 @@ public:
 
 	uint64_t getSize() const;
 	uint64_t getCaptureSize() const;
+	const std::vector<Signature::Byte>& getBytes() const;
 
 	bool match(const MatchSettings& settings, retdec::loader::Image* file) const;
 	bool match(const MatchSettings& settings, const retdec::utils::DynamicBuffer& data) const;
@@ -160,8 +161,8 @@ public:
 private:
 	Signature& operator =(const Signature&);
 
-	bool searchMatchImpl(const std::vector<uint8_t>& bytesToMatch, uint64_t offset, uint64_t maxSearchDist, retdec::utils::DynamicBuffer* captureBuffer) const;
-	int64_t matchImpl(const std::vector<uint8_t>& bytesToMatch, uint64_t offset, retdec::utils::DynamicBuffer* captureBuffer) const;
+	bool searchMatchImpl(const uint8_t* bytesToMatch, uint64_t size, uint64_t offset, uint64_t maxSearchDist, retdec::utils::DynamicBuffer* captureBuffer) const;
+	int64_t matchImpl(const uint8_t* bytesToMatch, uint64_t size, uint64_t offset, retdec::utils::DynamicBuffer* captureBuffer) const;
 
 	std::vector<Signature::Byte> _buffer; ///< Signature bytes buffer.
 };
@@ -0,0 +1,97 @@
+/**
+ * @file include/retdec/unpacker/signature_automaton.h
+ * @brief Declaration of automaton for matching many signatures at once.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_UNPACKER_SIGNATURE_AUTOMATON_H
+#define RETDEC_UNPACKER_SIGNATURE_AUTOMATON_H
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "retdec/loader/loader.h"
+#include "retdec/unpacker/signature.h"
+#include "retdec/utils/dynamic_buffer.h"
+
+namespace retdec {
+namespace unpacker {
+
+/**
+ * Matches set of signatures against the data in a single pass over them.
+ *
+ * Every signature is matched from the start of the data, or on any offset lower than its search distance
+ * if the search distance is non-zero, the same way as by Signature::match. The longest run of exact bytes
+ * of each signature (see Signature::Byte::Type::NORMAL) is used as an anchor and all anchors are looked up
+ * by Aho-Corasick automaton. Only the positions where the anchor occurs are then compared with the whole
+ * signature including its wildcard and capture bytes. Signatures without any exact byte are compared on every
+ * allowed position.
+ *
+ * If more signatures match, the one added first wins. Signatures are not owned by the automaton.
+ */
+class SignatureAutomaton
+{
+public:
+	/**
+	 * Signature with its match settings.
+	 */
+	struct Entry
+	{
+		const Signature* signature; ///< Signature to match.
+		uint64_t searchDistance; ///< Maximum searching distance. No searching if this is set 0.
+	};
+
+	static constexpr std::size_t NO_MATCH = std::numeric_limits<std::size_t>::max(); ///< Index returned if nothing matched.
+
+	SignatureAutomaton(const std::vector<Entry>& entries);
+	SignatureAutomaton(const SignatureAutomaton&) = delete;
+
+	uint64_t getWindowSize() const;
+
+	std::size_t match(const uint8_t* data, uint64_t physicalSize, uint64_t size, retdec::utils::DynamicBuffer* capturedData) const;
+	std::size_t match(uint64_t offset, retdec::loader::Image* file, retdec::utils::DynamicBuffer* capturedData) const;
+	std::size_t match(const retdec::utils::DynamicBuffer& data, retdec::utils::DynamicBuffer* capturedData) const;
+
+private:
+	SignatureAutomaton& operator =(const SignatureAutomaton&);
+
+	/**
+	 * State of the automaton.
+	 */
+	struct State
+	{
+		std::vector<std::pair<uint8_t, uint32_t>> next; ///< Transitions sorted by byte.
+		uint32_t fail = 0; ///< Failure transition.
+		std::vector<std::size_t> anchors; ///< Entries whose anchor ends in this state (including failure states).
+	};
+
+	/**
+	 * Anchor of the signature.
+	 */
+	struct Anchor
+	{
+		uint64_t start = 0; ///< Offset of the anchor in the signature.
+		uint64_t size = 0; ///< Number of bytes in the anchor.
+	};
+
+	uint32_t findTransition(uint32_t state, uint8_t byte) const;
+	void addAnchor(std::size_t index);
+	void buildFailureTransitions();
+	uint64_t getScanEnd(std::size_t best) const;
+	uint64_t getPositions(std::size_t index) const;
+	bool matchAt(std::size_t index, const uint8_t* data, uint64_t physicalSize, uint64_t size, uint64_t pos) const;
+
+	std::vector<Entry> _entries; ///< Matched signatures.
+	std::vector<Anchor> _anchors; ///< Anchors of the signatures.
+	std::vector<std::size_t> _unanchored; ///< Signatures without anchor.
+	std::vector<uint64_t> _scanEnds; ///< Number of bytes to scan to find the signatures up to the index.
+	std::vector<State> _states; ///< States of the automaton, the first one is initial.
+	uint64_t _windowSize; ///< Number of bytes needed to match all signatures.
+};
+
+} // namespace unpacker
+} // namespace retdec
+
+#endif
@@ -0,0 +1,106 @@
+/**
+* @file include/retdec/utils/const_pointee_iterator.h
+* @brief An adapter of an iterator over pointers which gives only constant
+*        access to the pointed objects.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_CONST_POINTEE_ITERATOR_H
+#define RETDEC_UTILS_CONST_POINTEE_ITERATOR_H
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief An adapter of an iterator over pointers which gives only constant
+*        access to the pointed objects.
+*
+* Containers of (smart) pointers hand out modifiable objects even through their
+* constant iterators. This adapter dereferences to @a Pointer, which is
+* supposed to be a pointer to a constant object, e.g.
+* @c std::shared_ptr<const T> for @c std::shared_ptr<T> elements or
+* @c const T* for @c std::unique_ptr<T> elements.
+*
+* @tparam Iterator Type of the adapted iterator.
+* @tparam Pointer Type of the pointers the adapter dereferences to.
+*/
+template<typename Iterator, typename Pointer>
+class ConstPointeeIterator {
+public:
+	// Standard typedefs.
+	using value_type = Pointer;
+	using reference = Pointer;
+	using pointer = void;
+	using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+	using iterator_category = std::random_access_iterator_tag;
+
+public:
+	ConstPointeeIterator() = default;
+	explicit ConstPointeeIterator(Iterator it): current(std::move(it)) {}
+
+	reference operator*() const {
+		using Element = typename std::iterator_traits<Iterator>::value_type;
+		if constexpr (std::is_constructible_v<Pointer, const Element &>) {
+			return Pointer(*current);
+		} else {
+			return Pointer(current->get());
+		}
+	}
+
+	reference operator[](difference_type n) const {
+		return *(*this + n);
+	}
+
+	ConstPointeeIterator &operator++() { ++current; return *this; }
+	ConstPointeeIterator operator++(int) { return ConstPointeeIterator(current++); }
+	ConstPointeeIterator &operator--() { --current; return *this; }
+	ConstPointeeIterator operator--(int) { return ConstPointeeIterator(current--); }
+	ConstPointeeIterator &operator+=(difference_type n) { current += n; return *this; }
+	ConstPointeeIterator &operator-=(difference_type n) { current -= n; return *this; }
+
+	friend ConstPointeeIterator operator+(ConstPointeeIterator it, difference_type n) {
+		return it += n;
+	}
+	friend ConstPointeeIterator operator+(difference_type n, ConstPointeeIterator it) {
+		return it += n;
+	}
+	friend ConstPointeeIterator operator-(ConstPointeeIterator it, difference_type n) {
+		return it -= n;
+	}
+	friend difference_type operator-(const ConstPointeeIterator &lhs,
+			const ConstPointeeIterator &rhs) {
+		return lhs.current - rhs.current;
+	}
+
+	friend bool operator==(const ConstPointeeIterator &lhs, const ConstPointeeIterator &rhs) {
+		return lhs.current == rhs.current;
+	}
+	friend bool operator!=(const ConstPointeeIterator &lhs, const ConstPointeeIterator &rhs) {
+		return lhs.current != rhs.current;
+	}
+	friend bool operator<(const ConstPointeeIterator &lhs, const ConstPointeeIterator &rhs) {
+		return lhs.current < rhs.current;
+	}
+	friend bool operator>(const ConstPointeeIterator &lhs, const ConstPointeeIterator &rhs) {
+		return lhs.current > rhs.current;
+	}
+	friend bool operator<=(const ConstPointeeIterator &lhs, const ConstPointeeIterator &rhs) {
+		return lhs.current <= rhs.current;
+	}
+	friend bool operator>=(const ConstPointeeIterator &lhs, const ConstPointeeIterator &rhs) {
+		return lhs.current >= rhs.current;
+	}
+
+private:
+	/// Adapted iterator.
+	Iterator current;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
@@ -0,0 +1,67 @@
+/**
+* @file include/retdec/utils/parallel.h
+* @brief Parallel processing of independent items.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_PARALLEL_H
+#define RETDEC_UTILS_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace retdec {
+namespace utils {
+
+void setMaxThreadCount(std::size_t count);
+std::size_t getMaxThreadCount();
+
+/**
+* @brief Call @a func for all indexes lower than @a count.
+*
+* Indexes are distributed among at most getMaxThreadCount() threads (the
+* calling thread is one of them). Everything is done by the calling thread if
+* there is only one index or threading is turned off by setMaxThreadCount().
+* @a func must not throw.
+*/
+template <typename Func>
+void parallelFor(std::size_t count, Func func)
+{
+	std::size_t threadCount = std::min(getMaxThreadCount(), count);
+	if (threadCount < 2)
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			func(i);
+		}
+		return;
+	}
+
+	std::atomic<std::size_t> next(0);
+	auto worker = [&]()
+	{
+		for (auto i = next++; i < count; i = next++)
+		{
+			func(i);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (std::size_t i = 1; i < threadCount; ++i)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+}
+
+} // namespace utils
+} // namespace retdec
+
+#endif
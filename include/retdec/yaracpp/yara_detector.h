@@ -49,6 +49,8 @@ class YaraDetector
 				/// @{
 				void addDetected(YaraRule &rule);
 				void addUndetected(YaraRule &rule);
+				std::vector<YaraRule>& getDetected();
+				std::vector<YaraRule>& getUndetected();
 				bool storeAllRules() const;
 				/// @}
 		};
@@ -82,6 +84,8 @@ class YaraDetector
 		YR_RULES* textFilesRules = nullptr;
 		/// rules from precompiled files
 		std::vector<YR_RULES*> precompiledRules;
+		/// namespaces requested for precompiled files
+		std::vector<std::string> precompiledNameSpaces;
 		/// internal state of instance
 		bool stateIsValid = true;
 		/// indicates whether text files need recompilation
@@ -103,6 +107,11 @@ class YaraDetector
 				T&& value,
 				bool storeAllRules = false
 		);
+		template <typename T> bool scanWithRules(
+				YR_RULES* rules,
+				T&& value,
+				CallbackSettings &settings
+		) const;
 		YR_RULES* getCompiledRules();
 		/// @}
 	public:
@@ -117,6 +126,7 @@ class YaraDetector
 				const std::string &nameSpace = std::string()
 		);
 		bool isInValidState() const;
+		bool compileRules();
 		/// @}
 
 		/// @name Detection methods
@@ -129,6 +139,19 @@ class YaraDetector
 				std::vector<std::uint8_t> &bytes,
 				bool storeAllRules = false
 		);
+		bool analyze(
+				const std::string &pathToInputFile,
+				std::vector<YaraRule> &detected,
+				std::vector<YaraRule> &undetected,
+				bool storeAllRules = false
+		) const;
+		bool analyze(
+				const std::uint8_t *data,
+				std::size_t size,
+				std::vector<YaraRule> &detected,
+				std::vector<YaraRule> &undetected,
+				bool storeAllRules = false
+		) const;
 		const std::vector<YaraRule>& getDetectedRules() const;
 		const std::vector<YaraRule>& getUndetectedRules() const;
 		/// @}
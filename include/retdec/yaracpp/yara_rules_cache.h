@@ -0,0 +1,51 @@
+/**
+ * @file include/retdec/yaracpp/yara_rules_cache.h
+ * @brief Cache of compiled YARA rules shared by several threads.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_YARACPP_YARA_RULES_CACHE_H
+#define RETDEC_YARACPP_YARA_RULES_CACHE_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "retdec/yaracpp/yara_detector.h"
+
+namespace retdec {
+namespace yaracpp {
+
+/**
+ * Cache of compiled YARA rules
+ *
+ * Each distinct set of rule files is loaded and compiled only once. Returned
+ * detectors live as long as the cache and can be used concurrently by
+ * YaraDetector::analyze() const, so one cache can serve many analyzed files.
+ */
+class YaraRulesCache
+{
+	public:
+		/// Rule files as pairs of path to file and namespace of its rules.
+		using RuleFiles = std::vector<std::pair<std::string, std::string>>;
+
+	private:
+		/// compiled detectors indexed by their rule files
+		std::map<RuleFiles, std::unique_ptr<YaraDetector>> detectors;
+		/// lock for the detectors
+		std::mutex detectorsMutex;
+
+	public:
+		/// @name Detection methods
+		/// @{
+		const YaraDetector* getDetector(const RuleFiles &ruleFiles);
+		/// @}
+};
+
+} // namespace yaracpp
+} // namespace retdec
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file include/retdec/yaracpp/yara_scan_session.h
+ * @brief One YARA scan of a memory buffer shared by several rule sets.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_YARACPP_YARA_SCAN_SESSION_H
+#define RETDEC_YARACPP_YARA_SCAN_SESSION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "retdec/yaracpp/yara_rule.h"
+#include "retdec/yaracpp/yara_rules_cache.h"
+
+namespace retdec {
+namespace yaracpp {
+
+/**
+ * Scan of one memory buffer by rule sets of several users
+ *
+ * Every user (e.g. compiler detection, crypto patterns) adds its rule set
+ * and gets its ID. Rule files of all the sets added since the last scan are
+ * compiled together, each file in its own namespace, and the buffer is
+ * scanned by all of them at once. Detected rules are then given back to the
+ * sets which contain their files, so rule sets can share files.
+ *
+ * The buffer is not copied, so it must live as long as the session.
+ */
+class YaraScanSession
+{
+	private:
+		/**
+		 * Rule set of one user
+		 */
+		struct RuleSet
+		{
+			std::vector<std::size_t> files;     ///< indexes of rule files
+			bool storeAllRules = false;         ///< store also undetected rules
+			bool scanned = false;               ///< the buffer was scanned by this set
+			std::vector<YaraRule> detected;     ///< detected rules
+			std::vector<YaraRule> undetected;   ///< undetected rules
+		};
+
+		/// scanned data
+		const std::uint8_t *data = nullptr;
+		/// size of scanned data
+		std::size_t dataSize = 0;
+		/// compiled rules shared with other sessions or @c nullptr
+		YaraRulesCache *rulesCache = nullptr;
+		/// paths to all rule files (each file only once)
+		std::vector<std::string> ruleFiles;
+		/// rule sets of users
+		std::vector<RuleSet> ruleSets;
+
+		/// @name Auxiliary methods
+		/// @{
+		std::size_t getRuleFileIndex(const std::string &pathToFile);
+		static std::string getNameSpace(std::size_t fileIndex);
+		bool scanRuleFiles(
+				const YaraRulesCache::RuleFiles &files,
+				bool storeAllRules,
+				std::vector<YaraRule> &detected,
+				std::vector<YaraRule> &undetected
+		) const;
+		/// @}
+	public:
+		YaraScanSession(
+				const std::uint8_t *scannedData,
+				std::size_t scannedDataSize,
+				YaraRulesCache *rules = nullptr
+		);
+
+		/// @name Detection methods
+		/// @{
+		std::size_t addRuleSet(
+				const std::vector<std::string> &pathsToFiles,
+				bool storeAllRules = false
+		);
+		bool scan();
+		bool isScanned(std::size_t ruleSet) const;
+		const std::vector<YaraRule>& getDetectedRules(std::size_t ruleSet) const;
+		const std::vector<YaraRule>& getUndetectedRules(std::size_t ruleSet) const;
+		/// @}
+};
+
+} // namespace yaracpp
+} // namespace retdec
+
+#endif
@@ -168,47 +168,23 @@ class ArchiveDecompiler:
             self._cleanup()
             return 0
 
-        # Run the decompilation over all the found files.
-        print('Running `%s' % DECOMPILER, end='')
-
+        # Run the decompilation over all the found files. The decompiler reads
+        # the archive only once and decompiles the files in parallel.
+        arg_list = [
+            DECOMPILER,
+            '--ar-all',
+            '--timeout', str(self.timeout),
+            self.library_path,
+        ]
         if self.decompiler_args:
-            print(' '.join(self.decompiler_args), end='')
-
-        print('` over %d files with timeout %d s. (run `kill %d ` to terminate this script)...' % (
-            self.file_count, self.timeout, os.getpid()), file=sys.stderr)
-
-        for i in range(self.file_count):
-            file_index = (i + 1)
-            print('%d/%d\t\t' % (file_index, self.file_count))
-
-            # We have to use indexes instead of names because archives can contain multiple files with same name.
-            log_file = self.library_path + '.file_' + str(file_index) + '.log.verbose'
-
-            # Do not escape!
-            arg_list = [
-                sys.executable,
-                DECOMPILER,
-                '--ar-index=' + str(i),
-                '-o', self.library_path + '.file_' + str(file_index) + '.c',
-                self.library_path,
-            ]
-            if self.decompiler_args:
-                arg_list.append(self.decompiler_args)
-            output, rc, timeouted = CmdRunner.run_cmd(
-                arg_list,
-                timeout=self.timeout,
-                buffer_output=True,
-            )
-
-            with open(log_file, 'w') as f:
-                f.write(output)
-
-            if timeouted:
-                print('[TIMEOUT]')
-            elif rc != 0:
-                print('[FAIL]')
-            else:
-                print('[OK]')
+            arg_list.extend(self.decompiler_args)
+
+        print('Running `%s` over %d files with timeout %d s per file'
+              ' (run `kill %d ` to terminate this script)...' % (
+                  ' '.join(arg_list), self.file_count, self.timeout, os.getpid()),
+              file=sys.stderr)
+
+        CmdRunner.run_cmd(arg_list)
 
         self._cleanup()
         return 0
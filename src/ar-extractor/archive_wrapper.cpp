@@ -407,6 +407,52 @@ bool ArchiveWrapper::extractByIndex(
 	return false;
 }
 
+/**
+ * Get all object files without extracting them.
+ *
+ * Objects are returned in the order of their indexes. Their data point into
+ * the buffer of this wrapper and are valid only while the wrapper exists. If
+ * name of object could not be read from input archive, name 'invalid_name'
+ * is used.
+ *
+ * @param result container where objects will be added
+ * @param errorMessage possible error message if @c false is returned
+ *
+ * @return @c true if no errors occurred, @c false otherwise
+ */
+bool ArchiveWrapper::getObjects(
+	std::vector<ArchiveObject> &result,
+	std::string &errorMessage) const
+{
+	Error error = Error::success();
+	for (const auto &child : archive->children(error)) {
+		if (checkError(error, errorMessage)) {
+			return false;
+		}
+
+		auto bufferOrErr = child.getBuffer();
+		if (!bufferOrErr) {
+			llvm::consumeError(bufferOrErr.takeError());
+			errorMessage = "Could not get file buffer";
+			return false;
+		}
+
+		auto nameOrErr = child.getName();
+		ArchiveObject object;
+		if (nameOrErr) {
+			object.name = nameOrErr->str();
+		}
+		else {
+			llvm::consumeError(nameOrErr.takeError());
+			object.name = "invalid_name";
+		}
+		object.data = *bufferOrErr;
+		result.push_back(std::move(object));
+	}
+
+	return !checkError(error, errorMessage);
+}
+
 /**
  * Get names of all object files in archive.
  *
@@ -6,6 +6,8 @@
 
 #include <llvm/IR/Dominators.h>
 #include <llvm/IR/PatternMatch.h>
+#include <llvm/IR/ValueHandle.h>
+#include <llvm/Transforms/Utils/Local.h>
 
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/string.h"
@@ -123,6 +125,11 @@ bool Decoder::run()
 	patternsRecognize();
 	finalizePseudoCalls();
 
+	if (_config->getConfig().parameters.isForwardRegisterValues())
+	{
+		forwardRegisterValues();
+	}
+
 	if (debug_enabled && fs::exists(_config->getOutputDirectory()))
 	{
 		dumpControFlowToJson(_module, _config->getOutputDirectory());
@@ -1589,5 +1596,131 @@ void Decoder::finalizePseudoCalls()
 	}
 }
 
+/**
+ * Forward values of registers within basic blocks:
+ * - A load of a register whose value in the block is already known (it was
+ *   stored or loaded before) is replaced by that value.
+ * - A store to a register which is overwritten later in the same block is
+ *   removed, because all the reads in between were replaced by its value.
+ *
+ * Calls (including the pseudo calls) may read or write any register, so
+ * nothing is known about registers after them, and stores before them are
+ * kept. The last store to each register in a block is kept, because the
+ * value may be live at the block's exit. Loads and stores through a pointer
+ * cast of a register (i.e. of another type) are kept as they are, and they
+ * end the forwarding of that register.
+ *
+ * This must run only after the decoding is done -- the decoder splits basic
+ * blocks at jump targets it finds later, and the forwarded values would
+ * be wrong (and would not dominate their uses) in the new blocks.
+ */
+void Decoder::forwardRegisterValues()
+{
+	for (auto& f : *_module)
+	for (auto& b : f)
+	{
+		// Value of each register at the current position in the block.
+		std::map<llvm::Value*, llvm::Value*> vals;
+		// The last store to each register, if it was not followed by a call.
+		std::map<llvm::Value*, llvm::StoreInst*> stores;
+		// Values of removed stores -- they may have become dead.
+		std::vector<llvm::WeakTrackingVH> removedVals;
+
+		for (auto i = b.begin(), e = b.end(); i != e;)
+		{
+			llvm::Instruction* insn = &*i;
+			++i;
+
+			if (llvm::isa<llvm::CallInst>(insn))
+			{
+				vals.clear();
+				stores.clear();
+			}
+			else if (auto* l = llvm::dyn_cast<llvm::LoadInst>(insn))
+			{
+				auto* ptr = l->getPointerOperand();
+				auto* reg = ptr->stripPointerCasts();
+				if (!isForwardableRegister(reg))
+				{
+					continue;
+				}
+				if (reg != ptr)
+				{
+					// The pending store is read as another type.
+					stores.erase(reg);
+					continue;
+				}
+
+				auto fIt = vals.find(reg);
+				if (fIt != vals.end() && fIt->second->getType() == l->getType())
+				{
+					l->replaceAllUsesWith(fIt->second);
+					l->eraseFromParent();
+				}
+				else
+				{
+					vals[reg] = l;
+					stores.erase(reg);
+				}
+			}
+			else if (auto* s = llvm::dyn_cast<llvm::StoreInst>(insn))
+			{
+				auto* ptr = s->getPointerOperand();
+				auto* reg = ptr->stripPointerCasts();
+				if (!isForwardableRegister(reg))
+				{
+					continue;
+				}
+				if (reg != ptr)
+				{
+					// The register is (partially) overwritten by another type.
+					vals.erase(reg);
+					stores.erase(reg);
+					continue;
+				}
+
+				auto fIt = stores.find(reg);
+				if (fIt != stores.end())
+				{
+					removedVals.push_back(fIt->second->getValueOperand());
+					fIt->second->eraseFromParent();
+				}
+				vals[reg] = s->getValueOperand();
+				stores[reg] = s;
+			}
+		}
+
+		for (auto& v : removedVals)
+		{
+			if (v)
+			{
+				llvm::RecursivelyDeleteTriviallyDeadInstructions(v);
+			}
+		}
+	}
+}
+
+/**
+ * Forward values of registers in module @a m without the decoding.
+ * @param m Module with decoded functions.
+ * @param a ABI which knows the registers of @a m.
+ */
+void Decoder::forwardRegisterValues(llvm::Module& m, Abi* a)
+{
+	_module = &m;
+	_abi = a;
+	forwardRegisterValues();
+}
+
+/**
+ * Only general purpose and flag registers are forwarded. Other registers
+ * (e.g. the x87 FPU top) are handled by specialized analyses that expect
+ * them to be accessed by each instruction.
+ */
+bool Decoder::isForwardableRegister(llvm::Value* reg)
+{
+	return _abi->isGeneralPurposeRegister(reg) || _abi->isFlagRegister(reg);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -85,6 +85,14 @@ void Decoder::initTranslator()
 			_module,
 			basicMode,
 			extraMode);
+
+	// Do not generate flag stores that are overwritten before they are read.
+	// Most of them would be removed by later optimizations anyway, but they
+	// make the IR several times bigger until then.
+	if (auto* c2lX86 = dynamic_cast<Capstone2LlvmIrTranslatorX86*>(_c2l.get()))
+	{
+		c2lX86->setLazyFlags(true);
+	}
 }
 
 /**
@@ -704,7 +712,7 @@ void Decoder::initJumpTargetsImports()
 		isPtr |= sec && sec->getName() == ".got.plt";
 		if (isPtr)
 		{
-			ptrs.insert(imp.get());
+			ptrs.insert(imp);
 			continue;
 		}
 
@@ -714,7 +722,7 @@ void Decoder::initJumpTargetsImports()
 		{
 			auto* f = createFunction(a, true);
 			_imports.emplace(a);
-			if (_image->isImportTerminating(impTbl, imp.get()))
+			if (_image->isImportTerminating(impTbl, imp))
 			{
 				_terminatingFncs.insert(f);
 			}
@@ -733,7 +741,7 @@ void Decoder::initJumpTargetsImports()
 		{
 			auto* f = createFunction(jt->getAddress());
 			_imports.emplace(jt->getAddress());
-			if (_image->isImportTerminating(impTbl, imp.get()))
+			if (_image->isImportTerminating(impTbl, imp))
 			{
 				_terminatingFncs.insert(f);
 			}
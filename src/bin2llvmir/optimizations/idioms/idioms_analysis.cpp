@@ -4,6 +4,9 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallVector.h>
+
 #include "retdec/bin2llvmir/optimizations/idioms/idioms_analysis.h"
 
 using namespace llvm;
@@ -12,255 +15,311 @@ namespace retdec {
 namespace bin2llvmir {
 
 /**
- * Analyse given BasicBlock and use instruction exchanger to transform
- * instruction idioms
+ * Initialize basic-block idioms enabled for the compiler and architecture
  *
- * @param bb BasicBlock to analyse
- * @param exchanger instruction idiom exchanger
- * @param fname instruction idiom exchanger name (for debug purpose only)
+ * Position of instruction idiom exchangers is IMPORTANT! More complicated
+ * instruction idioms have to be exchanged before simplier ones. They can
+ * consist of other instruction idioms (the simple ones), so they have to be
+ * exchanged at first place!
  */
-bool IdiomsAnalysis::analyse(llvm::BasicBlock & bb, llvm::Instruction * (IdiomsAnalysis::*exchanger)(llvm::BasicBlock::iterator) const, const char * fname) {
-	bool change_made = false;
+void IdiomsAnalysis::initBasicBlockIdioms() {
+	CC_compiler cc = getCompiler();
+	CC_arch arch = getArch();
 
-	for (BasicBlock::iterator iter = bb.begin(), end = bb.end(); iter != end; /**/) {
-		BasicBlock::iterator insn = iter;
-		++iter; // go to next instruction to use valid iterator in next loop
+	if (arch == ARCH_POWERPC || arch == ARCH_ARM || arch == ARCH_x86 || arch == ARCH_THUMB || arch == ARCH_ANY)
+		if (cc == CC_GCC || cc == CC_Intel || cc == CC_VStudio || cc == CC_ANY) {
+			addBasicBlockIdiom(&IdiomsMagicDivMod::signedMod1, Instruction::Add,
+										"IdiomsMagicDivMod::signedMod1");
 
-		// call exchanger on every instruction
-		Instruction * res = (this->*exchanger)(insn);
+			addBasicBlockIdiom(&IdiomsMagicDivMod::signedMod2, Instruction::Add,
+										"IdiomsMagicDivMod::signedMod2");
 
-		if (res) {
-			change_made = true;
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicUnsignedDiv2, Instruction::LShr,
+										"IdiomsMagicDivMod::magicUnsignedDiv2");
 
-			(*insn).replaceAllUsesWith(res);
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicUnsignedDiv1, Instruction::Trunc,
+										"IdiomsMagicDivMod::magicUnsignedDiv1");
 
-			// Move the name to the new instruction first.
-			res->takeName(&*insn);
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicSignedDiv1, Instruction::Sub,
+										"IdiomsMagicDivMod::magicSignedDiv1");
 
-			// Insert the new instruction into the basic block...
-			BasicBlock * InstParent = (*insn).getParent();
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicSignedDiv2, Instruction::Sub,
+										"IdiomsMagicDivMod::magicSignedDiv2");
 
-			// If we replace a PHI with something that isn't a PHI,
-			// fix up the insertion point.
-			if (! isa<PHINode>(res) && isa<PHINode>(insn))
-				insn = InstParent->getFirstInsertionPt();
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicSignedDiv3, Instruction::Sub,
+										"IdiomsMagicDivMod::magicSignedDiv3");
 
-			InstParent->getInstList().insert(insn, res);
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicSignedDiv4, Instruction::Sub,
+										"IdiomsMagicDivMod::magicSignedDiv4");
 
-			(*insn).eraseFromParent();
-		}
-	}
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicSignedDiv5, Instruction::Sub,
+										"IdiomsMagicDivMod::magicSignedDiv5");
 
-	return change_made;
-}
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicSignedDiv6, Instruction::Sub,
+										"IdiomsMagicDivMod::magicSignedDiv6");
 
-/**
- * Do instruction idioms analysis pass
- *
- * @param f Function to analyse for instruction idioms
- * @param p actual pass
- * @return true whenever an exchange has been made, otherwise 0
- */
-bool IdiomsAnalysis::doAnalysis(Function & f, Pass * p) {
-	/*
-	 * Instruction idioms are inspected in a tree of Instructions. Every
-	 * instruction idiom has to be called on a basic block. Position of
-	 * instruction idiom exchangers is IMPORTANT! More complicated instruction
-	 * idioms have to be exchanged before simplier ones. They can consist of
-	 * other instruction idioms (the simple ones), so they have to be exchanged
-	 * at first place!
-	 */
-	bool change_made = false; // was there any exchange?
+			// Found in PowerPC - div 10
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicSignedDiv7pos, Instruction::Sub,
+										"IdiomsMagicDivMod::magicSignedDiv7pos");
 
-	CC_compiler cc = getCompiler();
-	CC_arch arch = getArch();
+			// Found in PowerPC - the same as previous, but the divisor
+			// is negative, i.e. div -10
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicSignedDiv7neg, Instruction::Sub,
+										"IdiomsMagicDivMod::magicSignedDiv7neg");
 
-	// Inspect multi-basic block idioms
-	if (cc == CC_GCC || cc == CC_ANY) {
-		change_made |= analyse(f, p, &IdiomsGCC::exchangeCondBitShiftDivMultiBB,
-									"IdiomsGCC::exchangeCondBitShiftDivMultiBB");
+			// Found in PowerPC - div 6
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicSignedDiv8pos, Instruction::Sub,
+										"IdiomsMagicDivMod::magicSignedDiv8pos");
+
+			// Found in PowerPC - the same as previous, but the divisor
+			// is negative, i.e. div -3
+			addBasicBlockIdiom(&IdiomsMagicDivMod::magicSignedDiv8neg, Instruction::Sub,
+										"IdiomsMagicDivMod::magicSignedDiv8neg");
+
+			addBasicBlockIdiom(&IdiomsMagicDivMod::unsignedMod, Instruction::Sub,
+										"IdiomsMagicDivMod::unsignedMod");
 	}
 
-	// Inspect basic-block idioms
-	for (Function::iterator b = f.begin(); b != f.end(); ++b) {
-		BasicBlock & bb = *b;
-		if (arch == ARCH_POWERPC || arch == ARCH_ARM || arch == ARCH_x86 || arch == ARCH_THUMB || arch == ARCH_ANY)
-			if (cc == CC_GCC || cc == CC_Intel || cc == CC_VStudio || cc == CC_ANY) {
-				change_made |= analyse(bb, &IdiomsMagicDivMod::signedMod1,
-											"IdiomsMagicDivMod::signedMod1");
+	// all arch
+	if (cc == CC_GCC || cc == CC_ANY)
+		addBasicBlockIdiom(&IdiomsGCC::exchangeSignedModuloByTwo, Instruction::Sub,
+									"IdiomsGCC::exchangeSignedModuloByTwo");
 
-				change_made |= analyse(bb, &IdiomsMagicDivMod::signedMod2,
-											"IdiomsMagicDivMod::signedMod2");
+	// PowerPC model lacks FPU and x86 uses x87.
+	if (arch == ARCH_ARM || arch == ARCH_THUMB || arch == ARCH_MIPS || arch == ARCH_ANY)
+		if (cc == CC_GCC || cc == CC_ANY)
+			addBasicBlockIdiom(&IdiomsGCC::exchangeCopysign, Instruction::Or,
+										"IdiomsGCC::exchangeCopysign");
 
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicUnsignedDiv2,
-											"IdiomsMagicDivMod::magicUnsignedDiv2");
+	// PowerPC model lacks FPU and x86 uses x87.
+	if (arch == ARCH_ARM || arch == ARCH_THUMB || arch == ARCH_MIPS || arch == ARCH_ANY)
+		if (cc == CC_GCC || cc == CC_ANY)
+			addBasicBlockIdiom(&IdiomsGCC::exchangeFloatAbs, Instruction::And,
+										"IdiomsGCC::exchangeFloatAbs");
+
+	if (arch == ARCH_x86 || arch == ARCH_ANY)
+		if (cc == CC_Intel || cc == CC_VStudio || cc == CC_ANY)
+			addBasicBlockIdiom(&IdiomsVStudio::exchangeOrMinusOneAssign, Instruction::Or,
+										"IdiomsVStudio::exchangeOrMinusOneAssign");
+
+	if (arch == ARCH_x86 || arch == ARCH_ANY)
+		if (cc == CC_Intel || cc == CC_VStudio || cc == CC_ANY)
+			addBasicBlockIdiom(&IdiomsVStudio::exchangeAndZeroAssign, Instruction::And,
+									"IdiomsVStudio::exchangeAndZeroAssign");
+
+	// all arch
+	if (cc == CC_GCC || cc == CC_ANY)
+		addBasicBlockIdiom(&IdiomsGCC::exchangeCondBitShiftDiv1, Instruction::AShr,
+									"IdiomsGCC::exchangeCondBitShiftDiv1");
+
+	// all arch
+	if (cc == CC_GCC || cc == CC_ANY)
+		addBasicBlockIdiom(&IdiomsGCC::exchangeCondBitShiftDiv2, Instruction::Sub,
+									"IdiomsGCC::exchangeCondBitShiftDiv2");
+
+	// all arch
+	if (cc == CC_GCC || cc == CC_ANY)
+		addBasicBlockIdiom(&IdiomsGCC::exchangeCondBitShiftDiv3, Instruction::Sub,
+									"IdiomsGCC::exchangeCondBitShiftDiv3");
+
+	// all arch
+	if (cc == CC_GCC || cc == CC_Intel || cc == CC_LLVM || cc == CC_VStudio || cc == CC_ANY)
+		addBasicBlockIdiom(&IdiomsCommon::exchangeSignedModulo2n, Instruction::Sub,
+									"IdiomsCommon::exchangeSignedModulo2n");
+
+	// all arch
+	if (cc == CC_GCC || cc == CC_Intel || cc == CC_ANY)
+		addBasicBlockIdiom(&IdiomsCommon::exchangeGreaterEqualZero, Instruction::Xor,
+									"IdiomsCommon::exchangeGreaterEqualZero");
+
+	// all arch
+	if (cc == CC_GCC || cc == CC_LLVM || cc == CC_VStudio || cc == CC_ANY)
+		addBasicBlockIdiom(&IdiomsGCC::exchangeXorMinusOne, Instruction::Xor,
+									"IdiomsGCC::exchangeXorMinusOne");
+
+	if (arch == ARCH_POWERPC || arch == ARCH_ARM || arch == ARCH_THUMB || arch == ARCH_MIPS || arch == ARCH_ANY)
+		if (cc == CC_GCC || cc == CC_ANY)
+			addBasicBlockIdiom(&IdiomsCommon::exchangeDivByMinusTwo, Instruction::Sub,
+										"IdiomsCommon::exchangeDivByMinusTwo");
 
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicUnsignedDiv1,
-											"IdiomsMagicDivMod::magicUnsignedDiv1");
+	// all arch
+	if (cc == CC_GCC || cc == CC_Intel || cc == CC_LLVM || cc == CC_ANY)
+		addBasicBlockIdiom(&IdiomsCommon::exchangeLessThanZero, Instruction::LShr,
+									"IdiomsCommon::exchangeLessThanZero");
 
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicSignedDiv1,
-											"IdiomsMagicDivMod::magicSignedDiv1");
+	// PowerPC model lacks FPU and x86 uses x87.
+	if (cc == CC_GCC || cc == CC_ANY)
+		if (arch == ARCH_ARM || arch == ARCH_THUMB || arch == ARCH_MIPS || arch == ARCH_ANY)
+			addBasicBlockIdiom(&IdiomsGCC::exchangeFloatNeg, Instruction::Xor,
+										"IdiomsGCC::exchangeFloatNeg");
 
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicSignedDiv2,
-											"IdiomsMagicDivMod::magicSignedDiv2");
+	// all arch
+	if (cc == CC_GCC || cc == CC_ANY)
+		addBasicBlockIdiom(&IdiomsCommon::exchangeUnsignedModulo2n, Instruction::And,
+									"IdiomsCommon::exchangeUnsignedModulo2n");
 
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicSignedDiv3,
-											"IdiomsMagicDivMod::magicSignedDiv3");
+	// all arch
+	if (cc == CC_LLVM || cc == CC_ANY)
+			addBasicBlockIdiom(&IdiomsLLVM::exchangeIsGreaterThanMinusOne, Instruction::ICmp,
+										"IdiomsLLVM::exchangeIsGreaterThanMinusOne");
 
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicSignedDiv4,
-											"IdiomsMagicDivMod::magicSignedDiv4");
+	// all arch
+	// all compilers
+	addBasicBlockIdiom(&IdiomsCommon::exchangeBitShiftSDiv1, Instruction::Or,
+								"IdiomsCommon::exchangeBitShiftSDiv1");
+
+	// all arch
+	// all compilers
+	addBasicBlockIdiom(&IdiomsCommon::exchangeBitShiftUDiv, Instruction::LShr,
+								"IdiomsCommon::exchangeBitShiftUDiv");
+
+	// all arch
+	// all compilers
+	addBasicBlockIdiom(&IdiomsCommon::exchangeBitShiftMul, Instruction::Shl,
+								"IdiomsCommon::exchangeBitShiftMul");
+
+	// all arch
+	if (cc == CC_LLVM || cc == CC_ANY) {
+		addBasicBlockIdiom(&IdiomsLLVM::exchangeIsGreaterThanMinusOne, Instruction::ICmp,
+									"IdiomsLLVM::exchangeIsGreaterThanMinusOne");
+	}
 
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicSignedDiv5,
-											"IdiomsMagicDivMod::magicSignedDiv5");
+	// all arch
+	if (cc == CC_LLVM || cc == CC_ANY) {
+		addBasicBlockIdiom(&IdiomsLLVM::exchangeCompareEq, Instruction::Xor,
+									"IdiomsLLVM::exchangeCompareEq", IdiomShape::BOOL);
 
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicSignedDiv6,
-											"IdiomsMagicDivMod::magicSignedDiv6");
+#if 0
+		/* We do not recognize this well */
+		addBasicBlockIdiom(&IdiomsLLVM::exchangeCompareNeq, Instruction::Xor,
+									"IdiomsLLVM::exchangeCompareNeq", IdiomShape::BOOL);
+#endif
 
-				// Found in PowerPC - div 10
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicSignedDiv7pos,
-											"IdiomsMagicDivMod::magicSignedDiv7pos");
+		addBasicBlockIdiom(&IdiomsLLVM::exchangeCompareSlt, Instruction::And,
+									"IdiomsLLVM::exchangeCompareSlt", IdiomShape::BOOL);
 
-				// Found in PowerPC - the same as previous, but the divisor
-				// is negative, i.e. div -10
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicSignedDiv7neg,
-											"IdiomsMagicDivMod::magicSignedDiv7neg");
+		addBasicBlockIdiom(&IdiomsLLVM::exchangeCompareSle, Instruction::Or,
+								"IdiomsLLVM::exchangeCompareSle", IdiomShape::BOOL);
+	}
+}
 
-				// Found in PowerPC - div 6
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicSignedDiv8pos,
-											"IdiomsMagicDivMod::magicSignedDiv8pos");
+/**
+ * Add basic-block idiom to the end of the list of enabled idioms
+ *
+ * @param exchanger instruction idiom exchanger
+ * @param opcode opcode of the root instruction of the idiom
+ * @param fname instruction idiom exchanger name (for debug purpose only)
+ * @param shape shape of the root instruction of the idiom
+ */
+void IdiomsAnalysis::addBasicBlockIdiom(Exchanger exchanger, unsigned opcode,
+		const char * fname, IdiomShape shape) {
+	m_bbIdioms.push_back({exchanger, opcode, shape, fname});
+}
 
-				// Found in PowerPC - the same as previous, but the divisor
-				// is negative, i.e. div -3
-				change_made |= analyse(bb, &IdiomsMagicDivMod::magicSignedDiv8neg,
-											"IdiomsMagicDivMod::magicSignedDiv8neg");
+/**
+ * Analyse given BasicBlock and use all enabled instruction exchangers to
+ * transform instruction idioms
+ *
+ * Instructions of the block are indexed by their opcode in a single sweep
+ * and every exchanger is called only on the instructions with the opcode and
+ * shape of its root. The result is the same as if every exchanger walked the
+ * whole block: the index is in block order, instructions inserted during an
+ * exchange precede the replaced instruction (so the same exchanger would not
+ * visit them anyway) and the index is built again before the next exchanger
+ * only if the block has changed.
+ *
+ * @param bb BasicBlock to analyse
+ */
+bool IdiomsAnalysis::analyse(llvm::BasicBlock & bb) {
+	bool change_made = false;
 
-				change_made |= analyse(bb, &IdiomsMagicDivMod::unsignedMod,
-											"IdiomsMagicDivMod::unsignedMod");
+	// Exchangers erase only the replaced instruction and instructions of its
+	// idiom tree, which precede it, so the rest of the index stays valid.
+	DenseMap<unsigned, SmallVector<Instruction *, 8>> index;
+	bool index_valid = false;
+
+	for (const BasicBlockIdiom & idiom : m_bbIdioms) {
+		if (! index_valid) {
+			index.clear();
+			for (Instruction & insn : bb)
+				index[insn.getOpcode()].push_back(&insn);
+			index_valid = true;
 		}
 
-		// all arch
-		if (cc == CC_GCC || cc == CC_ANY)
-			change_made |= analyse(bb, &IdiomsGCC::exchangeSignedModuloByTwo,
-										"IdiomsGCC::exchangeSignedModuloByTwo");
+		auto roots = index.find(idiom.opcode);
+		if (roots == index.end())
+			continue;
 
-		// PowerPC model lacks FPU and x86 uses x87.
-		if (arch == ARCH_ARM || arch == ARCH_THUMB || arch == ARCH_MIPS || arch == ARCH_ANY)
-			if (cc == CC_GCC || cc == CC_ANY)
-				change_made |= analyse(bb, &IdiomsGCC::exchangeCopysign,
-											"IdiomsGCC::exchangeCopysign");
+		for (Instruction * insn : roots->second) {
+			if (idiom.shape == IdiomShape::BOOL && ! insn->getType()->isIntegerTy(1))
+				continue;
 
-		// PowerPC model lacks FPU and x86 uses x87.
-		if (arch == ARCH_ARM || arch == ARCH_THUMB || arch == ARCH_MIPS || arch == ARCH_ANY)
-			if (cc == CC_GCC || cc == CC_ANY)
-				change_made |= analyse(bb, &IdiomsGCC::exchangeFloatAbs,
-											"IdiomsGCC::exchangeFloatAbs");
+			Instruction * res = (this->*idiom.exchanger)(insn->getIterator());
 
-		if (arch == ARCH_x86 || arch == ARCH_ANY)
-			if (cc == CC_Intel || cc == CC_VStudio || cc == CC_ANY)
-				change_made |= analyse(bb, &IdiomsVStudio::exchangeOrMinusOneAssign,
-											"IdiomsVStudio::exchangeOrMinusOneAssign");
+			if (res) {
+				change_made = true;
+				index_valid = false;
+				exchange(insn, res);
+			}
+		}
+	}
 
-		if (arch == ARCH_x86 || arch == ARCH_ANY)
-			if (cc == CC_Intel || cc == CC_VStudio || cc == CC_ANY)
-				change_made |= analyse(bb, &IdiomsVStudio::exchangeAndZeroAssign,
-										"IdiomsVStudio::exchangeAndZeroAssign");
+	return change_made;
+}
 
-		// all arch
-		if (cc == CC_GCC || cc == CC_ANY)
-			change_made |= analyse(bb, &IdiomsGCC::exchangeCondBitShiftDiv1,
-										"IdiomsGCC::exchangeCondBitShiftDiv1");
+/**
+ * Replace instruction with the result of instruction idiom exchanger
+ *
+ * @param insn instruction to replace
+ * @param res new instruction, not inserted into any basic block yet
+ */
+void IdiomsAnalysis::exchange(llvm::Instruction * insn, llvm::Instruction * res) {
+	insn->replaceAllUsesWith(res);
 
-		// all arch
-		if (cc == CC_GCC || cc == CC_ANY)
-			change_made |= analyse(bb, &IdiomsGCC::exchangeCondBitShiftDiv2,
-										"IdiomsGCC::exchangeCondBitShiftDiv2");
+	// Move the name to the new instruction first.
+	res->takeName(insn);
 
-		// all arch
-		if (cc == CC_GCC || cc == CC_ANY)
-			change_made |= analyse(bb, &IdiomsGCC::exchangeCondBitShiftDiv3,
-										"IdiomsGCC::exchangeCondBitShiftDiv3");
-
-		// all arch
-		if (cc == CC_GCC || cc == CC_Intel || cc == CC_LLVM || cc == CC_VStudio || cc == CC_ANY)
-			change_made |= analyse(bb, &IdiomsCommon::exchangeSignedModulo2n,
-										"IdiomsCommon::exchangeSignedModulo2n");
-
-		// all arch
-		if (cc == CC_GCC || cc == CC_Intel || cc == CC_ANY)
-			change_made |= analyse(bb, &IdiomsCommon::exchangeGreaterEqualZero,
-										"IdiomsCommon::exchangeGreaterEqualZero");
-
-		// all arch
-		if (cc == CC_GCC || cc == CC_LLVM || cc == CC_VStudio || cc == CC_ANY)
-			change_made |= analyse(bb, &IdiomsGCC::exchangeXorMinusOne,
-										"IdiomsGCC::exchangeXorMinusOne");
-
-		if (arch == ARCH_POWERPC || arch == ARCH_ARM || arch == ARCH_THUMB || arch == ARCH_MIPS || arch == ARCH_ANY)
-			if (cc == CC_GCC || cc == CC_ANY)
-				change_made |= analyse(bb, &IdiomsCommon::exchangeDivByMinusTwo,
-											"IdiomsCommon::exchangeDivByMinusTwo");
-
-		// all arch
-		if (cc == CC_GCC || cc == CC_Intel || cc == CC_LLVM || cc == CC_ANY)
-			change_made |= analyse(bb, &IdiomsCommon::exchangeLessThanZero,
-										"IdiomsCommon::exchangeLessThanZero");
-
-		// PowerPC model lacks FPU and x86 uses x87.
-		if (cc == CC_GCC || cc == CC_ANY)
-			if (arch == ARCH_ARM || arch == ARCH_THUMB || arch == ARCH_MIPS || arch == ARCH_ANY)
-				change_made |= analyse(bb, &IdiomsGCC::exchangeFloatNeg,
-											"IdiomsGCC::exchangeFloatNeg");
+	// Insert the new instruction into the basic block...
+	BasicBlock * InstParent = insn->getParent();
+	BasicBlock::iterator pos = insn->getIterator();
 
-		// all arch
-		if (cc == CC_GCC || cc == CC_ANY)
-			change_made |= analyse(bb, &IdiomsCommon::exchangeUnsignedModulo2n,
-										"IdiomsCommon::exchangeUnsignedModulo2n");
-
-		// all arch
-		if (cc == CC_LLVM || cc == CC_ANY)
-				change_made |= analyse(bb, &IdiomsLLVM::exchangeIsGreaterThanMinusOne,
-											"IdiomsLLVM::exchangeIsGreaterThanMinusOne");
-
-		// all arch
-		// all compilers
-		change_made |= analyse(bb, &IdiomsCommon::exchangeBitShiftSDiv1,
-									"IdiomsCommon::exchangeBitShiftSDiv1");
-
-		// all arch
-		// all compilers
-		change_made |= analyse(bb, &IdiomsCommon::exchangeBitShiftUDiv,
-									"IdiomsCommon::exchangeBitShiftUDiv");
-
-		// all arch
-		// all compilers
-		change_made |= analyse(bb, &IdiomsCommon::exchangeBitShiftMul,
-									"IdiomsCommon::exchangeBitShiftMul");
-
-		// all arch
-		if (cc == CC_LLVM || cc == CC_ANY) {
-			change_made |= analyse(bb, &IdiomsLLVM::exchangeIsGreaterThanMinusOne,
-										"IdiomsLLVM::exchangeIsGreaterThanMinusOne");
-		}
+	// If we replace a PHI with something that isn't a PHI,
+	// fix up the insertion point.
+	if (! isa<PHINode>(res) && isa<PHINode>(insn))
+		pos = InstParent->getFirstInsertionPt();
 
-		// all arch
-		if (cc == CC_LLVM || cc == CC_ANY) {
-			change_made |= analyse(bb, &IdiomsLLVM::exchangeCompareEq,
-										"IdiomsLLVM::exchangeCompareEq");
+	InstParent->getInstList().insert(pos, res);
 
-	#if 0
-			/* We do not recognize this well */
-			change_made |= analyse(bb, &IdiomsLLVM::exchangeCompareNeq,
-										"IdiomsLLVM::exchangeCompareNeq");
-	#endif
+	insn->eraseFromParent();
+}
 
-			change_made |= analyse(bb, &IdiomsLLVM::exchangeCompareSlt,
-										"IdiomsLLVM::exchangeCompareSlt");
+/**
+ * Do instruction idioms analysis pass
+ *
+ * @param f Function to analyse for instruction idioms
+ * @param p actual pass
+ * @return true whenever an exchange has been made, otherwise 0
+ */
+bool IdiomsAnalysis::doAnalysis(Function & f, Pass * p) {
+	/*
+	 * Instruction idioms are inspected in a tree of Instructions. Every
+	 * instruction idiom has to be called on a basic block. Basic-block idioms
+	 * and their order are set up in initBasicBlockIdioms().
+	 */
+	bool change_made = false; // was there any exchange?
 
-			change_made |= analyse(bb, &IdiomsLLVM::exchangeCompareSle,
-									"IdiomsLLVM::exchangeCompareSle");
-		}
+	CC_compiler cc = getCompiler();
+
+	// Inspect multi-basic block idioms
+	if (cc == CC_GCC || cc == CC_ANY) {
+		change_made |= analyse(f, p, &IdiomsGCC::exchangeCondBitShiftDivMultiBB,
+									"IdiomsGCC::exchangeCondBitShiftDivMultiBB");
 	}
 
+	// Inspect basic-block idioms
+	for (Function::iterator b = f.begin(); b != f.end(); ++b)
+		change_made |= analyse(*b);
+
 	return change_made;
 }
 
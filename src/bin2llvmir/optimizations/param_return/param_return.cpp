@@ -15,6 +15,7 @@
 #include <llvm/IR/Instructions.h>
 
 #include "retdec/utils/container.h"
+#include "retdec/utils/parallel.h"
 #include "retdec/utils/string.h"
 #include "retdec/bin2llvmir/optimizations/param_return/filter/filter.h"
 #include "retdec/bin2llvmir/optimizations/param_return/param_return.h"
@@ -110,6 +111,11 @@ bool ParamReturn::run()
  * Collect possible arguments' stores for all calls we want to analyze.
  * At the moment, we analyze only indirect or declared function calls with no
  * arguments inside one basic block.
+ *
+ * Entries of all the functions and calls are created first, together with
+ * their extra data (LTI, debug info, config), whose sources are not
+ * thread-safe. Collectors then only read the IR and the results of RDA, so
+ * they fill the entries of all the functions in parallel.
  */
 void ParamReturn::collectAllCalls()
 {
@@ -125,34 +131,89 @@ void ParamReturn::collectAllCalls()
 					createDataFlowEntry(&f)));
 	}
 
+	std::vector<FunctionData> functions;
 	for (auto& f : _module->getFunctionList())
-	for (auto& b : f)
-	for (auto& i : b)
 	{
-		auto* call = dyn_cast<CallInst>(&i);
-		if (call == nullptr || call->getNumArgOperands() != 0)
-		{
-			continue;
-		}
+		FunctionData data;
 
-		auto* calledVal = call->getCalledValue();
-		auto* calledFnc = call->getCalledFunction();
-
-		if (calledFnc && calledFnc->isIntrinsic())
+		auto defIt = _fnc2calls.find(&f);
+		if (defIt != _fnc2calls.end())
 		{
-			continue;
+			data.definition = &defIt->second;
 		}
 
-		auto fIt = _fnc2calls.find(calledVal);
-		if (fIt == _fnc2calls.end())
+		for (auto& b : f)
+		for (auto& i : b)
 		{
-			fIt = _fnc2calls.emplace(
-				std::make_pair(
-					calledVal,
-					createDataFlowEntry(calledVal))).first;
+			auto* call = dyn_cast<CallInst>(&i);
+			if (call == nullptr || call->getNumArgOperands() != 0)
+			{
+				continue;
+			}
+
+			auto* calledVal = call->getCalledValue();
+			auto* calledFnc = call->getCalledFunction();
+
+			if (calledFnc && calledFnc->isIntrinsic())
+			{
+				continue;
+			}
+
+			auto fIt = _fnc2calls.find(calledVal);
+			if (fIt == _fnc2calls.end())
+			{
+				fIt = _fnc2calls.emplace(
+					std::make_pair(
+						calledVal,
+						createDataFlowEntry(calledVal))).first;
+			}
+
+			data.calls.emplace_back(
+					&fIt->second,
+					addDataFromCall(&fIt->second, call));
 		}
 
-		addDataFromCall(&fIt->second, call);
+		// Collectors look up stack variables in the config, which caches
+		// config functions of LLVM functions on the first lookup.
+		_config->getConfigFunction(&f);
+
+		functions.push_back(std::move(data));
+	}
+
+	parallelFor(functions.size(), [this, &functions](std::size_t i)
+	{
+		collectFunctionData(functions[i]);
+	});
+}
+
+/**
+ * Collect data of the definition and of all the calls in a single function.
+ * Only the entries in @a data are modified, so this can be run for more
+ * functions at once.
+ */
+void ParamReturn::collectFunctionData(const FunctionData& data) const
+{
+	if (auto* dataflow = data.definition)
+	{
+		_collector->collectDefArgs(dataflow);
+		_collector->collectDefRets(dataflow);
+	}
+
+	for (auto& call : data.calls)
+	{
+		auto* ce = &call.first->callEntries()[call.second];
+
+		_collector->collectCallArgs(ce);
+
+		// TODO: Use info from collecting return loads.
+		//
+		// At this moment info return loads is not used
+		// as it is not reliable source of info
+		// about return value. To enable this
+		// collector must have redesigned and reimplemented
+		// collection algorithm.
+		//
+		//_collector->collectCallRets(ce);
 	}
 }
 
@@ -160,9 +221,6 @@ DataFlowEntry ParamReturn::createDataFlowEntry(Value* calledValue) const
 {
 	DataFlowEntry dataflow(calledValue);
 
-	_collector->collectDefArgs(&dataflow);
-	_collector->collectDefRets(&dataflow);
-
 	collectExtraData(&dataflow);
 
 	return dataflow;
@@ -535,23 +593,18 @@ CallInst* ParamReturn::getWrapper(Function* fnc) const
 	return nullptr;
 }
 
-void ParamReturn::addDataFromCall(DataFlowEntry *dataflow, CallInst *call) const
+/**
+ * Create entry of the call @a call of @a dataflow. Its data are collected
+ * later by collectFunctionData().
+ * @return Index of the created entry in the call entries of @a dataflow.
+ */
+std::size_t ParamReturn::addDataFromCall(DataFlowEntry *dataflow, CallInst *call) const
 {
 	CallEntry* ce = dataflow->createCallEntry(call);
 
-	_collector->collectCallArgs(ce);
-
-	// TODO: Use info from collecting return loads.
-	//
-	// At this moment info return loads is not used
-	// as it is not reliable source of info
-	// about return value. To enable this
-	// collector must have redesigned and reimplemented
-	// collection algorithm.
-	//
-	//_collector->collectCallRets(ce);
-
 	collectExtraData(ce);
+
+	return dataflow->callEntries().size() - 1;
 }
 
 void ParamReturn::collectExtraData(CallEntry* ce) const
@@ -22,7 +22,7 @@
 #include "retdec/bin2llvmir/providers/names.h"
 #include "retdec/cpdetect/cpdetect.h"
 #include "retdec/utils/string.h"
-#include "retdec/yaracpp/yara_detector.h"
+#include "retdec/yaracpp/yara_scan_session.h"
 
 using namespace llvm;
 using namespace retdec::utils::io;
@@ -266,6 +266,16 @@ bool ProviderInitialization::runOnModule(Module& m)
 		throw std::runtime_error("Unsupported target format and architecture combination");
 	}
 
+	// Signatures of cpdetect and crypto patterns are matched by one YARA
+	// scan of the input file.
+	//
+	const auto& inputBytes = f->getFileFormat()->getBytes();
+	yaracpp::YaraScanSession yaraSession(inputBytes.data(), inputBytes.size());
+	const auto& cryptoPaths = c->getConfig().parameters.cryptoPatternPaths;
+	const auto cryptoRuleSet = yaraSession.addRuleSet(
+			std::vector<std::string>(cryptoPaths.begin(), cryptoPaths.end())
+	);
+
 	// Run cpdetect and set info to config.
 	// TODO: we could probably be using cpdetect results.
 	//
@@ -276,6 +286,7 @@ bool ProviderInitialization::runOnModule(Module& m)
 			false,
 			50 // ep bytes size
 	);
+	searchParams.scanSession = &yaraSession;
 	cpdetect::CompilerDetector cd(
 			*f->getFileFormat(),
 			searchParams,
@@ -354,15 +365,11 @@ bool ProviderInitialization::runOnModule(Module& m)
 		c->getConfig().architecture.setIsPic32();
 	}
 
-	// YARA crypto patterns scanning.
+	// YARA crypto patterns (scanned together with cpdetect signatures,
+	// unless cpdetect did not get to them).
 	//
-	yaracpp::YaraDetector yara;
-	for (auto& crypto : c->getConfig().parameters.cryptoPatternPaths)
-	{
-		yara.addRuleFile(crypto);
-	}
-	yara.analyze(c->getConfig().parameters.getInputFile());
-	for(const auto &rule : yara.getDetectedRules())
+	yaraSession.scan();
+	for(const auto &rule : yaraSession.getDetectedRules(cryptoRuleSet))
 	{
 		common::Pattern p = saveCryptoRule(
 				rule,
@@ -392,11 +399,21 @@ bool ProviderInitialization::runOnModule(Module& m)
 		throw std::runtime_error("ProviderInitialization: d == nullptr");
 	}
 
+	// If only the selected ranges are decoded, debug info of the rest of the
+	// file is not needed. Functions selected by name may be anywhere.
+	auto& params = c->getConfig().parameters;
+	common::AddressRangeContainer dwarfRanges;
+	if (params.isSelectedDecodeOnly() && params.selectedFunctions.empty())
+	{
+		dwarfRanges = params.selectedRanges;
+	}
+
 	auto* debug = DebugFormatProvider::addDebugFormat(
 			&m,
 			f->getImage(),
-			c->getConfig().parameters.getInputPdbFile(),
-			d
+			params.getInputPdbFile(),
+			d,
+			dwarfRanges
 	);
 
 	auto* lti = LtiProvider::addLti(&m, c, typeConfig, f->getImage());
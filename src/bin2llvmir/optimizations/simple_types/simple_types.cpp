@@ -89,10 +89,19 @@ bool SimpleTypesAnalysis::runOnModule(Module& M)
 		first = false;
 
 		RDA.runOnModule(M, AbiProvider::getAbi(&M));
+		unionFind = config->getConfig().parameters.isSimpleTypesUnionFind();
 		buildEqSets(M);
-		buildEquations();
-		eqSets.propagate(module);
-		eqSets.apply(module, config, objf, instToErase);
+		if (unionFind)
+		{
+			typeClasses.apply(module, config, objf, instToErase);
+			typeClasses.clear();
+		}
+		else
+		{
+			buildEquations();
+			eqSets.propagate(module);
+			eqSets.apply(module, config, objf, instToErase);
+		}
 		eraseObsoleteInstructions();
 		setGlobalConstants();
 		RDA.clear();
@@ -331,7 +340,11 @@ void SimpleTypesAnalysis::buildEqSets(Module& M)
 
 void SimpleTypesAnalysis::processRoot(Value* root)
 {
-	if (processedObjs.find(root) == processedObjs.end())
+	if (unionFind)
+	{
+		processRootUnionFind(root);
+	}
+	else if (processedObjs.find(root) == processedObjs.end())
 	{
 		auto& eqSet = eqSets.createEmptySet();
 		LOG << "[ROOT #" << eqSet.id << "]: " << llvmObjToString(root) << std::endl;
@@ -346,6 +359,57 @@ void SimpleTypesAnalysis::processRoot(Value* root)
 	}
 }
 
+/**
+ * The same as @c processRoot() followed by @c processValue(), but the found
+ * values are added to @c typeClasses. Unlike with equivalence sets, values
+ * that were already found from other roots are not skipped -- their classes
+ * are merged.
+ */
+void SimpleTypesAnalysis::processRootUnionFind(Value* root)
+{
+	if (typeClasses.contains(root))
+	{
+		return;
+	}
+
+	// Values are added to the classes when they are found, so each of them
+	// is processed only once.
+	std::queue<std::pair<Value*, TypeClasses::Id>> toProcess;
+	std::queue<Value*> found;
+	std::vector<TypeEntry> types;
+
+	toProcess.push({root, typeClasses.insert(module, config, root)});
+
+	while (!toProcess.empty())
+	{
+		auto* current = toProcess.front().first;
+		auto id = toProcess.front().second;
+		toProcess.pop();
+
+		for (auto uIt = current->user_begin(); uIt != current->user_end(); ++uIt)
+		{
+			processUse(current, *uIt, found, types);
+
+			for (; !found.empty(); found.pop())
+			{
+				bool inserted = false;
+				auto* v = found.front();
+				auto vId = typeClasses.insert(module, config, v, &inserted);
+				typeClasses.unite(module, id, vId);
+				if (inserted)
+				{
+					toProcess.push({v, vId});
+				}
+			}
+			for (auto& t : types)
+			{
+				typeClasses.insert(module, id, t.type, t.priority);
+			}
+			types.clear();
+		}
+	}
+}
+
 /**
  * While not empty, pop value from @p toProcess queue and add it to @p eqSet.
  * Go through all users of this value and based on their instruction types do one of the following:
@@ -374,14 +438,23 @@ void SimpleTypesAnalysis::processValue(std::queue<Value*>& toProcess, EqSet& eqS
 		eqSet.insert(config, current);
 		processedObjs.insert({current, &eqSet});
 
+		std::vector<TypeEntry> types;
 		for (auto uIt = current->user_begin(); uIt != current->user_end(); ++uIt)
 		{
-			processUse(current, *uIt, toProcess, eqSet);
+			processUse(current, *uIt, toProcess, types);
+		}
+		for (auto& t : types)
+		{
+			eqSet.insert(t.type, t.priority);
 		}
 	}
 }
 
-void SimpleTypesAnalysis::processUse(llvm::Value* current, Value* u, std::queue<Value*>& toProcess, EqSet& eqSet)
+/**
+ * Find values equivalent to @p current based on its use @p u. Values are
+ * added to @p toProcess, types (without values) to @p types.
+ */
+void SimpleTypesAnalysis::processUse(llvm::Value* current, Value* u, std::queue<Value*>& toProcess, std::vector<TypeEntry>& types)
 {
 	if (auto* eu = dyn_cast<ConstantExpr>(u))
 	{
@@ -456,7 +529,7 @@ void SimpleTypesAnalysis::processUse(llvm::Value* current, Value* u, std::queue<
 			p = eSourcePriority::PRIORITY_LTI;
 		}
 
-		eqSet.insert(fnc->getReturnType(), p);
+		types.push_back({fnc->getReturnType(), p});
 	}
 	else if (isa<BranchInst>(user))
 	{
@@ -670,7 +743,7 @@ void SimpleTypesAnalysis::processUse(llvm::Value* current, Value* u, std::queue<
 			{
 				if (tmp == current && tmp->getType() != Abi::getDefaultType(module))
 				{
-					eqSet.insert(tmp->getType(), eSourcePriority::PRIORITY_LTI);
+					types.push_back({tmp->getType(), eSourcePriority::PRIORITY_LTI});
 					break;
 				}
 			}
@@ -772,64 +845,71 @@ EqSet::EqSet(std::size_t id) :
 
 void EqSet::insert(Config* config, llvm::Value* v, eSourcePriority p)
 {
-	auto& conf = config->getConfig();
-
-	if (p != eSourcePriority::PRIORITY_NONE)
+	if (p == eSourcePriority::PRIORITY_NONE)
 	{
-		valSet.insert( {v,p} );
+		p = getPriority(config, v);
 	}
-	else
+
+	valSet.insert( {v,p} );
+}
+
+/**
+ * @return Priority of the type of value @p v -- @c PRIORITY_DEBUG if its type
+ *         comes from debug information, @c PRIORITY_NONE otherwise.
+ */
+eSourcePriority EqSet::getPriority(Config* config, llvm::Value* v)
+{
+	auto& conf = config->getConfig();
+
+	if (auto* fnc = dyn_cast<Function>(v))
 	{
-		if (auto* fnc = dyn_cast<Function>(v))
+		auto* cf = conf.functions.getFunctionByName(fnc->getName());
+		if (cf && cf->isFromDebug())
 		{
-			auto* cf = conf.functions.getFunctionByName(fnc->getName());
-			if (cf && cf->isFromDebug())
-			{
-				p = eSourcePriority::PRIORITY_DEBUG;
-			}
+			return eSourcePriority::PRIORITY_DEBUG;
 		}
-		else if (auto* alloca = dyn_cast<AllocaInst>(v))
-		{
-			assert(alloca->getParent());
-			assert(alloca->getParent()->getParent());
-			auto* fnc = alloca->getParent()->getParent();
+	}
+	else if (auto* alloca = dyn_cast<AllocaInst>(v))
+	{
+		assert(alloca->getParent());
+		assert(alloca->getParent()->getParent());
+		auto* fnc = alloca->getParent()->getParent();
 
-			auto* cf = conf.functions.getFunctionByName(fnc->getName());
-			if (cf)
-			{
-				auto* local = cf->locals.getObjectByName(alloca->getName());
-				if (local && local->isFromDebug())
-				{
-					p = eSourcePriority::PRIORITY_DEBUG;
-				}
-			}
-		}
-		else if (auto* global = dyn_cast<GlobalVariable>(v))
+		auto* cf = conf.functions.getFunctionByName(fnc->getName());
+		if (cf)
 		{
-			auto* cg = conf.globals.getObjectByName(global->getName());
-			if (cg && cg->isFromDebug())
+			auto* local = cf->locals.getObjectByName(alloca->getName());
+			if (local && local->isFromDebug())
 			{
-				p = eSourcePriority::PRIORITY_DEBUG;
+				return eSourcePriority::PRIORITY_DEBUG;
 			}
 		}
-		else if (auto* param = dyn_cast<Argument>(v))
+	}
+	else if (auto* global = dyn_cast<GlobalVariable>(v))
+	{
+		auto* cg = conf.globals.getObjectByName(global->getName());
+		if (cg && cg->isFromDebug())
 		{
-			assert(param->getParent());
-			auto* fnc = param->getParent();
+			return eSourcePriority::PRIORITY_DEBUG;
+		}
+	}
+	else if (auto* param = dyn_cast<Argument>(v))
+	{
+		assert(param->getParent());
+		auto* fnc = param->getParent();
 
-			auto* cf = conf.functions.getFunctionByName(fnc->getName());
-			if (cf)
+		auto* cf = conf.functions.getFunctionByName(fnc->getName());
+		if (cf)
+		{
+			auto* cp = cf->parameters.getObjectByName(param->getName());
+			if (cp && cp->isFromDebug())
 			{
-				auto* cp = cf->parameters.getObjectByName(param->getName());
-				if (cp && cp->isFromDebug())
-				{
-					p = eSourcePriority::PRIORITY_DEBUG;
-				}
+				return eSourcePriority::PRIORITY_DEBUG;
 			}
 		}
-
-		valSet.insert( {v,p} );
 	}
+
+	return eSourcePriority::PRIORITY_NONE;
 }
 
 void EqSet::insert(llvm::Type* t, eSourcePriority p)
@@ -1158,63 +1238,52 @@ void EqSet::propagate(llvm::Module* module)
 
 	for (auto& vs : valSet)
 	{
-		Type* valueType = vs.getTypeForPropagation();
+		joinType(module, masterType, vs.getTypeForPropagation(), vs.priority);
+	}
+	for (auto& ts : typeSet)
+	{
+		joinType(module, masterType, ts.type, ts.priority);
+	}
 
-		if (vs.priority < masterType.priority)
-		{
-			continue;
-		}
-		else if (vs.priority == masterType.priority)
-		{
-			if (valueType != masterType.type && masterType.priority != eSourcePriority::PRIORITY_NONE)
-			{
-				LOG << "[WARNING] same priority types differ: "
-					<< llvmObjToString(valueType) << " vs. "
-					<< llvmObjToString(masterType.type) << std::endl;
-			}
+	LOG << *this;
+	LOG << "\npropagate END   " << id << " =============================\n";
+}
 
-			auto* r = getHigherPriorityType(module, masterType.type, valueType);
-			if (r == valueType)
-			{
-				masterType.type = valueType;
-			}
-		}
-		else if (vs.priority > masterType.priority)
-		{
-			masterType.priority = vs.priority;
-			masterType.type = valueType;
-		}
+/**
+ * Join type @p t of priority @p p into @p masterType -- a type of a higher
+ * priority wins, from the types of the same priority, the higher one (see
+ * @c getHigherPriorityType()) wins.
+ */
+void EqSet::joinType(
+		llvm::Module* module,
+		TypeEntry& masterType,
+		llvm::Type* t,
+		eSourcePriority p)
+{
+	if (p < masterType.priority)
+	{
+		return;
 	}
-	for (auto& ts : typeSet)
+	else if (p == masterType.priority)
 	{
-		if (ts.priority < masterType.priority)
+		if (t != masterType.type && masterType.priority != eSourcePriority::PRIORITY_NONE)
 		{
-			continue;
+			LOG << "[WARNING] same priority types differ: "
+				<< llvmObjToString(t) << " vs. "
+				<< llvmObjToString(masterType.type) << std::endl;
 		}
-		else if (ts.priority == masterType.priority)
-		{
-			if (ts.type != masterType.type && masterType.priority != eSourcePriority::PRIORITY_NONE)
-			{
-				LOG << "[WARNING] same priority types differ: "
-					<< llvmObjToString(ts.type) << " vs. "
-					<< llvmObjToString(masterType.type) << std::endl;
-			}
 
-			auto* r = getHigherPriorityType(module, masterType.type, ts.type);
-			if (r == ts.type)
-			{
-				masterType.type = ts.type;
-			}
-		}
-		else if (ts.priority > masterType.priority)
+		auto* r = getHigherPriorityType(module, masterType.type, t);
+		if (r == t)
 		{
-			masterType.priority = ts.priority;
-			masterType.type = ts.type;
+			masterType.type = t;
 		}
 	}
-
-	LOG << *this;
-	LOG << "\npropagate END   " << id << " =============================\n";
+	else
+	{
+		masterType.priority = p;
+		masterType.type = t;
+	}
 }
 
 void EqSet::apply(
@@ -1228,45 +1297,59 @@ void EqSet::apply(
 
 	LOG << "\napply BEGIN " << id << " =============================\n";
 
-	auto &conf = config->getConfig();
-
 	IrModifier irModif(module, config);
 	for (auto& vs : valSet)
 	{
-		if (!(isa<AllocaInst>(vs.value) || isa<GlobalVariable>(vs.value) || isa<Argument>(vs.value)))
-		{
-			continue;
-		}
-		if (vs.getTypeForPropagation() == masterType.type
-				|| masterType.type == nullptr
-				|| (vs.priority >= masterType.priority && vs.priority > eSourcePriority::PRIORITY_NONE)
-				|| vs.getTypeForPropagation()->isAggregateType())
-		{
-			continue;
-		}
-		if (conf.registers.getObjectByName(vs.value->getName()))
-		{
-			continue;
-		}
-		if (masterType.type->isPointerTy())
+		applyType(irModif, config, objf, vs, masterType, instToErase);
+	}
+
+	LOG << "\napply END   " << id << " =============================\n";
+}
+
+/**
+ * Change the type of value @p vs to the type @p masterType of its equivalence
+ * set, if it is an object (local or global variable, or parameter) and it
+ * should be changed.
+ */
+void EqSet::applyType(
+		IrModifier& irModif,
+		Config* config,
+		FileImage* objf,
+		const ValueEntry& vs,
+		const TypeEntry& masterType,
+		std::unordered_set<llvm::Instruction*>& instToErase)
+{
+	if (!(isa<AllocaInst>(vs.value) || isa<GlobalVariable>(vs.value) || isa<Argument>(vs.value)))
+	{
+		return;
+	}
+	if (vs.getTypeForPropagation() == masterType.type
+			|| masterType.type == nullptr
+			|| (vs.priority >= masterType.priority && vs.priority > eSourcePriority::PRIORITY_NONE)
+			|| vs.getTypeForPropagation()->isAggregateType())
+	{
+		return;
+	}
+	if (config->getConfig().registers.getObjectByName(vs.value->getName()))
+	{
+		return;
+	}
+	if (masterType.type->isPointerTy())
+	{
+		llvm::Value* vsv = vs.value;
+		if (vsv->getType()->isPointerTy())
 		{
-			llvm::Value* vsv = vs.value;
-			if (vsv->getType()->isPointerTy())
+			llvm::Type* ptr = vsv->getType()->getPointerElementType();
+			if (ptr->isPointerTy() || ptr->isArrayTy())
 			{
-				llvm::Type* ptr = vsv->getType()->getPointerElementType();
-				if (ptr->isPointerTy() || ptr->isArrayTy())
-				{
-					continue;
-				}
+				return;
 			}
 		}
-
-		LOG << "\t" << vs << "  ==>  " << llvmObjToString(masterType.type) << std::endl;
-
-		irModif.changeObjectType(objf, vs.value, masterType.type, nullptr, &instToErase);
 	}
 
-	LOG << "\napply END   " << id << " =============================\n";
+	LOG << "\t" << vs << "  ==>  " << llvmObjToString(masterType.type) << std::endl;
+
+	irModif.changeObjectType(objf, vs.value, masterType.type, nullptr, &instToErase);
 }
 
 std::ostream& operator<<(std::ostream &out, const EqSet &eq)
@@ -1292,6 +1375,198 @@ std::ostream& operator<<(std::ostream &out, const EqSet &eq)
 	return out;
 }
 
+//
+//=============================================================================
+//  TypeClasses
+//=============================================================================
+//
+
+bool TypeClasses::contains(llvm::Value* v) const
+{
+	return ids.count(v);
+}
+
+/**
+ * Insert value @p v into its own class, if it is not in any class yet.
+ * @param module  Module used to compare types.
+ * @param config  Config used to find out the priority of the value's type.
+ * @param v       Value to insert.
+ * @param inserted If not @c nullptr, set to @c true if the value was
+ *                 inserted, @c false if it already was in some class.
+ * @return ID of the value.
+ */
+TypeClasses::Id TypeClasses::insert(
+		llvm::Module* module,
+		Config* config,
+		llvm::Value* v,
+		bool* inserted)
+{
+	auto res = ids.insert({v, static_cast<Id>(values.size())});
+	if (inserted)
+	{
+		*inserted = res.second;
+	}
+	if (!res.second)
+	{
+		return res.first->second;
+	}
+
+	Id id = res.first->second;
+	values.emplace_back(v, EqSet::getPriority(config, v));
+	parents.push_back(id);
+	classes.emplace_back();
+
+	auto& c = classes.back();
+	c.values = 1;
+	EqSet::joinType(
+			module,
+			c.type,
+			values.back().getTypeForPropagation(),
+			values.back().priority);
+
+	return id;
+}
+
+/**
+ * Add type @p t of priority @p p to the class of value with ID @p id.
+ */
+void TypeClasses::insert(
+		llvm::Module* module,
+		Id id,
+		llvm::Type* t,
+		eSourcePriority p)
+{
+	auto& c = classes[find(id)];
+	if (c.firstType == nullptr)
+	{
+		c.firstType = t;
+	}
+	else if (c.firstType != t)
+	{
+		c.moreTypes = true;
+	}
+	EqSet::joinType(module, c.type, t, p);
+}
+
+/**
+ * @return ID of the representative of the class of value with ID @p id.
+ */
+TypeClasses::Id TypeClasses::find(Id id)
+{
+	Id root = id;
+	while (parents[root] != root)
+	{
+		root = parents[root];
+	}
+
+	// Path compression.
+	while (parents[id] != root)
+	{
+		Id next = parents[id];
+		parents[id] = root;
+		id = next;
+	}
+
+	return root;
+}
+
+/**
+ * Merge classes of values with IDs @p id1 and @p id2.
+ */
+void TypeClasses::unite(llvm::Module* module, Id id1, Id id2)
+{
+	Id r1 = find(id1);
+	Id r2 = find(id2);
+	if (r1 == r2)
+	{
+		return;
+	}
+
+	// Union by size -- the bigger class becomes the representative.
+	if (classes[r1].values < classes[r2].values)
+	{
+		std::swap(r1, r2);
+	}
+	parents[r2] = r1;
+
+	auto& c1 = classes[r1];
+	auto& c2 = classes[r2];
+	c1.values += c2.values;
+	if (c1.firstType == nullptr)
+	{
+		c1.firstType = c2.firstType;
+	}
+	else if (c2.firstType && c2.firstType != c1.firstType)
+	{
+		c1.moreTypes = true;
+	}
+	c1.moreTypes |= c2.moreTypes;
+	EqSet::joinType(module, c1.type, c2.type.type, c2.type.priority);
+
+	c2 = ClassInfo();
+}
+
+/**
+ * @return Type of the class of value with ID @p id.
+ */
+const TypeEntry& TypeClasses::getType(Id id)
+{
+	return classes[find(id)].type;
+}
+
+/**
+ * Classes with at most one value and at most one type are trivial -- they are
+ * not applied, the same as such equivalence sets are not created.
+ */
+bool TypeClasses::isTrivial(Id id)
+{
+	auto& c = classes[find(id)];
+	return c.values <= 1 && !c.moreTypes;
+}
+
+/**
+ * @return Number of values in all the classes.
+ */
+std::size_t TypeClasses::size() const
+{
+	return values.size();
+}
+
+void TypeClasses::clear()
+{
+	ids.clear();
+	values.clear();
+	parents.clear();
+	classes.clear();
+}
+
+/**
+ * The same as @c EqSetContainer::apply().
+ */
+void TypeClasses::apply(
+		llvm::Module* module,
+		Config* config,
+		FileImage* objf,
+		std::unordered_set<llvm::Instruction*>& instToErase)
+{
+	IrModifier irModif(module, config);
+	for (Id id = 0; id < values.size(); ++id)
+	{
+		if (isTrivial(id))
+		{
+			continue;
+		}
+
+		EqSet::applyType(
+				irModif,
+				config,
+				objf,
+				values[id],
+				getType(id),
+				instToErase);
+	}
+}
+
 //
 //=============================================================================
 //  ValueEntry
@@ -6,6 +6,7 @@
 
 #include <llvm/IR/GlobalVariable.h>
 #include <llvm/IR/Module.h>
+#include <llvm/IR/ValueSymbolTable.h>
 
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
 #include "retdec/bin2llvmir/providers/config.h"
@@ -19,6 +20,37 @@ using namespace llvm;
 namespace retdec {
 namespace bin2llvmir {
 
+namespace {
+
+/**
+ * @return Alloca instruction named @a name in function @a fnc, or @c nullptr
+ *         if there is no such alloca. Function's symbol table is used if it
+ *         is available, so that the function does not have to be scanned.
+ */
+llvm::AllocaInst* getAllocaByName(llvm::Function* fnc, const std::string& name)
+{
+	if (auto* vst = fnc->getValueSymbolTable())
+	{
+		return dyn_cast_or_null<AllocaInst>(vst->lookup(name));
+	}
+
+	for (auto& b : *fnc)
+	for (auto& i : b)
+	{
+		if (AllocaInst* a = dyn_cast<AllocaInst>(&i))
+		{
+			if (a->getName() == name)
+			{
+				return a;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+} // anonymous namespace
+
 //
 //=============================================================================
 //  Config
@@ -102,11 +134,36 @@ retdec::common::Address Config::getFunctionAddress(
 retdec::common::Function* Config::getConfigFunction(
 		const llvm::Function* fnc)
 {
+	if (fnc == nullptr)
+	{
+		return nullptr;
+	}
+
+	auto& functions = _configDB.functions;
+	if (_llvm2functionEraseCount != functions.getEraseCount())
+	{
+		_llvm2function.clear();
+		_llvm2functionEraseCount = functions.getEraseCount();
+	}
+
+	auto fit = _llvm2function.find(fnc);
+	if (fit != _llvm2function.end() && fit->second->getName() == fnc->getName())
+	{
+		return fit->second;
+	}
+
 	// TODO: remove horrible const_cast
-	return fnc
-		? const_cast<retdec::common::Function*>(
-				_configDB.functions.getFunctionByName(fnc->getName()))
-		: nullptr;
+	auto* cf = const_cast<retdec::common::Function*>(
+			functions.getFunctionByName(fnc->getName()));
+	if (cf)
+	{
+		_llvm2function[fnc] = cf;
+	}
+	else if (fit != _llvm2function.end())
+	{
+		_llvm2function.erase(fit);
+	}
+	return cf;
 }
 
 retdec::common::Function* Config::getConfigFunction(
@@ -241,16 +298,9 @@ llvm::AllocaInst* Config::getLlvmStackVariable(
 		int off = 0;
 		if (l.getStorage().isStack(off) && off == offset)
 		{
-			for (auto& b : *fnc)
-			for (auto& i : b)
+			if (auto* a = getAllocaByName(fnc, l.getName()))
 			{
-				if (AllocaInst* a = dyn_cast<AllocaInst>(&i))
-				{
-					if (a->getName() == l.getName())
-					{
-						return a;
-					}
-				}
+				return a;
 			}
 		}
 	}
@@ -272,16 +322,9 @@ llvm::AllocaInst* Config::getLlvmStackVariable(
 	{
 		if (l.getRealName() == realName)
 		{
-			for (auto& b : *fnc)
-			for (auto& i : b)
+			if (auto* a = getAllocaByName(fnc, l.getName()))
 			{
-				if (AllocaInst* a = dyn_cast<AllocaInst>(&i))
-				{
-					if (a->getName() == l.getName())
-					{
-						return a;
-					}
-				}
+				return a;
 			}
 		}
 	}
@@ -28,6 +28,8 @@ std::map<Module*, DebugFormat> DebugFormatProvider::_module2debug;
 /**
  * Create and add to provider a debug info for the given module @a m, file
  * image @a objf, pdb file path @a pdbFile, and demangler @a demangler.
+ * If @a dwarfRanges are not empty, only DWARF information overlapping them
+ * is loaded.
  * @return Created and added debug ingo or @c nullptr if something went wrong
  *         and it was not successfully created.
  */
@@ -35,7 +37,8 @@ DebugFormat* DebugFormatProvider::addDebugFormat(
 				llvm::Module* m,
 				retdec::loader::Image* objf,
 				const std::string& pdbFile,
-				Demangler* demangler)
+				Demangler* demangler,
+				const retdec::common::AddressRangeContainer& dwarfRanges)
 {
 	if (objf == nullptr)
 	{
@@ -48,7 +51,8 @@ DebugFormat* DebugFormatProvider::addDebugFormat(
 					objf,
 					pdbFile,
 					nullptr, // symbol table -- not needed.
-					demangler ? demangler->getDemangler() : nullptr
+					demangler ? demangler->getDemangler() : nullptr,
+					dwarfRanges
 			)
 	);
 	return &p.first->second;
@@ -16,6 +16,7 @@
 #include "retdec/ctypes/union_type.h"
 #include "retdec/ctypes/unknown_type.h"
 #include "retdec/ctypes/void_type.h"
+#include "retdec/utils/filesystem.h"
 #include "retdec/utils/string.h"
 #include "retdec/bin2llvmir/providers/lti.h"
 #include "retdec/bin2llvmir/utils/ctypes2llvm.h"
@@ -25,6 +26,21 @@ using namespace llvm;
 namespace retdec {
 namespace bin2llvmir {
 
+namespace {
+
+/**
+ * Call convention of functions in LTI file @a filePath which do not specify
+ * their own.
+ */
+std::string getDefaultCallConvention(const std::string& filePath)
+{
+	return retdec::utils::containsCaseInsensitive(filePath, "win")
+			? "stdcall"
+			: "cdecl";
+}
+
+} // anonymous namespace
+
 //
 //=============================================================================
 //  Lti
@@ -48,11 +64,12 @@ Lti::Lti(
 	_ltiParser = ctypesparser::JSONCTypesParser(
 			static_cast<unsigned>(c->getConfig().architecture.getBitSize()));
 
+	std::vector<std::string> ltiFiles;
 	for (auto& l : _config->getConfig().parameters.libraryTypeInfoPaths)
 	{
 		if (retdec::utils::endsWith(l, "cstdlib.json"))
 		{
-			loadLtiFile(l);
+			ltiFiles.push_back(l);
 		}
 	}
 
@@ -68,12 +85,12 @@ Lti::Lti(
 		if (retdec::utils::endsWith(l, "windows.json")
 				&& _config->getConfig().fileFormat.isPe())
 		{
-			loadLtiFile(l);
+			ltiFiles.push_back(l);
 		}
 		else if (winDriver
 				&& retdec::utils::endsWith(l, "windrivers.json"))
 		{
-			loadLtiFile(l);
+			ltiFiles.push_back(l);
 		}
 		else if (retdec::utils::endsWith(l, "linux.json")
 				&& (_config->getConfig().fileFormat.isElf()
@@ -81,12 +98,38 @@ Lti::Lti(
 				|| _config->getConfig().fileFormat.isIntelHex()
 				|| _config->getConfig().fileFormat.isRaw()))
 		{
-			loadLtiFile(l);
+			ltiFiles.push_back(l);
 		}
 		else if (retdec::utils::endsWith(l, "arm.json") &&
 				_config->getConfig().architecture.isArm32OrThumb())
 		{
-			loadLtiFile(l);
+			ltiFiles.push_back(l);
+		}
+	}
+
+	loadLtiFiles(ltiFiles);
+}
+
+/**
+ * Load LTI files in the given order. Functions from the earlier files take
+ * precedence over the functions with the same names from the later files.
+ *
+ * If all the files have up-to-date precompiled type libraries next to them,
+ * only the libraries are loaded and functions are parsed from them when they
+ * are asked for. Otherwise, all the JSON files are parsed right away.
+ */
+void Lti::loadLtiFiles(const std::vector<std::string>& filePaths)
+{
+	for (auto& f : filePaths)
+	{
+		if (!loadLtiLibrary(f))
+		{
+			_ltiLibraries.clear();
+			for (auto& f : filePaths)
+			{
+				loadLtiFile(f);
+			}
+			return;
 		}
 	}
 }
@@ -96,15 +139,57 @@ void Lti::loadLtiFile(const std::string& filePath)
 	std::ifstream file(filePath);
 	if (file)
 	{
-		std::string cc = "cdecl";
-		if (retdec::utils::containsCaseInsensitive(filePath, "win"))
-		{
-			cc = "stdcall";
-		}
-		_ltiParser.parseInto(file, _ltiModule, _typeConfig->typeWidths(), cc);
+		_ltiParser.parseInto(
+				file,
+				_ltiModule,
+				_typeConfig->typeWidths(),
+				getDefaultCallConvention(filePath));
 	}
 }
 
+/**
+ * Load precompiled type library of LTI file @a filePath.
+ * @return @c True if the library was loaded, @c false if it does not exist,
+ *         is older than the LTI file, or is not valid.
+ */
+bool Lti::loadLtiLibrary(const std::string& filePath)
+{
+	auto libraryPath = ctypesparser::TypeLibrary::getLibraryPath(filePath);
+
+	std::error_code ec;
+	auto libraryTime = fs::last_write_time(libraryPath, ec);
+	if (ec)
+	{
+		return false;
+	}
+	auto fileTime = fs::last_write_time(filePath, ec);
+	if (!ec && fileTime > libraryTime)
+	{
+		return false;
+	}
+
+	std::unique_ptr<ctypesparser::TypeLibrary> library;
+	try
+	{
+		library = ctypesparser::TypeLibrary::fromFile(libraryPath);
+	}
+	catch (const ctypesparser::CTypesParseError&)
+	{
+		return false;
+	}
+	if (library == nullptr)
+	{
+		return false;
+	}
+
+	_ltiLibraries.push_back(LtiLibrary{
+			std::move(library),
+			ctypesparser::JSONCTypesParser(static_cast<unsigned>(
+					_config->getConfig().architecture.getBitSize())),
+			getDefaultCallConvention(filePath)});
+	return true;
+}
+
 bool Lti::hasLtiFunction(const std::string& name)
 {
 	return getLtiFunction(name) != nullptr;
@@ -113,7 +198,27 @@ bool Lti::hasLtiFunction(const std::string& name)
 std::shared_ptr<retdec::ctypes::Function> Lti::getLtiFunction(
 		const std::string& name)
 {
-	return _ltiModule->getFunctionWithName(name);
+	auto ltiFnc = _ltiModule->getFunctionWithName(name);
+	if (ltiFnc)
+	{
+		return ltiFnc;
+	}
+
+	for (auto& l : _ltiLibraries)
+	{
+		ltiFnc = l.parser.parseFunctionInto(
+				*l.library,
+				name,
+				_ltiModule,
+				_typeConfig->typeWidths(),
+				l.callConvention);
+		if (ltiFnc)
+		{
+			return ltiFnc;
+		}
+	}
+
+	return nullptr;
 }
 
 /**
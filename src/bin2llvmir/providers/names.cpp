@@ -478,6 +478,25 @@ std::string NameContainer::getNameFromImportLibAndOrd(
 		const std::string& libName,
 		int ord)
 {
+	auto arch = getImportOrdsArch();
+	if (arch.empty() || ord < 0)
+	{
+		return std::string();
+	}
+
+	// Libraries in the packed database do not have to be loaded from their
+	// text files. Libraries missing in it (e.g. added to the ordinals
+	// directory by hand) still can.
+	if (auto* db = getOrdinalDatabase())
+	{
+		std::string name;
+		if (db->getName(arch, libName, ord, name)
+				|| db->hasLibrary(arch, libName))
+		{
+			return name;
+		}
+	}
+
 	auto it = _dllOrds.find(libName);
 	if (it == _dllOrds.end())
 	{
@@ -501,12 +520,42 @@ std::string NameContainer::getNameFromImportLibAndOrd(
 	return std::string();
 }
 
+/**
+ * \return Name of the ordinals subdirectory for the input's architecture,
+ *         or an empty string if there are no ordinals for it.
+ */
+std::string NameContainer::getImportOrdsArch() const
+{
+	if (_config->getConfig().architecture.isArm()) return "arm";
+	else if (_config->getConfig().architecture.isX86()) return "x86";
+	else return std::string();
+}
+
+/**
+ * The packed ordinal number database is loaded from the ordinals directory
+ * the first time it is needed.
+ * \return Loaded database, or \c nullptr if there is none.
+ */
+const retdec::fileformat::OrdinalDatabase* NameContainer::getOrdinalDatabase()
+{
+	if (!_ordinalDatabaseLoaded)
+	{
+		_ordinalDatabaseLoaded = true;
+		auto dir = _config->getConfig().parameters.getOrdinalNumbersDirectory();
+		_ordinalDatabase = retdec::fileformat::OrdinalDatabase::fromFile(
+				dir + "/" + retdec::fileformat::OrdinalDatabase::FILE_NAME);
+	}
+
+	return _ordinalDatabase.get();
+}
+
 bool NameContainer::loadImportOrds(const std::string& libName)
 {
-	std::string arch;
-	if (_config->getConfig().architecture.isArm()) arch = "arm";
-	else if (_config->getConfig().architecture.isX86()) arch = "x86";
-	else return false;
+	auto arch = getImportOrdsArch();
+	if (arch.empty())
+	{
+		return false;
+	}
 
 	auto dir = _config->getConfig().parameters.getOrdinalNumbersDirectory();
 	auto filePath = dir + "/" + arch + "/" + libName + ".ord";
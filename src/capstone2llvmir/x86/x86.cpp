@@ -6,6 +6,8 @@
 
 #include <iomanip>
 
+#include <llvm/Transforms/Utils/Local.h>
+
 #include "capstone2llvmir/x86/x86_impl.h"
 
 namespace retdec {
@@ -115,6 +117,16 @@ bool Capstone2LlvmIrTranslatorX86_impl::isAnyPseudoFunctionCall(
 //==============================================================================
 //
 
+void Capstone2LlvmIrTranslatorX86_impl::setLazyFlags(bool f)
+{
+	_lazyFlags = f;
+}
+
+bool Capstone2LlvmIrTranslatorX86_impl::isLazyFlags() const
+{
+	return _lazyFlags;
+}
+
 bool Capstone2LlvmIrTranslatorX86_impl::isX87DataStoreFunction(llvm::Function* f) const
 {
 	return f == _x87DataStoreFunction;
@@ -738,6 +750,11 @@ llvm::StoreInst* Capstone2LlvmIrTranslatorX86_impl::storeRegister(
 			|| (getRegisterBitSize(pr) == 64 && getRegisterBitSize(r) == 32))
 	{
 		ret = irb.CreateStore(val, reg);
+
+		if (_lazyFlags && isStatusFlagRegister(r))
+		{
+			eraseOverwrittenFlagStore(ret);
+		}
 	}
 	else
 	{
@@ -816,6 +833,77 @@ llvm::StoreInst* Capstone2LlvmIrTranslatorX86_impl::storeRegister(
 	return ret;
 }
 
+bool Capstone2LlvmIrTranslatorX86_impl::isStatusFlagRegister(uint32_t r)
+{
+	return r == X86_REG_CF
+			|| r == X86_REG_PF
+			|| r == X86_REG_AF
+			|| r == X86_REG_ZF
+			|| r == X86_REG_SF
+			|| r == X86_REG_OF;
+}
+
+/**
+ * Lazy flags mode: remove the store of the same flag as the one stored by
+ * @p s, if the flag it sets can not be observed before @p s overwrites it.
+ *
+ * The instructions preceding @p s in its basic block are searched backwards.
+ * The search gives up on any load of the flag and on any call, since calls
+ * (pseudo branches, calls, returns, pseudo assembly functions) may observe
+ * the flag. Only stores generated for previous assembly instructions (i.e.
+ * before the special asm-to-LLVM mapping store of the current instruction)
+ * are removed, because translation routines may still use values computed
+ * for the current instruction. The removed store's value is removed as well
+ * if it becomes trivially dead.
+ *
+ * Flags are not removed across basic blocks, so later splitting of blocks
+ * (e.g. at jump targets found by the decoder) can not break this -- there is
+ * no read of the flag between the removed store and @p s on any path.
+ */
+void Capstone2LlvmIrTranslatorX86_impl::eraseOverwrittenFlagStore(
+		llvm::StoreInst* s)
+{
+	auto* reg = s->getPointerOperand();
+	auto* bb = s->getParent();
+
+	bool prevInsn = false;
+	auto it = s->getIterator();
+	while (it != bb->begin())
+	{
+		--it;
+		llvm::Instruction* i = &*it;
+
+		if (llvm::isa<llvm::CallInst>(i))
+		{
+			return;
+		}
+		else if (auto* l = llvm::dyn_cast<llvm::LoadInst>(i))
+		{
+			if (l->getPointerOperand() == reg)
+			{
+				return;
+			}
+		}
+		else if (auto* st = llvm::dyn_cast<llvm::StoreInst>(i))
+		{
+			if (isSpecialAsm2LlvmInstr(st))
+			{
+				prevInsn = true;
+			}
+			else if (st->getPointerOperand() == reg)
+			{
+				if (prevInsn)
+				{
+					auto* val = st->getValueOperand();
+					st->eraseFromParent();
+					llvm::RecursivelyDeleteTriviallyDeadInstructions(val);
+				}
+				return;
+			}
+		}
+	}
+}
+
 void Capstone2LlvmIrTranslatorX86_impl::storeRegisters(
 		llvm::IRBuilder<>& irb,
 		const std::vector<std::pair<uint32_t, llvm::Value*>>& regs)
@@ -45,6 +45,9 @@ class Capstone2LlvmIrTranslatorX86_impl :
 //==============================================================================
 //
 	public:
+		virtual void setLazyFlags(bool f) override;
+		virtual bool isLazyFlags() const override;
+
 		virtual bool isX87DataStoreFunction(llvm::Function* f) const override;
 		virtual bool isX87DataStoreFunctionCall(llvm::CallInst* c) const override;
 		virtual llvm::Function* getX87DataStoreFunction() const override;
@@ -120,6 +123,9 @@ class Capstone2LlvmIrTranslatorX86_impl :
 				llvm::IRBuilder<>& irb,
 				eOpConv ct = eOpConv::ZEXT_TRUNC_OR_BITCAST) override;
 
+		bool isStatusFlagRegister(uint32_t r);
+		void eraseOverwrittenFlagStore(llvm::StoreInst* s);
+
 		void storeRegisters(
 				llvm::IRBuilder<>& irb,
 				const std::vector<std::pair<uint32_t, llvm::Value*>>& regs);
@@ -219,6 +225,9 @@ class Capstone2LlvmIrTranslatorX86_impl :
 		llvm::Value* top = nullptr;
 		llvm::Value* idx = nullptr;
 
+		/// Remove status flag stores overwritten before they are read.
+		bool _lazyFlags = false;
+
 		llvm::Function* _x87DataStoreFunction = nullptr; // void (i3, fp80)
 		llvm::Function* _x87DataLoadFunction = nullptr; // fp80 (i3)
 //
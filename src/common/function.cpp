@@ -127,6 +127,37 @@ bool Function::operator!=(const Function& o) const
 //=============================================================================
 //
 
+FunctionContainer::FunctionContainer() :
+		std::set<Function, FunctionNameCompare>()
+{
+
+}
+
+FunctionContainer::FunctionContainer(const FunctionContainer& o) :
+		std::set<Function, FunctionNameCompare>(o)
+{
+	*this = o;
+}
+
+/**
+ * We need to make sure pointers in @c _addr2functions are valid -- point
+ * to the new container, not the old one.
+ */
+FunctionContainer& FunctionContainer::operator=(const FunctionContainer& o)
+{
+	if (this != &o)
+	{
+		std::set<Function, FunctionNameCompare>::operator=(o);
+		_addr2functions.clear();
+		for (auto& f : *this)
+		{
+			_addr2functions.emplace(f.getStart(), &f);
+		}
+		++_eraseCount;
+	}
+	return *this;
+}
+
 /**
  * @return @c True if container contains a function of the specified name.
  */
@@ -148,15 +179,18 @@ const Function* FunctionContainer::getFunctionByName(
 const Function* FunctionContainer::getFunctionByStartAddress(
 		const retdec::common::Address& addr) const
 {
-	for (auto& elem : *this)
+	// If more functions start on the address, the first one by name is used.
+	const Function* ret = nullptr;
+	auto range = _addr2functions.equal_range(addr);
+	for (auto it = range.first; it != range.second; ++it)
 	{
-		if (addr == elem.getStart())
+		if (ret == nullptr || it->second->getName() < ret->getName())
 		{
-			return &elem;
+			ret = it->second;
 		}
 	}
 
-	return nullptr;
+	return ret;
 }
 
 const Function* FunctionContainer::getFunctionByRealName(
@@ -173,6 +207,75 @@ const Function* FunctionContainer::getFunctionByRealName(
 	return nullptr;
 }
 
+/**
+ * @return Number of erase operations done on this container. Pointers to the
+ *         contained functions obtained before are valid while this number
+ *         does not change.
+ */
+std::size_t FunctionContainer::getEraseCount() const
+{
+	return _eraseCount;
+}
+
+/**
+ * Insert to the underlying container and update @c _addr2functions map.
+ * Existing function with the same name is not replaced.
+ */
+std::pair<FunctionContainer::iterator,bool> FunctionContainer::insert(
+		const Function& e)
+{
+	auto retPair = std::set<Function, FunctionNameCompare>::insert(e);
+	if (retPair.second)
+	{
+		const Function* f = &(*retPair.first);
+		_addr2functions.emplace(f->getStart(), f);
+	}
+	return retPair;
+}
+
+std::pair<FunctionContainer::iterator,bool> FunctionContainer::insert(
+		FunctionContainer::iterator,
+		const Function& e)
+{
+	return insert(e);
+}
+
+/**
+ * Clear both underlying container and @c _addr2functions map.
+ */
+void FunctionContainer::clear()
+{
+	std::set<Function, FunctionNameCompare>::clear();
+	_addr2functions.clear();
+	++_eraseCount;
+}
+
+/**
+ * Erase from both underlying container and @c _addr2functions map.
+ */
+size_t FunctionContainer::erase(const Function& val)
+{
+	auto it = find(val.getName());
+	if (it == end())
+	{
+		return 0;
+	}
+
+	auto range = _addr2functions.equal_range(it->getStart());
+	for (auto ait = range.first; ait != range.second; ++ait)
+	{
+		if (ait->second == &(*it))
+		{
+			_addr2functions.erase(ait);
+			break;
+		}
+	}
+
+	std::set<Function, FunctionNameCompare>::erase(it);
+	++_eraseCount;
+	return 1;
+}
+
 //
 //=============================================================================
 // FunctionSet
@@ -39,11 +39,15 @@ const std::string JSON_outputAsmFile            = "outputAsmFile";
 const std::string JSON_outputLlFile             = "outputLlFile";
 const std::string JSON_outputConfigFile         = "outputConfigFile";
 const std::string JSON_outputUnpackedFile       = "outputUnpackedFile";
+const std::string JSON_checkpointFile           = "checkpointFile";
+const std::string JSON_resumeFile               = "resumeFile";
 const std::string JSON_outputFormat             = "outputFormat";
 const std::string JSON_logFile                  = "logFile";
 const std::string JSON_errFile                  = "errFile";
 
 const std::string JSON_detectStaticCode         = "detectStaticCode";
+const std::string JSON_forwardRegisterValues    = "forwardRegisterValues";
+const std::string JSON_simpleTypesUnionFind     = "simpleTypesUnionFind";
 const std::string JSON_backendDisabledOpts      = "backendDisabledOpts";
 const std::string JSON_backendEnabledOpts       = "backendEnabledOpts";
 const std::string JSON_backendCallInfoObtainer  = "backendCallInfoObtainer";
@@ -58,10 +62,15 @@ const std::string JSON_backendNoTimeVaryingInfo = "backendNoTimeVaryingInfo";
 const std::string JSON_backendNoVarRenaming     = "backendNoVarRenaming";
 const std::string JSON_backendNoCompoundOperators = "backendNoCompoundOperators";
 const std::string JSON_backendNoSymbolicNames   = "backendNoSymbolicNames";
+const std::string JSON_backendFuncCacheDir      = "backendFuncCacheDir";
+const std::string JSON_backendFuncCacheMaxSize  = "backendFuncCacheMaxSize";
 
 const std::string JSON_timeout                  = "timeout";
+const std::string JSON_llvmPassesFuncSizeLimit  = "llvmPassesFunctionSizeLimit";
+const std::string JSON_llvmPassesFuncTimeLimit  = "llvmPassesFunctionTimeLimit";
 const std::string JSON_maxMemoryLimit           = "maxMemoryLimit";
 const std::string JSON_maxMemoryLimitHalfRam    = "maxMemoryLimitHalfRam";
+const std::string JSON_maxThreads               = "maxThreads";
 
 } // anonymous namespace
 
@@ -163,6 +172,16 @@ bool Parameters::isDetectStaticCode() const
 	return _detectStaticCode;
 }
 
+bool Parameters::isForwardRegisterValues() const
+{
+	return _forwardRegisterValues;
+}
+
+bool Parameters::isSimpleTypesUnionFind() const
+{
+	return _simpleTypesUnionFind;
+}
+
 bool Parameters::isTimeout() const
 {
 	return _timeout != 0;
@@ -212,6 +231,16 @@ void Parameters::setOutputUnpackedFile(const std::string& file)
 	_outputUnpackedFile = file;
 }
 
+void Parameters::setCheckpointFile(const std::string& file)
+{
+	_checkpointFile = file;
+}
+
+void Parameters::setResumeFile(const std::string& file)
+{
+	_resumeFile = file;
+}
+
 void Parameters::setOutputFormat(const std::string& format)
 {
 	_outputFormat = format;
@@ -252,11 +281,26 @@ void Parameters::setIsMaxMemoryLimitHalfRam(bool f)
 	_maxMemoryLimitHalfRam = f;
 }
 
+void Parameters::setMaxThreads(uint64_t threads)
+{
+	_maxThreads = threads;
+}
+
 void Parameters::setTimeout(uint64_t seconds)
 {
 	_timeout = seconds;
 }
 
+void Parameters::setLlvmPassesFunctionSizeLimit(uint64_t instructions)
+{
+	_llvmPassesFunctionSizeLimit = instructions;
+}
+
+void Parameters::setLlvmPassesFunctionTimeLimit(uint64_t milliseconds)
+{
+	_llvmPassesFunctionTimeLimit = milliseconds;
+}
+
 void Parameters::setEntryPoint(const retdec::common::Address& a)
 {
 	_entryPoint = a;
@@ -291,6 +335,16 @@ void Parameters::setBackendVarRenamer(const std::string& val)
 	_backendVarRenamer = val;
 }
 
+void Parameters::setBackendFuncCacheDir(const std::string& dir)
+{
+	_backendFuncCacheDir = dir;
+}
+
+void Parameters::setBackendFuncCacheMaxSize(uint64_t size)
+{
+	_backendFuncCacheMaxSize = size;
+}
+
 void Parameters::setIsBackendNoOpts(bool b)
 {
 	_backendNoOpts = b;
@@ -346,6 +400,16 @@ void Parameters::setIsDetectStaticCode(bool b)
 	_detectStaticCode = b;
 }
 
+void Parameters::setIsForwardRegisterValues(bool b)
+{
+	_forwardRegisterValues = b;
+}
+
+void Parameters::setIsSimpleTypesUnionFind(bool b)
+{
+	_simpleTypesUnionFind = b;
+}
+
 const std::string& Parameters::getOrdinalNumbersDirectory() const
 {
 	return _ordinalNumbersDirectory;
@@ -391,6 +455,16 @@ const std::string& Parameters::getOutputUnpackedFile() const
 	return _outputUnpackedFile;
 }
 
+const std::string& Parameters::getCheckpointFile() const
+{
+	return _checkpointFile;
+}
+
+const std::string& Parameters::getResumeFile() const
+{
+	return _resumeFile;
+}
+
 const std::string& Parameters::getOutputFormat() const
 {
 	return _outputFormat;
@@ -411,11 +485,26 @@ uint64_t Parameters::getMaxMemoryLimit() const
 	return _maxMemoryLimit;
 }
 
+uint64_t Parameters::getMaxThreads() const
+{
+	return _maxThreads;
+}
+
 uint64_t Parameters::getTimeout() const
 {
 	return _timeout;
 }
 
+uint64_t Parameters::getLlvmPassesFunctionSizeLimit() const
+{
+	return _llvmPassesFunctionSizeLimit;
+}
+
+uint64_t Parameters::getLlvmPassesFunctionTimeLimit() const
+{
+	return _llvmPassesFunctionTimeLimit;
+}
+
 retdec::common::Address Parameters::getEntryPoint() const
 {
 	return _entryPoint;
@@ -451,6 +540,16 @@ const std::string& Parameters::getBackendVarRenamer() const
 	return _backendVarRenamer;
 }
 
+const std::string& Parameters::getBackendFuncCacheDir() const
+{
+	return _backendFuncCacheDir;
+}
+
+uint64_t Parameters::getBackendFuncCacheMaxSize() const
+{
+	return _backendFuncCacheMaxSize;
+}
+
 void fixPath(std::string& path, fs::path root)
 {
 	fs::path p(path);
@@ -507,6 +606,8 @@ void Parameters::serialize(Writer& writer) const
 	serdes::serializeString(writer, JSON_outputLlFile, getOutputLlvmirFile());
 	serdes::serializeString(writer, JSON_outputConfigFile, getOutputConfigFile());
 	serdes::serializeString(writer, JSON_outputUnpackedFile, getOutputUnpackedFile());
+	serdes::serializeString(writer, JSON_checkpointFile, getCheckpointFile());
+	serdes::serializeString(writer, JSON_resumeFile, getResumeFile());
 	serdes::serializeString(writer, JSON_outputFormat, getOutputFormat());
 	serdes::serializeString(writer, JSON_logFile, getLogFile());
 	serdes::serializeString(writer, JSON_errFile, getErrFile());
@@ -519,6 +620,8 @@ void Parameters::serialize(Writer& writer) const
 	serdes::serializeBool(writer, JSON_backendEmitCfg, isBackendEmitCfg());
 	serdes::serializeBool(writer, JSON_backendEmitCg, isBackendEmitCg());
 	serdes::serializeBool(writer, JSON_detectStaticCode, isDetectStaticCode());
+	serdes::serializeBool(writer, JSON_forwardRegisterValues, isForwardRegisterValues());
+	serdes::serializeBool(writer, JSON_simpleTypesUnionFind, isSimpleTypesUnionFind());
 	serdes::serializeBool(writer, JSON_backendAggressiveOpts, isBackendAggressiveOpts());
 	serdes::serializeBool(writer, JSON_backendKeepAllBrackets, isBackendKeepAllBrackets());
 	serdes::serializeBool(writer, JSON_backendKeepLibraryFuncs, isBackendKeepLibraryFuncs());
@@ -526,10 +629,15 @@ void Parameters::serialize(Writer& writer) const
 	serdes::serializeBool(writer, JSON_backendNoVarRenaming, isBackendNoVarRenaming());
 	serdes::serializeBool(writer, JSON_backendNoCompoundOperators, isBackendNoCompoundOperators());
 	serdes::serializeBool(writer, JSON_backendNoSymbolicNames, isBackendNoSymbolicNames());
+	serdes::serializeString(writer, JSON_backendFuncCacheDir, getBackendFuncCacheDir());
+	serdes::serializeUint64(writer, JSON_backendFuncCacheMaxSize, getBackendFuncCacheMaxSize());
 
 	serdes::serializeUint64(writer, JSON_timeout, getTimeout());
+	serdes::serializeUint64(writer, JSON_llvmPassesFuncSizeLimit, getLlvmPassesFunctionSizeLimit());
+	serdes::serializeUint64(writer, JSON_llvmPassesFuncTimeLimit, getLlvmPassesFunctionTimeLimit());
 	serdes::serializeUint64(writer, JSON_maxMemoryLimit, getMaxMemoryLimit());
 	serdes::serializeBool(writer, JSON_maxMemoryLimitHalfRam, isMaxMemoryLimitHalfRam());
+	serdes::serializeUint64(writer, JSON_maxThreads, getMaxThreads());
 
 	serdes::serializeContainer(writer, JSON_selectedRanges, selectedRanges);
 	serdes::serializeContainer(writer, JSON_userStaticSigPaths, userStaticSignaturePaths);
@@ -576,11 +684,15 @@ void Parameters::deserialize(const rapidjson::Value& val)
 	setOutputLlvmirFile( serdes::deserializeString(val, JSON_outputLlFile) );
 	setOutputConfigFile( serdes::deserializeString(val, JSON_outputConfigFile) );
 	setOutputUnpackedFile( serdes::deserializeString(val, JSON_outputUnpackedFile) );
+	setCheckpointFile( serdes::deserializeString(val, JSON_checkpointFile) );
+	setResumeFile( serdes::deserializeString(val, JSON_resumeFile) );
 	setOutputFormat( serdes::deserializeString(val, JSON_outputFormat) );
 	setLogFile( serdes::deserializeString(val, JSON_logFile) );
 	setErrFile( serdes::deserializeString(val, JSON_errFile) );
 
 	setIsDetectStaticCode( serdes::deserializeBool(val, JSON_detectStaticCode, true) );
+	setIsForwardRegisterValues( serdes::deserializeBool(val, JSON_forwardRegisterValues, false) );
+	setIsSimpleTypesUnionFind( serdes::deserializeBool(val, JSON_simpleTypesUnionFind, false) );
 	setBackendDisabledOpts( serdes::deserializeString(val, JSON_backendDisabledOpts) );
 	setBackendEnabledOpts( serdes::deserializeString(val, JSON_backendEnabledOpts) );
 	setBackendCallInfoObtainer( serdes::deserializeString(val, JSON_backendCallInfoObtainer, "optim") );
@@ -595,10 +707,15 @@ void Parameters::deserialize(const rapidjson::Value& val)
 	setIsBackendNoVarRenaming( serdes::deserializeBool(val, JSON_backendNoVarRenaming, false) );
 	setIsBackendNoCompoundOperators( serdes::deserializeBool(val, JSON_backendNoCompoundOperators, false) );
 	setIsBackendNoSymbolicNames( serdes::deserializeBool(val, JSON_backendNoSymbolicNames, false) );
+	setBackendFuncCacheDir( serdes::deserializeString(val, JSON_backendFuncCacheDir) );
+	setBackendFuncCacheMaxSize( serdes::deserializeUint64(val, JSON_backendFuncCacheMaxSize, 1024 * 1024 * 1024) );
 
 	setTimeout( serdes::deserializeUint64(val, JSON_timeout, 0) );
+	setLlvmPassesFunctionSizeLimit( serdes::deserializeUint64(val, JSON_llvmPassesFuncSizeLimit, 0) );
+	setLlvmPassesFunctionTimeLimit( serdes::deserializeUint64(val, JSON_llvmPassesFuncTimeLimit, 0) );
 	setMaxMemoryLimit( serdes::deserializeUint64(val, JSON_maxMemoryLimit, 0) );
 	setIsMaxMemoryLimitHalfRam( serdes::deserializeBool(val, JSON_maxMemoryLimitHalfRam, true) );
+	setMaxThreads( serdes::deserializeUint64(val, JSON_maxThreads, 0) );
 
 	serdes::deserialize(val, JSON_entryPoint, _entryPoint);
 	serdes::deserialize(val, JSON_mainAddress, _mainAddress);
@@ -16,6 +16,8 @@
 #include "retdec/cpdetect/heuristics/pe_heuristics.h"
 #include "retdec/cpdetect/settings.h"
 #include "retdec/yaracpp/yara_detector.h"
+#include "retdec/yaracpp/yara_rules_cache.h"
+#include "retdec/yaracpp/yara_scan_session.h"
 
 using namespace retdec::fileformat;
 using namespace retdec::utils;
@@ -498,14 +500,14 @@ void CompilerDetector::getAllHeuristics()
  */
 ReturnCode CompilerDetector::getAllSignatures()
 {
-	YaraDetector yara;
+	YaraRulesCache::RuleFiles ruleFiles;
 
 	// Add internal paths.
 	unsigned iCntr = 0;
 	for (const auto &ruleFile : internalPaths)
 	{
 		std::string nameSpace = "internal_" + std::to_string(iCntr++);
-		yara.addRuleFile(ruleFile, nameSpace);
+		ruleFiles.emplace_back(ruleFile, nameSpace);
 	}
 
 	unsigned eCntr = 0;
@@ -514,16 +516,60 @@ ReturnCode CompilerDetector::getAllSignatures()
 		for (const auto &item : externalDatabase)
 		{
 			std::string nameSpace = "external_" + std::to_string(eCntr++);
-			yara.addRuleFile(item, nameSpace);
+			ruleFiles.emplace_back(item, nameSpace);
 		}
 	}
 
-	yara.analyze(
-			fileParser.getPathToFile(),
-			cpParams.searchType != SearchType::EXACT_MATCH
-	);
-	const auto &detected = yara.getDetectedRules();
-	const auto &undetected = yara.getUndetectedRules();
+	const bool storeAllRules = cpParams.searchType != SearchType::EXACT_MATCH;
+	std::vector<YaraRule> detected;
+	std::vector<YaraRule> undetected;
+	if (cpParams.scanSession)
+	{
+		// The file is scanned together with rule sets of other users of the
+		// session (files get their namespaces from the session).
+		std::vector<std::string> paths;
+		for (const auto &ruleFile : ruleFiles)
+		{
+			paths.push_back(ruleFile.first);
+		}
+		const auto ruleSet = cpParams.scanSession->addRuleSet(
+				paths,
+				storeAllRules
+		);
+		cpParams.scanSession->scan();
+		detected = cpParams.scanSession->getDetectedRules(ruleSet);
+		undetected = cpParams.scanSession->getUndetectedRules(ruleSet);
+	}
+	else
+	{
+		// Signatures are compiled only once for all files when they are shared.
+		std::unique_ptr<YaraDetector> localYara;
+		const YaraDetector *yara = nullptr;
+		if (cpParams.rulesCache)
+		{
+			yara = cpParams.rulesCache->getDetector(ruleFiles);
+		}
+		else
+		{
+			localYara = std::make_unique<YaraDetector>();
+			for (const auto &ruleFile : ruleFiles)
+			{
+				localYara->addRuleFile(ruleFile.first, ruleFile.second);
+			}
+			localYara->compileRules();
+			yara = localYara.get();
+		}
+
+		if (yara)
+		{
+			yara->analyze(
+					fileParser.getPathToFile(),
+					detected,
+					undetected,
+					storeAllRules
+			);
+		}
+	}
 	auto result = false;
 	if (cpParams.searchType == SearchType::EXACT_MATCH
 			|| (cpParams.searchType == SearchType::MOST_SIMILAR
@@ -773,6 +819,7 @@ ReturnCode CompilerDetector::getAllInformation()
 	{
 		toolInfo.overlayOffset = fileParser.getDeclaredFileLength();
 	}
+	fileParser.getEntropyProfile(toolInfo.entropyProfile);
 
 	const bool invalidEntryPoint = !toolInfo.entryPointAddress
 			|| !toolInfo.entryPointOffset;
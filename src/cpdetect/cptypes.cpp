@@ -4,11 +4,23 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+
 #include "retdec/cpdetect/cptypes.h"
 
 namespace retdec {
 namespace cpdetect {
 
+namespace
+{
+
+/// Entropy of window of compressed or encrypted data
+const double PACKED_WINDOW_ENTROPY = 7.2;
+/// Minimal number of windows in entropy profile of packed file
+const std::size_t MIN_PACKED_ENTROPY_WINDOWS = 4;
+
+} // anonymous namespace
+
 /**
  * Constructor of DetectParams structure
  */
@@ -226,6 +238,41 @@ bool ToolInformation::hasReliableResult() const
 	return false;
 }
 
+/**
+ * Check if entropy profile of the file indicates compressed or encrypted content
+ * @return @c true if most of the windows before overlay have high entropy
+ *
+ * Overlay is ignored because it often contains compressed data (e.g. archives
+ * of installers) even if the file itself is not packed.
+ */
+bool ToolInformation::hasPackedEntropyProfile() const
+{
+	const auto &profile = entropyProfile;
+	if (profile.empty() || !profile.stride)
+	{
+		return false;
+	}
+
+	// Only windows which end before start of overlay are taken into account
+	std::size_t windows = profile.entropy.size();
+	if (overlaySize)
+	{
+		const std::size_t beforeOverlay = overlayOffset < profile.windowSize
+				? 0
+				: (overlayOffset - profile.windowSize) / profile.stride + 1;
+		windows = std::min(windows, beforeOverlay);
+	}
+	if (windows < MIN_PACKED_ENTROPY_WINDOWS)
+	{
+		return false;
+	}
+
+	const std::size_t high = std::count_if(profile.entropy.begin(),
+			profile.entropy.begin() + windows,
+			[](double e) { return e > PACKED_WINDOW_ENTROPY; });
+	return high * 10 >= windows * 7;
+}
+
 /**
  * Check possible packing
  * @return detection level of possible packing
@@ -146,7 +146,7 @@ bool getDwarfLanguageString(uint64_t langCode, std::string &result)
  * @param symbol Input symbol
  * @return @c true if symbol is Go symbol, @c false otherwise
  */
-bool isGoFunction(const std::shared_ptr<retdec::fileformat::Symbol> &symbol)
+bool isGoFunction(const std::shared_ptr<const retdec::fileformat::Symbol> &symbol)
 {
 	if (!symbol->isFunction())
 	{
@@ -163,7 +163,7 @@ bool isGoFunction(const std::shared_ptr<retdec::fileformat::Symbol> &symbol)
  * @param symbol Input symbol
  * @return @c true if symbol is rust symbol, @c false otherwise
  */
-bool isRustFunction(const std::shared_ptr<retdec::fileformat::Symbol> &symbol)
+bool isRustFunction(const std::shared_ptr<const retdec::fileformat::Symbol> &symbol)
 {
 	if (!symbol->isFunction())
 	{
@@ -180,7 +180,7 @@ bool isRustFunction(const std::shared_ptr<retdec::fileformat::Symbol> &symbol)
  * @param symbol Input symbol
  * @return @c true if symbol is GHC symbol, @c false otherwise
  */
-bool isGhcSymbol(const std::shared_ptr<retdec::fileformat::Symbol> &symbol)
+bool isGhcSymbol(const std::shared_ptr<const retdec::fileformat::Symbol> &symbol)
 {
 	const auto offset = symbol->getName().find("base_GHC");
 	return offset == 0 || offset == 1;
@@ -950,12 +950,12 @@ std::string Heuristics::getUpxVersion()
 	{
 		// format: $Id: UPX x.xx
 		const std::string pattern = "$Id: UPX ";
-		const auto &content = search.getPlainString();
+		const auto content = search.getPlainString();
 		const auto pos = content.find(pattern);
 		const std::size_t versionLen = 4;
 		if (pos <= content.length() - pattern.length() - versionLen)
 		{
-			return content.substr(pos + pattern.length(), versionLen);
+			return std::string(content.substr(pos + pattern.length(), versionLen));
 		}
 	}
 
@@ -4,6 +4,7 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
 #include <initializer_list>
 #include <limits>
 #include <map>
@@ -118,13 +119,13 @@ const std::vector<PeHeaderStyle> headerStyles =
  * @param content Content of file
  * @return @c true if string is found, @c false otherwise
  */
-bool findAutoIt(const std::string &content)
+bool findAutoIt(std::string_view content)
 {
 	const std::string prefix = "AU3!EA";
 	const std::regex regExp(prefix + "[0-9]{2}");
 	const auto offset = content.find(prefix);
-	return offset != std::string::npos
-			&& regex_match(content.substr(offset, 8), regExp);
+	return offset != std::string_view::npos
+			&& regex_match(std::string(content.substr(offset, 8)), regExp);
 }
 
 /**
@@ -187,7 +188,7 @@ std::string PeHeuristics::getEnigmaVersion()
 	}
 
 	const std::string pattern = "\0\0\0ENIGMA"s;
-	const auto &content = search.getPlainString();
+	const auto content = search.getPlainString();
 	const auto pos = content.find(pattern, sec->getOffset());
 	if (pos < sec->getOffset() + sec->getLoadedSize())
 	{
@@ -212,7 +213,7 @@ std::string PeHeuristics::getEnigmaVersion()
  */
 std::string PeHeuristics::getUpxAdditionalInfo(std::size_t metadataPos)
 {
-	const auto& content = search.getPlainString();
+	const auto content = search.getPlainString();
 
 	std::string info;
 	if (content.length() > metadataPos + 6)
@@ -301,7 +302,7 @@ void PeHeuristics::getAutoItHeuristics()
 		addPriorityLanguage("AutoIt", "", true);
 	}
 
-	const auto &content = search.getPlainString();
+	const auto content = search.getPlainString();
 	const auto *rsrc = fileParser.getSection(".rsrc");
 	if (rsrc && rsrc->getOffset() < content.length()
 			&& findAutoIt(content.substr(rsrc->getOffset())))
@@ -400,12 +401,12 @@ const std::uint8_t * PeHeuristics::skip_NOP_JMP8_JMP32(
  */
 void PeHeuristics::getHeaderStyleHeuristics()
 {
-	const auto &content = search.getPlainString();
+	const auto content = search.getPlainString();
 
 	// Must have at least IMAGE_DOS_HEADER
 	if (content.length() > 0x40)
 	{
-		const char * e_cblp = content.c_str() + 0x02;
+		const char * e_cblp = content.data() + 0x02;
 
 		for (size_t i = 0; i < headerStyles.size(); i++)
 		{
@@ -435,6 +436,8 @@ void PeHeuristics::getSlashedSignatures()
 	}
 
 	const auto stopOffset = toolInfo.epOffset + LIGHTWEIGHT_FILE_SCAN_AREA;
+	std::vector<std::string> patterns;
+	std::vector<Search::Area> areas;
 	for (const auto &sig : x86SlashedSignatures)
 	{
 		auto start = toolInfo.epOffset;
@@ -455,9 +458,18 @@ void PeHeuristics::getSlashedSignatures()
 			);
 		}
 
-		const auto nibbles = search.findSlashedSignature(sig.pattern, start, end);
+		patterns.push_back(sig.pattern);
+		areas.push_back({start, end});
+	}
+
+	// all signatures are searched in one pass over the area after EP
+	const auto matches = search.findSlashedSignatures(patterns, areas);
+	for (std::size_t i = 0, e = matches.size(); i < e; ++i)
+	{
+		const auto nibbles = matches[i];
 		if (nibbles)
 		{
+			const auto &sig = x86SlashedSignatures[i];
 			addPacker(nibbles, nibbles, sig.name, sig.version, sig.additional);
 		}
 	}
@@ -590,7 +602,7 @@ void PeHeuristics::getStarForceHeuristics()
  */
 void PeHeuristics::getSafeDiscHeuristics()
 {
-	const auto &content = search.getPlainString();
+	const auto content = search.getPlainString();
 	const std::string safeDiscString = "BoG_ *90.0&!!  Yy>";
 	auto pos = content.find(safeDiscString, peParser.getSizeOfHeaders() - 0x2C);
 
@@ -680,7 +692,7 @@ void PeHeuristics::getSecuROMHeuristics()
 		if (loadedLength >= declaredLength)
 		{
 			// Retrieve the offset of the securom header
-			fileData = search.getPlainString().c_str();
+			fileData = search.getPlainString().data();
 			memcpy(
 					&SecuromOffs,
 					fileData + loadedLength - sizeof(uint32_t),
@@ -719,9 +731,9 @@ void PeHeuristics::getSecuROMHeuristics()
  */
 void PeHeuristics::getMPRMMGVAHeuristics()
 {
-	const auto &content = search.getPlainString();
+	const auto content = search.getPlainString();
 	const uint8_t * fileData = reinterpret_cast<const uint8_t *>(
-			content.c_str());
+			content.data());
 	const uint8_t * filePtr = fileData + toolInfo.epOffset;
 	const uint8_t * fileEnd = fileData + content.length();
 	unsigned long long offset1;
@@ -732,6 +744,8 @@ void PeHeuristics::getMPRMMGVAHeuristics()
 	{
 		if (search.exactComparison("892504----00", toolInfo.epOffset))
 		{
+			// the second signature is searched for after the first one, so
+			// the searches cannot be done in one pass
 			offset1 = search.findUnslashedSignature(
 					"64FF3500000000",
 					toolInfo.epOffset,
@@ -839,6 +853,9 @@ void PeHeuristics::getEzirizReactorHeuristics()
 
 	if (canSearch)
 	{
+		// each signature is searched for in a different section and the
+		// second one only if the first one is not found, so there is nothing
+		// to share by searching them in one pass
 		const auto *sec0 = peParser.getPeSection(0);
 		const auto *sec1 = peParser.getPeSection(1);
 
@@ -906,7 +923,7 @@ void PeHeuristics::getUpxHeuristics()
 	// UPX 1.00 - UPX 1.07
 	// format: UPX 1.0x
 	const std::string upxVer = "UPX 1.0";
-	const auto &content = search.getPlainString();
+	const auto content = search.getPlainString();
 	auto pos = content.find(upxVer);
 	if (pos < 0x500 && pos < content.length() - upxVer.length())
 	{
@@ -941,10 +958,10 @@ void PeHeuristics::getUpxHeuristics()
 	{
 		std::string version;
 		std::size_t num;
-		if (strToNum(content.substr(pos - minPos, 1), num)
-				&& strToNum(content.substr(pos - minPos + 2, 2), num))
+		if (strToNum(std::string(content.substr(pos - minPos, 1)), num)
+				&& strToNum(std::string(content.substr(pos - minPos + 2, 2)), num))
 		{
-			version = content.substr(pos - minPos, verLen);
+			version = std::string(content.substr(pos - minPos, verLen));
 		}
 		std::string additionalInfo = getUpxAdditionalInfo(pos);
 		if (!additionalInfo.empty())
@@ -988,7 +1005,7 @@ void PeHeuristics::getPeCompactHeuristics()
 	const std::string pattern = "PEC2";
 	const auto patLen = pattern.length();
 
-	const auto &content = search.getPlainString();
+	const auto content = search.getPlainString();
 	const auto pos = content.find(pattern);
 
 	if (pos < 0x500
@@ -1048,7 +1065,7 @@ void PeHeuristics::getEnigmaHeuristics()
 		if (sec)
 		{
 			const std::string pattern = "Enigma protector v";
-			const auto &content = search.getPlainString();
+			const auto content = search.getPlainString();
 			const auto pos = content.find(pattern, sec->getOffset());
 			if (pos < sec->getOffset() + sec->getSizeInFile()
 					&& pos <= content.length() - 4)
@@ -1057,7 +1074,7 @@ void PeHeuristics::getEnigmaHeuristics()
 						source,
 						strength,
 						"Enigma",
-						content.substr(pos + pattern.length(), 4)
+						std::string(content.substr(pos + pattern.length(), 4))
 				);
 				return;
 			}
@@ -1220,9 +1237,25 @@ void PeHeuristics::getNetHeuristic()
 		const auto start = sec->getOffset();
 		const auto end = start + sec->getLoadedSize() - 1;
 
-		const std::string sig =
-			"0000010B160C----------0208----------0D0906085961D21304091E630861D21305070811051E62110460D19D081758;";
-		if (search.findUnslashedSignature(sig, start, end))
+		// all signatures are searched in one pass over the section; string
+		// searches are not signatures and "?.resources" is needed only if
+		// Phoenix 1.7 is not found, so they stay separate
+		std::vector<std::string> patterns =
+		{
+			"0000010B160C----------0208----------0D0906085961D21304091E630861D21305070811051E62110460D19D081758;",
+			"282D00000A6F2E00000A14146F2F00000A;",
+			"436C69005300650063007500720065;"
+		};
+		patterns.insert(
+				patterns.end(),
+				dotNetShrinkPatterns.begin(),
+				dotNetShrinkPatterns.end());
+		const auto matches = search.findUnslashedSignatures(
+				patterns,
+				start,
+				end);
+
+		if (matches[0])
 		{
 			version = "1.7 - 1.8";
 		}
@@ -1235,31 +1268,20 @@ void PeHeuristics::getNetHeuristic()
 			addPacker(source, strength, "Phoenix", version);
 		}
 
-		if (search.findUnslashedSignature(
-				"282D00000A6F2E00000A14146F2F00000A;",
-				start,
-				end))
+		if (matches[1])
 		{
 			addPacker(source, strength, "AssemblyInvoke");
 		}
 
-		if (search.findUnslashedSignature(
-				"436C69005300650063007500720065;",
-				start,
-				end))
+		if (matches[2])
 		{
 			addPacker(source, strength, "CliSecure");
 		}
 
-		// Note: Before modifying the following loop to std::any_of(),
-		//       please see #231 (compilation bug with GCC 5).
-		for (const auto& str : dotNetShrinkPatterns)
+		if (std::any_of(matches.begin() + 3, matches.end(),
+				[](auto nibbles) { return nibbles != 0; }))
 		{
-			if (search.findUnslashedSignature(str, start, end))
-			{
-				addPacker(source, strength, ".netshrink", "2.01 (demo)");
-				break;
-			}
+			addPacker(source, strength, ".netshrink", "2.01 (demo)");
 		}
 	}
 }
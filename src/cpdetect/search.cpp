@@ -5,16 +5,14 @@
  */
 
 #include <algorithm>
+#include <limits>
 #include <map>
 
 #include "retdec/utils/container.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/equality.h"
-#include "retdec/utils/string.h"
 #include "retdec/cpdetect/search.h"
 #include "retdec/cpdetect/signature.h"
-#include "retdec/fileformat/utils/conversions.h"
-#include "retdec/fileformat/utils/file_io.h"
 
 using namespace retdec::utils;
 using namespace retdec::fileformat;
@@ -46,13 +44,41 @@ const std::map<Architecture, std::vector<Search::RelativeJump>> jumpMap =
 Search::Search(retdec::fileformat::FileFormat &fileParser)
 		: parser(fileParser)
 		, averageSlashLen(0)
+		, fileSupported(false)
 {
 	const auto &bytes = parser.getLoadedBytes();
-	bytesToHexString(bytes, nibbles);
-	bytesToString(bytes, plain);
+	const auto *data = bytes.data();
+	auto size = bytes.size();
 	fileLoaded = !bytes.empty();
-	fileSupported = parser.hexToLittle(nibbles)
-			&& parser.getNumberOfNibblesInByte();
+
+	// Signatures are compared with content of file in little endian. Only
+	// big endian files with multi-byte words need their own copy of content.
+	if (parser.isLittleEndian())
+	{
+		fileSupported = true;
+	}
+	else if (parser.isBigEndian())
+	{
+		const auto wordSize = parser.getBytesPerWord();
+		fileSupported = wordSize && size >= wordSize;
+		if (fileSupported && wordSize > 1)
+		{
+			size -= size % wordSize;
+			littleEndianBytes.assign(data, data + size);
+			for (std::size_t i = 0; i < size; i += wordSize)
+			{
+				std::reverse(
+						littleEndianBytes.begin() + i,
+						littleEndianBytes.begin() + i + wordSize);
+			}
+			data = littleEndianBytes.data();
+		}
+	}
+
+	// Compiled signatures are compared byte by byte.
+	fileSupported = fileSupported && parser.getNumberOfNibblesInByte() == 2;
+	matcher = SignatureMatcher(data, size);
+
 	jumps = mapGetValueOrDefault(
 			jumpMap,
 			parser.getTargetArchitecture(),
@@ -75,6 +101,12 @@ Search::Search(retdec::fileformat::FileFormat &fileParser)
 	{
 		averageSlashLen /= jumps.size();
 	}
+
+	for (const auto &jump : jumps)
+	{
+		matcher.addJump(jump.getSlash(), jump.getBytesAfter());
+	}
+	matcher.setAverageSlashLength(averageSlashLen);
 }
 
 /**
@@ -145,6 +177,156 @@ std::size_t Search::bytesFromNibbles(std::size_t nNibbles) const
 	return parser.bytesFromNibbles(nNibbles);
 }
 
+/**
+ * Get area of nibbles in which signature is searched
+ * @param signPattern Signature pattern
+ * @param mode Interpretation of special characters in @a signPattern
+ * @param area Area of file (in bytes)
+ * @param firstNibble Into this parameter is stored the first possible offset
+ *    of signature (in nibbles)
+ * @param lastNibble Into this parameter is stored the last possible offset
+ *    of signature (in nibbles)
+ * @return @c false if signature cannot be in @a area, @c true otherwise
+ */
+bool Search::getSearchArea(
+		const std::string &signPattern,
+		CompiledSignature::Mode mode,
+		const Area &area,
+		std::size_t &firstNibble,
+		std::size_t &lastNibble) const
+{
+	const auto fileLen = matcher.getNumberOfNibbles();
+	if (area.startOffset > area.stopOffset
+			|| area.startOffset >= matcher.getSize())
+	{
+		return false;
+	}
+
+	firstNibble = nibblesFromBytes(area.startOffset);
+	if (mode == CompiledSignature::Mode::UNSLASHED)
+	{
+		// signature must lie between start offset and the first nibble
+		// of stop offset
+		const auto stopIndex = std::min(
+				nibblesFromBytes(std::min(area.stopOffset, matcher.getSize())) + 1,
+				fileLen);
+		if (stopIndex - firstNibble < signPattern.length())
+		{
+			return false;
+		}
+
+		lastNibble = stopIndex - signPattern.length();
+		return true;
+	}
+
+	// signature may start on each nibble of area from which there is enough
+	// nibbles to the end of area (size of area is limited to prevent overflow,
+	// signature cannot start after the end of file anyway)
+	const auto signSize = signPattern.length()
+			- std::count(signPattern.begin(), signPattern.end(), ';');
+	const auto areaSize = nibblesFromBytes(
+			std::min(area.stopOffset - area.startOffset, fileLen + signSize)
+			+ 1);
+	if (areaSize < signSize)
+	{
+		return false;
+	}
+
+	const auto iters = area.startOffset == area.stopOffset
+			? 1
+			: areaSize - signSize + 1;
+	lastNibble = std::min(firstNibble + iters - 1, fileLen - 1);
+	return true;
+}
+
+/**
+ * Find signatures in one pass over file
+ * @param signPatterns Signature patterns
+ * @param areas Areas of file in which patterns are searched (one per pattern)
+ * @param mode Interpretation of special characters in patterns
+ * @return For each pattern number of its significant nibbles if it is
+ *    present in its area, zero otherwise
+ */
+std::vector<unsigned long long> Search::findSignatures(
+		const std::vector<std::string> &signPatterns,
+		const std::vector<Area> &areas,
+		CompiledSignature::Mode mode) const
+{
+	const auto nSigns = signPatterns.size();
+	std::vector<unsigned long long> result(nSigns, 0);
+	std::vector<CompiledSignature> signatures;
+	std::vector<std::size_t> firstNibbles(nSigns), lastNibbles(nSigns);
+	std::vector<bool> searched(nSigns, false), found(nSigns, false);
+	std::size_t scanStart = std::numeric_limits<std::size_t>::max();
+	std::size_t scanStop = 0;
+	signatures.reserve(nSigns);
+
+	for (std::size_t i = 0; i < nSigns; ++i)
+	{
+		signatures.emplace_back(signPatterns[i], mode);
+		searched[i] = signatures[i].isMatchable() && getSearchArea(
+				signPatterns[i],
+				mode,
+				areas[i],
+				firstNibbles[i],
+				lastNibbles[i]);
+		if (searched[i])
+		{
+			const auto &chunk = signatures[i].getChunks().front();
+			scanStart = std::min(scanStart, bytesFromNibbles(firstNibbles[i]));
+			scanStop = std::max(
+					scanStop,
+					bytesFromNibbles(lastNibbles[i])
+						+ std::max(chunk.values[0].size(), chunk.values[1].size()));
+		}
+	}
+
+	const auto verify = [&] (std::size_t sign, std::size_t nibbleOffset)
+	{
+		if (!searched[sign] || found[sign]
+				|| nibbleOffset < firstNibbles[sign]
+				|| nibbleOffset > lastNibbles[sign])
+		{
+			return;
+		}
+
+		const auto &signature = signatures[sign];
+		found[sign] = mode == CompiledSignature::Mode::UNSLASHED
+				? matcher.matchChunk(signature.getChunks().front(), nibbleOffset)
+				: matcher.match(signature, nibbleOffset);
+	};
+
+	SignatureAutomaton automaton(signatures);
+	if (scanStart < scanStop)
+	{
+		automaton.scan(
+				matcher.getData(),
+				scanStart,
+				std::min(scanStop, matcher.getSize()),
+				verify);
+	}
+
+	for (const auto sign : automaton.getUnanchoredSignatures())
+	{
+		for (auto offset = firstNibbles[sign];
+				searched[sign] && !found[sign] && offset <= lastNibbles[sign];
+				++offset)
+		{
+			verify(sign, offset);
+		}
+	}
+
+	for (std::size_t i = 0; i < nSigns; ++i)
+	{
+		if (found[i])
+		{
+			result[i] = countImpNibbles(signPatterns[i]);
+		}
+	}
+
+	return result;
+}
+
 /**
  * Check if input file was successfully loaded
  * @return @c true if file was successfully loaded, @c false otherwise
@@ -166,19 +348,27 @@ bool Search::isFileSupported() const
 /**
  * Get content of file in hexadecimal string representation
  * @return Content of file in hexadecimal string representation
+ *
+ * String is created on each call, signatures are matched directly against
+ * content of file.
  */
-const std::string& Search::getNibbles() const
+std::string Search::getNibbles() const
 {
+	std::string nibbles;
+	bytesToHexString(matcher.getData(), matcher.getSize(), nibbles);
 	return nibbles;
 }
 
 /**
  * Get content of file as plain string
- * @return Content of file as plain string
+ * @return View of content of file
  */
-const std::string& Search::getPlainString() const
+std::string_view Search::getPlainString() const
 {
-	return plain;
+	const auto &bytes = parser.getLoadedBytes();
+	return std::string_view(
+			reinterpret_cast<const char*>(bytes.data()),
+			bytes.size());
 }
 
 /**
@@ -195,53 +385,11 @@ const Search::RelativeJump* Search::getRelativeJump(
 		std::size_t shift,
 		std::int64_t &moveSize) const
 {
-	const auto nibbleOffset = nibblesFromBytes(fileOffset) + shift;
-	moveSize = 0;
-
-	for (const auto &jump : jumps)
-	{
-		const auto nibblesAfter = nibblesFromBytes(jump.getBytesAfter());
-		if (!hasSubstringOnPosition(nibbles, jump.getSlash(), nibbleOffset)
-				|| (nibbleOffset + jump.getSlashNibbleSize() + nibblesAfter - 1
-						>= nibbles.length()))
-		{
-			continue;
-		}
-
-		std::uint64_t jumpedBytes = 0;
-		if (!parser.getXByteOffset(
-				fileOffset + bytesFromNibbles(jump.getSlashNibbleSize()),
-				jump.getBytesAfter(),
-				jumpedBytes,
-				Endianness::LITTLE))
-		{
-			continue;
-		}
-
-		moveSize = static_cast<std::int64_t>(jumpedBytes);
-		switch(jump.getBytesAfter())
-		{
-			case 1:
-				moveSize = static_cast<std::int8_t>(moveSize);
-				break;
-			case 2:
-				moveSize = static_cast<std::int16_t>(moveSize);
-				break;
-			case 4:
-				moveSize = static_cast<std::int32_t>(moveSize);
-				break;
-			case 8:
-				moveSize = static_cast<std::int64_t>(moveSize);
-				break;
-			default:
-				assert(false && "Unexpected value of a switch expression");
-		}
-
-		moveSize = nibblesFromBytes(moveSize);
-		return &jump;
-	}
-
-	return nullptr;
+	const auto *jump = matcher.findJump(
+			nibblesFromBytes(fileOffset) + shift,
+			fileOffset,
+			moveSize);
+	return jump ? &jumps[jump - matcher.getJumps().data()] : nullptr;
 }
 
 /**
@@ -282,31 +430,8 @@ unsigned long long Search::findUnslashedSignature(
 		std::size_t startOffset,
 		std::size_t stopOffset) const
 {
-	if (startOffset > stopOffset)
-	{
-		return 0;
-	}
-
-	const auto startIterator = nibbles.begin() + nibblesFromBytes(startOffset);
-	const auto stopIndex = nibblesFromBytes(stopOffset) + 1;
-	const auto stopIterator = stopIndex < nibbles.size()
-			? nibbles.begin() + stopIndex
-			: nibbles.end();
-	const auto it = std::search(
-			startIterator,
-			stopIterator,
-			signPattern.begin(),
-			signPattern.end(),
-			[] (const char fileNibble, const char signatureNibble)
-			{
-				return fileNibble == signatureNibble
-						|| signatureNibble == '-'
-						|| signatureNibble == '?'
-						|| signatureNibble == ';';
-			}
-	);
-
-	return (it != stopIterator) ? countImpNibbles(signPattern) : 0;
+	return findUnslashedSignatures(
+			{signPattern}, startOffset, stopOffset).front();
 }
 
 /**
@@ -322,30 +447,42 @@ unsigned long long Search::findSlashedSignature(
 		std::size_t startOffset,
 		std::size_t stopOffset) const
 {
-	if (startOffset > stopOffset)
-	{
-		return 0;
-	}
-
-	const auto areaSize = nibblesFromBytes(stopOffset - startOffset + 1);
-	const auto signSize = signPattern.length()
-			- std::count(signPattern.begin(), signPattern.end(), ';');
-	if (areaSize < signSize)
-	{
-		return false;
-	}
-	const auto iters = startOffset == stopOffset ? 1 : areaSize - signSize + 1;
+	return findSlashedSignatures(
+			{signPattern}, {{startOffset, stopOffset}}).front();
+}
 
-	for (std::size_t i = 0; i < iters; ++i)
-	{
-		const auto result = exactComparison(signPattern, startOffset, i);
-		if (result)
-		{
-			return result;
-		}
-	}
+/**
+ * Search for many unslashed patterns in selected area in one pass
+ * @param signPatterns Signature patterns
+ * @param startOffset Start offset in file (in bytes)
+ * @param stopOffset Stop offset in file (in bytes)
+ * @return For each pattern the same value as findUnslashedSignature()
+ */
+std::vector<unsigned long long> Search::findUnslashedSignatures(
+		const std::vector<std::string> &signPatterns,
+		std::size_t startOffset,
+		std::size_t stopOffset) const
+{
+	return findSignatures(
+			signPatterns,
+			std::vector<Area>(signPatterns.size(), {startOffset, stopOffset}),
+			CompiledSignature::Mode::UNSLASHED);
+}
 
-	return 0;
+/**
+ * Search for many patterns, each in its own area, in one pass
+ * @param signPatterns Signature patterns
+ * @param areas Areas of file in which patterns are searched (one per pattern)
+ * @return For each pattern the same value as findSlashedSignature()
+ */
+std::vector<unsigned long long> Search::findSlashedSignatures(
+		const std::vector<std::string> &signPatterns,
+		const std::vector<Area> &areas) const
+{
+	return findSignatures(
+			signPatterns,
+			areas,
+			CompiledSignature::Mode::EXACT);
 }
 
 /**
@@ -361,52 +498,12 @@ unsigned long long Search::exactComparison(
 		std::size_t fileOffset,
 		std::size_t shift) const
 {
-	for (std::size_t sigIndex = 0,
-			fileIndex = nibblesFromBytes(fileOffset) + shift,
-			fileLen = nibbles.length()
-			;
-			fileIndex < fileLen
-			;
-			++sigIndex, ++fileIndex)
-	{
-		if (sigIndex == signPattern.length() || signPattern[sigIndex] == ';')
-		{
-			return countImpNibbles(signPattern);
-		}
-		else if (signPattern[sigIndex] == '/')
-		{
-			std::int64_t moveSize = 0;
-			const auto actShift = parser.getNumberOfNibblesInByte()
-					? fileIndex % parser.getNumberOfNibblesInByte()
-					: 0;
-			const auto *jump = getRelativeJump(
-					bytesFromNibbles(fileIndex), actShift, moveSize);
-			if (!jump)
-			{
-				if (!haveSlashes())
-				{
-					--fileIndex;
-					continue;
-				}
-
-				return 0;
-			}
-
-			// move after one nibble is in header of cycle
-			fileIndex += jump->getSlashNibbleSize()
-					+ nibblesFromBytes(jump->getBytesAfter())
-					+ moveSize
-					- 1;
-		}
-		else if (signPattern[sigIndex] != nibbles[fileIndex]
-				&& signPattern[sigIndex] != '-'
-				&& signPattern[sigIndex] != '?')
-		{
-			return 0;
-		}
-	}
-
-	return 0;
+	const CompiledSignature signature(
+			signPattern,
+			CompiledSignature::Mode::EXACT);
+	return matcher.match(signature, nibblesFromBytes(fileOffset) + shift)
+			? countImpNibbles(signPattern)
+			: 0;
 }
 
 /**
@@ -426,64 +523,14 @@ bool Search::countSimilarity(
 		std::size_t fileOffset,
 		std::size_t shift) const
 {
-	Similarity result;
-
-	for (std::size_t sigIndex = 0,
-			fileIndex = nibblesFromBytes(fileOffset) + shift,
-			fileLen = nibbles.length()
-			;
-			fileIndex < fileLen
-			;
-			++sigIndex, ++fileIndex)
-	{
-		if (sigIndex == signPattern.length() || signPattern[sigIndex] == ';')
-		{
-			sim.same = result.same;
-			sim.total = result.total;
-			sim.ratio = static_cast<double>(result.same) / result.total;
-			return countImpNibbles(signPattern);
-		}
-		else if (signPattern[sigIndex] == '-' || signPattern[sigIndex] == '?')
-		{
-			continue;
-		}
-		else if (signPattern[sigIndex] == '/')
-		{
-			std::int64_t moveSize = 0;
-			const auto actShift = parser.getNumberOfNibblesInByte()
-					? fileIndex % parser.getNumberOfNibblesInByte()
-					: 0;
-			const auto *jump = getRelativeJump(
-					bytesFromNibbles(fileIndex), actShift, moveSize);
-			if (!jump)
-			{
-				if (!haveSlashes())
-				{
-					--fileIndex;
-					continue;
-				}
-
-				result.total += averageSlashLen;
-			}
-			else
-			{
-				result.total += jump->getSlashNibbleSize();
-				result.same += jump->getSlashNibbleSize();
-				fileIndex += jump->getSlashNibbleSize()
-						+ nibblesFromBytes(jump->getBytesAfter())
-						+ moveSize - 1;
-			}
-			continue;
-		}
-		else if (signPattern[sigIndex] == nibbles[fileIndex])
-		{
-			++result.same;
-		}
-
-		++result.total;
-	}
-
-	return false;
+	const CompiledSignature signature(
+			signPattern,
+			CompiledSignature::Mode::EXACT);
+	return matcher.similarity(
+			signature,
+			nibblesFromBytes(fileOffset) + shift,
+			sim)
+		&& countImpNibbles(signPattern);
 }
 
 /**
@@ -502,27 +549,27 @@ bool Search::areaSimilarity(
 		std::size_t startOffset,
 		std::size_t stopOffset) const
 {
-	if (startOffset > stopOffset)
+	std::size_t firstNibble = 0, lastNibble = 0;
+	if (!countImpNibbles(signPattern)
+			|| !getSearchArea(
+					signPattern,
+					CompiledSignature::Mode::EXACT,
+					{startOffset, stopOffset},
+					firstNibble,
+					lastNibble))
 	{
 		return false;
 	}
 
-	const auto areaSize = nibblesFromBytes(stopOffset - startOffset + 1);
-	const auto signSize = signPattern.length()
-			- std::count(signPattern.begin(), signPattern.end(), ';');
-	if (areaSize < signSize)
-	{
-		return false;
-	}
-	const auto iters = startOffset == stopOffset
-			? 1
-			: areaSize - signSize + 1;
+	const CompiledSignature signature(
+			signPattern,
+			CompiledSignature::Mode::EXACT);
 	auto result = false;
 	Similarity act, max;
 
-	for (std::size_t i = 0; i < iters; ++i)
+	for (auto i = firstNibble; i <= lastNibble; ++i)
 	{
-		if (countSimilarity(signPattern, act, startOffset, i)
+		if (matcher.similarity(signature, i, act)
 				&& (act.ratio > max.ratio
 						|| (areEqual(act.ratio, max.ratio)
 								&& act.total > max.total)))
@@ -551,7 +598,7 @@ bool Search::areaSimilarity(
  */
 bool Search::hasString(const std::string &str) const
 {
-	return contains(plain, str);
+	return getPlainString().find(str) != std::string_view::npos;
 }
 
 /**
@@ -563,7 +610,9 @@ bool Search::hasString(const std::string &str) const
  */
 bool Search::hasString(const std::string &str, std::size_t fileOffset) const
 {
-	return hasSubstringOnPosition(plain, str, fileOffset);
+	const auto plain = getPlainString();
+	return fileOffset < plain.length()
+			&& plain.substr(fileOffset, str.length()) == str;
 }
 
 /**
@@ -579,7 +628,14 @@ bool Search::hasString(
 		std::size_t startOffset,
 		std::size_t stopOffset) const
 {
-	return hasSubstringInArea(plain, str, startOffset, stopOffset);
+	const auto plain = getPlainString();
+	if (startOffset > stopOffset || startOffset >= plain.length())
+	{
+		return false;
+	}
+
+	const auto area = plain.substr(startOffset, stopOffset - startOffset + 1);
+	return !area.empty() && area.find(str) != std::string_view::npos;
 }
 
 /**
@@ -641,7 +697,7 @@ bool Search::createSignature(
 
 	for (std::size_t i = 0,
 			fileIndex = nibblesFromBytes(fileOffset),
-			fileLen = nibbles.length(),
+			fileLen = matcher.getNumberOfNibbles(),
 			nibbleSize = nibblesFromBytes(size)
 			;
 			fileIndex < fileLen && i < nibbleSize
@@ -664,7 +720,8 @@ bool Search::createSignature(
 		}
 		else
 		{
-			pattern += nibbles[fileIndex];
+			const auto byte = matcher.getData()[fileIndex / 2];
+			pattern += "0123456789ABCDEF"[fileIndex % 2 ? byte & 0xF : byte >> 4];
 		}
 	}
 
@@ -0,0 +1,752 @@
+/**
+ * @file src/cpdetect/signature_matcher.cpp
+ * @brief Matching of signature patterns against raw bytes.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <deque>
+#include <limits>
+
+#include "retdec/cpdetect/signature_matcher.h"
+
+namespace retdec {
+namespace cpdetect {
+
+namespace
+{
+
+/// maximal length of anchor in bytes
+const std::size_t MAX_ANCHOR_LENGTH = 16;
+/// representation of variable nibble
+const int VARIABLE_NIBBLE = -1;
+/// representation of character which never matches
+const int INVALID_NIBBLE = -2;
+/// representation of nonexistent transition of automaton
+const std::size_t NO_STATE = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Get value of one character of signature pattern
+ * @param c Character of pattern
+ * @param mode Interpretation of special characters
+ * @return Value of nibble, @c VARIABLE_NIBBLE or @c INVALID_NIBBLE
+ */
+int getNibbleValue(char c, CompiledSignature::Mode mode)
+{
+	if (c >= '0' && c <= '9')
+	{
+		return c - '0';
+	}
+	else if (c >= 'A' && c <= 'F')
+	{
+		return c - 'A' + 10;
+	}
+	else if (c == '-' || c == '?'
+			|| (c == ';' && mode == CompiledSignature::Mode::UNSLASHED))
+	{
+		return VARIABLE_NIBBLE;
+	}
+
+	return INVALID_NIBBLE;
+}
+
+/**
+ * Compile part of signature pattern without slashes
+ * @param pattern Signature pattern
+ * @param start Index of the first character of chunk
+ * @param end Index after the last character of chunk
+ * @param mode Interpretation of special characters
+ * @return Compiled chunk
+ */
+CompiledSignature::Chunk compileChunk(
+		const std::string &pattern,
+		std::size_t start,
+		std::size_t end,
+		CompiledSignature::Mode mode)
+{
+	CompiledSignature::Chunk chunk;
+	chunk.nibbles = end - start;
+	for (std::size_t parity = 0; parity < 2; ++parity)
+	{
+		const auto bytes = (parity + chunk.nibbles + 1) / 2;
+		chunk.values[parity].assign(bytes, 0);
+		chunk.masks[parity].assign(bytes, 0);
+	}
+
+	for (std::size_t i = 0; i < chunk.nibbles; ++i)
+	{
+		const auto value = getNibbleValue(pattern[start + i], mode);
+		if (value == VARIABLE_NIBBLE)
+		{
+			continue;
+		}
+
+		++chunk.significant;
+		if (value == INVALID_NIBBLE)
+		{
+			chunk.matchable = false;
+			continue;
+		}
+
+		for (std::size_t parity = 0; parity < 2; ++parity)
+		{
+			const auto index = parity + i;
+			const auto shift = index % 2 ? 0 : 4;
+			chunk.values[parity][index / 2] |= value << shift;
+			chunk.masks[parity][index / 2] |= 0xF << shift;
+		}
+	}
+
+	return chunk;
+}
+
+/**
+ * Find the longest run of fully specified bytes in chunk
+ * @param chunk Compiled chunk
+ * @param parity Parity of the first nibble of chunk
+ * @param length Into this parameter is stored length of run
+ * @return Index of the first byte of run
+ */
+std::size_t findLongestLiteralRun(
+		const CompiledSignature::Chunk &chunk,
+		std::size_t parity,
+		std::size_t &length)
+{
+	const auto &masks = chunk.masks[parity];
+	std::size_t bestStart = 0, start = 0;
+	length = 0;
+
+	for (std::size_t i = 0, e = masks.size(); i <= e; ++i)
+	{
+		if (i < e && masks[i] == 0xFF)
+		{
+			continue;
+		}
+
+		if (i - start > length)
+		{
+			bestStart = start;
+			length = i - start;
+		}
+		start = i + 1;
+	}
+
+	return bestStart;
+}
+
+} // anonymous namespace
+
+/**
+ * Constructor
+ * @param pattern Signature pattern
+ * @param mode Interpretation of special characters in @a pattern
+ */
+CompiledSignature::CompiledSignature(const std::string &pattern, Mode mode)
+{
+	if (mode == Mode::UNSLASHED)
+	{
+		chunks.push_back(compileChunk(pattern, 0, pattern.length(), mode));
+		return;
+	}
+
+	const auto end = std::min(pattern.find(';'), pattern.length());
+	for (std::size_t start = 0; ; )
+	{
+		const auto slash = pattern.find('/', start);
+		if (slash >= end)
+		{
+			chunks.push_back(compileChunk(pattern, start, end, mode));
+			break;
+		}
+
+		chunks.push_back(compileChunk(pattern, start, slash, mode));
+		start = slash + 1;
+	}
+}
+
+/**
+ * Get compiled chunks
+ * @return Chunks of pattern, each two neighbouring chunks are separated
+ *    by one slash
+ */
+const std::vector<CompiledSignature::Chunk>& CompiledSignature::getChunks() const
+{
+	return chunks;
+}
+
+/**
+ * Get number of slashes in compiled pattern
+ * @return Number of slashes
+ */
+std::size_t CompiledSignature::getNumberOfSlashes() const
+{
+	return chunks.size() - 1;
+}
+
+/**
+ * Check if pattern can match some content
+ * @return @c false if pattern contains character which never matches,
+ *    @c true otherwise
+ */
+bool CompiledSignature::isMatchable() const
+{
+	return std::all_of(chunks.begin(), chunks.end(),
+			[] (const auto &chunk)
+			{
+				return chunk.matchable;
+			}
+	);
+}
+
+/**
+ * Constructor
+ * @param fileData Content of file
+ * @param fileSize Size of content of file
+ *
+ * Content of file is not copied, it must outlive the matcher.
+ */
+SignatureMatcher::SignatureMatcher(
+		const std::uint8_t *fileData,
+		std::size_t fileSize)
+		: data(fileData)
+		, size(fileSize)
+{
+
+}
+
+/**
+ * Add supported relative jump
+ * @param slash Representation of '/' in file
+ * @param bytesAfter Number of bytes after @a slash which contain relative
+ *    offset of jump (in little endian)
+ */
+void SignatureMatcher::addJump(const std::string &slash, std::size_t bytesAfter)
+{
+	Jump jump;
+	jump.slash = compileChunk(
+			slash,
+			0,
+			slash.length(),
+			CompiledSignature::Mode::EXACT);
+	jump.bytesAfter = bytesAfter;
+	jumps.push_back(jump);
+}
+
+/**
+ * Set average length of one slash representation
+ * @param length Average length in nibbles
+ */
+void SignatureMatcher::setAverageSlashLength(std::size_t length)
+{
+	averageSlashLen = length;
+}
+
+/**
+ * Get content of file
+ * @return Pointer to content of file
+ */
+const std::uint8_t* SignatureMatcher::getData() const
+{
+	return data;
+}
+
+/**
+ * Get size of content of file
+ * @return Size of content of file in bytes
+ */
+std::size_t SignatureMatcher::getSize() const
+{
+	return size;
+}
+
+/**
+ * Get supported relative jumps
+ * @return Supported relative jumps
+ */
+const std::vector<SignatureMatcher::Jump>& SignatureMatcher::getJumps() const
+{
+	return jumps;
+}
+
+/**
+ * Get size of content of file in nibbles
+ * @return Number of nibbles
+ */
+std::size_t SignatureMatcher::getNumberOfNibbles() const
+{
+	return size * 2;
+}
+
+/**
+ * Read relative offset of jump
+ * @param jump Detected jump
+ * @param byteOffset Offset of relative offset in file
+ * @param value Into this parameter is stored sign-extended relative offset
+ * @return @c true if offset was successfully read, @c false otherwise
+ */
+bool SignatureMatcher::readJumpOffset(
+		const Jump &jump,
+		std::size_t byteOffset,
+		std::int64_t &value) const
+{
+	const auto bytes = jump.bytesAfter;
+	if (bytes > sizeof(std::uint64_t) || byteOffset > size
+			|| size - byteOffset < bytes)
+	{
+		return false;
+	}
+
+	std::uint64_t result = 0;
+	for (std::size_t i = 0; i < bytes; ++i)
+	{
+		result |= static_cast<std::uint64_t>(data[byteOffset + i]) << (8 * i);
+	}
+
+	switch (bytes)
+	{
+		case 1:
+			value = static_cast<std::int8_t>(result);
+			break;
+		case 2:
+			value = static_cast<std::int16_t>(result);
+			break;
+		case 4:
+			value = static_cast<std::int32_t>(result);
+			break;
+		case 8:
+			value = static_cast<std::int64_t>(result);
+			break;
+		default:
+			assert(false && "Unexpected value of a switch expression");
+			value = 0;
+	}
+
+	return true;
+}
+
+/**
+ * Compare chunk of signature with content of file
+ * @param chunk Compiled chunk
+ * @param nibbleOffset Offset in file (in nibbles)
+ * @return @c true if whole chunk lies in file and all its significant nibbles
+ *    agree with content of file, @c false otherwise
+ */
+bool SignatureMatcher::matchChunk(
+		const CompiledSignature::Chunk &chunk,
+		std::size_t nibbleOffset) const
+{
+	const auto nibbles = getNumberOfNibbles();
+	if (!chunk.matchable || nibbleOffset > nibbles
+			|| nibbles - nibbleOffset < chunk.nibbles)
+	{
+		return false;
+	}
+
+	const auto parity = nibbleOffset % 2;
+	const auto *values = chunk.values[parity].data();
+	const auto *masks = chunk.masks[parity].data();
+	const auto *file = data + nibbleOffset / 2;
+	const auto bytes = chunk.values[parity].size();
+	std::size_t i = 0;
+
+	for (; i + sizeof(std::uint64_t) <= bytes; i += sizeof(std::uint64_t))
+	{
+		std::uint64_t f, v, m;
+		std::memcpy(&f, file + i, sizeof(f));
+		std::memcpy(&v, values + i, sizeof(v));
+		std::memcpy(&m, masks + i, sizeof(m));
+		if ((f ^ v) & m)
+		{
+			return false;
+		}
+	}
+
+	for (; i < bytes; ++i)
+	{
+		if ((file[i] ^ values[i]) & masks[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Count significant nibbles of chunk which agree with content of file
+ * @param chunk Compiled chunk
+ * @param nibbleOffset Offset in file (in nibbles)
+ * @return Number of agreeing nibbles
+ *
+ * Whole chunk must lie in file.
+ */
+std::size_t SignatureMatcher::countSameNibbles(
+		const CompiledSignature::Chunk &chunk,
+		std::size_t nibbleOffset) const
+{
+	const auto parity = nibbleOffset % 2;
+	const auto &values = chunk.values[parity];
+	const auto &masks = chunk.masks[parity];
+	const auto *file = data + nibbleOffset / 2;
+	std::size_t same = 0;
+
+	for (std::size_t i = 0, e = values.size(); i < e; ++i)
+	{
+		const auto diff = (file[i] ^ values[i]) & masks[i];
+		same += (masks[i] & 0xF0) && !(diff & 0xF0);
+		same += (masks[i] & 0x0F) && !(diff & 0x0F);
+	}
+
+	return same;
+}
+
+/**
+ * Check if relative jump is present on specified offset
+ * @param nibbleOffset Offset of slash in file (in nibbles)
+ * @param byteOffset Offset in file (in bytes) from which relative offset of
+ *    jump is counted
+ * @param moveSize Into this parameter is stored number of nibbles of which
+ *    will jump or zero if @c nullptr is returned
+ * @return Pointer to the description of detected jump or @c nullptr if jump
+ *    is not detected
+ */
+const SignatureMatcher::Jump* SignatureMatcher::findJump(
+		std::size_t nibbleOffset,
+		std::size_t byteOffset,
+		std::int64_t &moveSize) const
+{
+	moveSize = 0;
+
+	for (const auto &jump : jumps)
+	{
+		const auto slashLen = jump.slash.nibbles;
+		if (!matchChunk(jump.slash, nibbleOffset)
+				|| nibbleOffset + slashLen + jump.bytesAfter * 2 - 1
+						>= getNumberOfNibbles())
+		{
+			continue;
+		}
+
+		std::int64_t value = 0;
+		if (!readJumpOffset(jump, byteOffset + slashLen / 2, value))
+		{
+			continue;
+		}
+
+		moveSize = value * 2;
+		return &jump;
+	}
+
+	return nullptr;
+}
+
+/**
+ * Check if signature matches content of file on specified offset
+ * @param signature Signature compiled in CompiledSignature::Mode::EXACT mode
+ * @param nibbleOffset Offset in file (in nibbles)
+ * @return @c true if signature matches, @c false otherwise
+ */
+bool SignatureMatcher::match(
+		const CompiledSignature &signature,
+		std::size_t nibbleOffset) const
+{
+	const auto nibbles = static_cast<std::int64_t>(getNumberOfNibbles());
+	const auto &chunks = signature.getChunks();
+	auto offset = static_cast<std::int64_t>(nibbleOffset);
+
+	for (std::size_t i = 0, e = chunks.size(); i < e; ++i)
+	{
+		if (i)
+		{
+			if (offset >= nibbles)
+			{
+				return false;
+			}
+
+			std::int64_t moveSize = 0;
+			const auto *jump = findJump(offset, offset / 2, moveSize);
+			if (jump)
+			{
+				offset += static_cast<std::int64_t>(
+						jump->slash.nibbles + jump->bytesAfter * 2) + moveSize;
+				if (offset < 0)
+				{
+					return false;
+				}
+			}
+			else if (!jumps.empty())
+			{
+				return false;
+			}
+		}
+
+		if (!matchChunk(chunks[i], offset))
+		{
+			return false;
+		}
+		offset += chunks[i].nibbles;
+	}
+
+	return offset < nibbles;
+}
+
+/**
+ * Count similarity of signature and content of file on specified offset
+ * @param signature Signature compiled in CompiledSignature::Mode::EXACT mode
+ * @param nibbleOffset Offset in file (in nibbles)
+ * @param sim Structure for save similarity
+ * @return @c true if whole signature lies in file, @c false otherwise
+ *
+ * If function return @c false, @a sim is left unchanged
+ */
+bool SignatureMatcher::similarity(
+		const CompiledSignature &signature,
+		std::size_t nibbleOffset,
+		Similarity &sim) const
+{
+	const auto nibbles = static_cast<std::int64_t>(getNumberOfNibbles());
+	const auto &chunks = signature.getChunks();
+	auto offset = static_cast<std::int64_t>(nibbleOffset);
+	Similarity result;
+
+	for (std::size_t i = 0, e = chunks.size(); i < e; ++i)
+	{
+		const auto &chunk = chunks[i];
+		if (i)
+		{
+			if (offset >= nibbles)
+			{
+				return false;
+			}
+
+			std::int64_t moveSize = 0;
+			const auto *jump = findJump(offset, offset / 2, moveSize);
+			if (jump)
+			{
+				result.total += jump->slash.nibbles;
+				result.same += jump->slash.nibbles;
+				offset += static_cast<std::int64_t>(
+						jump->slash.nibbles + jump->bytesAfter * 2) + moveSize;
+				if (offset < 0)
+				{
+					return false;
+				}
+			}
+			else if (!jumps.empty())
+			{
+				result.total += averageSlashLen;
+				++offset;
+			}
+		}
+
+		if (offset > nibbles
+				|| nibbles - offset < static_cast<std::int64_t>(chunk.nibbles))
+		{
+			return false;
+		}
+
+		result.same += countSameNibbles(chunk, offset);
+		result.total += chunk.significant;
+		offset += chunk.nibbles;
+	}
+
+	if (offset >= nibbles)
+	{
+		return false;
+	}
+
+	sim.same = result.same;
+	sim.total = result.total;
+	sim.ratio = static_cast<double>(result.same) / result.total;
+	return true;
+}
+
+/**
+ * Constructor
+ * @param signatures Compiled signatures
+ */
+SignatureAutomaton::SignatureAutomaton(
+		const std::vector<CompiledSignature> &signatures)
+{
+	states.emplace_back();
+
+	for (std::size_t i = 0, e = signatures.size(); i < e; ++i)
+	{
+		if (!signatures[i].isMatchable())
+		{
+			continue;
+		}
+
+		const auto &chunk = signatures[i].getChunks().front();
+		std::size_t starts[2], lengths[2];
+		for (std::size_t parity = 0; parity < 2; ++parity)
+		{
+			starts[parity] = findLongestLiteralRun(
+					chunk,
+					parity,
+					lengths[parity]);
+			lengths[parity] = std::min(lengths[parity], MAX_ANCHOR_LENGTH);
+		}
+
+		if (!lengths[0] || !lengths[1])
+		{
+			unanchored.push_back(i);
+			continue;
+		}
+
+		for (std::size_t parity = 0; parity < 2; ++parity)
+		{
+			addAnchor(
+					chunk.values[parity].data() + starts[parity],
+					lengths[parity],
+					{i, parity, starts[parity] + lengths[parity]});
+		}
+	}
+
+	buildFailureTransitions();
+}
+
+/**
+ * Find transition of automaton
+ * @param state Source state
+ * @param c Input byte
+ * @return Target state or @c NO_STATE if there is no such transition
+ */
+std::size_t SignatureAutomaton::findTransition(
+		std::size_t state,
+		std::uint8_t c) const
+{
+	const auto &next = states[state].next;
+	const auto it = std::lower_bound(next.begin(), next.end(), c,
+			[] (const auto &transition, std::uint8_t value)
+			{
+				return transition.first < value;
+			}
+	);
+
+	return it != next.end() && it->first == c ? it->second : NO_STATE;
+}
+
+/**
+ * Add anchor into trie of automaton
+ * @param anchor Bytes of anchor
+ * @param length Number of bytes of anchor
+ * @param info Description of anchor
+ */
+void SignatureAutomaton::addAnchor(
+		const std::uint8_t *anchor,
+		std::size_t length,
+		const Anchor &info)
+{
+	std::size_t state = 0;
+
+	for (std::size_t i = 0; i < length; ++i)
+	{
+		auto next = findTransition(state, anchor[i]);
+		if (next == NO_STATE)
+		{
+			next = states.size();
+			auto &transitions = states[state].next;
+			transitions.insert(
+					std::upper_bound(transitions.begin(), transitions.end(),
+							std::make_pair(anchor[i], std::size_t(0))),
+					std::make_pair(anchor[i], next));
+			states.emplace_back();
+		}
+		state = next;
+	}
+
+	states[state].anchors.push_back(info);
+}
+
+/**
+ * Compute failure transitions of all states
+ */
+void SignatureAutomaton::buildFailureTransitions()
+{
+	std::deque<std::size_t> queue;
+	for (const auto &transition : states[0].next)
+	{
+		queue.push_back(transition.second);
+	}
+
+	while (!queue.empty())
+	{
+		const auto state = queue.front();
+		queue.pop_front();
+
+		for (const auto &transition : states[state].next)
+		{
+			auto fail = states[state].fail;
+			auto target = findTransition(fail, transition.first);
+			while (target == NO_STATE && fail)
+			{
+				fail = states[fail].fail;
+				target = findTransition(fail, transition.first);
+			}
+
+			auto &next = states[transition.second];
+			next.fail = target == NO_STATE ? 0 : target;
+			const auto &inherited = states[next.fail].anchors;
+			next.anchors.insert(
+					next.anchors.end(),
+					inherited.begin(),
+					inherited.end());
+			queue.push_back(transition.second);
+		}
+	}
+}
+
+/**
+ * Get signatures which are not reported by scan()
+ * @return Indexes of signatures without anchor
+ */
+const std::vector<std::size_t>& SignatureAutomaton::getUnanchoredSignatures() const
+{
+	return unanchored;
+}
+
+/**
+ * Report all possible occurrences of anchored signatures
+ * @param data Content of file
+ * @param startOffset Start offset of scanned area (in bytes)
+ * @param stopOffset Offset after the end of scanned area (in bytes)
+ * @param callback Function called for each occurrence of anchor
+ *
+ * Occurrences are reported only for anchors lying completely in scanned area.
+ * Reported offsets of signatures have to be verified by SignatureMatcher.
+ */
+void SignatureAutomaton::scan(
+		const std::uint8_t *data,
+		std::size_t startOffset,
+		std::size_t stopOffset,
+		const Callback &callback) const
+{
+	std::size_t state = 0;
+
+	for (auto i = startOffset; i < stopOffset; ++i)
+	{
+		auto next = findTransition(state, data[i]);
+		while (next == NO_STATE && state)
+		{
+			state = states[state].fail;
+			next = findTransition(state, data[i]);
+		}
+		state = next == NO_STATE ? 0 : next;
+
+		for (const auto &anchor : states[state].anchors)
+		{
+			if (i + 1 >= anchor.end)
+			{
+				callback(
+						anchor.signature,
+						(i + 1 - anchor.end) * 2 + anchor.parity);
+			}
+		}
+	}
+}
+
+} // namespace cpdetect
+} // namespace retdec
@@ -0,0 +1,93 @@
+/**
+ * @file src/ctypescompilertool/ctypes_compiler.cpp
+ * @brief Compiles C-types in JSON to precompiled type libraries.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include "retdec/ctypesparser/exceptions.h"
+#include "retdec/ctypesparser/type_library.h"
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/io/log.h"
+
+using namespace retdec::utils::io;
+using namespace retdec::ctypesparser;
+
+/**
+ * @brief String constant containing help.
+ */
+const std::string helpmsg =
+	"Usage:\n"
+	"\t'retdec-ctypes-compiler [-h, --help]   | Show this help.\n"
+	"\t'retdec-ctypes-compiler <file.json>... | Compile each <file.json> to <file.lti> next to it.\n";
+
+/**
+ * @brief Compiles C-types in JSON file @a jsonPath to type library.
+ *
+ * @return @c true on success, @c false otherwise.
+ */
+bool compileFile(const std::string &jsonPath)
+{
+	std::string libraryPath = TypeLibrary::getLibraryPath(jsonPath);
+
+	std::ifstream json(jsonPath, std::ios::binary);
+	if (!json)
+	{
+		Log::error() << Log::Error << "cannot open " << jsonPath << std::endl;
+		return false;
+	}
+
+	// Compile to a temporary file first, so that nobody ever sees a partially
+	// written library.
+	std::string tmpPath = libraryPath + ".tmp";
+	try
+	{
+		std::ofstream library(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!library)
+		{
+			Log::error() << Log::Error << "cannot create " << tmpPath << std::endl;
+			return false;
+		}
+		TypeLibrary::compile(json, library);
+	}
+	catch (const CTypesParseError &e)
+	{
+		Log::error() << Log::Error << jsonPath << ": " << e.what() << std::endl;
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+
+	std::error_code ec;
+	fs::rename(tmpPath, libraryPath, ec);
+	if (ec)
+	{
+		Log::error() << Log::Error << "cannot create " << libraryPath << std::endl;
+		std::remove(tmpPath.c_str());
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @brief Main function of the C-types compiler tool.
+ */
+int main(int argc, char *argv[])
+{
+	if (argc <= 1 || strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--help") == 0) {
+		Log::info() << helpmsg;
+		return 0;
+	}
+
+	int ret = 0;
+	for (int i = 1; i < argc; ++i) {
+		if (!compileFile(argv[i])) {
+			ret = 1;
+		}
+	}
+	return ret;
+}
@@ -232,6 +232,58 @@ void JSONCTypesParser::parseInto(
 	parseJsonIntoModule(root, module);
 }
 
+/**
+* @brief Parses a single function from the type library to user's module.
+*
+* @param[in] library Type library containing the function.
+* @param[in] name Name of the function.
+* @param[in] module User's module.
+* @param[in] typeWidths C-types' bit widths.
+* @param[in] callConvention Function call convention.
+*
+* @return Parsed function, or @c nullptr if @a library does not contain it.
+*
+* @throw CTypesParseError when the library records are invalid.
+*
+* Only the function and the types it uses are parsed. Types are shared by all
+* the functions parsed from the same library, so each library should have its
+* own parser.
+*/
+std::shared_ptr<retdec::ctypes::Function> JSONCTypesParser::parseFunctionInto(
+	const TypeLibrary &library,
+	const std::string &name,
+	std::unique_ptr<retdec::ctypes::Module> &module,
+	const CTypesParser::TypeWidths &typeWidths,
+	const retdec::ctypes::CallConvention &callConvention)
+{
+	assert(module && "violated precondition - module cannot be null");
+
+	std::string_view record;
+	if (!library.getFunction(name, record))
+	{
+		return nullptr;
+	}
+
+	context = module->getContext();
+	defaultCallConv = callConvention;
+	this->typeWidths = typeWidths;
+
+	// Keys of types are valid only in the library they come from.
+	if (typesLibrary != &library)
+	{
+		parserContext.clear();
+		typesMap.clear();
+		typesLibrary = &library;
+	}
+
+	libraryRecords.clear();
+	auto newFunction = getOrParseFunction(name, parseLibraryRecord(record));
+	libraryRecords.clear();
+
+	module->addFunction(newFunction);
+	return newFunction;
+}
+
 /**
 * @brief Loads JSON from the input stream to a string.
 */
@@ -276,6 +328,7 @@ void JSONCTypesParser::parseJsonIntoModule(
 {
 	// We need a clean context for each JSON because types may have different keys.
 	parserContext.clear();
+	typesLibrary = nullptr;
 	const rapidjson::Value &functions = safeGetObject(*root, JSON_functions);
 
 	addTypesToMap(safeGetObject(*root, JSON_types));
@@ -302,6 +355,48 @@ void JSONCTypesParser::addTypesToMap(const rapidjson::Value &types)
 	}
 }
 
+/**
+* @brief Parses JSON record from @c typesLibrary.
+*
+* The record is kept in @c libraryRecords, so its values may be referenced
+* until the parsing of the current function is finished.
+*
+* @throw CTypesParseError when the record is invalid.
+*/
+const rapidjson::Value &JSONCTypesParser::parseLibraryRecord(std::string_view record)
+{
+	auto doc = std::make_unique<rapidjson::Document>();
+	rapidjson::ParseResult res = doc->Parse(record.data(), record.size());
+	if (!res)
+	{
+		handleParsingFailure(res);
+	}
+	libraryRecords.push_back(std::move(doc));
+	return *libraryRecords.back();
+}
+
+/**
+* @brief Returns JSON representation of type with key @a typeKey.
+*
+* The type is taken from @c typesLibrary if set, from @c typesMap otherwise.
+*
+* @throw CTypesParseError when the type is missing in the library.
+*/
+const rapidjson::Value &JSONCTypesParser::getJsonType(const std::string &typeKey)
+{
+	if (typesLibrary == nullptr)
+	{
+		return retdec::utils::mapGetValueOrDefault(typesMap, typeKey)->value;
+	}
+
+	std::string_view record;
+	if (!typesLibrary->getType(typeKey, record))
+	{
+		throw CTypesParseError("type " + typeKey + " is missing in type library");
+	}
+	return parseLibraryRecord(record);
+}
+
 /**
 * @brief Returns function from context, if already stored, otherwise parse new one.
 *
@@ -504,7 +599,7 @@ std::shared_ptr<retdec::ctypes::Type> JSONCTypesParser::getOrParseType(
 std::shared_ptr<retdec::ctypes::Type> JSONCTypesParser::parseType(
 	const std::string &typeKey)
 {
-	const rapidjson::Value &jsonType = retdec::utils::mapGetValueOrDefault(typesMap, typeKey)->value;
+	const rapidjson::Value &jsonType = getJsonType(typeKey);
 	std::string typeOfType = safeGetString(jsonType, JSON_type);
 	std::shared_ptr<retdec::ctypes::Type> parsedType;
 
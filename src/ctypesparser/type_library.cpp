@@ -0,0 +1,373 @@
+/**
+* @file src/ctypesparser/type_library.cpp
+* @brief Precompiled library of C-types.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "retdec/ctypesparser/exceptions.h"
+#include "retdec/ctypesparser/type_library.h"
+#include "retdec/utils/string.h"
+
+namespace {
+
+const char LIBRARY_MAGIC[] = {'R', 'D', 'T', 'L'};
+const std::uint32_t LIBRARY_VERSION = 1;
+
+/// Size of the header (magic, version, function count, type count).
+const std::size_t HEADER_SIZE = 16;
+/// Size of one index entry (name offset and size, record offset and size).
+const std::size_t ENTRY_SIZE = 16;
+
+/**
+* @brief Named record of the library being compiled.
+*/
+struct Record
+{
+	std::string name;
+	std::string json;
+};
+
+void writeU32(std::string &out, std::size_t value)
+{
+	if (value > std::numeric_limits<std::uint32_t>::max())
+	{
+		throw retdec::ctypesparser::CTypesParseError(
+			"Type library is too large.");
+	}
+
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+	}
+}
+
+/**
+* @brief Minifies all members of the JSON object to records sorted by names.
+*/
+std::vector<Record> getRecords(
+	const rapidjson::Value &root,
+	const std::string &name)
+{
+	auto res = root.FindMember(name.c_str());
+	if (res == root.MemberEnd() || !res->value.IsObject())
+	{
+		throw retdec::ctypesparser::CTypesParseError(
+			name + " must be an object value");
+	}
+
+	std::vector<Record> records;
+	const rapidjson::Value &object = res->value;
+	for (auto i = object.MemberBegin(), e = object.MemberEnd(); i != e; ++i)
+	{
+		rapidjson::StringBuffer buffer;
+		rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+		i->value.Accept(writer);
+		records.push_back(Record{
+			std::string(i->name.GetString(), i->name.GetStringLength()),
+			std::string(buffer.GetString(), buffer.GetSize())});
+	}
+
+	// The first occurrence of the name wins, as in the JSON parser.
+	std::stable_sort(records.begin(), records.end(),
+		[](const Record &r1, const Record &r2) { return r1.name < r2.name; });
+	records.erase(
+		std::unique(records.begin(), records.end(),
+			[](const Record &r1, const Record &r2) { return r1.name == r2.name; }),
+		records.end());
+	return records;
+}
+
+/**
+* @brief Writes index of @a records to @a index and their names and JSONs to
+*        @a blob, which starts at @a blobOffset in the library.
+*/
+void writeRecords(
+	const std::vector<Record> &records,
+	std::size_t blobOffset,
+	std::string &index,
+	std::string &blob)
+{
+	for (const auto &r : records)
+	{
+		writeU32(index, blobOffset + blob.size());
+		writeU32(index, r.name.size());
+		blob += r.name;
+		writeU32(index, blobOffset + blob.size());
+		writeU32(index, r.json.size());
+		blob += r.json;
+	}
+}
+
+} // anonymous namespace
+
+namespace retdec {
+namespace ctypesparser {
+
+const std::string TypeLibrary::FILE_EXTENSION = ".lti";
+
+/**
+* @brief Compiles C-types in JSON to a type library.
+*
+* @param[in] json Input stream containing C-types in JSON.
+* @param[out] library Output stream for the compiled library.
+*
+* @throw CTypesParseError when the input JSON is invalid.
+*/
+void TypeLibrary::compile(std::istream &json, std::ostream &library)
+{
+	std::ostringstream sstr;
+	sstr << json.rdbuf();
+	if (!json.good())
+	{
+		throw CTypesParseError("Failed to read from the input stream.");
+	}
+	std::string buffer = sstr.str();
+
+	rapidjson::Document root;
+	rapidjson::ParseResult res = root.Parse(buffer.c_str(), buffer.size());
+	if (!res)
+	{
+		std::ostringstream errMsg;
+		errMsg << "Failed to parse JSON.\n";
+		errMsg << "Error (offset " << res.Offset() << "): "
+			<< GetParseError_En(res.Code());
+		throw CTypesParseError(errMsg.str());
+	}
+
+	auto functions = getRecords(root, "functions");
+	auto types = getRecords(root, "types");
+
+	std::string out(LIBRARY_MAGIC, sizeof(LIBRARY_MAGIC));
+	writeU32(out, LIBRARY_VERSION);
+	writeU32(out, functions.size());
+	writeU32(out, types.size());
+
+	std::size_t blobOffset = HEADER_SIZE
+		+ (functions.size() + types.size()) * ENTRY_SIZE;
+	std::string blob;
+	writeRecords(functions, blobOffset, out, blob);
+	writeRecords(types, blobOffset, out, blob);
+	out += blob;
+
+	library.write(out.data(), out.size());
+	if (!library.good())
+	{
+		throw CTypesParseError("Failed to write to the output stream.");
+	}
+}
+
+/**
+* @brief Loads the type library from file.
+*
+* @return Loaded library, or @c nullptr if the file cannot be read.
+*
+* @throw CTypesParseError when the file is not a valid type library.
+*/
+std::unique_ptr<TypeLibrary> TypeLibrary::fromFile(const std::string &path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		return nullptr;
+	}
+
+	std::ostringstream sstr;
+	sstr << file.rdbuf();
+	if (!file.good())
+	{
+		return nullptr;
+	}
+	return fromBuffer(sstr.str());
+}
+
+/**
+* @brief Creates the type library from its content.
+*
+* @throw CTypesParseError when @a buffer is not a valid type library.
+*/
+std::unique_ptr<TypeLibrary> TypeLibrary::fromBuffer(std::string buffer)
+{
+	return std::unique_ptr<TypeLibrary>(new TypeLibrary(std::move(buffer)));
+}
+
+/**
+* @brief Returns path of the type library compiled from JSON in @a jsonPath.
+*/
+std::string TypeLibrary::getLibraryPath(const std::string &jsonPath)
+{
+	static const std::string jsonExtension = ".json";
+
+	if (retdec::utils::endsWith(jsonPath, jsonExtension))
+	{
+		return jsonPath.substr(0, jsonPath.size() - jsonExtension.size())
+			+ FILE_EXTENSION;
+	}
+	return jsonPath + FILE_EXTENSION;
+}
+
+/**
+* @brief Constructs the library and checks that all its records are in it.
+*
+* @throw CTypesParseError when @a buffer is not a valid type library.
+*/
+TypeLibrary::TypeLibrary(std::string buffer):
+	data(std::move(buffer))
+{
+	if (data.size() < HEADER_SIZE
+			|| !std::equal(std::begin(LIBRARY_MAGIC), std::end(LIBRARY_MAGIC),
+				data.begin()))
+	{
+		throw CTypesParseError("Not a type library.");
+	}
+	if (readU32(4) != LIBRARY_VERSION)
+	{
+		throw CTypesParseError("Unsupported version of type library.");
+	}
+
+	functionCount = readU32(8);
+	typeCount = readU32(12);
+	if ((data.size() - HEADER_SIZE) / ENTRY_SIZE < functionCount + typeCount)
+	{
+		throw CTypesParseError("Truncated type library.");
+	}
+
+	for (std::size_t i = 0, e = functionCount + typeCount; i < e; ++i)
+	{
+		std::size_t entry = HEADER_SIZE + i * ENTRY_SIZE;
+		for (std::size_t field = 0; field < ENTRY_SIZE; field += 8)
+		{
+			std::size_t offset = readU32(entry + field);
+			std::size_t size = readU32(entry + field + 4);
+			if (offset > data.size() || size > data.size() - offset)
+			{
+				throw CTypesParseError("Truncated type library.");
+			}
+		}
+	}
+}
+
+/**
+* @brief Returns the number of functions in the library.
+*/
+std::size_t TypeLibrary::getFunctionCount() const
+{
+	return functionCount;
+}
+
+/**
+* @brief Returns the number of types in the library.
+*/
+std::size_t TypeLibrary::getTypeCount() const
+{
+	return typeCount;
+}
+
+/**
+* @brief Returns @c true if the library contains function @a name.
+*/
+bool TypeLibrary::hasFunction(const std::string &name) const
+{
+	std::string_view record;
+	return getFunction(name, record);
+}
+
+/**
+* @brief Finds JSON record of function @a name.
+*
+* @param[in] name Name of the function.
+* @param[out] record JSON object representing the function, if found.
+*
+* @return @c true if the function was found, @c false otherwise.
+*/
+bool TypeLibrary::getFunction(
+	const std::string &name,
+	std::string_view &record) const
+{
+	return find(HEADER_SIZE, functionCount, name, record);
+}
+
+/**
+* @brief Finds JSON record of type with key @a key.
+*
+* @param[in] key Key of the type, as used in the JSON.
+* @param[out] record JSON object representing the type, if found.
+*
+* @return @c true if the type was found, @c false otherwise.
+*/
+bool TypeLibrary::getType(
+	const std::string &key,
+	std::string_view &record) const
+{
+	return find(HEADER_SIZE + functionCount * ENTRY_SIZE, typeCount, key, record);
+}
+
+std::uint32_t TypeLibrary::readU32(std::size_t offset) const
+{
+	std::uint32_t value = 0;
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		value |= static_cast<std::uint32_t>(
+			static_cast<unsigned char>(data[offset + i])) << (8 * i);
+	}
+	return value;
+}
+
+std::string_view TypeLibrary::readString(
+	std::size_t offset,
+	std::size_t size) const
+{
+	return std::string_view(data.data() + offset, size);
+}
+
+std::string_view TypeLibrary::getName(
+	std::size_t indexOffset,
+	std::size_t i) const
+{
+	std::size_t entry = indexOffset + i * ENTRY_SIZE;
+	return readString(readU32(entry), readU32(entry + 4));
+}
+
+bool TypeLibrary::find(
+	std::size_t indexOffset,
+	std::size_t count,
+	const std::string &name,
+	std::string_view &record) const
+{
+	std::size_t first = 0;
+	std::size_t last = count;
+	while (first < last)
+	{
+		std::size_t middle = first + (last - first) / 2;
+		if (getName(indexOffset, middle) < name)
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+
+	if (first == count || getName(indexOffset, first) != name)
+	{
+		return false;
+	}
+
+	std::size_t entry = indexOffset + first * ENTRY_SIZE;
+	record = readString(readU32(entry + 8), readU32(entry + 12));
+	return true;
+}
+
+} // namespace ctypesparser
+} // namespace retdec
@@ -19,21 +19,39 @@ DebugFormat::DebugFormat()
 
 }
 
+/**
+ * Create debug information without any input file. It can be loaded from
+ * DWARF context by loadDwarf().
+ * @param dwarfRanges If not empty, only DWARF information overlapping these
+ *                    ranges is loaded.
+ */
+DebugFormat::DebugFormat(
+		const retdec::common::AddressRangeContainer& dwarfRanges)
+		:
+		_dwarfRanges(dwarfRanges)
+{
+
+}
+
 /**
  * @param inFile    Parsed file format representation of @p inputFile.
  * @param pdbFile   Input PDB file to load debugging information from.
  * @param symtab    Symbol table.
  * @param demangler Demangled instance used for this input file.
+ * @param dwarfRanges If not empty, only DWARF information overlapping these
+ *                    ranges (e.g. ranges selected for decoding) is loaded.
  */
 DebugFormat::DebugFormat(
 		retdec::loader::Image* inFile,
 		const std::string& pdbFile,
 		SymbolTable* symtab,
-		retdec::demangler::Demangler* demangler)
+		retdec::demangler::Demangler* demangler,
+		const retdec::common::AddressRangeContainer& dwarfRanges)
 		:
 		_symtab(symtab),
 		_inFile(inFile),
-		_demangler(demangler)
+		_demangler(demangler),
+		_dwarfRanges(dwarfRanges)
 {
 	_pdbFile = new retdec::pdbparser::PDBFile();
 	auto s = _pdbFile->load_pdb_file(pdbFile.c_str());
@@ -6,10 +6,13 @@
 
 #define LOG_ENABLED false
 
+#include <algorithm>
+
 #include <llvm/DebugInfo/DWARF/DWARFExpression.h>
 
 #include "retdec/demangler/demangler.h"
 #include "retdec/utils/debug.h"
+#include "retdec/utils/parallel.h"
 #include "retdec/utils/string.h"
 #include "retdec/debugformat/debugformat.h"
 
@@ -20,24 +23,81 @@ std::string getDefaultDataType()
 	return "i32";
 }
 
+/**
+ * Get DIE referenced by the attribute @a attr of @a die, which may be in
+ * another unit (e.g. @c DW_FORM_ref_addr).
+ *
+ * LLVM extracts DIEs of units lazily, so all the units which can be referenced
+ * must be extracted before this is called in parallel (see
+ * DebugFormat::loadDwarf()). References into type units (@c DW_FORM_ref_sig8)
+ * are not followed, because LLVM looks them up in a lazily built map.
+ */
+llvm::DWARFDie getReferencedDie(llvm::DWARFDie die, llvm::dwarf::Attribute attr)
+{
+	auto value = die.find(attr);
+	if (!value || value->getForm() == llvm::dwarf::DW_FORM_ref_sig8)
+	{
+		return llvm::DWARFDie();
+	}
+	return die.getAttributeValueAsReferencedDie(*value);
+}
+
+/**
+ * @return @c True if the range <@a start, @a end) overlaps with any range
+ *         in @a ranges.
+ */
+bool overlaps(
+		const retdec::common::AddressRangeContainer& ranges,
+		retdec::common::Address start,
+		retdec::common::Address end)
+{
+	retdec::common::AddressRange range(start, end);
+	for (auto& r : ranges)
+	{
+		if (r.overlaps(range) || r.contains(start))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 } // anonymous namespace
 
 namespace retdec {
 namespace debugformat {
 
+/**
+ * Load DWARF information.
+ *
+ * The object file is created from the bytes already loaded by the file
+ * format, the input file is not read again.
+ */
 void DebugFormat::loadDwarf()
 {
 	// Open input file as buffer.
 	//
-	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffOrErr =
-			llvm::MemoryBuffer::getFileOrSTDIN(
-				_inFile->getFileFormat()->getPathToFile());
-	if (buffOrErr.getError())
+	auto* fileFormat = _inFile->getFileFormat();
+	const auto& bytes = fileFormat->getBytes();
+	std::unique_ptr<llvm::MemoryBuffer> bufferPtr;
+	if (bytes.empty())
 	{
-		return;
+		llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffOrErr =
+				llvm::MemoryBuffer::getFileOrSTDIN(
+					fileFormat->getPathToFile());
+		if (buffOrErr.getError())
+		{
+			return;
+		}
+		bufferPtr = std::move(buffOrErr.get());
 	}
-	std::unique_ptr<llvm::MemoryBuffer> bufferPtr = std::move(buffOrErr.get());
-	llvm::MemoryBufferRef buffer = *bufferPtr;
+	llvm::MemoryBufferRef buffer = bufferPtr
+			? llvm::MemoryBufferRef(*bufferPtr)
+			: llvm::MemoryBufferRef(
+					llvm::StringRef(
+							reinterpret_cast<const char*>(bytes.data()),
+							bytes.size()),
+					fileFormat->getPathToFile());
 
 	// Open buffer as a binary file.
 	//
@@ -61,20 +121,97 @@ void DebugFormat::loadDwarf()
 	}
 	std::unique_ptr<llvm::DWARFContext> DICtx = llvm::DWARFContext::create(*obj);
 
+	loadDwarf(*DICtx);
+}
+
+/**
+ * Load DWARF information from the given context.
+ *
+ * Units are parsed sequentially (LLVM parses them lazily and it is not
+ * thread-safe), but the conversion of their DIEs is done in parallel, each
+ * unit into its own @c DwarfUnit. The results are merged in the order of
+ * units, so they do not depend on the scheduling of threads.
+ */
+void DebugFormat::loadDwarf(llvm::DWARFContext& context)
+{
 	LOG << "\n*** DebugFormat::DebugFormat(): DWARF" << std::endl;
 
+	// Extract DIEs of all units, also of those which are not loaded and of
+	// type units. The loaded units can reference them (DW_FORM_ref_addr,
+	// DW_AT_specification, DW_AT_abstract_origin) and LLVM would extract
+	// them lazily, which must not happen in parallel.
+	//
+	for (auto& unit : context.normal_units())
+	{
+		unit->getUnitDIE(false);
+	}
+
+	// Parse compilation units which are to be loaded.
+	//
+	std::vector<DwarfUnit> units;
+	for (auto& unit : context.compile_units())
+	{
+		if (!isDwarfUnitSelected(unit->getUnitDIE(true)))
+		{
+			continue;
+		}
+
+		if (unit->getUnitDIE(false))
+		{
+			units.emplace_back();
+			units.back().unit = unit.get();
+			units.back().lines = context.getLineTableForUnit(unit.get());
+		}
+	}
+
 	// Inspect compilation unit DIEs.
 	//
-	for (auto& unit : DICtx->compile_units())
+	utils::parallelFor(units.size(), [this, &units](std::size_t i)
+	{
+		loadDwarf_CU(units[i], units[i].unit->getUnitDIE(false));
+	});
+
+	for (auto& cu : units)
+	{
+		mergeDwarf_CU(cu);
+	}
+}
+
+/**
+ * @return @c True if the compilation unit with the given unit DIE @a die
+ *         should be loaded. All units are loaded if there are no DWARF ranges
+ *         set, or if the unit does not describe its ranges.
+ */
+bool DebugFormat::isDwarfUnitSelected(llvm::DWARFDie die) const
+{
+	if (_dwarfRanges.empty() || !die)
+	{
+		return true;
+	}
+
+	auto rangesOrErr = die.getAddressRanges();
+	if (!rangesOrErr)
 	{
-		if (auto unitDie = unit->getUnitDIE(false))
+		llvm::consumeError(rangesOrErr.takeError());
+		return true;
+	}
+
+	for (auto& r : rangesOrErr.get())
+	{
+		if (r.LowPC < r.HighPC && overlaps(_dwarfRanges, r.LowPC, r.HighPC))
 		{
-			loadDwarf_CU(unitDie);
+			return true;
 		}
 	}
+	return false;
 }
 
-void DebugFormat::loadDwarf_CU(llvm::DWARFDie die)
+/**
+ * Convert DIEs of the compilation unit @a die into @a cu.
+ * This is called in parallel for different units -- it must not modify
+ * this object, use the demangler, or lazily parse anything in LLVM's context.
+ */
+void DebugFormat::loadDwarf_CU(DwarfUnit& cu, llvm::DWARFDie die) const
 {
 	for (auto c : die.children())
 	{
@@ -82,19 +219,20 @@ void DebugFormat::loadDwarf_CU(llvm::DWARFDie die)
 		{
 			case llvm::dwarf::DW_TAG_subprogram:
 			{
-				auto f = loadDwarf_subprogram(c);
+				std::string linkageName;
+				auto f = loadDwarf_subprogram(cu, c, linkageName);
 				if (!f.getName().empty() && f.getStart().isDefined())
 				{
-					functions.insert({f.getStart(), f});
+					cu.functions.emplace_back(std::move(f), linkageName);
 				}
 				break;
 			}
 			case llvm::dwarf::DW_TAG_variable:
 			{
-				auto v = loadDwarf_variable(c);
+				auto v = loadDwarf_variable(cu, c);
 				if (!v.getName().empty())
 				{
-					globals.insert(v);
+					cu.globals.push_back(v);
 				}
 			}
 			default:
@@ -103,7 +241,48 @@ void DebugFormat::loadDwarf_CU(llvm::DWARFDie die)
 	}
 }
 
-retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
+/**
+ * Merge information loaded from the compilation unit @a cu into this object.
+ * Parts which are not thread-safe (demangling, symbol lookup) are done here.
+ */
+void DebugFormat::mergeDwarf_CU(DwarfUnit& cu)
+{
+	for (auto& p : cu.functions)
+	{
+		auto& f = p.first;
+		if (functions.count(f.getStart()))
+		{
+			continue;
+		}
+
+		if (!p.second.empty())
+		{
+			auto dn = _demangler
+					? _demangler->demangleToString(p.second)
+					: std::string();
+			f.setDemangledName(dn.empty() ? p.second : dn);
+		}
+
+		auto* sym = _inFile
+				? _inFile->getFileFormat()->getSymbol(f.getStart() + 1)
+				: nullptr;
+		f.setIsThumb(sym && sym->isThumbSymbol());
+
+		functions.insert({f.getStart(), f});
+	}
+
+	for (auto& v : cu.globals)
+	{
+		globals.insert(v);
+	}
+
+	types.insert(cu.types.begin(), cu.types.end());
+}
+
+retdec::common::Function DebugFormat::loadDwarf_subprogram(
+		DwarfUnit& cu,
+		llvm::DWARFDie die,
+		std::string& linkageName) const
 {
 	// Start & end address.
 	//
@@ -131,25 +310,41 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 	{
 		return retdec::common::Function();
 	}
+	if (!_dwarfRanges.empty() && !overlaps(_dwarfRanges, start, end))
+	{
+		return retdec::common::Function();
+	}
+
+	// Declaration, which holds names and type of the function if its
+	// definition does not (e.g. C++ methods, inlined functions).
+	//
+	auto decl = getReferencedDie(die, llvm::dwarf::DW_AT_specification);
+	if (!decl)
+	{
+		decl = getReferencedDie(die, llvm::dwarf::DW_AT_abstract_origin);
+	}
+	auto find = [&die, &decl](llvm::dwarf::Attribute attr)
+	{
+		auto v = die.find(attr);
+		return v || !decl ? v : decl.find(attr);
+	};
 
 	// Names
 	//
-	std::string name, linkageName, demangledName;
-	if (auto n = llvm::dwarf::toString(die.find(
+	std::string name;
+	if (auto n = llvm::dwarf::toString(find(
 			llvm::dwarf::DW_AT_name)))
 	{
 		name = n.getValue();
 	}
-	auto ln = llvm::dwarf::toString(die.find(llvm::dwarf::DW_AT_linkage_name));
+	auto ln = llvm::dwarf::toString(find(llvm::dwarf::DW_AT_linkage_name));
 	if (!ln.hasValue())
 	{
-		ln = llvm::dwarf::toString(die.find(llvm::dwarf::DW_AT_MIPS_linkage_name));
+		ln = llvm::dwarf::toString(find(llvm::dwarf::DW_AT_MIPS_linkage_name));
 	}
 	if (ln.hasValue())
 	{
 		linkageName = ln.getValue();
-		auto dn = _demangler->demangleToString(linkageName);
-		demangledName = dn.empty() ? linkageName : dn;
 	}
 	if (name.empty() && linkageName.empty())
 	{
@@ -157,16 +352,12 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 	}
 
 	auto* unit = die.getDwarfUnit();
-	auto* lines = unit->getContext().getLineTableForUnit(unit);
+	auto* lines = cu.lines;
 
 	retdec::common::Function dif(linkageName.empty() ? name : linkageName);
 
 	dif.setIsFromDebug(true);
 	dif.setStartEnd(start, end);
-	dif.setDemangledName(demangledName);
-
-	auto* sym = _inFile->getFileFormat()->getSymbol(start + 1);
-	dif.setIsThumb(sym && sym->isThumbSymbol());
 
 	// Source file name.
 	//
@@ -212,16 +403,14 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 
 	// Return type.
 	//
-	if (auto o = llvm::dwarf::toReference(die.find(llvm::dwarf::DW_AT_type)))
+	auto typeOwner = die.find(llvm::dwarf::DW_AT_type) || !decl ? die : decl;
+	if (!typeOwner.find(llvm::dwarf::DW_AT_type))
 	{
-		if (auto odie = unit->getDIEForOffset(o.getValue()))
-		{
-			dif.returnType = loadDwarf_type(odie);
-		}
+		dif.returnType.setLlvmIr("void");
 	}
-	else
+	else if (auto odie = getReferencedDie(typeOwner, llvm::dwarf::DW_AT_type))
 	{
-		dif.returnType.setLlvmIr("void");
+		dif.returnType = loadDwarf_type(cu, odie);
 	}
 
 	// Children.
@@ -235,11 +424,11 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 				dif.setIsVariadic(true);
 				break;
 			case llvm::dwarf::DW_TAG_formal_parameter:
-				dif.parameters.push_back(loadDwarf_formal_parameter(c, argCntr++));
+				dif.parameters.push_back(loadDwarf_formal_parameter(cu, c, argCntr++));
 				break;
 			case llvm::dwarf::DW_TAG_variable:
 			{
-				auto var = loadDwarf_variable(c);
+				auto var = loadDwarf_variable(cu, c);
 				if (!var.getName().empty())
 				{
 					dif.locals.insert(var);
@@ -254,11 +443,13 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 	return dif;
 }
 
-std::string DebugFormat::loadDwarf_type(llvm::DWARFDie die)
+std::string DebugFormat::loadDwarf_type(
+		DwarfUnit& cu,
+		llvm::DWARFDie die) const
 {
 	// Try to use cache.
-	auto it = dieOff2type.find({die.getDwarfUnit(), die.getOffset()});
-	if (it != dieOff2type.end())
+	auto it = cu.dieOff2type.find(die.getOffset());
+	if (it != cu.dieOff2type.end())
 	{
 		return it->second;
 	}
@@ -270,18 +461,18 @@ std::string DebugFormat::loadDwarf_type(llvm::DWARFDie die)
 	// If it does end up here, this will protect us from infinite recursion.
 	// Named types (e.g. structures) needs some more hacking in their
 	/// processing.
-	dieOff2type.insert(
-			{{die.getDwarfUnit(), die.getOffset()},
-			getDefaultDataType()});
+	cu.dieOff2type.insert({die.getOffset(), getDefaultDataType()});
 
-	auto ret = _loadDwarf_type(die);
+	auto ret = _loadDwarf_type(cu, die);
 
-	dieOff2type[{die.getDwarfUnit(), die.getOffset()}] = ret;
+	cu.dieOff2type[die.getOffset()] = ret;
 
 	return ret;
 }
 
-std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
+std::string DebugFormat::_loadDwarf_type(
+		DwarfUnit& cu,
+		llvm::DWARFDie die) const
 {
 	switch (die.getTag())
 	{
@@ -337,12 +528,9 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 		}
 		case llvm::dwarf::DW_TAG_pointer_type:
 		{
-			if (auto o = llvm::dwarf::toReference(die.find(llvm::dwarf::DW_AT_type)))
+			if (auto odie = getReferencedDie(die, llvm::dwarf::DW_AT_type))
 			{
-				if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
-				{
-					return loadDwarf_type(odie) + "*";
-				}
+				return loadDwarf_type(cu, odie) + "*";
 			}
 			// Default here is pointer to void.
 			return "void*";
@@ -351,12 +539,9 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 		{
 			std::string ret;
 			std::string type = getDefaultDataType();
-			if (auto o = llvm::dwarf::toReference(die.find(llvm::dwarf::DW_AT_type)))
+			if (auto odie = getReferencedDie(die, llvm::dwarf::DW_AT_type))
 			{
-				if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
-				{
-					type = loadDwarf_type(odie);
-				}
+				type = loadDwarf_type(cu, odie);
 			}
 			unsigned dimensions = 0;
 			for (auto c : die.children())
@@ -395,37 +580,35 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 		case llvm::dwarf::DW_TAG_shared_type:
 		case llvm::dwarf::DW_TAG_volatile_type:
 		{
-			if (auto o = llvm::dwarf::toReference(die.find(llvm::dwarf::DW_AT_type)))
+			if (auto odie = getReferencedDie(die, llvm::dwarf::DW_AT_type))
 			{
-				if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
-				{
-					return loadDwarf_type(odie);
-				}
+				return loadDwarf_type(cu, odie);
 			}
 			return getDefaultDataType();
 		}
 		case llvm::dwarf::DW_TAG_structure_type:
 		case llvm::dwarf::DW_TAG_class_type:
 		{
-			auto it = dieOff2type.find({die.getDwarfUnit(), die.getOffset()});
+			auto it = cu.dieOff2type.find(die.getOffset());
 			// Because we insert default type to cache before processing the
 			// type, we need to ignore default types in the map.
-			if (it != dieOff2type.end() && it->second != getDefaultDataType())
+			if (it != cu.dieOff2type.end() && it->second != getDefaultDataType())
 			{
 				return it->second;
 			}
 
-			static unsigned anonStuctCntr = 0;
+			// Anonymous structures are named by their DIE offsets, which are
+			// unique in the file no matter in which order units are loaded.
 			auto n = llvm::dwarf::toString(die.find(llvm::dwarf::DW_AT_name));
 			std::string name = n
 					? std::string("%") + n.getValue()
-					: "%anon_struct_" + std::to_string(anonStuctCntr++);
+					: "%anon_struct_" + std::to_string(die.getOffset());
 
 			// It is important to insert an entry into cache container before
 			// calling loadDwarf_type() recursively.
 			// This will prevent infinite cycle if structure contains pointer to
 			// itself.
-			dieOff2type[{die.getDwarfUnit(), die.getOffset()}] = name;
+			cu.dieOff2type[die.getOffset()] = name;
 
 			std::string body;
 			for (auto c : die.children())
@@ -433,12 +616,9 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 				if (c.getTag() == llvm::dwarf::DW_TAG_member)
 				{
 					std::string elem = getDefaultDataType();
-					if (auto o = llvm::dwarf::toReference(c.find(llvm::dwarf::DW_AT_type)))
+					if (auto odie = getReferencedDie(c, llvm::dwarf::DW_AT_type))
 					{
-						if (auto odie = c.getDwarfUnit()->getDIEForOffset(o.getValue()))
-						{
-							elem = loadDwarf_type(odie);
-						}
+						elem = loadDwarf_type(cu, odie);
 					}
 
 					body += body.empty() ? "{" : ", ";
@@ -447,18 +627,15 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 			}
 			body += body.empty() ? "{" + getDefaultDataType() + "}" : "}";
 
-			types.insert(name + " = type " + body);
+			cu.types.insert(name + " = type " + body);
 			return name;
 		}
 		case llvm::dwarf::DW_TAG_subroutine_type:
 		{
 			std::string ret = "void";
-			if (auto o = llvm::dwarf::toReference(die.find(llvm::dwarf::DW_AT_type)))
+			if (auto odie = getReferencedDie(die, llvm::dwarf::DW_AT_type))
 			{
-				if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
-				{
-					ret = loadDwarf_type(odie);
-				}
+				ret = loadDwarf_type(cu, odie);
 			}
 
 			std::string body;
@@ -467,12 +644,9 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 				if (c.getTag() == llvm::dwarf::DW_TAG_formal_parameter)
 				{
 					std::string param = getDefaultDataType();
-					if (auto o = llvm::dwarf::toReference(c.find(llvm::dwarf::DW_AT_type)))
+					if (auto odie = getReferencedDie(c, llvm::dwarf::DW_AT_type))
 					{
-						if (auto odie = c.getDwarfUnit()->getDIEForOffset(o.getValue()))
-						{
-							param = loadDwarf_type(odie);
-						}
+						param = loadDwarf_type(cu, odie);
 					}
 
 					body += body.empty() ? "(" : ", ";
@@ -490,8 +664,9 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 }
 
 retdec::common::Object DebugFormat::loadDwarf_formal_parameter(
+		DwarfUnit& cu,
 		llvm::DWARFDie die,
-		unsigned argCntr)
+		unsigned argCntr) const
 {
 	std::string name = std::string("a") + std::to_string(argCntr);
 	if (auto n = llvm::dwarf::toString(die.find(
@@ -506,17 +681,16 @@ retdec::common::Object DebugFormat::loadDwarf_formal_parameter(
 
 	retdec::common::Object arg(name, retdec::common::Storage::undefined());
 	arg.type = getDefaultDataType();
-	if (auto o = llvm::dwarf::toReference(die.find(llvm::dwarf::DW_AT_type)))
+	if (auto odie = getReferencedDie(die, llvm::dwarf::DW_AT_type))
 	{
-		if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
-		{
-			arg.type = loadDwarf_type(odie);
-		}
+		arg.type = loadDwarf_type(cu, odie);
 	}
 	return arg;
 }
 
-retdec::common::Object DebugFormat::loadDwarf_variable(llvm::DWARFDie die)
+retdec::common::Object DebugFormat::loadDwarf_variable(
+		DwarfUnit& cu,
+		llvm::DWARFDie die) const
 {
 	std::string name;
 	if (auto n = llvm::dwarf::toString(die.find(
@@ -577,12 +751,9 @@ retdec::common::Object DebugFormat::loadDwarf_variable(llvm::DWARFDie die)
 	}
 
 	retdec::common::Object var(name, storage);
-	if (auto o = llvm::dwarf::toReference(die.find(llvm::dwarf::DW_AT_type)))
+	if (auto odie = getReferencedDie(die, llvm::dwarf::DW_AT_type))
 	{
-		if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
-		{
-			var.type = loadDwarf_type(odie);
-		}
+		var.type = loadDwarf_type(cu, odie);
 	}
 	return var;
 }
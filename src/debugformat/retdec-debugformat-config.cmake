@@ -10,6 +10,7 @@ if(NOT TARGET retdec::debugformat)
             pdbparser
             llvm
     )
+    find_package(Threads REQUIRED)
 
     include(${CMAKE_CURRENT_LIST_DIR}/retdec-debugformat-targets.cmake)
 endif()
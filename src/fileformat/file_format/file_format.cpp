@@ -195,12 +195,11 @@ void FileFormat::init()
 		crc32.clear();
 		md5.clear();
 		sha256.clear();
+		entropyProfile.clear();
 	}
 	else
 	{
-		crc32 = retdec::fileformat::getCrc32(bytes.data(), bytes.size());
-		md5 = retdec::fileformat::getMd5(bytes.data(), bytes.size());
-		sha256 = retdec::fileformat::getSha256(bytes.data(), bytes.size());
+		computeHashesAndEntropyProfile();
 	}
 	initStream();
 }
@@ -267,6 +266,27 @@ void FileFormat::clear()
 	dynamicTables.clear();
 }
 
+/**
+ * Compute hashes and entropy profile (with default window size and stride)
+ * of file content
+ *
+ * Content is hashed by parts and windows which end in a part are profiled
+ * while the part is in cache, so the content is read only once.
+ */
+void FileFormat::computeHashesAndEntropyProfile()
+{
+	DataHasher hasher;
+	EntropyProfiler profiler(bytes.data(), bytes.size(), DEFAULT_ENTROPY_WINDOW_SIZE, DEFAULT_ENTROPY_STRIDE);
+	for (std::uint64_t offset = 0; offset < bytes.size(); offset += HASHED_PART_SIZE)
+	{
+		const auto partSize = std::min<std::uint64_t>(bytes.size() - offset, HASHED_PART_SIZE);
+		hasher.add(bytes.data() + offset, partSize);
+		profiler.processUntil(offset + partSize);
+	}
+	hasher.getHashes(crc32, md5, sha256);
+	entropyProfile = profiler.getProfile();
+}
+
 /**
  * Compute hashes of section table. This method must be called after
  * sections are loaded.
@@ -1074,6 +1094,32 @@ std::size_t FileFormat::getOverlaySize() const
 	return (realSize > declSize) ? realSize - declSize : 0;
 }
 
+/**
+ * Get entropy profile of file content
+ * @param res Variable to store the result to
+ * @param windowSize Size of windows
+ * @param stride Distance between starts of windows
+ * @return @c true if profile contains at least one window, @c false otherwise
+ *
+ * Profile with the default window size and stride is computed together with
+ * file hashes (see @c LoadFlags::NO_FILE_HASHES), other profiles are
+ * computed on request.
+ */
+bool FileFormat::getEntropyProfile(EntropyProfile &res, std::size_t windowSize, std::size_t stride) const
+{
+	if (!entropyProfile.empty() && windowSize == entropyProfile.windowSize
+		&& stride == entropyProfile.stride)
+	{
+		res = entropyProfile;
+	}
+	else
+	{
+		res = computeEntropyProfile(bytes.data(), bytes.size(), windowSize, stride);
+	}
+
+	return !res.empty();
+}
+
 /**
  * Get overlay data entropy
  * @param res Variable to store the result to
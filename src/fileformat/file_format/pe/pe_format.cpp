@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <cassert>
 #include <map>
+#include <mutex>
 #include <regex>
 #include <tuple>
 #include <unordered_map>
@@ -794,6 +795,49 @@ retdec::fileformat::Certificate x509toCert(X509* cert)
 	return c;
 }
 
+/**
+ * Load list of OS DLLs
+ * @param dllListFile Path to text file containing list of OS DLLs
+ * @return Lower-case names of the DLLs or @c nullptr if the file cannot be
+ *    opened
+ *
+ * Each list is read only once and then shared by all PE files, so that
+ * processes analyzing many files do not read it again for each of them.
+ */
+std::shared_ptr<const std::unordered_set<std::string>> loadDllList(
+		const std::string &dllListFile)
+{
+	static std::mutex dllListsMutex;
+	static std::unordered_map<std::string,
+			std::shared_ptr<const std::unordered_set<std::string>>> dllLists;
+
+	std::lock_guard<std::mutex> lock(dllListsMutex);
+	auto it = dllLists.find(dllListFile);
+	if (it != dllLists.end())
+	{
+		return it->second;
+	}
+
+	std::ifstream stream(dllListFile, std::ifstream::in);
+	if (!stream)
+	{
+		return nullptr;
+	}
+
+	std::unordered_set<std::string> dllList;
+	std::string oneLine;
+	while(stream)
+	{
+		std::getline(stream, oneLine);
+		std::transform(oneLine.begin(), oneLine.end(), oneLine.begin(), ::tolower);
+		dllList.insert(oneLine);
+	}
+
+	auto result = std::make_shared<const std::unordered_set<std::string>>(std::move(dllList));
+	dllLists.emplace(dllListFile, result);
+	return result;
+}
+
 } // anonymous namespace
 
 /**
@@ -888,9 +932,12 @@ void PeFormat::initStructures(const std::string & dllListFile)
 			file->readExportDirectory();
 			file->readDebugDirectory();
 			file->readTlsDirectory();
-			file->readResourceDirectory();
-			file->readSecurityDirectory();
-			file->readComHeaderDirectory();
+			if(!(getLoadFlags() & LoadFlags::NO_RESOURCES))
+				file->readResourceDirectory();
+			if(!(getLoadFlags() & LoadFlags::NO_CERTIFICATES))
+				file->readSecurityDirectory();
+			if(!(getLoadFlags() & LoadFlags::NO_DOTNET))
+				file->readComHeaderDirectory();
 			file->readRelocationsDirectory();
 
 			// Fill-in the loader error info from PE file
@@ -906,20 +953,29 @@ void PeFormat::initStructures(const std::string & dllListFile)
 	if(stateIsValid)
 	{
 		fileFormat = Format::PE;
-		loadRichHeader();
+		// Expensive parts which the user does not need are not loaded at all,
+		// so that they look like they are not present in the file.
+		if(!(getLoadFlags() & LoadFlags::NO_RICH_HEADER))
+			loadRichHeader();
 		loadSections();
 		loadSymbols();
-		loadImports();
-		loadExports();
+		if(!(getLoadFlags() & LoadFlags::NO_IMPORTS))
+			loadImports();
+		if(!(getLoadFlags() & LoadFlags::NO_EXPORTS))
+			loadExports();
 		loadPdbInfo();
-		loadResources();
-		loadCertificates();
+		if(!(getLoadFlags() & LoadFlags::NO_RESOURCES))
+			loadResources();
+		if(!(getLoadFlags() & LoadFlags::NO_CERTIFICATES))
+			loadCertificates();
 		loadTlsInformation();
-		loadDotnetHeaders();
+		if(!(getLoadFlags() & LoadFlags::NO_DOTNET))
+			loadDotnetHeaders();
 		loadVisualBasicHeader();
 		computeSectionTableHashes();
 		loadStrings();
-		scanForAnomalies();
+		if(!(getLoadFlags() & LoadFlags::NO_ANOMALIES))
+			scanForAnomalies();
 	}
 }
 
@@ -2627,52 +2683,14 @@ void PeFormat::parseBlobStream(std::uint64_t baseAddress, std::uint64_t offset,
 	blobStream = std::make_unique<BlobStream>(offset, size);
 	auto address = baseAddress + offset;
 
-	std::vector<std::uint8_t> elementData;
-	std::uint64_t length, lengthSize;
-
-	std::size_t inStreamOffset = 0;
-	while (inStreamOffset < size)
+	// Elements are decoded on demand directly from the content of the section
+	const auto* secSeg = getSectionOrSegmentFromAddress(address);
+	if (!secSeg)
 	{
-		// First std::uint8_t is length of next element in the blob
-		lengthSize = 1;
-		if (!get1Byte(address + inStreamOffset, length))
-		{
-			return;
-		}
-
-		// 2-std::uint8_t length encoding if the length is 10xxxxxx
-		if ((length & 0xC0) == 0x80)
-		{
-			if (!get2Byte(address + inStreamOffset, length, Endianness::BIG))
-			{
-				return;
-			}
-
-			length &= ~0xC000;
-			lengthSize = 2;
-		}
-		// 4-std::uint8_t length encoding if the length is 110xxxxx
-		else if ((length & 0xE0) == 0xC0)
-		{
-			if (!get4Byte(address + inStreamOffset, length, Endianness::BIG))
-			{
-				return;
-			}
-
-			length &= ~0xE0000000;
-			lengthSize = 4;
-		}
-
-		// Read only if length is greater than 0
-		elementData.clear();
-		if (length > 0 && !getXBytes(address + inStreamOffset + lengthSize, length, elementData))
-		{
-			return;
-		}
-
-		blobStream->addElement(inStreamOffset, elementData);
-		inStreamOffset += lengthSize + length;
+		return;
 	}
+
+	blobStream->setData(secSeg->getBytes(address - secSeg->getAddress(), size));
 }
 
 /**
@@ -2704,22 +2722,14 @@ void PeFormat::parseStringStream(std::uint64_t baseAddress, std::uint64_t offset
 	stringStream = std::make_unique<StringStream>(offset, size);
 	auto address = baseAddress + offset;
 
-	// First string is always empty, so we just skip it
-	std::uint64_t currentOffset = 1;
-	while (currentOffset < size)
+	// Strings are read on demand directly from the content of the section
+	const auto* secSeg = getSectionOrSegmentFromAddress(address);
+	if (!secSeg)
 	{
-		std::string string;
-		if (!getNTBS(address + currentOffset, string))
-		{
-			currentOffset += 1;
-			continue;
-		}
-
-		stringStream->addString(currentOffset, string);
-
-		// +1 for null-terminator
-		currentOffset += 1 + string.length();
+		return;
 	}
+
+	stringStream->setData(secSeg->getBytes(address - secSeg->getAddress(), size));
 }
 
 /**
@@ -2735,6 +2745,7 @@ void PeFormat::parseUserStringStream(std::uint64_t/* baseAddress*/, std::uint64_
 
 /**
  * Parses single metadata table from metadata stream.
+ * Rows of the table are decoded lazily, only their location is recorded here.
  * @param table Table where to insert data.
  * @param address Address of table data.
  */
@@ -2742,19 +2753,44 @@ template <typename T>
 void PeFormat::parseMetadataTable(BaseMetadataTable* table, std::uint64_t& address)
 {
 	auto specTable = static_cast<MetadataTable<T>*>(table);
-	for (std::size_t i = 0; i < table->getSize(); ++i)
+	if (table->getSize() == 0)
 	{
-		try
-		{
-			T row;
-			row.load(this, metadataStream.get(), address);
-			specTable->addRow(std::move(row));
-		}
-		catch (const InvalidDotnetRecordError&)
+		return;
+	}
+
+	// All rows of the table have the same size, so we need to decode only the first one
+	std::uint64_t rowEndAddress = address;
+	try
+	{
+		T row;
+		row.load(this, metadataStream.get(), rowEndAddress);
+	}
+	catch (const InvalidDotnetRecordError&)
+	{
+		return;
+	}
+
+	// Use only rows which are fully present in the file
+	const std::uint64_t rowSize = rowEndAddress - address;
+	std::size_t numberOfRows = table->getSize();
+	std::uint64_t lastByte;
+	if (!get1Byte(address + numberOfRows * rowSize - 1, lastByte))
+	{
+		std::size_t low = 1, high = numberOfRows - 1;
+		while (low < high)
 		{
-			break;
+			auto middle = low + (high - low + 1) / 2;
+			if (get1Byte(address + middle * rowSize - 1, lastByte))
+				low = middle;
+			else
+				high = middle - 1;
 		}
+
+		numberOfRows = low;
 	}
+
+	specTable->setRows(this, metadataStream.get(), address, rowSize, numberOfRows);
+	address += numberOfRows * rowSize;
 }
 
 /**
@@ -2776,6 +2812,11 @@ void PeFormat::detectModuleVersionId()
 	}
 
 	auto row = moduleTable->getRow(1);
+	if (!row)
+	{
+		return;
+	}
+
 	moduleVersionId = guidStream->getGuidString(row->mvId.getIndex());
 }
 
@@ -2804,7 +2845,7 @@ void PeFormat::detectTypeLibId()
 	for (std::size_t i = 1; i <= typeRefTable->getNumberOfRows(); ++i)
 	{
 		auto typeRefRow = typeRefTable->getRow(i);
-		auto assemblyRef = assemblyRefTable->getRow(typeRefRow->resolutionScope.getIndex());
+		auto assemblyRef = typeRefRow ? assemblyRefTable->getRow(typeRefRow->resolutionScope.getIndex()) : nullptr;
 		if (!assemblyRef)
 		{
 			continue;
@@ -2835,7 +2876,7 @@ void PeFormat::detectTypeLibId()
 	for (std::size_t i = 1; i <= memberRefTable->getNumberOfRows(); ++i)
 	{
 		auto memberRefRow = memberRefTable->getRow(i);
-		if (memberRefRow->classType.getIndex() == guidTypeRef)
+		if (memberRefRow && memberRefRow->classType.getIndex() == guidTypeRef)
 		{
 			guidMemberRef = i;
 			break;
@@ -2854,7 +2895,7 @@ void PeFormat::detectTypeLibId()
 	for (std::size_t i = 1; i <= customAttributeTable->getNumberOfRows(); ++i)
 	{
 		auto customAttributeRow = customAttributeTable->getRow(i);
-		if (customAttributeRow->type.getIndex() == guidMemberRef)
+		if (customAttributeRow && customAttributeRow->type.getIndex() == guidMemberRef)
 		{
 			// Its value is the TypeLib we are looking for
 			auto typeLibData = blobStream->getElement(customAttributeRow->value.getIndex());
@@ -2985,6 +3026,10 @@ void PeFormat::computeTypeRefHashes()
 		bool validReferencedName = false;
 
 		auto typeRefRow = typeRefTable->getRow(i);
+		if (!typeRefRow)
+		{
+			continue;
+		}
 
 		if (stringStream->getString(typeRefRow->typeName.getIndex(), typeName) && !typeName.empty())
 		{
@@ -3548,10 +3593,10 @@ bool PeFormat::isMissingDependency(std::string dllName) const
 
 	// If we have overriden set, use that one.
 	// Otherwise, use the default DLL set
-	if (std::empty(dllList)) {
+	if (!dllList || std::empty(*dllList)) {
 		return checkDefaultList(dllName) == false;
 	} else {
-		return dllList.find(dllName) == dllList.end();
+		return dllList->find(dllName) == dllList->end();
 	}
 }
 
@@ -3569,22 +3614,14 @@ bool PeFormat::initDllList(const std::string & dllListFile)
 	// Do nothing if the DLL list is empty
 	if (dllListFile.length())
 	{
-		std::ifstream stream(dllListFile, std::ifstream::in);
-		std::string oneLine;
+		dllList = loadDllList(dllListFile);
 
 		// Do nothing if the DLL list file cannot be open
-		if (!stream)
+		if (!dllList)
 		{
 			errorLoadingDllList = true;
 			return false;
 		}
-
-		while(stream)
-		{
-			std::getline(stream, oneLine);
-			std::transform(oneLine.begin(), oneLine.end(), oneLine.begin(), ::tolower);
-			dllList.insert(oneLine);
-		}
 	}
 
 	// Sanity check
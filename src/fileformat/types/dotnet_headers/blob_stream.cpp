@@ -20,26 +20,56 @@ BlobStream::BlobStream(std::uint64_t streamOffset, std::uint64_t streamSize) : S
 
 /**
  * Returns the element at the specified offset in the blob.
+ * Returned data reference the content of the stream, so they are valid
+ * as long as the file this stream belongs to.
  * @param offset Offset of the element.
  * @return Element data if it exists, otherwise empty sequence.
  */
-std::vector<std::uint8_t> BlobStream::getElement(std::size_t offset) const
+llvm::ArrayRef<std::uint8_t> BlobStream::getElement(std::size_t offset) const
 {
-	auto itr = elements.find(offset);
-	if (itr == elements.end())
+	if (offset >= data.size())
 		return {};
 
-	return itr->second;
+	auto bytes = reinterpret_cast<const std::uint8_t*>(data.data());
+	std::uint64_t length = bytes[offset];
+	std::uint64_t lengthSize = 1;
+
+	// 2-byte length encoding if the length is 10xxxxxx
+	if ((length & 0xC0) == 0x80)
+	{
+		if (offset + 2 > data.size())
+			return {};
+
+		length = ((length & 0x3F) << 8) | bytes[offset + 1];
+		lengthSize = 2;
+	}
+	// 4-byte length encoding if the length is 110xxxxx
+	else if ((length & 0xE0) == 0xC0)
+	{
+		if (offset + 4 > data.size())
+			return {};
+
+		length = ((length & 0x1F) << 24)
+			| (static_cast<std::uint64_t>(bytes[offset + 1]) << 16)
+			| (static_cast<std::uint64_t>(bytes[offset + 2]) << 8)
+			| bytes[offset + 3];
+		lengthSize = 4;
+	}
+
+	if (offset + lengthSize + length > data.size())
+		return {};
+
+	return llvm::ArrayRef<std::uint8_t>(bytes + offset + lengthSize, length);
 }
 
 /**
- * Adds new element at the specified offset.
- * @param offset Offset of the element.
- * @param data Data of the element.
+ * Sets the content of the stream.
+ * @param streamData Content of the stream. It is not copied, so it needs to
+ *    outlive this stream.
  */
-void BlobStream::addElement(std::size_t offset, const std::vector<std::uint8_t>& data)
+void BlobStream::setData(llvm::StringRef streamData)
 {
-	elements.emplace(offset, data);
+	data = streamData;
 }
 
 } // namespace fileformat
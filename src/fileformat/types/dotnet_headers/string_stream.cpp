@@ -9,44 +9,72 @@
 namespace retdec {
 namespace fileformat {
 
+/**
+ * Constructor.
+ * @param streamOffset Stream offset.
+ * @param streamSize Stream size.
+ */
 StringStream::StringStream(std::uint64_t streamOffset, std::uint64_t streamSize) : Stream(StreamType::String, streamOffset, streamSize)
 {
-	strings.emplace(0, std::string{});
 }
 
+/**
+ * Returns the string at the specified offset in the stream.
+ * @param offset Offset of the string.
+ * @param result Read string.
+ * @return @c true if the string was read, otherwise @c false.
+ */
 bool StringStream::getString(std::size_t offset, std::string& result) const
+{
+	llvm::StringRef string;
+	if (!getStringRef(offset, string))
+		return false;
+
+	result = string.str();
+	return true;
+}
+
+/**
+ * Returns the string at the specified offset in the stream without copying it.
+ * User can also request string at the offset in the middle of another string,
+ * the rest of that string is returned in such case.
+ * @param offset Offset of the string.
+ * @param result Reference to the string in the content of the stream. It is
+ *    valid as long as the file this stream belongs to.
+ * @return @c true if the string was read, otherwise @c false.
+ */
+bool StringStream::getStringRef(std::size_t offset, llvm::StringRef& result) const
 {
 	if (offset >= getSize())
 		return false;
 
-	auto itr = strings.lower_bound(offset);
-	if (itr == strings.begin())
+	// First string is always empty
+	if (offset == 0)
 	{
-		result.clear();
+		result = llvm::StringRef();
 		return true;
 	}
 
-	// User can also request string at the offset in the middle of another string
-	// We need to find if there is a difference between string's offset and requested offset
-	if (itr != strings.end() && offset == itr->first)
-	{
-		result = itr->second;
-		return true;
-	}
+	if (offset >= data.size())
+		return false;
 
-	// If so, move backwards by one element (lower bound returns the first element that is not greater than searched element)
-	--itr;
-	std::size_t substrOffset = offset - itr->first;
-	if (substrOffset >= itr->second.length())
+	// String needs to be null-terminated inside the stream
+	auto end = data.find('\0', offset);
+	if (end == llvm::StringRef::npos)
 		return false;
 
-	result = itr->second.substr(offset - itr->first);
+	result = data.slice(offset, end);
 	return true;
 }
 
-void StringStream::addString(std::size_t offset, const std::string& string)
+/**
+ * Sets the content of the stream.
+ * @param streamData Content of the stream. It is not copied, so it needs to
+ *    outlive this stream.
+ */
+void StringStream::setData(llvm::StringRef streamData)
 {
-	strings.emplace(offset, string);
+	data = streamData;
 }
 
 } // namespace fileformat
@@ -31,17 +31,17 @@ const std::uint8_t Generic           = 0x10; ///< Flag indicating whether the me
  * @param [out] bytesRead Amount of bytes read out of signature.
  * @return Decoded unsigned integer.
  */
-std::uint64_t decodeUnsigned(const std::vector<std::uint8_t>& data, std::uint64_t& bytesRead)
+std::uint64_t decodeUnsigned(llvm::ArrayRef<std::uint8_t> data, std::uint64_t& bytesRead)
 {
 	std::uint64_t result = 0;
 	bytesRead = 0;
 
+	if (data.empty())
+		return result;
+
 	// If highest bit not set, it is 1-byte number
 	if ((data[0] & 0x80) == 0)
 	{
-		if (data.size() < 1)
-			return result;
-
 		result = data[0];
 		bytesRead = 1;
 	}
@@ -77,17 +77,17 @@ std::uint64_t decodeUnsigned(const std::vector<std::uint8_t>& data, std::uint64_
  * @param [out] bytesRead Amount of bytes read out of signature.
  * @return Decoded signed integer.
  */
-std::int64_t decodeSigned(const std::vector<std::uint8_t>& data, std::uint64_t& bytesRead)
+std::int64_t decodeSigned(llvm::ArrayRef<std::uint8_t> data, std::uint64_t& bytesRead)
 {
 	std::int64_t result = 0;
 	bytesRead = 0;
 
+	if (data.empty())
+		return result;
+
 	// If highest bit not set, it is 1-byte number
 	if ((data[0] & 0x80) == 0)
 	{
-		if (data.size() < 1)
-			return result;
-
 		std::int8_t result8 = (data[0] & 0x01 ? 0x80 : 0x00)
 			| static_cast<std::uint64_t>(data[0]);
 		result = result8 >> 1;
@@ -360,6 +360,8 @@ bool DotnetTypeReconstructor::reconstructClasses()
 	for (std::size_t i = 1; i <= typeDefTable->getNumberOfRows(); ++i)
 	{
 		auto typeDef = static_cast<const TypeDef*>(typeDefTable->getRow(i));
+		if (typeDef == nullptr)
+			continue;
 
 		std::size_t fieldsCount = 0;
 		std::size_t methodsCount = 0;
@@ -395,6 +397,8 @@ bool DotnetTypeReconstructor::reconstructClasses()
 	for (std::size_t i = 1; i <= typeRefTable->getNumberOfRows(); ++i)
 	{
 		auto typeRef = typeRefTable->getRow(i);
+		if (typeRef == nullptr)
+			continue;
 
 		auto newClass = createClassReference(typeRef, i);
 		if (newClass == nullptr)
@@ -456,22 +460,26 @@ bool DotnetTypeReconstructor::reconstructGenericParameters()
 	if (genericParamTable == nullptr)
 		return true;
 
-	for (const auto& genericParam : *genericParamTable)
+	for (std::size_t i = 1; i <= genericParamTable->getNumberOfRows(); ++i)
 	{
+		auto genericParam = genericParamTable->getRow(i);
+		if (genericParam == nullptr)
+			continue;
+
 		// Obtain generic parameter name
 		std::string genericParamName;
-		if (!stringStream->getString(genericParam.name.getIndex(), genericParamName))
+		if (!stringStream->getString(genericParam->name.getIndex(), genericParamName))
 			continue;
 		genericParamName = retdec::utils::replaceNonprintableChars(genericParamName);
 
 		// Generic parameter points either to TypeDef or MethodDef table depending on what it belongs to
 		MetadataTableType classOrMethod;
-		if (!genericParam.owner.getTable(classOrMethod))
+		if (!genericParam->owner.getTable(classOrMethod))
 			continue;
 
 		if (classOrMethod == MetadataTableType::TypeDef)
 		{
-			auto itr = defClassTable.find(genericParam.owner.getIndex());
+			auto itr = defClassTable.find(genericParam->owner.getIndex());
 			if (itr == defClassTable.end())
 				continue;
 
@@ -479,7 +487,7 @@ bool DotnetTypeReconstructor::reconstructGenericParameters()
 		}
 		else if (classOrMethod == MetadataTableType::MethodDef)
 		{
-			auto itr = methodTable.find(genericParam.owner.getIndex());
+			auto itr = methodTable.find(genericParam->owner.getIndex());
 			if (itr == methodTable.end())
 				continue;
 
@@ -598,6 +606,8 @@ bool DotnetTypeReconstructor::reconstructProperties()
 	for (std::size_t i = 1; i <= propertyMapTable->getNumberOfRows(); ++i)
 	{
 		auto propertyMap = propertyMapTable->getRow(i);
+		if (propertyMap == nullptr)
+			continue;
 
 		// First obtain owning class
 		auto ownerIndex = propertyMap->parent.getIndex();
@@ -647,6 +657,8 @@ bool DotnetTypeReconstructor::reconstructNestedClasses()
 	for (std::size_t i = 1; i <= nestedClassTable->getNumberOfRows(); ++i)
 	{
 		auto nestedClass = nestedClassTable->getRow(i);
+		if (nestedClass == nullptr)
+			continue;
 
 		auto nestedItr = defClassTable.find(nestedClass->nestedClass.getIndex());
 		if (nestedItr == defClassTable.end())
@@ -889,7 +901,7 @@ std::unique_ptr<DotnetField> DotnetTypeReconstructor::createField(const Field* f
 
 	if (signature.empty() || signature[0] != FieldSignature)
 		return nullptr;
-	signature.erase(signature.begin(), signature.begin() + 1);
+	signature = signature.drop_front(1);
 
 	auto type = dataTypeFromSignature(signature, ownerClass, nullptr);
 	if (type == nullptr)
@@ -925,7 +937,7 @@ std::unique_ptr<DotnetProperty> DotnetTypeReconstructor::createProperty(const Pr
 	bool hasThis = signature[0] & HasThis;
 	// Delete two bytes because the first is 0x08 (or 0x28 if HASTHIS is set) and the other one is number of parameters
 	// This seems like a weird thing, because I don't think that C# allows any parameters in getters/setters and therefore this will always be 0
-	signature.erase(signature.begin(), signature.begin() + 2);
+	signature = signature.drop_front(2);
 
 	auto type = dataTypeFromSignature(signature, ownerClass, nullptr);
 	if (type == nullptr)
@@ -961,7 +973,7 @@ std::unique_ptr<DotnetMethod> DotnetTypeReconstructor::createMethod(const Method
 	// If method contains generic paramters, we need to read the number of these generic paramters
 	if (signature[0] & Generic)
 	{
-		signature.erase(signature.begin(), signature.begin() + 1);
+		signature = signature.drop_front(1);
 
 		// We ignore this value just because we have this information already from the class name in format 'ClassName`N'
 		std::uint64_t bytesRead = 0;
@@ -969,11 +981,11 @@ std::unique_ptr<DotnetMethod> DotnetTypeReconstructor::createMethod(const Method
 		if (bytesRead == 0)
 			return nullptr;
 
-		signature.erase(signature.begin(), signature.begin() + bytesRead);
+		signature = signature.drop_front(bytesRead);
 	}
 	else
 	{
-		signature.erase(signature.begin(), signature.begin() + 1);
+		signature = signature.drop_front(1);
 	}
 
 	// It is followed by number of parameters
@@ -981,7 +993,7 @@ std::unique_ptr<DotnetMethod> DotnetTypeReconstructor::createMethod(const Method
 	std::uint64_t paramsCount = decodeUnsigned(signature, bytesRead);
 	if (bytesRead == 0)
 		return nullptr;
-	signature.erase(signature.begin(), signature.begin() + bytesRead);
+	signature = signature.drop_front(bytesRead);
 
 	auto newMethod = std::make_unique<DotnetMethod>();
 	newMethod->setRawRecord(methodDef);
@@ -1007,11 +1019,11 @@ std::unique_ptr<DotnetMethod> DotnetTypeReconstructor::createMethod(const Method
  * @param param Param table record.
  * @param ownerClass Owning class.
  * @param ownerMethod Owning method.
- * @param signature Signature with data types. Is destroyed in the meantime.
+ * @param signature Signature with data types. Read bytes are dropped from its front.
  * @return New method parameter or @c nullptr in case of failure.
  */
 std::unique_ptr<DotnetParameter> DotnetTypeReconstructor::createMethodParameter(const Param* param, const DotnetClass* ownerClass,
-		const DotnetMethod* ownerMethod, std::vector<std::uint8_t>& signature)
+		const DotnetMethod* ownerMethod, llvm::ArrayRef<std::uint8_t>& signature)
 {
 	std::string paramName;
 	if (!stringStream->getString(param->name.getIndex(), paramName))
@@ -1036,7 +1048,7 @@ std::unique_ptr<DotnetParameter> DotnetTypeReconstructor::createMethodParameter(
  * @return New data type or @c nullptr in case of failure.
  */
 template <typename T>
-std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByReference(std::vector<std::uint8_t>& data)
+std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByReference(llvm::ArrayRef<std::uint8_t>& data)
 {
 	std::uint64_t bytesRead;
 	TypeDefOrRef typeRef;
@@ -1048,7 +1060,7 @@ std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByReference(st
 	if (classRef == nullptr)
 		return nullptr;
 
-	data.erase(data.begin(), data.begin() + bytesRead);
+	data = data.drop_front(bytesRead);
 	return std::make_unique<T>(classRef);
 }
 
@@ -1060,7 +1072,7 @@ std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByReference(st
  * @return New data type or @c nullptr in case of failure.
  */
 template <typename T>
-std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByType(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByType(llvm::ArrayRef<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
 	auto type = dataTypeFromSignature(data, ownerClass, ownerMethod);
 	if (type == nullptr)
@@ -1076,7 +1088,7 @@ std::unique_ptr<T> DotnetTypeReconstructor::createDataTypeFollowedByType(std::ve
  * @return New data type or @c nullptr in case of failure.
  */
 template <typename T, typename U>
-std::unique_ptr<T> DotnetTypeReconstructor::createGenericReference(std::vector<std::uint8_t>& data, const U* owner)
+std::unique_ptr<T> DotnetTypeReconstructor::createGenericReference(llvm::ArrayRef<std::uint8_t>& data, const U* owner)
 {
 	if (owner == nullptr)
 		return nullptr;
@@ -1091,7 +1103,7 @@ std::unique_ptr<T> DotnetTypeReconstructor::createGenericReference(std::vector<s
 	if (index >= genericParams.size())
 		return nullptr;
 
-	data.erase(data.begin(), data.begin() + bytesRead);
+	data = data.drop_front(bytesRead);
 	return std::make_unique<T>(&genericParams[index]);
 }
 
@@ -1102,7 +1114,7 @@ std::unique_ptr<T> DotnetTypeReconstructor::createGenericReference(std::vector<s
  * @param ownerMethod Owning method.
  * @return New data type or @c nullptr in case of failure.
  */
-std::unique_ptr<DotnetDataTypeGenericInst> DotnetTypeReconstructor::createGenericInstantiation(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<DotnetDataTypeGenericInst> DotnetTypeReconstructor::createGenericInstantiation(llvm::ArrayRef<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
 	if (data.empty())
 		return nullptr;
@@ -1117,7 +1129,7 @@ std::unique_ptr<DotnetDataTypeGenericInst> DotnetTypeReconstructor::createGeneri
 
 	// Number of instantiated generic parameters
 	auto genericCount = data[0];
-	data.erase(data.begin(), data.begin() + 1);
+	data = data.drop_front(1);
 
 	// Generic parameters used for instantiation
 	std::vector<std::unique_ptr<DotnetDataTypeBase>> genericTypes;
@@ -1140,7 +1152,7 @@ std::unique_ptr<DotnetDataTypeGenericInst> DotnetTypeReconstructor::createGeneri
  * @param ownerMethod Owning method.
  * @return New data type or @c nullptr in case of failure.
  */
-std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(llvm::ArrayRef<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
 	// First comes data type representing elements in array
 	auto type = dataTypeFromSignature(data, ownerClass, ownerMethod);
@@ -1152,7 +1164,7 @@ std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(std::v
 	std::uint64_t rank = decodeUnsigned(data, bytesRead);
 	if (bytesRead == 0)
 		return nullptr;
-	data.erase(data.begin(), data.begin() + bytesRead);
+	data = data.drop_front(bytesRead);
 
 	// Rank must be non-zero number
 	if (rank == 0)
@@ -1164,7 +1176,7 @@ std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(std::v
 	std::uint64_t numOfSizes = decodeUnsigned(data, bytesRead);
 	if (bytesRead == 0)
 		return nullptr;
-	data.erase(data.begin(), data.begin() + bytesRead);
+	data = data.drop_front(bytesRead);
 
 	// Now get all those sizes
 	for (std::uint64_t i = 0; i < numOfSizes; ++i)
@@ -1172,14 +1184,14 @@ std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(std::v
 		dimensions[i].second = decodeSigned(data, bytesRead);
 		if (bytesRead == 0)
 			return nullptr;
-		data.erase(data.begin(), data.begin() + bytesRead);
+		data = data.drop_front(bytesRead);
 	}
 
 	// And some dimensions can also be limited by special lower bound
 	std::size_t numOfLowBounds = decodeUnsigned(data, bytesRead);
 	if (bytesRead == 0)
 		return nullptr;
-	data.erase(data.begin(), data.begin() + bytesRead);
+	data = data.drop_front(bytesRead);
 
 	// Make sure we don't get out of bounds with dimensions
 	numOfLowBounds = std::min(dimensions.size(), numOfLowBounds);
@@ -1188,7 +1200,7 @@ std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(std::v
 		dimensions[i].first = decodeSigned(data, bytesRead);
 		if (bytesRead == 0)
 			return nullptr;
-		data.erase(data.begin(), data.begin() + bytesRead);
+		data = data.drop_front(bytesRead);
 
 		// Adjust higher bound according to lower bound
 		dimensions[i].second += dimensions[i].first;
@@ -1205,7 +1217,7 @@ std::unique_ptr<DotnetDataTypeArray> DotnetTypeReconstructor::createArray(std::v
  * @return New data type or @c nullptr in case of failure.
  */
 template <typename T>
-std::unique_ptr<T> DotnetTypeReconstructor::createModifier(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<T> DotnetTypeReconstructor::createModifier(llvm::ArrayRef<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
 	// These modifiers are used to somehow specify data type using some data type
 	// The only usage we know about right know is 'volatile' keyword
@@ -1220,7 +1232,7 @@ std::unique_ptr<T> DotnetTypeReconstructor::createModifier(std::vector<std::uint
 	auto modifier = selectClass(typeRef);
 	if (modifier == nullptr)
 		return nullptr;
-	data.erase(data.begin(), data.begin() + bytesRead);
+	data = data.drop_front(bytesRead);
 
 	// Go further in signature because we only have modifier, we need to obtain type that is modified
 	auto type = dataTypeFromSignature(data, ownerClass, ownerMethod);
@@ -1237,20 +1249,20 @@ std::unique_ptr<T> DotnetTypeReconstructor::createModifier(std::vector<std::uint
  * @param ownerMethod Owning method.
  * @return New data type or @c nullptr in case of failure.
  */
-std::unique_ptr<DotnetDataTypeFnPtr> DotnetTypeReconstructor::createFnPtr(std::vector<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<DotnetDataTypeFnPtr> DotnetTypeReconstructor::createFnPtr(llvm::ArrayRef<std::uint8_t>& data, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
 	if (data.empty())
 		return nullptr;
 
 	// Delete first byte, what does it even mean?
-	data.erase(data.begin(), data.begin() + 1);
+	data = data.drop_front(1);
 
 	// Read number of parameters
 	std::uint64_t bytesRead = 0;
 	std::uint64_t paramsCount = decodeUnsigned(data, bytesRead);
 	if (bytesRead == 0)
 		return nullptr;
-	data.erase(data.begin(), data.begin() + bytesRead);
+	data = data.drop_front(bytesRead);
 
 	auto returnType = dataTypeFromSignature(data, ownerClass, ownerMethod);
 	if (returnType == nullptr)
@@ -1270,20 +1282,20 @@ std::unique_ptr<DotnetDataTypeFnPtr> DotnetTypeReconstructor::createFnPtr(std::v
 }
 
 /**
- * Creates data type from signature. Signature is destroyed in the meantime.
+ * Creates data type from signature. Read bytes are dropped from the front of the signature.
  * @param signature Signature data.
  * @param ownerClass Owning class.
  * @param ownerMethod Owning method.
  * @return New data type or @c nullptr in case of failure.
  */
-std::unique_ptr<DotnetDataTypeBase> DotnetTypeReconstructor::dataTypeFromSignature(std::vector<std::uint8_t>& signature, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
+std::unique_ptr<DotnetDataTypeBase> DotnetTypeReconstructor::dataTypeFromSignature(llvm::ArrayRef<std::uint8_t>& signature, const DotnetClass* ownerClass, const DotnetMethod* ownerMethod)
 {
 	if (signature.empty())
 		return nullptr;
 
 	std::unique_ptr<DotnetDataTypeBase> result;
 	auto type = static_cast<ElementType>(signature[0]);
-	signature.erase(signature.begin(), signature.begin() + 1);
+	signature = signature.drop_front(1);
 
 	switch (type)
 	{
@@ -14,6 +14,42 @@ using namespace retdec::utils;
 namespace retdec {
 namespace fileformat {
 
+/**
+ * Build indexes used for lookup of exports by name and address
+ *
+ * If there are more exports with the same key, the first one is indexed.
+ */
+void ExportTable::buildIndexes() const
+{
+	if(indexesValid)
+	{
+		return;
+	}
+
+	nameIndex.clear();
+	addressIndex.clear();
+	nameIndex.reserve(exports.size());
+	addressIndex.reserve(exports.size());
+
+	for(std::size_t i = 0, e = exports.size(); i < e; ++i)
+	{
+		nameIndex.emplace(exports[i].getName(), i);
+		addressIndex.emplace(exports[i].getAddress(), i);
+	}
+
+	indexesValid = true;
+}
+
+/**
+ * Drop indexes used for lookup of exports
+ *
+ * Indexes are built again on the next lookup.
+ */
+void ExportTable::invalidateIndexes()
+{
+	indexesValid = false;
+}
+
 /**
  * Get number of stored exports
  * @return Number of stored exports
@@ -67,15 +103,9 @@ const Export* ExportTable::getExport(std::size_t exportIndex) const
  */
 const Export* ExportTable::getExport(const std::string &name) const
 {
-	for(const auto &e : exports)
-	{
-		if(e.getName() == name)
-		{
-			return &e;
-		}
-	}
-
-	return nullptr;
+	buildIndexes();
+	auto it = nameIndex.find(name);
+	return it != nameIndex.end() ? &exports[it->second] : nullptr;
 }
 
 /**
@@ -85,15 +115,9 @@ const Export* ExportTable::getExport(const std::string &name) const
  */
 const Export* ExportTable::getExportOnAddress(unsigned long long address) const
 {
-	for(const auto &e : exports)
-	{
-		if(e.getAddress() == address)
-		{
-			return &e;
-		}
-	}
-
-	return nullptr;
+	buildIndexes();
+	auto it = addressIndex.find(address);
+	return it != addressIndex.end() ? &exports[it->second] : nullptr;
 }
 
 /**
@@ -174,6 +198,7 @@ void ExportTable::computeHashes()
 void ExportTable::clear()
 {
 	exports.clear();
+	invalidateIndexes();
 }
 
 /**
@@ -183,6 +208,7 @@ void ExportTable::clear()
 void ExportTable::addExport(Export &newExport)
 {
 	exports.push_back(newExport);
+	invalidateIndexes();
 }
 
 /**
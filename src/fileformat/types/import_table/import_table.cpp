@@ -568,6 +568,42 @@ std::string ordLookUp(const std::string& libName, const std::size_t& ordNum)
 namespace retdec {
 namespace fileformat {
 
+/**
+ * Build indexes used for lookup of imports by name and address
+ *
+ * If there are more imports with the same key, the first one is indexed.
+ */
+void ImportTable::buildIndexes() const
+{
+	if(indexesValid)
+	{
+		return;
+	}
+
+	nameIndex.clear();
+	addressIndex.clear();
+	nameIndex.reserve(imports.size());
+	addressIndex.reserve(imports.size());
+
+	for(std::size_t i = 0, e = imports.size(); i < e; ++i)
+	{
+		nameIndex.emplace(imports[i]->getName(), i);
+		addressIndex.emplace(imports[i]->getAddress(), i);
+	}
+
+	indexesValid = true;
+}
+
+/**
+ * Drop indexes used for lookup of imports
+ *
+ * Indexes are built again on the next lookup.
+ */
+void ImportTable::invalidateIndexes()
+{
+	indexesValid = false;
+}
+
 /**
  * Get number of libraries which are imported
  * @return Number of libraries which are imported
@@ -711,15 +747,9 @@ const Import* ImportTable::getImport(std::size_t importIndex) const
  */
 const Import* ImportTable::getImport(const std::string &name) const
 {
-	for(const auto &i : imports)
-	{
-		if(i->getName() == name)
-		{
-			return i.get();
-		}
-	}
-
-	return nullptr;
+	buildIndexes();
+	auto it = nameIndex.find(name);
+	return it != nameIndex.end() ? imports[it->second].get() : nullptr;
 }
 
 /**
@@ -729,15 +759,9 @@ const Import* ImportTable::getImport(const std::string &name) const
  */
 const Import* ImportTable::getImportOnAddress(unsigned long long address) const
 {
-	for(const auto &i : imports)
-	{
-		if(i->getAddress() == address)
-		{
-			return i.get();
-		}
-	}
-
-	return nullptr;
+	buildIndexes();
+	auto it = addressIndex.find(address);
+	return it != addressIndex.end() ? imports[it->second].get() : nullptr;
 }
 
 /**
@@ -746,7 +770,7 @@ const Import* ImportTable::getImportOnAddress(unsigned long long address) const
  */
 ImportTable::importsIterator ImportTable::begin() const
 {
-	return imports.begin();
+	return importsIterator(imports.begin());
 }
 
 /**
@@ -755,7 +779,7 @@ ImportTable::importsIterator ImportTable::begin() const
  */
 ImportTable::importsIterator ImportTable::end() const
 {
-	return imports.end();
+	return importsIterator(imports.end());
 }
 
 /**
@@ -835,6 +859,7 @@ void ImportTable::clear()
 {
 	libraries.clear();
 	imports.clear();
+	invalidateIndexes();
 	impHashCrc32.clear();
 	impHashMd5.clear();
 	impHashSha256.clear();
@@ -861,6 +886,7 @@ void ImportTable::addLibrary(std::string name, bool isMissingDependency)
 void ImportTable::addImport(std::unique_ptr<Import>&& import)
 {
 	imports.push_back(std::move(import));
+	invalidateIndexes();
 }
 
 /**
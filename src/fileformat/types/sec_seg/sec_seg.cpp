@@ -4,6 +4,7 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
 #include <sstream>
 
 #include "retdec/utils/conversion.h"
@@ -11,6 +12,7 @@
 #include "retdec/fileformat/file_format/file_format.h"
 #include "retdec/fileformat/types/sec_seg/sec_seg.h"
 #include "retdec/fileformat/utils/conversions.h"
+#include "retdec/fileformat/utils/entropy.h"
 #include "retdec/fileformat/utils/file_io.h"
 #include "retdec/fileformat/utils/other.h"
 #include "retdec/fileformat/utils/crypto.h"
@@ -22,14 +24,30 @@ namespace retdec {
 namespace fileformat {
 
 /**
- * Compute all supported hashes
+ * Compute all supported hashes and entropy
+ *
+ * Data are hashed by parts and histogram of every part is computed while
+ * it is in cache, so the data are read only once.
  */
-void SecSeg::computeHashes()
+void SecSeg::computeHashesAndEntropy()
 {
 	const auto *hashData = reinterpret_cast<const unsigned char*>(bytes.data());
-	crc32 = retdec::fileformat::getCrc32(hashData, bytes.size());
-	md5 = retdec::fileformat::getMd5(hashData, bytes.size());
-	sha256 = retdec::fileformat::getSha256(hashData, bytes.size());
+	const std::uint64_t size = bytes.size();
+	DataHasher hasher;
+	ByteHistogram histogram{};
+	for (std::uint64_t offset = 0; offset < size; offset += HASHED_PART_SIZE)
+	{
+		const auto partSize = std::min<std::uint64_t>(size - offset, HASHED_PART_SIZE);
+		hasher.add(hashData + offset, partSize);
+		addToByteHistogram(histogram, hashData + offset, partSize);
+	}
+	hasher.getHashes(crc32, md5, sha256);
+
+	if (size)
+	{
+		entropy = computeHistogramEntropy(histogram);
+		isEntropyValid = true;
+	}
 }
 
 /**
@@ -523,7 +541,7 @@ void SecSeg::setMemory(bool sMemory)
  */
 void SecSeg::computeEntropy()
 {
-	if (!loaded)
+	if (!loaded || isEntropyValid)
 	{
 		return;
 	}
@@ -571,6 +589,7 @@ void SecSeg::invalidateEntrySize()
  */
 void SecSeg::load(const FileFormat *sOwner)
 {
+	isEntropyValid = false;
 	if(!fileSize || !sOwner || offset >= sOwner->getLoadedFileLength())
 	{
 		bytes = "";
@@ -583,7 +602,7 @@ void SecSeg::load(const FileFormat *sOwner)
 
 	if (!(sOwner->getLoadFlags() & LoadFlags::NO_VERBOSE_HASHES))
 	{
-		computeHashes();
+		computeHashesAndEntropy();
 	}
 }
 
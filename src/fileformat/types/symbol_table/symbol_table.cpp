@@ -12,6 +12,51 @@ using namespace retdec::utils;
 namespace retdec {
 namespace fileformat {
 
+/**
+ * Build indexes used for lookup of symbols by name, address and index
+ *
+ * If there are more symbols with the same key, the first one is indexed.
+ */
+void SymbolTable::buildIndexes() const
+{
+	if(indexesValid)
+	{
+		return;
+	}
+
+	nameIndex.clear();
+	addressIndex.clear();
+	symbolIndexIndex.clear();
+	nameIndex.reserve(table.size());
+	addressIndex.reserve(table.size());
+	symbolIndexIndex.reserve(table.size());
+
+	for(std::size_t i = 0, e = table.size(); i < e; ++i)
+	{
+		const auto &s = table[i];
+		nameIndex.emplace(s->getName(), i);
+		symbolIndexIndex.emplace(s->getIndex(), i);
+
+		unsigned long long a;
+		if(s->getAddress(a))
+		{
+			addressIndex.emplace(a, i);
+		}
+	}
+
+	indexesValid = true;
+}
+
+/**
+ * Drop indexes used for lookup of symbols
+ *
+ * Indexes are built again on the next lookup.
+ */
+void SymbolTable::invalidateIndexes()
+{
+	indexesValid = false;
+}
+
 /**
  * Get number of symbols in table
  * @return Number of symbols in table
@@ -38,15 +83,9 @@ const Symbol* SymbolTable::getSymbol(std::size_t symbolIndex) const
  */
 const Symbol* SymbolTable::getSymbol(const std::string &name) const
 {
-	for(const auto &s : table)
-	{
-		if(s->getName() == name)
-		{
-			return s.get();
-		}
-	}
-
-	return nullptr;
+	buildIndexes();
+	auto it = nameIndex.find(name);
+	return it != nameIndex.end() ? table[it->second].get() : nullptr;
 }
 
 /**
@@ -56,16 +95,9 @@ const Symbol* SymbolTable::getSymbol(const std::string &name) const
  */
 const Symbol* SymbolTable::getSymbolOnAddress(unsigned long long addr) const
 {
-	for(const auto &s : table)
-	{
-		unsigned long long a;
-		if(s->getAddress(a) && a == addr)
-		{
-			return s.get();
-		}
-	}
-
-	return nullptr;
+	buildIndexes();
+	auto it = addressIndex.find(addr);
+	return it != addressIndex.end() ? table[it->second].get() : nullptr;
 }
 
 /**
@@ -75,15 +107,9 @@ const Symbol* SymbolTable::getSymbolOnAddress(unsigned long long addr) const
  */
 const Symbol* SymbolTable::getSymbolWithIndex(std::size_t symbolIndex) const
 {
-	for(const auto &s : table)
-	{
-		if(s->getIndex() == symbolIndex)
-		{
-			return s.get();
-		}
-	}
-
-	return nullptr;
+	buildIndexes();
+	auto it = symbolIndexIndex.find(symbolIndex);
+	return it != symbolIndexIndex.end() ? table[it->second].get() : nullptr;
 }
 
 /**
@@ -102,6 +128,8 @@ const std::string& SymbolTable::getName() const
  */
 Symbol* SymbolTable::getSymbol(std::size_t symbolIndex)
 {
+	// Returned symbol may be modified, so indexes cannot be trusted anymore
+	invalidateIndexes();
 	return (symbolIndex < getNumberOfSymbols()) ? table[symbolIndex].get() : nullptr;
 }
 
@@ -112,6 +140,9 @@ Symbol* SymbolTable::getSymbol(std::size_t symbolIndex)
  */
 Symbol* SymbolTable::getSymbol(const std::string &name)
 {
+	// Returned symbol may be modified, so indexes cannot be trusted anymore
+	invalidateIndexes();
+
 	for(auto &s : table)
 	{
 		if(s->getName() == name)
@@ -130,6 +161,9 @@ Symbol* SymbolTable::getSymbol(const std::string &name)
  */
 Symbol* SymbolTable::getSymbolOnAddress(unsigned long long addr)
 {
+	// Returned symbol may be modified, so indexes cannot be trusted anymore
+	invalidateIndexes();
+
 	for(auto &s : table)
 	{
 		unsigned long long a;
@@ -149,6 +183,9 @@ Symbol* SymbolTable::getSymbolOnAddress(unsigned long long addr)
  */
 Symbol* SymbolTable::getSymbolWithIndex(std::size_t symbolIndex)
 {
+	// Returned symbol may be modified, so indexes cannot be trusted anymore
+	invalidateIndexes();
+
 	for(auto &s : table)
 	{
 		if(s->getIndex() == symbolIndex)
@@ -166,7 +203,7 @@ Symbol* SymbolTable::getSymbolWithIndex(std::size_t symbolIndex)
  */
 SymbolTable::symbolsConstIterator SymbolTable::begin() const
 {
-	return table.begin();
+	return symbolsConstIterator(table.begin());
 }
 
 /**
@@ -175,6 +212,7 @@ SymbolTable::symbolsConstIterator SymbolTable::begin() const
  */
 SymbolTable::symbolsIterator SymbolTable::begin()
 {
+	invalidateIndexes();
 	return table.begin();
 }
 
@@ -184,7 +222,7 @@ SymbolTable::symbolsIterator SymbolTable::begin()
  */
 SymbolTable::symbolsConstIterator SymbolTable::end() const
 {
-	return table.end();
+	return symbolsConstIterator(table.end());
 }
 
 /**
@@ -193,6 +231,7 @@ SymbolTable::symbolsConstIterator SymbolTable::end() const
  */
 SymbolTable::symbolsIterator SymbolTable::end()
 {
+	invalidateIndexes();
 	return table.end();
 }
 
@@ -202,6 +241,7 @@ SymbolTable::symbolsIterator SymbolTable::end()
 void SymbolTable::clear()
 {
 	table.clear();
+	invalidateIndexes();
 }
 
 /**
@@ -211,6 +251,7 @@ void SymbolTable::clear()
 void SymbolTable::addSymbol(const std::shared_ptr<Symbol> &symbol)
 {
 	table.push_back(symbol);
+	invalidateIndexes();
 }
 
 /**
@@ -220,6 +261,7 @@ void SymbolTable::addSymbol(const std::shared_ptr<Symbol> &symbol)
 void SymbolTable::addSymbol(std::shared_ptr<Symbol> &&symbol)
 {
 	table.push_back(std::move(symbol));
+	invalidateIndexes();
 }
 
 /**
@@ -8,6 +8,7 @@
 #include <cmath>
 #include <vector>
 
+#include <openssl/evp.h>
 #include <openssl/md5.h>
 #include <openssl/sha.h>
 
@@ -78,5 +79,82 @@ std::string getSha256(const unsigned char *data, std::uint64_t length)
 	return sha;
 }
 
+/**
+ * States of hash functions of @c DataHasher
+ */
+struct DataHasher::Contexts
+{
+	retdec::utils::CRC32 crc32;
+	EVP_MD_CTX *md5 = EVP_MD_CTX_new();
+	EVP_MD_CTX *sha256 = EVP_MD_CTX_new();
+
+	Contexts()
+	{
+		EVP_DigestInit_ex(md5, EVP_md5(), nullptr);
+		EVP_DigestInit_ex(sha256, EVP_sha256(), nullptr);
+	}
+
+	~Contexts()
+	{
+		EVP_MD_CTX_free(md5);
+		EVP_MD_CTX_free(sha256);
+	}
+};
+
+namespace
+{
+
+/**
+ * Finish computation of digest and get it as a hexadecimal string
+ */
+std::string finishDigest(EVP_MD_CTX *ctx)
+{
+	std::vector<unsigned char> digest(EVP_MD_CTX_size(ctx));
+	if (EVP_DigestFinal_ex(ctx, digest.data(), nullptr) != 1)
+	{
+		return {};
+	}
+
+	std::string res;
+	retdec::utils::bytesToHexString(digest, res, 0, 0, false);
+	return res;
+}
+
+} // anonymous namespace
+
+DataHasher::DataHasher() : contexts(std::make_unique<Contexts>())
+{
+
+}
+
+DataHasher::~DataHasher() = default;
+
+/**
+ * Add next part of data
+ * @param data Part of data
+ * @param length Length of @a data
+ */
+void DataHasher::add(const unsigned char *data, std::uint64_t length)
+{
+	contexts->crc32.add(data, length);
+	EVP_DigestUpdate(contexts->md5, data, length);
+	EVP_DigestUpdate(contexts->sha256, data, length);
+}
+
+/**
+ * Get hashes of all added data
+ * @param crc32 Into this parameter CRC32 is stored
+ * @param md5 Into this parameter MD5 is stored
+ * @param sha256 Into this parameter SHA256 is stored
+ *
+ * This method can be called only once.
+ */
+void DataHasher::getHashes(std::string &crc32, std::string &md5, std::string &sha256)
+{
+	crc32 = contexts->crc32.getHash();
+	md5 = finishDigest(contexts->md5);
+	sha256 = finishDigest(contexts->sha256);
+}
+
 } // namespace fileformat
 } // namespace retdec
@@ -0,0 +1,275 @@
+/**
+ * @file src/fileformat/utils/entropy.cpp
+ * @brief Byte histograms and entropy of data.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "retdec/fileformat/utils/entropy.h"
+
+namespace retdec {
+namespace fileformat {
+
+namespace
+{
+
+/// Maximal window size for which weights of counts are precomputed
+const std::size_t MAX_PRECOMPUTED_WEIGHTS = 1 << 16;
+
+} // anonymous namespace
+
+/**
+ * Check if profile contains no window
+ * @return @c true if profile is empty, @c false otherwise
+ */
+bool EntropyProfile::empty() const
+{
+	return entropy.empty();
+}
+
+/**
+ * Get maximal entropy of windows
+ * @return Maximal entropy or @c 0 if profile is empty
+ */
+double EntropyProfile::getMax() const
+{
+	return empty() ? 0.0 : *std::max_element(entropy.begin(), entropy.end());
+}
+
+/**
+ * Get number of windows with entropy greater than @a threshold
+ * @param threshold Entropy threshold in <0,8>
+ * @return Number of windows
+ */
+std::size_t EntropyProfile::getNumberOfWindowsAbove(double threshold) const
+{
+	return std::count_if(entropy.begin(), entropy.end(),
+		[threshold](double e) { return e > threshold; });
+}
+
+/**
+ * Remove all windows
+ */
+void EntropyProfile::clear()
+{
+	windowSize = 0;
+	stride = 0;
+	entropy.clear();
+}
+
+/**
+ * Constructor
+ * @param profiledData Data to compute entropy profile of
+ * @param profiledDataLen Length of @a profiledData
+ * @param windowSize Size of windows
+ * @param stride Distance between starts of windows
+ *
+ * Nothing is profiled if any of the parameters is zero.
+ */
+EntropyProfiler::EntropyProfiler(const std::uint8_t *profiledData, std::size_t profiledDataLen,
+	std::size_t windowSize, std::size_t stride) : data(profiledData), dataLen(profiledDataLen)
+{
+	profile.windowSize = windowSize;
+	profile.stride = stride;
+	if (!data || !dataLen || !windowSize || !stride)
+	{
+		return;
+	}
+
+	window = std::min(windowSize, dataLen);
+	if (window <= MAX_PRECOMPUTED_WEIGHTS)
+	{
+		weights.resize(window + 1);
+		for (std::size_t c = 1; c <= window; ++c)
+		{
+			weights[c] = c * std::log2(static_cast<double>(c));
+		}
+	}
+}
+
+/**
+ * Get <tt>count * log2(count)</tt>
+ */
+double EntropyProfiler::getWeight(std::uint64_t count) const
+{
+	if (count < weights.size())
+	{
+		return weights[count];
+	}
+
+	return count ? count * std::log2(static_cast<double>(count)) : 0.0;
+}
+
+/**
+ * Get entropy of current window
+ *
+ * Entropy is <tt>log2(n) - sum(c * log2(c)) / n</tt>, where @c n is the
+ * window size and @c c are counts of byte values.
+ */
+double EntropyProfiler::getWindowEntropy() const
+{
+	double sum = 0.0;
+	for (auto count : counts)
+	{
+		sum += getWeight(count);
+	}
+
+	const auto entropy = std::log2(static_cast<double>(window)) - sum / window;
+	return std::min(std::max(entropy, 0.0), 8.0);
+}
+
+/**
+ * Compute entropy of all windows which end before @a offset
+ * @param offset Offset in data up to which they are available
+ *
+ * Histogram of overlapping windows is updated only by bytes which leave and
+ * enter the window, so every byte is counted at most twice.
+ */
+void EntropyProfiler::processUntil(std::size_t offset)
+{
+	offset = std::min(offset, dataLen);
+	while (window)
+	{
+		const auto start = profile.entropy.size() * profile.stride;
+		const auto end = start + window;
+		if (end > offset || end < start)
+		{
+			break;
+		}
+
+		if (windowEnd && start < windowEnd)
+		{
+			for (auto i = windowStart; i < start; ++i)
+			{
+				--counts[data[i]];
+			}
+			for (auto i = windowEnd; i < end; ++i)
+			{
+				++counts[data[i]];
+			}
+		}
+		else
+		{
+			counts.fill(0);
+			addToByteHistogram(counts, data + start, window);
+		}
+
+		windowStart = start;
+		windowEnd = end;
+		profile.entropy.push_back(getWindowEntropy());
+	}
+}
+
+/**
+ * Get entropy profile of windows processed so far
+ */
+const EntropyProfile& EntropyProfiler::getProfile() const
+{
+	return profile;
+}
+
+/**
+ * Add occurrences of byte values in data to histogram
+ * @param histogram Histogram to add to
+ * @param data Data to count bytes of
+ * @param dataLen Length of @a data
+ *
+ * Bytes are read by eight and counted into four interleaved tables. This
+ * breaks the dependency between increments of the same counter by
+ * consecutive bytes, which otherwise serializes the loop on runs of equal
+ * bytes (e.g. padding), and the tables are summed by a vectorizable loop.
+ */
+void addToByteHistogram(ByteHistogram &histogram, const std::uint8_t *data, std::size_t dataLen)
+{
+	if (!data)
+	{
+		return;
+	}
+
+	// Counts of a block fit into 32 bits.
+	const std::size_t blockLen = std::size_t(1) << 30;
+	std::array<std::array<std::uint32_t, 256>, 4> tables;
+	while (dataLen)
+	{
+		const auto len = std::min(dataLen, blockLen);
+		for (auto &table : tables)
+		{
+			table.fill(0);
+		}
+
+		std::size_t i = 0;
+		for (; i + 8 <= len; i += 8)
+		{
+			std::uint64_t word;
+			std::memcpy(&word, data + i, sizeof(word));
+			++tables[0][word & 0xFF];
+			++tables[1][(word >> 8) & 0xFF];
+			++tables[2][(word >> 16) & 0xFF];
+			++tables[3][(word >> 24) & 0xFF];
+			++tables[0][(word >> 32) & 0xFF];
+			++tables[1][(word >> 40) & 0xFF];
+			++tables[2][(word >> 48) & 0xFF];
+			++tables[3][word >> 56];
+		}
+		for (; i < len; ++i)
+		{
+			++tables[0][data[i]];
+		}
+
+		for (std::size_t b = 0; b < histogram.size(); ++b)
+		{
+			histogram[b] += std::uint64_t(tables[0][b]) + tables[1][b] + tables[2][b] + tables[3][b];
+		}
+
+		data += len;
+		dataLen -= len;
+	}
+}
+
+/**
+ * Compute entropy of data with the given histogram
+ * @param histogram Histogram of data
+ * @return entropy in <0,8>
+ */
+double computeHistogramEntropy(const ByteHistogram &histogram)
+{
+	std::uint64_t dataLen = 0;
+	for (auto frequency : histogram)
+	{
+		dataLen += frequency;
+	}
+
+	double entropy = 0;
+	for (auto frequency : histogram)
+	{
+		if (frequency)
+		{
+			double probability = static_cast<double>(frequency) / dataLen;
+			entropy -= probability * std::log2(probability);
+		}
+	}
+
+	return entropy;
+}
+
+/**
+ * Compute entropy profile of data
+ * @param data Data to compute entropy profile of
+ * @param dataLen Length of @a data
+ * @param windowSize Size of windows
+ * @param stride Distance between starts of windows
+ * @return Entropy profile
+ */
+EntropyProfile computeEntropyProfile(const std::uint8_t *data, std::size_t dataLen,
+	std::size_t windowSize, std::size_t stride)
+{
+	EntropyProfiler profiler(data, dataLen, windowSize, stride);
+	profiler.processUntil(dataLen);
+	return profiler.getProfile();
+}
+
+} // namespace fileformat
+} // namespace retdec
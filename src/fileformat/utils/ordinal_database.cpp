@@ -0,0 +1,262 @@
+/**
+ * @file src/fileformat/utils/ordinal_database.cpp
+ * @brief Packed database of names of functions imported by ordinal numbers.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+
+#include <llvm/Support/MemoryBuffer.h>
+
+#include "retdec/utils/string.h"
+#include "retdec/fileformat/utils/ordinal_database.h"
+
+using namespace retdec::utils;
+
+namespace retdec {
+namespace fileformat {
+
+namespace
+{
+
+const char DATABASE_MAGIC[] = {'R', 'D', 'O', 'D'};
+const std::uint32_t DATABASE_VERSION = 1;
+
+/// Size of the header (magic, version, library count, entry count).
+const std::size_t HEADER_SIZE = 16;
+/// Size of one library (key offset and size, first entry, entry count).
+const std::size_t LIBRARY_SIZE = 16;
+/// Size of one entry (ordinal, name offset and size).
+const std::size_t ENTRY_SIZE = 12;
+
+/**
+ * Get key of library @a library for architecture @a arch, as used in the
+ * database.
+ */
+std::string getLibraryKey(const std::string &arch, const std::string &library)
+{
+	auto key = toLower(arch) + "/" + toLower(library);
+	if (endsWith(key, ".dll"))
+	{
+		key.resize(key.size() - 4);
+	}
+	return key;
+}
+
+} // anonymous namespace
+
+const std::string OrdinalDatabase::FILE_NAME = "ordinals.bin";
+
+/**
+ * Constructor
+ * @param buffer Content of the database
+ */
+OrdinalDatabase::OrdinalDatabase(std::unique_ptr<llvm::MemoryBuffer> buffer) : buffer(std::move(buffer))
+{
+	data = this->buffer->getBufferStart();
+	size = this->buffer->getBufferSize();
+}
+
+/**
+ * Destructor
+ */
+OrdinalDatabase::~OrdinalDatabase() = default;
+
+/**
+ * Load the database from file
+ * @param path Path to the database
+ * @return Loaded database or @c nullptr if the file cannot be read or it is
+ *    not a valid database
+ *
+ * The file is mapped to memory, so only the pages that are actually looked
+ * into are read from the disk.
+ */
+std::unique_ptr<OrdinalDatabase> OrdinalDatabase::fromFile(const std::string &path)
+{
+	auto buffer = llvm::MemoryBuffer::getFile(path, -1, false);
+	if (!buffer)
+	{
+		return nullptr;
+	}
+
+	std::unique_ptr<OrdinalDatabase> database(new OrdinalDatabase(std::move(buffer.get())));
+	return database->load() ? std::move(database) : nullptr;
+}
+
+/**
+ * Create the database from its content
+ * @param buffer Content of the database
+ * @return Created database or @c nullptr if @a buffer is not a valid database
+ */
+std::unique_ptr<OrdinalDatabase> OrdinalDatabase::fromBuffer(const std::string &buffer)
+{
+	std::unique_ptr<OrdinalDatabase> database(new OrdinalDatabase(
+		llvm::MemoryBuffer::getMemBufferCopy(buffer)));
+	return database->load() ? std::move(database) : nullptr;
+}
+
+/**
+ * Get number of libraries in the database
+ * @return Number of libraries of all architectures
+ */
+std::size_t OrdinalDatabase::getNumberOfLibraries() const
+{
+	return libraryCount;
+}
+
+/**
+ * Get number of entries in the database
+ * @return Number of ordinal numbers of all libraries
+ */
+std::size_t OrdinalDatabase::getNumberOfEntries() const
+{
+	return entryCount;
+}
+
+/**
+ * Find out if the database contains library
+ * @param arch Architecture of the library (e.g. "x86", "arm")
+ * @param library Name of the library with or without the ".dll" suffix
+ * @return @c true if the library is in the database, @c false otherwise
+ */
+bool OrdinalDatabase::hasLibrary(const std::string &arch, const std::string &library) const
+{
+	std::size_t index;
+	return findLibrary(arch, library, index);
+}
+
+/**
+ * Get name of function exported by library under ordinal number
+ * @param arch Architecture of the library (e.g. "x86", "arm")
+ * @param library Name of the library with or without the ".dll" suffix
+ * @param ordinal Ordinal number of the function
+ * @param name Into this parameter the name of the function is stored
+ * @return @c true if the name was found, @c false otherwise
+ *
+ * If the function is not found, @a name is left unchanged.
+ */
+bool OrdinalDatabase::getName(const std::string &arch, const std::string &library, std::uint32_t ordinal, std::string &name) const
+{
+	std::size_t index;
+	if (!findLibrary(arch, library, index))
+	{
+		return false;
+	}
+
+	const auto libraryOffset = HEADER_SIZE + index * LIBRARY_SIZE;
+	const auto entriesOffset = HEADER_SIZE + libraryCount * LIBRARY_SIZE;
+	const std::size_t begin = readU32(libraryOffset + 8);
+	const std::size_t end = begin + readU32(libraryOffset + 12);
+	if (end > entryCount)
+	{
+		return false;
+	}
+
+	std::size_t first = begin;
+	std::size_t last = end;
+	while (first < last)
+	{
+		const auto middle = first + (last - first) / 2;
+		if (readU32(entriesOffset + middle * ENTRY_SIZE) < ordinal)
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+
+	const auto entry = entriesOffset + first * ENTRY_SIZE;
+	if (first == end || readU32(entry) != ordinal)
+	{
+		return false;
+	}
+
+	name = std::string(readString(readU32(entry + 4), readU32(entry + 8)));
+	return true;
+}
+
+/**
+ * Check that the database has the right header and that its tables are inside
+ * of it, and read its header
+ * @return @c true if the database is valid, @c false otherwise
+ *
+ * Entries and strings are checked only when they are looked up, so that the
+ * whole database does not have to be read from the disk.
+ */
+bool OrdinalDatabase::load()
+{
+	if (size < HEADER_SIZE || !std::equal(std::begin(DATABASE_MAGIC), std::end(DATABASE_MAGIC), data)
+		|| readU32(4) != DATABASE_VERSION)
+	{
+		return false;
+	}
+
+	const auto libraries = readU32(8);
+	const auto entries = readU32(12);
+	if ((size - HEADER_SIZE) / LIBRARY_SIZE < libraries
+		|| (size - HEADER_SIZE - libraries * LIBRARY_SIZE) / ENTRY_SIZE < entries)
+	{
+		return false;
+	}
+
+	libraryCount = libraries;
+	entryCount = entries;
+	return true;
+}
+
+std::uint32_t OrdinalDatabase::readU32(std::size_t offset) const
+{
+	std::uint32_t value = 0;
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[offset + i])) << (8 * i);
+	}
+	return value;
+}
+
+std::string_view OrdinalDatabase::readString(std::size_t offset, std::size_t length) const
+{
+	if (offset > size || length > size - offset)
+	{
+		return std::string_view();
+	}
+	return std::string_view(data + offset, length);
+}
+
+bool OrdinalDatabase::findLibrary(const std::string &arch, const std::string &library, std::size_t &index) const
+{
+	const auto key = getLibraryKey(arch, library);
+	const auto getKey = [&](std::size_t i)
+	{
+		const auto offset = HEADER_SIZE + i * LIBRARY_SIZE;
+		return readString(readU32(offset), readU32(offset + 4));
+	};
+
+	std::size_t first = 0;
+	std::size_t last = libraryCount;
+	while (first < last)
+	{
+		const auto middle = first + (last - first) / 2;
+		if (getKey(middle) < key)
+		{
+			first = middle + 1;
+		}
+		else
+		{
+			last = middle;
+		}
+	}
+
+	if (first == libraryCount || getKey(first) != key)
+	{
+		return false;
+	}
+
+	index = first;
+	return true;
+}
+
+} // namespace fileformat
+} // namespace retdec
@@ -4,13 +4,12 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
-#include <array>
-#include <cmath>
 #include <map>
 #include <unordered_map>
 
 #include "retdec/utils/container.h"
 #include "retdec/utils/conversion.h"
+#include "retdec/fileformat/utils/entropy.h"
 #include "retdec/fileformat/utils/other.h"
 
 using namespace retdec::utils;
@@ -488,29 +487,14 @@ std::string codePageToStr(std::size_t cpage)
  */
 double computeDataEntropy(const std::uint8_t *data, std::size_t dataLen)
 {
-	std::array<std::size_t, 256> histogram{};
-	double entropy = 0;
-
 	if (!data)
 	{
 		return 0;
 	}
 
-	for (std::size_t i = 0; i < dataLen; i++)
-	{
-		histogram[data[i]]++;
-	}
-
-	for (auto frequency : histogram)
-	{
-		if (frequency)
-		{
-			double probability = static_cast<double>(frequency) / dataLen;
-			entropy -= probability * std::log2(probability);
-		}
-	}
-
-	return entropy;
+	ByteHistogram histogram{};
+	addToByteHistogram(histogram, data, dataLen);
+	return computeHistogramEntropy(histogram);
 }
 
 } // namespace fileformat
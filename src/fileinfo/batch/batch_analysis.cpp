@@ -0,0 +1,154 @@
+/**
+ * @file src/fileinfo/batch/batch_analysis.cpp
+ * @brief Methods of BatchAnalysis class.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+#include "fileinfo/batch/batch_analysis.h"
+
+namespace retdec {
+namespace fileinfo {
+
+/**
+ * Constructor
+ * @param inputPaths Names of input files from the command line
+ * @param listFilePath Name of the file with names of input files, "-" for
+ *    standard input or empty string if there is no such file
+ *
+ * @a inputPaths must live as long as the analysis.
+ */
+BatchAnalysis::BatchAnalysis(const std::vector<std::string> &inputPaths, const std::string &listFilePath) : paths(inputPaths)
+{
+	if(listFilePath == "-")
+	{
+		list = &std::cin;
+	}
+	else if(!listFilePath.empty())
+	{
+		listFile.open(listFilePath);
+		list = &listFile;
+	}
+}
+
+/**
+ * Get name of the next input file
+ * @param path Into this parameter the name is stored
+ * @return @c true if there is a next name, @c false otherwise
+ */
+bool BatchAnalysis::getNextPath(std::string &path)
+{
+	std::lock_guard<std::mutex> lock(inputMutex);
+	if(nextPath < paths.size())
+	{
+		path = paths[nextPath++];
+		return true;
+	}
+
+	while(list && std::getline(*list, path))
+	{
+		if(!path.empty() && path.back() == '\r')
+		{
+			path.pop_back();
+		}
+		if(!path.empty())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Check if the list of names can be read
+ */
+bool BatchAnalysis::isInValidState() const
+{
+	return !list || *list;
+}
+
+/**
+ * Analyze all input files
+ * @param analyzer Analyzer of one file
+ * @param printer Printer of results, which is never called by two threads
+ *    at once
+ * @param jobs Requested number of threads (see getNumberOfJobs())
+ * @param onFailure Creator of the result of a file whose analysis has thrown
+ *    an exception (if not set, nothing is printed for such file)
+ *
+ * An exception thrown by @a analyzer ends only the analysis of the current
+ * file, the other files are analyzed as usual.
+ */
+void BatchAnalysis::run(const Analyzer &analyzer, const Printer &printer, std::size_t jobs,
+		const FailureHandler &onFailure)
+{
+	auto analyze = [&](const std::string &path, std::string &result)
+	{
+		std::string message;
+		try
+		{
+			result = analyzer(path);
+			return true;
+		}
+		catch(const std::exception &e)
+		{
+			message = e.what();
+		}
+		catch(...)
+		{
+			message = "unknown exception";
+		}
+
+		if(!onFailure)
+		{
+			return false;
+		}
+		result = onFailure(path, message);
+		return true;
+	};
+
+	auto worker = [&]()
+	{
+		std::string path;
+		std::string result;
+		while(getNextPath(path))
+		{
+			if(!analyze(path, result))
+			{
+				continue;
+			}
+			std::lock_guard<std::mutex> lock(outputMutex);
+			printer(result);
+		}
+	};
+
+	jobs = getNumberOfJobs(jobs);
+	std::vector<std::thread> threads;
+	for(std::size_t i = 1; i < jobs; ++i)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+	for(auto &thread : threads)
+	{
+		thread.join();
+	}
+}
+
+/**
+ * Get number of threads used for analysis
+ * @param requestedJobs Requested number of threads (0 means number of CPUs)
+ * @return Number of threads, at least 1 and at most @c MAX_JOBS
+ */
+std::size_t BatchAnalysis::getNumberOfJobs(std::size_t requestedJobs)
+{
+	const std::size_t jobs = requestedJobs ? requestedJobs : std::thread::hardware_concurrency();
+	return std::min(std::max<std::size_t>(jobs, 1), MAX_JOBS);
+}
+
+} // namespace fileinfo
+} // namespace retdec
@@ -0,0 +1,79 @@
+/**
+ * @file src/fileinfo/batch/batch_analysis.h
+ * @brief Definition of BatchAnalysis class.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef FILEINFO_BATCH_BATCH_ANALYSIS_H
+#define FILEINFO_BATCH_BATCH_ANALYSIS_H
+
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace retdec {
+namespace fileinfo {
+
+/**
+ * Fatal error during analysis of one file in batch mode
+ *
+ * It is thrown by the LLVM fatal error handler installed in batch mode, so the
+ * analysis of the failed file is abandoned and the other files are analyzed
+ * as usual.
+ */
+class BatchFatalError : public std::runtime_error
+{
+	public:
+		using std::runtime_error::runtime_error;
+};
+
+/**
+ * Analysis of many input files on several threads
+ *
+ * Names of input files from the command line come first, then names from the
+ * list file. The list is read by lines as they are needed, so that it can be
+ * fed by another process while files are analyzed. The result of each file is
+ * printed as soon as the file is analyzed.
+ */
+class BatchAnalysis
+{
+	public:
+		/// Analyzer of one file, returns the result printed for the file.
+		using Analyzer = std::function<std::string(const std::string &path)>;
+		/// Printer of the result of one file.
+		using Printer = std::function<void(const std::string &result)>;
+		/// Creator of the result of one file whose analyzer has thrown
+		/// an exception with the given message.
+		using FailureHandler = std::function<std::string(const std::string &path, const std::string &message)>;
+
+		/// Maximal number of threads
+		static constexpr std::size_t MAX_JOBS = 64;
+
+	private:
+		std::mutex inputMutex;                 ///< lock for reading of names
+		std::mutex outputMutex;                ///< lock for printing of results
+		const std::vector<std::string> &paths; ///< names from the command line
+		std::size_t nextPath = 0;              ///< index of the next name from the command line
+		std::ifstream listFile;                ///< file with names
+		std::istream *list = nullptr;          ///< stream with names (file or stdin)
+
+		bool getNextPath(std::string &path);
+	public:
+		BatchAnalysis(const std::vector<std::string> &inputPaths, const std::string &listFilePath);
+
+		bool isInValidState() const;
+		void run(const Analyzer &analyzer, const Printer &printer, std::size_t jobs,
+				const FailureHandler &onFailure = nullptr);
+
+		static std::size_t getNumberOfJobs(std::size_t requestedJobs);
+};
+
+} // namespace fileinfo
+} // namespace retdec
+
+#endif
@@ -123,6 +123,18 @@ void FileDetector::getOverlayInfo()
 	}
 }
 
+/**
+ * Get entropy profile of file
+ */
+void FileDetector::getEntropyProfile()
+{
+	EntropyProfile profile;
+	if(fileParser->getEntropyProfile(profile))
+	{
+		fileInfo.setEntropyProfile(profile);
+	}
+}
+
 /**
  * Get information about related PDB file
  */
@@ -223,9 +235,9 @@ void FileDetector::getTlsInfo()
 }
 
 /**
- * Get loader information
+ * Get error of loader
  */
-void FileDetector::getLoaderInfo()
+void FileDetector::getLoaderErrorInfo()
 {
 	// Propagate loader error no matter if the Image pointer will be created or not
 	auto ldrErrInfo = getFileParser()->getLoaderErrorInfo();
@@ -233,7 +245,13 @@ void FileDetector::getLoaderInfo()
 	{
 		fileInfo.setLoaderErrorInfo(ldrErrInfo);
 	}
+}
 
+/**
+ * Get loader information
+ */
+void FileDetector::getLoaderInfo()
+{
 	std::unique_ptr<retdec::loader::Image> image = retdec::loader::createImage(fileParser);
 	if(!image)
 	{
@@ -334,21 +352,65 @@ void FileDetector::getAllInformation()
 		detectFileType();
 		getEndianness();
 		getArchitectureBitSize();
-		getCompilerInformation();
-		getRichHeaderInfo();
-		getOverlayInfo();
-		getPdbInfo();
-		getResourceInfo();
-		getManifestInfo();
-		getImports();
-		getExports();
-		getHashes();
+		if(fileInfo.isOutputFieldSelected(OutputFields::CPDETECT))
+		{
+			getCompilerInformation();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::RICH_HEADER))
+		{
+			getRichHeaderInfo();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::OVERLAY))
+		{
+			getOverlayInfo();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::ENTROPY))
+		{
+			getEntropyProfile();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::HEADER))
+		{
+			getPdbInfo();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::RESOURCES))
+		{
+			getResourceInfo();
+			getManifestInfo();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::IMPORTS | OutputFields::LOADER))
+		{
+			getImports();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::EXPORTS))
+		{
+			getExports();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::HASHES))
+		{
+			getHashes();
+		}
 		getAdditionalInfo();
-		getCertificates();
-		getTlsInfo();
-		getLoaderInfo();
-		getStrings();
-		getAnomalies();
+		if(fileInfo.isOutputFieldSelected(OutputFields::CERTIFICATES))
+		{
+			getCertificates();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::TLS))
+		{
+			getTlsInfo();
+		}
+		getLoaderErrorInfo();
+		if(fileInfo.isOutputFieldSelected(OutputFields::LOADER))
+		{
+			getLoaderInfo();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::STRINGS))
+		{
+			getStrings();
+		}
+		if(fileInfo.isOutputFieldSelected(OutputFields::ANOMALIES))
+		{
+			getAnomalies();
+		}
 	}
 }
 
@@ -27,6 +27,7 @@ class FileDetector : private retdec::utils::NonCopyable
 		void getCompilerInformation();
 		void getRichHeaderInfo();
 		void getOverlayInfo();
+		void getEntropyProfile();
 		void getPdbInfo();
 		void getResourceInfo();
 		void getManifestInfo();
@@ -36,6 +37,7 @@ class FileDetector : private retdec::utils::NonCopyable
 		void getStrings();
 		void getCertificates();
 		void getTlsInfo();
+		void getLoaderErrorInfo();
 		void getLoaderInfo();
 		void getAnomalies();
 		/// @}
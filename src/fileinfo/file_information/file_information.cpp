@@ -96,6 +96,25 @@ ReturnCode FileInformation::getStatus() const
 	return status;
 }
 
+/**
+ * Get information about file which is computed and printed
+ * @return Selected fields
+ */
+OutputFields FileInformation::getOutputFields() const
+{
+	return outputFields;
+}
+
+/**
+ * Find out if information is computed and printed
+ * @param fields Fields of information (combination of OutputFields values)
+ * @return @c true if at least one of @a fields is selected, @c false otherwise
+ */
+bool FileInformation::isOutputFieldSelected(unsigned fields) const
+{
+	return outputFields & fields;
+}
+
 /**
  * Get path to input file
  * @return Path to input file
@@ -231,6 +250,15 @@ std::string FileInformation::getCompactManifest() const
 	return compactManifest;
 }
 
+/**
+ * Get entropy profile of input file
+ * @return Entropy profile (empty if it was not computed)
+ */
+const retdec::fileformat::EntropyProfile& FileInformation::getEntropyProfile() const
+{
+	return entropyProfile;
+}
+
 /**
  * Get number of stored data directories
  * @return Number of stored data directories
@@ -3720,6 +3748,15 @@ void FileInformation::setStatus(ReturnCode state)
 	status = state;
 }
 
+/**
+ * Set information about file which is computed and printed
+ * @param fields Selected fields
+ */
+void FileInformation::setOutputFields(OutputFields fields)
+{
+	outputFields = fields;
+}
+
 /**
  * Set binary file name
  * @param filepath Path to input file
@@ -3855,6 +3892,15 @@ void FileInformation::setCompactManifest(const std::string &fileCompactManifest)
 	compactManifest = fileCompactManifest;
 }
 
+/**
+ * Set entropy profile of input file
+ * @param profile Entropy profile
+ */
+void FileInformation::setEntropyProfile(const retdec::fileformat::EntropyProfile &profile)
+{
+	entropyProfile = profile;
+}
+
 /**
  * Set time stamp
  * @param timestamp Time stamp
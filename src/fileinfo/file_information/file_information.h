@@ -25,6 +25,7 @@ class FileInformation
 {
 	private:
 		retdec::cpdetect::ReturnCode status = retdec::cpdetect::ReturnCode::OK;
+		OutputFields outputFields = OutputFields::ALL_FIELDS; ///< information which is computed and printed
 		std::string filePath;                          ///< path to input file
 		std::string crc32;                             ///< CRC32 of input file
 		std::string md5;                               ///< MD5 of input file
@@ -41,6 +42,7 @@ class FileInformation
 		std::string endianness;                        ///< endianness
 		std::string manifest;                          ///< XML manifest
 		std::string compactManifest;                   ///< compact version of XML manifest
+		retdec::fileformat::EntropyProfile entropyProfile; ///< entropy profile of input file
 		FileHeader header;                             ///< file header
 		RichHeader richHeader;                         ///< rich header
 		VisualBasicInfo visualBasicInfo;               ///< visual basic information
@@ -75,6 +77,8 @@ class FileInformation
 		/// @name Getters of own members
 		/// @{
 		retdec::cpdetect::ReturnCode getStatus() const;
+		OutputFields getOutputFields() const;
+		bool isOutputFieldSelected(unsigned fields) const;
 		std::string getPathToFile() const;
 		std::string getCrc32() const;
 		std::string getMd5() const;
@@ -90,6 +94,7 @@ class FileInformation
 		std::string getEndianness() const;
 		std::string getManifest() const;
 		std::string getCompactManifest() const;
+		const retdec::fileformat::EntropyProfile& getEntropyProfile() const;
 		std::size_t getNumberOfStoredDataDirectories() const;
 		std::size_t getNumberOfStoredSegments() const;
 		std::size_t getNumberOfStoredSections() const;
@@ -545,6 +550,7 @@ class FileInformation
 		/// @name Setters
 		/// @{
 		void setStatus(retdec::cpdetect::ReturnCode state);
+		void setOutputFields(OutputFields fields);
 		void setPathToFile(const std::string &filepath);
 		void setCrc32(const std::string &fileCrc32);
 		void setMd5(const std::string &fileMd5);
@@ -560,6 +566,7 @@ class FileInformation
 		void setEndianness(const std::string &fileEndianness);
 		void setManifest(const std::string &fileManifest);
 		void setCompactManifest(const std::string &fileCompactManifest);
+		void setEntropyProfile(const retdec::fileformat::EntropyProfile &profile);
 		void setTimeStamp(const std::string &timestamp);
 		void setFileStatus(const std::string &fileStatus);
 		void setFileVersion(const std::string &version);
@@ -19,6 +19,7 @@
 #include "fileinfo/file_information/file_information_types/file_segment.h"
 #include "fileinfo/file_information/file_information_types/import_table.h"
 #include "fileinfo/file_information/file_information_types/loader_info.h"
+#include "fileinfo/file_information/file_information_types/output_fields.h"
 #include "fileinfo/file_information/file_information_types/pattern/pattern.h"
 #include "fileinfo/file_information/file_information_types/pdb_info.h"
 #include "fileinfo/file_information/file_information_types/relocation_table/relocation_table.h"
@@ -0,0 +1,174 @@
+/**
+ * @file src/fileinfo/file_information/file_information_types/output_fields.cpp
+ * @brief Selection of information about file which is computed and printed.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <utility>
+#include <vector>
+
+#include "retdec/utils/string.h"
+#include "fileinfo/file_information/file_information_types/output_fields.h"
+
+using namespace retdec::fileformat;
+using namespace retdec::utils;
+
+namespace retdec {
+namespace fileinfo {
+
+namespace
+{
+
+const std::vector<std::pair<std::string, OutputFields>> fieldNames =
+{
+	{"hashes", OutputFields::HASHES},
+	{"cpdetect", OutputFields::CPDETECT},
+	{"header", OutputFields::HEADER},
+	{"sections", OutputFields::SECTIONS},
+	{"symbols", OutputFields::SYMBOLS},
+	{"imports", OutputFields::IMPORTS},
+	{"exports", OutputFields::EXPORTS},
+	{"relocations", OutputFields::RELOCATIONS},
+	{"resources", OutputFields::RESOURCES},
+	{"richHeader", OutputFields::RICH_HEADER},
+	{"certificates", OutputFields::CERTIFICATES},
+	{"tls", OutputFields::TLS},
+	{"dotnet", OutputFields::DOTNET},
+	{"strings", OutputFields::STRINGS},
+	{"overlay", OutputFields::OVERLAY},
+	{"loader", OutputFields::LOADER},
+	{"anomalies", OutputFields::ANOMALIES},
+	{"patterns", OutputFields::PATTERNS},
+	{"entropy", OutputFields::ENTROPY}
+};
+
+/**
+ * Find out if any of the given fields is selected
+ */
+bool isAnySelected(OutputFields fields, unsigned wanted)
+{
+	return fields & wanted;
+}
+
+} // anonymous namespace
+
+/**
+ * Parse comma-separated list of names of fields (e.g. "hashes,imports")
+ * @param list List of names
+ * @param fields Into this parameter the selected fields are stored
+ * @return @c true if all names are valid, @c false otherwise
+ *
+ * Name "all" selects all fields.
+ */
+bool parseOutputFields(const std::string &list, OutputFields &fields)
+{
+	unsigned result = OutputFields::NO_FIELDS;
+	for(const auto &name : split(list, ',', true))
+	{
+		if(name == "all")
+		{
+			result |= OutputFields::ALL_FIELDS;
+			continue;
+		}
+
+		bool found = false;
+		for(const auto &item : fieldNames)
+		{
+			if(item.first == name)
+			{
+				result |= item.second;
+				found = true;
+				break;
+			}
+		}
+
+		if(!found)
+		{
+			return false;
+		}
+	}
+
+	fields = static_cast<OutputFields>(result);
+	return true;
+}
+
+/**
+ * Get names of all fields
+ * @return Comma-separated names of fields
+ */
+std::string getOutputFieldNames()
+{
+	std::vector<std::string> names;
+	for(const auto &item : fieldNames)
+	{
+		names.push_back(item.first);
+	}
+	return joinStrings(names, ",");
+}
+
+/**
+ * Get flags for fileformat which switch off loading of parts of file not
+ * needed by the given fields
+ * @param fields Selected fields
+ * @return Load flags
+ *
+ * Some fields need more than their own part of file, e.g. detection of
+ * compilers looks into imports, exports, resources, rich header and .NET
+ * headers, and anomalies are searched also in imports, exports and resources.
+ *
+ * All fields are the default output, which loads everything and detects
+ * strings only if asked for by @c --strings, so no flags are returned for them.
+ */
+LoadFlags getLoadFlagsForOutputFields(OutputFields fields)
+{
+	unsigned flags = LoadFlags::NONE;
+	if(fields == OutputFields::ALL_FIELDS)
+	{
+		return LoadFlags::NONE;
+	}
+
+	if(!isAnySelected(fields, OutputFields::HASHES))
+	{
+		flags |= LoadFlags::NO_FILE_HASHES | LoadFlags::NO_VERBOSE_HASHES;
+	}
+	if(isAnySelected(fields, OutputFields::STRINGS))
+	{
+		flags |= LoadFlags::DETECT_STRINGS;
+	}
+	if(!isAnySelected(fields, OutputFields::RICH_HEADER | OutputFields::CPDETECT))
+	{
+		flags |= LoadFlags::NO_RICH_HEADER;
+	}
+	if(!isAnySelected(fields, OutputFields::IMPORTS | OutputFields::CPDETECT
+			| OutputFields::LOADER | OutputFields::ANOMALIES))
+	{
+		flags |= LoadFlags::NO_IMPORTS;
+	}
+	if(!isAnySelected(fields, OutputFields::EXPORTS | OutputFields::CPDETECT
+			| OutputFields::ANOMALIES))
+	{
+		flags |= LoadFlags::NO_EXPORTS;
+	}
+	if(!isAnySelected(fields, OutputFields::RESOURCES | OutputFields::CPDETECT
+			| OutputFields::ANOMALIES))
+	{
+		flags |= LoadFlags::NO_RESOURCES;
+	}
+	if(!isAnySelected(fields, OutputFields::CERTIFICATES))
+	{
+		flags |= LoadFlags::NO_CERTIFICATES;
+	}
+	if(!isAnySelected(fields, OutputFields::DOTNET | OutputFields::CPDETECT))
+	{
+		flags |= LoadFlags::NO_DOTNET;
+	}
+	if(!isAnySelected(fields, OutputFields::ANOMALIES))
+	{
+		flags |= LoadFlags::NO_ANOMALIES;
+	}
+
+	return static_cast<LoadFlags>(flags);
+}
+
+} // namespace fileinfo
+} // namespace retdec
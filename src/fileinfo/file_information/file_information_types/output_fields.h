@@ -0,0 +1,55 @@
+/**
+ * @file src/fileinfo/file_information/file_information_types/output_fields.h
+ * @brief Selection of information about file which is computed and printed.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef FILEINFO_FILE_INFORMATION_FILE_INFORMATION_TYPES_OUTPUT_FIELDS_H
+#define FILEINFO_FILE_INFORMATION_FILE_INFORMATION_TYPES_OUTPUT_FIELDS_H
+
+#include <string>
+
+#include "retdec/fileformat/fftypes.h"
+
+namespace retdec {
+namespace fileinfo {
+
+/**
+ * Groups of information about file
+ *
+ * Basic information (format, class, architecture, entry point, ...) and
+ * errors are computed and printed always.
+ */
+enum OutputFields
+{
+	NO_FIELDS    = 0,
+	HASHES       = 1 << 0,  ///< hashes of file, section table, sections, imports, ...
+	CPDETECT     = 1 << 1,  ///< detected compilers, packers and languages
+	HEADER       = 1 << 2,  ///< file header, its flags, data directories, PDB, ELF notes
+	SECTIONS     = 1 << 3,  ///< segments and sections
+	SYMBOLS      = 1 << 4,  ///< symbol tables
+	IMPORTS      = 1 << 5,  ///< import table
+	EXPORTS      = 1 << 6,  ///< export table
+	RELOCATIONS  = 1 << 7,  ///< relocation tables and dynamic sections
+	RESOURCES    = 1 << 8,  ///< resources, manifest and version info
+	RICH_HEADER  = 1 << 9,  ///< rich header
+	CERTIFICATES = 1 << 10, ///< certificates and signature
+	TLS          = 1 << 11, ///< thread-local storage
+	DOTNET       = 1 << 12, ///< .NET and Visual Basic information
+	STRINGS      = 1 << 13, ///< strings
+	OVERLAY      = 1 << 14, ///< overlay
+	LOADER       = 1 << 15, ///< loaded image and missing dependencies
+	ANOMALIES    = 1 << 16, ///< anomalies
+	PATTERNS     = 1 << 17, ///< detected YARA patterns
+	ENTROPY      = 1 << 18, ///< entropy profile of file
+	ALL_FIELDS   = (1 << 19) - 1
+};
+
+bool parseOutputFields(const std::string &list, OutputFields &fields);
+std::string getOutputFieldNames();
+retdec::fileformat::LoadFlags getLoadFlagsForOutputFields(OutputFields fields);
+
+} // namespace fileinfo
+} // namespace retdec
+
+#endif
@@ -4,6 +4,8 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/io/log.h"
@@ -290,6 +292,7 @@ void JsonPresentation::presentPackingInfo(Writer& writer) const
 {
 	const auto packed = fileinfo.toolInfo.isPacked();
 	serializeString(writer, "packed", toLower(packedToString(packed)));
+	serdes::serializeBool(writer, "highEntropyContent", fileinfo.toolInfo.hasPackedEntropyProfile());
 }
 
 /**
@@ -311,6 +314,31 @@ void JsonPresentation::presentOverlay(Writer& writer) const
 	}
 }
 
+/**
+ * Present entropy profile of file
+ */
+void JsonPresentation::presentEntropyProfile(Writer& writer) const
+{
+	const auto &profile = fileinfo.getEntropyProfile();
+	if(profile.empty())
+	{
+		return;
+	}
+
+	writer.String("entropyProfile");
+	writer.StartObject();
+	serdes::serializeUint64(writer, "windowSize", profile.windowSize);
+	serdes::serializeUint64(writer, "stride", profile.stride);
+	writer.String("entropy");
+	writer.StartArray();
+	for(const auto entropy : profile.entropy)
+	{
+		writer.Double(entropy);
+	}
+	writer.EndArray();
+	writer.EndObject();
+}
+
 /**
  * Present detected patterns
  */
@@ -1219,10 +1247,20 @@ void JsonPresentation::presentIterativeSubtitle(
 	}
 }
 
-bool JsonPresentation::present()
+/**
+ * Serialize information about file to JSON
+ * @param singleLine If @c true, the whole object is on one line (as needed
+ *    for output with one object per line), otherwise it is pretty-printed
+ * @return Information about file in JSON
+ */
+std::string JsonPresentation::getJson(bool singleLine) const
 {
 	rapidjson::StringBuffer sb;
 	Writer writer(sb);
+	if(singleLine)
+	{
+		writer.SetIndent(' ', 0);
+	}
 	writer.StartObject();
 
 	serializeString(writer, "inputFile", fileinfo.getPathToFile());
@@ -1231,62 +1269,152 @@ bool JsonPresentation::present()
 	presentLoaderError(writer);
 	presentSimple(BasicJsonGetter(fileinfo), writer);
 	presentSimple(EntryPointJsonGetter(fileinfo), writer, "entryPoint");
-	presentCompiler(writer);
-	presentLanguages(writer);
-	presentOverlay(writer);
+	// If only some fields are selected, all information about them is printed.
+	const auto selected = [this](unsigned fields)
+	{
+		return fileinfo.isOutputFieldSelected(fields);
+	};
+	const bool allFields = fileinfo.getOutputFields() == OutputFields::ALL_FIELDS;
+
+	if(selected(OutputFields::CPDETECT))
+	{
+		presentCompiler(writer);
+		presentLanguages(writer);
+	}
+	if(selected(OutputFields::OVERLAY))
+	{
+		presentOverlay(writer);
+	}
 
-	if(verbose)
+	if(verbose || !allFields)
 	{
 		std::string flags, title;
 		std::vector<std::string> desc, info;
 
-		presentPackingInfo(writer);
-
-		HeaderJsonGetter headerInfo(fileinfo);
-		presentSimple(headerInfo, writer);
-		headerInfo.getFileFlags(title, flags, desc, info);
-		presentFlags(writer, title, flags, desc);
-		headerInfo.getDllFlags(title, flags, desc, info);
-		presentFlags(writer, title, flags, desc);
-
-		presentSimple(PdbJsonGetter(fileinfo), writer, "pdbInfo");
-
-		presentIterativeSubtitle(writer, RichHeaderJsonGetter(fileinfo));
-		presentIterativeSubtitle(writer, DataDirectoryJsonGetter(fileinfo));
-		presentIterativeSubtitle(writer, SegmentJsonGetter(fileinfo));
-		presentIterativeSubtitle(writer, SectionJsonGetter(fileinfo));
-		presentIterativeSubtitle(writer, SymbolTablesJsonGetter(fileinfo));
-		presentIterativeSubtitle(writer, ImportTableJsonGetter(fileinfo));
-		presentIterativeSubtitle(writer, ExportTableJsonGetter(fileinfo));
-		presentIterativeSubtitle(writer, RelocationTablesJsonGetter(fileinfo));
-		presentIterativeSubtitle(writer, DynamicSectionsJsonGetter(fileinfo));
-		presentIterativeSubtitle(writer, ResourceJsonGetter(fileinfo));
-		presentIterativeSubtitle(writer, AnomaliesJsonGetter(fileinfo));
+		if(selected(OutputFields::CPDETECT))
+		{
+			presentPackingInfo(writer);
+		}
+
+		if(selected(OutputFields::HEADER))
+		{
+			HeaderJsonGetter headerInfo(fileinfo);
+			presentSimple(headerInfo, writer);
+			headerInfo.getFileFlags(title, flags, desc, info);
+			presentFlags(writer, title, flags, desc);
+			headerInfo.getDllFlags(title, flags, desc, info);
+			presentFlags(writer, title, flags, desc);
+
+			presentSimple(PdbJsonGetter(fileinfo), writer, "pdbInfo");
+		}
+
+		if(selected(OutputFields::RICH_HEADER))
+		{
+			presentIterativeSubtitle(writer, RichHeaderJsonGetter(fileinfo));
+		}
+		if(selected(OutputFields::HEADER))
+		{
+			presentIterativeSubtitle(writer, DataDirectoryJsonGetter(fileinfo));
+		}
+		if(selected(OutputFields::SECTIONS))
+		{
+			presentIterativeSubtitle(writer, SegmentJsonGetter(fileinfo));
+			presentIterativeSubtitle(writer, SectionJsonGetter(fileinfo));
+		}
+		if(selected(OutputFields::SYMBOLS))
+		{
+			presentIterativeSubtitle(writer, SymbolTablesJsonGetter(fileinfo));
+		}
+		if(selected(OutputFields::IMPORTS))
+		{
+			presentIterativeSubtitle(writer, ImportTableJsonGetter(fileinfo));
+		}
+		if(selected(OutputFields::EXPORTS))
+		{
+			presentIterativeSubtitle(writer, ExportTableJsonGetter(fileinfo));
+		}
+		if(selected(OutputFields::RELOCATIONS))
+		{
+			presentIterativeSubtitle(writer, RelocationTablesJsonGetter(fileinfo));
+			presentIterativeSubtitle(writer, DynamicSectionsJsonGetter(fileinfo));
+		}
+		if(selected(OutputFields::RESOURCES))
+		{
+			presentIterativeSubtitle(writer, ResourceJsonGetter(fileinfo));
+		}
+		if(selected(OutputFields::ANOMALIES))
+		{
+			presentIterativeSubtitle(writer, AnomaliesJsonGetter(fileinfo));
+		}
 		const auto manifest = fileinfo.getCompactManifest();
-		if(!manifest.empty())
+		if(!manifest.empty() && selected(OutputFields::RESOURCES))
 		{
 			serializeString(writer, "manifest", manifest);
 		}
-		presentElfNotes(writer);
-		presentMissingDepsInfo(writer);
-		presentLoaderInfo(writer);
-		presentPatterns(writer);
-		presentCertificates(writer);
-		presentTlsInfo(writer);
-		presentDotnetInfo(writer);
-		presentVisualBasicInfo(writer);
-		presentVersionInfo(writer);
+		if(selected(OutputFields::HEADER))
+		{
+			presentElfNotes(writer);
+		}
+		if(selected(OutputFields::LOADER))
+		{
+			presentMissingDepsInfo(writer);
+			presentLoaderInfo(writer);
+		}
+		if(selected(OutputFields::PATTERNS))
+		{
+			presentPatterns(writer);
+		}
+		if(selected(OutputFields::ENTROPY))
+		{
+			presentEntropyProfile(writer);
+		}
+		if(selected(OutputFields::CERTIFICATES))
+		{
+			presentCertificates(writer);
+		}
+		if(selected(OutputFields::TLS))
+		{
+			presentTlsInfo(writer);
+		}
+		if(selected(OutputFields::DOTNET))
+		{
+			presentDotnetInfo(writer);
+			presentVisualBasicInfo(writer);
+		}
+		if(selected(OutputFields::RESOURCES))
+		{
+			presentVersionInfo(writer);
+		}
 	}
 	else
 	{
 		presentRichHeader(writer);
 	}
 
-	presentIterativeSubtitle(writer, StringsJsonGetter(fileinfo));
+	if(selected(OutputFields::STRINGS))
+	{
+		presentIterativeSubtitle(writer, StringsJsonGetter(fileinfo));
+	}
 
 	writer.EndObject();
-	Log::info() << sb.GetString() << std::endl;
 
+	std::string json = sb.GetString();
+	if(singleLine)
+	{
+		// Strings are escaped in ASCII output, so only the line breaks
+		// between values are removed.
+		json.erase(std::remove(json.begin(), json.end(), '\n'), json.end());
+	}
+	return json;
+}
+
+/**
+ * Print information about file in JSON on standard output
+ * @return @c true
+ */
+bool JsonPresentation::present()
+{
+	Log::info() << getJson() << std::endl;
 	return true;
 }
 
@@ -39,6 +39,7 @@ class JsonPresentation : public FilePresentation
 		void presentRichHeader(Writer& writer) const;
 		void presentPackingInfo(Writer& writer) const;
 		void presentOverlay(Writer& writer) const;
+		void presentEntropyProfile(Writer& writer) const;
 		void presentPatterns(Writer& writer) const;
 		void presentMissingDepsInfo(Writer& writer) const;
 		void presentLoaderInfo(Writer& writer) const;
@@ -64,6 +65,7 @@ class JsonPresentation : public FilePresentation
 	public:
 		JsonPresentation(FileInformation &fileinfo_, bool verbose_);
 
+		std::string getJson(bool singleLine = false) const;
 		virtual bool present() override;
 };
 
@@ -475,6 +475,8 @@ void PlainPresentation::presentPackingInfo() const
 {
 	const auto packed = fileinfo.toolInfo.isPacked();
 	Log::info() << "Packed                   : " << packedToString(packed) << "\n";
+	const auto highEntropy = fileinfo.toolInfo.hasPackedEntropyProfile();
+	Log::info() << "High entropy content     : " << (highEntropy ? "Yes" : "No") << "\n";
 }
 
 /**
@@ -700,10 +702,27 @@ bool PlainPresentation::present()
 {
 	Log::info() << "Input file               : " << fileinfo.getPathToFile() << "\n";
 	presentSimple(BasicPlainGetter(fileinfo), false);
-	presentCompiler();
-	presentLanguages();
-	presentRichHeader();
-	presentOverlay();
+
+	// If only some fields are selected, all information about them is printed.
+	const auto selected = [this](unsigned fields)
+	{
+		return fileinfo.isOutputFieldSelected(fields);
+	};
+	const bool allFields = fileinfo.getOutputFields() == OutputFields::ALL_FIELDS;
+
+	if(selected(OutputFields::CPDETECT))
+	{
+		presentCompiler();
+		presentLanguages();
+	}
+	if(allFields)
+	{
+		presentRichHeader();
+	}
+	if(selected(OutputFields::OVERLAY))
+	{
+		presentOverlay();
+	}
 	if(returnCode != ReturnCode::OK)
 	{
 		Log::error() << getErrorMessage(returnCode, fileinfo.getFileFormatEnum()) << "\n";
@@ -714,7 +733,7 @@ bool PlainPresentation::present()
 		Log::error() << fileinfo.messages[i] << "\n";
 	}
 
-	if(verbose)
+	if(verbose || !allFields)
 	{
 		std::string errorMessage;
 
@@ -733,37 +752,79 @@ bool PlainPresentation::present()
 		std::string flags, title;
 		std::vector<std::string> desc, info;
 
-		presentPackingInfo();
-
-		HeaderPlainGetter headerInfo(fileinfo);
-		presentSimple(headerInfo, true);
-		headerInfo.getFileFlags(title, flags, desc, info);
-		presentSimpleFlags(title, flags, desc, info);
-		headerInfo.getDllFlags(title, flags, desc, info);
-		presentSimpleFlags(title, flags, desc, info);
-		presentSimple(PdbPlainGetter(fileinfo), false, "Related PDB file");
-
-		presentIterativeDistribution(RichHeaderPlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(DataDirectoryPlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(SegmentPlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(SectionPlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(SymbolTablesPlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(ImportTablePlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(ExportTablePlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(TypeRefTablePlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(VisualBasicExternTablePlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(RelocationTablesPlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(DynamicSectionsPlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(ResourcePlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(VersionInfoStringTablePlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(VersionInfoLanguageTablePlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(TlsInfoPlainGetter(fileinfo), explanatory);
-		presentIterativeDistribution(AnomaliesPlainGetter(fileinfo), explanatory);
-
-		presentNotes();
+		if(selected(OutputFields::CPDETECT))
+		{
+			presentPackingInfo();
+		}
+
+		if(selected(OutputFields::HEADER))
+		{
+			HeaderPlainGetter headerInfo(fileinfo);
+			presentSimple(headerInfo, true);
+			headerInfo.getFileFlags(title, flags, desc, info);
+			presentSimpleFlags(title, flags, desc, info);
+			headerInfo.getDllFlags(title, flags, desc, info);
+			presentSimpleFlags(title, flags, desc, info);
+			presentSimple(PdbPlainGetter(fileinfo), false, "Related PDB file");
+		}
+
+		if(selected(OutputFields::RICH_HEADER))
+		{
+			presentIterativeDistribution(RichHeaderPlainGetter(fileinfo), explanatory);
+		}
+		if(selected(OutputFields::HEADER))
+		{
+			presentIterativeDistribution(DataDirectoryPlainGetter(fileinfo), explanatory);
+		}
+		if(selected(OutputFields::SECTIONS))
+		{
+			presentIterativeDistribution(SegmentPlainGetter(fileinfo), explanatory);
+			presentIterativeDistribution(SectionPlainGetter(fileinfo), explanatory);
+		}
+		if(selected(OutputFields::SYMBOLS))
+		{
+			presentIterativeDistribution(SymbolTablesPlainGetter(fileinfo), explanatory);
+		}
+		if(selected(OutputFields::IMPORTS))
+		{
+			presentIterativeDistribution(ImportTablePlainGetter(fileinfo), explanatory);
+		}
+		if(selected(OutputFields::EXPORTS))
+		{
+			presentIterativeDistribution(ExportTablePlainGetter(fileinfo), explanatory);
+		}
+		if(selected(OutputFields::DOTNET))
+		{
+			presentIterativeDistribution(TypeRefTablePlainGetter(fileinfo), explanatory);
+			presentIterativeDistribution(VisualBasicExternTablePlainGetter(fileinfo), explanatory);
+		}
+		if(selected(OutputFields::RELOCATIONS))
+		{
+			presentIterativeDistribution(RelocationTablesPlainGetter(fileinfo), explanatory);
+			presentIterativeDistribution(DynamicSectionsPlainGetter(fileinfo), explanatory);
+		}
+		if(selected(OutputFields::RESOURCES))
+		{
+			presentIterativeDistribution(ResourcePlainGetter(fileinfo), explanatory);
+			presentIterativeDistribution(VersionInfoStringTablePlainGetter(fileinfo), explanatory);
+			presentIterativeDistribution(VersionInfoLanguageTablePlainGetter(fileinfo), explanatory);
+		}
+		if(selected(OutputFields::TLS))
+		{
+			presentIterativeDistribution(TlsInfoPlainGetter(fileinfo), explanatory);
+		}
+		if(selected(OutputFields::ANOMALIES))
+		{
+			presentIterativeDistribution(AnomaliesPlainGetter(fileinfo), explanatory);
+		}
+
+		if(selected(OutputFields::HEADER))
+		{
+			presentNotes();
+		}
 
 		auto manifest = fileinfo.getManifest();
-		if(!manifest.empty())
+		if(!manifest.empty() && selected(OutputFields::RESOURCES))
 		{
 			presentTitle("Manifest");
 			if(manifest[0] != '\n')
@@ -777,24 +838,37 @@ bool PlainPresentation::present()
 			Log::info() << replaceNonasciiChars(manifest);
 		}
 
-		presentIterativeSimple(CertificateTablePlainGetter(fileinfo));
-		presentSimple(DotnetPlainGetter(fileinfo), false, ".NET Information");
-		presentDotnetClasses();
-		presentSimple(VisualBasicPlainGetter(fileinfo), false, "Visual Basic Information");
-		presentVisualBasicObjects();
+		if(selected(OutputFields::CERTIFICATES))
+		{
+			presentIterativeSimple(CertificateTablePlainGetter(fileinfo));
+		}
+		if(selected(OutputFields::DOTNET))
+		{
+			presentSimple(DotnetPlainGetter(fileinfo), false, ".NET Information");
+			presentDotnetClasses();
+			presentSimple(VisualBasicPlainGetter(fileinfo), false, "Visual Basic Information");
+			presentVisualBasicObjects();
+		}
 
-		if(returnCode != ReturnCode::FILE_NOT_EXIST && returnCode != ReturnCode::UNKNOWN_FORMAT)
+		if(selected(OutputFields::LOADER)
+				&& returnCode != ReturnCode::FILE_NOT_EXIST && returnCode != ReturnCode::UNKNOWN_FORMAT)
 		{
 			presentIterativeDistribution(MissingDepsPlainGetter(fileinfo), explanatory);
 			presentIterativeDistribution(LoaderInfoPlainGetter(fileinfo), explanatory);
 		}
 
-		presentPatterns("Detected cryptography patterns", fileinfo.getCryptoPatterns());
-		presentPatterns("Detected malware patterns", fileinfo.getMalwarePatterns());
-		presentPatterns("Other detected patterns", fileinfo.getOtherPatterns());
+		if(selected(OutputFields::PATTERNS))
+		{
+			presentPatterns("Detected cryptography patterns", fileinfo.getCryptoPatterns());
+			presentPatterns("Detected malware patterns", fileinfo.getMalwarePatterns());
+			presentPatterns("Other detected patterns", fileinfo.getOtherPatterns());
+		}
 	}
 
-	presentIterativeDistribution(StringsPlainGetter(fileinfo), explanatory);
+	if(selected(OutputFields::STRINGS))
+	{
+		presentIterativeDistribution(StringsPlainGetter(fileinfo), explanatory);
+	}
 	return true;
 }
 
@@ -4,6 +4,9 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <fstream>
+#include <iostream>
+#include <memory>
 #include <regex>
 
 #include <llvm/Support/ErrorHandling.h>
@@ -17,6 +20,9 @@
 #include "retdec/cpdetect/settings.h"
 #include "retdec/fileformat/utils/format_detection.h"
 #include "retdec/fileformat/utils/other.h"
+#include "retdec/yaracpp/yara_rules_cache.h"
+#include "retdec/yaracpp/yara_scan_session.h"
+#include "fileinfo/batch/batch_analysis.h"
 #include "fileinfo/file_detector/detector_factory.h"
 #include "fileinfo/file_detector/macho_detector.h"
 #include "fileinfo/file_presentation/config_presentation.h"
@@ -30,6 +36,7 @@ using namespace retdec::ar_extractor;
 using namespace retdec::cpdetect;
 using namespace retdec::fileformat;
 using namespace retdec::fileinfo;
+using namespace retdec::yaracpp;
 
 namespace
 {
@@ -56,6 +63,11 @@ struct ProgParams
 	bool maxMemoryHalfRAM;                  ///< limit maximal memory to half of system RAM
 	std::size_t epBytesCount;               ///< number of bytes to load from entry point
 	LoadFlags loadFlags;                    ///< load flags for `fileformat`
+	OutputFields outputFields;              ///< information which is computed and printed
+	bool batch;                             ///< analyze many files, print one JSON object per line
+	std::vector<std::string> batchPaths;    ///< names of input files in batch mode
+	std::string batchListFile;              ///< name of the file with names of input files ("-" is stdin)
+	std::size_t jobs;                       ///< number of threads in batch mode (0 means number of CPUs)
 
 	ProgParams() : searchMode(SearchType::EXACT_MATCH),
 					internalDatabase(true),
@@ -67,7 +79,10 @@ struct ProgParams
 					maxMemory(0),
 					maxMemoryHalfRAM(false),
 					epBytesCount(EP_BYTES_SIZE),
-					loadFlags(LoadFlags::NONE) {}
+					loadFlags(LoadFlags::NONE),
+					outputFields(OutputFields::ALL_FIELDS),
+					batch(false),
+					jobs(0) {}
 };
 
 /**
@@ -104,6 +119,21 @@ void fatalErrorHandler(void *user_data, const std::string& /*reason*/, bool /*ge
 	exit(static_cast<int>(ReturnCode::FORMAT_PARSER_PROBLEM));
 }
 
+/**
+ * LLVM fatal error handler in batch mode
+ * @param user_data Unused
+ * @param reason Reason of the error
+ * @param gen_crash_diag Unused
+ *
+ * The handler is called on the thread that failed. It abandons the analysis
+ * of the file analyzed by this thread, whose failure is then recorded by
+ * runBatch(), and the other files are analyzed as usual.
+ */
+void batchFatalErrorHandler(void* /*user_data*/, const std::string& reason, bool /*gen_crash_diag*/)
+{
+	throw BatchFatalError(reason);
+}
+
 /**
  * Print help text on standard output
  */
@@ -113,7 +143,8 @@ void printHelp()
 				<< "For compiler detection, program looks in the input file for YARA patterns.\n"
 				<< "According to them, it determines compiler or packer used for file creation.\n"
 				<< "Supported file formats are: " + joinStrings(getSupportedFileFormats()) + ".\n\n"
-				<< "Usage: fileinfo [options] file\n\n"
+				<< "Usage: fileinfo [options] file\n"
+				<< "       fileinfo [options] --batch [file...]\n\n"
 				<< "Options list:\n"
 				<< "    --help, -h            Display this help.\n"
 				<< "\n"
@@ -159,6 +190,12 @@ void printHelp()
 				<< "                          Either all hashes or only file/verbose hashes.\n"
 				<< "                          All assumed if no argument specified.\n"
 				<< "    --ep-bytes=N          Number of bytes to load from entry point. (Default: " << EP_BYTES_SIZE << ")\n"
+				<< "    --fields=list         Compute and print only the given comma-separated\n"
+				<< "                          fields (and basic information about the file).\n"
+				<< "                          Only the parts of the file needed for them are\n"
+				<< "                          loaded. All information about the fields is\n"
+				<< "                          printed, as with \"--verbose\". Fields:\n"
+				<< "                          " << getOutputFieldNames() << "\n"
 				<< "\n"
 				<< "Other options for specifying output:\n"
 				<< "    --verbose, -v         Print more information about input file.\n"
@@ -178,7 +215,19 @@ void printHelp()
 				<< "\n"
 				<< "Options for specifying list of available DLLs:\n"
 				<< "    --dlls=filename\n"
-				<< "                          Load the list of present DLLs from the file.\n";
+				<< "                          Load the list of present DLLs from the file.\n"
+				<< "\n"
+				<< "Options for analyzing many files at once:\n"
+				<< "  Signatures, YARA rules and the list of DLLs are loaded only once and shared\n"
+				<< "  by all files. For each file, one JSON object is printed on one line as soon\n"
+				<< "  as the file is analyzed, so the order of files on output may differ.\n"
+				<< "  Option \"--config\" cannot be used in this mode.\n"
+				<< "    --batch               Analyze all files given on the command line.\n"
+				<< "    --batch-list=file     Analyze also files listed in the given file (one\n"
+				<< "                          per line). Use \"-\" to read them from standard\n"
+				<< "                          input as they come.\n"
+				<< "    --jobs=N              Number of files analyzed at once (default: number\n"
+				<< "                          of CPUs, at most " << BatchAnalysis::MAX_JOBS << ").\n";
 }
 
 std::string getParamOrDie(std::vector<std::string> &argv, std::size_t &i)
@@ -217,7 +266,8 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 	std::vector<std::string> argv;
 
 	std::set<std::string> withArgs = {"malware", "m", "crypto", "C", "other",
-			"o", "config", "c", "no-hashes", "max-memory", "ep-bytes", "dlls"};
+			"o", "config", "c", "no-hashes", "max-memory", "ep-bytes", "dlls",
+			"batch-list", "jobs", "fields"};
 	for (int i = 1; i < argc; ++i)
 	{
 		std::string a = _argv[i];
@@ -242,6 +292,7 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 		argv.push_back(a);
 	}
 
+	std::vector<std::string> inputFiles;
 	for (std::size_t i = 0; i < argv.size(); ++i)
 	{
 		std::string c = argv[i];
@@ -365,21 +416,48 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 
 			params.dllListFile = dllListFile;
 		}
-		else if (params.filePath.empty())
+		else if (c == "--fields")
+		{
+			if (!parseOutputFields(getParamOrDie(argv, i), params.outputFields))
+				return false;
+		}
+		else if (c == "--batch")
+		{
+			params.batch = true;
+		}
+		else if (c == "--batch-list")
+		{
+			params.batchListFile = getParamOrDie(argv, i);
+			params.batch = true;
+		}
+		else if (c == "--jobs")
 		{
-			params.filePath = argv[i];
+			auto jobsString = getParamOrDie(argv, i);
+			if (!strToNum(jobsString, params.jobs))
+				return false;
 		}
 		else
 		{
-			return false;
+			inputFiles.push_back(argv[i]);
 		}
 	}
 
-	if(params.filePath.empty())
+	params.loadFlags = static_cast<LoadFlags>(params.loadFlags
+			| getLoadFlagsForOutputFields(params.outputFields));
+
+	if(params.batch)
+	{
+		params.batchPaths = inputFiles;
+		return !params.generateConfigFile
+				&& (!inputFiles.empty() || !params.batchListFile.empty());
+	}
+
+	if(inputFiles.size() != 1)
 	{
 		return false;
 	}
 
+	params.filePath = inputFiles.front();
 	return true;
 }
 
@@ -401,6 +479,154 @@ void limitMaximalMemoryIfRequested(const ProgParams& params)
 	}
 }
 
+/**
+ * Analyze input file
+ * @param params Program parameters
+ * @param filePath Path to input file
+ * @param config Config of input file or @c nullptr if no config is used
+ * @param rulesCache Compiled YARA rules shared by all analyzed files or
+ *    @c nullptr if the rules are compiled for this file only
+ * @param fileinfo Into this parameter information about file is stored
+ */
+void analyzeFile(
+		const ProgParams& params,
+		const std::string& filePath,
+		retdec::config::Config* config,
+		YaraRulesCache* rulesCache,
+		FileInformation& fileinfo)
+{
+	DetectParams searchPar(params.searchMode, params.internalDatabase, params.externalDatabase, params.epBytesCount);
+	searchPar.rulesCache = rulesCache;
+	const auto fileFormat = detectFileFormat(filePath, config && config->fileFormat.isRaw());
+	fileinfo.setPathToFile(filePath);
+	fileinfo.setFileFormatEnum(fileFormat);
+	fileinfo.setOutputFields(params.outputFields);
+	if(fileFormat == Format::UNDETECTABLE)
+	{
+		fileinfo.setStatus(ReturnCode::FILE_NOT_EXIST);
+		return;
+	}
+
+	std::unique_ptr<FileDetector> fileDetector(createFileDetector(filePath, params.dllListFile, fileFormat, fileinfo, searchPar, params.loadFlags));
+	if(fileDetector)
+	{
+		if(!fileDetector->getFileParser()->isInValidState())
+		{
+			// Check if Mach-O is archive.
+			if (fileFormat == Format::MACHO)
+			{
+				auto machoDetecor = static_cast<MachODetector*>(fileDetector.get());
+				if (machoDetecor->isMachoUniversalArchive())
+				{
+					fileinfo.setStatus(ReturnCode::MACHO_AR_DETECTED);
+					return;
+				}
+			}
+
+			fileinfo.setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
+			return;
+		}
+
+		if(config)
+		{
+			fileDetector->setConfigFile(*config);
+		}
+	}
+	else
+	{
+		if(isArchive(filePath))
+		{
+			fileinfo.setStatus(ReturnCode::ARCHIVE_DETECTED);
+		}
+		else
+		{
+			fileinfo.setStatus(ReturnCode::UNKNOWN_FORMAT);
+		}
+	}
+
+	// Signatures of compilers and YARA patterns are matched by one scan of
+	// the loaded file.
+	std::unique_ptr<YaraScanSession> scanSession;
+	if(fileDetector)
+	{
+		const auto &bytes = fileDetector->getFileParser()->getBytes();
+		scanSession = std::make_unique<YaraScanSession>(bytes.data(), bytes.size(), rulesCache);
+		searchPar.scanSession = scanSession.get();
+	}
+	PatternDetector patternDetector(fileDetector ? fileDetector->getFileParser() : nullptr, fileinfo, rulesCache, scanSession.get());
+	if(fileinfo.isOutputFieldSelected(OutputFields::PATTERNS))
+	{
+		patternDetector.addFilePaths("malware", params.yaraMalwarePaths);
+		patternDetector.addFilePaths("crypto", params.yaraCryptoPaths);
+		patternDetector.addFilePaths("other", params.yaraOtherPaths);
+		patternDetector.addRuleSets();
+	}
+
+	if(fileDetector)
+	{
+		fileDetector->getAllInformation();
+	}
+	if(fileinfo.isOutputFieldSelected(OutputFields::PATTERNS))
+	{
+		patternDetector.analyze();
+	}
+}
+
+/**
+ * Analyze all input files in batch mode
+ * @param params Program parameters
+ * @return Program status
+ *
+ * Files are analyzed by several threads. Compiled YARA rules (signatures of
+ * tools and rules from options) and lists of DLLs are shared by all of them.
+ */
+int runBatch(ProgParams& params)
+{
+	BatchAnalysis batch(params.batchPaths, params.batchListFile);
+	if(!batch.isInValidState())
+	{
+		Log::error() << "Error: loading of list of input files failed: " << params.batchListFile << "\n";
+		return static_cast<int>(ReturnCode::FILE_PROBLEM);
+	}
+
+	llvm::install_fatal_error_handler(batchFatalErrorHandler, nullptr);
+
+	YaraRulesCache rulesCache;
+	batch.run(
+		[&](const std::string& path)
+		{
+			retdec::config::Config config;
+			FileInformation fileinfo;
+			try
+			{
+				analyzeFile(params, path, &config, &rulesCache, fileinfo);
+			}
+			catch(const BatchFatalError&)
+			{
+				fileinfo.setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
+			}
+			return JsonPresentation(fileinfo, params.verbose).getJson(true);
+		},
+		[](const std::string& json)
+		{
+			Log::info() << json << std::endl;
+		},
+		params.jobs,
+		[&](const std::string& path, const std::string& message)
+		{
+			// E.g. std::bad_alloc or an exception of a parser on malformed
+			// input, the file is reported as failed.
+			FileInformation fileinfo;
+			fileinfo.setPathToFile(path);
+			fileinfo.setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
+			fileinfo.messages.push_back("Error: Analysis failed: " + message);
+			return JsonPresentation(fileinfo, params.verbose).getJson(true);
+		}
+	);
+
+	return static_cast<int>(ReturnCode::OK);
+}
+
 } // anonymous namespace
 
 /**
@@ -421,6 +647,11 @@ int main(int argc, char* argv[])
 
 	limitMaximalMemoryIfRequested(params);
 
+	if(params.batch)
+	{
+		return runBatch(params);
+	}
+
 	bool useConfig = true;
 	retdec::config::Config config;
 	if(params.generateConfigFile && !params.configFile.empty())
@@ -439,67 +670,10 @@ int main(int argc, char* argv[])
 		}
 	}
 
-	DetectParams searchPar(params.searchMode, params.internalDatabase, params.externalDatabase, params.epBytesCount);
-	const auto fileFormat = detectFileFormat(params.filePath, useConfig && config.fileFormat.isRaw());
 	FileInformation fileinfo;
-	FileDetector *fileDetector = nullptr;
-	fileinfo.setPathToFile(params.filePath);
-	fileinfo.setFileFormatEnum(fileFormat);
 	ErrorHandlerInfo hInfo { &params, &fileinfo };
 	llvm::install_fatal_error_handler(fatalErrorHandler, &hInfo);
-	switch(fileFormat)
-	{
-		case Format::UNDETECTABLE:
-		{
-			fileinfo.setStatus(ReturnCode::FILE_NOT_EXIST);
-			break;
-		}
-		default:
-		{
-			fileDetector = createFileDetector(params.filePath, params.dllListFile, fileFormat, fileinfo, searchPar, params.loadFlags);
-			if(fileDetector)
-			{
-				if(!fileDetector->getFileParser()->isInValidState())
-				{
-					// Check if Mach-O is archive.
-					if (fileFormat == Format::MACHO)
-					{
-						auto machoDetecor = static_cast<MachODetector*>(fileDetector);
-						if (machoDetecor->isMachoUniversalArchive())
-						{
-							fileinfo.setStatus(ReturnCode::MACHO_AR_DETECTED);
-							break;
-						}
-					}
-
-					fileinfo.setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
-					break;
-				}
-
-				if(useConfig)
-				{
-					fileDetector->setConfigFile(config);
-				}
-				fileDetector->getAllInformation();
-			}
-			else
-			{
-				if(isArchive(params.filePath))
-				{
-					fileinfo.setStatus(ReturnCode::ARCHIVE_DETECTED);
-				}
-				else
-				{
-					fileinfo.setStatus(ReturnCode::UNKNOWN_FORMAT);
-				}
-			}
-			PatternDetector patternDetector(fileDetector ? fileDetector->getFileParser() : nullptr, fileinfo);
-			patternDetector.addFilePaths("malware", params.yaraMalwarePaths);
-			patternDetector.addFilePaths("crypto", params.yaraCryptoPaths);
-			patternDetector.addFilePaths("other", params.yaraOtherPaths);
-			patternDetector.analyze();
-		}
-	}
+	analyzeFile(params, params.filePath, useConfig ? &config : nullptr, nullptr, fileinfo);
 
 	// print results on standard output
 	if(params.plainText)
@@ -523,6 +697,5 @@ int main(int argc, char* argv[])
 		}
 	}
 
-	delete fileDetector;
 	return isFatalError(res) ? static_cast<int>(res) : static_cast<int>(ReturnCode::OK);
 }
@@ -4,6 +4,7 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <memory>
 #include <regex>
 
 #include "retdec/utils/conversion.h"
@@ -11,6 +12,8 @@
 #include "retdec/utils/string.h"
 #include "fileinfo/pattern_detector/pattern_detector.h"
 #include "retdec/yaracpp/yara_detector.h"
+#include "retdec/yaracpp/yara_rules_cache.h"
+#include "retdec/yaracpp/yara_scan_session.h"
 
 using namespace retdec::utils;
 using namespace retdec::yaracpp;
@@ -22,9 +25,17 @@ namespace fileinfo {
  * Constructor
  * @param fparser Pointer to file parser
  * @param finfo Reference to information about input file
+ * @param rules Compiled YARA rules shared with other detectors. If it is
+ *    @c nullptr, rules are compiled by this detector.
+ * @param session Scan of input file shared with other detectors. If it is
+ *    @c nullptr, input file is scanned by this detector.
  */
-PatternDetector::PatternDetector(const retdec::fileformat::FileFormat *fparser, FileInformation &finfo) :
-	fileParser(fparser), fileinfo(finfo)
+PatternDetector::PatternDetector(
+		const retdec::fileformat::FileFormat *fparser,
+		FileInformation &finfo,
+		yaracpp::YaraRulesCache *rules,
+		yaracpp::YaraScanSession *session) :
+	fileParser(fparser), fileinfo(finfo), rulesCache(rules), scanSession(session)
 {
 
 }
@@ -331,37 +342,101 @@ void PatternDetector::addFilePaths(const std::string &category, const std::set<s
 	}
 }
 
+/**
+ * Add rule sets of categories which were not added yet to the shared scan
+ * of input file
+ *
+ * Rule sets added before other detectors scan the file are scanned together
+ * with their rules. Does nothing if the scan is not shared.
+ */
+void PatternDetector::addRuleSets()
+{
+	if(!scanSession)
+	{
+		return;
+	}
+
+	for(std::size_t i = ruleSets.size(), e = categories.size(); i < e; ++i)
+	{
+		const auto &paths = categories[i].second;
+		ruleSets.push_back(scanSession->addRuleSet(std::vector<std::string>(paths.begin(), paths.end())));
+	}
+}
+
+/**
+ * Save detected rules of the given category
+ * @param category Name of category
+ * @param detected Detected rules
+ */
+void PatternDetector::saveRules(const std::string &category, const std::vector<yaracpp::YaraRule> &detected)
+{
+	for(const auto &rule : detected)
+	{
+		if(category == "crypto")
+		{
+			saveCryptoRule(rule);
+		}
+		else if(category == "malware")
+		{
+			saveMalwareRule(rule);
+		}
+		else
+		{
+			saveOtherRule(rule);
+		}
+	}
+}
+
 /**
  * Analyze input file and try to find YARA patterns
  */
 void PatternDetector::analyze()
 {
-	for(const auto &category : categories)
+	addRuleSets();
+	if(scanSession)
 	{
-		YaraDetector yara;
+		scanSession->scan();
+	}
 
-		for(const auto &item : category.second)
+	for(std::size_t i = 0, e = categories.size(); i < e; ++i)
+	{
+		const auto &category = categories[i];
+		if(scanSession)
 		{
-			yara.addRuleFile(item);
+			saveRules(category.first, scanSession->getDetectedRules(ruleSets[i]));
+			continue;
 		}
 
-		yara.analyze(fileinfo.getPathToFile());
+		YaraRulesCache::RuleFiles ruleFiles;
+		for(const auto &item : category.second)
+		{
+			ruleFiles.emplace_back(item, std::string());
+		}
 
-		for(const auto &rule : yara.getDetectedRules())
+		std::unique_ptr<YaraDetector> localYara;
+		const YaraDetector *yara = nullptr;
+		if(rulesCache)
 		{
-			if(category.first == "crypto")
-			{
-				saveCryptoRule(rule);
-			}
-			else if(category.first == "malware")
-			{
-				saveMalwareRule(rule);
-			}
-			else
+			yara = rulesCache->getDetector(ruleFiles);
+		}
+		else
+		{
+			localYara = std::make_unique<YaraDetector>();
+			for(const auto &item : ruleFiles)
 			{
-				saveOtherRule(rule);
+				localYara->addRuleFile(item.first);
 			}
+			localYara->compileRules();
+			yara = localYara.get();
 		}
+
+		std::vector<YaraRule> detected, undetected;
+		if(yara)
+		{
+			yara->analyze(fileinfo.getPathToFile(), detected, undetected);
+		}
+
+		saveRules(category.first, detected);
 	}
 
 	fileinfo.removeRedundantCryptoRules();
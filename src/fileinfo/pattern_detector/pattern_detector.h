@@ -16,6 +16,8 @@
 namespace retdec {
 namespace yaracpp {
 class YaraRule;
+class YaraRulesCache;
+class YaraScanSession;
 } // namespace yaracpp
 } // namespace retdec
 
@@ -32,6 +34,9 @@ class PatternDetector
 		const retdec::fileformat::FileFormat *fileParser;                             ///< parser of input file
 		FileInformation &fileinfo;                                             ///< information about input file
 		std::vector<std::pair<std::string, std::set<std::string>>> categories; ///< paths to YARA rules
+		yaracpp::YaraRulesCache *rulesCache;                                   ///< shared compiled YARA rules
+		yaracpp::YaraScanSession *scanSession;                                 ///< scan of input file shared with other detectors
+		std::vector<std::size_t> ruleSets;                                     ///< rule sets of categories in @c scanSession
 
 		/// @name Iterators
 		/// @{
@@ -45,13 +50,19 @@ class PatternDetector
 		void saveCryptoRule(const yaracpp::YaraRule &rule);
 		void saveMalwareRule(const yaracpp::YaraRule &rule);
 		void saveOtherRule(const yaracpp::YaraRule &rule);
+		void saveRules(const std::string &category, const std::vector<yaracpp::YaraRule> &detected);
 		/// @}
 	public:
-		PatternDetector(const retdec::fileformat::FileFormat *fparser, FileInformation &finfo);
+		PatternDetector(
+				const retdec::fileformat::FileFormat *fparser,
+				FileInformation &finfo,
+				yaracpp::YaraRulesCache *rules = nullptr,
+				yaracpp::YaraScanSession *session = nullptr);
 
 		/// @name Detection methods
 		/// @{
 		void addFilePaths(const std::string &category, const std::set<std::string> &paths);
+		void addRuleSets();
 		void analyze();
 		/// @}
 };
@@ -177,7 +177,7 @@ void DefUseAnalysis::computeGenAndKillForNode(ShPtr<DefUseChains> ducs,
 	kill.clear();
 
 	// Defined variables in the node (regularly updated).
-	VarSet defVars;
+	VarBitSet defVars;
 
 	//
 	// Compute GEN[node].
@@ -191,7 +191,8 @@ void DefUseAnalysis::computeGenAndKillForNode(ShPtr<DefUseChains> ducs,
 		// Compute GEN[node] for the current statement.
 		for (auto j = stmtData->dir_read_begin(), f = stmtData->dir_read_end();
 				j != f; ++j) {
-			if (!hasItem(defVars, *j) && ducs->shouldBeIncluded(*j)) {
+			if (!defVars.contains(*j, ducs->varIds) &&
+					ducs->shouldBeIncluded(*j)) {
 				gen.emplace(*i, *j);
 			}
 		}
@@ -201,7 +202,7 @@ void DefUseAnalysis::computeGenAndKillForNode(ShPtr<DefUseChains> ducs,
 		for (auto j = stmtData->dir_written_begin(), f = stmtData->dir_written_end();
 				j != f; ++j) {
 			if (ducs->shouldBeIncluded(*j)) {
-				defVars.insert(*j);
+				defVars.insert(*j, ducs->varIds);
 			}
 		}
 	}
@@ -211,7 +212,9 @@ void DefUseAnalysis::computeGenAndKillForNode(ShPtr<DefUseChains> ducs,
 	//
 
 	// For each defined variable in the node...
-	for (const auto &defVar : defVars) {
+	for (auto i = defVars.id_begin(), e = defVars.id_end(); i != e; ++i) {
+		const auto &defVar = ducs->varIds.getVar(*i);
+
 		// Get all statements where the current variable is used.
 		const auto &varUses = vuv->getUses(defVar, ducs->func)->dirUses;
 
@@ -28,9 +28,7 @@
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 #include "retdec/utils/container.h"
 
-using retdec::utils::addToSet;
 using retdec::utils::hasItem;
-using retdec::utils::setUnion;
 
 namespace retdec {
 namespace llvmir2hll {
@@ -107,8 +105,10 @@ ShPtr<VarUses> VarUsesVisitor::getUses(ShPtr<Variable> var,
 
 	// Have we already computed this piece of information?
 	if (cachingEnabled) {
-		varUses = cache[func][var];
-		if (varUses) {
+		const auto &funcUses = cache[func];
+		auto id = findCachedUses(funcUses, var);
+		if (id != VarNumbering::NO_ID) {
+			varUses = funcUses.uses[id];
 			return varUses;
 		}
 	}
@@ -122,7 +122,7 @@ ShPtr<VarUses> VarUsesVisitor::getUses(ShPtr<Variable> var,
 
 	// Should we cache the computed result?
 	if (cachingEnabled) {
-		cache[func][var] = varUses;
+		storeCachedUses(cache[func], varUses);
 	}
 
 	return varUses;
@@ -189,41 +189,24 @@ void VarUsesVisitor::stmtHasBeenAdded(ShPtr<Statement> stmt,
 		return;
 	}
 
-	// Get all variables used in the new statement.
+	// Update the uses of all variables used in the new statement. Variables
+	// that haven't been used in the function before the statement was added
+	// get new uses.
 	ShPtr<ValueData> stmtData(va->getValueData(stmt));
-	VarSet dirUsedVars(stmtData->getDirAccessedVars());
-	VarSet indirUsedVars(setUnion(
-		stmtData->getMayBeAccessedVars(),
-		stmtData->getMustBeAccessedVars()));
-
-	// Go over all variables used in the function. If the current variable is
-	// used in the new statement, update its uses.
-	for (const auto &p : cache[func]) {
-		// Directly used variables.
-		if (hasItem(dirUsedVars, p.first)) {
-			p.second->dirUses.insert(stmt);
-			dirUsedVars.erase(p.first);
-		}
-		// Indirectly used variables.
-		if (hasItem(indirUsedVars, p.first)) {
-			p.second->indirUses.insert(stmt);
-			indirUsedVars.erase(p.first);
-		}
-	}
-
-	// If there are some variables left, it means that these haven't been used
-	// in the function before the statement was added. Add them.
+	auto &funcUses = cache[func];
 	// Directly used variables.
-	for (const auto &var : dirUsedVars) {
-		ShPtr<VarUses> varUses(new VarUses(var, func));
-		varUses->dirUses.insert(stmt);
-		cache[func][var] = varUses;
+	for (const auto &var : stmtData->getDirAccessedVars()) {
+		addCachedUse(funcUses, getOrCreateCachedUses(funcUses, var, func),
+			stmt, true);
 	}
 	// Indirectly used variables.
-	for (const auto &var : indirUsedVars) {
-		ShPtr<VarUses> varUses(new VarUses(var, func));
-		varUses->indirUses.insert(stmt);
-		cache[func][var] = varUses;
+	for (const auto &var : stmtData->getMayBeAccessedVars()) {
+		addCachedUse(funcUses, getOrCreateCachedUses(funcUses, var, func),
+			stmt, false);
+	}
+	for (const auto &var : stmtData->getMustBeAccessedVars()) {
+		addCachedUse(funcUses, getOrCreateCachedUses(funcUses, var, func),
+			stmt, false);
 	}
 }
 
@@ -254,26 +237,30 @@ void VarUsesVisitor::stmtHasBeenChanged(ShPtr<Statement> stmt,
 		return;
 	}
 
-	// Get all variables used in the new statement.
+	// Remove the statement from the uses of all variables that have been used
+	// in it, and then add it to the uses of variables that are used in it
+	// now. Notice that this has to be done only for cached variables.
+	auto &funcUses = cache[func];
+	removeCachedUses(funcUses, stmt);
 	ShPtr<ValueData> stmtData(va->getValueData(stmt));
-	const VarSet &dirUsedVars(stmtData->getDirAccessedVars());
-	const VarSet &indirUsedVars(setUnion(
-		stmtData->getMayBeAccessedVars(),
-		stmtData->getMustBeAccessedVars()));
-
-	// Go over all variables used in the function and remove the statement from
-	// the uses of all variables in the function which are not used in the
-	// statement. Notice that this has to be done only for cached variables.
-	for (const auto &p : cache[func]) {
-		// Direct uses.
-		p.second->dirUses.erase(stmt);
-		if (hasItem(dirUsedVars, p.first)) {
-			p.second->dirUses.insert(stmt);
+	// Direct uses.
+	for (const auto &var : stmtData->getDirAccessedVars()) {
+		auto id = findCachedUses(funcUses, var);
+		if (id != VarNumbering::NO_ID) {
+			addCachedUse(funcUses, id, stmt, true);
+		}
+	}
+	// Indirect uses.
+	for (const auto &var : stmtData->getMayBeAccessedVars()) {
+		auto id = findCachedUses(funcUses, var);
+		if (id != VarNumbering::NO_ID) {
+			addCachedUse(funcUses, id, stmt, false);
 		}
-		// Indirect uses.
-		p.second->indirUses.erase(stmt);
-		if (hasItem(indirUsedVars, p.first)) {
-			p.second->indirUses.insert(stmt);
+	}
+	for (const auto &var : stmtData->getMustBeAccessedVars()) {
+		auto id = findCachedUses(funcUses, var);
+		if (id != VarNumbering::NO_ID) {
+			addCachedUse(funcUses, id, stmt, false);
 		}
 	}
 }
@@ -305,13 +292,9 @@ void VarUsesVisitor::stmtHasBeenRemoved(ShPtr<Statement> stmt,
 		return;
 	}
 
-	// Remove the statement from the uses of all variables in the function.
-	// TODO Is this way faster than obtaining all variables used in stmt and
-	//      then updating only the uses of these variables?
-	for (const auto &p : cache[func]) {
-		p.second->dirUses.erase(stmt);
-		p.second->indirUses.erase(stmt);
-	}
+	// Remove the statement from the uses of all variables that are used in
+	// it.
+	removeCachedUses(cache[func], stmt);
 }
 
 /**
@@ -364,16 +347,16 @@ void VarUsesVisitor::precomputeEverything(ShPtr<Module> module) {
 		// create a cache entry for it. However, then, when calling getUses(),
 		// getUses() would act as if we haven't precomputed everything. To
 		// this end, we initialize an empty VarUses for every global variable.
+		auto &funcUses = cache[func];
 		for (auto j = module->global_var_begin(), f = module->global_var_end();
 				j != f; ++j) {
-			cache[func][(*j)->getVar()] = ShPtr<VarUses>(
-				new VarUses((*j)->getVar(), func));
+			getOrCreateCachedUses(funcUses, (*j)->getVar(), func);
 		}
 
 		// Do the same for all function's arguments (there may be arguments
 		// which are never used).
 		for (const auto &param : func->getParams()) {
-			cache[func][param] = ShPtr<VarUses>(new VarUses(param, func));
+			getOrCreateCachedUses(funcUses, param, func);
 		}
 
 		restart();
@@ -394,27 +377,23 @@ void VarUsesVisitor::findAndStoreUses(ShPtr<Statement> stmt) {
 	if (precomputing) {
 		// We are pre-computing everything.
 
+		auto &funcUses = cache[func];
+
 		// Directly used variables.
 		for (auto i = stmtData->dir_all_begin(), e = stmtData->dir_all_end();
 				i != e; ++i) {
-			ShPtr<VarUses> &varUses(cache[func][*i]);
-			if (!varUses) {
-				varUses = ShPtr<VarUses>(new VarUses(*i, func));
-			}
-			varUses->dirUses.insert(stmt);
+			addCachedUse(funcUses, getOrCreateCachedUses(funcUses, *i, func),
+				stmt, true);
 		}
 
 		// Indirectly used variables.
-		VarSet indirUsedVars;
-		addToSet(stmtData->getMayBeAccessedVars(), indirUsedVars);
-		addToSet(stmtData->getMustBeAccessedVars(), indirUsedVars);
-		// For every indirectly used variable...
-		for (const auto &var : indirUsedVars) {
-			ShPtr<VarUses> &varUses(cache[func][var]);
-			if (!varUses) {
-				varUses = ShPtr<VarUses>(new VarUses(var, func));
-			}
-			varUses->indirUses.insert(stmt);
+		for (const auto &var : stmtData->getMayBeAccessedVars()) {
+			addCachedUse(funcUses, getOrCreateCachedUses(funcUses, var, func),
+				stmt, false);
+		}
+		for (const auto &var : stmtData->getMustBeAccessedVars()) {
+			addCachedUse(funcUses, getOrCreateCachedUses(funcUses, var, func),
+				stmt, false);
 		}
 	} else {
 		// We are not pre-computing.
@@ -441,17 +420,105 @@ void VarUsesVisitor::dumpCache() {
 	llvm::errs() << "[VarUsesVisitor] Cache:\n";
 	for (auto i = cache.begin(), e = cache.end(); i != e; ++i) {
 		llvm::errs() << "    " << i->first->getName() << ":\n";
-		for (auto j = i->second.begin(), f = i->second.end(); j != f ; ++j) {
-			llvm::errs() << "        " << j->first->getName() << ":\n";
+		for (const auto &varUses : i->second.uses) {
+			if (!varUses) {
+				continue;
+			}
+			llvm::errs() << "        " << varUses->var->getName() << ":\n";
 			llvm::errs() << "            dir: ";
-			dump(j->second->dirUses, dumpFuncGetTextRepr<ShPtr<Statement>>);
+			dump(varUses->dirUses, dumpFuncGetTextRepr<ShPtr<Statement>>);
 			llvm::errs() << "            indir: ";
-			dump(j->second->indirUses, dumpFuncGetTextRepr<ShPtr<Statement>>);
+			dump(varUses->indirUses, dumpFuncGetTextRepr<ShPtr<Statement>>);
 		}
 	}
 	llvm::errs() << "\n";
 }
 
+/**
+* @brief Returns the ID of @a var in @a funcUses (the uses in @a func),
+*        creating empty cached uses of @a var if they do not exist.
+*/
+VarNumbering::Id VarUsesVisitor::getOrCreateCachedUses(FuncVarUses &funcUses,
+		ShPtr<Variable> var, ShPtr<Function> func) {
+	auto id = funcUses.varIds.getId(var);
+	if (id >= funcUses.uses.size()) {
+		funcUses.uses.resize(id + 1);
+	}
+	if (!funcUses.uses[id]) {
+		funcUses.uses[id] = std::make_shared<VarUses>(var, func);
+	}
+	return id;
+}
+
+/**
+* @brief Returns the ID of @a var in @a funcUses if its uses are cached, @c
+*        VarNumbering::NO_ID otherwise.
+*/
+VarNumbering::Id VarUsesVisitor::findCachedUses(const FuncVarUses &funcUses,
+		ShPtr<Variable> var) const {
+	auto id = funcUses.varIds.findId(var);
+	if (id == VarNumbering::NO_ID || id >= funcUses.uses.size() ||
+			!funcUses.uses[id]) {
+		return VarNumbering::NO_ID;
+	}
+	return id;
+}
+
+/**
+* @brief Stores the computed uses @a varUses of a variable into @a funcUses.
+*/
+void VarUsesVisitor::storeCachedUses(FuncVarUses &funcUses,
+		ShPtr<VarUses> varUses) {
+	auto id = funcUses.varIds.getId(varUses->var);
+	if (id >= funcUses.uses.size()) {
+		funcUses.uses.resize(id + 1);
+	}
+	funcUses.uses[id] = varUses;
+
+	for (const auto &stmt : varUses->dirUses) {
+		addCachedUse(funcUses, id, stmt, true);
+	}
+	for (const auto &stmt : varUses->indirUses) {
+		addCachedUse(funcUses, id, stmt, false);
+	}
+}
+
+/**
+* @brief Adds @a stmt into the cached direct or indirect uses of the variable
+*        with the given ID.
+*/
+void VarUsesVisitor::addCachedUse(FuncVarUses &funcUses, VarNumbering::Id id,
+		ShPtr<Statement> stmt, bool direct) {
+	auto &varUses = funcUses.uses[id];
+	if (direct) {
+		varUses->dirUses.insert(stmt);
+	} else {
+		varUses->indirUses.insert(stmt);
+	}
+
+	auto &varIds = funcUses.stmtVarIds[stmt];
+	if (!hasItem(varIds, id)) {
+		varIds.push_back(id);
+	}
+}
+
+/**
+* @brief Removes @a stmt from the cached uses of all variables in @a funcUses.
+*/
+void VarUsesVisitor::removeCachedUses(FuncVarUses &funcUses,
+		ShPtr<Statement> stmt) {
+	auto i = funcUses.stmtVarIds.find(stmt);
+	if (i == funcUses.stmtVarIds.end()) {
+		return;
+	}
+
+	for (auto id : i->second) {
+		funcUses.uses[id]->dirUses.erase(stmt);
+		funcUses.uses[id]->indirUses.erase(stmt);
+	}
+	funcUses.stmtVarIds.erase(i);
+}
+
 void VarUsesVisitor::visit(ShPtr<AssignStmt> stmt) {
 	findAndStoreUses(stmt);
 	OrderedAllVisitor::visit(stmt);
@@ -13,6 +13,7 @@
 #include "retdec/llvmir2hll/hll/output_manager.h"
 #include "retdec/llvmir2hll/hll/output_managers/json_manager.h"
 #include "retdec/llvmir2hll/hll/output_managers/plain_manager.h"
+#include "retdec/llvmir2hll/hll/output_managers/recording_manager.h"
 #include "retdec/llvmir2hll/ir/array_type.h"
 #include "retdec/llvmir2hll/ir/binary_op_expr.h"
 #include "retdec/llvmir2hll/ir/call_expr.h"
@@ -32,6 +33,7 @@
 #include "retdec/llvmir2hll/ir/variable.h"
 #include "retdec/llvmir2hll/llvm/llvm_support.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/func_output_cache.h"
 #include "retdec/llvmir2hll/support/global_vars_sorter.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 #include "retdec/llvmir2hll/utils/ir.h"
@@ -197,6 +199,18 @@ void HLLWriter::setOptionUseCompoundOperators(bool use) {
 	optionUseCompoundOperators = use;
 }
 
+/**
+* @brief Sets the cache of the emitted output of functions.
+*
+* @param[in] cache Cache to be used. If it is the null pointer, no cache is used.
+*
+* Functions found in the cache are not emitted; their cached output is used
+* instead. The output of other cacheable functions is stored into the cache.
+*/
+void HLLWriter::setFuncOutputCache(ShPtr<FuncOutputCache> cache) {
+	funcOutputCache = cache;
+}
+
 /**
 * @brief Emits the code from the given module.
 *
@@ -554,7 +568,20 @@ bool HLLWriter::emitFunction(ShPtr<Function> func) {
 	// signature. IDA plugin relies on that.
 	emitCommentIfAvailable(func);
 
-	func->accept(this);
+	if (funcOutputCache && funcOutputCache->hasCachedOutput(func)) {
+		funcOutputCache->emitCachedOutput(func, *out);
+	} else if (funcOutputCache && funcOutputCache->isCacheable(func)) {
+		// Record the emitted tokens so they can be stored into the cache.
+		UPtr<OutputManager> target(std::move(out));
+		auto recorder = std::make_unique<RecordingOutputManager>(*target);
+		RecordingOutputManager &recorderRef = *recorder;
+		out = std::move(recorder);
+		func->accept(this);
+		funcOutputCache->storeOutput(func, recorderRef.getTokens());
+		out = std::move(target);
+	} else {
+		func->accept(this);
+	}
 
 	currFunc.reset();
 	out->addressPop();
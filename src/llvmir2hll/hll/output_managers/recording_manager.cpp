@@ -0,0 +1,237 @@
+/**
+* @file src/llvmir2hll/hll/output_managers/recording_manager.cpp
+* @brief Implementation of RecordingOutputManager.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <cstdint>
+#include <string>
+
+#include "retdec/llvmir2hll/hll/output_managers/recording_manager.h"
+#include "retdec/llvmir2hll/support/debug.h"
+
+namespace retdec {
+namespace llvmir2hll {
+
+RecordingOutputManager::RecordingOutputManager(OutputManager& target) :
+		_target(target)
+{
+	setCommentPrefix(target.getCommentPrefix());
+	setOutputLanguage(target.getOutputLanguage());
+}
+
+void RecordingOutputManager::newLine()
+{
+	record(OutputToken::Kind::NewLine);
+	_target.newLine();
+}
+
+void RecordingOutputManager::space(const std::string& space)
+{
+	record(OutputToken::Kind::Space, space);
+	_target.space(space);
+}
+
+void RecordingOutputManager::punctuation(char p)
+{
+	record(OutputToken::Kind::Punctuation, std::string(1, p));
+	_target.punctuation(p);
+}
+
+void RecordingOutputManager::operatorX(const std::string& op)
+{
+	record(OutputToken::Kind::Operator, op);
+	_target.operatorX(op);
+}
+
+void RecordingOutputManager::globalVariableId(const std::string& id)
+{
+	record(OutputToken::Kind::GlobalVariableId, id);
+	_target.globalVariableId(id);
+}
+
+void RecordingOutputManager::localVariableId(const std::string& id)
+{
+	record(OutputToken::Kind::LocalVariableId, id);
+	_target.localVariableId(id);
+}
+
+void RecordingOutputManager::memberId(const std::string& id)
+{
+	record(OutputToken::Kind::MemberId, id);
+	_target.memberId(id);
+}
+
+void RecordingOutputManager::labelId(const std::string& id)
+{
+	record(OutputToken::Kind::LabelId, id);
+	_target.labelId(id);
+}
+
+void RecordingOutputManager::functionId(const std::string& id)
+{
+	record(OutputToken::Kind::FunctionId, id);
+	_target.functionId(id);
+}
+
+void RecordingOutputManager::parameterId(const std::string& id)
+{
+	record(OutputToken::Kind::ParameterId, id);
+	_target.parameterId(id);
+}
+
+void RecordingOutputManager::keyword(const std::string& k)
+{
+	record(OutputToken::Kind::Keyword, k);
+	_target.keyword(k);
+}
+
+void RecordingOutputManager::dataType(const std::string& t)
+{
+	record(OutputToken::Kind::DataType, t);
+	_target.dataType(t);
+}
+
+void RecordingOutputManager::preprocessor(const std::string& p)
+{
+	record(OutputToken::Kind::Preprocessor, p);
+	_target.preprocessor(p);
+}
+
+void RecordingOutputManager::include(const std::string& i)
+{
+	record(OutputToken::Kind::Include, i);
+	_target.include(i);
+}
+
+void RecordingOutputManager::constantBool(const std::string& c)
+{
+	record(OutputToken::Kind::ConstantBool, c);
+	_target.constantBool(c);
+}
+
+void RecordingOutputManager::constantInt(const std::string& c)
+{
+	record(OutputToken::Kind::ConstantInt, c);
+	_target.constantInt(c);
+}
+
+void RecordingOutputManager::constantFloat(const std::string& c)
+{
+	record(OutputToken::Kind::ConstantFloat, c);
+	_target.constantFloat(c);
+}
+
+void RecordingOutputManager::constantString(const std::string& c)
+{
+	record(OutputToken::Kind::ConstantString, c);
+	_target.constantString(c);
+}
+
+void RecordingOutputManager::constantSymbol(const std::string& c)
+{
+	record(OutputToken::Kind::ConstantSymbol, c);
+	_target.constantSymbol(c);
+}
+
+void RecordingOutputManager::constantPointer(const std::string& c)
+{
+	record(OutputToken::Kind::ConstantPointer, c);
+	_target.constantPointer(c);
+}
+
+void RecordingOutputManager::comment(const std::string& comment)
+{
+	record(OutputToken::Kind::Comment, comment);
+	_target.comment(comment);
+}
+
+void RecordingOutputManager::commentModifier()
+{
+	record(OutputToken::Kind::CommentModifier);
+	_target.commentModifier();
+}
+
+void RecordingOutputManager::addressPush(Address a)
+{
+	record(
+		OutputToken::Kind::AddressPush,
+		a.isDefined() ? std::to_string(a.getValue()) : ""
+	);
+	_target.addressPush(a);
+}
+
+void RecordingOutputManager::addressPop()
+{
+	record(OutputToken::Kind::AddressPop);
+	_target.addressPop();
+}
+
+/**
+* @brief Returns all the tokens recorded so far.
+*/
+const OutputTokens& RecordingOutputManager::getTokens() const
+{
+	return _tokens;
+}
+
+/**
+* @brief Passes the given recorded token to @a out.
+*/
+void RecordingOutputManager::replay(const OutputToken& token, OutputManager& out)
+{
+	const auto& v = token.value;
+	switch (token.kind)
+	{
+		case OutputToken::Kind::NewLine: out.newLine(); break;
+		case OutputToken::Kind::Space: out.space(v); break;
+		case OutputToken::Kind::Punctuation: out.punctuation(v.empty() ? ' ' : v[0]); break;
+		case OutputToken::Kind::Operator: out.operatorX(v); break;
+		case OutputToken::Kind::GlobalVariableId: out.globalVariableId(v); break;
+		case OutputToken::Kind::LocalVariableId: out.localVariableId(v); break;
+		case OutputToken::Kind::MemberId: out.memberId(v); break;
+		case OutputToken::Kind::LabelId: out.labelId(v); break;
+		case OutputToken::Kind::FunctionId: out.functionId(v); break;
+		case OutputToken::Kind::ParameterId: out.parameterId(v); break;
+		case OutputToken::Kind::Keyword: out.keyword(v); break;
+		case OutputToken::Kind::DataType: out.dataType(v); break;
+		case OutputToken::Kind::Preprocessor: out.preprocessor(v); break;
+		case OutputToken::Kind::Include: out.include(v); break;
+		case OutputToken::Kind::ConstantBool: out.constantBool(v); break;
+		case OutputToken::Kind::ConstantInt: out.constantInt(v); break;
+		case OutputToken::Kind::ConstantFloat: out.constantFloat(v); break;
+		case OutputToken::Kind::ConstantString: out.constantString(v); break;
+		case OutputToken::Kind::ConstantSymbol: out.constantSymbol(v); break;
+		case OutputToken::Kind::ConstantPointer: out.constantPointer(v); break;
+		case OutputToken::Kind::Comment: out.comment(v); break;
+		case OutputToken::Kind::CommentModifier: out.commentModifier(); break;
+		case OutputToken::Kind::AddressPush:
+			out.addressPush(v.empty()
+				? Address()
+				: Address(static_cast<std::uint64_t>(std::stoull(v))));
+			break;
+		case OutputToken::Kind::AddressPop: out.addressPop(); break;
+		default:
+			FAIL("unknown kind of recorded token");
+			break;
+	}
+}
+
+/**
+* @brief Passes all the given recorded tokens to @a out.
+*/
+void RecordingOutputManager::replay(const OutputTokens& tokens, OutputManager& out)
+{
+	for (const auto& token : tokens)
+	{
+		replay(token, out);
+	}
+}
+
+void RecordingOutputManager::record(OutputToken::Kind kind, const std::string& value)
+{
+	_tokens.push_back(OutputToken{kind, value});
+}
+
+} // namespace llvmir2hll
+} // namespace retdec
@@ -511,6 +511,26 @@ bool Module::hasInstructionIdiomFuncs() const {
 	);
 }
 
+/**
+* @brief Excludes the given function from optimizations.
+*
+* The body of the function is still visible to analyses (e.g. to the alias
+* analysis or to obtainers of information about calls), but optimizers do not
+* change it.
+*/
+void Module::excludeFuncFromOptimizations(ShPtr<Function> func) {
+	funcsExcludedFromOptimizations.insert(func);
+}
+
+/**
+* @brief Has the given function been excluded from optimizations?
+*
+* See excludeFuncFromOptimizations() for more details.
+*/
+bool Module::isFuncExcludedFromOptimizations(ShPtr<Function> func) const {
+	return hasItem(funcsExcludedFromOptimizations, func);
+}
+
 /**
 * @brief Returns all syscall functions in the module.
 */
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <fstream>
 #include <memory>
+#include <sstream>
 
 #include "retdec/llvmir2hll/llvmir2hll.h"
 #include "retdec/utils/io/log.h"
@@ -190,6 +191,12 @@ bool LlvmIr2Hll::runOnModule(llvm::Module &m)
 		obtainDebugInfo();
 	}
 
+	if (canUseFuncOutputCache())
+	{
+		Log::phase("looking up functions in the cache");
+		lookUpCachedFuncs();
+	}
+
 	if (!globalConfig->parameters.isBackendNoOpts())
 	{
 		Log::phase("alias analysis [" + aliasAnalysis->getId() + "]");
@@ -199,6 +206,12 @@ bool LlvmIr2Hll::runOnModule(llvm::Module &m)
 		runOptimizations();
 	}
 
+	if (funcOutputCache)
+	{
+		Log::phase("restoring symbols of functions found in the cache");
+		restoreCachedFuncs();
+	}
+
 	if (!globalConfig->parameters.isBackendNoVarRenaming())
 	{
 		Log::phase("variable renaming [" + varRenamer->getId() + "]");
@@ -582,6 +595,31 @@ void LlvmIr2Hll::obtainDebugInfo()
 	llvmir2hll::LLVMDebugInfoObtainer::obtainVarNames(resModule);
 }
 
+/**
+* @brief Looks up function definitions in the cache of the emitted output.
+*
+* Functions that are found are excluded from the optimizations, and the HLL
+* writer emits their cached output instead of them.
+*/
+void LlvmIr2Hll::lookUpCachedFuncs()
+{
+	funcOutputCache = std::make_shared<llvmir2hll::FuncOutputCache>(
+			globalConfig->parameters.getBackendFuncCacheDir(),
+			globalConfig->parameters.getBackendFuncCacheMaxSize(),
+			getFuncOutputCacheContext()
+	);
+	funcOutputCache->lookUp(resModule);
+	funcOutputCache->excludeCachedFuncs(resModule);
+	hllWriter->setFuncOutputCache(funcOutputCache);
+
+	const auto &stats = funcOutputCache->getStatistics();
+	Log::phase(
+		"found " + std::to_string(stats.hits) + " of "
+		+ std::to_string(stats.hits + stats.misses) + " cacheable functions",
+		Log::SubPhase
+	);
+}
+
 /**
 * @brief Initializes the alias analysis.
 */
@@ -610,6 +648,15 @@ void LlvmIr2Hll::runOptimizations()
 	optManager->optimize(resModule);
 }
 
+/**
+* @brief Restores global variables and functions referenced from the cached
+*        output that were removed by the optimizations.
+*/
+void LlvmIr2Hll::restoreCachedFuncs()
+{
+	funcOutputCache->restoreCachedSymbols(resModule);
+}
+
 /**
 * @brief Renames variables in the resulting module by using the selected
 *        variable renamer.
@@ -688,6 +735,25 @@ void LlvmIr2Hll::finalize()
 {
 	saveConfig();
 	if (outFile) outFile->keep();
+
+	if (funcOutputCache)
+	{
+		funcOutputCache->evict();
+
+		const auto &stats = funcOutputCache->getStatistics();
+		Log::phase(
+			"function output cache: "
+			+ std::to_string(stats.hits) + " hits, "
+			+ std::to_string(stats.misses) + " misses, "
+			+ std::to_string(stats.uncacheable) + " uncacheable, "
+			+ std::to_string(stats.stores) + " stored, "
+			+ std::to_string(stats.evictions) + " evicted, "
+			+ std::to_string(stats.bytesRead) + " B read, "
+			+ std::to_string(stats.bytesWritten) + " B written, "
+			+ std::to_string(stats.size) + " B total",
+			Log::SubPhase
+		);
+	}
 }
 
 /**
@@ -854,6 +920,55 @@ std::string LlvmIr2Hll::getTypeOfRunOptimizations() const
 			: "normal";
 }
 
+/**
+* @brief Can the cache of the emitted output of functions be used?
+*
+* The cache is not used when the output of a function depends on other
+* functions in a way that is not reflected in the key of the cache (aggressive
+* optimizations, names from debug information), or when functions have to be
+* processed also for other purposes than emission (CFGs, call graphs).
+*/
+bool LlvmIr2Hll::canUseFuncOutputCache() const
+{
+	const auto &params = globalConfig->parameters;
+	return !params.getBackendFuncCacheDir().empty()
+			&& !params.isBackendAggressiveOpts()
+			&& !params.isBackendEmitCfg()
+			&& !params.isBackendEmitCg()
+			&& !resModule->isDebugInfoAvailable();
+}
+
+/**
+* @brief Returns a description of everything besides the functions themselves
+*        that affects the emitted output (used in keys of the cache).
+*/
+std::string LlvmIr2Hll::getFuncOutputCacheContext() const
+{
+	const auto &params = globalConfig->parameters;
+	const auto &arch = globalConfig->architecture;
+	std::ostringstream context;
+	context << "version: " << RETDEC_VERSION << "\n"
+		<< "arch: " << arch.getName() << " " << arch.getBitSize()
+			<< (arch.isEndianBig() ? " big" : " little") << "\n"
+		<< "data layout: " << llvmModule->getDataLayoutStr() << "\n"
+		<< "hll: " << TargetHLL << " " << params.getOutputFormat() << "\n"
+		<< "semantics: " << oSemantics << " " << StrictFPUSemantics << "\n"
+		<< "evaluator: " << oArithmExprEvaluator << "\n"
+		<< "alias analysis: " << oAliasAnalysis << "\n"
+		<< "call info obtainer: " << params.getBackendCallInfoObtainer() << "\n"
+		<< "var renamer: " << params.getBackendVarRenamer() << " "
+			<< params.isBackendNoVarRenaming() << " "
+			<< oVarNameGen << " " << VarNameGenPrefix << "\n"
+		<< "opts: " << params.isBackendNoOpts() << " "
+			<< params.getBackendEnabledOpts() << " "
+			<< params.getBackendDisabledOpts() << "\n"
+		<< "writer: " << EmitDebugComments << " "
+			<< params.isBackendKeepAllBrackets() << " "
+			<< params.isBackendNoCompoundOperators() << " "
+			<< params.isBackendNoSymbolicNames() << "\n";
+	return context.str();
+}
+
 /**
 * @brief Returns the IDs of pattern finders to be run.
 */
@@ -47,6 +47,10 @@ void AggressiveGlobalToLocalOptimizer::convertGlobalVarsToLocalVars() {
 	// For each function...
 	for (auto i = module->func_definition_begin(),
 			e = module->func_definition_end(); i != e; ++i) {
+		if (module->isFuncExcludedFromOptimizations(*i)) {
+			continue;
+		}
+
 		// For each global variable...
 		for (const auto &var : globalVars) {
 			// Skip global variables which have an assigned name from debug
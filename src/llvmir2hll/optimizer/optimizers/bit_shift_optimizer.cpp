@@ -106,7 +106,9 @@ void BitShiftOptimizer::doOptimization() {
 	// Visit all functions.
 	for (auto i = module->func_definition_begin(),
 			e = module->func_definition_end(); i != e; ++i) {
-		(*i)->accept(this);
+		if (!module->isFuncExcludedFromOptimizations(*i)) {
+			(*i)->accept(this);
+		}
 	}
 }
 
@@ -44,7 +44,9 @@ void DerefToArrayIndexOptimizer::doOptimization() {
 	// Visit all functions.
 	for (auto i = module->func_definition_begin(),
 			e = module->func_definition_end(); i != e; ++i) {
-		(*i)->accept(this);
+		if (!module->isFuncExcludedFromOptimizations(*i)) {
+			(*i)->accept(this);
+		}
 	}
 }
 
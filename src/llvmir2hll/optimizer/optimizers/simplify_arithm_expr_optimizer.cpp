@@ -70,6 +70,10 @@ void SimplifyArithmExprOptimizer::doOptimization() {
 	// Visit all functions.
 	for (auto i = module->func_definition_begin(),
 			e = module->func_definition_end(); i != e; ++i) {
+		if (module->isFuncExcludedFromOptimizations(*i)) {
+			continue;
+		}
+
 		// Keep optimizing until there are no changes.
 		do {
 			codeChanged = false;
@@ -0,0 +1,909 @@
+/**
+* @file src/llvmir2hll/support/func_output_cache.cpp
+* @brief Implementation of FuncOutputCache.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <set>
+#include <unordered_map>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "retdec/llvmir2hll/hll/output_manager.h"
+#include "retdec/llvmir2hll/ir/function.h"
+#include "retdec/llvmir2hll/ir/module.h"
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/llvmir2hll/support/func_output_cache.h"
+#include "retdec/utils/container.h"
+#include "retdec/utils/filesystem.h"
+
+using retdec::utils::addToSet;
+using retdec::utils::hasItem;
+
+namespace retdec {
+namespace llvmir2hll {
+
+namespace {
+
+/// Magic string at the beginning of every cached entry. Increase the number
+/// whenever the format of entries or the way of computing keys changes.
+const std::string ENTRY_MAGIC = "retdec-func-output-cache 2";
+
+/// Maximal length of a token in an entry. Longer tokens mean that the entry
+/// is corrupted.
+const std::size_t MAX_TOKEN_LENGTH = 16 * 1024 * 1024;
+
+/**
+* @brief Can the given character be a part of an LLVM IR identifier?
+*/
+bool isIdentChar(char c) {
+	return std::isalnum(static_cast<unsigned char>(c))
+		|| c == '-' || c == '$' || c == '.' || c == '_';
+}
+
+/**
+* @brief Can the given character precede a decimal number that is not a part
+*        of an identifier?
+*/
+bool canPrecedeNumber(char c) {
+	return !isIdentChar(c) && c != '%' && c != '@' && c != '!' && c != '#';
+}
+
+/**
+* @brief Replaces addresses from <tt>[start, end]</tt> in @a text.
+*
+* Recognized are hexadecimal numbers prefixed with @c 0x or @c _ (e.g.
+* @c 0x401000 or @c dec_label_pc_401000) and, unless @a onlyHex is @c true,
+* decimal numbers that are not a part of an identifier. Every recognized
+* address is replaced with the result of <tt>replace(offset, isHex,
+* isUpper)</tt>, where @c offset is the offset of the address from @a start.
+* Prefixes are kept.
+*/
+template<typename Replacer>
+std::string replaceAddresses(const std::string &text, std::uint64_t start,
+		std::uint64_t end, bool onlyHex, Replacer replace) {
+	std::string result;
+	result.reserve(text.size());
+
+	auto parse = [&](std::size_t from, bool hex, std::size_t &to,
+			std::uint64_t &value, bool &upper) {
+		value = 0;
+		upper = false;
+		to = from;
+		while (to < text.size()) {
+			char c = text[to];
+			unsigned digit;
+			if (c >= '0' && c <= '9') {
+				digit = c - '0';
+			} else if (hex && c >= 'a' && c <= 'f') {
+				digit = c - 'a' + 10;
+			} else if (hex && c >= 'A' && c <= 'F') {
+				digit = c - 'A' + 10;
+				upper = true;
+			} else {
+				break;
+			}
+			if (to - from >= (hex ? 16 : 19)) {
+				// Too long to be an address.
+				return false;
+			}
+			value = value * (hex ? 16 : 10) + digit;
+			++to;
+		}
+		if (to == from) {
+			return false;
+		}
+		// The number has to be followed by something else than an
+		// identifier.
+		return to == text.size() || !std::isalnum(
+			static_cast<unsigned char>(text[to]));
+	};
+
+	std::size_t i = 0;
+	while (i < text.size()) {
+		char c = text[i];
+		char prev = i > 0 ? text[i - 1] : ' ';
+		std::size_t to = 0;
+		std::uint64_t value = 0;
+		bool upper = false;
+
+		if (c == '0' && i + 1 < text.size()
+				&& (text[i + 1] == 'x' || text[i + 1] == 'X')
+				&& canPrecedeNumber(prev)
+				&& parse(i + 2, true, to, value, upper)
+				&& value >= start && value <= end) {
+			result += text.substr(i, 2);
+			result += replace(value - start, true, upper);
+			i = to;
+		} else if (c == '_'
+				&& parse(i + 1, true, to, value, upper)
+				&& value >= start && value <= end) {
+			result += '_';
+			result += replace(value - start, true, upper);
+			i = to;
+		} else if (!onlyHex && std::isdigit(static_cast<unsigned char>(c))
+				&& canPrecedeNumber(prev)
+				&& parse(i, false, to, value, upper)
+				&& value >= start && value <= end) {
+			result += replace(value - start, false, false);
+			i = to;
+		} else {
+			result += c;
+			++i;
+		}
+	}
+	return result;
+}
+
+/**
+* @brief Relocates addresses from <tt>[oldStart, oldEnd]</tt> in @a text so
+*        they are relative to @a newStart.
+*
+* See replaceAddresses() for the description of @a onlyHex.
+*/
+std::string relocateAddresses(const std::string &text, std::uint64_t oldStart,
+		std::uint64_t oldEnd, std::uint64_t newStart, bool onlyHex) {
+	if (oldStart == newStart) {
+		return text;
+	}
+
+	return replaceAddresses(text, oldStart, oldEnd, onlyHex,
+		[newStart](std::uint64_t offset, bool isHex, bool isUpper) {
+			std::string str;
+			llvm::raw_string_ostream os(str);
+			if (isHex) {
+				os << llvm::format_hex_no_prefix(newStart + offset, 1, isUpper);
+			} else {
+				os << newStart + offset;
+			}
+			return os.str();
+		}
+	);
+}
+
+/**
+* @brief Can a token of the given kind contain addresses from the function?
+*
+* Other tokens (e.g. string literals or names of variables) are replayed
+* untouched even if they contain numbers that look like addresses.
+*/
+bool canContainAddress(OutputToken::Kind kind) {
+	switch (kind) {
+		case OutputToken::Kind::LabelId:
+		case OutputToken::Kind::ConstantInt:
+		case OutputToken::Kind::ConstantPointer:
+		case OutputToken::Kind::Comment:
+		case OutputToken::Kind::AddressPush:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+* @brief Normalizes the textual representation of LLVM IR.
+*
+* Comments, metadata and references to attribute groups are removed. Names of
+* global objects for which @a isSymbol returns @c true are replaced with their
+* index in @a symbolNames (new names are appended). Addresses from
+* <tt>[start, end]</tt> are replaced with their offsets from @a start.
+*/
+std::string normalizeIR(const std::string &text, std::uint64_t start,
+		std::uint64_t end,
+		const std::function<bool (const std::string &)> &isSymbol,
+		StringVector &symbolNames) {
+	std::string result;
+	result.reserve(text.size());
+
+	std::size_t i = 0;
+	while (i < text.size()) {
+		char c = text[i];
+		if (c == '"') {
+			// String literal.
+			std::size_t j = i + 1;
+			while (j < text.size() && text[j] != '"') {
+				++j;
+			}
+			result += text.substr(i, j + 1 - i);
+			i = j + 1;
+		} else if (c == ';') {
+			// Comment.
+			while (i < text.size() && text[i] != '\n') {
+				++i;
+			}
+		} else if (c == '!' || c == '#') {
+			// Metadata or a reference to an attribute group.
+			++i;
+			while (i < text.size() && isIdentChar(text[i])) {
+				++i;
+			}
+		} else if (c == '@') {
+			// Global object.
+			std::string name;
+			std::size_t j = i + 1;
+			if (j < text.size() && text[j] == '"') {
+				++j;
+				while (j < text.size() && text[j] != '"') {
+					name += text[j++];
+				}
+				++j;
+			} else {
+				while (j < text.size() && isIdentChar(text[j])) {
+					name += text[j++];
+				}
+			}
+			if (isSymbol(name)) {
+				auto it = std::find(symbolNames.begin(), symbolNames.end(), name);
+				result += "@$" + std::to_string(it - symbolNames.begin());
+				if (it == symbolNames.end()) {
+					symbolNames.push_back(name);
+				}
+			} else {
+				result += text.substr(i, j - i);
+			}
+			i = j;
+		} else {
+			result += c;
+			++i;
+		}
+	}
+
+	return replaceAddresses(result, start, end, false,
+		[](std::uint64_t offset, bool, bool) {
+			return "$+" + std::to_string(offset);
+		}
+	);
+}
+
+/**
+* @brief Does the given type contain a structure without a name?
+*
+* Names of such structures are generated by writers during emission, so they
+* may differ between runs.
+*/
+bool containsUnnamedStruct(llvm::Type *type, std::set<llvm::Type *> &visited) {
+	if (!visited.insert(type).second) {
+		return false;
+	}
+
+	if (auto structType = llvm::dyn_cast<llvm::StructType>(type)) {
+		if (structType->isLiteral() || !structType->hasName()) {
+			return true;
+		}
+	}
+
+	for (auto subtype : type->subtypes()) {
+		if (containsUnnamedStruct(subtype, visited)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+* @brief Does the given function use a structure without a name?
+*/
+bool usesUnnamedStruct(const llvm::Function &func) {
+	std::set<llvm::Type *> visited;
+	if (containsUnnamedStruct(func.getFunctionType(), visited)) {
+		return true;
+	}
+
+	for (const auto &bb : func) {
+		for (const auto &inst : bb) {
+			if (containsUnnamedStruct(inst.getType(), visited)) {
+				return true;
+			}
+			for (const auto &op : inst.operands()) {
+				if (containsUnnamedStruct(op->getType(), visited)) {
+					return true;
+				}
+			}
+			if (auto alloca = llvm::dyn_cast<llvm::AllocaInst>(&inst)) {
+				if (containsUnnamedStruct(alloca->getAllocatedType(), visited)) {
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+/**
+* @brief Returns the lowercase hexadecimal SHA-1 hash of the given data.
+*/
+std::string computeHash(const std::string &data) {
+	auto hash = llvm::SHA1::hash(llvm::ArrayRef<std::uint8_t>(
+		reinterpret_cast<const std::uint8_t *>(data.data()), data.size()));
+
+	static const char digits[] = "0123456789abcdef";
+	std::string result;
+	for (auto byte : hash) {
+		result += digits[byte >> 4];
+		result += digits[byte & 0xf];
+	}
+	return result;
+}
+
+/**
+* @brief Returns functions from @a funcs that are referenced from @a func (e.g.
+*        called by it).
+*/
+std::vector<const llvm::Function *> getReferencedFuncs(
+		const llvm::Function &func,
+		const std::map<const llvm::Function *, std::string> &funcs) {
+	std::set<const llvm::Function *> result;
+	for (const auto &bb : func) {
+		for (const auto &inst : bb) {
+			for (const auto &op : inst.operands()) {
+				auto referenced = llvm::dyn_cast<llvm::Function>(
+					op->stripPointerCasts());
+				if (referenced && funcs.count(referenced)) {
+					result.insert(referenced);
+				}
+			}
+		}
+	}
+	return {result.begin(), result.end()};
+}
+
+/**
+* @brief Computes keys of strongly connected components of the graph of
+*        references between functions by Tarjan's algorithm.
+*
+* Components are finished in the reverse topological order, so keys of all
+* the components referenced from a component are known when its key is
+* computed.
+*/
+class CalleeKeysComputer {
+public:
+	explicit CalleeKeysComputer(
+			const std::map<const llvm::Function *, std::string> &ownKeys):
+		ownKeys(ownKeys) {}
+
+	std::map<const llvm::Function *, std::string> compute() {
+		for (const auto &p : ownKeys) {
+			if (!indexes.count(p.first)) {
+				visit(p.first);
+			}
+		}
+		return keys;
+	}
+
+private:
+	void visit(const llvm::Function *func) {
+		std::size_t index = indexes.size();
+		indexes[func] = index;
+		lowLinks[func] = index;
+		stack.push_back(func);
+		onStack.insert(func);
+
+		for (auto callee : getReferencedFuncs(*func, ownKeys)) {
+			if (!indexes.count(callee)) {
+				visit(callee);
+				lowLinks[func] = std::min(lowLinks[func], lowLinks[callee]);
+			} else if (onStack.count(callee)) {
+				lowLinks[func] = std::min(lowLinks[func], indexes[callee]);
+			}
+		}
+
+		if (lowLinks[func] != index) {
+			return;
+		}
+
+		// The function is the root of a component.
+		std::vector<const llvm::Function *> component;
+		do {
+			component.push_back(stack.back());
+			onStack.erase(stack.back());
+			stack.pop_back();
+		} while (component.back() != func);
+
+		std::set<std::string> memberKeys;
+		std::set<std::string> calleeKeys;
+		for (auto member : component) {
+			memberKeys.insert(ownKeys.at(member));
+			for (auto callee : getReferencedFuncs(*member, ownKeys)) {
+				// Members of the component do not have their key yet.
+				auto it = keys.find(callee);
+				if (it != keys.end()) {
+					calleeKeys.insert(it->second);
+				}
+			}
+		}
+
+		std::string data;
+		for (const auto &key : memberKeys) {
+			data += key + '\n';
+		}
+		data += '\n';
+		for (const auto &key : calleeKeys) {
+			data += key + '\n';
+		}
+		std::string key(computeHash(data));
+		for (auto member : component) {
+			keys[member] = key;
+		}
+	}
+
+private:
+	const std::map<const llvm::Function *, std::string> &ownKeys;
+	std::map<const llvm::Function *, std::string> keys;
+	std::map<const llvm::Function *, std::size_t> indexes;
+	std::map<const llvm::Function *, std::size_t> lowLinks;
+	std::vector<const llvm::Function *> stack;
+	std::set<const llvm::Function *> onStack;
+};
+
+} // anonymous namespace
+
+/**
+* @brief Constructs a new cache.
+*
+* @param[in] dir Directory with the cached entries. It is created when the
+*                first entry is stored.
+* @param[in] maxSize Maximal size of the cache in bytes. If it is @c 0, the
+*                    size is not limited.
+* @param[in] context Description of everything that affects the emitted output
+*                    besides the function itself (decompiler version,
+*                    architecture, target HLL, parameters of the back-end).
+*/
+FuncOutputCache::FuncOutputCache(const std::string &dir,
+		std::uintmax_t maxSize, const std::string &context):
+	dir(dir), maxSize(maxSize), context(context) {}
+
+/**
+* @brief Computes keys of all function definitions in @a module and looks
+*        them up in the cache.
+*
+* Functions that are not found are remembered so that their output is stored
+* by storeOutput() after emission.
+*/
+void FuncOutputCache::lookUp(ShPtr<Module> module) {
+	const llvm::Module *llvmModule = module->getLLVMModule();
+
+	// Linked functions, syscalls, and idioms are emitted in a special way, so
+	// do not cache them.
+	FuncSet specialFuncs(module->getStaticallyLinkedFuncs());
+	addToSet(module->getDynamicallyLinkedFuncs(), specialFuncs);
+	addToSet(module->getSyscallFuncs(), specialFuncs);
+	addToSet(module->getInstructionIdiomFuncs(), specialFuncs);
+
+	auto isSymbol = [&module](const std::string &name) {
+		if (module->getGlobalVarByName(name)) {
+			return true;
+		}
+		// Names of declarations are kept in the key because, unlike names
+		// of definitions, they identify the function.
+		ShPtr<Function> func(module->getFuncByName(name));
+		return func && func->isDefinition();
+	};
+
+	// Keys of all definitions computed only from the functions themselves.
+	std::map<const llvm::Function *, std::string> ownKeys;
+	std::map<ShPtr<Function>, const llvm::Function *> cacheableFuncs;
+	for (auto i = module->func_definition_begin(),
+			e = module->func_definition_end(); i != e; ++i) {
+		ShPtr<Function> func(*i);
+		const llvm::Function *llvmFunc = llvmModule
+			? llvmModule->getFunction(func->getInitialName())
+			: nullptr;
+		if (!llvmFunc || llvmFunc->isDeclaration()) {
+			++stats.uncacheable;
+			continue;
+		}
+
+		bool hasAddresses = func->getStartAddress().isDefined()
+			&& func->getEndAddress().isDefined();
+		StringVector symbolNames;
+		ownKeys[llvmFunc] = computeKey(*llvmFunc,
+			hasAddresses ? func->getStartAddress().getValue() : 0,
+			hasAddresses ? func->getEndAddress().getValue() : 0,
+			context, isSymbol, symbolNames);
+		if (!hasAddresses || hasItem(specialFuncs, func)
+				|| usesUnnamedStruct(*llvmFunc)) {
+			++stats.uncacheable;
+			continue;
+		}
+
+		CachedFunc cachedFunc;
+		for (const auto &name : symbolNames) {
+			Symbol symbol;
+			if ((symbol.var = module->getGlobalVarByName(name))) {
+				symbol.varInit = module->getInitForGlobalVar(symbol.var);
+			} else {
+				symbol.func = module->getFuncByName(name);
+			}
+			cachedFunc.symbols.push_back(symbol);
+		}
+		funcs.emplace(func, std::move(cachedFunc));
+		cacheableFuncs.emplace(func, llvmFunc);
+	}
+
+	// The output of a function depends also on what the functions it calls
+	// do (e.g. which variables they modify), so include them in its key.
+	auto calleeKeys = computeCalleeKeys(ownKeys);
+	for (auto &p : funcs) {
+		ShPtr<Function> func(p.first);
+		CachedFunc &cachedFunc(p.second);
+		const llvm::Function *llvmFunc = cacheableFuncs.at(func);
+		cachedFunc.key = computeHash(ownKeys.at(llvmFunc) + '\n'
+			+ calleeKeys.at(llvmFunc));
+
+		cachedFunc.hit = load(cachedFunc.key, cachedFunc.entry);
+		if (cachedFunc.hit) {
+			// Make sure that the entry is consistent with the function.
+			auto size = func->getEndAddress().getValue()
+				- func->getStartAddress().getValue();
+			cachedFunc.hit = cachedFunc.entry.endAddress
+				- cachedFunc.entry.startAddress == size;
+			for (const auto &token : cachedFunc.entry.tokens) {
+				if (token.symbol != OutputToken::NO_SYMBOL
+						&& token.symbol >= cachedFunc.symbols.size()) {
+					cachedFunc.hit = false;
+				}
+			}
+		}
+		++(cachedFunc.hit ? stats.hits : stats.misses);
+	}
+}
+
+/**
+* @brief Excludes functions found in the cache from optimizations of
+*        @a module.
+*
+* Their bodies stay in the module, so analyses used by the optimizations of
+* other functions (e.g. the alias analysis or obtainers of information about
+* calls) still see what the cached functions do.
+*/
+void FuncOutputCache::excludeCachedFuncs(ShPtr<Module> module) {
+	for (const auto &p : funcs) {
+		if (p.second.hit) {
+			module->excludeFuncFromOptimizations(p.first);
+		}
+	}
+}
+
+/**
+* @brief Puts back global variables and functions referenced from the cached
+*        output that were removed from @a module by optimizations (e.g.
+*        because they seemed to be unused or were converted into local
+*        variables of other functions).
+*/
+void FuncOutputCache::restoreCachedSymbols(ShPtr<Module> module) {
+	for (const auto &p : funcs) {
+		if (!p.second.hit) {
+			continue;
+		}
+
+		for (const auto &symbol : p.second.symbols) {
+			if (symbol.var && !module->isGlobalVar(symbol.var)) {
+				module->addGlobalVar(symbol.var, symbol.varInit);
+			} else if (symbol.func && !module->funcExists(symbol.func)) {
+				module->addFunc(symbol.func);
+			}
+		}
+	}
+}
+
+/**
+* @brief Has the output of the given function been found in the cache?
+*/
+bool FuncOutputCache::hasCachedOutput(ShPtr<Function> func) const {
+	auto it = funcs.find(func);
+	return it != funcs.end() && it->second.hit;
+}
+
+/**
+* @brief Should the output of the given function be stored into the cache?
+*/
+bool FuncOutputCache::isCacheable(ShPtr<Function> func) const {
+	auto it = funcs.find(func);
+	return it != funcs.end() && !it->second.hit;
+}
+
+/**
+* @brief Emits the cached output of the given function into @a out.
+*
+* @par Preconditions
+*  - hasCachedOutput(@a func) is @c true
+*/
+void FuncOutputCache::emitCachedOutput(ShPtr<Function> func,
+		OutputManager &out) const {
+	const CachedFunc &cachedFunc(funcs.at(func));
+	const Entry &entry(cachedFunc.entry);
+	std::uint64_t start = func->getStartAddress().getValue();
+
+	for (OutputToken token : entry.tokens) {
+		if (token.symbol != OutputToken::NO_SYMBOL) {
+			token.value = getSymbolName(cachedFunc.symbols[token.symbol]);
+		} else if (canContainAddress(token.kind)) {
+			// Comments can contain arbitrary text, so only hexadecimal
+			// addresses emitted by writers (e.g. 0x401000) are relocated in
+			// them.
+			token.value = relocateAddresses(token.value, entry.startAddress,
+				entry.endAddress, start,
+				token.kind == OutputToken::Kind::Comment);
+		}
+		RecordingOutputManager::replay(token, out);
+	}
+}
+
+/**
+* @brief Stores the emitted output of the given function into the cache.
+*
+* Tokens that are names of the referenced global variables and functions are
+* stored as references to symbols so they can be renamed when replayed.
+*
+* Does nothing if the function is not cacheable.
+*/
+void FuncOutputCache::storeOutput(ShPtr<Function> func,
+		const OutputTokens &tokens) {
+	auto it = funcs.find(func);
+	if (it == funcs.end() || it->second.hit) {
+		return;
+	}
+	const CachedFunc &cachedFunc(it->second);
+
+	std::unordered_map<std::string, std::size_t> symbolIndexes;
+	for (std::size_t i = 0; i < cachedFunc.symbols.size(); ++i) {
+		symbolIndexes.emplace(getSymbolName(cachedFunc.symbols[i]), i);
+	}
+
+	Entry entry;
+	entry.startAddress = func->getStartAddress().getValue();
+	entry.endAddress = func->getEndAddress().getValue();
+	entry.tokens = tokens;
+	for (auto &token : entry.tokens) {
+		if (token.kind != OutputToken::Kind::GlobalVariableId
+				&& token.kind != OutputToken::Kind::FunctionId) {
+			continue;
+		}
+		auto symbolIt = symbolIndexes.find(token.value);
+		if (symbolIt != symbolIndexes.end()) {
+			token.symbol = symbolIt->second;
+			token.value.clear();
+		}
+	}
+
+	if (save(cachedFunc.key, entry)) {
+		++stats.stores;
+	}
+}
+
+/**
+* @brief Loads the entry with the given key.
+*
+* @return @c true if the entry exists and is valid, @c false otherwise.
+*
+* The modification time of a loaded entry is updated so that evict() removes
+* least recently used entries first.
+*/
+bool FuncOutputCache::load(const std::string &key, Entry &entry) {
+	std::string path(getEntryPath(key));
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		return false;
+	}
+
+	std::string magic;
+	std::size_t count = 0;
+	if (!std::getline(in, magic) || magic != ENTRY_MAGIC
+			|| !(in >> entry.startAddress >> entry.endAddress >> count)) {
+		return false;
+	}
+
+	entry.tokens.clear();
+	for (std::size_t i = 0; i < count; ++i) {
+		int kind = 0;
+		std::size_t symbol = 0;
+		std::size_t length = 0;
+		if (!(in >> kind >> symbol >> length)
+				|| kind < 0
+				|| kind > static_cast<int>(OutputToken::Kind::AddressPop)
+				|| length > MAX_TOKEN_LENGTH
+				|| in.get() != '\n') {
+			return false;
+		}
+
+		OutputToken token{static_cast<OutputToken::Kind>(kind),
+			std::string(length, '\0'), symbol};
+		if (length > 0 && !in.read(&token.value[0], length)) {
+			return false;
+		}
+		entry.tokens.push_back(std::move(token));
+	}
+
+	std::error_code ec;
+	stats.bytesRead += fs::file_size(path, ec);
+	fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+	return true;
+}
+
+/**
+* @brief Saves the given entry under the given key.
+*
+* The entry is written into a temporary file which is then renamed, so
+* concurrently running decompilations never see partially written entries.
+*
+* @return @c true if the entry has been saved, @c false otherwise.
+*/
+bool FuncOutputCache::save(const std::string &key, const Entry &entry) {
+	fs::path path(getEntryPath(key));
+	std::error_code ec;
+	fs::create_directories(path.parent_path(), ec);
+	if (ec) {
+		return false;
+	}
+
+	fs::path tmpPath(path.string() + ".tmp" + std::to_string(
+		std::chrono::steady_clock::now().time_since_epoch().count()));
+	{
+		std::ofstream out(tmpPath.string(), std::ios::binary);
+		out << ENTRY_MAGIC << '\n'
+			<< entry.startAddress << ' ' << entry.endAddress << ' '
+			<< entry.tokens.size() << '\n';
+		for (const auto &token : entry.tokens) {
+			out << static_cast<int>(token.kind) << ' ' << token.symbol << ' '
+				<< token.value.size() << '\n' << token.value;
+		}
+		if (!out) {
+			out.close();
+			fs::remove(tmpPath, ec);
+			return false;
+		}
+	}
+
+	std::uintmax_t size = fs::file_size(tmpPath, ec);
+	fs::rename(tmpPath, path, ec);
+	if (ec) {
+		fs::remove(tmpPath, ec);
+		return false;
+	}
+	stats.bytesWritten += size;
+	return true;
+}
+
+/**
+* @brief Removes least recently used entries until the size of the cache is
+*        not greater than the maximal size.
+*/
+void FuncOutputCache::evict() {
+	struct File {
+		fs::path path;
+		fs::file_time_type time;
+		std::uintmax_t size;
+	};
+
+	std::error_code ec;
+	std::vector<File> files;
+	std::uintmax_t totalSize = 0;
+	for (fs::recursive_directory_iterator it(dir, ec), e; !ec && it != e;
+			it.increment(ec)) {
+		if (!it->is_regular_file(ec)) {
+			continue;
+		}
+		File file{it->path(), it->last_write_time(ec), it->file_size(ec)};
+		totalSize += file.size;
+		files.push_back(file);
+	}
+
+	if (maxSize != 0 && totalSize > maxSize) {
+		std::sort(files.begin(), files.end(),
+			[](const File &f1, const File &f2) { return f1.time < f2.time; });
+		for (const auto &file : files) {
+			if (totalSize <= maxSize) {
+				break;
+			}
+			if (fs::remove(file.path, ec)) {
+				totalSize -= file.size;
+				++stats.evictions;
+			}
+		}
+	}
+	stats.size = totalSize;
+}
+
+/**
+* @brief Returns statistics about the usage of the cache.
+*/
+const FuncOutputCache::Statistics &FuncOutputCache::getStatistics() const {
+	return stats;
+}
+
+/**
+* @brief Computes the key of the given function.
+*
+* @param[in] func Function.
+* @param[in] startAddress Start address of @a func.
+* @param[in] endAddress End address of @a func.
+* @param[in] context Description of everything else that affects the output.
+* @param[in] isSymbol Returns @c true for names of global objects that should
+*                     not be a part of the key.
+* @param[out] symbolNames Names of global objects referenced from @a func for
+*                         which @a isSymbol returned @c true, in the order of
+*                         their first occurrence.
+*/
+std::string FuncOutputCache::computeKey(const llvm::Function &func,
+		std::uint64_t startAddress, std::uint64_t endAddress,
+		const std::string &context,
+		const std::function<bool (const std::string &)> &isSymbol,
+		StringVector &symbolNames) {
+	std::string text;
+	llvm::raw_string_ostream os(text);
+	func.print(os);
+	os.flush();
+
+	std::string data(context);
+	data += '\n';
+	data += std::to_string(endAddress - startAddress);
+	data += '\n';
+	data += normalizeIR(text, startAddress, endAddress, isSymbol, symbolNames);
+
+	// Contents of constant global variables (e.g. strings) may be a part of
+	// the output, so include them as well. Their initializers may reference
+	// further symbols, which are appended to symbolNames.
+	const llvm::Module *module = func.getParent();
+	for (std::size_t i = 0; module && i < symbolNames.size(); ++i) {
+		auto var = module->getGlobalVariable(symbolNames[i], true);
+		if (!var || !var->isConstant() || !var->hasInitializer()) {
+			continue;
+		}
+
+		std::string init;
+		llvm::raw_string_ostream initOs(init);
+		var->getInitializer()->print(initOs);
+		initOs.flush();
+		data += "\n@$" + std::to_string(i) + " = ";
+		data += normalizeIR(init, startAddress, endAddress, isSymbol,
+			symbolNames);
+	}
+
+	return computeHash(data);
+}
+
+/**
+* @brief Computes keys that describe the functions called by the given
+*        functions.
+*
+* @param[in] ownKeys Keys of functions computed by computeKey().
+*
+* The returned key of a function changes whenever the key of any function
+* from @a ownKeys that it (transitively) calls or references changes,
+* including the function itself. Mutually recursive functions get the same key.
+*/
+std::map<const llvm::Function *, std::string>
+		FuncOutputCache::computeCalleeKeys(
+			const std::map<const llvm::Function *, std::string> &ownKeys) {
+	return CalleeKeysComputer(ownKeys).compute();
+}
+
+/**
+* @brief Returns the path to the file with the entry with the given key.
+*/
+std::string FuncOutputCache::getEntryPath(const std::string &key) const {
+	return (fs::path(dir) / key.substr(0, 2) / key).string();
+}
+
+/**
+* @brief Returns the current name of the given symbol.
+*/
+std::string FuncOutputCache::getSymbolName(const Symbol &symbol) const {
+	return symbol.var ? symbol.var->getName() : symbol.func->getName();
+}
+
+} // namespace llvmir2hll
+} // namespace retdec
@@ -0,0 +1,273 @@
+/**
+* @file src/llvmir2hll/support/var_bit_set.cpp
+* @brief Implementation of VarNumbering and VarBitSet.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/var_bit_set.h"
+
+namespace retdec {
+namespace llvmir2hll {
+
+const VarNumbering::Id VarNumbering::NO_ID = static_cast<VarNumbering::Id>(-1);
+
+/**
+* @brief Returns the ID of @a var.
+*
+* If @a var has not been numbered yet, it gets the first unused ID.
+*
+* @par Preconditions
+*  - @a var is non-null
+*/
+VarNumbering::Id VarNumbering::getId(const ShPtr<Variable> &var) {
+	PRECONDITION_NON_NULL(var);
+
+	auto result = ids.emplace(var.get(), vars.size());
+	if (result.second) {
+		vars.push_back(var);
+	}
+	return result.first->second;
+}
+
+/**
+* @brief Returns the ID of @a var, or @c NO_ID if @a var has not been numbered.
+*/
+VarNumbering::Id VarNumbering::findId(const ShPtr<Variable> &var) const {
+	auto i = ids.find(var.get());
+	return i != ids.end() ? i->second : NO_ID;
+}
+
+/**
+* @brief Returns @c true if @a var has been numbered, @c false otherwise.
+*/
+bool VarNumbering::hasId(const ShPtr<Variable> &var) const {
+	return ids.find(var.get()) != ids.end();
+}
+
+/**
+* @brief Returns the variable with the given ID.
+*
+* @par Preconditions
+*  - @a id has been assigned to a variable (i.e. <tt>id < size()</tt>)
+*/
+const ShPtr<Variable> &VarNumbering::getVar(Id id) const {
+	PRECONDITION(id < vars.size(), "invalid ID " << id);
+
+	return vars[id];
+}
+
+/**
+* @brief Returns the number of numbered variables.
+*/
+std::size_t VarNumbering::size() const {
+	return vars.size();
+}
+
+/**
+* @brief Forgets all the numbered variables.
+*/
+void VarNumbering::clear() {
+	ids.clear();
+	vars.clear();
+}
+
+/**
+* @brief Creates a bit set from @a vars.
+*
+* Variables from @a vars that have not been numbered yet are numbered.
+*/
+VarBitSet VarBitSet::fromVarSet(const VarSet &vars, VarNumbering &numbering) {
+	VarBitSet result;
+	for (const auto &var : vars) {
+		result.insert(numbering.getId(var));
+	}
+	return result;
+}
+
+/**
+* @brief Converts the set into VarSet.
+*
+* @par Preconditions
+*  - all IDs in the set have been assigned by @a numbering
+*/
+VarSet VarBitSet::toVarSet(const VarNumbering &numbering) const {
+	VarSet result;
+	for (auto i = id_begin(), e = id_end(); i != e; ++i) {
+		result.insert(numbering.getVar(*i));
+	}
+	return result;
+}
+
+/**
+* @brief Returns @c true if both sets contain the same IDs, @c false otherwise.
+*/
+bool VarBitSet::operator==(const VarBitSet &other) const {
+	// BitVector::operator==() considers also the sizes of the vectors, which
+	// are not significant here.
+	return !bits.test(other.bits) && !other.bits.test(bits);
+}
+
+/**
+* @brief Returns @c true if the sets differ, @c false otherwise.
+*/
+bool VarBitSet::operator!=(const VarBitSet &other) const {
+	return !(*this == other);
+}
+
+/**
+* @brief Inserts @a id into the set.
+*
+* @return @c true if @a id has been inserted, @c false if it already was in the
+*         set.
+*/
+bool VarBitSet::insert(Id id) {
+	if (id >= bits.size()) {
+		// Grow geometrically to make a series of insertions of increasing
+		// IDs cheap.
+		bits.resize(std::max<std::size_t>(id + 1, 2 * bits.size()));
+	} else if (bits.test(id)) {
+		return false;
+	}
+	bits.set(id);
+	return true;
+}
+
+/**
+* @brief Inserts @a var into the set.
+*
+* If @a var has not been numbered yet, it is numbered by @a numbering.
+*
+* @return @c true if @a var has been inserted, @c false if it already was in
+*         the set.
+*/
+bool VarBitSet::insert(const ShPtr<Variable> &var, VarNumbering &numbering) {
+	return insert(numbering.getId(var));
+}
+
+/**
+* @brief Removes @a id from the set.
+*
+* @return @c true if @a id has been removed, @c false if it was not in the set.
+*/
+bool VarBitSet::erase(Id id) {
+	if (!contains(id)) {
+		return false;
+	}
+	bits.reset(id);
+	return true;
+}
+
+/**
+* @brief Returns @c true if @a id is in the set, @c false otherwise.
+*/
+bool VarBitSet::contains(Id id) const {
+	return id < bits.size() && bits.test(id);
+}
+
+/**
+* @brief Returns @c true if @a var is in the set, @c false otherwise.
+*
+* Variables that have not been numbered by @a numbering are never in the set.
+*/
+bool VarBitSet::contains(const ShPtr<Variable> &var,
+		const VarNumbering &numbering) const {
+	auto id = numbering.findId(var);
+	return id != VarNumbering::NO_ID && contains(id);
+}
+
+/**
+* @brief Returns @c true if the set is empty, @c false otherwise.
+*/
+bool VarBitSet::empty() const {
+	return bits.none();
+}
+
+/**
+* @brief Returns the number of IDs in the set.
+*/
+std::size_t VarBitSet::size() const {
+	return bits.count();
+}
+
+/**
+* @brief Removes all IDs from the set.
+*/
+void VarBitSet::clear() {
+	bits.reset();
+}
+
+/**
+* @brief Adds all IDs from @a other into the set.
+*
+* @return @c true if the set has been changed, @c false otherwise.
+*/
+bool VarBitSet::unionWith(const VarBitSet &other) {
+	if (!other.bits.test(bits)) {
+		return false;
+	}
+	bits |= other.bits;
+	return true;
+}
+
+/**
+* @brief Removes all IDs that are not in @a other from the set.
+*
+* @return @c true if the set has been changed, @c false otherwise.
+*/
+bool VarBitSet::intersectWith(const VarBitSet &other) {
+	if (!bits.test(other.bits)) {
+		return false;
+	}
+	bits &= other.bits;
+	return true;
+}
+
+/**
+* @brief Removes all IDs that are in @a other from the set.
+*
+* @return @c true if the set has been changed, @c false otherwise.
+*/
+bool VarBitSet::subtract(const VarBitSet &other) {
+	if (!bits.anyCommon(other.bits)) {
+		return false;
+	}
+	bits.reset(other.bits);
+	return true;
+}
+
+/**
+* @brief Returns @c true if the set and @a other share at least one ID, @c
+*        false otherwise.
+*/
+bool VarBitSet::intersects(const VarBitSet &other) const {
+	return bits.anyCommon(other.bits);
+}
+
+/**
+* @brief Returns @c true if all IDs in the set are also in @a other, @c false
+*        otherwise.
+*/
+bool VarBitSet::isSubsetOf(const VarBitSet &other) const {
+	return !bits.test(other.bits);
+}
+
+/**
+* @brief Returns an iterator to the smallest ID in the set.
+*/
+VarBitSet::id_iterator VarBitSet::id_begin() const {
+	return bits.set_bits_begin();
+}
+
+/**
+* @brief Returns an iterator past the largest ID in the set.
+*/
+VarBitSet::id_iterator VarBitSet::id_end() const {
+	return bits.set_bits_end();
+}
+
+} // namespace llvmir2hll
+} // namespace retdec
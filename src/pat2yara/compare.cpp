@@ -4,8 +4,14 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <unordered_map>
+
 #include "pat2yara/compare.h"
 #include "pat2yara/utils.h"
+#include "retdec/utils/parallel.h"
 #include "yaramod/types/hex_string.h"
 #include "yaramod/types/rule.h"
 
@@ -191,6 +197,219 @@ bool sortNamesPredicate(
 	return first < other;
 }
 
+/**
+ * Number of leading nibbles used as a key of pattern bucket.
+ */
+const std::size_t BUCKET_KEY_NIBBLES = 16;
+
+/**
+ * Value of wild-card nibble in @c RulePattern.
+ */
+const std::uint8_t WILDCARD_NIBBLE = 0xFF;
+
+/**
+ * Marks rule that is not related to any previous rule.
+ */
+const std::size_t NO_RELATION = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Minimal number of rules for which processing is done in parallel.
+ */
+const std::size_t PARALLEL_THRESHOLD = 1024;
+
+/**
+ * Pattern of rule prepared for fast comparison.
+ */
+struct RulePattern
+{
+	bool hasPattern = false;          ///< @c false if rule has no pattern
+	bool isWild = false;              ///< key contains wild-card or is short
+	std::string key;                  ///< leading nibbles of pattern
+	std::vector<std::uint8_t> nibbles; ///< all nibbles of pattern
+};
+
+/**
+ * Rules with the same pattern key.
+ */
+struct Bucket
+{
+	std::vector<std::size_t> bases;    ///< bases of relations in order
+	std::vector<std::size_t> runRules; ///< rules waiting for processing
+};
+
+/**
+ * Prepare pattern of rule for fast comparison.
+ *
+ * Rules whose patterns start with the same @c BUCKET_KEY_NIBBLES nibbles
+ * without wild-cards get the same key. Rules that have a wild-card in the
+ * leading nibbles or have shorter patterns may match patterns with many
+ * different keys, so they are marked as wild.
+ *
+ * @param rule input rule
+ *
+ * @return prepared pattern
+ */
+RulePattern createRulePattern(
+	const Rule* rule)
+{
+	RulePattern result;
+
+	const auto pattern = getHexPattern(rule, "$1");
+	if (!pattern) {
+		return result;
+	}
+
+	result.hasPattern = true;
+	for (const auto &unit : pattern->getUnits()) {
+		if (unit->isWildcard()) {
+			result.nibbles.push_back(WILDCARD_NIBBLE);
+			continue;
+		}
+
+		// Application works with input that should not contain jumps nor ORs.
+		assert(!unit->isJump()
+			&& "jump in pattern (should not appear in bin2pat output)");
+		assert(!unit->isOr()
+			&& "OR in pattern (should not appear in bin2pat output)");
+
+		result.nibbles.push_back(
+			std::static_pointer_cast<HexStringNibble>(unit)->getValue());
+	}
+
+	if (result.nibbles.size() < BUCKET_KEY_NIBBLES) {
+		result.isWild = true;
+		return result;
+	}
+
+	result.key.assign(result.nibbles.begin(),
+		result.nibbles.begin() + BUCKET_KEY_NIBBLES);
+	result.isWild = result.key.find(static_cast<char>(WILDCARD_NIBBLE))
+		!= std::string::npos;
+	if (result.isWild) {
+		result.key.clear();
+	}
+
+	return result;
+}
+
+/**
+ * Compare two prepared patterns the same way as @c compareRuleByPatterns().
+ *
+ * @param first first pattern
+ * @param other other pattern
+ *
+ * @return @c true if patterns are same, @c false otherwise
+ */
+bool compareRulePatterns(
+	const RulePattern &first,
+	const RulePattern &other)
+{
+	if (!first.hasPattern || !other.hasPattern) {
+		return first.hasPattern == other.hasPattern;
+	}
+
+	auto size = std::min(first.nibbles.size(), other.nibbles.size());
+	for (std::size_t i = 0; i < size; ++i) {
+		if (first.nibbles[i] != other.nibbles[i]
+			&& first.nibbles[i] != WILDCARD_NIBBLE
+			&& other.nibbles[i] != WILDCARD_NIBBLE) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Check whether wild pattern can match patterns from bucket with given key.
+ *
+ * @param pattern wild pattern
+ * @param key key of bucket
+ *
+ * @return @c true if @p pattern can match patterns with @p key
+ */
+bool isKeyCompatible(
+	const RulePattern &pattern,
+	const std::string &key)
+{
+	if (!pattern.hasPattern || key.empty()) {
+		// Only rules without patterns have empty key.
+		return !pattern.hasPattern && key.empty();
+	}
+
+	auto size = std::min(pattern.nibbles.size(), key.size());
+	for (std::size_t i = 0; i < size; ++i) {
+		if (pattern.nibbles[i] != WILDCARD_NIBBLE
+			&& pattern.nibbles[i] != static_cast<std::uint8_t>(key[i])) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Find the first base of relation related to rule.
+ *
+ * @param patterns prepared patterns of all rules
+ * @param ruleIndex index of rule
+ * @param bases first sorted list of bases
+ * @param otherBases second sorted list of bases
+ *
+ * @return index of related base or @c NO_RELATION
+ */
+std::size_t findBase(
+	const std::vector<RulePattern> &patterns,
+	std::size_t ruleIndex,
+	const std::vector<std::size_t> &bases,
+	const std::vector<std::size_t> &otherBases)
+{
+	const auto &pattern = patterns[ruleIndex];
+	auto result = NO_RELATION;
+
+	for (auto base : bases) {
+		if (compareRulePatterns(patterns[base], pattern)) {
+			result = base;
+			break;
+		}
+	}
+	for (auto base : otherBases) {
+		if (base > result) {
+			break;
+		}
+		if (compareRulePatterns(patterns[base], pattern)) {
+			result = base;
+			break;
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Call function for all indexes in range <0, count), in parallel only if
+ * there is enough work.
+ *
+ * @param count number of indexes
+ * @param work estimated amount of work, small work is done sequentially
+ * @param func function to call
+ */
+template <typename Func>
+void parallelFor(
+	std::size_t count,
+	std::size_t work,
+	Func func)
+{
+	if (work < PARALLEL_THRESHOLD) {
+		for (std::size_t i = 0; i < count; ++i) {
+			func(i);
+		}
+		return;
+	}
+
+	retdec::utils::parallelFor(count, func);
+}
+
 } // anonymous namespace
 
 /**
@@ -341,6 +560,14 @@ bool RuleRelations::add(
 /**
  * Create vector of relations from rules.
  *
+ * Every rule is added to the first relation (in order of creation) whose base
+ * rule has the same pattern. Rules that are not related to any existing
+ * relation start a new one. To avoid comparing every rule with every
+ * relation, rules are split into buckets by the beginning of their patterns
+ * and compared only with relations from compatible buckets. Buckets are
+ * processed in parallel. The result is the same as if all rules were
+ * processed one by one.
+ *
  * @param rules input rules
  *
  * @return vector of rule relations
@@ -348,28 +575,91 @@ bool RuleRelations::add(
 std::vector<RuleRelations> getRuleRelationsFromRules(
 	const std::vector<std::unique_ptr<Rule>> &rules)
 {
+	std::vector<RulePattern> patterns;
+	patterns.reserve(rules.size());
+	for (const auto &rule : rules) {
+		patterns.push_back(createRulePattern(rule.get()));
+	}
+
+	// Relation index of every rule that is a base of some relation.
+	std::vector<std::size_t> relationIndex(rules.size(), NO_RELATION);
+	// Base of relation for every rule that is not a base itself.
+	std::vector<std::size_t> baseIndex(rules.size(), NO_RELATION);
+
+	std::unordered_map<std::string, Bucket> buckets;
+	std::vector<std::size_t> wildBases;
 	std::vector<RuleRelations> results;
 
-	for (const auto &rule : rules) {
-		// Look for related rules.
-		bool foundRelation = false;
-		for (auto &relation : results) {
-			if (relation.add(rule.get())) {
-				// Related rule was found.
-				foundRelation = true;
-				break;
+	// Create relations for new bases and add related rules in the original
+	// order of rules so that output does not depend on scheduling.
+	auto commit = [&](std::size_t first, std::size_t last) {
+		for (std::size_t i = first; i < last; ++i) {
+			if (baseIndex[i] == NO_RELATION) {
+				relationIndex[i] = results.size();
+				results.emplace_back(RuleRelations(rules[i].get()));
+			}
+			else {
+				auto &relation = results[relationIndex[baseIndex[i]]];
+				[[maybe_unused]] bool added = relation.add(rules[i].get());
+				assert(added && "bucketed comparison differs from add()");
+			}
+		}
+	};
+
+	std::size_t runStart = 0;
+	std::vector<Bucket*> runBuckets;
+	for (std::size_t i = 0; i <= rules.size(); ++i) {
+		if (i < rules.size() && !patterns[i].isWild) {
+			auto &bucket = buckets[patterns[i].key];
+			if (bucket.runRules.empty()) {
+				runBuckets.push_back(&bucket);
+			}
+			bucket.runRules.push_back(i);
+			continue;
+		}
+
+		// Process run of rules that are not wild. Every bucket is compared
+		// only with itself and with wild bases which do not change during
+		// the run, so buckets are independent.
+		parallelFor(runBuckets.size(), i - runStart, [&](std::size_t b) {
+			auto &bucket = *runBuckets[b];
+			for (auto ruleIndex : bucket.runRules) {
+				auto base = findBase(patterns, ruleIndex, bucket.bases,
+					wildBases);
+				if (base == NO_RELATION) {
+					bucket.bases.push_back(ruleIndex);
+				}
+				baseIndex[ruleIndex] = base;
 			}
+			bucket.runRules.clear();
+		});
+		runBuckets.clear();
+		commit(runStart, i);
+
+		if (i == rules.size()) {
+			break;
 		}
 
-		// Create new entry if no related rule was found.
-		if (!foundRelation) {
-			results.emplace_back(RuleRelations(rule.get()));
+		// Wild rule may be related to bases from any compatible bucket.
+		auto base = findBase(patterns, i, {}, wildBases);
+		for (const auto &keyBucket : buckets) {
+			if (isKeyCompatible(patterns[i], keyBucket.first)) {
+				auto candidate = findBase(patterns, i, keyBucket.second.bases,
+					{});
+				base = std::min(base, candidate);
+			}
+		}
+		if (base == NO_RELATION) {
+			wildBases.push_back(i);
 		}
+		baseIndex[i] = base;
+		commit(i, i + 1);
+		runStart = i + 1;
 	}
 
-	for (auto &result : results) {
-		result.makeAlternativesUniq();
-	}
+	parallelFor(results.size(), results.size(), [&](std::size_t r) {
+		results[r].makeAlternativesUniq();
+	});
 
 	return results;
 }
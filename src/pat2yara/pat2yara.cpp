@@ -9,6 +9,7 @@
 
 #include "retdec/utils/filesystem.h"
 #include "retdec/utils/io/log.h"
+#include "retdec/utils/parallel.h"
 #include "pat2yara/processing.h"
 #include "yaramod/builder/yara_file_builder.h"
 #include "yaramod/builder/yara_rule_builder.h"
@@ -47,7 +48,10 @@ void printUsage(Logger& log)
 	"--ignore-nops OPCODE\n"
 	"    Ignore NOPs with OPCODE when computing (pure) size.\n\n"
 	"--delphi\n"
-	"    Set special Delphi processing on.\n\n";
+	"    Set special Delphi processing on.\n\n"
+	"--max-threads VALUE\n"
+	"    Use at most VALUE threads (0 means number of CPUs, 1 turns\n"
+	"    threading off).\n\n";
 }
 
 /**
@@ -140,6 +144,13 @@ int processArguments(std::vector<std::string> &args)
 				return dieWithError("invalid --ignore-nops argument value");
 			}
 		}
+		else if (args[i] == "--max-threads") {
+			std::size_t threads = 0;
+			if (!argumentToSize(args, threads, ++i)) {
+				return dieWithError("invalid --max-threads argument value");
+			}
+			retdec::utils::setMaxThreadCount(threads);
+		}
 		else if (args[i] == "--output" || args[i] == "-o") {
 			if (args.size() > i + 1) {
 				outputPath = args[++i];
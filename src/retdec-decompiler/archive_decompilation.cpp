@@ -0,0 +1,242 @@
+/**
+ * @file src/retdec-decompiler/archive_decompilation.cpp
+ * @brief Decompilation of all the objects from archive.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <llvm/ADT/Optional.h>
+#include <llvm/Support/Program.h>
+#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "retdec/utils/io/log.h"
+#include "retdec-decompiler/archive_decompilation.h"
+
+using namespace retdec::utils::io;
+
+namespace retdec {
+namespace decompiler {
+
+/**
+ * Decompile one object from archive in a separate decompiler process.
+ * @param decompiler Path to the decompiler executable.
+ * @param archivePath Path to the archive.
+ * @param index Index of the object in the archive.
+ * @param object The object.
+ * @param args Arguments of the decompiler after the input file.
+ * @param outputFormat Output format of the decompilation (@c plain or @c json).
+ *
+ * The object is written next to the archive as INPUT_FILE.file_N, so all
+ * the outputs of the decompilation are named after it. The object is only
+ * a temporary copy and it is removed as soon as the process finishes, even
+ * without --cleanup. Output of the process is redirected into
+ * INPUT_FILE.file_N.log.
+ */
+ArchiveMemberResult decompileArchiveMember(
+		const std::string& decompiler,
+		const std::string& archivePath,
+		std::size_t index,
+		const retdec::ar_extractor::ArchiveObject& object,
+		const std::vector<std::string>& args,
+		const std::string& outputFormat)
+{
+	ArchiveMemberResult res;
+	res.name = object.name;
+	res.inputFile = archivePath + ".file_" + std::to_string(index + 1);
+	res.outputFile = res.inputFile
+			+ (outputFormat == "plain" ? ".c" : ".c.json");
+	res.logFile = res.inputFile + ".log";
+
+	std::ofstream objectFile(res.inputFile, std::ofstream::binary);
+	objectFile.write(object.data.data(), object.data.size());
+	objectFile.close();
+	if (!objectFile)
+	{
+		remove(res.inputFile.c_str());
+		res.status = "error";
+		res.errorMessage = "failed to write object into " + res.inputFile;
+		res.exitCode = EXIT_FAILURE;
+		return res;
+	}
+
+	std::vector<llvm::StringRef> processArgs = {decompiler, res.inputFile};
+	processArgs.insert(processArgs.end(), args.begin(), args.end());
+	llvm::Optional<llvm::StringRef> redirects[] = {
+			llvm::None,
+			llvm::StringRef(res.logFile),
+			llvm::StringRef(res.logFile)
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	res.exitCode = llvm::sys::ExecuteAndWait(
+			decompiler,
+			processArgs,
+			llvm::None,
+			redirects,
+			0,
+			0,
+			&res.errorMessage
+	);
+	res.seconds = std::chrono::duration<double>(
+			std::chrono::steady_clock::now() - start
+	).count();
+	remove(res.inputFile.c_str());
+
+	switch (res.exitCode)
+	{
+		case EXIT_SUCCESS: res.status = "ok"; break;
+		case EXIT_TIMEOUT: res.status = "timeout"; break;
+		case EXIT_BAD_ALLOC: res.status = "out-of-memory"; break;
+		case -1: res.status = "error"; break; // process could not be run
+		case -2: res.status = "crash"; break;
+		default: res.status = "fail"; break;
+	}
+
+	return res;
+}
+
+/**
+ * Decompile the objects from archive by a pool of @a jobs workers, every
+ * object by decompileArchiveMember().
+ * @param decompiler Path to the decompiler executable.
+ * @param archivePath Path to the archive.
+ * @param objects Objects from the archive.
+ * @param args Arguments of the decompiler after the input file.
+ * @param outputFormat Output format of the decompilation (@c plain or @c json).
+ * @param jobs Number of objects decompiled at once (@c 0 for the number of
+ *             CPU cores).
+ * @return Results of the objects in the order of @a objects.
+ */
+std::vector<ArchiveMemberResult> decompileArchiveMembers(
+		const std::string& decompiler,
+		const std::string& archivePath,
+		const std::vector<retdec::ar_extractor::ArchiveObject>& objects,
+		const std::vector<std::string>& args,
+		const std::string& outputFormat,
+		std::size_t jobs)
+{
+	if (jobs == 0)
+	{
+		jobs = std::max(1u, std::thread::hardware_concurrency());
+	}
+	jobs = std::max<std::size_t>(1, std::min(jobs, objects.size()));
+
+	Log::info() << "Decompiling " << objects.size() << " files using "
+			<< jobs << " jobs" << std::endl;
+
+	std::vector<ArchiveMemberResult> results(objects.size());
+	std::atomic<std::size_t> next(0);
+	std::size_t finished = 0;
+	std::mutex mutex;
+
+	auto worker = [&]()
+	{
+		for (auto i = next++; i < objects.size(); i = next++)
+		{
+			auto res = decompileArchiveMember(
+					decompiler,
+					archivePath,
+					i,
+					objects[i],
+					args,
+					outputFormat
+			);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			Log::info() << ++finished << "/" << objects.size() << "\t"
+					<< res.name << "\t[" << res.status << "]" << std::endl;
+			results[i] = std::move(res);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (std::size_t i = 1; i < jobs; ++i)
+	{
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (auto& t : threads)
+	{
+		t.join();
+	}
+
+	return results;
+}
+
+/**
+ * Write summary of the decompilation of all the objects from archive
+ * in JSON format.
+ */
+void writeArchiveSummary(
+		const std::string& summaryPath,
+		const std::string& archivePath,
+		const std::vector<ArchiveMemberResult>& results)
+{
+	rapidjson::Document root(rapidjson::kObjectType);
+	auto& allocator = root.GetAllocator();
+
+	std::map<std::string, unsigned> counts;
+	rapidjson::Value objects(rapidjson::kArrayType);
+	for (std::size_t i = 0; i < results.size(); ++i)
+	{
+		auto& r = results[i];
+		++counts[r.status];
+
+		rapidjson::Value object(rapidjson::kObjectType);
+		object.AddMember("index", static_cast<uint64_t>(i), allocator);
+		object.AddMember("name", rapidjson::Value(r.name.c_str(), allocator), allocator);
+		object.AddMember("status", rapidjson::Value(r.status.c_str(), allocator), allocator);
+		object.AddMember("exitCode", r.exitCode, allocator);
+		object.AddMember("seconds", r.seconds, allocator);
+		object.AddMember("output", rapidjson::Value(r.outputFile.c_str(), allocator), allocator);
+		object.AddMember("log", rapidjson::Value(r.logFile.c_str(), allocator), allocator);
+		if (!r.errorMessage.empty())
+		{
+			object.AddMember("error", rapidjson::Value(r.errorMessage.c_str(), allocator), allocator);
+		}
+		objects.PushBack(object, allocator);
+	}
+
+	rapidjson::Value summary(rapidjson::kObjectType);
+	summary.AddMember("total", static_cast<uint64_t>(results.size()), allocator);
+	for (auto& c : counts)
+	{
+		summary.AddMember(
+				rapidjson::Value(c.first.c_str(), allocator),
+				rapidjson::Value(c.second),
+				allocator
+		);
+	}
+
+	root.AddMember("archive", rapidjson::Value(archivePath.c_str(), allocator), allocator);
+	root.AddMember("summary", summary, allocator);
+	root.AddMember("objects", objects, allocator);
+
+	rapidjson::StringBuffer buffer;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+	root.Accept(writer);
+
+	std::ofstream out(summaryPath);
+	out << buffer.GetString() << std::endl;
+	if (!out)
+	{
+		throw std::runtime_error(
+				"failed to write archive summary into " + summaryPath
+		);
+	}
+}
+
+} // namespace decompiler
+} // namespace retdec
@@ -0,0 +1,63 @@
+/**
+ * @file src/retdec-decompiler/archive_decompilation.h
+ * @brief Decompilation of all the objects from archive.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_DECOMPILER_ARCHIVE_DECOMPILATION_H
+#define RETDEC_DECOMPILER_ARCHIVE_DECOMPILATION_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "retdec/ar-extractor/archive_wrapper.h"
+
+namespace retdec {
+namespace decompiler {
+
+/// Exit code of decompilation which ran out of time.
+const int EXIT_TIMEOUT = 137;
+/// Exit code of decompilation which ran out of memory.
+const int EXIT_BAD_ALLOC = 135;
+
+/**
+ * Result of decompilation of one object from archive.
+ */
+struct ArchiveMemberResult
+{
+	std::string name;
+	std::string inputFile;
+	std::string outputFile;
+	std::string logFile;
+	std::string status;
+	std::string errorMessage;
+	int exitCode = 0;
+	double seconds = 0.0;
+};
+
+ArchiveMemberResult decompileArchiveMember(
+		const std::string& decompiler,
+		const std::string& archivePath,
+		std::size_t index,
+		const retdec::ar_extractor::ArchiveObject& object,
+		const std::vector<std::string>& args,
+		const std::string& outputFormat);
+
+std::vector<ArchiveMemberResult> decompileArchiveMembers(
+		const std::string& decompiler,
+		const std::string& archivePath,
+		const std::vector<retdec::ar_extractor::ArchiveObject>& objects,
+		const std::vector<std::string>& args,
+		const std::string& outputFormat,
+		std::size_t jobs);
+
+void writeArchiveSummary(
+		const std::string& summaryPath,
+		const std::string& archivePath,
+		const std::vector<ArchiveMemberResult>& results);
+
+} // namespace decompiler
+} // namespace retdec
+
+#endif
@@ -48,11 +48,12 @@
 #include "retdec/utils/memory.h"
 
 #include "retdec/utils/io/log.h"
+#include "retdec-decompiler/archive_decompilation.h"
 
 using namespace retdec::utils::io;
 
-const int EXIT_TIMEOUT = 137;
-const int EXIT_BAD_ALLOC = 135;
+using retdec::decompiler::EXIT_TIMEOUT;
+using retdec::decompiler::EXIT_BAD_ALLOC;
 
 //
 //==============================================================================
@@ -73,6 +74,10 @@ class ProgramOptions
 		std::string arExtractPath;
 		std::string arName;
 		std::optional<uint64_t> arIdx;
+		bool arAll = false;
+		unsigned arJobs = 0;
+		/// Arguments passed to decompilations of objects in --ar-all mode.
+		std::vector<std::string> arMemberArgs;
 
 		bool cleanup = false;
 		std::set<std::string> toClean;
@@ -86,6 +91,10 @@ class ProgramOptions
 
 		void load();
 
+	private:
+		/// Is the last loaded option passed to decompilations of objects?
+		bool isArMemberArg = true;
+
 	private:
 		void loadOption(std::list<std::string>::iterator& i);
 		bool isParam(
@@ -154,11 +163,17 @@ void ProgramOptions::load()
 
 	for (auto i = _argv.begin(); i != _argv.end();)
 	{
+		auto first = i;
+		isArMemberArg = true;
 		loadOption(i);
 		if (i != _argv.end())
 		{
 			++i;
 		}
+		if (isArMemberArg)
+		{
+			arMemberArgs.insert(arMemberArgs.end(), first, i);
+		}
 	}
 
 	afterLoad();
@@ -288,6 +303,20 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 		params.setMaxMemoryLimit(0);
 		params.setIsMaxMemoryLimitHalfRam(false);
 	}
+	else if (isParam(i, "", "--max-threads"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			params.setMaxThreads(std::stoull(val));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--max-threads] invalid value: " + val
+			);
+		}
+	}
 	else if (isParam(i, "-o", "--output"))
 	{
 		std::string out = getParamOrDie(i);
@@ -387,6 +416,23 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 	{
 		params.setIsDetectStaticCode(false);
 	}
+	else if (isParam(i, "", "--forward-register-values"))
+	{
+		params.setIsForwardRegisterValues(true);
+	}
+	else if (isParam(i, "", "--simple-types-union-find"))
+	{
+		params.setIsSimpleTypesUnionFind(true);
+	}
+	else if (isParam(i, "", "--checkpoint"))
+	{
+		params.setCheckpointFile(getParamOrDie(i));
+	}
+	else if (isParam(i, "", "--resume"))
+	{
+		std::string cp = checkFile(getParamOrDie(i), "[--resume]");
+		params.setResumeFile(cp);
+	}
 	else if (isParam(i, "", "--backend-disabled-opts"))
 	{
 		params.setBackendDisabledOpts(getParamOrDie(i));
@@ -461,6 +507,26 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 	{
 		params.setIsBackendNoSymbolicNames(true);
 	}
+	else if (isParam(i, "", "--backend-func-cache"))
+	{
+		params.setBackendFuncCacheDir(
+			fs::absolute(getParamOrDie(i)).string()
+		);
+	}
+	else if (isParam(i, "", "--backend-func-cache-size"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			params.setBackendFuncCacheMaxSize(std::stoull(val));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--backend-func-cache-size] invalid value: " + val
+			);
+		}
+	}
 	else if (isParam(i, "", "--ar-index"))
 	{
 		if (!arName.empty())
@@ -495,6 +561,26 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 
 		arName = getParamOrDie(i);
 	}
+	else if (isParam(i, "", "--ar-all"))
+	{
+		arAll = true;
+		isArMemberArg = false;
+	}
+	else if (isParam(i, "", "--ar-jobs"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			arJobs = std::stoul(val);
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--ar-jobs] invalid number of jobs: " + val
+			);
+		}
+		isArMemberArg = false;
+	}
 	else if (isParam(i, "", "--static-code-sigfile"))
 	{
 		auto file = checkFile(getParamOrDie(i), "[--static-code-sigfile]");
@@ -514,6 +600,34 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 			);
 		}
 	}
+	else if (isParam(i, "", "--llvm-function-size-limit"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			params.setLlvmPassesFunctionSizeLimit(std::stoull(val));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--llvm-function-size-limit] invalid value: " + val
+			);
+		}
+	}
+	else if (isParam(i, "", "--llvm-function-time-limit"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			params.setLlvmPassesFunctionTimeLimit(std::stoull(val));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--llvm-function-time-limit] invalid value: " + val
+			);
+		}
+	}
 	else if (isParam(i, "-s", "--silent"))
 	{
 		params.setIsVerboseOutput(false);
@@ -523,6 +637,7 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 	else if (params.getInputFile().empty())
 	{
 		params.setInputFile(c);
+		isArMemberArg = false;
 	}
 	else
 	{
@@ -535,6 +650,30 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
  */
 void ProgramOptions::afterLoad()
 {
+	if (arAll)
+	{
+		if (arIdx || !arName.empty())
+		{
+			throw std::runtime_error(
+				"[--ar-all] cannot be used with [--ar-index] or [--ar-name]"
+			);
+		}
+		if (!params.getOutputFile().empty())
+		{
+			throw std::runtime_error(
+				"[--ar-all] outputs are named after the input archive, "
+				"[-o|--output] cannot be used"
+			);
+		}
+		if (!params.getCheckpointFile().empty()
+				|| !params.getResumeFile().empty())
+		{
+			throw std::runtime_error(
+				"[--ar-all] cannot be used with [--checkpoint] or [--resume]"
+			);
+		}
+	}
+
 	auto in = params.getInputFile();
 	if (params.getOutputAsmFile().empty())
 		params.setOutputAsmFile(in + ".dsm");
@@ -624,6 +763,15 @@ General arguments:
 	[--cleanup] Removes temporary files created during the decompilation.
 	[--config] Specify JSON decompilation configuration file.
 	[--disable-static-code-detection] Prevents detection of statically linked code.
+	[--forward-register-values] Reuses register values within basic blocks right after decoding instead of reloading them,
+	                            and removes register stores overwritten in the same block. Smaller LLVM IR for later passes.
+	[--simple-types-union-find] Reconstructs simple data types using union-find over all the values instead of separate
+	                            equivalence sets. Uses less memory on big inputs. Equivalent values found from different
+	                            roots are merged into a single class, so the results may differ.
+	[--checkpoint FILE] Store the optimized LLVM IR (bitcode) into FILE and the config into FILE.config.json
+	                    right before its conversion into the output.
+	[--resume FILE] Do not decode nor optimize INPUT_FILE, convert the LLVM IR stored by [--checkpoint FILE]
+	                into the output. INPUT_FILE is used only to name the output files.
 Selective decompilation arguments:
 	[--select-ranges RANGES] Specify a comma separated list of ranges to decompile (example: 0x100-0x200,0x300-0x400,0x500-0x600).
 	[--select-functions FUNCS] Specify a comma separated list of functions to decompile (example: fnc1,fnc2,fnc3).
@@ -640,6 +788,10 @@ Raw or Intel HEX decompilation arguments:
 Archive decompilation arguments:
 	[--ar-index INDEX] Pick file from archive for decompilation by its zero-based index.
 	[--ar-name NAME] Pick file from archive for decompilation by its name.
+	[--ar-all] Decompile all files from archive in parallel. Outputs for file on index N are named INPUT_FILE.file_N+1.*,
+	           summary of all the decompilations is stored into INPUT_FILE.summary.json.
+	           Extracted files INPUT_FILE.file_N+1 are always removed after their decompilation.
+	[--ar-jobs N] Number of files decompiled at once in --ar-all mode (default: number of CPU cores).
 	[--static-code-sigfile FILE] Adds additional signature file for static code detection.
 Backend arguments:
 	[--backend-disabled-opts LIST] Prevents the optimizations from the given comma-separated list of optimizations to be run.
@@ -656,10 +808,16 @@ Backend arguments:
 	[--backend-no-var-renaming] Disables renaming of variables in the backend.
 	[--backend-no-compound-operators] Do not emit compound operators (like +=) instead of assignments.
 	[--backend-no-symbolic-names] Disables the conversion of constant arguments to their symbolic names.
+	[--backend-func-cache DIR] Caches the output of decompiled functions in DIR and reuses it for identical functions.
+	[--backend-func-cache-size BYTES] Maximal size of the function cache, least recently used entries are removed (Default: 1073741824, 0 = unlimited).
 Decompilation process arguments:
 	[--timeout SECONDS]
 	[--max-memory MAX_MEMORY] Limits the maximal memory used by the given number of bytes.
 	[--no-memory-limit] Disables the default memory limit (half of system RAM).
+	[--max-threads N] Analyses which run in parallel use at most N threads (Default: 0 = number of CPUs, 1 = no threads).
+	[--llvm-function-size-limit N] Functions with more than N LLVM instructions are optimized only by cheap LLVM passes (Default: 0 = unlimited).
+	[--llvm-function-time-limit MS] Functions whose optimization by a group of LLVM passes takes more than MS milliseconds
+	                                are optimized only by cheap LLVM passes from then on (Default: 0 = unlimited).
 LLVM IR debug arguments:
 	[--print-after-all] Dump LLVM IR to stderr after every LLVM pass.
 	[--print-before-all] Dump LLVM IR to stderr before every LLVM pass.
@@ -789,12 +947,12 @@ void setLogsFrom(const retdec::config::Parameters& params)
 	}
 }
 
-int decompile(retdec::config::Config& config, ProgramOptions& po)
+/**
+ * If the input file is a Mach-O Universal Binary, extract the requested
+ * (or the best) architecture from it and use it as the input file.
+ */
+void extractMachOUniversal(retdec::config::Config& config, ProgramOptions& po)
 {
-	setLogsFrom(config.parameters);
-
-	// Macho-O extraction.
-	//
 	retdec::macho_extractor::BreakMachOUniversal fat(
 			config.parameters.getInputFile()
 	);
@@ -826,13 +984,28 @@ int decompile(retdec::config::Config& config, ProgramOptions& po)
 				throw std::runtime_error(
 						"Mach-O extraction: extractBestArchive() failed."
 				);
-				return EXIT_FAILURE;
 			}
 		}
 
 		config.parameters.setInputFile(extractedFile);
 		po.toClean.insert(extractedFile);
 	}
+}
+
+int decompile(retdec::config::Config& config, ProgramOptions& po)
+{
+	setLogsFrom(config.parameters);
+
+	// Everything before the conversion into HLL is in the checkpoint.
+	//
+	if (!config.parameters.getResumeFile().empty())
+	{
+		return retdec::decompile(config);
+	}
+
+	// Macho-O extraction.
+	//
+	extractMachOUniversal(config, po);
 
 	// Archive extraction.
 	//
@@ -955,6 +1128,82 @@ int decompile(retdec::config::Config& config, ProgramOptions& po)
 	return retdec::decompile(config);
 }
 
+//
+//==============================================================================
+// Archive decompilation.
+//==============================================================================
+//
+
+/**
+ * Decompile all the objects from the input archive (--ar-all).
+ *
+ * The archive is read only once and its objects are decompiled by a pool of
+ * workers. Decompilation keeps global state (providers, LLVM options, logs),
+ * so every object is decompiled in its own decompiler process, which also
+ * isolates crashes, timeouts and memory limits of the individual objects.
+ */
+int decompileArchive(retdec::config::Config& config, ProgramOptions& po)
+{
+	setLogsFrom(config.parameters);
+
+	// Macho-O extraction.
+	//
+	extractMachOUniversal(config, po);
+
+	Log::phase("Archive decompilation");
+
+	auto archivePath = config.parameters.getInputFile();
+	bool ok = true;
+	std::string errMsg;
+	retdec::ar_extractor::ArchiveWrapper arw(archivePath, ok, errMsg);
+	if (!ok)
+	{
+		throw std::runtime_error(
+				"failed to create archive wrapper: " + errMsg
+		);
+	}
+	if (arw.isThinArchive())
+	{
+		throw std::runtime_error(
+				"file is a thin archive and cannot be decompiled"
+		);
+	}
+
+	std::vector<retdec::ar_extractor::ArchiveObject> objects;
+	if (!arw.getObjects(objects, errMsg))
+	{
+		throw std::runtime_error("failed to read archive: " + errMsg);
+	}
+	if (objects.empty())
+	{
+		throw std::runtime_error("the input archive is empty");
+	}
+
+	auto results = retdec::decompiler::decompileArchiveMembers(
+			retdec::utils::getThisBinaryPath().string(),
+			archivePath,
+			objects,
+			po.arMemberArgs,
+			po.params.getOutputFormat(),
+			po.arJobs
+	);
+
+	retdec::decompiler::writeArchiveSummary(
+			archivePath + ".summary.json",
+			archivePath,
+			results
+	);
+
+	for (auto& r : results)
+	{
+		if (r.status != "ok")
+		{
+			return EXIT_FAILURE;
+		}
+	}
+	return EXIT_SUCCESS;
+}
+
 //
 //==============================================================================
 // Cleanup.
@@ -1027,7 +1276,12 @@ int main(int argc, char **argv)
 	try
 	{
 		std::stringstream buffer;
-		if (config.parameters.isTimeout())
+		if (po.arAll)
+		{
+			// Timeout is applied to the decompilation of each file.
+			ret = decompileArchive(config, po);
+		}
+		else if (config.parameters.isTimeout())
 		{
 			std::packaged_task<
 					int(retdec::config::Config&,
@@ -4,6 +4,9 @@
  * @copyright (c) 2019 Avast Software, licensed under the MIT license
  */
 
+#include <chrono>
+#include <set>
+
 #include <llvm/ADT/Triple.h>
 #include <llvm/Analysis/CallGraph.h>
 #include <llvm/Analysis/CallGraphSCCPass.h>
@@ -12,11 +15,13 @@
 #include <llvm/Analysis/ScalarEvolution.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/CodeGen/CommandFlags.inc>
 #include <llvm/IR/CFG.h>
 #include <llvm/IR/DataLayout.h>
 #include <llvm/IR/DebugInfo.h>
 #include <llvm/IR/IRPrintingPasses.h>
+#include <llvm/IR/InstIterator.h>
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/LegacyPassNameParser.h>
@@ -27,6 +32,7 @@
 #include <llvm/LinkAllIR.h>
 #include <llvm/MC/SubtargetFeature.h>
 #include <llvm/Support/Debug.h>
+#include <llvm/Support/FileSystem.h>
 #include <llvm/Support/Host.h>
 #include <llvm/Support/ManagedStatic.h>
 #include <llvm/Support/PrettyStackTrace.h>
@@ -50,6 +56,7 @@
 #include "retdec/config/config.h"
 #include "retdec/retdec/retdec.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/parallel.h"
 #include "retdec/utils/io/log.h"
 
 using namespace retdec::utils::io;
@@ -92,8 +99,66 @@ std::unique_ptr<llvm::Module> createLlvmModule(llvm::LLVMContext& Context)
 
 namespace retdec {
 
+/**
+ * Start addresses of LLVM functions and addresses of instructions referencing
+ * them. These are collected for all functions before any of them is visited,
+ * so that the LLVM IR of already visited functions can be dropped.
+ */
+struct FunctionIndex
+{
+	std::map<const llvm::Function*, common::Address> starts;
+	std::map<const llvm::Function*, std::set<common::Address>> references;
+};
+
+FunctionIndex createFunctionIndex(
+		bin2llvmir::Config* config,
+		llvm::Module& module)
+{
+	FunctionIndex ret;
+
+	for (llvm::Function& f : module.functions())
+	{
+		auto start = bin2llvmir::AsmInstruction::getFunctionAddress(&f);
+		if (start.isUndefined())
+		{
+			start = config->getFunctionAddress(&f);
+		}
+		if (start.isDefined())
+		{
+			ret.starts.emplace(&f, start);
+		}
+
+		auto& refs = ret.references[&f];
+		for (auto* u : f.users())
+		{
+			if (auto* i = llvm::dyn_cast<llvm::Instruction>(u))
+			{
+				if (auto ai = bin2llvmir::AsmInstruction(i))
+				{
+					auto addr = ai.getAddress();
+					// MIPS hack: there are delay slots on MIPS, calls/branches
+					// are placed at the end of the next instruction (delay slot)
+					// we need to modify reference address.
+					// This assums that all references on MIPS have delays slots of
+					// 4 bytes, and therefore need to be fixed, it it is not the
+					// case, it will cause problems.
+					//
+					if (config->getConfig().architecture.isMipsOrPic32())
+					{
+						addr -= 4;
+					}
+					refs.insert(addr);
+				}
+			}
+		}
+	}
+
+	return ret;
+}
+
 common::BasicBlock fillBasicBlock(
 		bin2llvmir::Config* config,
+		const FunctionIndex& index,
 		llvm::BasicBlock& bb,
 		llvm::BasicBlock& bbEnd)
 {
@@ -168,13 +233,8 @@ common::BasicBlock fillBasicBlock(
 			auto call = llvm::dyn_cast<llvm::CallInst>(&i);
 			if (call && call->getCalledFunction())
 			{
-				auto cf = call->getCalledFunction();
-				auto target = bin2llvmir::AsmInstruction::getFunctionAddress(cf);
-				if (target.isUndefined())
-				{
-					target = config->getFunctionAddress(cf);
-				}
-				if (target.isDefined())
+				auto it = index.starts.find(call->getCalledFunction());
+				if (it != index.starts.end())
 				{
 					auto src = ai.getAddress();
 					// MIPS hack: there are delay slots on MIPS, calls/branches
@@ -190,7 +250,7 @@ common::BasicBlock fillBasicBlock(
 					}
 
 					ret.calls.emplace(
-							common::BasicBlock::CallEntry{src, target});
+							common::BasicBlock::CallEntry{src, it->second});
 				}
 			}
 		}
@@ -199,16 +259,23 @@ common::BasicBlock fillBasicBlock(
 	return ret;
 }
 
-common::Function fillFunction(
+void visitFunction(
 		bin2llvmir::Config* config,
-		llvm::Function& f)
+		const FunctionIndex& index,
+		llvm::Function& f,
+		DisassemblyVisitor& visitor)
 {
 	common::Function ret(
 			bin2llvmir::AsmInstruction::getFunctionAddress(&f),
 			bin2llvmir::AsmInstruction::getFunctionEndAddress(&f),
 			f.getName()
 	);
+	ret.codeReferences = index.references.at(&f);
+	visitor.visitFunction(ret);
 
+	// Basic blocks are visited in the same order as they would be stored
+	// in common::Function::basicBlocks.
+	std::set<common::BasicBlock> bbs;
 	for (llvm::BasicBlock& bb : f)
 	{
 		// There are more BBs in LLVM IR than we created in control-flow
@@ -235,51 +302,53 @@ common::Function fillFunction(
 			}
 		}
 
-		ret.basicBlocks.emplace(
-				fillBasicBlock(config, bb, *bbEnd));
+		bbs.emplace(fillBasicBlock(config, index, bb, *bbEnd));
+	}
+	for (auto& bb : bbs)
+	{
+		visitor.visitBasicBlock(bb);
 	}
 
-	for (auto* u : f.users())
+	visitor.visitFunctionEnd(ret);
+}
+
+/**
+ * Drop the LLVM IR of function \p f together with the Capstone instructions
+ * it was created from.
+ */
+void dropFunction(llvm::Function& f)
+{
+	auto& insnMap = bin2llvmir::AsmInstruction::getLlvmToCapstoneInsnMap(
+			f.getParent());
+	for (auto& i : llvm::instructions(f))
 	{
-		if (auto* i = llvm::dyn_cast<llvm::Instruction>(u))
+		if (auto* s = llvm::dyn_cast<llvm::StoreInst>(&i))
 		{
-			if (auto ai = bin2llvmir::AsmInstruction(i))
+			auto it = insnMap.find(s);
+			if (it != insnMap.end())
 			{
-				auto addr = ai.getAddress();
-				// MIPS hack: there are delay slots on MIPS, calls/branches
-				// are placed at the end of the next instruction (delay slot)
-				// we need to modify reference address.
-				// This assums that all references on MIPS have delays slots of
-				// 4 bytes, and therefore need to be fixed, it it is not the
-				// case, it will cause problems.
-				//
-				if (config->getConfig().architecture.isMipsOrPic32())
-				{
-					addr -= 4;
-				}
-				ret.codeReferences.insert(addr);
+				cs_free(it->second, 1);
+				insnMap.erase(it);
 			}
 		}
 	}
 
-	return ret;
+	f.deleteBody();
 }
 
-void fillFunctions(
+void visitFunctions(
 		llvm::Module& module,
-		retdec::common::FunctionSet* fs)
+		DisassemblyVisitor& visitor,
+		bool keepLlvmIr)
 {
-	if (fs == nullptr)
-	{
-		return;
-	}
-
 	auto* config = bin2llvmir::ConfigProvider::getConfig(&module);
 	if (config == nullptr)
 	{
 		return;
 	}
 
+	auto index = createFunctionIndex(config, module);
+
 	for (llvm::Function& f : module.functions())
 	{
 		if (f.isDeclaration()
@@ -289,21 +358,83 @@ void fillFunctions(
 			auto sa = config->getFunctionAddress(&f);
 			if (sa.isDefined())
 			{
-				fs->emplace(common::Function(sa, sa, f.getName()));
+				common::Function ret(sa, sa, f.getName());
+				visitor.visitFunction(ret);
+				visitor.visitFunctionEnd(ret);
 			}
 			continue;
 		}
 
-		fs->emplace(fillFunction(config, f));
+		visitFunction(config, index, f, visitor);
+
+		if (!keepLlvmIr)
+		{
+			dropFunction(f);
+		}
+	}
+
+	if (!keepLlvmIr)
+	{
+		auto& insnMap = bin2llvmir::AsmInstruction::getLlvmToCapstoneInsnMap(
+				&module);
+		for (auto& p : insnMap)
+		{
+			cs_free(p.second, 1);
+		}
+		insnMap.clear();
 	}
 }
 
-LlvmModuleContextPair disassemble(
-		const std::string& inputPath,
+/**
+ * Visitor collecting all the visited functions into a set.
+ */
+class FunctionSetFiller : public DisassemblyVisitor
+{
+	public:
+		FunctionSetFiller(retdec::common::FunctionSet* fs) :
+				_fs(fs)
+		{
+
+		}
+
+		void visitFunction(const common::Function& f) override
+		{
+			_function = f;
+		}
+
+		void visitBasicBlock(const common::BasicBlock& bb) override
+		{
+			_function.basicBlocks.emplace_hint(_function.basicBlocks.end(), bb);
+		}
+
+		void visitFunctionEnd(const common::Function& f) override
+		{
+			_fs->emplace(std::move(_function));
+		}
+
+	private:
+		retdec::common::FunctionSet* _fs = nullptr;
+		common::Function _function;
+};
+
+void fillFunctions(
+		llvm::Module& module,
 		retdec::common::FunctionSet* fs)
 {
-	auto context = std::make_unique<llvm::LLVMContext>();
-	auto module = createLlvmModule(*context);
+	if (fs == nullptr)
+	{
+		return;
+	}
+
+	FunctionSetFiller filler(fs);
+	visitFunctions(module, filler, true);
+}
+
+std::unique_ptr<llvm::Module> decode(
+		llvm::LLVMContext& context,
+		const std::string& inputPath)
+{
+	auto module = createLlvmModule(context);
 
 	config::Config c;
 	c.parameters.setInputFile(inputPath);
@@ -318,11 +449,41 @@ LlvmModuleContextPair disassemble(
 	// Now that we have all of the passes ready, run them.
 	pm.run(*module);
 
+	return module;
+}
+
+LlvmModuleContextPair disassemble(
+		const std::string& inputPath,
+		retdec::common::FunctionSet* fs)
+{
+	auto context = std::make_unique<llvm::LLVMContext>();
+	auto module = decode(*context, inputPath);
+
 	fillFunctions(*module, fs);
 
 	return LlvmModuleContextPair{std::move(module), std::move(context)};
 }
 
+LlvmModuleContextPair disassemble(
+		const std::string& inputPath,
+		DisassemblyVisitor& visitor,
+		bool keepLlvmIr)
+{
+	auto context = std::make_unique<llvm::LLVMContext>();
+	auto module = decode(*context, inputPath);
+
+	visitFunctions(*module, visitor, keepLlvmIr);
+
+	if (!keepLlvmIr)
+	{
+		// Order matters: module destructor uses context.
+		module.reset();
+		context.reset();
+	}
+
+	return LlvmModuleContextPair{std::move(module), std::move(context)};
+}
+
 //==============================================================================
 // decompiler
 //==============================================================================
@@ -408,6 +569,116 @@ class ModulePassPrinter : public ModulePass
 char ModulePassPrinter::ID = 0;
 std::string ModulePassPrinter::LastPhase;
 
+/**
+ * Suffix of the config file stored together with a checkpoint.
+ */
+const std::string CHECKPOINT_CONFIG_SUFFIX = ".config.json";
+
+/**
+ * This pass stores a checkpoint of the decompilation: the current LLVM module
+ * as bitcode, and the current config. The config holds everything from the
+ * providers that the conversion into HLL uses, and the mapping of LLVM
+ * instructions to assembly instructions is a part of the module.
+ * In pass manager, it should be placed right before LlvmIr2Hll.
+ */
+class CheckpointWriter : public ModulePass
+{
+	public:
+		static char ID;
+
+	public:
+		CheckpointWriter(const retdec::config::Config& config)
+				: ModulePass(ID)
+				, _config(config)
+		{
+
+		}
+
+		bool runOnModule(Module& M) override
+		{
+			auto path = _config.parameters.getCheckpointFile();
+
+			std::error_code ec;
+			ToolOutputFile out(path, ec, sys::fs::F_None);
+			if (ec)
+			{
+				throw std::runtime_error(
+					"failed to create checkpoint " + path + ": " + ec.message()
+				);
+			}
+			bool ShouldPreserveUseListOrder = true;
+			WriteBitcodeToFile(M, out.os(), ShouldPreserveUseListOrder);
+			out.keep();
+
+			_config.generateJsonFile(path + CHECKPOINT_CONFIG_SUFFIX);
+
+			return false;
+		}
+
+		llvm::StringRef getPassName() const override
+		{
+			return "Checkpoint writer";
+		}
+
+		void getAnalysisUsage(AnalysisUsage &AU) const override
+		{
+			AU.setPreservesAll();
+		}
+
+	private:
+		const retdec::config::Config& _config;
+};
+char CheckpointWriter::ID = 0;
+
+/**
+ * Load the LLVM module and the config stored by CheckpointWriter into
+ * the resume file from \p config.
+ *
+ * All but the parameters in \p config is replaced by the stored config.
+ * The parameters (e.g. output files, back-end options) stay as they are,
+ * only the results of the selective decompilation are taken from the stored
+ * config.
+ */
+std::unique_ptr<llvm::Module> loadCheckpoint(
+		llvm::LLVMContext& context,
+		retdec::config::Config& config)
+{
+	auto path = config.parameters.getResumeFile();
+
+	auto params = config.parameters;
+	try
+	{
+		config = retdec::config::Config::fromFile(
+				path + CHECKPOINT_CONFIG_SUFFIX);
+	}
+	catch (const retdec::config::Exception& e)
+	{
+		throw std::runtime_error(
+			"failed to load checkpoint config " + path
+			+ CHECKPOINT_CONFIG_SUFFIX + ": " + e.what()
+		);
+	}
+	params.selectedFunctions = config.parameters.selectedFunctions;
+	params.selectedNotFoundFunctions = config.parameters.selectedNotFoundFunctions;
+	params.selectedRanges = config.parameters.selectedRanges;
+	config.parameters = params;
+
+	llvm::SMDiagnostic Err;
+	auto M = parseIRFile(path, Err, context);
+	if (M == nullptr)
+	{
+		throw std::runtime_error(
+			"failed to load checkpoint " + path + ": " + Err.getMessage().str()
+		);
+	}
+	if (verifyModule(*M, &errs()))
+	{
+		throw std::runtime_error("checkpoint " + path + " is broken");
+	}
+
+	return M;
+}
+
 /**
  * Add the pass to the pass manager - no verification.
  */
@@ -430,6 +701,268 @@ static inline void addPass(
 
 }
 
+/**
+ * Limits of the LLVM optimizations of a single function, shared by all the
+ * groups of LLVM passes in the pipeline.
+ *
+ * Functions over the limits are demoted: they are optimized only by a cheap
+ * subset of the remaining LLVM passes. Giant (e.g. flattened or obfuscated)
+ * functions then cannot make passes like gvn or jump-threading take most of
+ * the decompilation time.
+ */
+class LlvmPassesBudget
+{
+	public:
+		LlvmPassesBudget(
+				uint64_t sizeLimit,
+				uint64_t timeLimit)
+				: _sizeLimit(sizeLimit)
+				, _timeLimit(timeLimit)
+		{
+
+		}
+
+		bool isEnabled() const
+		{
+			return _sizeLimit != 0 || _timeLimit.count() != 0;
+		}
+
+		/**
+		 * Demote the function @a f if it is over the size limit.
+		 * @return @c true if @a f is demoted (now or before).
+		 */
+		bool checkSize(Function& f)
+		{
+			if (isDemoted(f))
+			{
+				return true;
+			}
+
+			auto size = f.getInstructionCount();
+			if (_sizeLimit != 0 && size > _sizeLimit)
+			{
+				demote(f, std::to_string(size) + " instructions");
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * Demote the function @a f if its optimization took @a elapsed time,
+		 * which is over the time limit.
+		 */
+		void checkTime(Function& f, std::chrono::steady_clock::duration elapsed)
+		{
+			if (_timeLimit.count() != 0 && elapsed > _timeLimit)
+			{
+				auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+						elapsed);
+				demote(f, "optimized for " + std::to_string(ms.count()) + " ms");
+			}
+		}
+
+	private:
+		bool isDemoted(const Function& f) const
+		{
+			return _demoted.count(f.getName().str());
+		}
+
+		void demote(const Function& f, const std::string& reason)
+		{
+			_demoted.insert(f.getName().str());
+			Log::error() << Log::Warning << "Function " << f.getName().str()
+					<< " (" << reason << ") is over the budget, "
+					<< "it is optimized only by cheap LLVM passes from now on."
+					<< std::endl;
+		}
+
+	private:
+		/// Maximal number of instructions (0 means no limit).
+		uint64_t _sizeLimit = 0;
+		/// Maximal time of a group of passes (0 means no limit).
+		std::chrono::milliseconds _timeLimit;
+		/// Names of the demoted functions.
+		std::set<std::string> _demoted;
+};
+
+/**
+ * LLVM passes run on demoted functions. They are roughly linear in the size
+ * of the function, and still clean up the most of the decoded code.
+ */
+const std::set<std::string> CHEAP_LLVM_PASSES =
+{
+	"verify",
+	"mem2reg",
+	"instcombine",
+	"simplifycfg",
+	"early-cse",
+	"sccp",
+	"bdce",
+	"adce",
+};
+
+/**
+ * Can the pass be run function by function in LlvmFunctionPassGroup?
+ * Only LLVM (not RetDec) passes working on single functions can. Analyses
+ * (e.g. basicaa) and immutable passes (e.g. tbaa) stay in the module pass
+ * manager, so that module passes after the group can use them too.
+ */
+bool isFunctionLevelLlvmPass(Pass* p, const PassInfo* pi)
+{
+	if (utils::startsWith(pi->getPassArgument().str(), "retdec")
+			|| pi->isAnalysis())
+	{
+		return false;
+	}
+
+	switch (p->getPassKind())
+	{
+		case PT_Region:
+		case PT_Loop:
+		case PT_Function:
+			return true;
+		default:
+			return false;
+	}
+}
+
+/**
+ * Runs a group of consecutive function-level LLVM passes function by
+ * function, within the budget. Functions over the budget are optimized only
+ * by the cheap passes from the group.
+ *
+ * The function pass manager of the group does not see analyses of the module
+ * pass manager, so the analyses and immutable passes that precede the group
+ * are added to it as well.
+ */
+class LlvmFunctionPassGroup : public ModulePass
+{
+	public:
+		static char ID;
+
+	public:
+		LlvmFunctionPassGroup(
+				const std::vector<const PassInfo*>& analyses,
+				const std::vector<const PassInfo*>& passes,
+				const TargetLibraryInfoImpl& tlii,
+				LlvmPassesBudget& budget)
+				: ModulePass(ID)
+				, _analyses(analyses)
+				, _passes(passes)
+				, _tlii(tlii)
+				, _budget(budget)
+		{
+
+		}
+
+		bool runOnModule(Module& m) override
+		{
+			auto full = createPassManager(m, false);
+			auto cheap = createPassManager(m, true);
+
+			bool changed = full->doInitialization();
+			changed |= cheap->doInitialization();
+
+			for (Function& f : m)
+			{
+				if (f.isDeclaration())
+				{
+					continue;
+				}
+
+				if (_budget.checkSize(f))
+				{
+					changed |= cheap->run(f);
+					continue;
+				}
+
+				auto start = std::chrono::steady_clock::now();
+				changed |= full->run(f);
+				_budget.checkTime(f, std::chrono::steady_clock::now() - start);
+			}
+
+			changed |= full->doFinalization();
+			changed |= cheap->doFinalization();
+			return changed;
+		}
+
+		llvm::StringRef getPassName() const override
+		{
+			return "LLVM function pass group";
+		}
+
+	private:
+		std::unique_ptr<legacy::FunctionPassManager> createPassManager(
+				Module& m,
+				bool cheapOnly)
+		{
+			auto pm = std::make_unique<legacy::FunctionPassManager>(&m);
+
+			// The same as in the module pass manager, see decompile().
+			pm->add(new TargetLibraryInfoWrapperPass(_tlii));
+
+			for (auto* info : _analyses)
+			{
+				pm->add(info->createPass());
+			}
+			for (auto* info : _passes)
+			{
+				auto* pass = info->createPass();
+				if (cheapOnly
+						&& !CHEAP_LLVM_PASSES.count(info->getPassArgument().str()))
+				{
+					delete pass;
+					continue;
+				}
+				pm->add(pass);
+			}
+			return pm;
+		}
+
+	private:
+		/// Analyses and immutable passes that precede the group.
+		std::vector<const PassInfo*> _analyses;
+		std::vector<const PassInfo*> _passes;
+		const TargetLibraryInfoImpl& _tlii;
+		LlvmPassesBudget& _budget;
+};
+char LlvmFunctionPassGroup::ID = 0;
+
+std::vector<LlvmPassStep> getLlvmPassSteps(
+		const retdec::config::Parameters& params)
+{
+	auto& passRegistry = initializeLlvmPasses();
+	bool grouping = params.getLlvmPassesFunctionSizeLimit() != 0
+			|| params.getLlvmPassesFunctionTimeLimit() != 0;
+
+	std::vector<LlvmPassStep> steps;
+	for (auto& p : params.llvmPasses)
+	{
+		auto* info = passRegistry.getPassInfo(p);
+		if (info == nullptr)
+		{
+			throw std::runtime_error("cannot create pass: " + p);
+		}
+
+		if (grouping)
+		{
+			std::unique_ptr<Pass> pass(info->createPass());
+			if (isFunctionLevelLlvmPass(pass.get(), info))
+			{
+				if (steps.empty() || !steps.back().functionGroup)
+				{
+					steps.push_back({{}, true});
+				}
+				steps.back().passes.push_back(p);
+				continue;
+			}
+		}
+
+		steps.push_back({{p}, false});
+	}
+	return steps;
+}
+
 
 /**
  * TODO: this function has exact copy located in retdec-decompiler.cpp.
@@ -463,6 +996,7 @@ void setLogsFrom(const retdec::config::Parameters& params)
 bool decompile(retdec::config::Config& config, std::string* outString)
 {
 	setLogsFrom(config.parameters);
+	utils::setMaxThreadCount(config.parameters.getMaxThreads());
 
 	Log::phase("Initialization");
 	auto& passRegistry = initializeLlvmPasses();
@@ -470,8 +1004,15 @@ bool decompile(retdec::config::Config& config, std::string* outString)
 	// limitMaximalMemoryIfRequested(params);
 	// PrintAfterAll = true;
 
+	// When resuming from a checkpoint, all the passes before the conversion
+	// into HLL were already run on the stored module.
+	bool resume = !config.parameters.getResumeFile().empty();
+	bool checkpoint = !config.parameters.getCheckpointFile().empty();
+
 	auto context = std::make_unique<llvm::LLVMContext>();
-	auto module = createLlvmModule(*context);
+	auto module = resume
+			? loadCheckpoint(*context, config)
+			: createLlvmModule(*context);
 
 	// Create a PassManager to hold and optimize the collection of passes we
 	// are about to build.
@@ -487,29 +1028,74 @@ bool decompile(retdec::config::Config& config, std::string* outString)
 	TLII.disableAllFunctions();
 	pm.add(new TargetLibraryInfoWrapperPass(TLII));
 
-	for (auto& p : config.parameters.llvmPasses)
+	// With a budget, consecutive function-level LLVM passes are grouped and
+	// run function by function, so that the budget can be checked for each
+	// function.
+	LlvmPassesBudget budget(
+			config.parameters.getLlvmPassesFunctionSizeLimit(),
+			config.parameters.getLlvmPassesFunctionTimeLimit());
+	// Analyses and immutable passes added so far, see LlvmFunctionPassGroup.
+	std::vector<const PassInfo*> analyses;
+
+	for (auto& step : getLlvmPassSteps(config.parameters))
 	{
-		if (auto* info = passRegistry.getPassInfo(p))
+		if (step.functionGroup)
 		{
-			auto* pass = info->createPass();
-			addPass(pm, pass, info);
-
-			if (info->getTypeInfo() == &bin2llvmir::ProviderInitialization::ID)
+			if (resume)
 			{
-				auto* p = static_cast<bin2llvmir::ProviderInitialization*>(pass);
-				p->setConfig(&config);
+				continue;
 			}
-			if (info->getTypeInfo() == &llvmir2hll::LlvmIr2Hll::ID)
+
+			std::vector<const PassInfo*> group;
+			for (auto& p : step.passes)
 			{
-				auto* p = static_cast<llvmir2hll::LlvmIr2Hll*>(pass);
-				p->setConfig(&config);
-				p->setOutputString(outString);
+				group.push_back(passRegistry.getPassInfo(p));
 			}
+			pm.add(new ModulePassPrinter(
+					group.front()->getPassName().str(),
+					group.front()->getPassArgument().str()
+			));
+			pm.add(new LlvmFunctionPassGroup(analyses, group, TLII, budget));
+			continue;
 		}
-		else
+
+		auto* info = passRegistry.getPassInfo(step.passes.front());
+		bool isLlvmIr2Hll = info->getTypeInfo() == &llvmir2hll::LlvmIr2Hll::ID;
+		if (resume && !isLlvmIr2Hll)
 		{
-			throw std::runtime_error("cannot create pass: " + p);
+			continue;
 		}
+		resume = false;
+
+		auto* pass = info->createPass();
+		if (info->isAnalysis() || pass->getAsImmutablePass())
+		{
+			analyses.push_back(info);
+		}
+		if (checkpoint && isLlvmIr2Hll)
+		{
+			pm.add(new CheckpointWriter(config));
+		}
+		addPass(pm, pass, info);
+
+		if (info->getTypeInfo() == &bin2llvmir::ProviderInitialization::ID)
+		{
+			auto* p = static_cast<bin2llvmir::ProviderInitialization*>(pass);
+			p->setConfig(&config);
+		}
+		if (isLlvmIr2Hll)
+		{
+			auto* p = static_cast<llvmir2hll::LlvmIr2Hll*>(pass);
+			p->setConfig(&config);
+			p->setOutputString(outString);
+		}
+	}
+
+	if (resume)
+	{
+		throw std::runtime_error(
+			"cannot resume from checkpoint: retdec-llvmir2hll is not in LLVM passes"
+		);
 	}
 
 	// Now that we have all of the passes ready, run them.
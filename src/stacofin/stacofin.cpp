@@ -12,7 +12,7 @@
 #include "retdec/stacofin/stacofin.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/filesystem.h"
-#include "retdec/yaracpp/yara_detector.h"
+#include "retdec/yaracpp/yara_scan_session.h"
 
 /**
  * Set \c debug_enabled to \c true to enable this LOG macro.
@@ -695,6 +695,21 @@ const DetectedFunctionsPtrMap& Finder::getConfirmedDetections() const
 void Finder::search(
 	const Image& image,
 	const std::string& yaraFile)
+{
+	search(image, std::set<std::string>{yaraFile});
+}
+
+/**
+ * Search for static code in input file.
+ *
+ * All the signature files are matched by one scan of the loaded input file.
+ *
+ * @param image input file image
+ * @param yaraFiles static code signature files
+ */
+void Finder::search(
+	const retdec::loader::Image& image,
+	const std::set<std::string>& yaraFiles)
 {
 	// Get FileFormat instance.
 	const auto* fileFormat = image.getFileFormat();
@@ -703,18 +718,43 @@ void Finder::search(
 		return;
 	}
 
-	// Start Yara detector.
-	YaraDetector detector;
-	detector.addRuleFile(yaraFile);
-	auto inputBytes = fileFormat->getLoadedBytes();
-	detector.analyze(inputBytes);
-	if (!detector.isInValidState())
+	// Every signature file is a separate rule set, so that detections know
+	// their signature file.
+	const auto& inputBytes = fileFormat->getLoadedBytes();
+	YaraScanSession session(inputBytes.data(), inputBytes.size());
+	std::vector<std::pair<std::string, std::size_t>> ruleSets;
+	for (const auto& f : yaraFiles)
+	{
+		ruleSets.emplace_back(f, session.addRuleSet({f}));
+	}
+	if (!session.scan())
 	{
 		return;
 	}
 
+	for (const auto& ruleSet : ruleSets)
+	{
+		addDetections(
+				*fileFormat,
+				ruleSet.first,
+				session.getDetectedRules(ruleSet.second));
+	}
+}
+
+/**
+ * Add functions detected by rules from the given signature file.
+ *
+ * @param fileFormat input file
+ * @param yaraFile static code signature file
+ * @param detectedRules rules from @a yaraFile detected in input file
+ */
+void Finder::addDetections(
+	const retdec::fileformat::FileFormat& fileFormat,
+	const std::string& yaraFile,
+	const std::vector<YaraRule>& detectedRules)
+{
 	// Iterate over detected rules.
-	for (const YaraRule &detectedRule : detector.getDetectedRules())
+	for (const YaraRule &detectedRule : detectedRules)
 	{
 		DetectedFunction detectedFunction;
 		detectedFunction.signaturePath = yaraFile;
@@ -752,7 +792,7 @@ void Finder::search(
 			// This is different for every match.
 			detectedFunction.offset = ruleMatch.getOffset();
 			unsigned long long address = 0;
-			if (!fileFormat->getAddressFromOffset(
+			if (!fileFormat.getAddressFromOffset(
 						address, detectedFunction.offset))
 			{
 				// Cannot get address. Maybe report error?
@@ -770,22 +810,6 @@ void Finder::search(
 	}
 }
 
-/**
- * Search for static code in input file.
- *
- * @param image input file image
- * @param yaraFiles static code signature files
- */
-void Finder::search(
-	const retdec::loader::Image& image,
-	const std::set<std::string>& yaraFiles)
-{
-	for (const auto& f : yaraFiles)
-	{
-		search(image, f);
-	}
-}
-
 /**
  * Search for static code in input file based on information in config file.
  *
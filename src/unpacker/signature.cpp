@@ -73,6 +73,16 @@ uint64_t Signature::getCaptureSize() const
 	return count;
 }
 
+/**
+ * Returns the bytes of the signature.
+ *
+ * @return Bytes of the signature.
+ */
+const std::vector<Signature::Byte>& Signature::getBytes() const
+{
+	return _buffer;
+}
+
 /**
  * Matches the signature against the file using the specified settings. Matching is being done on section or segment which contains entry point.
  *
@@ -91,9 +101,9 @@ bool Signature::match(const Signature::MatchSettings& settings, retdec::loader::
 	seg->getBytes(bytesToMatch, settings.getOffset(), getSize() + settings.getSearchDistance());
 
 	if (settings.isSearch())
-		return searchMatchImpl(bytesToMatch, 0, settings.getSearchDistance(), nullptr);
+		return searchMatchImpl(bytesToMatch.data(), bytesToMatch.size(), 0, settings.getSearchDistance(), nullptr);
 
-	return (matchImpl(bytesToMatch, 0, nullptr) == static_cast<int64_t>(getSize()));
+	return (matchImpl(bytesToMatch.data(), bytesToMatch.size(), 0, nullptr) == static_cast<int64_t>(getSize()));
 }
 
 /**
@@ -107,9 +117,9 @@ bool Signature::match(const Signature::MatchSettings& settings, retdec::loader::
 bool Signature::match(const Signature::MatchSettings& settings, const DynamicBuffer& data) const
 {
 	if (settings.isSearch())
-		return searchMatchImpl(data.getBuffer(), settings.getOffset(), settings.getSearchDistance(), nullptr);
+		return searchMatchImpl(data.getRawBuffer(), data.getRealDataSize(), settings.getOffset(), settings.getSearchDistance(), nullptr);
 
-	return (matchImpl(data.getBuffer(), settings.getOffset(), nullptr) == static_cast<int64_t>(getSize()));
+	return (matchImpl(data.getRawBuffer(), data.getRealDataSize(), settings.getOffset(), nullptr) == static_cast<int64_t>(getSize()));
 }
 
 /**
@@ -132,9 +142,9 @@ bool Signature::match(const Signature::MatchSettings& settings, retdec::loader::
 	seg->getBytes(bytesToMatch, settings.getOffset(), getSize() + settings.getSearchDistance());
 
 	if (settings.isSearch())
-		return searchMatchImpl(bytesToMatch, 0, settings.getSearchDistance(), &capturedData);
+		return searchMatchImpl(bytesToMatch.data(), bytesToMatch.size(), 0, settings.getSearchDistance(), &capturedData);
 
-	return (matchImpl(bytesToMatch, 0, &capturedData) == static_cast<int64_t>(getSize()));
+	return (matchImpl(bytesToMatch.data(), bytesToMatch.size(), 0, &capturedData) == static_cast<int64_t>(getSize()));
 }
 
 /**
@@ -149,19 +159,19 @@ bool Signature::match(const Signature::MatchSettings& settings, retdec::loader::
 bool Signature::match(const Signature::MatchSettings& settings, const DynamicBuffer& data, DynamicBuffer& capturedData) const
 {
 	if (settings.isSearch())
-		return searchMatchImpl(data.getBuffer(), settings.getOffset(), settings.getSearchDistance(), &capturedData);
+		return searchMatchImpl(data.getRawBuffer(), data.getRealDataSize(), settings.getOffset(), settings.getSearchDistance(), &capturedData);
 
-	return (matchImpl(data.getBuffer(), settings.getOffset(), &capturedData) == static_cast<int64_t>(getSize()));
+	return (matchImpl(data.getRawBuffer(), data.getRealDataSize(), settings.getOffset(), &capturedData) == static_cast<int64_t>(getSize()));
 }
 
-bool Signature::searchMatchImpl(const std::vector<uint8_t>& bytesToMatch, uint64_t offset, uint64_t maxSearchDist, DynamicBuffer* capturedData) const
+bool Signature::searchMatchImpl(const uint8_t* bytesToMatch, uint64_t size, uint64_t offset, uint64_t maxSearchDist, DynamicBuffer* capturedData) const
 {
 	// Boyer-Moore search over whole bytesToMatch buffer
 	uint64_t searchOffset = 0;
 	while (searchOffset < maxSearchDist)
 	{
 		// Reverse comparison for the first right-most mismatch position in needle
-		int64_t mismatchPos = matchImpl(bytesToMatch, offset + searchOffset, capturedData);
+		int64_t mismatchPos = matchImpl(bytesToMatch, size, offset + searchOffset, capturedData);
 		if (mismatchPos == -1)
 			return false;
 
@@ -184,10 +194,10 @@ bool Signature::searchMatchImpl(const std::vector<uint8_t>& bytesToMatch, uint64
 	return false;
 }
 
-int64_t Signature::matchImpl(const std::vector<uint8_t>& bytesToMatch, uint64_t offset, DynamicBuffer* captureBuffer) const
+int64_t Signature::matchImpl(const uint8_t* bytesToMatch, uint64_t size, uint64_t offset, DynamicBuffer* captureBuffer) const
 {
 	// Bytes to match are not big enough to match this signature
-	if (bytesToMatch.size() - offset < getSize())
+	if (offset > size || size - offset < getSize())
 		return -1;
 
 	if (captureBuffer != nullptr)
@@ -0,0 +1,296 @@
+/**
+ * @file src/unpacker/signature_automaton.cpp
+ * @brief Definition of automaton for matching many signatures at once.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <queue>
+
+#include "retdec/unpacker/signature_automaton.h"
+
+using namespace retdec::utils;
+
+namespace retdec {
+namespace unpacker {
+
+namespace {
+
+/**
+ * Maximum number of bytes in the anchor of the signature.
+ */
+const uint64_t MAX_ANCHOR_SIZE = 16;
+
+} // anonymous namespace
+
+/**
+ * Constructor. Builds the automaton from the signatures.
+ *
+ * @param entries Signatures with their match settings ordered by their priority.
+ */
+SignatureAutomaton::SignatureAutomaton(const std::vector<Entry>& entries) : _entries(entries), _anchors(entries.size()),
+	_scanEnds(entries.size()), _states(1), _windowSize(0)
+{
+	uint64_t scanEnd = 0;
+	for (std::size_t i = 0; i < _entries.size(); ++i)
+	{
+		const auto& bytes = _entries[i].signature->getBytes();
+
+		// Longest run of exact bytes is the anchor
+		uint64_t runStart = 0;
+		for (uint64_t j = 0; j <= bytes.size(); ++j)
+		{
+			if (j < bytes.size() && bytes[j].getType() == Signature::Byte::Type::NORMAL)
+				continue;
+
+			if (j - runStart > _anchors[i].size)
+			{
+				_anchors[i].start = runStart;
+				_anchors[i].size = j - runStart;
+			}
+			runStart = j + 1;
+		}
+		_anchors[i].size = std::min(_anchors[i].size, MAX_ANCHOR_SIZE);
+
+		if (_anchors[i].size > 0)
+		{
+			addAnchor(i);
+			scanEnd = std::max(scanEnd, getPositions(i) - 1 + _anchors[i].start + _anchors[i].size);
+		}
+		else
+			_unanchored.push_back(i);
+
+		_scanEnds[i] = scanEnd;
+		_windowSize = std::max(_windowSize, getPositions(i) - 1 + bytes.size());
+	}
+
+	buildFailureTransitions();
+}
+
+/**
+ * Returns the number of bytes from the start of the data that can take part in any match.
+ *
+ * @return Size of the window.
+ */
+uint64_t SignatureAutomaton::getWindowSize() const
+{
+	return _windowSize;
+}
+
+/**
+ * Matches all signatures against the data. Data behave as if they were padded with zeroes up to the specified size.
+ *
+ * @param data Input data.
+ * @param physicalSize Number of bytes in data.
+ * @param size Number of bytes available for matching including the zero padding.
+ * @param capturedData Buffer where to capture the capture bytes of the matched signature, if any.
+ *
+ * @return Index of the matched signature, or @c NO_MATCH if no signature matched.
+ */
+std::size_t SignatureAutomaton::match(const uint8_t* data, uint64_t physicalSize, uint64_t size, DynamicBuffer* capturedData) const
+{
+	size = std::min(size, _windowSize);
+	physicalSize = std::min(physicalSize, size);
+
+	std::size_t best = NO_MATCH;
+	uint64_t bestPos = 0;
+	for (auto index : _unanchored)
+	{
+		for (uint64_t pos = 0; pos < getPositions(index); ++pos)
+		{
+			if (matchAt(index, data, physicalSize, size, pos))
+			{
+				best = index;
+				bestPos = pos;
+				break;
+			}
+		}
+
+		if (best != NO_MATCH)
+			break;
+	}
+
+	// Only the signatures with lower index than the best one are looked for
+	uint32_t state = 0;
+	uint64_t scanEnd = std::min(size, getScanEnd(best));
+	for (uint64_t i = 0; i < scanEnd; ++i)
+	{
+		state = findTransition(state, i < physicalSize ? data[i] : 0);
+		for (auto index : _states[state].anchors)
+		{
+			if (index >= best)
+				break;
+
+			// Anchor cannot lie before the start of the data
+			const Anchor& anchor = _anchors[index];
+			if (i + 1 < anchor.start + anchor.size)
+				continue;
+
+			uint64_t pos = i + 1 - anchor.start - anchor.size;
+			if (pos < getPositions(index) && matchAt(index, data, physicalSize, size, pos))
+			{
+				best = index;
+				bestPos = pos;
+				scanEnd = std::min(size, getScanEnd(best));
+				break;
+			}
+		}
+	}
+
+	if (best != NO_MATCH && capturedData != nullptr)
+	{
+		const Signature* signature = _entries[best].signature;
+		capturedData->setCapacity(signature->getCaptureSize());
+
+		uint64_t captureWritePos = 0;
+		const auto& bytes = signature->getBytes();
+		for (uint64_t i = 0; i < bytes.size(); ++i)
+		{
+			if (bytes[i].getType() == Signature::Byte::Type::CAPTURE)
+			{
+				uint64_t pos = bestPos + i;
+				capturedData->write<uint8_t>(pos < physicalSize ? data[pos] : 0, captureWritePos++);
+			}
+		}
+	}
+
+	return best;
+}
+
+/**
+ * Matches all signatures against the section or segment of the file which contains entry point. The bytes are
+ * read directly from the segment, without copying.
+ *
+ * @param offset Offset in the section or segment where to start matching.
+ * @param file Input file.
+ * @param capturedData Buffer where to capture the capture bytes of the matched signature, if any.
+ *
+ * @return Index of the matched signature, or @c NO_MATCH if no signature matched.
+ */
+std::size_t SignatureAutomaton::match(uint64_t offset, retdec::loader::Image* file, DynamicBuffer* capturedData) const
+{
+	const retdec::loader::Segment* seg = file->getEpSegment();
+	if (seg == nullptr || offset >= seg->getSize())
+		return NO_MATCH;
+
+	// Segment may contain less data than its size, the rest is filled with zeroes
+	auto rawData = seg->getRawData();
+	uint64_t size = seg->getSize() - offset;
+	if (rawData.first == nullptr || offset >= rawData.second)
+		return match(nullptr, 0, size, capturedData);
+
+	return match(rawData.first + offset, rawData.second - offset, size, capturedData);
+}
+
+/**
+ * Matches all signatures against the data buffer from its beginning.
+ *
+ * @param data Input data buffer.
+ * @param capturedData Buffer where to capture the capture bytes of the matched signature, if any.
+ *
+ * @return Index of the matched signature, or @c NO_MATCH if no signature matched.
+ */
+std::size_t SignatureAutomaton::match(const DynamicBuffer& data, DynamicBuffer* capturedData) const
+{
+	return match(data.getRawBuffer(), data.getRealDataSize(), data.getRealDataSize(), capturedData);
+}
+
+uint32_t SignatureAutomaton::findTransition(uint32_t state, uint8_t byte) const
+{
+	while (true)
+	{
+		const auto& next = _states[state].next;
+		auto it = std::lower_bound(next.begin(), next.end(), byte,
+				[](const std::pair<uint8_t, uint32_t>& transition, uint8_t value) { return transition.first < value; });
+		if (it != next.end() && it->first == byte)
+			return it->second;
+
+		if (state == 0)
+			return 0;
+
+		state = _states[state].fail;
+	}
+}
+
+void SignatureAutomaton::addAnchor(std::size_t index)
+{
+	const auto& bytes = _entries[index].signature->getBytes();
+	const Anchor& anchor = _anchors[index];
+
+	uint32_t state = 0;
+	for (uint64_t i = anchor.start; i < anchor.start + anchor.size; ++i)
+	{
+		uint8_t byte = bytes[i].getExpectedValue();
+		auto& next = _states[state].next;
+		auto it = std::lower_bound(next.begin(), next.end(), byte,
+				[](const std::pair<uint8_t, uint32_t>& transition, uint8_t value) { return transition.first < value; });
+		if (it != next.end() && it->first == byte)
+		{
+			state = it->second;
+			continue;
+		}
+
+		uint32_t newState = static_cast<uint32_t>(_states.size());
+		next.insert(it, std::make_pair(byte, newState));
+		_states.emplace_back();
+		state = newState;
+	}
+
+	_states[state].anchors.push_back(index);
+}
+
+void SignatureAutomaton::buildFailureTransitions()
+{
+	std::queue<uint32_t> queue;
+	for (const auto& transition : _states[0].next)
+		queue.push(transition.second);
+
+	while (!queue.empty())
+	{
+		uint32_t state = queue.front();
+		queue.pop();
+
+		// Failure states are closer to the root so their anchors are already complete
+		auto& anchors = _states[state].anchors;
+		const auto& failAnchors = _states[_states[state].fail].anchors;
+		anchors.insert(anchors.end(), failAnchors.begin(), failAnchors.end());
+		std::sort(anchors.begin(), anchors.end());
+
+		for (const auto& transition : _states[state].next)
+		{
+			_states[transition.second].fail = findTransition(_states[state].fail, transition.first);
+			queue.push(transition.second);
+		}
+	}
+}
+
+uint64_t SignatureAutomaton::getScanEnd(std::size_t best) const
+{
+	if (best == NO_MATCH)
+		return _scanEnds.empty() ? 0 : _scanEnds.back();
+
+	return best > 0 ? _scanEnds[best - 1] : 0;
+}
+
+uint64_t SignatureAutomaton::getPositions(std::size_t index) const
+{
+	return std::max<uint64_t>(_entries[index].searchDistance, 1);
+}
+
+bool SignatureAutomaton::matchAt(std::size_t index, const uint8_t* data, uint64_t physicalSize, uint64_t size, uint64_t pos) const
+{
+	const auto& bytes = _entries[index].signature->getBytes();
+	if (pos > size || size - pos < bytes.size())
+		return false;
+
+	for (uint64_t i = 0; i < bytes.size(); ++i)
+	{
+		if (bytes[i] != (pos + i < physicalSize ? data[pos + i] : 0))
+			return false;
+	}
+
+	return true;
+}
+
+} // namespace unpacker
+} // namespace retdec
@@ -4,6 +4,9 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <map>
+#include <mutex>
+
 #include "unpackertool/plugins/upx/upx_stub_signatures.h"
 
 using namespace retdec::fileformat;
@@ -1741,6 +1744,10 @@ const UpxStubData* UpxStubSignatures::matchSignatures(Image* file, DynamicBuffer
 	Architecture architecture = file->getFileFormat()->getTargetArchitecture();
 	Format format = file->getFileFormat()->getFileFormat();
 
+	// There are no stubs for unknown architecture or file format
+	if (architecture == Architecture::UNKNOWN || format == Format::UNKNOWN)
+		return nullptr;
+
 	// Find out whether file has entry point section or segment
 	const retdec::loader::Segment* epSeg = file->getEpSegment();
 	if (epSeg == nullptr)
@@ -1751,21 +1758,14 @@ const UpxStubData* UpxStubSignatures::matchSignatures(Image* file, DynamicBuffer
 	file->getFileFormat()->getEpAddress(ep);
 	ep -= epSeg->getAddress();
 
-	for (const UpxStubData& stubData : allStubs)
-	{
-		if (stubData.architecture != architecture || stubData.format != format)
-			continue;
-
-		Signature::MatchSettings settings(ep, stubData.searchDistance);
-		DynamicBuffer localCaptureData(file->getFileFormat()->getEndianness());
-		if (stubData.signature->match(settings, file, localCaptureData))
-		{
-			captureData = localCaptureData;
-			return &stubData;
-		}
-	}
+	const CompiledStubs& compiledStubs = getCompiledStubs(architecture, format);
+	DynamicBuffer localCaptureData(file->getFileFormat()->getEndianness());
+	std::size_t index = compiledStubs.automaton->match(ep, file, &localCaptureData);
+	if (index == SignatureAutomaton::NO_MATCH)
+		return nullptr;
 
-	return nullptr;
+	captureData = localCaptureData;
+	return compiledStubs.stubs[index];
 }
 
 /**
@@ -1783,22 +1783,49 @@ const UpxStubData* UpxStubSignatures::matchSignatures(Image* file, DynamicBuffer
 const UpxStubData* UpxStubSignatures::matchSignatures(const DynamicBuffer& data, DynamicBuffer& captureData,
 		retdec::fileformat::Architecture architecture /*= Architecture::UNKNOWN*/, retdec::fileformat::Format format /*= Format::UNKNOWN*/)
 {
+	const CompiledStubs& compiledStubs = getCompiledStubs(architecture, format);
+	DynamicBuffer localCaptureData(data.getEndianness());
+	std::size_t index = compiledStubs.automaton->match(data, &localCaptureData);
+	if (index == SignatureAutomaton::NO_MATCH)
+		return nullptr;
+
+	captureData = localCaptureData;
+	return compiledStubs.stubs[index];
+}
+
+/**
+ * Returns the unpacking stubs for the specified architecture and file format together with the automaton matching
+ * their signatures. The automaton is built on the first request and then shared by all later ones.
+ *
+ * @param architecture Architecture of the file. Unknown architecture selects stubs of all architectures.
+ * @param format File format of the file. Unknown file format selects stubs of all file formats.
+ *
+ * @return Compiled unpacking stubs.
+ */
+const UpxStubSignatures::CompiledStubs& UpxStubSignatures::getCompiledStubs(Architecture architecture, Format format)
+{
+	static std::mutex mutex;
+	static std::map<std::pair<Architecture, Format>, CompiledStubs> cache;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto itr = cache.find({architecture, format});
+	if (itr != cache.end())
+		return itr->second;
+
+	CompiledStubs& compiledStubs = cache[{architecture, format}];
+	std::vector<SignatureAutomaton::Entry> entries;
 	for (const UpxStubData& stubData : allStubs)
 	{
 		if ((architecture != Architecture::UNKNOWN && stubData.architecture != architecture)
 				|| (format != Format::UNKNOWN && stubData.format != format))
 			continue;
 
-		Signature::MatchSettings settings(0, stubData.searchDistance);
-		DynamicBuffer localCaptureData(data.getEndianness());
-		if (stubData.signature->match(settings, data, localCaptureData))
-		{
-			captureData = localCaptureData;
-			return &stubData;
-		}
+		compiledStubs.stubs.push_back(&stubData);
+		entries.push_back({ stubData.signature, stubData.searchDistance });
 	}
 
-	return nullptr;
+	compiledStubs.automaton = std::make_unique<SignatureAutomaton>(entries);
+	return compiledStubs;
 }
 
 } // namespace upx
@@ -7,10 +7,14 @@
 #ifndef UNPACKERTOOL_PLUGINS_UPX_UPX_STUB_SIGNATURES_H
 #define UNPACKERTOOL_PLUGINS_UPX_UPX_STUB_SIGNATURES_H
 
+#include <memory>
+#include <vector>
+
 #include "retdec/fileformat/fileformat.h"
 #include "retdec/loader/loader.h"
 #include "unpackertool/plugins/upx/upx_stub.h"
 #include "retdec/unpacker/signature.h"
+#include "retdec/unpacker/signature_automaton.h"
 
 using namespace retdec::utils;
 
@@ -60,8 +64,19 @@ public:
 			retdec::fileformat::Architecture architecture = retdec::fileformat::Architecture::UNKNOWN, retdec::fileformat::Format format = retdec::fileformat::Format::UNKNOWN);
 
 private:
+	/**
+	 * Unpacking stubs for single architecture and file format with their signatures compiled into one automaton.
+	 */
+	struct CompiledStubs
+	{
+		std::vector<const UpxStubData*> stubs; ///< Unpacking stubs in the order of @ref allStubs.
+		std::unique_ptr<retdec::unpacker::SignatureAutomaton> automaton; ///< Automaton matching signatures of the stubs.
+	};
+
 	UpxStubSignatures& operator =(const UpxStubSignatures&);
 
+	static const CompiledStubs& getCompiledStubs(retdec::fileformat::Architecture architecture, retdec::fileformat::Format format);
+
 	static std::vector<UpxStubData> allStubs; ///< All supported unpacking stubs.
 };
 
@@ -0,0 +1,44 @@
+/**
+* @file src/utils/parallel.cpp
+* @brief Implementation of the parallel processing of independent items.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include "retdec/utils/parallel.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+/// Requested maximal number of threads, 0 means number of hardware threads.
+std::atomic<std::size_t> maxThreadCount(0);
+
+} // anonymous namespace
+
+/**
+* @brief Set maximal number of threads used by parallelFor().
+*
+* @param count Number of threads. @c 0 means number of hardware threads (the
+*    default), @c 1 turns threading off.
+*/
+void setMaxThreadCount(std::size_t count)
+{
+	maxThreadCount = count;
+}
+
+/**
+* @brief Get maximal number of threads used by parallelFor() (at least 1).
+*/
+std::size_t getMaxThreadCount()
+{
+	std::size_t count = maxThreadCount;
+	if (count == 0)
+	{
+		count = std::thread::hardware_concurrency();
+	}
+	return std::max<std::size_t>(count, 1);
+}
+
+} // namespace utils
+} // namespace retdec
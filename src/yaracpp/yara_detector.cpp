@@ -67,6 +67,38 @@ struct Scanner<std::vector<std::uint8_t>>
 	}
 };
 
+/**
+ * Memory buffer which is not owned by the scanner.
+ */
+struct MemoryBuffer
+{
+	const std::uint8_t* data;
+	std::size_t size;
+};
+
+/**
+ * Specialization for scanning memory buffers which are not in vectors.
+ */
+template <>
+struct Scanner<MemoryBuffer>
+{
+	static bool scan(
+			YR_RULES* rules,
+			YR_CALLBACK_FUNC callback,
+			YaraDetector::CallbackSettings& settings,
+			const MemoryBuffer& buffer)
+	{
+		return yr_rules_scan_mem(
+				rules,
+				const_cast<uint8_t*>(buffer.data),
+				buffer.size,
+				0,
+				callback,
+				&settings, 0
+		) == ERROR_SUCCESS;
+	}
+};
+
 /**
  * Interface for Scanner. Provides template type deduction and
  * always passes correct type into Scanner template.
@@ -167,6 +199,24 @@ void YaraDetector::CallbackSettings::addUndetected(YaraRule &rule)
 	storedUndetected.push_back(rule);
 }
 
+/**
+ * Get stored detected rules
+ * @return Detected rules
+ */
+std::vector<YaraRule>& YaraDetector::CallbackSettings::getDetected()
+{
+	return storedDetected;
+}
+
+/**
+ * Get stored undetected rules
+ * @return Undetected rules
+ */
+std::vector<YaraRule>& YaraDetector::CallbackSettings::getUndetected()
+{
+	return storedUndetected;
+}
+
 /**
  * Check if storing of all rules (not only detected) is set
  * @return @c true if storing of all rules is set
@@ -226,6 +276,10 @@ int YaraDetector::yaraCallback(
 
 	YaraRule actual;
 	actual.setName(actRule->identifier);
+	if(actRule->ns && actRule->ns->name)
+	{
+		actual.setNameSpace(actRule->ns->name);
+	}
 	YR_META *meta;
 	yr_rule_metas_foreach(actRule, meta)
 	{
@@ -293,9 +347,10 @@ bool YaraDetector::addRules(const char *string)
  * Add external file with text rules
  * @param pathToFile Path to rule file
  * @param nameSpace Namespace to use for the given rule file. If the file is
- *                  already compiled, this has no effect. If it is a text file,
- *                  this allows to have multiple rules with the same ID across
- *                  multiple rule files.
+ *                  already compiled, its rules keep their namespaces, but
+ *                  detected rules are reported in this namespace (if it is
+ *                  not empty). If it is a text file, this allows to have
+ *                  multiple rules with the same ID across multiple rule files.
  */
 bool YaraDetector::addRuleFile(
 		const std::string &pathToFile,
@@ -306,6 +361,7 @@ bool YaraDetector::addRuleFile(
 	if (yr_rules_load(pathToFile.c_str(), &rules) == ERROR_SUCCESS)
 	{
 		precompiledRules.push_back(rules);
+		precompiledNameSpaces.push_back(nameSpace);
 	}
 	// If we didn't succeeded consider it as text file
 	else
@@ -337,6 +393,18 @@ bool YaraDetector::isInValidState() const
 	return stateIsValid;
 }
 
+/**
+ * Compile all added text rules
+ * @return @c true if the rules were compiled, otherwise @c false.
+ *
+ * Rules are otherwise compiled by the first call of analyze(). After this
+ * call, the const analyze() method can be used.
+ */
+bool YaraDetector::compileRules()
+{
+	return getCompiledRules() != nullptr;
+}
+
 /**
  * Analyze input file
  * @param pathToInputFile Path to input file
@@ -363,6 +431,60 @@ bool YaraDetector::analyze(std::vector<std::uint8_t> &bytes, bool storeAllRules)
 	return analyzeWithScan(bytes, storeAllRules);
 }
 
+/**
+ * Analyze input file and store results into the given vectors instead of
+ * into this instance
+ * @param pathToInputFile Path to input file
+ * @param detected Into this parameter detected rules are stored
+ * @param undetected Into this parameter undetected rules are stored
+ * @param storeAllRules If this parameter is set to @c true,
+ *                      store all rules (not only detected)
+ * @return @c true if analysis completed without any error, otherwise @c false.
+ *
+ * Rules must be compiled by compileRules() first. This method does not modify
+ * the instance, so one instance can be used by several threads at once.
+ */
+bool YaraDetector::analyze(
+		const std::string &pathToInputFile,
+		std::vector<YaraRule> &detected,
+		std::vector<YaraRule> &undetected,
+		bool storeAllRules) const
+{
+	if (needsRecompilation || !textFilesRules)
+		return false;
+
+	auto settings = CallbackSettings(storeAllRules, detected, undetected);
+	return scanWithRules(textFilesRules, pathToInputFile, settings);
+}
+
+/**
+ * Analyze input bytes and store results into the given vectors instead of
+ * into this instance
+ * @param data Input bytes
+ * @param size Number of input bytes
+ * @param detected Into this parameter detected rules are stored
+ * @param undetected Into this parameter undetected rules are stored
+ * @param storeAllRules If this parameter is set to @c true,
+ *                      store all rules (not only detected)
+ * @return @c true if analysis completed without any error, otherwise @c false.
+ *
+ * Bytes are not copied. As with the file variant, rules must be compiled by
+ * compileRules() first and the instance can be used by several threads.
+ */
+bool YaraDetector::analyze(
+		const std::uint8_t *data,
+		std::size_t size,
+		std::vector<YaraRule> &detected,
+		std::vector<YaraRule> &undetected,
+		bool storeAllRules) const
+{
+	if (needsRecompilation || !textFilesRules)
+		return false;
+
+	auto settings = CallbackSettings(storeAllRules, detected, undetected);
+	return scanWithRules(textFilesRules, MemoryBuffer{data, size}, settings);
+}
+
 /**
  * Get detected rules
  * @return Detected rules
@@ -401,13 +523,40 @@ bool YaraDetector::analyzeWithScan(T&& value, bool storeAllRules)
 	if (!(rules))
 		return false;
 
+	return scanWithRules(rules, std::forward<T>(value), settings);
+}
+
+/**
+ * Scan input sequence with compiled text rules and all precompiled rules
+ * @param rules Compiled rules from text files
+ * @param value Value to analyze
+ * @param settings Settings of callback function
+ * @return @c true if analysis completed without any error, otherwise @c false.
+ */
+template <typename T>
+bool YaraDetector::scanWithRules(
+		YR_RULES* rules,
+		T&& value,
+		CallbackSettings &settings) const
+{
 	if (!scan(rules, yaraCallback, settings, std::forward<T>(value)))
 		return false;
 
-	for (auto* rules : precompiledRules)
+	for (std::size_t i = 0; i < precompiledRules.size(); ++i)
 	{
-		if (!scan(rules, yaraCallback, settings, std::forward<T>(value)))
+		const auto detectedCount = settings.getDetected().size();
+		const auto undetectedCount = settings.getUndetected().size();
+		if (!scan(precompiledRules[i], yaraCallback, settings, std::forward<T>(value)))
 			return false;
+
+		// Report rules in the namespace the file was added with.
+		const auto& nameSpace = precompiledNameSpaces[i];
+		if (nameSpace.empty())
+			continue;
+		for (auto j = detectedCount; j < settings.getDetected().size(); ++j)
+			settings.getDetected()[j].setNameSpace(nameSpace);
+		for (auto j = undetectedCount; j < settings.getUndetected().size(); ++j)
+			settings.getUndetected()[j].setNameSpace(nameSpace);
 	}
 
 	return true;
@@ -20,6 +20,15 @@ const std::string &YaraRule::getName() const
 	return name;
 }
 
+/**
+ * Get namespace of this rule
+ * @return Namespace of rule
+ */
+const std::string &YaraRule::getNameSpace() const
+{
+	return nameSpace;
+}
+
 /**
  * Get selected meta related to this rule
  * @param id Name of selected meta
@@ -135,6 +144,15 @@ void YaraRule::setName(const std::string &ruleName)
 	name = ruleName;
 }
 
+/**
+ * Set namespace of rule
+ * @param ruleNameSpace Namespace of rule
+ */
+void YaraRule::setNameSpace(const std::string &ruleNameSpace)
+{
+	nameSpace = ruleNameSpace;
+}
+
 /**
  * Add meta
  * @param meta Meta related to this rule
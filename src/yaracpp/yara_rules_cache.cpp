@@ -0,0 +1,45 @@
+/**
+ * @file src/yaracpp/yara_rules_cache.cpp
+ * @brief Cache of compiled YARA rules shared by several threads.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include "retdec/yaracpp/yara_rules_cache.h"
+
+namespace retdec {
+namespace yaracpp {
+
+/**
+ * Get detector with compiled rules from the given files
+ * @param ruleFiles Paths to files with rules and their namespaces
+ * @return Detector ready for YaraDetector::analyze() const or @c nullptr if
+ *    the rules cannot be compiled
+ *
+ * Rule files are loaded and compiled by the first call for them. Files which
+ * cannot be loaded are skipped, as in YaraDetector::addRuleFile().
+ */
+const YaraDetector* YaraRulesCache::getDetector(const RuleFiles &ruleFiles)
+{
+	std::lock_guard<std::mutex> lock(detectorsMutex);
+
+	auto it = detectors.find(ruleFiles);
+	if (it == detectors.end())
+	{
+		auto detector = std::make_unique<YaraDetector>();
+		for (const auto &ruleFile : ruleFiles)
+		{
+			detector->addRuleFile(ruleFile.first, ruleFile.second);
+		}
+
+		if (!detector->isInValidState() || !detector->compileRules())
+		{
+			detector.reset();
+		}
+		it = detectors.emplace(ruleFiles, std::move(detector)).first;
+	}
+
+	return it->second.get();
+}
+
+} // namespace yaracpp
+} // namespace retdec
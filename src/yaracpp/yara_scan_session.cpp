@@ -0,0 +1,267 @@
+/**
+ * @file src/yaracpp/yara_scan_session.cpp
+ * @brief One YARA scan of a memory buffer shared by several rule sets.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+#include "retdec/yaracpp/yara_detector.h"
+#include "retdec/yaracpp/yara_rules_cache.h"
+#include "retdec/yaracpp/yara_scan_session.h"
+
+namespace retdec {
+namespace yaracpp {
+
+/**
+ * Constructor
+ * @param scannedData Data to scan
+ * @param scannedDataSize Size of @a scannedData
+ * @param rules Compiled rules shared with other sessions. If it is
+ *    @c nullptr, rules are compiled by this session.
+ */
+YaraScanSession::YaraScanSession(
+		const std::uint8_t *scannedData,
+		std::size_t scannedDataSize,
+		YaraRulesCache *rules)
+		: data(scannedData)
+		, dataSize(scannedDataSize)
+		, rulesCache(rules)
+{
+
+}
+
+/**
+ * Get index of rule file, add it if it is not known yet
+ * @param pathToFile Path to rule file
+ * @return Index of rule file
+ */
+std::size_t YaraScanSession::getRuleFileIndex(const std::string &pathToFile)
+{
+	auto it = std::find(ruleFiles.begin(), ruleFiles.end(), pathToFile);
+	if (it != ruleFiles.end())
+	{
+		return it - ruleFiles.begin();
+	}
+
+	ruleFiles.push_back(pathToFile);
+	return ruleFiles.size() - 1;
+}
+
+/**
+ * Get namespace of rules from the given rule file
+ * @param fileIndex Index of rule file
+ * @return Namespace
+ */
+std::string YaraScanSession::getNameSpace(std::size_t fileIndex)
+{
+	return "file_" + std::to_string(fileIndex);
+}
+
+/**
+ * Add rule set
+ * @param pathsToFiles Paths to files with rules
+ * @param storeAllRules If this parameter is set to @c true,
+ *                      store all rules (not only detected)
+ * @return ID of rule set for getDetectedRules() and getUndetectedRules()
+ *
+ * The buffer is scanned by the set by the next call of scan().
+ */
+std::size_t YaraScanSession::addRuleSet(
+		const std::vector<std::string> &pathsToFiles,
+		bool storeAllRules)
+{
+	RuleSet ruleSet;
+	ruleSet.storeAllRules = storeAllRules;
+	for (const auto &path : pathsToFiles)
+	{
+		const auto index = getRuleFileIndex(path);
+		if (std::find(ruleSet.files.begin(), ruleSet.files.end(), index)
+				== ruleSet.files.end())
+		{
+			ruleSet.files.push_back(index);
+		}
+	}
+
+	ruleSets.push_back(std::move(ruleSet));
+	return ruleSets.size() - 1;
+}
+
+/**
+ * Scan the buffer by all rule sets added since the last scan at once
+ * @return @c true if scan completed without any error, otherwise @c false.
+ *
+ * If rules of all the files cannot be compiled or scanned together (e.g. one
+ * of the files contains an error), every file is scanned by its own rules,
+ * so only rules of the broken files are missing from the results.
+ *
+ * Does nothing if there is no such set, so every user of the session can
+ * call it before it gets its results.
+ */
+bool YaraScanSession::scan()
+{
+	// Rule files scanned now and sets which contain them.
+	std::map<std::size_t, std::vector<std::size_t>> fileSets;
+	bool storeAllRules = false;
+	bool pending = false;
+	for (std::size_t i = 0; i < ruleSets.size(); ++i)
+	{
+		auto &ruleSet = ruleSets[i];
+		if (ruleSet.scanned)
+		{
+			continue;
+		}
+
+		pending = true;
+		ruleSet.scanned = true;
+		storeAllRules |= ruleSet.storeAllRules;
+		for (auto file : ruleSet.files)
+		{
+			fileSets[file].push_back(i);
+		}
+	}
+	if (!pending || fileSets.empty())
+	{
+		return true;
+	}
+
+	YaraRulesCache::RuleFiles files;
+	std::unordered_map<std::string, std::size_t> nameSpaces;
+	for (const auto &item : fileSets)
+	{
+		const auto nameSpace = getNameSpace(item.first);
+		files.emplace_back(ruleFiles[item.first], nameSpace);
+		nameSpaces.emplace(nameSpace, item.first);
+	}
+
+	std::vector<YaraRule> detected;
+	std::vector<YaraRule> undetected;
+	bool result = scanRuleFiles(files, storeAllRules, detected, undetected);
+	if (!result)
+	{
+		// One broken rule file must not break the scan by the others, so
+		// every file gets its own scan.
+		detected.clear();
+		undetected.clear();
+		result = true;
+		for (const auto &file : files)
+		{
+			result &= scanRuleFiles({file}, storeAllRules, detected, undetected);
+		}
+	}
+
+	for (const auto &rule : detected)
+	{
+		auto it = nameSpaces.find(rule.getNameSpace());
+		if (it == nameSpaces.end())
+		{
+			continue;
+		}
+
+		for (auto set : fileSets[it->second])
+		{
+			ruleSets[set].detected.push_back(rule);
+		}
+	}
+	for (const auto &rule : undetected)
+	{
+		auto it = nameSpaces.find(rule.getNameSpace());
+		if (it == nameSpaces.end())
+		{
+			continue;
+		}
+
+		for (auto set : fileSets[it->second])
+		{
+			if (ruleSets[set].storeAllRules)
+			{
+				ruleSets[set].undetected.push_back(rule);
+			}
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Scan the buffer by rules from the given files compiled together
+ * @param files Paths to rule files and their namespaces
+ * @param storeAllRules If this parameter is set to @c true,
+ *                      store all rules (not only detected)
+ * @param detected Into this parameter detected rules are added
+ * @param undetected Into this parameter undetected rules are added
+ * @return @c true if the rules were compiled and the scan completed without
+ *    any error, otherwise @c false (nothing is added to the vectors then).
+ */
+bool YaraScanSession::scanRuleFiles(
+		const YaraRulesCache::RuleFiles &files,
+		bool storeAllRules,
+		std::vector<YaraRule> &detected,
+		std::vector<YaraRule> &undetected) const
+{
+	std::unique_ptr<YaraDetector> localYara;
+	const YaraDetector *yara = nullptr;
+	if (rulesCache)
+	{
+		yara = rulesCache->getDetector(files);
+	}
+	else
+	{
+		localYara = std::make_unique<YaraDetector>();
+		for (const auto &file : files)
+		{
+			localYara->addRuleFile(file.first, file.second);
+		}
+		if (localYara->isInValidState() && localYara->compileRules())
+		{
+			yara = localYara.get();
+		}
+	}
+
+	std::vector<YaraRule> fileDetected;
+	std::vector<YaraRule> fileUndetected;
+	if (!yara || !yara->analyze(data, dataSize, fileDetected, fileUndetected, storeAllRules))
+	{
+		return false;
+	}
+
+	detected.insert(detected.end(), fileDetected.begin(), fileDetected.end());
+	undetected.insert(undetected.end(), fileUndetected.begin(), fileUndetected.end());
+	return true;
+}
+
+/**
+ * Check if the buffer was scanned by the given rule set
+ * @param ruleSet ID of rule set
+ * @return @c true if it was scanned, @c false otherwise
+ */
+bool YaraScanSession::isScanned(std::size_t ruleSet) const
+{
+	return ruleSet < ruleSets.size() && ruleSets[ruleSet].scanned;
+}
+
+/**
+ * Get rules of the given rule set detected by the last scan
+ * @param ruleSet ID of rule set
+ * @return Detected rules
+ */
+const std::vector<YaraRule>& YaraScanSession::getDetectedRules(std::size_t ruleSet) const
+{
+	return ruleSets.at(ruleSet).detected;
+}
+
+/**
+ * Get rules of the given rule set not detected by the last scan
+ * @param ruleSet ID of rule set
+ * @return Undetected rules (only if the set stores all rules)
+ */
+const std::vector<YaraRule>& YaraScanSession::getUndetectedRules(std::size_t ruleSet) const
+{
+	return ruleSets.at(ruleSet).undetected;
+}
+
+} // namespace yaracpp
+} // namespace retdec
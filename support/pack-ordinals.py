@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+
+"""Pack all the *.ord files into a single ordinal number database.
+Usage: pack-ordinals.py ordinals-path output-path
+    ordinals-path Path to the source ordinals directory (containing <arch>/<library>.ord files).
+    output-path   Path to the packed database to create.
+
+The layout of the database is described in
+include/retdec/fileformat/utils/ordinal_database.h.
+"""
+
+import os
+import struct
+import sys
+
+
+MAGIC = b'RDOD'
+VERSION = 1
+
+HEADER_FORMAT = '<4sIII'
+LIBRARY_FORMAT = '<IIII'
+ENTRY_FORMAT = '<III'
+
+
+def print_help():
+    print('Usage: %s ordinals-path output-path' % sys.argv[0])
+
+
+def get_arguments():
+    if len(sys.argv) != 3:
+        print_help()
+        sys.exit(1)
+    return sys.argv[1], sys.argv[2]
+
+
+def read_ord_file(path):
+    """ Read the given *.ord file into a dictionary {ordinal: name}.
+    Lines are in the form "<ordinal> <name>". When an ordinal is present more
+    than once, its last name wins, as in bin2llvmir.
+    """
+    ords = {}
+    with open(path, 'r', encoding='utf-8') as f:
+        for line in f:
+            parts = line.split()
+            if len(parts) < 2 or not parts[0].isdigit():
+                continue
+            ords[int(parts[0])] = parts[1]
+    return ords
+
+
+def read_ordinals(ordinals_dir):
+    """ Read all the *.ord files from the given directory into a dictionary
+    {'<arch>/<library>': {ordinal: name}}.
+    """
+    libraries = {}
+    for arch in sorted(os.listdir(ordinals_dir)):
+        arch_dir = os.path.join(ordinals_dir, arch)
+        if not os.path.isdir(arch_dir):
+            continue
+        for filename in sorted(os.listdir(arch_dir)):
+            library, ext = os.path.splitext(filename)
+            if ext != '.ord':
+                continue
+            ords = read_ord_file(os.path.join(arch_dir, filename))
+            if ords:
+                libraries[arch.lower() + '/' + library.lower()] = ords
+    return libraries
+
+
+def pack_ordinals(libraries):
+    """ Pack the given libraries into the binary database.
+    """
+    keys = sorted(libraries, key=lambda k: k.encode('utf-8'))
+    entry_count = sum(len(libraries[k]) for k in keys)
+
+    blob = bytearray()
+    blob_offsets = {}
+    blob_start = (struct.calcsize(HEADER_FORMAT)
+        + len(keys) * struct.calcsize(LIBRARY_FORMAT)
+        + entry_count * struct.calcsize(ENTRY_FORMAT))
+
+    def add_string(s):
+        data = s.encode('utf-8')
+        if data not in blob_offsets:
+            blob_offsets[data] = blob_start + len(blob)
+            blob.extend(data)
+        return blob_offsets[data], len(data)
+
+    library_table = bytearray()
+    entry_table = bytearray()
+    first_entry = 0
+    for key in keys:
+        ords = libraries[key]
+        offset, size = add_string(key)
+        library_table += struct.pack(LIBRARY_FORMAT, offset, size, first_entry, len(ords))
+        for ordinal in sorted(ords):
+            offset, size = add_string(ords[ordinal])
+            entry_table += struct.pack(ENTRY_FORMAT, ordinal, offset, size)
+        first_entry += len(ords)
+
+    header = struct.pack(HEADER_FORMAT, MAGIC, VERSION, len(keys), entry_count)
+    return bytes(header + library_table + entry_table + blob)
+
+
+def main():
+    ordinals_dir, output = get_arguments()
+    data = pack_ordinals(read_ordinals(ordinals_dir))
+
+    # Write to a temporary file first, so that nobody ever sees a partially
+    # written database.
+    tmp_output = output + '.tmp'
+    os.makedirs(os.path.dirname(os.path.abspath(output)), exist_ok=True)
+    with open(tmp_output, 'wb') as f:
+        f.write(data)
+    os.replace(tmp_output, output)
+
+    sys.exit(0)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,323 @@
+/**
+* @file tests/bin2llvmir/optimizations/decoder/decoder_tests.cpp
+* @brief Tests for the @c Decoder pass.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include "bin2llvmir/utils/llvmir_tests.h"
+#include "retdec/bin2llvmir/optimizations/decoder/decoder.h"
+#include "retdec/bin2llvmir/providers/abi/abi.h"
+
+using namespace ::testing;
+using namespace llvm;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+/**
+ * @brief Tests for the @c Decoder pass.
+ */
+class DecoderTests: public LlvmIrTests
+{
+	protected:
+		Decoder decoder;
+		Abi* abi = nullptr;
+
+		const std::string REGISTERS = R"(
+			@eax = internal global i32 0
+			@ebx = internal global i32 0
+			@zf = internal global i1 false
+			@fpu_stat_TOP = internal global i3 0
+			@mem = global i32 0
+			declare void @ext()
+		)";
+
+		void forwardRegisterValues(const std::string& code)
+		{
+			parseInput(REGISTERS + code);
+
+			auto c = config::Config::fromJsonString(R"({
+				"architecture" : {
+					"bitSize" : 32,
+					"endian" : "little",
+					"name" : "x86"
+				}
+			})");
+			auto* config = ConfigProvider::addConfig(module.get(), c);
+			abi = AbiProvider::addAbi(module.get(), config);
+			abi->addRegister(X86_REG_EAX, getGlobalByName("eax"));
+			abi->addRegister(X86_REG_EBX, getGlobalByName("ebx"));
+			abi->addRegister(X86_REG_ZF, getGlobalByName("zf"));
+			abi->addRegister(X87_REG_TOP, getGlobalByName("fpu_stat_TOP"));
+
+			decoder.forwardRegisterValues(*module, abi);
+		}
+};
+
+//
+// forwardRegisterValues()
+//
+
+TEST_F(DecoderTests, storedValueIsForwardedToLoads)
+{
+	forwardRegisterValues(R"(
+		define i32 @fnc() {
+		bb:
+			store i32 1, i32* @eax
+			%0 = load i32, i32* @eax
+			%1 = add i32 %0, 2
+			store i32 %1, i32* @ebx
+			store i1 true, i1* @zf
+			%2 = load i1, i1* @zf
+			%3 = load i32, i32* @ebx
+			%4 = select i1 %2, i32 %3, i32 %0
+			ret i32 %4
+		}
+	)");
+
+	std::string exp = REGISTERS + R"(
+		define i32 @fnc() {
+		bb:
+			store i32 1, i32* @eax
+			%0 = add i32 1, 2
+			store i32 %0, i32* @ebx
+			store i1 true, i1* @zf
+			%1 = select i1 true, i32 %0, i32 1
+			ret i32 %1
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(DecoderTests, loadedValueIsForwardedToNextLoads)
+{
+	forwardRegisterValues(R"(
+		define i32 @fnc() {
+		bb:
+			%0 = load i32, i32* @eax
+			%1 = load i32, i32* @eax
+			%2 = add i32 %0, %1
+			ret i32 %2
+		}
+	)");
+
+	std::string exp = REGISTERS + R"(
+		define i32 @fnc() {
+		bb:
+			%0 = load i32, i32* @eax
+			%1 = add i32 %0, %0
+			ret i32 %1
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(DecoderTests, overwrittenStoreIsRemovedWithItsDeadComputation)
+{
+	forwardRegisterValues(R"(
+		define void @fnc() {
+		bb:
+			%0 = load i32, i32* @ebx
+			%1 = mul i32 %0, 3
+			store i32 %1, i32* @eax
+			%2 = load i32, i32* @mem
+			store i32 %2, i32* @ebx
+			store i32 5, i32* @eax
+			store i32 6, i32* @ebx
+			ret void
+		}
+	)");
+
+	std::string exp = REGISTERS + R"(
+		define void @fnc() {
+		bb:
+			store i32 5, i32* @eax
+			store i32 6, i32* @ebx
+			ret void
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(DecoderTests, overwrittenStoreKeepsComputationWhichIsStillUsed)
+{
+	forwardRegisterValues(R"(
+		define i32 @fnc() {
+		bb:
+			%0 = load i32, i32* @mem
+			%1 = add i32 %0, 1
+			store i32 %1, i32* @eax
+			%2 = load i32, i32* @eax
+			store i32 %2, i32* @ebx
+			store i32 0, i32* @eax
+			ret i32 %2
+		}
+	)");
+
+	std::string exp = REGISTERS + R"(
+		define i32 @fnc() {
+		bb:
+			%0 = load i32, i32* @mem
+			%1 = add i32 %0, 1
+			store i32 %1, i32* @ebx
+			store i32 0, i32* @eax
+			ret i32 %1
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(DecoderTests, valuesAreNotForwardedAcrossCalls)
+{
+	forwardRegisterValues(R"(
+		define i32 @fnc() {
+		bb:
+			store i32 1, i32* @eax
+			call void @ext()
+			%0 = load i32, i32* @eax
+			store i32 2, i32* @eax
+			call void @ext()
+			store i32 3, i32* @eax
+			ret i32 %0
+		}
+	)");
+
+	std::string exp = REGISTERS + R"(
+		define i32 @fnc() {
+		bb:
+			store i32 1, i32* @eax
+			call void @ext()
+			%0 = load i32, i32* @eax
+			store i32 2, i32* @eax
+			call void @ext()
+			store i32 3, i32* @eax
+			ret i32 %0
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(DecoderTests, valuesAreNotForwardedThroughAccessOfOtherType)
+{
+	forwardRegisterValues(R"(
+		define i32 @fnc() {
+		bb:
+			store i32 1, i32* @eax
+			%0 = load i16, i16* bitcast (i32* @eax to i16*)
+			store i32 2, i32* @eax
+			store i16 3, i16* bitcast (i32* @eax to i16*)
+			%1 = load i32, i32* @eax
+			%2 = load i32, i32* @eax
+			%3 = add i32 %1, %2
+			ret i32 %3
+		}
+	)");
+
+	std::string exp = REGISTERS + R"(
+		define i32 @fnc() {
+		bb:
+			store i32 1, i32* @eax
+			%0 = load i16, i16* bitcast (i32* @eax to i16*)
+			store i32 2, i32* @eax
+			store i16 3, i16* bitcast (i32* @eax to i16*)
+			%1 = load i32, i32* @eax
+			%2 = add i32 %1, %1
+			ret i32 %2
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(DecoderTests, valuesAreNotForwardedToOtherBlocks)
+{
+	forwardRegisterValues(R"(
+		define i32 @fnc() {
+		bb:
+			store i32 1, i32* @eax
+			store i32 2, i32* @eax
+			br label %next
+		next:
+			%0 = load i32, i32* @eax
+			ret i32 %0
+		}
+	)");
+
+	std::string exp = REGISTERS + R"(
+		define i32 @fnc() {
+		bb:
+			store i32 2, i32* @eax
+			br label %next
+		next:
+			%0 = load i32, i32* @eax
+			ret i32 %0
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(DecoderTests, onlyGeneralPurposeAndFlagRegistersAreForwarded)
+{
+	forwardRegisterValues(R"(
+		define i32 @fnc() {
+		bb:
+			store i3 1, i3* @fpu_stat_TOP
+			%0 = load i3, i3* @fpu_stat_TOP
+			store i32 1, i32* @mem
+			%1 = load i32, i32* @mem
+			ret i32 %1
+		}
+	)");
+
+	std::string exp = REGISTERS + R"(
+		define i32 @fnc() {
+		bb:
+			store i3 1, i3* @fpu_stat_TOP
+			%0 = load i3, i3* @fpu_stat_TOP
+			store i32 1, i32* @mem
+			%1 = load i32, i32* @mem
+			ret i32 %1
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+
+	EXPECT_TRUE(decoder.isForwardableRegister(getGlobalByName("eax")));
+	EXPECT_TRUE(decoder.isForwardableRegister(getGlobalByName("zf")));
+	EXPECT_FALSE(decoder.isForwardableRegister(getGlobalByName("fpu_stat_TOP")));
+	EXPECT_FALSE(decoder.isForwardableRegister(getGlobalByName("mem")));
+}
+
+TEST_F(DecoderTests, forwardingMakesDecodedBlocksSmaller)
+{
+	// Typical decoded code: every instruction loads its operands from
+	// registers and stores its results (including flags) back.
+	forwardRegisterValues(R"(
+		define void @fnc() {
+		bb:
+			%0 = load i32, i32* @eax
+			%1 = load i32, i32* @ebx
+			%2 = add i32 %0, %1
+			%3 = icmp eq i32 %2, 0
+			store i1 %3, i1* @zf
+			store i32 %2, i32* @eax
+			%4 = load i32, i32* @eax
+			%5 = load i32, i32* @ebx
+			%6 = sub i32 %4, %5
+			%7 = icmp eq i32 %6, 0
+			store i1 %7, i1* @zf
+			store i32 %6, i32* @eax
+			%8 = load i32, i32* @eax
+			%9 = xor i32 %8, %8
+			%10 = icmp eq i32 %9, 0
+			store i1 %10, i1* @zf
+			store i32 %9, i32* @eax
+			ret void
+		}
+	)");
+
+	EXPECT_EQ(9, getFunctionByName("fnc")->getInstructionCount());
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
@@ -0,0 +1,252 @@
+/**
+* @file tests/bin2llvmir/optimizations/idioms/idioms_analysis_tests.cpp
+* @brief Tests for the @c IdiomsAnalysis.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include "retdec/bin2llvmir/optimizations/idioms/idioms_analysis.h"
+#include "bin2llvmir/utils/llvmir_tests.h"
+
+using namespace ::testing;
+using namespace llvm;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+/**
+ * @brief Tests for the @c IdiomsAnalysis.
+ */
+class IdiomsAnalysisTests: public LlvmIrTests
+{
+	protected:
+		bool runIdioms(CC_compiler cc, CC_arch arch)
+		{
+			IdiomsAnalysis idioms(module.get(), cc, arch);
+			return idioms.doAnalysis(*getFunctionByName("fnc"), nullptr);
+		}
+};
+
+//
+// analyse(BasicBlock&)
+//
+
+TEST_F(IdiomsAnalysisTests, blockWithoutIdiomsIsNotChanged)
+{
+	parseInput(R"(
+		define i32 @fnc(i32 %x, i32 %y) {
+			%a = add i32 %x, %y
+			%b = mul i32 %a, %x
+			ret i32 %b
+		}
+	)");
+
+	// There are no multi-block idioms for LLVM, so the result depends only
+	// on the basic-block idioms.
+	EXPECT_FALSE(runIdioms(CC_LLVM, ARCH_ANY));
+
+	std::string exp = R"(
+		define i32 @fnc(i32 %x, i32 %y) {
+			%a = add i32 %x, %y
+			%b = mul i32 %a, %x
+			ret i32 %b
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(IdiomsAnalysisTests, allIdiomsInBlockAreExchanged)
+{
+	parseInput(R"(
+		define i32 @fnc(i32 %x, i32 %y) {
+			%a = shl i32 %x, 2
+			%b = lshr i32 %y, 3
+			%c = add i32 %a, %b
+			%d = shl i32 %c, 1
+			ret i32 %d
+		}
+	)");
+
+	EXPECT_TRUE(runIdioms(CC_ANY, ARCH_ANY));
+
+	std::string exp = R"(
+		define i32 @fnc(i32 %x, i32 %y) {
+			%a = mul i32 %x, 4
+			%b = udiv i32 %y, 8
+			%c = add i32 %a, %b
+			%d = mul i32 %c, 2
+			ret i32 %d
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(IdiomsAnalysisTests, idiomsAreExchangedInAllBlocks)
+{
+	parseInput(R"(
+		define i32 @fnc(i32 %x) {
+		first:
+			%a = shl i32 %x, 2
+			br label %second
+		second:
+			%b = shl i32 %a, 3
+			ret i32 %b
+		}
+	)");
+
+	EXPECT_TRUE(runIdioms(CC_ANY, ARCH_ANY));
+
+	std::string exp = R"(
+		define i32 @fnc(i32 %x) {
+		first:
+			%a = mul i32 %x, 4
+			br label %second
+		second:
+			%b = mul i32 %a, 8
+			ret i32 %b
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(IdiomsAnalysisTests, exchangerErasingPrecedingOperandsKeepsOtherIdioms)
+{
+	// ((X u>> 31) ^ 1) --> X >= 0 erases the lshr, which would be an idiom
+	// on its own. Idioms before and after it are exchanged as well.
+	parseInput(R"(
+		define i32 @fnc(i32 %x, i32 %y) {
+			%u = lshr i32 %y, 3
+			%a = lshr i32 %x, 31
+			%b = xor i32 %a, 1
+			%c = shl i32 %b, 2
+			%d = add i32 %c, %u
+			ret i32 %d
+		}
+	)");
+
+	EXPECT_TRUE(runIdioms(CC_ANY, ARCH_ANY));
+
+	std::string exp = R"(
+		define i32 @fnc(i32 %x, i32 %y) {
+			%u = udiv i32 %y, 8
+			%1 = icmp sge i32 %x, 0
+			%b = zext i1 %1 to i32
+			%c = mul i32 %b, 4
+			%d = add i32 %c, %u
+			ret i32 %d
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(IdiomsAnalysisTests, exchangerErasingSeveralPrecedingOperands)
+{
+	// 0 - (((X u>> 31) + X) s>> 1) --> X / -2
+	parseInput(R"(
+		define i32 @fnc(i32 %x, i32 %y) {
+			%u = shl i32 %y, 1
+			%a = lshr i32 %x, 31
+			%b = add i32 %a, %x
+			%c = ashr i32 %b, 1
+			%d = sub i32 0, %c
+			%e = add i32 %d, %u
+			ret i32 %e
+		}
+	)");
+
+	EXPECT_TRUE(runIdioms(CC_GCC, ARCH_MIPS));
+
+	std::string exp = R"(
+		define i32 @fnc(i32 %x, i32 %y) {
+			%u = mul i32 %y, 2
+			%d = sdiv i32 %x, -2
+			%e = add i32 %d, %u
+			ret i32 %e
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+//
+// initBasicBlockIdioms()
+//
+
+TEST_F(IdiomsAnalysisTests, complexIdiomIsExchangedBeforeItsParts)
+{
+	// Only the lshr is an idiom for LLVM, (X u>> 31) ^ 1 is not.
+	parseInput(R"(
+		define i32 @fnc(i32 %x) {
+			%a = lshr i32 %x, 31
+			%b = xor i32 %a, 1
+			ret i32 %b
+		}
+	)");
+
+	EXPECT_TRUE(runIdioms(CC_LLVM, ARCH_x86));
+
+	std::string exp = R"(
+		define i32 @fnc(i32 %x) {
+			%1 = icmp slt i32 %x, 0
+			%a = zext i1 %1 to i32
+			%b = xor i32 %a, 1
+			ret i32 %b
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(IdiomsAnalysisTests, idiomsOfOtherCompilerAreNotExchanged)
+{
+	parseInput(R"(
+		define i32 @fnc(i32 %x) {
+			%a = or i32 %x, -1
+			ret i32 %a
+		}
+	)");
+
+	EXPECT_FALSE(runIdioms(CC_LLVM, ARCH_x86));
+
+	std::string exp = R"(
+		define i32 @fnc(i32 %x) {
+			%a = or i32 %x, -1
+			ret i32 %a
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(IdiomsAnalysisTests, idiomsOfCompilerAndArchitectureAreExchanged)
+{
+	parseInput(R"(
+		define i32 @fnc(i32 %x) {
+			%a = or i32 %x, -1
+			ret i32 %a
+		}
+	)");
+
+	EXPECT_TRUE(runIdioms(CC_VStudio, ARCH_x86));
+
+	std::string exp = R"(
+		define i32 @fnc(i32 %x) {
+			%a = add i32 0, -1
+			ret i32 %a
+		}
+	)";
+	checkModuleAgainstExpectedIr(exp);
+}
+
+TEST_F(IdiomsAnalysisTests, idiomsOfOtherArchitectureAreNotExchanged)
+{
+	parseInput(R"(
+		define i32 @fnc(i32 %x) {
+			%a = or i32 %x, -1
+			ret i32 %a
+		}
+	)");
+
+	EXPECT_FALSE(runIdioms(CC_VStudio, ARCH_ARM));
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
@@ -10,6 +10,7 @@
 #include "retdec/bin2llvmir/providers/demangler.h"
 
 #include "retdec/bin2llvmir/optimizations/param_return/param_return.h"
+#include "retdec/utils/parallel.h"
 #include "bin2llvmir/utils/llvmir_tests.h"
 
 using namespace ::testing;
@@ -26,6 +27,74 @@ class ParamReturnTests: public LlvmIrTests
 {
 	protected:
 		ParamReturn pass;
+
+		/**
+		 * Run the pass on x86 module with @a count functions which call
+		 * declared and indirect functions with values stored on the stack,
+		 * using at most @a threads threads.
+		 * @return Resulting module.
+		 */
+		std::string runOnManyFunctions(std::size_t count, std::size_t threads)
+		{
+			std::string ir = R"(
+				@r = global i32 0
+				declare void @print()
+			)";
+			std::string functions;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				auto n = std::to_string(i);
+				ir += "define void @fnc" + n + R"(() {
+					%stack_-4 = alloca i32
+					%stack_-8 = alloca i32
+					store i32 )" + n + R"(, i32* %stack_-4
+					store i32 456, i32* %stack_-8
+					call void @print()
+					%a = bitcast i32* @r to void()*
+					store i32 789, i32* %stack_-4
+					call void %a()
+					ret void
+				}
+				)";
+				functions += std::string(functions.empty() ? "" : ",") + R"({
+					"name" : "fnc)" + n + R"(",
+					"startAddr" : ")" + std::to_string(0x1000 + i) + R"(",
+					"locals" : [
+						{
+							"name" : "stack_-4",
+							"storage" : { "type" : "stack", "value" : -4 }
+						},
+						{
+							"name" : "stack_-8",
+							"storage" : { "type" : "stack", "value" : -8 }
+						}
+					]
+				})";
+			}
+			parseInput(ir);
+			auto c = config::Config::fromJsonString(R"({
+				"architecture" : {
+					"bitSize" : 32,
+					"endian" : "little",
+					"name" : "x86"
+				},
+				"functions" : [)" + functions + R"(]
+			})");
+			auto config = Config::fromConfig(module.get(), c);
+			auto abi = AbiProvider::addAbi(module.get(), &config);
+			auto typeConfig = std::make_unique<ctypesparser::TypeConfig>();
+			auto demangler = DemanglerProvider::addDemangler(
+				module.get(),
+				&config,
+				std::move(typeConfig));
+
+			utils::setMaxThreadCount(threads);
+			ParamReturn p;
+			p.runOnModuleCustom(*module, &config, abi, demangler);
+			utils::setMaxThreadCount(0);
+
+			return llvmObjToString(module.get());
+		}
 };
 
 //
@@ -96,6 +165,34 @@ TEST_F(ParamReturnTests, x86PtrCallBasicFunctionality)
 	checkModuleAgainstExpectedIr(exp);
 }
 
+TEST_F(ParamReturnTests, x86ParallelCollectionGivesSameResultAsSequential)
+{
+	const std::size_t count = 64;
+	auto sequential = runOnManyFunctions(count, 1);
+	auto parallel = runOnManyFunctions(count, 8);
+
+	EXPECT_EQ(sequential, parallel);
+
+	// Every function passes its own stack values to both calls.
+	parseInput(parallel);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto* f = getFunctionByName("fnc" + std::to_string(i));
+		ASSERT_NE(nullptr, f);
+		std::size_t calls = 0;
+		for (auto& b : *f)
+		for (auto& inst : b)
+		{
+			if (auto* call = dyn_cast<CallInst>(&inst))
+			{
+				EXPECT_EQ(2, call->getNumArgOperands());
+				++calls;
+			}
+		}
+		EXPECT_EQ(2, calls);
+	}
+}
+
 TEST_F(ParamReturnTests, x86PtrCallPrevBbIsUsedOnlyIfItIsASinglePredecessor)
 {
 	parseInput(R"(
@@ -0,0 +1,130 @@
+/**
+* @file tests/bin2llvmir/optimizations/simple_types/simple_types_tests.cpp
+* @brief Tests for the union-find solver of the @c SimpleTypesAnalysis pass.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include "bin2llvmir/utils/llvmir_tests.h"
+#include "retdec/bin2llvmir/optimizations/simple_types/simple_types.h"
+
+using namespace ::testing;
+using namespace llvm;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+/**
+ * @brief Tests for the @c TypeClasses class.
+ */
+class TypeClassesTests: public LlvmIrTests
+{
+	protected:
+		TypeClasses classes;
+};
+
+TEST_F(TypeClassesTests, valueIsInsertedOnlyOnce)
+{
+	parseInput(R"(
+		@a = global i32 0
+	)");
+	auto c = Config::empty(module.get());
+	auto* a = getGlobalByName("a");
+
+	bool inserted = false;
+	auto id1 = classes.insert(module.get(), &c, a, &inserted);
+	EXPECT_TRUE(inserted);
+	auto id2 = classes.insert(module.get(), &c, a, &inserted);
+	EXPECT_FALSE(inserted);
+
+	EXPECT_EQ(id1, id2);
+	EXPECT_TRUE(classes.contains(a));
+	EXPECT_EQ(1u, classes.size());
+	EXPECT_EQ(Type::getInt32Ty(context), classes.getType(id1).type);
+}
+
+TEST_F(TypeClassesTests, unitedClassesHaveTheHigherType)
+{
+	parseInput(R"(
+		@a = global i32 0
+		@b = global float* null
+		@c = global i16 0
+	)");
+	auto c = Config::empty(module.get());
+	auto idA = classes.insert(module.get(), &c, getGlobalByName("a"));
+	auto idB = classes.insert(module.get(), &c, getGlobalByName("b"));
+	auto idC = classes.insert(module.get(), &c, getGlobalByName("c"));
+
+	classes.unite(module.get(), idA, idB);
+
+	EXPECT_EQ(classes.find(idA), classes.find(idB));
+	EXPECT_NE(classes.find(idA), classes.find(idC));
+	EXPECT_EQ(
+			PointerType::get(Type::getFloatTy(context), 0),
+			classes.getType(idA).type);
+	EXPECT_EQ(classes.getType(idA).type, classes.getType(idB).type);
+	EXPECT_EQ(Type::getInt16Ty(context), classes.getType(idC).type);
+}
+
+TEST_F(TypeClassesTests, typeWithHigherPriorityWins)
+{
+	parseInput(R"(
+		@a = global float* null
+	)");
+	auto c = Config::empty(module.get());
+	auto id = classes.insert(module.get(), &c, getGlobalByName("a"));
+
+	classes.insert(
+			module.get(),
+			id,
+			Type::getInt8Ty(context),
+			eSourcePriority::PRIORITY_LTI);
+
+	EXPECT_EQ(Type::getInt8Ty(context), classes.getType(id).type);
+	EXPECT_EQ(eSourcePriority::PRIORITY_LTI, classes.getType(id).priority);
+}
+
+TEST_F(TypeClassesTests, classesWithSingleValueAndTypeAreTrivial)
+{
+	parseInput(R"(
+		@a = global i32 0
+		@b = global i32 0
+		@c = global i32 0
+	)");
+	auto c = Config::empty(module.get());
+	auto idA = classes.insert(module.get(), &c, getGlobalByName("a"));
+	auto idB = classes.insert(module.get(), &c, getGlobalByName("b"));
+	auto idC = classes.insert(module.get(), &c, getGlobalByName("c"));
+
+	classes.insert(module.get(), idA, Type::getInt8Ty(context));
+	classes.insert(module.get(), idB, Type::getInt8Ty(context));
+	classes.insert(module.get(), idB, Type::getInt16Ty(context));
+	classes.unite(module.get(), idC, idC);
+
+	EXPECT_TRUE(classes.isTrivial(idA));
+	EXPECT_FALSE(classes.isTrivial(idB));
+	EXPECT_TRUE(classes.isTrivial(idC));
+
+	classes.unite(module.get(), idA, idC);
+
+	EXPECT_FALSE(classes.isTrivial(idA));
+	EXPECT_FALSE(classes.isTrivial(idC));
+}
+
+TEST_F(TypeClassesTests, clearRemovesAllValues)
+{
+	parseInput(R"(
+		@a = global i32 0
+	)");
+	auto c = Config::empty(module.get());
+	classes.insert(module.get(), &c, getGlobalByName("a"));
+
+	classes.clear();
+
+	EXPECT_FALSE(classes.contains(getGlobalByName("a")));
+	EXPECT_EQ(0u, classes.size());
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
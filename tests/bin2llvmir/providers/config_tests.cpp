@@ -64,6 +64,43 @@ TEST_F(ConfigTests, getConfigFunctionReturnsNullptrIfFunctionNotFound)
 	EXPECT_NE(&(*p.first), configFnc1);
 }
 
+TEST_F(ConfigTests, getConfigFunctionReturnsNullptrIfFunctionErased)
+{
+	parseInput(R"(
+		define void @fnc() {
+			ret void
+		}
+	)");
+	Function* llvmFnc = getFunctionByName("fnc");
+	auto config = Config::empty(module.get());
+	config.getConfig().functions.insert(retdec::common::Function("fnc"));
+	auto* configFnc1 = config.getConfigFunction(llvmFnc);
+	config.getConfig().functions.erase(retdec::common::Function("fnc"));
+	auto* configFnc2 = config.getConfigFunction(llvmFnc);
+
+	EXPECT_NE(nullptr, configFnc1);
+	EXPECT_EQ(nullptr, configFnc2);
+}
+
+TEST_F(ConfigTests, getConfigFunctionGetsFunctionOfRenamedLlvmFunction)
+{
+	parseInput(R"(
+		define void @fnc() {
+			ret void
+		}
+	)");
+	Function* llvmFnc = getFunctionByName("fnc");
+	auto config = Config::empty(module.get());
+	auto p1 = config.getConfig().functions.insert(retdec::common::Function("fnc"));
+	auto p2 = config.getConfig().functions.insert(retdec::common::Function("renamed"));
+	auto* configFnc1 = config.getConfigFunction(llvmFnc);
+	llvmFnc->setName("renamed");
+	auto* configFnc2 = config.getConfigFunction(llvmFnc);
+
+	EXPECT_EQ(&(*p1.first), configFnc1);
+	EXPECT_EQ(&(*p2.first), configFnc2);
+}
+
 //
 // getLlvmFunction
 //
@@ -177,6 +177,22 @@ class Capstone2LlvmIrTranslatorX86Tests :
 			return dynamic_cast<Capstone2LlvmIrTranslatorX86*>(_translator.get());
 		}
 
+		std::size_t countRegisterStores(uint32_t reg)
+		{
+			auto* gv = getRegister(reg);
+			std::size_t cnt = 0;
+			for (llvm::inst_iterator I = llvm::inst_begin(_function),
+					E = llvm::inst_end(_function); I != E; ++I)
+			{
+				auto* s = dyn_cast<StoreInst>(&*I);
+				if (s && s->getPointerOperand() == gv)
+				{
+					++cnt;
+				}
+			}
+			return cnt;
+		}
+
 	// Some of these (or their parts) might be moved to abstract parent class.
 	//
 	protected:
@@ -13636,6 +13652,69 @@ TEST_P(Capstone2LlvmIrTranslatorX86Tests, X86_INS_FXTRACT)
 	});
 }
 
+//
+// Lazy flags mode
+//
+
+TEST_P(Capstone2LlvmIrTranslatorX86Tests, LAZY_FLAGS_overwritten_flags_are_removed)
+{
+	ALL_MODES;
+
+	getX86Translator()->setLazyFlags(true);
+
+	setRegisters({
+		{X86_REG_CX, 0x1200},
+	});
+
+	emulate("add cx, 0x34; sub cx, 0x1234");
+
+	EXPECT_JUST_REGISTERS_LOADED({X86_REG_CX});
+	EXPECT_JUST_REGISTERS_STORED({
+		{X86_REG_CX, 0x0ULL},
+		{X86_REG_PF, true},
+		{X86_REG_SF, false},
+		{X86_REG_ZF, true},
+		{X86_REG_OF, false},
+		{X86_REG_AF, false},
+		{X86_REG_CF, false},
+	});
+	for (auto f : {X86_REG_CF, X86_REG_PF, X86_REG_AF,
+			X86_REG_ZF, X86_REG_SF, X86_REG_OF})
+	{
+		EXPECT_EQ(1u, countRegisterStores(f)) << dumpFunction(_function);
+	}
+	EXPECT_NO_MEMORY_LOADED_STORED();
+	EXPECT_NO_VALUE_CALLED();
+}
+
+TEST_P(Capstone2LlvmIrTranslatorX86Tests, LAZY_FLAGS_read_flags_are_kept)
+{
+	ALL_MODES;
+
+	getX86Translator()->setLazyFlags(true);
+
+	setRegisters({
+		{X86_REG_CX, 0xffff},
+	});
+
+	emulate("add cx, 1; adc cx, 0");
+
+	EXPECT_JUST_REGISTERS_LOADED({X86_REG_CX, X86_REG_CF});
+	EXPECT_JUST_REGISTERS_STORED({
+		{X86_REG_CX, 0x1ULL},
+		{X86_REG_PF, false},
+		{X86_REG_SF, false},
+		{X86_REG_ZF, false},
+		{X86_REG_OF, false},
+		{X86_REG_AF, false},
+		{X86_REG_CF, false},
+	});
+	EXPECT_EQ(2u, countRegisterStores(X86_REG_CF)) << dumpFunction(_function);
+	EXPECT_EQ(1u, countRegisterStores(X86_REG_ZF)) << dumpFunction(_function);
+	EXPECT_NO_MEMORY_LOADED_STORED();
+	EXPECT_NO_VALUE_CALLED();
+}
+
 //
 // TODO:
 // X86_INS_STOSB, X86_INS_STOSW, X86_INS_STOSD, X86_INS_STOSQ
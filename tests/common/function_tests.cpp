@@ -74,6 +74,87 @@ TEST_F(FunctionContainerTests, TestGetFunctionByStartAddress)
 	ASSERT_TRUE(n == nullptr);
 }
 
+TEST_F(FunctionContainerTests, TestGetFunctionByStartAddressAfterErase)
+{
+	funcs.erase(fnc4);
+
+	EXPECT_EQ(nullptr, funcs.getFunctionByStartAddress(fnc4.getStart()));
+	EXPECT_EQ(nullptr, funcs.getFunctionByName(fnc4.getName()));
+	auto* f = funcs.getFunctionByStartAddress(fnc3.getStart());
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_EQ( fnc3.getName(), f->getName() );
+}
+
+TEST_F(FunctionContainerTests, TestGetFunctionByStartAddressAfterClear)
+{
+	funcs.clear();
+
+	EXPECT_EQ(nullptr, funcs.getFunctionByStartAddress(fnc1.getStart()));
+}
+
+TEST_F(FunctionContainerTests, TestGetFunctionByStartAddressReturnsFirstFunctionByName)
+{
+	Function fnc0("fnc0");
+	fnc0.setStart(fnc2.getStart());
+	Function fnc5("fnc5");
+	fnc5.setStart(fnc2.getStart());
+	funcs.insert(fnc5);
+	funcs.insert(fnc0);
+
+	auto* f = funcs.getFunctionByStartAddress(fnc2.getStart());
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_EQ( "fnc0", f->getName() );
+
+	funcs.erase(fnc0);
+	f = funcs.getFunctionByStartAddress(fnc2.getStart());
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_EQ( "fnc2", f->getName() );
+}
+
+TEST_F(FunctionContainerTests, TestInsertDoesNotReplaceFunctionWithTheSameName)
+{
+	Function other("fnc1");
+	other.setStart(0x5000);
+	auto p = funcs.insert(other);
+
+	EXPECT_FALSE(p.second);
+	EXPECT_EQ(nullptr, funcs.getFunctionByStartAddress(0x5000));
+	EXPECT_EQ(&(*p.first), funcs.getFunctionByStartAddress(fnc1.getStart()));
+}
+
+TEST_F(FunctionContainerTests, TestCopyHasOwnAddressIndex)
+{
+	FunctionContainer copy(funcs);
+	funcs.clear();
+
+	auto* f = copy.getFunctionByStartAddress(fnc1.getStart());
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_EQ(copy.getFunctionByName(fnc1.getName()), f);
+
+	FunctionContainer assigned;
+	assigned = copy;
+	copy.clear();
+
+	f = assigned.getFunctionByStartAddress(fnc2.getStart());
+	ASSERT_TRUE(f != nullptr);
+	EXPECT_EQ(assigned.getFunctionByName(fnc2.getName()), f);
+}
+
+TEST_F(FunctionContainerTests, TestEraseCountChangesOnlyOnErase)
+{
+	auto count = funcs.getEraseCount();
+
+	Function fnc5("fnc5");
+	funcs.insert(fnc5);
+	EXPECT_EQ(count, funcs.getEraseCount());
+
+	funcs.erase(Function("non-existing-name"));
+	EXPECT_EQ(count, funcs.getEraseCount());
+
+	funcs.erase(fnc5);
+	EXPECT_NE(count, funcs.getEraseCount());
+}
+
 } // namespace tests
 } // namespace common
 } // namespace retdec
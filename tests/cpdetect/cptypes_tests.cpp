@@ -0,0 +1,111 @@
+/**
+ * @file tests/cpdetect/cptypes_tests.cpp
+ * @brief Tests for the @c cptypes module.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/cpdetect/cptypes.h"
+
+using namespace ::testing;
+using namespace retdec::fileformat;
+
+namespace retdec {
+namespace cpdetect {
+namespace tests {
+
+class ToolInformationTests : public Test
+{
+	protected:
+		ToolInformation toolInfo;
+
+		/// Data which look like compressed or encrypted content.
+		static std::vector<std::uint8_t> randomBytes(std::size_t size)
+		{
+			std::vector<std::uint8_t> bytes(size);
+			std::uint32_t state = 0x12345678;
+			for (auto &b : bytes)
+			{
+				state = state * 1103515245 + 12345;
+				b = static_cast<std::uint8_t>(state >> 16);
+			}
+			return bytes;
+		}
+
+		/// Data which look like code or padding of a normal binary.
+		static std::vector<std::uint8_t> plainBytes(std::size_t size)
+		{
+			std::vector<std::uint8_t> bytes(size);
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				bytes[i] = i % 16 < 8 ? 0x00 : static_cast<std::uint8_t>(0x90 + i % 4);
+			}
+			return bytes;
+		}
+
+		void setContent(
+				const std::vector<std::uint8_t> &image,
+				const std::vector<std::uint8_t> &overlay = {})
+		{
+			auto content = image;
+			content.insert(content.end(), overlay.begin(), overlay.end());
+			toolInfo.entropyProfile = computeEntropyProfile(content.data(), content.size());
+			toolInfo.overlayOffset = overlay.empty() ? 0 : image.size();
+			toolInfo.overlaySize = overlay.size();
+		}
+};
+
+TEST_F(ToolInformationTests, HighEntropyContentWithoutSignatureIsReportedSeparately)
+{
+	setContent(randomBytes(64 * 1024));
+
+	EXPECT_TRUE(toolInfo.hasPackedEntropyProfile());
+	EXPECT_EQ(Packed::PROBABLY_NO, toolInfo.isPacked());
+}
+
+TEST_F(ToolInformationTests, NormalBinaryHasNoHighEntropyContent)
+{
+	setContent(plainBytes(64 * 1024));
+
+	EXPECT_FALSE(toolInfo.hasPackedEntropyProfile());
+	EXPECT_EQ(Packed::PROBABLY_NO, toolInfo.isPacked());
+}
+
+TEST_F(ToolInformationTests, HighEntropyOverlayIsExcluded)
+{
+	setContent(plainBytes(32 * 1024), randomBytes(256 * 1024));
+
+	EXPECT_FALSE(toolInfo.hasPackedEntropyProfile());
+	EXPECT_EQ(Packed::PROBABLY_NO, toolInfo.isPacked());
+}
+
+TEST_F(ToolInformationTests, PackedImageWithOverlayHasHighEntropyContent)
+{
+	setContent(randomBytes(32 * 1024), plainBytes(256 * 1024));
+	toolInfo.addTool(DetectionMethod::SIGNATURE, DetectionStrength::HIGH,
+			ToolType::PACKER, "UPX");
+
+	EXPECT_TRUE(toolInfo.hasPackedEntropyProfile());
+	EXPECT_EQ(Packed::PACKED, toolInfo.isPacked());
+}
+
+TEST_F(ToolInformationTests, OverlayStartingInFirstWindowIsExcluded)
+{
+	setContent(plainBytes(DEFAULT_ENTROPY_WINDOW_SIZE / 2), randomBytes(64 * 1024));
+
+	EXPECT_FALSE(toolInfo.hasPackedEntropyProfile());
+}
+
+TEST_F(ToolInformationTests, EmptyProfileHasNoHighEntropyContent)
+{
+	EXPECT_FALSE(toolInfo.hasPackedEntropyProfile());
+	EXPECT_EQ(Packed::PROBABLY_NO, toolInfo.isPacked());
+}
+
+} // namespace tests
+} // namespace cpdetect
+} // namespace retdec
@@ -0,0 +1,149 @@
+/**
+ * @file tests/cpdetect/search_tests.cpp
+ * @brief Tests for the @c search module.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include "retdec/cpdetect/search.h"
+#include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
+
+using namespace ::testing;
+using namespace retdec::fileformat;
+using namespace retdec::utils;
+
+namespace retdec {
+namespace cpdetect {
+namespace tests {
+
+class SearchTests : public Test
+{
+	protected:
+		std::vector<std::uint8_t> data;
+		std::unique_ptr<RawDataFormat> parser;
+
+		/// Parser has to be set up before the search is created.
+		void createParser(const std::vector<std::uint8_t> &bytes)
+		{
+			data = bytes;
+			parser = std::make_unique<RawDataFormat>(data.data(), data.size());
+			parser->setTargetArchitecture(Architecture::X86);
+			parser->setEndianness(Endianness::LITTLE);
+			parser->setBytesPerWord(4);
+		}
+};
+
+TEST_F(SearchTests, UnslashedSignaturesAreFoundOnOddNibbles)
+{
+	createParser({0x12, 0x34, 0x56, 0x78, 0x9A});
+	Search search(*parser);
+
+	ASSERT_TRUE(search.isFileSupported());
+	EXPECT_EQ("123456789A", search.getNibbles());
+	EXPECT_EQ(4, search.findUnslashedSignature("2345", 0, 5));
+	EXPECT_EQ(3, search.findUnslashedSignature("4-67", 0, 5));
+	EXPECT_EQ(0, search.findUnslashedSignature("2346", 0, 5));
+	EXPECT_EQ(
+		std::vector<unsigned long long>({4, 0, 5, 4}),
+		search.findUnslashedSignatures({"3456", "3465", "56789", "1234"}, 0, 5)
+	);
+}
+
+TEST_F(SearchTests, UnslashedSignatureMustBeInArea)
+{
+	createParser({0x12, 0x34, 0x56, 0x78, 0x9A});
+	Search search(*parser);
+
+	EXPECT_EQ(0, search.findUnslashedSignature("1234", 1, 5));
+	EXPECT_EQ(4, search.findUnslashedSignature("5678", 1, 5));
+	EXPECT_EQ(0, search.findUnslashedSignature("789A", 0, 2));
+}
+
+TEST_F(SearchTests, SlashedSignaturesFollowRelativeJumps)
+{
+	// nop; push ebp; jmp short +2; nop; nop; xor eax, eax; ret
+	createParser({0x90, 0x55, 0xEB, 0x02, 0x90, 0x90, 0x31, 0xC0, 0xC3});
+	Search search(*parser);
+
+	// Slash counts as average length of the x86 jump representations.
+	EXPECT_EQ(8, search.findSlashedSignature("55/31C0;", 0, 9));
+	EXPECT_EQ(0, search.findSlashedSignature("55/9090;", 0, 9));
+	EXPECT_EQ(0, search.findSlashedSignature("55/31C0;", 2, 9));
+	EXPECT_EQ(
+		std::vector<unsigned long long>({8, 0, 4}),
+		search.findSlashedSignatures(
+				{"55/31C0;", "55/9090;", "9055;"},
+				{{0, 9}, {0, 9}, {0, 2}})
+	);
+	EXPECT_EQ(8, search.exactComparison("55/31C0;", 1));
+	EXPECT_EQ(0, search.exactComparison("55/31C0;", 0));
+}
+
+TEST_F(SearchTests, SignaturesWithSameAnchorAreFoundInOnePass)
+{
+	createParser({0x00, 0x12, 0x34, 0x56, 0x78, 0x12, 0x34, 0x9A, 0x00});
+	Search search(*parser);
+
+	EXPECT_EQ(
+		std::vector<unsigned long long>({6, 6, 0, 2}),
+		search.findSlashedSignatures(
+				{"12349A;", "123456;", "123400;", "1-3-;"},
+				std::vector<Search::Area>(4, {0, 9}))
+	);
+}
+
+TEST_F(SearchTests, BigEndianFileIsSearchedInLittleEndian)
+{
+	createParser({0x78, 0x56, 0x34, 0x12, 0xF0, 0xDE, 0xBC, 0x9A, 0xAA});
+	parser->setEndianness(Endianness::BIG);
+	Search search(*parser);
+
+	ASSERT_TRUE(search.isFileSupported());
+	// Incomplete word at the end of file is not searched.
+	EXPECT_EQ("123456789ABCDEF0", search.getNibbles());
+	EXPECT_EQ(8, search.findUnslashedSignature("12345678", 0, 8));
+	EXPECT_EQ(6, search.findUnslashedSignature("789ABC", 0, 8));
+	EXPECT_EQ(0, search.findUnslashedSignature("7856", 0, 8));
+	EXPECT_EQ(4, search.exactComparison("9ABC;", 4));
+	// Plain strings are searched in the original content.
+	EXPECT_TRUE(search.hasString("\x78\x56\x34\x12"));
+}
+
+TEST_F(SearchTests, BigEndianFileWithOneByteWordsIsNotSwapped)
+{
+	createParser({0x12, 0x34, 0x56});
+	parser->setEndianness(Endianness::BIG);
+	parser->setBytesPerWord(1);
+	Search search(*parser);
+
+	ASSERT_TRUE(search.isFileSupported());
+	EXPECT_EQ("123456", search.getNibbles());
+	EXPECT_EQ(4, search.findUnslashedSignature("2345", 0, 3));
+}
+
+TEST_F(SearchTests, BigEndianFileShorterThanWordIsNotSupported)
+{
+	createParser({0x12, 0x34});
+	parser->setEndianness(Endianness::BIG);
+	Search search(*parser);
+
+	EXPECT_TRUE(search.isFileLoaded());
+	EXPECT_FALSE(search.isFileSupported());
+}
+
+TEST_F(SearchTests, FileWithoutTwoNibblesPerByteIsNotSupported)
+{
+	createParser({0x12, 0x34, 0x56, 0x78});
+	parser->setBytesLength(16);
+	Search search(*parser);
+
+	EXPECT_TRUE(search.isFileLoaded());
+	EXPECT_FALSE(search.isFileSupported());
+}
+
+} // namespace tests
+} // namespace cpdetect
+} // namespace retdec
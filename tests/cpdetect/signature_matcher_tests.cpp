@@ -0,0 +1,299 @@
+/**
+ * @file tests/cpdetect/signature_matcher_tests.cpp
+ * @brief Tests for the @c signature_matcher module.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <set>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include "retdec/cpdetect/signature_matcher.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace cpdetect {
+namespace tests {
+
+namespace {
+
+const auto EXACT = CompiledSignature::Mode::EXACT;
+const auto UNSLASHED = CompiledSignature::Mode::UNSLASHED;
+
+using Occurrences = std::set<std::pair<std::size_t, std::size_t>>;
+
+Occurrences scan(
+		const std::vector<std::string> &patterns,
+		const std::vector<std::uint8_t> &data,
+		std::size_t startOffset,
+		std::size_t stopOffset)
+{
+	std::vector<CompiledSignature> signatures;
+	for (const auto &pattern : patterns)
+	{
+		signatures.emplace_back(pattern, EXACT);
+	}
+
+	Occurrences result;
+	SignatureAutomaton(signatures).scan(
+			data.data(),
+			startOffset,
+			stopOffset,
+			[&] (std::size_t sign, std::size_t nibbleOffset)
+			{
+				result.emplace(sign, nibbleOffset);
+			}
+	);
+	return result;
+}
+
+} // anonymous namespace
+
+//
+// CompiledSignature
+//
+
+TEST(CompiledSignatureTests, ExactPatternIsSplitBySlashesAndEndsWithSemicolon)
+{
+	CompiledSignature signature("AB/CD--/EF;0123", EXACT);
+
+	ASSERT_EQ(3, signature.getChunks().size());
+	EXPECT_EQ(2, signature.getNumberOfSlashes());
+	EXPECT_EQ(2, signature.getChunks()[0].nibbles);
+	EXPECT_EQ(4, signature.getChunks()[1].nibbles);
+	EXPECT_EQ(2, signature.getChunks()[1].significant);
+	EXPECT_EQ(2, signature.getChunks()[2].nibbles);
+	EXPECT_TRUE(signature.isMatchable());
+}
+
+TEST(CompiledSignatureTests, UnslashedPatternIsOneChunkWithVariableSemicolons)
+{
+	CompiledSignature signature("AB;C?", UNSLASHED);
+
+	ASSERT_EQ(1, signature.getChunks().size());
+	EXPECT_EQ(0, signature.getNumberOfSlashes());
+	EXPECT_EQ(5, signature.getChunks()[0].nibbles);
+	EXPECT_EQ(3, signature.getChunks()[0].significant);
+	EXPECT_TRUE(signature.isMatchable());
+}
+
+TEST(CompiledSignatureTests, SlashInUnslashedPatternNeverMatches)
+{
+	CompiledSignature signature("AB/CD", UNSLASHED);
+
+	ASSERT_EQ(1, signature.getChunks().size());
+	EXPECT_FALSE(signature.isMatchable());
+}
+
+TEST(CompiledSignatureTests, InvalidCharacterMakesSignatureUnmatchable)
+{
+	EXPECT_FALSE(CompiledSignature("ABxD", EXACT).isMatchable());
+	EXPECT_FALSE(CompiledSignature("AB/cD", EXACT).isMatchable());
+}
+
+TEST(CompiledSignatureTests, ChunkIsCompiledForBothParities)
+{
+	CompiledSignature signature("A-C", EXACT);
+	const auto &chunk = signature.getChunks().front();
+
+	EXPECT_EQ(std::vector<std::uint8_t>({0xA0, 0xC0}), chunk.values[0]);
+	EXPECT_EQ(std::vector<std::uint8_t>({0xF0, 0xF0}), chunk.masks[0]);
+	EXPECT_EQ(std::vector<std::uint8_t>({0x0A, 0x0C}), chunk.values[1]);
+	EXPECT_EQ(std::vector<std::uint8_t>({0x0F, 0x0F}), chunk.masks[1]);
+	EXPECT_EQ(2, chunk.significant);
+}
+
+//
+// SignatureMatcher
+//
+
+class SignatureMatcherTests : public Test
+{
+	protected:
+		std::vector<std::uint8_t> data = {0x12, 0x34, 0x56, 0x78, 0x9A};
+		SignatureMatcher matcher;
+
+		SignatureMatcherTests() : matcher(data.data(), data.size())
+		{
+
+		}
+
+		bool matchChunk(const std::string &pattern, std::size_t nibbleOffset)
+		{
+			CompiledSignature signature(pattern, UNSLASHED);
+			return matcher.matchChunk(
+					signature.getChunks().front(),
+					nibbleOffset);
+		}
+};
+
+TEST_F(SignatureMatcherTests, ChunkMatchesOnEvenNibble)
+{
+	EXPECT_EQ(10, matcher.getNumberOfNibbles());
+	EXPECT_TRUE(matchChunk("3456", 2));
+	EXPECT_TRUE(matchChunk("3-5?", 2));
+	EXPECT_FALSE(matchChunk("3456", 0));
+	EXPECT_FALSE(matchChunk("3457", 2));
+}
+
+TEST_F(SignatureMatcherTests, ChunkMatchesOnOddNibble)
+{
+	EXPECT_TRUE(matchChunk("2345", 1));
+	EXPECT_TRUE(matchChunk("23;5", 1));
+	EXPECT_TRUE(matchChunk("456789A", 3));
+	EXPECT_FALSE(matchChunk("2346", 1));
+	EXPECT_FALSE(matchChunk("2345", 3));
+}
+
+TEST_F(SignatureMatcherTests, LongChunkIsComparedOnBothParities)
+{
+	data = {0x01, 0x23, 0x45, 0x67, 0x89, 0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45};
+	matcher = SignatureMatcher(data.data(), data.size());
+
+	EXPECT_TRUE(matchChunk("0123456789ABCDEF012345", 0));
+	EXPECT_TRUE(matchChunk("123456789ABCDEF01234", 1));
+	EXPECT_FALSE(matchChunk("123456789ABCDEF01235", 1));
+}
+
+TEST_F(SignatureMatcherTests, ChunkMustLieInFile)
+{
+	EXPECT_TRUE(matchChunk("9A", 8));
+	EXPECT_TRUE(matchChunk("A", 9));
+	EXPECT_FALSE(matchChunk("9A0", 8));
+	EXPECT_FALSE(matchChunk("A0", 9));
+	EXPECT_FALSE(matchChunk("1", 10));
+}
+
+TEST_F(SignatureMatcherTests, SameNibblesAreCountedOnBothParities)
+{
+	CompiledSignature even("1244", UNSLASHED);
+	CompiledSignature odd("2-F5", UNSLASHED);
+
+	EXPECT_EQ(3, matcher.countSameNibbles(even.getChunks().front(), 0));
+	EXPECT_EQ(2, matcher.countSameNibbles(odd.getChunks().front(), 1));
+}
+
+TEST_F(SignatureMatcherTests, SlashesAreSkippedWithoutJumps)
+{
+	EXPECT_TRUE(matcher.match(CompiledSignature("12/34/56;", EXACT), 0));
+	EXPECT_TRUE(matcher.match(CompiledSignature("23/45;", EXACT), 1));
+	EXPECT_FALSE(matcher.match(CompiledSignature("12/56;", EXACT), 0));
+}
+
+TEST_F(SignatureMatcherTests, SlashedSignatureFollowsJump)
+{
+	// push ebp; jmp short +2; nop; nop; xor eax, eax; ret
+	data = {0x55, 0xEB, 0x02, 0x90, 0x90, 0x31, 0xC0, 0xC3};
+	matcher = SignatureMatcher(data.data(), data.size());
+	matcher.addJump("EB", 1);
+	matcher.addJump("E9", 4);
+
+	EXPECT_TRUE(matcher.match(CompiledSignature("55/31C0;", EXACT), 0));
+	EXPECT_FALSE(matcher.match(CompiledSignature("55/9090;", EXACT), 0));
+	// Slash must be one of the jumps if there are any.
+	EXPECT_FALSE(matcher.match(CompiledSignature("55EB/9090;", EXACT), 0));
+
+	std::int64_t moveSize = 0;
+	const auto *jump = matcher.findJump(2, 1, moveSize);
+	ASSERT_NE(nullptr, jump);
+	EXPECT_EQ(1, jump->bytesAfter);
+	EXPECT_EQ(4, moveSize);
+	EXPECT_EQ(nullptr, matcher.findJump(0, 0, moveSize));
+	EXPECT_EQ(0, moveSize);
+}
+
+TEST_F(SignatureMatcherTests, SignatureMustEndBeforeEndOfFile)
+{
+	EXPECT_TRUE(matcher.match(CompiledSignature("789;", EXACT), 6));
+	EXPECT_FALSE(matcher.match(CompiledSignature("789A;", EXACT), 6));
+}
+
+TEST_F(SignatureMatcherTests, SimilarityCountsSameNibbles)
+{
+	Similarity sim;
+	EXPECT_TRUE(matcher.similarity(CompiledSignature("1235;", EXACT), 0, sim));
+	EXPECT_EQ(3, sim.same);
+	EXPECT_EQ(4, sim.total);
+	EXPECT_DOUBLE_EQ(0.75, sim.ratio);
+
+	EXPECT_TRUE(matcher.similarity(CompiledSignature("2-45;", EXACT), 1, sim));
+	EXPECT_EQ(3, sim.same);
+	EXPECT_EQ(3, sim.total);
+}
+
+TEST_F(SignatureMatcherTests, SimilarityOutOfFileLeavesResultUnchanged)
+{
+	Similarity sim;
+	sim.same = 7;
+	sim.total = 8;
+
+	EXPECT_FALSE(matcher.similarity(CompiledSignature("9A00;", EXACT), 8, sim));
+	EXPECT_EQ(7, sim.same);
+	EXPECT_EQ(8, sim.total);
+}
+
+//
+// SignatureAutomaton
+//
+
+TEST(SignatureAutomatonTests, AnchorsAreFoundOnBothParities)
+{
+	const std::vector<std::uint8_t> data = {0x12, 0x34, 0x56, 0x78, 0x9A};
+
+	const auto found = scan({"3456", "2345"}, data, 0, data.size());
+
+	EXPECT_TRUE(found.count({0, 2}));
+	EXPECT_TRUE(found.count({1, 1}));
+}
+
+TEST(SignatureAutomatonTests, OverlappingAnchorsAreAllFound)
+{
+	const std::vector<std::uint8_t> data = {0x00, 0x12, 0x34, 0x56, 0x00};
+
+	const auto found = scan({"123456", "3456", "345", "1234"}, data, 0, data.size());
+
+	EXPECT_TRUE(found.count({0, 2}));
+	EXPECT_TRUE(found.count({1, 4}));
+	EXPECT_TRUE(found.count({2, 4}));
+	EXPECT_TRUE(found.count({3, 2}));
+}
+
+TEST(SignatureAutomatonTests, AnchorIsTakenBeforeFirstSlash)
+{
+	const std::vector<std::uint8_t> data = {0x55, 0xEB, 0x02, 0x90, 0x90, 0x31, 0xC0};
+
+	const auto found = scan({"55EB/31C0"}, data, 0, data.size());
+
+	EXPECT_TRUE(found.count({0, 0}));
+}
+
+TEST(SignatureAutomatonTests, OnlyAnchorsInScannedAreaAreFound)
+{
+	const std::vector<std::uint8_t> data = {0x12, 0x34, 0x56, 0x12, 0x34, 0x56};
+
+	const auto found = scan({"123456"}, data, 1, data.size());
+
+	EXPECT_EQ(Occurrences({{0, 6}}), found);
+}
+
+TEST(SignatureAutomatonTests, SignaturesWithoutAnchorAreReported)
+{
+	std::vector<CompiledSignature> signatures;
+	signatures.emplace_back("1-2-", EXACT);
+	signatures.emplace_back("1234", EXACT);
+	signatures.emplace_back("--/1234", EXACT);
+	signatures.emplace_back("12xx", EXACT);
+
+	SignatureAutomaton automaton(signatures);
+
+	EXPECT_EQ(
+		std::vector<std::size_t>({0, 2}),
+		automaton.getUnanchoredSignatures()
+	);
+}
+
+} // namespace tests
+} // namespace cpdetect
+} // namespace retdec
@@ -0,0 +1,236 @@
+/**
+* @file tests/ctypesparser/type_library_tests.cpp
+* @brief Tests for the @c type_library module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "retdec/ctypes/call_convention.h"
+#include "retdec/ctypes/context.h"
+#include "retdec/ctypes/function.h"
+#include "retdec/ctypes/module.h"
+#include "retdec/ctypes/pointer_type.h"
+#include "retdec/ctypes/struct_type.h"
+#include "retdec/ctypesparser/json_ctypes_parser.h"
+#include "retdec/ctypesparser/type_library.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace ctypesparser {
+namespace tests {
+
+class TypeLibraryTests : public Test
+{
+	public:
+		TypeLibraryTests():
+			module(std::make_unique<retdec::ctypes::Module>(
+				std::make_shared<retdec::ctypes::Context>())) {}
+
+	protected:
+		std::unique_ptr<TypeLibrary> compile(const std::string &json)
+		{
+			std::stringstream in(json);
+			std::stringstream out;
+			TypeLibrary::compile(in, out);
+			return TypeLibrary::fromBuffer(out.str());
+		}
+
+	protected:
+		JSONCTypesParser parser;
+		std::unique_ptr<retdec::ctypes::Module> module;
+};
+
+const std::string LIBRARY_JSON = R"(
+	{
+		"functions": {
+			"ff": {
+				"decl": "int ff(struct s *p);",
+				"header": "CHeader.h",
+				"name": "ff",
+				"params": [
+					{
+						"name": "p",
+						"type": "p1"
+					}
+				],
+				"ret_type": "i1"
+			},
+			"gg": {
+				"decl": "int gg(void);",
+				"header": "CHeader.h",
+				"name": "gg",
+				"params": [],
+				"ret_type": "i1",
+				"call_conv": "cdecl"
+			},
+			"ff": {
+				"decl": "void ff(void);",
+				"header": "Duplicate.h",
+				"name": "ff",
+				"params": [],
+				"ret_type": "i1"
+			}
+		},
+		"types": {
+			"i1": {
+				"name": "int",
+				"type": "integral_type"
+			},
+			"p1": {
+				"pointed_type": "s1",
+				"type": "pointer"
+			},
+			"s1": {
+				"members": [
+					{
+						"name": "next",
+						"type": "p1"
+					}
+				],
+				"name": "s",
+				"type": "structure"
+			}
+		}
+	}
+)";
+
+TEST_F(TypeLibraryTests,
+CompileThrowsExceptionOnBadInput)
+{
+	std::stringstream in(R"({ "functions": {} )");
+	std::stringstream out;
+
+	ASSERT_THROW(TypeLibrary::compile(in, out), CTypesParseError);
+}
+
+TEST_F(TypeLibraryTests,
+CompileThrowsExceptionWhenTypesAreMissing)
+{
+	std::stringstream in(R"({ "functions": {} })");
+	std::stringstream out;
+
+	ASSERT_THROW(TypeLibrary::compile(in, out), CTypesParseError);
+}
+
+TEST_F(TypeLibraryTests,
+FromBufferThrowsExceptionOnInvalidLibrary)
+{
+	ASSERT_THROW(TypeLibrary::fromBuffer("not a library"), CTypesParseError);
+}
+
+TEST_F(TypeLibraryTests,
+FromBufferThrowsExceptionOnTruncatedLibrary)
+{
+	std::stringstream in(LIBRARY_JSON);
+	std::stringstream out;
+	TypeLibrary::compile(in, out);
+	std::string library = out.str();
+
+	ASSERT_THROW(
+		TypeLibrary::fromBuffer(library.substr(0, library.size() - 1)),
+		CTypesParseError
+	);
+}
+
+TEST_F(TypeLibraryTests,
+FromFileReturnsNullptrWhenFileDoesNotExist)
+{
+	EXPECT_EQ(nullptr, TypeLibrary::fromFile("/nonexistent/types.lti"));
+}
+
+TEST_F(TypeLibraryTests,
+GetLibraryPathReplacesJsonExtension)
+{
+	EXPECT_EQ("types/windows.lti", TypeLibrary::getLibraryPath("types/windows.json"));
+	EXPECT_EQ("types/windows.lti", TypeLibrary::getLibraryPath("types/windows"));
+}
+
+TEST_F(TypeLibraryTests,
+LibraryContainsAllFunctionsAndTypesOnce)
+{
+	auto library = compile(LIBRARY_JSON);
+
+	EXPECT_EQ(2, library->getFunctionCount());
+	EXPECT_EQ(3, library->getTypeCount());
+	EXPECT_TRUE(library->hasFunction("ff"));
+	EXPECT_TRUE(library->hasFunction("gg"));
+	EXPECT_FALSE(library->hasFunction("f"));
+	EXPECT_FALSE(library->hasFunction("hh"));
+
+	std::string_view record;
+	EXPECT_TRUE(library->getType("s1", record));
+	EXPECT_FALSE(library->getType("s2", record));
+}
+
+TEST_F(TypeLibraryTests,
+LibraryKeepsFirstOccurrenceOfName)
+{
+	auto library = compile(LIBRARY_JSON);
+
+	std::string_view record;
+	ASSERT_TRUE(library->getFunction("ff", record));
+	EXPECT_NE(std::string_view::npos, record.find("CHeader.h"));
+}
+
+TEST_F(TypeLibraryTests,
+ParseFunctionIntoReturnsNullptrWhenFunctionIsNotInLibrary)
+{
+	auto library = compile(LIBRARY_JSON);
+
+	EXPECT_EQ(nullptr, parser.parseFunctionInto(*library, "hh", module));
+	EXPECT_FALSE(module->hasFunctionWithName("hh"));
+}
+
+TEST_F(TypeLibraryTests,
+ParseFunctionIntoParsesOnlyRequestedFunction)
+{
+	auto library = compile(LIBRARY_JSON);
+
+	auto ff = parser.parseFunctionInto(*library, "ff", module);
+
+	ASSERT_NE(nullptr, ff);
+	EXPECT_TRUE(module->hasFunctionWithName("ff"));
+	EXPECT_FALSE(module->hasFunctionWithName("gg"));
+	EXPECT_EQ("CHeader.h", ff->getHeaderFile().getPath());
+	ASSERT_EQ(1, ff->getParameterCount());
+
+	auto pointer = std::dynamic_pointer_cast<retdec::ctypes::PointerType>(
+		ff->getParameter(1).getType());
+	ASSERT_NE(nullptr, pointer);
+	auto structure = std::dynamic_pointer_cast<retdec::ctypes::StructType>(
+		pointer->getPointedType());
+	ASSERT_NE(nullptr, structure);
+	EXPECT_EQ("s", structure->getName());
+	EXPECT_EQ(pointer, structure->getMemberType(1));
+}
+
+TEST_F(TypeLibraryTests,
+ParseFunctionIntoParsesSameFunctionsAsJsonParser)
+{
+	auto library = compile(LIBRARY_JSON);
+	std::stringstream json(LIBRARY_JSON);
+	retdec::ctypes::CallConvention stdcall("stdcall");
+	auto jsonModule = JSONCTypesParser().parse(json, {}, stdcall);
+
+	auto gg = parser.parseFunctionInto(*library, "gg", module, {}, stdcall);
+	auto ff = parser.parseFunctionInto(*library, "ff", module, {}, stdcall);
+
+	ASSERT_NE(nullptr, gg);
+	ASSERT_NE(nullptr, ff);
+	auto jsonGg = jsonModule->getFunctionWithName("gg");
+	auto jsonFf = jsonModule->getFunctionWithName("ff");
+	EXPECT_EQ(std::string(jsonGg->getDeclaration()), std::string(gg->getDeclaration()));
+	EXPECT_EQ(jsonGg->getCallConvention(), gg->getCallConvention());
+	EXPECT_EQ(std::string(jsonFf->getDeclaration()), std::string(ff->getDeclaration()));
+	EXPECT_EQ(jsonFf->getCallConvention(), ff->getCallConvention());
+	EXPECT_EQ(jsonFf->getReturnType()->getName(), ff->getReturnType()->getName());
+	EXPECT_EQ(ff->getReturnType(), gg->getReturnType());
+}
+
+} // namespace tests
+} // namespace ctypesparser
+} // namespace retdec
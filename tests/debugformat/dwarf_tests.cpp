@@ -0,0 +1,288 @@
+/**
+* @file tests/debugformat/dwarf_tests.cpp
+* @brief Tests for the DWARF loading of @c debugformat module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <gtest/gtest.h>
+
+#include <llvm/BinaryFormat/Dwarf.h>
+
+#include "retdec/debugformat/debugformat.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace debugformat {
+namespace tests {
+
+namespace {
+
+/**
+ * Writer of DWARF 4 sections of a little-endian 64-bit file.
+ */
+class DwarfWriter
+{
+	public:
+		/// Abbreviation codes.
+		enum Abbrev : std::uint8_t
+		{
+			COMPILE_UNIT = 1,
+			SUBPROGRAM,
+			BASE_TYPE,
+			SUBPROGRAM_SPECIFICATION,
+			SUBPROGRAM_DECLARATION,
+		};
+
+		DwarfWriter()
+		{
+			using namespace llvm::dwarf;
+			abbrev(COMPILE_UNIT, DW_TAG_compile_unit, true,
+					{{DW_AT_low_pc, DW_FORM_addr}, {DW_AT_high_pc, DW_FORM_data8}});
+			abbrev(SUBPROGRAM, DW_TAG_subprogram, false,
+					{{DW_AT_name, DW_FORM_string}, {DW_AT_low_pc, DW_FORM_addr},
+					{DW_AT_high_pc, DW_FORM_data8}, {DW_AT_type, DW_FORM_ref_addr}});
+			abbrev(BASE_TYPE, DW_TAG_base_type, false,
+					{{DW_AT_name, DW_FORM_string}, {DW_AT_encoding, DW_FORM_data1},
+					{DW_AT_byte_size, DW_FORM_data1}});
+			abbrev(SUBPROGRAM_SPECIFICATION, DW_TAG_subprogram, false,
+					{{DW_AT_specification, DW_FORM_ref_addr},
+					{DW_AT_low_pc, DW_FORM_addr}, {DW_AT_high_pc, DW_FORM_data8}});
+			abbrev(SUBPROGRAM_DECLARATION, DW_TAG_subprogram, false,
+					{{DW_AT_name, DW_FORM_string}, {DW_AT_linkage_name, DW_FORM_string},
+					{DW_AT_type, DW_FORM_ref_addr}, {DW_AT_declaration, DW_FORM_flag_present}});
+			abbrevs.push_back(0);
+		}
+
+		/// Start a compilation unit with the range <@a start, @a start + @a size).
+		void startUnit(std::uint64_t start, std::uint64_t size)
+		{
+			unitOffset = info.size();
+			number(0, 4);      // unit_length, set in endUnit()
+			number(4, 2);      // version
+			number(0, 4);      // debug_abbrev_offset
+			number(8, 1);      // address_size
+			number(COMPILE_UNIT, 1);
+			number(start, 8);
+			number(size, 8);
+		}
+
+		void endUnit()
+		{
+			number(0, 1);      // end of children of the unit DIE
+			auto length = info.size() - unitOffset - 4;
+			for (std::size_t i = 0; i < 4; ++i)
+			{
+				info[unitOffset + i] = (length >> (8 * i)) & 0xff;
+			}
+		}
+
+		/// @return Offset of the new DIE.
+		std::uint32_t subprogram(
+				const std::string& name,
+				std::uint64_t start,
+				std::uint64_t size,
+				std::uint32_t type)
+		{
+			auto offset = info.size();
+			number(SUBPROGRAM, 1);
+			string(name);
+			number(start, 8);
+			number(size, 8);
+			number(type, 4);
+			return offset;
+		}
+
+		std::uint32_t baseType(const std::string& name, std::uint8_t size)
+		{
+			auto offset = info.size();
+			number(BASE_TYPE, 1);
+			string(name);
+			number(llvm::dwarf::DW_ATE_signed, 1);
+			number(size, 1);
+			return offset;
+		}
+
+		std::uint32_t specification(
+				std::uint32_t declaration,
+				std::uint64_t start,
+				std::uint64_t size)
+		{
+			auto offset = info.size();
+			number(SUBPROGRAM_SPECIFICATION, 1);
+			number(declaration, 4);
+			number(start, 8);
+			number(size, 8);
+			return offset;
+		}
+
+		std::uint32_t declaration(
+				const std::string& name,
+				const std::string& linkageName,
+				std::uint32_t type)
+		{
+			auto offset = info.size();
+			number(SUBPROGRAM_DECLARATION, 1);
+			string(name);
+			string(linkageName);
+			number(type, 4);
+			return offset;
+		}
+
+		/// The context refers to the sections, so it must not outlive
+		/// the writer.
+		std::unique_ptr<llvm::DWARFContext> createContext()
+		{
+			sections["debug_info"] = llvm::MemoryBuffer::getMemBufferCopy(info);
+			sections["debug_abbrev"] = llvm::MemoryBuffer::getMemBufferCopy(abbrevs);
+			return llvm::DWARFContext::create(sections, 8, true);
+		}
+
+	private:
+		void abbrev(
+				std::uint8_t code,
+				llvm::dwarf::Tag tag,
+				bool children,
+				const std::vector<std::pair<llvm::dwarf::Attribute, llvm::dwarf::Form>>& attrs)
+		{
+			// All the values are lower than 0x80, so they fit into one byte
+			// of ULEB128.
+			abbrevs.push_back(code);
+			abbrevs.push_back(tag);
+			abbrevs.push_back(children);
+			for (auto& a : attrs)
+			{
+				abbrevs.push_back(a.first);
+				abbrevs.push_back(a.second);
+			}
+			abbrevs.push_back(0);
+			abbrevs.push_back(0);
+		}
+
+		void number(std::uint64_t value, std::size_t size)
+		{
+			for (std::size_t i = 0; i < size; ++i)
+			{
+				info.push_back((value >> (8 * i)) & 0xff);
+			}
+		}
+
+		void string(const std::string& str)
+		{
+			info += str;
+			info.push_back('\0');
+		}
+
+	private:
+		std::string info;
+		std::string abbrevs;
+		std::size_t unitOffset = 0;
+		llvm::StringMap<std::unique_ptr<llvm::MemoryBuffer>> sections;
+};
+
+const std::uint64_t FIRST_UNIT_START = 0x1000;
+const std::uint64_t UNIT_SIZE = 0x100;
+
+} // anonymous namespace
+
+class DwarfTests : public Test
+{
+	protected:
+		DwarfWriter writer;
+
+		/**
+		 * Create DWARF with one unit of shared types (outside of ranges of
+		 * all other units) and @a unitCount units with two functions each.
+		 * All the functions use types from the shared unit.
+		 */
+		std::unique_ptr<llvm::DWARFContext> createDwarf(std::size_t unitCount)
+		{
+			writer.startUnit(0x9000, UNIT_SIZE);
+			auto intType = writer.baseType("int", 4);
+			auto longType = writer.baseType("long", 8);
+			auto method = writer.declaration("method", "_ZN1A6methodEv", longType);
+			writer.endUnit();
+
+			for (std::size_t i = 0; i < unitCount; ++i)
+			{
+				auto start = FIRST_UNIT_START + i * UNIT_SIZE;
+				writer.startUnit(start, UNIT_SIZE);
+				writer.subprogram("func_" + std::to_string(i), start, 0x10, intType);
+				writer.specification(method, start + 0x20, 0x10);
+				writer.endUnit();
+			}
+
+			return writer.createContext();
+		}
+};
+
+TEST_F(DwarfTests, TypesFromOtherUnitAreLoaded)
+{
+	auto ctx = createDwarf(1);
+	DebugFormat df;
+	df.loadDwarf(*ctx);
+
+	ASSERT_EQ(2, df.functions.size());
+	auto* f = df.getFunction(FIRST_UNIT_START);
+	ASSERT_NE(nullptr, f);
+	EXPECT_EQ("func_0", f->getName());
+	EXPECT_EQ("i32", f->returnType.getLlvmIr());
+}
+
+TEST_F(DwarfTests, NamesAndTypesOfSpecificationFromOtherUnitAreLoaded)
+{
+	auto ctx = createDwarf(1);
+	DebugFormat df;
+	df.loadDwarf(*ctx);
+
+	auto* f = df.getFunction(FIRST_UNIT_START + 0x20);
+	ASSERT_NE(nullptr, f);
+	EXPECT_EQ("_ZN1A6methodEv", f->getName());
+	EXPECT_EQ("i64", f->returnType.getLlvmIr());
+	EXPECT_EQ(FIRST_UNIT_START + 0x30, f->getEnd());
+}
+
+TEST_F(DwarfTests, UnitsOutsideOfRangesAreNotLoadedButCanBeReferenced)
+{
+	auto ctx = createDwarf(3);
+	common::AddressRangeContainer ranges;
+	ranges.insert(FIRST_UNIT_START + UNIT_SIZE, FIRST_UNIT_START + 2 * UNIT_SIZE);
+	DebugFormat df(ranges);
+	df.loadDwarf(*ctx);
+
+	ASSERT_EQ(2, df.functions.size());
+	auto* f = df.getFunction(FIRST_UNIT_START + UNIT_SIZE);
+	ASSERT_NE(nullptr, f);
+	EXPECT_EQ("func_1", f->getName());
+	EXPECT_EQ("i32", f->returnType.getLlvmIr());
+	auto* m = df.getFunction(FIRST_UNIT_START + UNIT_SIZE + 0x20);
+	ASSERT_NE(nullptr, m);
+	EXPECT_EQ("i64", m->returnType.getLlvmIr());
+}
+
+TEST_F(DwarfTests, ManyUnitsReferencingOneUnitAreLoadedInParallel)
+{
+	const std::size_t unitCount = 200;
+	auto ctx = createDwarf(unitCount);
+	common::AddressRangeContainer ranges;
+	ranges.insert(FIRST_UNIT_START, FIRST_UNIT_START + unitCount * UNIT_SIZE);
+	DebugFormat df(ranges);
+	df.loadDwarf(*ctx);
+
+	ASSERT_EQ(2 * unitCount, df.functions.size());
+	for (std::size_t i = 0; i < unitCount; ++i)
+	{
+		auto start = FIRST_UNIT_START + i * UNIT_SIZE;
+		auto* f = df.getFunction(start);
+		ASSERT_NE(nullptr, f);
+		EXPECT_EQ("func_" + std::to_string(i), f->getName());
+		EXPECT_EQ("i32", f->returnType.getLlvmIr());
+		auto* m = df.getFunction(start + 0x20);
+		ASSERT_NE(nullptr, m);
+		EXPECT_EQ("i64", m->returnType.getLlvmIr());
+	}
+}
+
+} // namespace tests
+} // namespace debugformat
+} // namespace retdec
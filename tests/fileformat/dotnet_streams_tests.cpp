@@ -0,0 +1,134 @@
+/**
+* @file tests/fileformat/dotnet_streams_tests.cpp
+* @brief Tests for the .NET @c BlobStream and @c StringStream modules.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/types/dotnet_headers/blob_stream.h"
+#include "retdec/fileformat/types/dotnet_headers/string_stream.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+/**
+ * Tests for the @c BlobStream module.
+ */
+class BlobStreamTests : public Test
+{
+	protected:
+		// 0x00: empty element
+		// 0x01: 1-byte length element
+		// 0x04: 2-byte length element (0x0003)
+		// 0x09: truncated element
+		const std::string content = std::string("\x00\x02\xAA\xBB\x80\x03\x01\x02\x03\x05\x01", 11);
+		BlobStream blob = BlobStream(0, content.size());
+
+	public:
+		BlobStreamTests()
+		{
+			blob.setData(content);
+		}
+};
+
+TEST_F(BlobStreamTests,
+EmptyElementIsDecoded)
+{
+	EXPECT_TRUE(blob.getElement(0).empty());
+}
+
+TEST_F(BlobStreamTests,
+ElementWithShortLengthIsDecoded)
+{
+	auto element = blob.getElement(1);
+	ASSERT_EQ(2, element.size());
+	EXPECT_EQ(0xAA, element[0]);
+	EXPECT_EQ(0xBB, element[1]);
+}
+
+TEST_F(BlobStreamTests,
+ElementWithTwoByteLengthIsDecoded)
+{
+	auto element = blob.getElement(4);
+	ASSERT_EQ(3, element.size());
+	EXPECT_EQ(0x01, element[0]);
+	EXPECT_EQ(0x03, element[2]);
+}
+
+TEST_F(BlobStreamTests,
+TruncatedElementIsEmpty)
+{
+	EXPECT_TRUE(blob.getElement(9).empty());
+}
+
+TEST_F(BlobStreamTests,
+ElementOutOfStreamIsEmpty)
+{
+	EXPECT_TRUE(blob.getElement(100).empty());
+}
+
+/**
+ * Tests for the @c StringStream module.
+ */
+class StringStreamTests : public Test
+{
+	protected:
+		const std::string content = std::string("\0Hello\0World\0Unterminated", 25);
+		StringStream strings = StringStream(0, content.size());
+
+	public:
+		StringStreamTests()
+		{
+			strings.setData(content);
+		}
+};
+
+TEST_F(StringStreamTests,
+FirstStringIsEmpty)
+{
+	std::string result = "nonempty";
+	ASSERT_TRUE(strings.getString(0, result));
+	EXPECT_EQ("", result);
+}
+
+TEST_F(StringStreamTests,
+StringAtItsOffsetIsRead)
+{
+	std::string result;
+	ASSERT_TRUE(strings.getString(1, result));
+	EXPECT_EQ("Hello", result);
+	ASSERT_TRUE(strings.getString(7, result));
+	EXPECT_EQ("World", result);
+}
+
+TEST_F(StringStreamTests,
+StringInTheMiddleOfAnotherStringIsRead)
+{
+	llvm::StringRef result;
+	ASSERT_TRUE(strings.getStringRef(3, result));
+	EXPECT_EQ("llo", result.str());
+}
+
+TEST_F(StringStreamTests,
+UnterminatedStringIsNotRead)
+{
+	std::string result;
+	EXPECT_FALSE(strings.getString(13, result));
+}
+
+TEST_F(StringStreamTests,
+StringOutOfStreamIsNotRead)
+{
+	std::string result;
+	EXPECT_FALSE(strings.getString(100, result));
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -0,0 +1,135 @@
+/**
+* @file tests/fileformat/entropy_tests.cpp
+* @brief Tests for the @c entropy module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/utils/entropy.h"
+#include "retdec/fileformat/utils/other.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+namespace {
+
+/**
+ * Data whose first half is pseudo-random and second half is zero padding
+ */
+std::vector<std::uint8_t> createData(std::size_t size)
+{
+	std::vector<std::uint8_t> data(size, 0);
+	std::uint32_t state = 0x12345678;
+	for (std::size_t i = 0; i < size / 2; ++i)
+	{
+		state = state * 1103515245 + 12345;
+		data[i] = static_cast<std::uint8_t>(state >> 24);
+	}
+	return data;
+}
+
+} // anonymous namespace
+
+class EntropyTests : public Test
+{
+};
+
+TEST_F(EntropyTests, ByteHistogramCountsAllBytes)
+{
+	const auto data = createData(1003);
+	ByteHistogram expected{};
+	for (auto byte : data)
+	{
+		++expected[byte];
+	}
+
+	ByteHistogram histogram{};
+	addToByteHistogram(histogram, data.data(), data.size());
+	EXPECT_EQ(expected, histogram);
+
+	// Counts are added to the existing ones.
+	addToByteHistogram(histogram, data.data(), data.size());
+	for (std::size_t i = 0; i < histogram.size(); ++i)
+	{
+		EXPECT_EQ(2 * expected[i], histogram[i]);
+	}
+}
+
+TEST_F(EntropyTests, HistogramEntropyOfUniformData)
+{
+	ByteHistogram histogram{};
+	histogram.fill(16);
+	EXPECT_DOUBLE_EQ(8.0, computeHistogramEntropy(histogram));
+
+	histogram.fill(0);
+	histogram['A'] = 100;
+	EXPECT_DOUBLE_EQ(0.0, computeHistogramEntropy(histogram));
+}
+
+TEST_F(EntropyTests, ProfileMatchesEntropyOfWindows)
+{
+	const auto data = createData(10000);
+	for (std::size_t stride : {256, 1024, 1500})
+	{
+		const auto profile = computeEntropyProfile(data.data(), data.size(), 1024, stride);
+		EXPECT_EQ(1024, profile.windowSize);
+		EXPECT_EQ(stride, profile.stride);
+		ASSERT_EQ((data.size() - 1024) / stride + 1, profile.entropy.size());
+		for (std::size_t i = 0; i < profile.entropy.size(); ++i)
+		{
+			const auto expected = computeDataEntropy(data.data() + i * stride, 1024);
+			EXPECT_NEAR(expected, profile.entropy[i], 1e-9);
+		}
+	}
+}
+
+TEST_F(EntropyTests, ProfileOfIncrementallyProcessedData)
+{
+	const auto data = createData(10000);
+	EntropyProfiler profiler(data.data(), data.size(), 512, 128);
+	for (std::size_t offset = 0; offset <= data.size(); offset += 700)
+	{
+		profiler.processUntil(offset);
+	}
+	profiler.processUntil(data.size());
+
+	const auto expected = computeEntropyProfile(data.data(), data.size(), 512, 128);
+	ASSERT_EQ(expected.entropy.size(), profiler.getProfile().entropy.size());
+	for (std::size_t i = 0; i < expected.entropy.size(); ++i)
+	{
+		EXPECT_NEAR(expected.entropy[i], profiler.getProfile().entropy[i], 1e-9);
+	}
+}
+
+TEST_F(EntropyTests, ProfileOfShortDataHasOneWindow)
+{
+	const auto data = createData(100);
+	const auto profile = computeEntropyProfile(data.data(), data.size());
+	ASSERT_EQ(1, profile.entropy.size());
+	EXPECT_NEAR(computeDataEntropy(data.data(), data.size()), profile.entropy[0], 1e-9);
+}
+
+TEST_F(EntropyTests, ProfileQueries)
+{
+	const auto data = createData(8192);
+	const auto profile = computeEntropyProfile(data.data(), data.size(), 1024, 1024);
+	ASSERT_EQ(8, profile.entropy.size());
+	EXPECT_EQ(4, profile.getNumberOfWindowsAbove(7.0));
+	EXPECT_DOUBLE_EQ(0.0, profile.entropy.back());
+	EXPECT_GT(profile.getMax(), 7.0);
+}
+
+TEST_F(EntropyTests, ProfileOfNoDataIsEmpty)
+{
+	EXPECT_TRUE(computeEntropyProfile(nullptr, 0).empty());
+	const auto data = createData(100);
+	EXPECT_TRUE(computeEntropyProfile(data.data(), data.size(), 0, 1).empty());
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
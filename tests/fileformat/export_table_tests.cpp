@@ -0,0 +1,96 @@
+/**
+ * @file tests/fileformat/export_table_tests.cpp
+ * @brief Tests for the @c export_table module.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/types/export_table/export_table.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+class ExportTableTests : public Test
+{
+	protected:
+		ExportTable table;
+
+		void addExport(const std::string &name, unsigned long long address)
+		{
+			Export newExport;
+			newExport.setName(name);
+			newExport.setAddress(address);
+			table.addExport(newExport);
+		}
+};
+
+TEST_F(ExportTableTests, LookupsFindExports)
+{
+	addExport("foo", 0x1000);
+	addExport("bar", 0x2000);
+
+	EXPECT_EQ(table.getExport(0), table.getExport("foo"));
+	EXPECT_EQ(table.getExport(1), table.getExport("bar"));
+	EXPECT_EQ(table.getExport(1), table.getExportOnAddress(0x2000));
+	EXPECT_EQ(nullptr, table.getExport("baz"));
+	EXPECT_EQ(nullptr, table.getExportOnAddress(0x3000));
+	EXPECT_TRUE(table.hasExport("foo"));
+	EXPECT_TRUE(table.hasExport(0x1000));
+}
+
+TEST_F(ExportTableTests, FirstExportWithSameKeyIsFound)
+{
+	addExport("foo", 0x1000);
+	addExport("foo", 0x1000);
+
+	EXPECT_EQ(table.getExport(0), table.getExport("foo"));
+	EXPECT_EQ(table.getExport(0), table.getExportOnAddress(0x1000));
+}
+
+TEST_F(ExportTableTests, AddedExportIsFoundAfterLookup)
+{
+	addExport("foo", 0x1000);
+	ASSERT_EQ(nullptr, table.getExport("bar"));
+	ASSERT_EQ(nullptr, table.getExportOnAddress(0x2000));
+
+	addExport("bar", 0x2000);
+
+	ASSERT_NE(nullptr, table.getExport("bar"));
+	EXPECT_EQ(0x2000, table.getExport("bar")->getAddress());
+	EXPECT_EQ(table.getExport(1), table.getExportOnAddress(0x2000));
+}
+
+TEST_F(ExportTableTests, ManyAddedExportsAreFoundAfterLookup)
+{
+	// Storage of exports is reallocated, indexes must not point into it.
+	addExport("foo", 0x1000);
+	ASSERT_NE(nullptr, table.getExport("foo"));
+
+	for (unsigned i = 0; i < 100; ++i)
+	{
+		addExport("f" + std::to_string(i), 0x2000 + i);
+	}
+
+	ASSERT_NE(nullptr, table.getExport("f99"));
+	EXPECT_EQ(0x2000 + 99, table.getExport("f99")->getAddress());
+	EXPECT_EQ("foo", table.getExportOnAddress(0x1000)->getName());
+}
+
+TEST_F(ExportTableTests, NoExportIsFoundAfterClear)
+{
+	addExport("foo", 0x1000);
+	ASSERT_NE(nullptr, table.getExport("foo"));
+
+	table.clear();
+
+	EXPECT_EQ(nullptr, table.getExport("foo"));
+	EXPECT_EQ(nullptr, table.getExportOnAddress(0x1000));
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -0,0 +1,95 @@
+/**
+ * @file tests/fileformat/import_table_tests.cpp
+ * @brief Tests for the @c import_table module.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/types/import_table/import_table.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+class ImportTableTests : public Test
+{
+	protected:
+		ImportTable table;
+
+		const Import* addImport(const std::string &name, unsigned long long address)
+		{
+			auto import = std::make_unique<Import>();
+			import->setName(name);
+			import->setAddress(address);
+			const auto *result = import.get();
+			table.addImport(std::move(import));
+			return result;
+		}
+};
+
+TEST_F(ImportTableTests, LookupsFindImports)
+{
+	const auto *foo = addImport("foo", 0x1000);
+	const auto *bar = addImport("bar", 0x2000);
+
+	EXPECT_EQ(foo, table.getImport("foo"));
+	EXPECT_EQ(bar, table.getImport("bar"));
+	EXPECT_EQ(bar, table.getImportOnAddress(0x2000));
+	EXPECT_EQ(nullptr, table.getImport("baz"));
+	EXPECT_EQ(nullptr, table.getImportOnAddress(0x3000));
+	EXPECT_TRUE(table.hasImport("foo"));
+	EXPECT_TRUE(table.hasImport(0x1000));
+}
+
+TEST_F(ImportTableTests, FirstImportWithSameKeyIsFound)
+{
+	const auto *first = addImport("foo", 0x1000);
+	addImport("foo", 0x1000);
+
+	EXPECT_EQ(first, table.getImport("foo"));
+	EXPECT_EQ(first, table.getImportOnAddress(0x1000));
+}
+
+TEST_F(ImportTableTests, AddedImportIsFoundAfterLookup)
+{
+	addImport("foo", 0x1000);
+	ASSERT_EQ(nullptr, table.getImport("bar"));
+	ASSERT_EQ(nullptr, table.getImportOnAddress(0x2000));
+
+	const auto *bar = addImport("bar", 0x2000);
+
+	EXPECT_EQ(bar, table.getImport("bar"));
+	EXPECT_EQ(bar, table.getImportOnAddress(0x2000));
+}
+
+TEST_F(ImportTableTests, NoImportIsFoundAfterClear)
+{
+	addImport("foo", 0x1000);
+	ASSERT_NE(nullptr, table.getImport("foo"));
+
+	table.clear();
+
+	EXPECT_EQ(nullptr, table.getImport("foo"));
+	EXPECT_EQ(nullptr, table.getImportOnAddress(0x1000));
+}
+
+TEST_F(ImportTableTests, IteratorGivesOnlyConstImports)
+{
+	const auto *foo = addImport("foo", 0x1000);
+
+	auto it = table.begin();
+	static_assert(
+			std::is_same<decltype(*it), const Import*>::value,
+			"imports must not be modifiable through iterator");
+	EXPECT_EQ(foo, *it);
+	EXPECT_EQ(table.end(), ++it);
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -0,0 +1,158 @@
+/**
+* @file tests/fileformat/ordinal_database_tests.cpp
+* @brief Tests for the @c ordinal_database module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/utils/ordinal_database.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+namespace {
+
+void writeU32(std::string &out, std::uint32_t value)
+{
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+	}
+}
+
+/**
+ * Database in the same layout as produced by support/pack-ordinals.py:
+ *   arm/coredll: 1 -> "CoreFunc"
+ *   x86/kernel32: 1 -> "BaseThreadInitThunk", 3 -> "Beep"
+ *   x86/ws2_32: 3 -> "closesocket"
+ */
+std::string createDatabase()
+{
+	const std::vector<std::pair<std::string, std::vector<std::pair<std::uint32_t, std::string>>>> libraries =
+	{
+		{"arm/coredll", {{1, "CoreFunc"}}},
+		{"x86/kernel32", {{1, "BaseThreadInitThunk"}, {3, "Beep"}}},
+		{"x86/ws2_32", {{3, "closesocket"}}}
+	};
+
+	std::size_t entryCount = 0;
+	for (const auto &library : libraries)
+	{
+		entryCount += library.second.size();
+	}
+
+	const std::size_t blobStart = 16 + libraries.size() * 16 + entryCount * 12;
+	std::string blob;
+	std::string libraryTable;
+	std::string entryTable;
+	std::size_t firstEntry = 0;
+	for (const auto &library : libraries)
+	{
+		writeU32(libraryTable, blobStart + blob.size());
+		writeU32(libraryTable, library.first.size());
+		writeU32(libraryTable, firstEntry);
+		writeU32(libraryTable, library.second.size());
+		blob += library.first;
+		for (const auto &entry : library.second)
+		{
+			writeU32(entryTable, entry.first);
+			writeU32(entryTable, blobStart + blob.size());
+			writeU32(entryTable, entry.second.size());
+			blob += entry.second;
+		}
+		firstEntry += library.second.size();
+	}
+
+	std::string database = "RDOD";
+	writeU32(database, 1);
+	writeU32(database, libraries.size());
+	writeU32(database, entryCount);
+	return database + libraryTable + entryTable + blob;
+}
+
+} // anonymous namespace
+
+class OrdinalDatabaseTests : public Test
+{
+	public:
+		OrdinalDatabaseTests() : database(OrdinalDatabase::fromBuffer(createDatabase())) {}
+
+	protected:
+		std::unique_ptr<OrdinalDatabase> database;
+};
+
+TEST_F(OrdinalDatabaseTests, FromBufferReturnsNullptrOnInvalidDatabase)
+{
+	EXPECT_EQ(nullptr, OrdinalDatabase::fromBuffer(""));
+	EXPECT_EQ(nullptr, OrdinalDatabase::fromBuffer("not a database"));
+}
+
+TEST_F(OrdinalDatabaseTests, FromBufferReturnsNullptrOnTruncatedDatabase)
+{
+	// Entry table is cut in half.
+	EXPECT_EQ(nullptr, OrdinalDatabase::fromBuffer(createDatabase().substr(0, 16 + 3 * 16 + 2 * 12)));
+}
+
+TEST_F(OrdinalDatabaseTests, FromFileReturnsNullptrWhenFileDoesNotExist)
+{
+	EXPECT_EQ(nullptr, OrdinalDatabase::fromFile("/nonexistent/ordinals.bin"));
+}
+
+TEST_F(OrdinalDatabaseTests, DatabaseContainsAllLibrariesAndEntries)
+{
+	ASSERT_NE(nullptr, database);
+	EXPECT_EQ(3, database->getNumberOfLibraries());
+	EXPECT_EQ(4, database->getNumberOfEntries());
+	EXPECT_TRUE(database->hasLibrary("arm", "coredll"));
+	EXPECT_TRUE(database->hasLibrary("x86", "kernel32"));
+	EXPECT_TRUE(database->hasLibrary("x86", "ws2_32"));
+	EXPECT_FALSE(database->hasLibrary("x86", "coredll"));
+	EXPECT_FALSE(database->hasLibrary("x86", "user32"));
+}
+
+TEST_F(OrdinalDatabaseTests, GetNameFindsNameInRightLibrary)
+{
+	ASSERT_NE(nullptr, database);
+	std::string name;
+
+	EXPECT_TRUE(database->getName("x86", "kernel32", 1, name));
+	EXPECT_EQ("BaseThreadInitThunk", name);
+	EXPECT_TRUE(database->getName("x86", "kernel32", 3, name));
+	EXPECT_EQ("Beep", name);
+	EXPECT_TRUE(database->getName("x86", "ws2_32", 3, name));
+	EXPECT_EQ("closesocket", name);
+	EXPECT_TRUE(database->getName("arm", "coredll", 1, name));
+	EXPECT_EQ("CoreFunc", name);
+}
+
+TEST_F(OrdinalDatabaseTests, GetNameIgnoresCaseAndDllSuffixOfLibrary)
+{
+	ASSERT_NE(nullptr, database);
+	std::string name;
+
+	EXPECT_TRUE(database->getName("x86", "KERNEL32.dll", 3, name));
+	EXPECT_EQ("Beep", name);
+	EXPECT_TRUE(database->getName("x86", "Ws2_32.DLL", 3, name));
+	EXPECT_EQ("closesocket", name);
+}
+
+TEST_F(OrdinalDatabaseTests, GetNameDoesNotFindMissingOrdinal)
+{
+	ASSERT_NE(nullptr, database);
+	std::string name = "unchanged";
+
+	EXPECT_FALSE(database->getName("x86", "kernel32", 0, name));
+	EXPECT_FALSE(database->getName("x86", "kernel32", 2, name));
+	EXPECT_FALSE(database->getName("x86", "kernel32", 4, name));
+	EXPECT_FALSE(database->getName("x86", "user32", 1, name));
+	EXPECT_FALSE(database->getName("arm", "kernel32", 1, name));
+	EXPECT_EQ("unchanged", name);
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
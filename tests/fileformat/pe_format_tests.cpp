@@ -4,11 +4,15 @@
 * @copyright (c) 2019 Avast Software, licensed under the MIT license
 */
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
 #include <string>
 
 #include <gtest/gtest.h>
 
 #include "retdec/fileformat/file_format/pe/pe_format.h"
+#include "retdec/utils/filesystem.h"
 #include "fileformat/fileformat_tests.h"
 
 using namespace ::testing;
@@ -108,6 +112,165 @@ const std::vector<uint8_t> peBytes =
 	0x00, 0x00, 0x00, 0x00
 };
 
+namespace {
+
+/**
+ * Detached PKCS #7 signature with a self-signed certificate (CN=retdec).
+ */
+const std::vector<uint8_t> signatureBytes =
+{
+	0x30, 0x82, 0x02, 0x4d, 0x06, 0x09, 0x2a, 0x86, 0x48, 0x86, 0xf7, 0x0d,
+	0x01, 0x07, 0x02, 0xa0, 0x82, 0x02, 0x3e, 0x30, 0x82, 0x02, 0x3a, 0x02,
+	0x01, 0x01, 0x31, 0x0f, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01,
+	0x65, 0x03, 0x04, 0x02, 0x01, 0x05, 0x00, 0x30, 0x0b, 0x06, 0x09, 0x2a,
+	0x86, 0x48, 0x86, 0xf7, 0x0d, 0x01, 0x07, 0x01, 0xa0, 0x82, 0x01, 0x7e,
+	0x30, 0x82, 0x01, 0x7a, 0x30, 0x82, 0x01, 0x1f, 0xa0, 0x03, 0x02, 0x01,
+	0x02, 0x02, 0x14, 0x43, 0x2b, 0x15, 0x2d, 0x43, 0x73, 0x3a, 0x2f, 0xe8,
+	0x9e, 0xbf, 0x83, 0xa7, 0x6b, 0x2b, 0x76, 0x55, 0x8f, 0xaf, 0x80, 0x30,
+	0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x30,
+	0x11, 0x31, 0x0f, 0x30, 0x0d, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x06,
+	0x72, 0x65, 0x74, 0x64, 0x65, 0x63, 0x30, 0x20, 0x17, 0x0d, 0x32, 0x36,
+	0x31, 0x30, 0x31, 0x39, 0x31, 0x36, 0x30, 0x39, 0x33, 0x32, 0x5a, 0x18,
+	0x0f, 0x32, 0x31, 0x32, 0x36, 0x30, 0x39, 0x32, 0x35, 0x31, 0x36, 0x30,
+	0x39, 0x33, 0x32, 0x5a, 0x30, 0x11, 0x31, 0x0f, 0x30, 0x0d, 0x06, 0x03,
+	0x55, 0x04, 0x03, 0x0c, 0x06, 0x72, 0x65, 0x74, 0x64, 0x65, 0x63, 0x30,
+	0x59, 0x30, 0x13, 0x06, 0x07, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x02, 0x01,
+	0x06, 0x08, 0x2a, 0x86, 0x48, 0xce, 0x3d, 0x03, 0x01, 0x07, 0x03, 0x42,
+	0x00, 0x04, 0x16, 0x4c, 0xf5, 0xb2, 0xba, 0x5d, 0xca, 0x4f, 0xc5, 0x18,
+	0x91, 0x26, 0x7a, 0x04, 0x66, 0xdd, 0x82, 0x94, 0x1a, 0x6e, 0xbb, 0x05,
+	0xd8, 0x87, 0xb3, 0x62, 0xa3, 0x7d, 0x7f, 0x59, 0x62, 0xc2, 0xd1, 0xcd,
+	0xba, 0x11, 0xd5, 0x27, 0x6b, 0xf1, 0x59, 0x90, 0xd9, 0xd7, 0x87, 0xc3,
+	0xdc, 0xc8, 0x42, 0xae, 0x9a, 0x1a, 0xf9, 0x4c, 0x11, 0xf5, 0xcf, 0xed,
+	0x25, 0xb0, 0xff, 0xb7, 0xcd, 0x51, 0xa3, 0x53, 0x30, 0x51, 0x30, 0x1d,
+	0x06, 0x03, 0x55, 0x1d, 0x0e, 0x04, 0x16, 0x04, 0x14, 0x74, 0xa9, 0x7a,
+	0x40, 0x1a, 0xb4, 0x3f, 0x06, 0xe8, 0x21, 0x84, 0x0e, 0x71, 0x40, 0x18,
+	0xbb, 0x97, 0xbe, 0xe8, 0x31, 0x30, 0x1f, 0x06, 0x03, 0x55, 0x1d, 0x23,
+	0x04, 0x18, 0x30, 0x16, 0x80, 0x14, 0x74, 0xa9, 0x7a, 0x40, 0x1a, 0xb4,
+	0x3f, 0x06, 0xe8, 0x21, 0x84, 0x0e, 0x71, 0x40, 0x18, 0xbb, 0x97, 0xbe,
+	0xe8, 0x31, 0x30, 0x0f, 0x06, 0x03, 0x55, 0x1d, 0x13, 0x01, 0x01, 0xff,
+	0x04, 0x05, 0x30, 0x03, 0x01, 0x01, 0xff, 0x30, 0x0a, 0x06, 0x08, 0x2a,
+	0x86, 0x48, 0xce, 0x3d, 0x04, 0x03, 0x02, 0x03, 0x49, 0x00, 0x30, 0x46,
+	0x02, 0x21, 0x00, 0xfc, 0xe1, 0x7b, 0x9f, 0x3f, 0x9c, 0x73, 0x91, 0xd9,
+	0xa5, 0x47, 0x11, 0x2e, 0xe4, 0x44, 0x15, 0x2a, 0xa6, 0x66, 0xe2, 0x58,
+	0x04, 0x3a, 0x60, 0xd8, 0x4e, 0x28, 0x01, 0xc8, 0xb1, 0x61, 0x75, 0x02,
+	0x21, 0x00, 0xfb, 0x1c, 0x66, 0x64, 0x0e, 0xfb, 0xb8, 0xf1, 0x9a, 0xa2,
+	0x31, 0x52, 0xb5, 0x8c, 0x63, 0xd2, 0x35, 0xf7, 0x16, 0xc4, 0x3b, 0xb1,
+	0x61, 0x88, 0xaa, 0x6d, 0x20, 0xcd, 0x66, 0xe1, 0x34, 0xdd, 0x31, 0x81,
+	0x94, 0x30, 0x81, 0x91, 0x02, 0x01, 0x01, 0x30, 0x29, 0x30, 0x11, 0x31,
+	0x0f, 0x30, 0x0d, 0x06, 0x03, 0x55, 0x04, 0x03, 0x0c, 0x06, 0x72, 0x65,
+	0x74, 0x64, 0x65, 0x63, 0x02, 0x14, 0x43, 0x2b, 0x15, 0x2d, 0x43, 0x73,
+	0x3a, 0x2f, 0xe8, 0x9e, 0xbf, 0x83, 0xa7, 0x6b, 0x2b, 0x76, 0x55, 0x8f,
+	0xaf, 0x80, 0x30, 0x0d, 0x06, 0x09, 0x60, 0x86, 0x48, 0x01, 0x65, 0x03,
+	0x04, 0x02, 0x01, 0x05, 0x00, 0x30, 0x0a, 0x06, 0x08, 0x2a, 0x86, 0x48,
+	0xce, 0x3d, 0x04, 0x03, 0x02, 0x04, 0x46, 0x30, 0x44, 0x02, 0x20, 0x0c,
+	0xd5, 0x4e, 0x13, 0x87, 0xd0, 0x84, 0x78, 0x37, 0x5b, 0xc1, 0x73, 0x99,
+	0xbd, 0x2e, 0x42, 0x34, 0xab, 0x0e, 0xcb, 0x67, 0xf4, 0xc6, 0x66, 0xe8,
+	0x31, 0xf2, 0xac, 0x19, 0xcf, 0xba, 0xf2, 0x02, 0x20, 0x3f, 0x4b, 0xe7,
+	0x71, 0xbd, 0x6b, 0x38, 0xaa, 0xaa, 0x3e, 0x4c, 0xed, 0xc1, 0x95, 0xa9,
+	0x70, 0xb8, 0x09, 0x87, 0xd0, 0xe1, 0xe8, 0xf4, 0x4e, 0xbb, 0xbd, 0xa1,
+	0x69, 0xef, 0xb2, 0xfa, 0x2b
+};
+
+/**
+ * Store little-endian 16-bit value into bytes at the given offset.
+ */
+void put16(std::vector<uint8_t> &bytes, std::size_t offset, std::uint16_t value)
+{
+	bytes[offset] = value & 0xff;
+	bytes[offset + 1] = value >> 8;
+}
+
+/**
+ * Store little-endian 32-bit value into bytes at the given offset.
+ */
+void put32(std::vector<uint8_t> &bytes, std::size_t offset, std::uint32_t value)
+{
+	put16(bytes, offset, value & 0xffff);
+	put16(bytes, offset + 2, value >> 16);
+}
+
+/**
+ * Create PE file with all the parts which can be skipped by load flags.
+ *
+ * It is @c peBytes (which already has imports, an empty export table and
+ * anomalies) with PE header moved behind a rich header, with resources and
+ * .NET headers in the enlarged section and with a certificate in overlay.
+ */
+std::vector<uint8_t> makePeWithAllStructures()
+{
+	auto bytes = peBytes;
+	bytes.resize(0x600);
+
+	// Move PE header behind the rich header ("DanS", padding, one record,
+	// "Rich" and the key).
+	const std::size_t pe = 0xc0;
+	std::copy(peBytes.begin() + 0x40, peBytes.begin() + 0x160, bytes.begin() + pe);
+	std::fill(bytes.begin() + 0x40, bytes.begin() + pe, 0);
+	put32(bytes, 0x3c, pe);
+	const std::uint32_t key = 0x1badcafe;
+	const std::uint32_t rich[] = {0x536e6144 ^ key, key, key, key,
+			0x00010001 ^ key, 1 ^ key, 0x68636952, key};
+	for (std::size_t i = 0; i < 8; ++i)
+	{
+		put32(bytes, 0x80 + 4 * i, rich[i]);
+	}
+
+	const std::size_t opt = pe + 24;
+	const auto setDataDir = [&](std::size_t index, std::uint32_t address, std::uint32_t size)
+	{
+		put32(bytes, opt + 96 + 8 * index, address);
+		put32(bytes, opt + 100 + 8 * index, size);
+	};
+	// Size of headers and size of raw data of the only section.
+	put32(bytes, opt + 60, 0x200);
+	put32(bytes, opt + 0xe0 + 16, 0x400);
+
+	// RCDATA resource at RVA 0x1200: type, name and language directories.
+	const std::size_t res = 0x400;
+	put16(bytes, res + 0x0e, 1);
+	put32(bytes, res + 0x10, 10);
+	put32(bytes, res + 0x14, 0x80000018);
+	put16(bytes, res + 0x26, 1);
+	put32(bytes, res + 0x28, 1);
+	put32(bytes, res + 0x2c, 0x80000030);
+	put16(bytes, res + 0x3e, 1);
+	put32(bytes, res + 0x40, 0x409);
+	put32(bytes, res + 0x44, 0x48);
+	put32(bytes, res + 0x48, 0x1260);
+	put32(bytes, res + 0x4c, 4);
+	put32(bytes, res + 0x60, 0x61746164); // "data"
+	setDataDir(2, 0x1200, 0x70);
+
+	// CLR header at RVA 0x1300 followed by metadata header without streams.
+	const std::size_t clr = 0x500;
+	put32(bytes, clr, 72);
+	put16(bytes, clr + 4, 2);
+	put16(bytes, clr + 6, 5);
+	put32(bytes, clr + 8, 0x1348);
+	put32(bytes, clr + 12, 0x20);
+	put32(bytes, clr + 16, 1);
+	put32(bytes, clr + 0x48, 0x424a5342); // "BSJB"
+	put16(bytes, clr + 0x4c, 1);
+	put16(bytes, clr + 0x4e, 1);
+	put32(bytes, clr + 0x54, 4);
+	put16(bytes, clr + 0x58, 0x3476); // "v4"
+	setDataDir(14, 0x1300, 72);
+
+	// Certificate in overlay.
+	const std::size_t cert = bytes.size();
+	bytes.resize(cert + 8);
+	put32(bytes, cert, 8 + signatureBytes.size());
+	put16(bytes, cert + 4, 0x0200);
+	put16(bytes, cert + 6, 0x0002);
+	bytes.insert(bytes.end(), signatureBytes.begin(), signatureBytes.end());
+	bytes.resize((bytes.size() + 7) & ~7);
+	setDataDir(4, cert, bytes.size() - cert);
+
+	return bytes;
+}
+
+} // anonymous namespace
+
 /**
  * Tests for the @c coff_format module - using istream constructor.
  */
@@ -204,6 +367,116 @@ TEST_F(PeFormatTests_data, DataInterpretationDefault)
 	EXPECT_EQ(0x105d0040103805c7, res);
 }
 
+TEST_F(PeFormatTests_data, DllListIsLoadedOnceAndShared)
+{
+	const auto listPath = (fs::temp_directory_path() / ("retdec-pe-format-tests-dlls-"
+			+ std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())
+			+ ".txt")).string();
+	std::ofstream(listPath) << "KERNEL32.dll\nFoo.DLL\n";
+
+	ASSERT_TRUE(parser->initDllList(listPath));
+	EXPECT_FALSE(parser->isMissingDependency("foo.dll"));
+	EXPECT_FALSE(parser->isMissingDependency("kernel32.DLL"));
+	EXPECT_TRUE(parser->isMissingDependency("bar.dll"));
+
+	// The list is not read again for other files, so they get it even when
+	// the file does not exist anymore.
+	fs::remove(listPath);
+	PeFormat other(peBytes.data(), peBytes.size());
+	ASSERT_TRUE(other.initDllList(listPath));
+	EXPECT_FALSE(other.dllListFailedToLoad());
+	EXPECT_FALSE(other.isMissingDependency("FOO.dll"));
+	EXPECT_TRUE(other.isMissingDependency("bar.dll"));
+
+	EXPECT_FALSE(other.initDllList(listPath + ".missing"));
+	EXPECT_TRUE(other.dllListFailedToLoad());
+}
+
+/**
+ * Tests of load flags which skip parts of PE files.
+ */
+class PeFormatTests_loadFlags : public Test
+{
+	protected:
+		std::vector<uint8_t> bytes = makePeWithAllStructures();
+
+		std::unique_ptr<PeFormat> load(LoadFlags flags)
+		{
+			return std::make_unique<PeFormat>(bytes.data(), bytes.size(), flags);
+		}
+};
+
+TEST_F(PeFormatTests_loadFlags, AllStructuresAreLoadedWithoutFlags)
+{
+	auto parser = load(LoadFlags::NONE);
+	ASSERT_TRUE(parser->isInValidState());
+	EXPECT_NE(nullptr, parser->getRichHeader());
+	EXPECT_NE(nullptr, parser->getImportTable());
+	EXPECT_NE(nullptr, parser->getExportTable());
+	EXPECT_NE(nullptr, parser->getResourceTable());
+	EXPECT_NE(nullptr, parser->getCertificateTable());
+	EXPECT_NE(nullptr, parser->getCLRHeader());
+	EXPECT_NE(nullptr, parser->getMetadataHeader());
+	EXPECT_FALSE(parser->getAnomalies().empty());
+}
+
+TEST_F(PeFormatTests_loadFlags, RichHeaderIsSkipped)
+{
+	auto parser = load(LoadFlags::NO_RICH_HEADER);
+	ASSERT_TRUE(parser->isInValidState());
+	EXPECT_EQ(nullptr, parser->getRichHeader());
+	EXPECT_NE(nullptr, parser->getImportTable());
+}
+
+TEST_F(PeFormatTests_loadFlags, ImportsAreSkipped)
+{
+	auto parser = load(LoadFlags::NO_IMPORTS);
+	ASSERT_TRUE(parser->isInValidState());
+	EXPECT_EQ(nullptr, parser->getImportTable());
+	EXPECT_NE(nullptr, parser->getExportTable());
+}
+
+TEST_F(PeFormatTests_loadFlags, ExportsAreSkipped)
+{
+	auto parser = load(LoadFlags::NO_EXPORTS);
+	ASSERT_TRUE(parser->isInValidState());
+	EXPECT_EQ(nullptr, parser->getExportTable());
+	EXPECT_NE(nullptr, parser->getImportTable());
+}
+
+TEST_F(PeFormatTests_loadFlags, ResourcesAreSkipped)
+{
+	auto parser = load(LoadFlags::NO_RESOURCES);
+	ASSERT_TRUE(parser->isInValidState());
+	EXPECT_EQ(nullptr, parser->getResourceTable());
+	EXPECT_NE(nullptr, parser->getCertificateTable());
+}
+
+TEST_F(PeFormatTests_loadFlags, CertificatesAreSkipped)
+{
+	auto parser = load(LoadFlags::NO_CERTIFICATES);
+	ASSERT_TRUE(parser->isInValidState());
+	EXPECT_EQ(nullptr, parser->getCertificateTable());
+	EXPECT_NE(nullptr, parser->getResourceTable());
+}
+
+TEST_F(PeFormatTests_loadFlags, DotnetHeadersAreSkipped)
+{
+	auto parser = load(LoadFlags::NO_DOTNET);
+	ASSERT_TRUE(parser->isInValidState());
+	EXPECT_EQ(nullptr, parser->getCLRHeader());
+	EXPECT_EQ(nullptr, parser->getMetadataHeader());
+	EXPECT_NE(nullptr, parser->getRichHeader());
+}
+
+TEST_F(PeFormatTests_loadFlags, AnomaliesAreSkipped)
+{
+	auto parser = load(LoadFlags::NO_ANOMALIES);
+	ASSERT_TRUE(parser->isInValidState());
+	EXPECT_TRUE(parser->getAnomalies().empty());
+	EXPECT_NE(nullptr, parser->getCLRHeader());
+}
+
 } // namespace tests
 } // namespace fileformat
 } // namespace retdec
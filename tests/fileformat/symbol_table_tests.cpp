@@ -0,0 +1,161 @@
+/**
+ * @file tests/fileformat/symbol_table_tests.cpp
+ * @brief Tests for the @c symbol_table module.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/types/symbol_table/symbol_table.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+class SymbolTableTests : public Test
+{
+	protected:
+		SymbolTable table;
+
+		std::shared_ptr<Symbol> addSymbol(
+				const std::string &name,
+				unsigned long long address,
+				unsigned long long index)
+		{
+			auto symbol = std::make_shared<Symbol>();
+			symbol->setName(name);
+			symbol->setAddress(address);
+			symbol->setIndex(index);
+			table.addSymbol(symbol);
+			return symbol;
+		}
+
+		/// Lookups through the const interface, which uses the indexes.
+		const SymbolTable& constTable() const
+		{
+			return table;
+		}
+};
+
+TEST_F(SymbolTableTests, LookupsFindSymbols)
+{
+	auto foo = addSymbol("foo", 0x1000, 1);
+	auto bar = addSymbol("bar", 0x2000, 2);
+
+	EXPECT_EQ(foo.get(), constTable().getSymbol("foo"));
+	EXPECT_EQ(bar.get(), constTable().getSymbol("bar"));
+	EXPECT_EQ(bar.get(), constTable().getSymbolOnAddress(0x2000));
+	EXPECT_EQ(foo.get(), constTable().getSymbolWithIndex(1));
+	EXPECT_EQ(nullptr, constTable().getSymbol("baz"));
+	EXPECT_EQ(nullptr, constTable().getSymbolOnAddress(0x3000));
+	EXPECT_EQ(nullptr, constTable().getSymbolWithIndex(3));
+	EXPECT_TRUE(constTable().hasSymbol("foo"));
+	EXPECT_TRUE(constTable().hasSymbol(0x1000));
+}
+
+TEST_F(SymbolTableTests, FirstSymbolWithSameKeyIsFound)
+{
+	auto first = addSymbol("foo", 0x1000, 1);
+	addSymbol("foo", 0x1000, 1);
+
+	EXPECT_EQ(first.get(), constTable().getSymbol("foo"));
+	EXPECT_EQ(first.get(), constTable().getSymbolOnAddress(0x1000));
+	EXPECT_EQ(first.get(), constTable().getSymbolWithIndex(1));
+}
+
+TEST_F(SymbolTableTests, SymbolWithoutAddressIsNotFoundOnAddress)
+{
+	auto symbol = std::make_shared<Symbol>();
+	symbol->setName("foo");
+	table.addSymbol(symbol);
+
+	EXPECT_EQ(symbol.get(), constTable().getSymbol("foo"));
+	EXPECT_EQ(nullptr, constTable().getSymbolOnAddress(0));
+}
+
+TEST_F(SymbolTableTests, AddedSymbolIsFoundAfterLookup)
+{
+	addSymbol("foo", 0x1000, 1);
+	ASSERT_EQ(nullptr, constTable().getSymbol("bar"));
+
+	auto bar = addSymbol("bar", 0x2000, 2);
+
+	EXPECT_EQ(bar.get(), constTable().getSymbol("bar"));
+	EXPECT_EQ(bar.get(), constTable().getSymbolOnAddress(0x2000));
+	EXPECT_EQ(bar.get(), constTable().getSymbolWithIndex(2));
+}
+
+TEST_F(SymbolTableTests, MovedSymbolIsFoundAfterLookup)
+{
+	ASSERT_EQ(nullptr, constTable().getSymbol("foo"));
+
+	auto symbol = std::make_shared<Symbol>();
+	symbol->setName("foo");
+	table.addSymbol(std::move(symbol));
+
+	EXPECT_NE(nullptr, constTable().getSymbol("foo"));
+}
+
+TEST_F(SymbolTableTests, NoSymbolIsFoundAfterClear)
+{
+	addSymbol("foo", 0x1000, 1);
+	ASSERT_NE(nullptr, constTable().getSymbol("foo"));
+
+	table.clear();
+
+	EXPECT_EQ(nullptr, constTable().getSymbol("foo"));
+	EXPECT_EQ(nullptr, constTable().getSymbolOnAddress(0x1000));
+	EXPECT_EQ(nullptr, constTable().getSymbolWithIndex(1));
+}
+
+TEST_F(SymbolTableTests, SymbolModifiedThroughGetterIsFoundAfterLookup)
+{
+	addSymbol("foo", 0x1000, 1);
+	ASSERT_NE(nullptr, constTable().getSymbol("foo"));
+
+	auto *symbol = table.getSymbol("foo");
+	symbol->setName("bar");
+	symbol->setAddress(0x2000);
+	symbol->setIndex(2);
+
+	EXPECT_EQ(nullptr, constTable().getSymbol("foo"));
+	EXPECT_EQ(symbol, constTable().getSymbol("bar"));
+	EXPECT_EQ(nullptr, constTable().getSymbolOnAddress(0x1000));
+	EXPECT_EQ(symbol, constTable().getSymbolOnAddress(0x2000));
+	EXPECT_EQ(nullptr, constTable().getSymbolWithIndex(1));
+	EXPECT_EQ(symbol, constTable().getSymbolWithIndex(2));
+}
+
+TEST_F(SymbolTableTests, SymbolModifiedThroughIteratorIsFoundAfterLookup)
+{
+	addSymbol("foo", 0x1000, 1);
+	ASSERT_NE(nullptr, constTable().getSymbol("foo"));
+
+	for (auto &symbol : table)
+	{
+		symbol->setName("bar");
+	}
+
+	EXPECT_EQ(nullptr, constTable().getSymbol("foo"));
+	EXPECT_NE(nullptr, constTable().getSymbol("bar"));
+}
+
+TEST_F(SymbolTableTests, ConstIteratorGivesOnlyConstSymbols)
+{
+	auto foo = addSymbol("foo", 0x1000, 1);
+
+	auto it = constTable().begin();
+	static_assert(
+			std::is_same<decltype(*it), std::shared_ptr<const Symbol>>::value,
+			"symbols must not be modifiable through const iterator");
+	EXPECT_EQ(foo, *it);
+	EXPECT_EQ(constTable().end(), ++it);
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -0,0 +1,238 @@
+/**
+ * @file tests/fileinfo/batch_analysis_tests.cpp
+ * @brief Tests for the @c batch_analysis module.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <gtest/gtest.h>
+
+#include "retdec/utils/filesystem.h"
+#include "fileinfo/batch/batch_analysis.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileinfo {
+namespace tests {
+
+class BatchAnalysisTests : public Test
+{
+	protected:
+		std::string listPath;
+
+		void SetUp() override
+		{
+			listPath = (fs::temp_directory_path() / ("retdec-batch-analysis-tests-"
+					+ std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())
+					+ ".txt")).string();
+		}
+
+		void TearDown() override
+		{
+			std::error_code ec;
+			fs::remove(listPath, ec);
+		}
+
+		void writeList(const std::string &content)
+		{
+			std::ofstream(listPath, std::ios::binary) << content;
+		}
+
+		std::vector<std::string> createPaths(std::size_t count)
+		{
+			std::vector<std::string> paths;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				paths.push_back("file" + std::to_string(i));
+			}
+			return paths;
+		}
+};
+
+TEST_F(BatchAnalysisTests, NamesFromCommandLineComeBeforeNamesFromList)
+{
+	const std::vector<std::string> paths = {"a", "b"};
+	writeList("c\r\n\nd\n\n");
+	BatchAnalysis batch(paths, listPath);
+	ASSERT_TRUE(batch.isInValidState());
+
+	std::vector<std::string> results;
+	batch.run(
+		[](const std::string &path) { return "result of " + path; },
+		[&](const std::string &result) { results.push_back(result); },
+		1
+	);
+
+	EXPECT_EQ(
+		std::vector<std::string>({"result of a", "result of b", "result of c", "result of d"}),
+		results
+	);
+}
+
+TEST_F(BatchAnalysisTests, EveryFileIsAnalyzedOnceByManyThreads)
+{
+	const auto paths = createPaths(100);
+	std::string list;
+	for (const auto &path : createPaths(200))
+	{
+		list += "list_" + path + "\n";
+	}
+	writeList(list);
+	BatchAnalysis batch(paths, listPath);
+
+	std::atomic<std::size_t> analyzed(0);
+	std::atomic<std::size_t> printing(0);
+	bool concurrentPrinting = false;
+	std::vector<std::string> results;
+	batch.run(
+		[&](const std::string &path)
+		{
+			++analyzed;
+			return path;
+		},
+		[&](const std::string &result)
+		{
+			if (++printing > 1)
+			{
+				concurrentPrinting = true;
+			}
+			results.push_back(result);
+			--printing;
+		},
+		8
+	);
+
+	EXPECT_EQ(300, analyzed);
+	EXPECT_FALSE(concurrentPrinting);
+	ASSERT_EQ(300, results.size());
+	std::sort(results.begin(), results.end());
+	EXPECT_TRUE(std::adjacent_find(results.begin(), results.end()) == results.end());
+	EXPECT_TRUE(std::binary_search(results.begin(), results.end(), "file99"));
+	EXPECT_TRUE(std::binary_search(results.begin(), results.end(), "list_file199"));
+}
+
+TEST_F(BatchAnalysisTests, FatalErrorInOneFileDoesNotStopOtherFiles)
+{
+	const auto paths = createPaths(50);
+	BatchAnalysis batch(paths, "");
+
+	std::vector<std::string> results;
+	batch.run(
+		[](const std::string &path)
+		{
+			// The same way as the analysis of fileinfo, which gets the error
+			// from the LLVM fatal error handler.
+			try
+			{
+				if (path == "file7" || path == "file33")
+				{
+					throw BatchFatalError("corrupted " + path);
+				}
+				return path + " ok";
+			}
+			catch (const BatchFatalError &)
+			{
+				return path + " failed";
+			}
+		},
+		[&](const std::string &result) { results.push_back(result); },
+		4
+	);
+
+	ASSERT_EQ(50, results.size());
+	EXPECT_EQ(2, std::count_if(results.begin(), results.end(), [](const auto &result) {
+		return result.find("failed") != std::string::npos;
+	}));
+	EXPECT_NE(results.end(), std::find(results.begin(), results.end(), "file7 failed"));
+	EXPECT_NE(results.end(), std::find(results.begin(), results.end(), "file49 ok"));
+}
+
+TEST_F(BatchAnalysisTests, ExceptionInOneFileIsReportedAndOtherFilesAreAnalyzed)
+{
+	const auto paths = createPaths(50);
+	BatchAnalysis batch(paths, "");
+
+	std::vector<std::string> results;
+	batch.run(
+		[](const std::string &path) -> std::string
+		{
+			if (path == "file3")
+			{
+				throw std::out_of_range("offset out of file");
+			}
+			if (path == "file20")
+			{
+				throw std::bad_alloc();
+			}
+			if (path == "file41")
+			{
+				throw 42;
+			}
+			return path + " ok";
+		},
+		[&](const std::string &result) { results.push_back(result); },
+		4,
+		[](const std::string &path, const std::string &message)
+		{
+			return path + " failed: " + message;
+		}
+	);
+
+	ASSERT_EQ(50, results.size());
+	EXPECT_NE(results.end(), std::find(results.begin(), results.end(),
+			"file3 failed: offset out of file"));
+	EXPECT_NE(results.end(), std::find(results.begin(), results.end(),
+			"file20 failed: " + std::string(std::bad_alloc().what())));
+	EXPECT_NE(results.end(), std::find(results.begin(), results.end(),
+			"file41 failed: unknown exception"));
+	EXPECT_EQ(47, std::count_if(results.begin(), results.end(), [](const auto &result) {
+		return result.find(" ok") != std::string::npos;
+	}));
+}
+
+TEST_F(BatchAnalysisTests, FileWithExceptionIsSkippedWithoutFailureHandler)
+{
+	const std::vector<std::string> paths = {"a", "b", "c"};
+	BatchAnalysis batch(paths, "");
+
+	std::vector<std::string> results;
+	batch.run(
+		[](const std::string &path) -> std::string
+		{
+			if (path == "b")
+			{
+				throw std::runtime_error("malformed");
+			}
+			return path;
+		},
+		[&](const std::string &result) { results.push_back(result); },
+		1
+	);
+
+	EXPECT_EQ(std::vector<std::string>({"a", "c"}), results);
+}
+
+TEST_F(BatchAnalysisTests, MissingListFileIsReported)
+{
+	const std::vector<std::string> paths = {"a"};
+	BatchAnalysis batch(paths, listPath + ".missing");
+	EXPECT_FALSE(batch.isInValidState());
+}
+
+TEST_F(BatchAnalysisTests, NumberOfJobsIsLimited)
+{
+	EXPECT_EQ(3, BatchAnalysis::getNumberOfJobs(3));
+	EXPECT_EQ(BatchAnalysis::MAX_JOBS, BatchAnalysis::getNumberOfJobs(100000));
+	EXPECT_GE(BatchAnalysis::getNumberOfJobs(0), 1);
+	EXPECT_LE(BatchAnalysis::getNumberOfJobs(0), BatchAnalysis::MAX_JOBS);
+}
+
+} // namespace tests
+} // namespace fileinfo
+} // namespace retdec
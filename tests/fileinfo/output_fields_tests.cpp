@@ -0,0 +1,152 @@
+/**
+ * @file tests/fileinfo/output_fields_tests.cpp
+ * @brief Tests for the @c output_fields module.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <gtest/gtest.h>
+
+#include "fileinfo/file_information/file_information_types/output_fields.h"
+
+using namespace ::testing;
+using namespace retdec::fileformat;
+
+namespace retdec {
+namespace fileinfo {
+namespace tests {
+
+class OutputFieldsTests : public Test
+{
+	protected:
+		/// All parts of PE files that can be skipped.
+		static constexpr unsigned allSkipped = LoadFlags::NO_RICH_HEADER
+				| LoadFlags::NO_IMPORTS | LoadFlags::NO_EXPORTS
+				| LoadFlags::NO_RESOURCES | LoadFlags::NO_CERTIFICATES
+				| LoadFlags::NO_DOTNET | LoadFlags::NO_ANOMALIES;
+
+		/// Get load flags for fields given by their names.
+		static unsigned flagsFor(const std::string &list)
+		{
+			OutputFields fields = OutputFields::NO_FIELDS;
+			EXPECT_TRUE(parseOutputFields(list, fields));
+			return getLoadFlagsForOutputFields(fields);
+		}
+
+		/// Get parts of PE files skipped for fields given by their names.
+		static unsigned skippedFor(const std::string &list)
+		{
+			return flagsFor(list) & allSkipped;
+		}
+};
+
+//
+// parseOutputFields()
+//
+
+TEST_F(OutputFieldsTests, ValidNamesAreParsed)
+{
+	OutputFields fields = OutputFields::NO_FIELDS;
+
+	ASSERT_TRUE(parseOutputFields("hashes,imports, cpdetect", fields));
+	EXPECT_EQ(OutputFields::HASHES | OutputFields::IMPORTS | OutputFields::CPDETECT,
+			fields);
+}
+
+TEST_F(OutputFieldsTests, AllNamesFromHelpAreParsed)
+{
+	OutputFields fields = OutputFields::NO_FIELDS;
+
+	ASSERT_TRUE(parseOutputFields(getOutputFieldNames(), fields));
+	EXPECT_EQ(OutputFields::ALL_FIELDS, fields);
+}
+
+TEST_F(OutputFieldsTests, AllSelectsAllFields)
+{
+	OutputFields fields = OutputFields::NO_FIELDS;
+
+	ASSERT_TRUE(parseOutputFields("all", fields));
+	EXPECT_EQ(OutputFields::ALL_FIELDS, fields);
+}
+
+TEST_F(OutputFieldsTests, DuplicateNamesSelectFieldOnce)
+{
+	OutputFields fields = OutputFields::NO_FIELDS;
+
+	ASSERT_TRUE(parseOutputFields("exports,tls,exports", fields));
+	EXPECT_EQ(OutputFields::EXPORTS | OutputFields::TLS, fields);
+}
+
+TEST_F(OutputFieldsTests, UnknownNameIsRejectedAndFieldsAreKept)
+{
+	OutputFields fields = OutputFields::HASHES;
+
+	EXPECT_FALSE(parseOutputFields("imports,foo", fields));
+	EXPECT_FALSE(parseOutputFields("Imports", fields));
+	EXPECT_FALSE(parseOutputFields("imports,", fields));
+	EXPECT_EQ(OutputFields::HASHES, fields);
+}
+
+//
+// getLoadFlagsForOutputFields()
+//
+
+TEST_F(OutputFieldsTests, DefaultOutputLoadsEverything)
+{
+	EXPECT_EQ(LoadFlags::NONE, getLoadFlagsForOutputFields(OutputFields::ALL_FIELDS));
+	EXPECT_EQ(LoadFlags::NONE, flagsFor("all"));
+}
+
+TEST_F(OutputFieldsTests, FieldWithoutStructuresSkipsAllOfThem)
+{
+	EXPECT_EQ(allSkipped | LoadFlags::NO_FILE_HASHES | LoadFlags::NO_VERBOSE_HASHES,
+			flagsFor("sections"));
+}
+
+TEST_F(OutputFieldsTests, HashesAreComputedOnlyForHashes)
+{
+	EXPECT_FALSE(flagsFor("hashes") & (LoadFlags::NO_FILE_HASHES | LoadFlags::NO_VERBOSE_HASHES));
+	EXPECT_TRUE(flagsFor("imports") & LoadFlags::NO_FILE_HASHES);
+}
+
+TEST_F(OutputFieldsTests, StringsAreDetectedOnlyForStrings)
+{
+	EXPECT_TRUE(flagsFor("strings") & LoadFlags::DETECT_STRINGS);
+	EXPECT_FALSE(flagsFor("header") & LoadFlags::DETECT_STRINGS);
+}
+
+TEST_F(OutputFieldsTests, FieldLoadsOnlyItsOwnStructure)
+{
+	EXPECT_EQ(allSkipped & ~LoadFlags::NO_RICH_HEADER, skippedFor("richHeader"));
+	EXPECT_EQ(allSkipped & ~LoadFlags::NO_EXPORTS, skippedFor("exports"));
+	EXPECT_EQ(allSkipped & ~LoadFlags::NO_RESOURCES, skippedFor("resources"));
+	EXPECT_EQ(allSkipped & ~LoadFlags::NO_CERTIFICATES, skippedFor("certificates"));
+	EXPECT_EQ(allSkipped & ~LoadFlags::NO_DOTNET, skippedFor("dotnet"));
+}
+
+TEST_F(OutputFieldsTests, ImportsAreLoadedForImportsAndLoader)
+{
+	EXPECT_EQ(allSkipped & ~LoadFlags::NO_IMPORTS, skippedFor("imports"));
+	EXPECT_EQ(allSkipped & ~LoadFlags::NO_IMPORTS, skippedFor("loader"));
+}
+
+TEST_F(OutputFieldsTests, CpdetectGetsAllStructuresItLooksInto)
+{
+	EXPECT_EQ(LoadFlags::NO_CERTIFICATES | LoadFlags::NO_ANOMALIES,
+			skippedFor("cpdetect"));
+}
+
+TEST_F(OutputFieldsTests, AnomaliesGetImportsExportsAndResources)
+{
+	EXPECT_EQ(LoadFlags::NO_RICH_HEADER | LoadFlags::NO_CERTIFICATES | LoadFlags::NO_DOTNET,
+			skippedFor("anomalies"));
+}
+
+TEST_F(OutputFieldsTests, FlagsOfSeveralFieldsAreCombined)
+{
+	EXPECT_EQ(LoadFlags::NO_RICH_HEADER | LoadFlags::NO_IMPORTS | LoadFlags::NO_DOTNET
+			| LoadFlags::NO_ANOMALIES, skippedFor("exports,resources,certificates"));
+}
+
+} // namespace tests
+} // namespace fileinfo
+} // namespace retdec
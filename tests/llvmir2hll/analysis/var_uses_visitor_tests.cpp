@@ -281,6 +281,65 @@ GlobalVariableIsIndirectlyUsedMay) {
 	}
 }
 
+TEST_F(VarUsesVisitorTests,
+CachedUsesAreUpdatedWhenStatementIsChangedOrRemoved) {
+	// Set-up the module.
+	//
+	// def test():
+	//    a = 1
+	//    return a
+	//
+	ShPtr<Variable> varA(Variable::create("a", IntType::create(32)));
+	testFunc->addLocalVar(varA);
+	ShPtr<ReturnStmt> returnA(ReturnStmt::create(varA));
+	ShPtr<VarDefStmt> varADef(VarDefStmt::create(varA,
+		ConstInt::create(1, 32), returnA));
+	testFunc->setBody(varADef);
+
+	INSTANTIATE_ALIAS_ANALYSIS_AND_VALUE_ANALYSIS(module);
+	ShPtr<VarUsesVisitor> vuv(VarUsesVisitor::create(va, true, module));
+
+	// return a -> return 2
+	returnA->setRetVal(ConstInt::create(2, 32));
+	vuv->stmtHasBeenChanged(returnA, testFunc);
+	StmtSet refVarAUses;
+	refVarAUses.insert(varADef);
+	EXPECT_EQ(refVarAUses, vuv->getUses(varA, testFunc)->dirUses);
+
+	// Remove a = 1.
+	testFunc->setBody(returnA);
+	vuv->stmtHasBeenRemoved(varADef, testFunc);
+	EXPECT_TRUE(vuv->getUses(varA, testFunc)->dirUses.empty());
+	EXPECT_FALSE(vuv->isUsed(varA, testFunc));
+}
+
+TEST_F(VarUsesVisitorTests,
+CachedUsesAreUpdatedWhenStatementIsAdded) {
+	// Set-up the module.
+	//
+	// def test():
+	//    return a
+	//
+	ShPtr<Variable> varA(Variable::create("a", IntType::create(32)));
+	testFunc->addLocalVar(varA);
+	ShPtr<ReturnStmt> returnA(ReturnStmt::create(varA));
+	testFunc->setBody(returnA);
+
+	INSTANTIATE_ALIAS_ANALYSIS_AND_VALUE_ANALYSIS(module);
+	ShPtr<VarUsesVisitor> vuv(VarUsesVisitor::create(va, true));
+	StmtSet refVarAUses;
+	refVarAUses.insert(returnA);
+	EXPECT_EQ(refVarAUses, vuv->getUses(varA, testFunc)->dirUses);
+
+	// Add a = 1 before the return statement.
+	ShPtr<AssignStmt> assignA1(AssignStmt::create(varA,
+		ConstInt::create(1, 32), returnA));
+	testFunc->setBody(assignA1);
+	vuv->stmtHasBeenAdded(assignA1, testFunc);
+	refVarAUses.insert(assignA1);
+	EXPECT_EQ(refVarAUses, vuv->getUses(varA, testFunc)->dirUses);
+}
+
 } // namespace tests
 } // namespace llvmir2hll
 } // namespace retdec
@@ -0,0 +1,101 @@
+/**
+* @file tests/llvmir2hll/hll/output_managers/recording_manager_tests.cpp
+* @brief Tests for the recording output manager.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include "llvmir2hll/hll/output_managers/output_manager_tests.h"
+#include "retdec/llvmir2hll/hll/output_managers/plain_manager.h"
+#include "retdec/llvmir2hll/hll/output_managers/recording_manager.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+class RecordingOutputManagerTests: public OutputManagerTests
+{
+	protected:
+		virtual void SetUp() override;
+
+		void emitSampleCode(OutputManager& out);
+
+	protected:
+		UPtr<OutputManager> target;
+};
+
+void RecordingOutputManagerTests::SetUp()
+{
+	OutputManagerTests::SetUp();
+	target = UPtr<OutputManager>(new PlainOutputManager(codeStream));
+	target->setCommentPrefix("//");
+	manager = UPtr<OutputManager>(new RecordingOutputManager(*target));
+}
+
+void RecordingOutputManagerTests::emitSampleCode(OutputManager& out)
+{
+	out.addressPush(0x1000);
+	out.dataType("int32_t");
+	out.space();
+	out.functionId("main");
+	out.punctuation('(');
+	out.punctuation(')');
+	out.space();
+	out.punctuation('{');
+	out.newLine();
+	out.space("    ");
+	out.keyword("return");
+	out.space();
+	out.constantInt("0");
+	out.punctuation(';');
+	out.comment("0x1000", " ");
+	out.newLine();
+	out.punctuation('}');
+	out.newLine();
+	out.addressPop();
+}
+
+TEST_F(RecordingOutputManagerTests, tokens_are_passed_to_target)
+{
+	emitSampleCode(*manager);
+	EXPECT_EQ(
+		"int32_t main() {\n"
+		"    return 0; // 0x1000\n"
+		"}\n",
+		emitCode()
+	);
+}
+
+TEST_F(RecordingOutputManagerTests, tokens_are_recorded)
+{
+	manager->functionId("main");
+	manager->addressPush(0x1000);
+	manager->addressPop();
+
+	auto& tokens = static_cast<RecordingOutputManager&>(*manager).getTokens();
+	ASSERT_EQ(3, tokens.size());
+	EXPECT_EQ(OutputToken::Kind::FunctionId, tokens[0].kind);
+	EXPECT_EQ("main", tokens[0].value);
+	EXPECT_EQ(OutputToken::Kind::AddressPush, tokens[1].kind);
+	EXPECT_EQ("4096", tokens[1].value);
+	EXPECT_EQ(OutputToken::Kind::AddressPop, tokens[2].kind);
+}
+
+TEST_F(RecordingOutputManagerTests, replay_produces_same_output)
+{
+	emitSampleCode(*manager);
+	std::string original = emitCode();
+	code.clear();
+
+	RecordingOutputManager::replay(
+		static_cast<RecordingOutputManager&>(*manager).getTokens(),
+		*target
+	);
+
+	EXPECT_EQ(original, emitCode());
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
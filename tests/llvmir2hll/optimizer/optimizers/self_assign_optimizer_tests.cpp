@@ -204,6 +204,28 @@ FuncWithJustSelfAssignIsOptimizedToEmptyBody) {
 		testFunc->getBody()->getSuccessor();
 }
 
+TEST_F(SelfAssignOptimizerTests,
+FuncExcludedFromOptimizationsIsNotOptimized) {
+	// Add a body to the testing function:
+	//
+	//   a = a
+	//   return
+	//
+	ShPtr<Variable> var(Variable::create("a", IntType::create(16)));
+	ShPtr<AssignStmt> assignStmt(
+		AssignStmt::create(var, var,
+		ReturnStmt::create())); // successor
+	testFunc->setBody(assignStmt);
+	module->excludeFuncFromOptimizations(testFunc);
+
+	// Optimize the module.
+	Optimizer::optimize<SelfAssignOptimizer>(module);
+
+	// Check that the body has not been changed.
+	EXPECT_EQ(assignStmt, testFunc->getBody());
+	EXPECT_TRUE(isa<ReturnStmt>(assignStmt->getSuccessor()));
+}
+
 } // namespace tests
 } // namespace llvmir2hll
 } // namespace retdec
@@ -0,0 +1,314 @@
+/**
+* @file tests/llvmir2hll/support/func_output_cache_tests.cpp
+* @brief Tests for the @c func_output_cache module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <chrono>
+#include <memory>
+
+#include <gtest/gtest.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include "retdec/llvmir2hll/support/func_output_cache.h"
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/string.h"
+
+using namespace ::testing;
+
+using retdec::utils::startsWith;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+/**
+* @brief Tests for the @c func_output_cache module.
+*/
+class FuncOutputCacheTests: public Test {
+protected:
+	virtual void SetUp() override {
+		dir = fs::temp_directory_path() / ("retdec-func-output-cache-tests-"
+			+ std::to_string(
+				std::chrono::steady_clock::now().time_since_epoch().count()));
+	}
+
+	virtual void TearDown() override {
+		std::error_code ec;
+		fs::remove_all(dir, ec);
+	}
+
+	FuncOutputCache::Entry createEntry(const std::string &value) {
+		FuncOutputCache::Entry entry;
+		entry.startAddress = 0x1000;
+		entry.endAddress = 0x1010;
+		entry.tokens.push_back({OutputToken::Kind::FunctionId, "", 0});
+		entry.tokens.push_back({OutputToken::Kind::Comment, value});
+		entry.tokens.push_back({OutputToken::Kind::NewLine, ""});
+		return entry;
+	}
+
+	std::unique_ptr<llvm::Module> parse(const std::string &code) {
+		llvm::SMDiagnostic err;
+		return llvm::parseAssemblyString(code, err, context);
+	}
+
+	std::string computeKey(llvm::Module &module, const std::string &funcName,
+			std::uint64_t start, StringVector &symbolNames) {
+		return FuncOutputCache::computeKey(*module.getFunction(funcName),
+			start, start + 0x10, "context",
+			[](const std::string &name) {
+				return startsWith(name, "function_")
+					|| startsWith(name, "global_var_");
+			},
+			symbolNames);
+	}
+
+protected:
+	fs::path dir;
+	llvm::LLVMContext context;
+};
+
+TEST_F(FuncOutputCacheTests,
+SavedEntryCanBeLoaded) {
+	FuncOutputCache cache(dir.string(), 0, "context");
+	FuncOutputCache::Entry entry(createEntry("a\nmultiline comment"));
+
+	ASSERT_TRUE(cache.save("0123456789", entry));
+
+	FuncOutputCache::Entry loaded;
+	ASSERT_TRUE(cache.load("0123456789", loaded));
+	EXPECT_EQ(entry.startAddress, loaded.startAddress);
+	EXPECT_EQ(entry.endAddress, loaded.endAddress);
+	ASSERT_EQ(entry.tokens.size(), loaded.tokens.size());
+	for (std::size_t i = 0; i < entry.tokens.size(); ++i) {
+		EXPECT_EQ(entry.tokens[i].kind, loaded.tokens[i].kind);
+		EXPECT_EQ(entry.tokens[i].value, loaded.tokens[i].value);
+		EXPECT_EQ(entry.tokens[i].symbol, loaded.tokens[i].symbol);
+	}
+	EXPECT_GT(cache.getStatistics().bytesRead, 0u);
+	EXPECT_GT(cache.getStatistics().bytesWritten, 0u);
+}
+
+TEST_F(FuncOutputCacheTests,
+LoadOfNonexistentEntryFails) {
+	FuncOutputCache cache(dir.string(), 0, "context");
+	FuncOutputCache::Entry entry;
+
+	EXPECT_FALSE(cache.load("0123456789", entry));
+}
+
+TEST_F(FuncOutputCacheTests,
+EvictRemovesLeastRecentlyUsedEntriesUntilSizeIsUnderLimit) {
+	FuncOutputCache writer(dir.string(), 0, "context");
+	ASSERT_TRUE(writer.save("aa1", createEntry("1")));
+	ASSERT_TRUE(writer.save("aa2", createEntry("2")));
+	ASSERT_TRUE(writer.save("aa3", createEntry("3")));
+	auto entrySize = fs::file_size(dir / "aa" / "aa1");
+
+	// Make aa2 the least recently used entry and aa1 the most recently used
+	// one.
+	auto now = fs::file_time_type::clock::now();
+	fs::last_write_time(dir / "aa" / "aa2", now - std::chrono::hours(2));
+	fs::last_write_time(dir / "aa" / "aa3", now - std::chrono::hours(1));
+	fs::last_write_time(dir / "aa" / "aa1", now);
+
+	FuncOutputCache cache(dir.string(), 2 * entrySize, "context");
+	cache.evict();
+
+	EXPECT_EQ(1, cache.getStatistics().evictions);
+	EXPECT_EQ(2 * entrySize, cache.getStatistics().size);
+	EXPECT_TRUE(fs::exists(dir / "aa" / "aa1"));
+	EXPECT_FALSE(fs::exists(dir / "aa" / "aa2"));
+	EXPECT_TRUE(fs::exists(dir / "aa" / "aa3"));
+}
+
+TEST_F(FuncOutputCacheTests,
+EvictDoesNothingWhenSizeIsNotLimited) {
+	FuncOutputCache cache(dir.string(), 0, "context");
+	ASSERT_TRUE(cache.save("aa1", createEntry("1")));
+	ASSERT_TRUE(cache.save("aa2", createEntry("2")));
+
+	cache.evict();
+
+	EXPECT_EQ(0, cache.getStatistics().evictions);
+	EXPECT_TRUE(fs::exists(dir / "aa" / "aa1"));
+	EXPECT_TRUE(fs::exists(dir / "aa" / "aa2"));
+}
+
+TEST_F(FuncOutputCacheTests,
+KeyDoesNotDependOnNamesOfSymbolsAndOnAddressOfFunction) {
+	auto module = parse(R"(
+		@global_var_2000 = global i32 0
+		@global_var_3000 = global i32 0
+
+		define i32 @function_1000() {
+		dec_label_pc_1000:
+		  %v = load i32, i32* @global_var_2000
+		  br label %dec_label_pc_1008
+		dec_label_pc_1008:
+		  ret i32 %v
+		}
+
+		define i32 @function_5000() {
+		dec_label_pc_5000:
+		  %v = load i32, i32* @global_var_3000
+		  br label %dec_label_pc_5008
+		dec_label_pc_5008:
+		  ret i32 %v
+		}
+	)");
+	ASSERT_TRUE(module);
+
+	StringVector symbolNames1;
+	StringVector symbolNames2;
+	auto key1 = computeKey(*module, "function_1000", 0x1000, symbolNames1);
+	auto key2 = computeKey(*module, "function_5000", 0x5000, symbolNames2);
+
+	EXPECT_EQ(key1, key2);
+	EXPECT_EQ(StringVector({"function_1000", "global_var_2000"}), symbolNames1);
+	EXPECT_EQ(StringVector({"function_5000", "global_var_3000"}), symbolNames2);
+}
+
+TEST_F(FuncOutputCacheTests,
+KeyDependsOnCodeOfFunction) {
+	auto module = parse(R"(
+		define i32 @function_1000() {
+		  ret i32 1
+		}
+
+		define i32 @function_5000() {
+		  ret i32 2
+		}
+	)");
+	ASSERT_TRUE(module);
+
+	StringVector symbolNames1;
+	StringVector symbolNames2;
+	EXPECT_NE(
+		computeKey(*module, "function_1000", 0x1000, symbolNames1),
+		computeKey(*module, "function_5000", 0x5000, symbolNames2)
+	);
+}
+
+TEST_F(FuncOutputCacheTests,
+KeyDependsOnContentsOfReferencedConstants) {
+	auto module = parse(R"(
+		@global_var_2000 = constant [2 x i8] c"a\00"
+		@global_var_3000 = constant [2 x i8] c"b\00"
+
+		define i8* @function_1000() {
+		  ret i8* getelementptr ([2 x i8], [2 x i8]* @global_var_2000, i32 0, i32 0)
+		}
+
+		define i8* @function_5000() {
+		  ret i8* getelementptr ([2 x i8], [2 x i8]* @global_var_3000, i32 0, i32 0)
+		}
+	)");
+	ASSERT_TRUE(module);
+
+	StringVector symbolNames1;
+	StringVector symbolNames2;
+	EXPECT_NE(
+		computeKey(*module, "function_1000", 0x1000, symbolNames1),
+		computeKey(*module, "function_5000", 0x5000, symbolNames2)
+	);
+}
+
+TEST_F(FuncOutputCacheTests,
+CalleeKeyDependsOnCodeOfCalledFunctions) {
+	auto module1 = parse(R"(
+		define i32 @function_1000() {
+		  %v = call i32 @function_2000()
+		  ret i32 %v
+		}
+
+		define i32 @function_2000() {
+		  ret i32 1
+		}
+
+		define i32 @function_3000() {
+		  ret i32 3
+		}
+	)");
+	ASSERT_TRUE(module1);
+	llvm::LLVMContext context2;
+	llvm::SMDiagnostic err;
+	auto module2 = llvm::parseAssemblyString(R"(
+		define i32 @function_1000() {
+		  %v = call i32 @function_2000()
+		  ret i32 %v
+		}
+
+		define i32 @function_2000() {
+		  ret i32 2
+		}
+
+		define i32 @function_3000() {
+		  ret i32 3
+		}
+	)", err, context2);
+	ASSERT_TRUE(module2);
+
+	auto computeCalleeKeys = [this](llvm::Module &module) {
+		std::map<const llvm::Function *, std::string> ownKeys;
+		for (const auto &func : module) {
+			StringVector symbolNames;
+			ownKeys[&func] = computeKey(module, func.getName().str(),
+				0x1000, symbolNames);
+		}
+		return FuncOutputCache::computeCalleeKeys(ownKeys);
+	};
+	auto keys1 = computeCalleeKeys(*module1);
+	auto keys2 = computeCalleeKeys(*module2);
+
+	// Only keys of the changed function and of its callers differ.
+	EXPECT_NE(keys1.at(module1->getFunction("function_1000")),
+		keys2.at(module2->getFunction("function_1000")));
+	EXPECT_NE(keys1.at(module1->getFunction("function_2000")),
+		keys2.at(module2->getFunction("function_2000")));
+	EXPECT_EQ(keys1.at(module1->getFunction("function_3000")),
+		keys2.at(module2->getFunction("function_3000")));
+}
+
+TEST_F(FuncOutputCacheTests,
+RecursiveFunctionsGetSameCalleeKey) {
+	auto module = parse(R"(
+		define void @function_1000() {
+		  call void @function_2000()
+		  ret void
+		}
+
+		define void @function_2000() {
+		  call void @function_1000()
+		  call void @function_3000()
+		  ret void
+		}
+
+		define void @function_3000() {
+		  ret void
+		}
+	)");
+	ASSERT_TRUE(module);
+
+	std::map<const llvm::Function *, std::string> ownKeys;
+	for (const auto &func : *module) {
+		StringVector symbolNames;
+		ownKeys[&func] = computeKey(*module, func.getName().str(),
+			0x1000, symbolNames);
+	}
+	auto keys = FuncOutputCache::computeCalleeKeys(ownKeys);
+
+	ASSERT_EQ(3, keys.size());
+	EXPECT_EQ(keys.at(module->getFunction("function_1000")),
+		keys.at(module->getFunction("function_2000")));
+	EXPECT_NE(keys.at(module->getFunction("function_1000")),
+		keys.at(module->getFunction("function_3000")));
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
@@ -0,0 +1,192 @@
+/**
+* @file tests/llvmir2hll/support/var_bit_set_tests.cpp
+* @brief Tests for the @c var_bit_set module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/llvmir2hll/ir/int_type.h"
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/llvmir2hll/support/types.h"
+#include "retdec/llvmir2hll/support/var_bit_set.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+/**
+* @brief Tests for the @c var_bit_set module.
+*/
+class VarBitSetTests: public Test {
+protected:
+	VarBitSetTests():
+		varA(Variable::create("a", IntType::create(32))),
+		varB(Variable::create("b", IntType::create(32))),
+		varC(Variable::create("c", IntType::create(32))) {}
+
+protected:
+	ShPtr<Variable> varA;
+	ShPtr<Variable> varB;
+	ShPtr<Variable> varC;
+	VarNumbering numbering;
+};
+
+TEST_F(VarBitSetTests,
+VariablesAreNumberedDenselyInTheOrderOfNumbering) {
+	EXPECT_EQ(0, numbering.getId(varB));
+	EXPECT_EQ(1, numbering.getId(varA));
+	EXPECT_EQ(0, numbering.getId(varB));
+	EXPECT_EQ(2, numbering.size());
+	EXPECT_EQ(varB, numbering.getVar(0));
+	EXPECT_EQ(varA, numbering.getVar(1));
+}
+
+TEST_F(VarBitSetTests,
+FindIdDoesNotNumberVariable) {
+	EXPECT_EQ(VarNumbering::NO_ID, numbering.findId(varA));
+	EXPECT_FALSE(numbering.hasId(varA));
+	EXPECT_EQ(0, numbering.size());
+
+	numbering.getId(varA);
+	EXPECT_EQ(0, numbering.findId(varA));
+	EXPECT_TRUE(numbering.hasId(varA));
+}
+
+TEST_F(VarBitSetTests,
+NewSetIsEmpty) {
+	VarBitSet set;
+
+	EXPECT_TRUE(set.empty());
+	EXPECT_EQ(0, set.size());
+	EXPECT_FALSE(set.contains(0));
+	EXPECT_FALSE(set.contains(varA, numbering));
+}
+
+TEST_F(VarBitSetTests,
+InsertAndEraseReturnWhetherSetHasBeenChanged) {
+	VarBitSet set;
+
+	EXPECT_TRUE(set.insert(varA, numbering));
+	EXPECT_FALSE(set.insert(varA, numbering));
+	EXPECT_TRUE(set.insert(100));
+	EXPECT_TRUE(set.contains(varA, numbering));
+	EXPECT_TRUE(set.contains(100));
+	EXPECT_FALSE(set.contains(varB, numbering));
+	EXPECT_EQ(2, set.size());
+
+	EXPECT_TRUE(set.erase(100));
+	EXPECT_FALSE(set.erase(100));
+	EXPECT_FALSE(set.erase(1000));
+	EXPECT_EQ(1, set.size());
+}
+
+TEST_F(VarBitSetTests,
+SetsWithSameIdsAreEqualRegardlessOfTheirCapacity) {
+	VarBitSet set1;
+	set1.insert(1);
+	VarBitSet set2;
+	set2.insert(1);
+	set2.insert(500);
+	set2.erase(500);
+
+	EXPECT_EQ(set1, set2);
+	set2.insert(2);
+	EXPECT_NE(set1, set2);
+}
+
+TEST_F(VarBitSetTests,
+UnionWithAddsIdsAndReturnsWhetherSetHasBeenChanged) {
+	VarBitSet set1;
+	set1.insert(1);
+	VarBitSet set2;
+	set2.insert(1);
+	set2.insert(200);
+
+	EXPECT_TRUE(set1.unionWith(set2));
+	EXPECT_EQ(set2, set1);
+	EXPECT_FALSE(set1.unionWith(set2));
+}
+
+TEST_F(VarBitSetTests,
+IntersectWithKeepsOnlyCommonIds) {
+	VarBitSet set1;
+	set1.insert(1);
+	set1.insert(2);
+	set1.insert(300);
+	VarBitSet set2;
+	set2.insert(2);
+	set2.insert(3);
+
+	EXPECT_TRUE(set1.intersectWith(set2));
+	EXPECT_EQ(1, set1.size());
+	EXPECT_TRUE(set1.contains(2));
+	EXPECT_FALSE(set1.intersectWith(set2));
+}
+
+TEST_F(VarBitSetTests,
+SubtractRemovesIdsOfOtherSet) {
+	VarBitSet set1;
+	set1.insert(1);
+	set1.insert(2);
+	VarBitSet set2;
+	set2.insert(2);
+	set2.insert(400);
+
+	EXPECT_TRUE(set1.subtract(set2));
+	EXPECT_EQ(1, set1.size());
+	EXPECT_TRUE(set1.contains(1));
+	EXPECT_FALSE(set1.subtract(set2));
+}
+
+TEST_F(VarBitSetTests,
+IntersectsAndIsSubsetOfWorkCorrectly) {
+	VarBitSet set1;
+	set1.insert(1);
+	VarBitSet set2;
+	set2.insert(1);
+	set2.insert(64);
+	VarBitSet set3;
+	set3.insert(64);
+
+	EXPECT_TRUE(set1.intersects(set2));
+	EXPECT_FALSE(set1.intersects(set3));
+	EXPECT_TRUE(set1.isSubsetOf(set2));
+	EXPECT_TRUE(set3.isSubsetOf(set2));
+	EXPECT_FALSE(set2.isSubsetOf(set1));
+	EXPECT_TRUE(VarBitSet().isSubsetOf(set1));
+}
+
+TEST_F(VarBitSetTests,
+IdsAreIteratedInAscendingOrder) {
+	VarBitSet set;
+	set.insert(70);
+	set.insert(3);
+	set.insert(64);
+
+	std::vector<VarBitSet::Id> ids;
+	for (auto i = set.id_begin(), e = set.id_end(); i != e; ++i) {
+		ids.push_back(*i);
+	}
+	EXPECT_EQ(std::vector<VarBitSet::Id>({3, 64, 70}), ids);
+}
+
+TEST_F(VarBitSetTests,
+ConversionFromAndToVarSetPreservesVariables) {
+	VarSet vars{varA, varC};
+
+	VarBitSet set(VarBitSet::fromVarSet(vars, numbering));
+	EXPECT_EQ(2, set.size());
+	EXPECT_TRUE(set.contains(varA, numbering));
+	EXPECT_FALSE(set.contains(varB, numbering));
+	EXPECT_TRUE(set.contains(varC, numbering));
+	EXPECT_EQ(vars, set.toVarSet(numbering));
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
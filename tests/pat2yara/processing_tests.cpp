@@ -0,0 +1,283 @@
+/**
+ * @file tests/pat2yara/processing_tests.cpp
+ * @brief Tests for the @c processing module.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "pat2yara/processing.h"
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/parallel.h"
+#include "yaramod/builder/yara_file_builder.h"
+#include "yaramod/yaramod.h"
+
+using namespace ::testing;
+using namespace yaramod;
+
+namespace retdec {
+namespace pat2yara {
+namespace tests {
+
+namespace {
+
+/**
+ * Patterns in the format of bin2pat output.
+ *
+ * - alpha_copy has the same pattern and references as alpha.
+ * - gamma has the same pattern as alpha except for a wild-card, but other
+ *   references.
+ * - delta has not enough pure information.
+ * - T.1 has a problematic name.
+ */
+const char PATTERNS[] = R"(rule r_alpha
+{
+	meta:
+		name = "alpha"
+		size = 8
+		bitWidth = 32
+		endianness = "little"
+		source = "test.a"
+		architecture = "x86"
+		refs = "0004 beta"
+	strings:
+		$1 = { 55 89 E5 83 EC 08 C9 C3 }
+	condition:
+		$1
+}
+
+rule r_delta
+{
+	meta:
+		name = "delta"
+		size = 3
+		bitWidth = 32
+		endianness = "little"
+		source = "test.a"
+		architecture = "x86"
+	strings:
+		$1 = { 31 C0 C3 }
+	condition:
+		$1
+}
+
+rule r_alpha_copy
+{
+	meta:
+		name = "alpha_copy"
+		size = 8
+		bitWidth = 32
+		endianness = "little"
+		source = "test.a"
+		architecture = "x86"
+		refs = "0004 beta"
+	strings:
+		$1 = { 55 89 E5 83 EC 08 C9 C3 }
+	condition:
+		$1
+}
+
+rule r_epsilon
+{
+	meta:
+		name = "epsilon"
+		size = 6
+		bitWidth = 32
+		endianness = "little"
+		source = "test.a"
+		architecture = "x86"
+	strings:
+		$1 = { 8B 44 24 04 40 C3 }
+	condition:
+		$1
+}
+
+rule r_gamma
+{
+	meta:
+		name = "gamma"
+		size = 8
+		bitWidth = 32
+		endianness = "little"
+		source = "test.a"
+		architecture = "x86"
+		refs = "0004 delta"
+	strings:
+		$1 = { 55 ?? E5 83 EC 08 C9 C3 }
+	condition:
+		$1
+}
+
+rule r_t1
+{
+	meta:
+		name = "T.1"
+		size = 6
+		bitWidth = 32
+		endianness = "little"
+		source = "test.a"
+		architecture = "x86"
+	strings:
+		$1 = { 8B 44 24 08 48 C3 }
+	condition:
+		$1
+}
+)";
+
+/**
+ * Expected output of pat2yara for PATTERNS.
+ */
+const char EXPECTED_RULES[] = R"(private rule architecture
+{
+	meta:
+		bits = 32
+		endianness = "little"
+		architecture = "x86"
+	condition:
+		true
+}
+
+rule r_alpha_0
+{
+	meta:
+		name = "alpha"
+		size = 8
+		refs = "0004 beta"
+		altNames = "alpha_copy"
+	strings:
+		$1 = { 55 89 E5 83 EC 08 C9 C3 }
+	condition:
+		$1
+}
+
+rule r_gamma_0
+{
+	meta:
+		name = "gamma"
+		size = 8
+		refs = "0004 delta"
+	strings:
+		$1 = { 55 ?? E5 83 EC 08 C9 C3 }
+	condition:
+		$1
+}
+
+rule r_epsilon_0
+{
+	meta:
+		name = "epsilon"
+		size = 6
+	strings:
+		$1 = { 8B 44 24 04 40 C3 }
+	condition:
+		$1
+}
+)";
+
+/**
+ * Expected log-file of pat2yara for PATTERNS.
+ */
+const char EXPECTED_LOG[] = R"(rule r_delta
+{
+	meta:
+		name = "delta"
+		source = "test.a"
+		reason = "not enough pure information"
+	strings:
+		$1 = { 31 C0 C3 }
+	condition:
+		false
+}
+
+rule r_t1
+{
+	meta:
+		name = "T.1"
+		source = "test.a"
+		reason = "problematic function name"
+	strings:
+		$1 = { 8B 44 24 08 48 C3 }
+	condition:
+		false
+}
+)";
+
+} // anonymous namespace
+
+class ProcessingTests : public Test
+{
+	protected:
+		fs::path dir;
+		ProcessingOptions options;
+
+		void SetUp() override
+		{
+			dir = fs::temp_directory_path() / ("retdec-pat2yara-tests-"
+				+ std::to_string(
+					std::chrono::steady_clock::now().time_since_epoch().count()));
+			fs::create_directories(dir);
+
+			auto input = (dir / "test.pat").string();
+			std::ofstream(input) << PATTERNS;
+			options.input.push_back(input);
+			options.logOn = true;
+
+			std::string error;
+			ASSERT_TRUE(options.validate(error)) << error;
+		}
+
+		void TearDown() override
+		{
+			utils::setMaxThreadCount(0);
+
+			std::error_code ec;
+			fs::remove_all(dir, ec);
+		}
+
+		/// Parse rules and print them again, so that the comparison of rules
+		/// does not depend on formatting details of the printer.
+		static std::string normalize(const std::string &rules)
+		{
+			Yaramod ym;
+			std::istringstream input(rules);
+			const auto &file = ym.parseStream(input);
+			return file ? file->getText() : "invalid rules";
+		}
+};
+
+TEST_F(ProcessingTests, PatternsAreConvertedToExpectedRules)
+{
+	YaraFileBuilder fileBuilder;
+	YaraFileBuilder logBuilder;
+
+	processFiles(fileBuilder, logBuilder, options);
+
+	EXPECT_EQ(normalize(EXPECTED_RULES),
+		normalize(fileBuilder.get(false)->getText()));
+	EXPECT_EQ(normalize(EXPECTED_LOG),
+		normalize(logBuilder.get(false)->getText()));
+}
+
+TEST_F(ProcessingTests, OutputDoesNotDependOnNumberOfThreads)
+{
+	for (std::size_t threads : {1, 2, 8})
+	{
+		utils::setMaxThreadCount(threads);
+		YaraFileBuilder fileBuilder;
+		YaraFileBuilder logBuilder;
+
+		processFiles(fileBuilder, logBuilder, options);
+
+		EXPECT_EQ(normalize(EXPECTED_RULES),
+			normalize(fileBuilder.get(false)->getText()))
+			<< threads << " threads";
+	}
+}
+
+} // namespace tests
+} // namespace pat2yara
+} // namespace retdec
@@ -0,0 +1,184 @@
+/**
+ * @file tests/retdec-decompiler/archive_decompilation_tests.cpp
+ * @brief Tests for the @c archive_decompilation module.
+ * @copyright (c) 2020 Avast Software, licensed under the MIT license
+ */
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec-decompiler/archive_decompilation.h"
+
+using namespace ::testing;
+using namespace retdec::ar_extractor;
+
+namespace retdec {
+namespace decompiler {
+namespace tests {
+
+// The fake decompiler is a shell script.
+#ifndef _WIN32
+
+class ArchiveDecompilationTests : public Test
+{
+	protected:
+		fs::path dir;
+
+		void SetUp() override
+		{
+			dir = fs::temp_directory_path() / ("retdec-archive-decompilation-tests-"
+				+ std::to_string(
+					std::chrono::steady_clock::now().time_since_epoch().count()));
+			fs::create_directories(dir);
+
+			// Decompilation of an object succeeds unless the object contains
+			// "fail". Arguments are logged.
+			std::ofstream(decompiler()) << "#!/bin/sh\n"
+					<< "echo \"decompiling $@\"\n"
+					<< "if grep -q fail \"$1\"; then exit 1; fi\n"
+					<< "echo \"int main() {}\" > \"$1.c\"\n";
+			fs::permissions(decompiler(), fs::perms::owner_all);
+
+			writeArchive({{"good.o", "good object\n"}, {"bad.o", "fail\n"}});
+		}
+
+		void TearDown() override
+		{
+			std::error_code ec;
+			fs::remove_all(dir, ec);
+		}
+
+		std::string decompiler() const
+		{
+			return (dir / "fake-decompiler.sh").string();
+		}
+
+		std::string archive() const
+		{
+			return (dir / "lib.a").string();
+		}
+
+		/// Write archive in the common (GNU) format with the given objects.
+		void writeArchive(const std::vector<std::pair<std::string, std::string>>& objects)
+		{
+			std::ofstream out(archive(), std::ios::binary);
+			out << "!<arch>\n";
+			for (auto& o : objects)
+			{
+				auto field = [&](const std::string& value, std::size_t size)
+				{
+					out << value << std::string(size - value.size(), ' ');
+				};
+				field(o.first + "/", 16);
+				field("0", 12);
+				field("0", 6);
+				field("0", 6);
+				field("644", 8);
+				field(std::to_string(o.second.size()), 10);
+				out << "`\n" << o.second;
+				if (o.second.size() % 2)
+				{
+					out << "\n";
+				}
+			}
+		}
+
+		static std::string readFile(const std::string& path)
+		{
+			std::ifstream in(path);
+			std::stringstream ss;
+			ss << in.rdbuf();
+			return ss.str();
+		}
+};
+
+TEST_F(ArchiveDecompilationTests, successfulAndFailedObjectsAreReportedInSummary)
+{
+	bool ok = false;
+	std::string errMsg;
+	ArchiveWrapper arw(archive(), ok, errMsg);
+	ASSERT_TRUE(ok) << errMsg;
+	std::vector<ArchiveObject> objects;
+	ASSERT_TRUE(arw.getObjects(objects, errMsg)) << errMsg;
+	ASSERT_EQ(2, objects.size());
+
+	auto results = decompileArchiveMembers(
+			decompiler(), archive(), objects, {"--silent"}, "plain", 2);
+
+	ASSERT_EQ(2, results.size());
+	EXPECT_EQ("good.o", results[0].name);
+	EXPECT_EQ("ok", results[0].status);
+	EXPECT_EQ(0, results[0].exitCode);
+	EXPECT_EQ(archive() + ".file_1.c", results[0].outputFile);
+	EXPECT_TRUE(fs::exists(results[0].outputFile));
+	EXPECT_EQ("bad.o", results[1].name);
+	EXPECT_EQ("fail", results[1].status);
+	EXPECT_EQ(1, results[1].exitCode);
+	EXPECT_FALSE(fs::exists(results[1].outputFile));
+
+	// Outputs of the processes are logged, temporary objects are removed.
+	for (auto& r : results)
+	{
+		EXPECT_EQ("decompiling " + r.inputFile + " --silent\n", readFile(r.logFile));
+		EXPECT_FALSE(fs::exists(r.inputFile)) << r.inputFile;
+	}
+
+	auto summaryPath = archive() + ".summary.json";
+	writeArchiveSummary(summaryPath, archive(), results);
+
+	rapidjson::Document summary;
+	summary.Parse(readFile(summaryPath).c_str());
+	ASSERT_FALSE(summary.HasParseError());
+	EXPECT_EQ(archive(), summary["archive"].GetString());
+	EXPECT_EQ(2, summary["summary"]["total"].GetUint64());
+	EXPECT_EQ(1, summary["summary"]["ok"].GetUint());
+	EXPECT_EQ(1, summary["summary"]["fail"].GetUint());
+	auto& jsonObjects = summary["objects"];
+	ASSERT_EQ(2, jsonObjects.Size());
+	EXPECT_EQ(0, jsonObjects[0]["index"].GetUint64());
+	EXPECT_EQ("good.o", std::string(jsonObjects[0]["name"].GetString()));
+	EXPECT_EQ("ok", std::string(jsonObjects[0]["status"].GetString()));
+	EXPECT_EQ(results[0].outputFile, jsonObjects[0]["output"].GetString());
+	EXPECT_EQ(1, jsonObjects[1]["index"].GetUint64());
+	EXPECT_EQ("bad.o", std::string(jsonObjects[1]["name"].GetString()));
+	EXPECT_EQ("fail", std::string(jsonObjects[1]["status"].GetString()));
+	EXPECT_EQ(1, jsonObjects[1]["exitCode"].GetInt());
+	EXPECT_EQ(results[1].logFile, jsonObjects[1]["log"].GetString());
+
+	// Nothing but the outputs, logs and summary is left next to the archive.
+	std::size_t files = 0;
+	for (auto& e : fs::directory_iterator(dir))
+	{
+		(void) e;
+		++files;
+	}
+	// decompiler, archive, summary, 2 logs, 1 output
+	EXPECT_EQ(6, files);
+}
+
+TEST_F(ArchiveDecompilationTests, objectIsRemovedWhenDecompilerCannotBeRun)
+{
+	ArchiveObject object{"good.o", "good object\n"};
+
+	auto res = decompileArchiveMember(
+			(dir / "missing-decompiler").string(), archive(), 0, object, {}, "json");
+
+	EXPECT_EQ("error", res.status);
+	EXPECT_EQ(-1, res.exitCode);
+	EXPECT_FALSE(res.errorMessage.empty());
+	EXPECT_EQ(archive() + ".file_1.c.json", res.outputFile);
+	EXPECT_FALSE(fs::exists(res.inputFile));
+}
+
+#endif
+
+} // namespace tests
+} // namespace decompiler
+} // namespace retdec
@@ -0,0 +1,554 @@
+/**
+ * @file tests/retdec/retdec_tests.cpp
+ * @brief Tests for the @c retdec library.
+ * @copyright (c) 2019 Avast Software, licensed under the MIT license
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/config/config.h"
+#include "retdec/config/parameters.h"
+#include "retdec/retdec/retdec.h"
+#include "retdec/utils/filesystem.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace tests {
+
+namespace {
+
+std::string toString(const std::vector<LlvmPassStep>& steps)
+{
+	std::string ret;
+	for (auto& step : steps)
+	{
+		std::string passes;
+		for (auto& p : step.passes)
+		{
+			passes += (passes.empty() ? "" : " ") + p;
+		}
+		ret += step.functionGroup ? "[" + passes + "]\n" : passes + "\n";
+	}
+	return ret;
+}
+
+
+/**
+ * Small 32-bit x86 PE file with a TLS callback, which calls imported
+ * @c printf() and @c ExitProcess().
+ */
+const std::vector<std::uint8_t> peBytes =
+{
+	0x4d, 0x5a, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x00, 0x00, 0x00, 0x50, 0x45, 0x00, 0x00, 0x4c, 0x01, 0x01, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xe0, 0x00, 0x02, 0x01, 0x0b, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x20, 0x00, 0x00, 0x60, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xa0, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x60, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00,
+	0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc7, 0x05, 0x38, 0x10,
+	0x40, 0x00, 0x5d, 0x10, 0x40, 0x00, 0x68, 0x6f, 0x10, 0x40, 0x00, 0xe8,
+	0x1c, 0x00, 0x00, 0x00, 0x83, 0xc4, 0x04, 0x6a, 0x00, 0xff, 0x15, 0x20,
+	0x11, 0x40, 0x00, 0xcc, 0xff, 0x35, 0x38, 0x10, 0x40, 0x00, 0xe8, 0x05,
+	0x00, 0x00, 0x00, 0x83, 0xc4, 0x04, 0xc3, 0xcc, 0xff, 0x25, 0x28, 0x11,
+	0x40, 0x00, 0xcc, 0xcc, 0x3c, 0x10, 0x40, 0x00, 0x20, 0x2a, 0x20, 0x73,
+	0x69, 0x6d, 0x70, 0x6c, 0x65, 0x20, 0x54, 0x4c, 0x53, 0x3a, 0x0a, 0x20,
+	0x20, 0x23, 0x20, 0x31, 0x73, 0x74, 0x20, 0x54, 0x4c, 0x53, 0x20, 0x63,
+	0x61, 0x6c, 0x6c, 0x0a, 0x00, 0x20, 0x20, 0x23, 0x20, 0x32, 0x6e, 0x64,
+	0x20, 0x54, 0x4c, 0x53, 0x20, 0x63, 0x61, 0x6c, 0x6c, 0x0a, 0x00, 0x20,
+	0x20, 0x23, 0x20, 0x45, 0x6e, 0x74, 0x72, 0x79, 0x50, 0x6f, 0x69, 0x6e,
+	0x74, 0x20, 0x65, 0x78, 0x65, 0x63, 0x75, 0x74, 0x65, 0x64, 0x0a, 0x20,
+	0x20, 0x23, 0x20, 0x45, 0x78, 0x69, 0x74, 0x50, 0x72, 0x6f, 0x63, 0x65,
+	0x73, 0x73, 0x20, 0x63, 0x61, 0x6c, 0x6c, 0x65, 0x64, 0x0a, 0x00, 0x00,
+	0xe0, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x11, 0x00, 0x00, 0x20, 0x11, 0x00, 0x00, 0xe8, 0x10, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4d, 0x11, 0x00, 0x00,
+	0x28, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x0e, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x45, 0x78, 0x69, 0x74, 0x50, 0x72, 0x6f, 0x63, 0x65, 0x73,
+	0x73, 0x00, 0x00, 0x00, 0x70, 0x72, 0x69, 0x6e, 0x74, 0x66, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x0e, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x6b, 0x65, 0x72, 0x6e, 0x65, 0x6c, 0x33, 0x32,
+	0x2e, 0x64, 0x6c, 0x6c, 0x00, 0x6d, 0x73, 0x76, 0x63, 0x72, 0x74, 0x2e,
+	0x64, 0x6c, 0x6c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x11, 0x40, 0x00,
+	0x84, 0x11, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x45, 0x23, 0x01, 0x00,
+	0x20, 0x10, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00
+};
+
+/**
+ * Describe function without its basic blocks.
+ */
+std::string describeFunction(const common::Function& f)
+{
+	std::string ret = "function " + f.getStart().toHexString()
+			+ "-" + f.getEnd().toHexString() + " " + f.getName() + " refs:";
+	for (auto& r : f.codeReferences)
+	{
+		ret += " " + r.toHexString();
+	}
+	return ret + "\n";
+}
+
+/**
+ * Describe basic block including its instructions.
+ */
+std::string describeBasicBlock(const common::BasicBlock& bb)
+{
+	std::string ret = "  bb " + bb.getStart().toHexString()
+			+ "-" + bb.getEnd().toHexString() + " preds:";
+	for (auto& p : bb.preds)
+	{
+		ret += " " + p.toHexString();
+	}
+	ret += " succs:";
+	for (auto& s : bb.succs)
+	{
+		ret += " " + s.toHexString();
+	}
+	ret += " calls:";
+	for (auto& c : bb.calls)
+	{
+		ret += " " + c.srcAddr.toHexString() + "->" + c.targetAddr.toHexString();
+	}
+	ret += "\n";
+	for (auto* i : bb.instructions)
+	{
+		ret += "    " + common::Address(i->address).toHexString()
+				+ " " + i->mnemonic + " " + i->op_str + "\n";
+	}
+	return ret;
+}
+
+/**
+ * Describe all the functions from the set, ordered by their descriptions.
+ */
+std::multiset<std::string> describeFunctions(const common::FunctionSet& fs)
+{
+	std::multiset<std::string> ret;
+	for (auto& f : fs)
+	{
+		auto desc = describeFunction(f);
+		for (auto& bb : f.basicBlocks)
+		{
+			desc += describeBasicBlock(bb);
+		}
+		ret.insert(desc);
+	}
+	return ret;
+}
+
+/**
+ * Visitor which checks the order of the calls and describes everything it
+ * gets. Instructions are described right in visitBasicBlock() because they
+ * are valid only during the call if the LLVM IR is not kept.
+ */
+class DescribingVisitor : public DisassemblyVisitor
+{
+	public:
+		void visitFunction(const common::Function& f) override
+		{
+			EXPECT_FALSE(inFunction) << f.getName();
+			inFunction = true;
+			function = f;
+			lastBasicBlock = common::Address();
+			names.push_back(f.getName());
+			description = describeFunction(f);
+		}
+
+		void visitBasicBlock(const common::BasicBlock& bb) override
+		{
+			EXPECT_TRUE(inFunction);
+			EXPECT_TRUE(function.contains(bb.getStart())) << function.getName();
+			if (lastBasicBlock.isDefined())
+			{
+				EXPECT_LT(lastBasicBlock, bb.getStart()) << function.getName();
+			}
+			lastBasicBlock = bb.getStart();
+			++basicBlocks;
+			description += describeBasicBlock(bb);
+		}
+
+		void visitFunctionEnd(const common::Function& f) override
+		{
+			EXPECT_TRUE(inFunction);
+			EXPECT_EQ(function.getStart(), f.getStart());
+			EXPECT_EQ(function.getName(), f.getName());
+			inFunction = false;
+			functions.insert(description);
+		}
+
+		/// Names of the visited functions in the order of visiting.
+		std::vector<std::string> names;
+		/// Descriptions of the visited functions.
+		std::multiset<std::string> functions;
+		/// Number of all the visited basic blocks.
+		std::size_t basicBlocks = 0;
+		/// Visitor is between visitFunction() and visitFunctionEnd().
+		bool inFunction = false;
+
+	private:
+		common::Function function;
+		common::Address lastBasicBlock;
+		std::string description;
+};
+
+} // anonymous namespace
+
+class LlvmPassStepsTests : public Test
+{
+	protected:
+		config::Parameters params;
+
+		void SetUp() override
+		{
+			params.llvmPasses = {
+				"retdec-provider-init",
+				"retdec-decoder",
+				"tbaa",
+				"basicaa",
+				"instcombine",
+				"gvn",
+				"loop-simplify",
+				"retdec-provider-init",
+				"targetlibinfo",
+				"simplifycfg",
+				"globaldce",
+				"early-cse",
+			};
+		}
+};
+
+TEST_F(LlvmPassStepsTests, withoutBudgetEveryPassIsStepInOriginalOrder)
+{
+	auto steps = getLlvmPassSteps(params);
+
+	ASSERT_EQ(params.llvmPasses.size(), steps.size());
+	for (std::size_t i = 0; i < steps.size(); ++i)
+	{
+		EXPECT_FALSE(steps[i].functionGroup);
+		EXPECT_EQ(std::vector<std::string>{params.llvmPasses[i]}, steps[i].passes);
+	}
+}
+
+TEST_F(LlvmPassStepsTests, withSizeLimitFunctionPassesAreGroupedBetweenModulePasses)
+{
+	params.setLlvmPassesFunctionSizeLimit(100);
+
+	auto steps = getLlvmPassSteps(params);
+
+	EXPECT_EQ(
+		"retdec-provider-init\n"
+		"retdec-decoder\n"
+		"tbaa\n"
+		"basicaa\n"
+		"[instcombine gvn loop-simplify]\n"
+		"retdec-provider-init\n"
+		"targetlibinfo\n"
+		"[simplifycfg]\n"
+		"globaldce\n"
+		"[early-cse]\n",
+		toString(steps)
+	);
+}
+
+TEST_F(LlvmPassStepsTests, withTimeLimitFunctionPassesAreGrouped)
+{
+	params.setLlvmPassesFunctionTimeLimit(100);
+
+	auto steps = getLlvmPassSteps(params);
+
+	ASSERT_EQ(10, steps.size());
+	EXPECT_TRUE(steps[4].functionGroup);
+}
+
+TEST_F(LlvmPassStepsTests, analysesAndImmutablePassesStayInModulePassManager)
+{
+	params.setLlvmPassesFunctionSizeLimit(100);
+	params.llvmPasses = {"instcombine", "tbaa", "basicaa", "gvn"};
+
+	auto steps = getLlvmPassSteps(params);
+
+	EXPECT_EQ("[instcombine]\ntbaa\nbasicaa\n[gvn]\n", toString(steps));
+}
+
+TEST_F(LlvmPassStepsTests, unknownPassThrows)
+{
+	params.llvmPasses = {"instcombine", "no-such-pass"};
+
+	EXPECT_THROW(getLlvmPassSteps(params), std::runtime_error);
+}
+
+/**
+ * Decompilation of a small raw x86 code interrupted by a checkpoint right
+ * before the conversion into HLL and resumed from it.
+ */
+class CheckpointTests : public Test
+{
+	protected:
+		fs::path dir;
+
+		void SetUp() override
+		{
+			dir = fs::temp_directory_path() / ("retdec-checkpoint-tests-"
+				+ std::to_string(
+					std::chrono::steady_clock::now().time_since_epoch().count()));
+			fs::create_directories(dir);
+
+			// push ebp; mov ebp, esp; mov eax, 1; add eax, 2; pop ebp; ret
+			std::ofstream input(inputFile(), std::ios::binary);
+			const char code[] = "\x55\x89\xE5\xB8\x01\x00\x00\x00"
+					"\x83\xC0\x02\x5D\xC3";
+			input.write(code, sizeof(code) - 1);
+		}
+
+		void TearDown() override
+		{
+			std::error_code ec;
+			fs::remove_all(dir, ec);
+		}
+
+		std::string inputFile() const
+		{
+			return (dir / "input.bin").string();
+		}
+
+		std::string checkpointFile() const
+		{
+			return (dir / "checkpoint.bc").string();
+		}
+
+		/// Parameters shared by all the runs, without the checkpoint.
+		config::Parameters createParameters() const
+		{
+			config::Parameters params;
+			params.setInputFile(inputFile());
+			params.setOutputFormat("plain");
+			params.setEntryPoint(common::Address(0x1000));
+			params.setSectionVMA(common::Address(0x1000));
+			params.setIsKeepAllFunctions(true);
+			params.setIsDetectStaticCode(false);
+			params.setIsBackendNoTimeVaryingInfo(true);
+			params.setBackendCallInfoObtainer("optim");
+			params.setBackendVarRenamer("readable");
+			params.llvmPasses = {
+				"retdec-provider-init",
+				"retdec-decoder",
+				"retdec-x86-addr-spaces",
+				"retdec-x87-fpu",
+				"retdec-inst-opt",
+				"retdec-stack",
+				"retdec-param-return",
+				"retdec-simple-types",
+				"retdec-remove-asm-instrs",
+				"instcombine",
+				"simplifycfg",
+				"retdec-llvmir2hll",
+			};
+			return params;
+		}
+
+		config::Config createConfig() const
+		{
+			config::Config config;
+			config.architecture.setIsX86();
+			config.architecture.setIsEndianLittle();
+			config.architecture.setBitSize(32);
+			config.fileFormat.setIsRaw();
+			config.fileFormat.setFileClassBits(32);
+			config.parameters = createParameters();
+			return config;
+		}
+};
+
+TEST_F(CheckpointTests, resumedDecompilationHasSameOutputAsUninterruptedOne)
+{
+	auto config = createConfig();
+	std::string uninterrupted;
+	decompile(config, &uninterrupted);
+	ASSERT_FALSE(uninterrupted.empty());
+
+	auto checkpointConfig = createConfig();
+	checkpointConfig.parameters.setCheckpointFile(checkpointFile());
+	std::string checkpointed;
+	decompile(checkpointConfig, &checkpointed);
+	ASSERT_TRUE(fs::exists(checkpointFile()));
+	ASSERT_TRUE(fs::exists(checkpointFile() + ".config.json"));
+	EXPECT_EQ(uninterrupted, checkpointed);
+
+	// Everything but the parameters is loaded from the checkpoint.
+	config::Config resumeConfig;
+	resumeConfig.parameters = createParameters();
+	resumeConfig.parameters.setResumeFile(checkpointFile());
+	std::string resumed;
+	decompile(resumeConfig, &resumed);
+	EXPECT_EQ(uninterrupted, resumed);
+	EXPECT_TRUE(resumeConfig.architecture.isX86());
+}
+
+TEST_F(CheckpointTests, resumeFromMissingCheckpointThrows)
+{
+	auto config = createConfig();
+	config.parameters.setResumeFile(checkpointFile());
+
+	EXPECT_THROW(decompile(config), std::runtime_error);
+}
+
+/**
+ * Disassembly of a small PE file streamed to a visitor.
+ */
+class DisassemblyVisitorTests : public Test
+{
+	protected:
+		fs::path dir;
+
+		void SetUp() override
+		{
+			dir = fs::temp_directory_path() / ("retdec-disassembly-tests-"
+				+ std::to_string(
+					std::chrono::steady_clock::now().time_since_epoch().count()));
+			fs::create_directories(dir);
+
+			std::ofstream input(inputFile(), std::ios::binary);
+			input.write(reinterpret_cast<const char*>(peBytes.data()), peBytes.size());
+		}
+
+		void TearDown() override
+		{
+			std::error_code ec;
+			fs::remove_all(dir, ec);
+		}
+
+		std::string inputFile() const
+		{
+			return (dir / "input.exe").string();
+		}
+};
+
+TEST_F(DisassemblyVisitorTests, functionsAreVisitedInModuleOrderWithOrderedBasicBlocks)
+{
+	DescribingVisitor visitor;
+	auto res = disassemble(inputFile(), visitor);
+	ASSERT_NE(nullptr, res.module);
+	EXPECT_FALSE(visitor.inFunction);
+	ASSERT_FALSE(visitor.names.empty());
+	EXPECT_GT(visitor.basicBlocks, 0u);
+
+	// Visited functions are a subsequence of the module functions.
+	auto it = visitor.names.begin();
+	for (auto& f : res.module->functions())
+	{
+		if (it != visitor.names.end() && f.getName() == *it)
+		{
+			++it;
+		}
+	}
+	EXPECT_EQ(visitor.names.end(), it);
+}
+
+TEST_F(DisassemblyVisitorTests, visitedFunctionsAreSameAsFunctionSet)
+{
+	std::multiset<std::string> expected;
+	{
+		common::FunctionSet fs;
+		auto res = disassemble(inputFile(), &fs);
+		ASSERT_NE(nullptr, res.module);
+		ASSERT_FALSE(fs.empty());
+		// Instructions are owned by the module.
+		expected = describeFunctions(fs);
+	}
+
+	DescribingVisitor visitor;
+	auto res = disassemble(inputFile(), visitor);
+
+	EXPECT_EQ(expected, visitor.functions);
+}
+
+TEST_F(DisassemblyVisitorTests, droppedLlvmIrDoesNotChangeVisitedFunctions)
+{
+	DescribingVisitor keeping;
+	auto kept = disassemble(inputFile(), keeping, true);
+	ASSERT_NE(nullptr, kept.module);
+
+	// Instructions of the later functions are described only after the IR
+	// of the earlier ones is dropped.
+	DescribingVisitor dropping;
+	auto dropped = disassemble(inputFile(), dropping, false);
+	EXPECT_EQ(nullptr, dropped.module);
+	EXPECT_EQ(nullptr, dropped.context);
+
+	EXPECT_EQ(keeping.names, dropping.names);
+	EXPECT_EQ(keeping.functions, dropping.functions);
+}
+
+TEST_F(DisassemblyVisitorTests, fileWhichCannotBeLoadedThrowsWithoutVisiting)
+{
+	DescribingVisitor visitor;
+
+	EXPECT_THROW(
+			disassemble((dir / "missing.exe").string(), visitor, false),
+			std::runtime_error);
+	EXPECT_TRUE(visitor.names.empty());
+}
+
+} // namespace tests
+} // namespace retdec
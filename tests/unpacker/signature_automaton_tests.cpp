@@ -0,0 +1,115 @@
+/**
+* @file tests/unpacker/signature_automaton_tests.cpp
+* @brief Tests for the @c signature_automaton module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/dynamic_buffer.h"
+#include "retdec/unpacker/signature_automaton.h"
+
+using namespace ::testing;
+using namespace retdec::utils;
+
+namespace retdec {
+namespace unpacker {
+namespace tests {
+
+class SignatureAutomatonTests : public Test {};
+
+TEST_F(SignatureAutomatonTests,
+ExactMatchWorks) {
+	Signature sig1 = { 0x40, 0x41, 0x42, 0x43 };
+	Signature sig2 = { 0x38, 0x39, 0x40 };
+	SignatureAutomaton automaton({ { &sig1, 0 }, { &sig2, 0 } });
+	DynamicBuffer matchedBuffer({ 0x38, 0x39, 0x40, 0x41, 0x42, 0x43, 0x44 });
+
+	EXPECT_EQ(1, automaton.match(matchedBuffer, nullptr));
+}
+
+TEST_F(SignatureAutomatonTests,
+FailedMatchWorks) {
+	Signature sig1 = { 0x40, 0x41, 0x42, 0x43 };
+	Signature sig2 = { 0x50, ANY, 0x52 };
+	SignatureAutomaton automaton({ { &sig1, 0 }, { &sig2, 0 } });
+	DynamicBuffer matchedBuffer({ 0x38, 0x39, 0x40, 0x41, 0x42, 0x43, 0x44 });
+
+	EXPECT_EQ(SignatureAutomaton::NO_MATCH, automaton.match(matchedBuffer, nullptr));
+}
+
+TEST_F(SignatureAutomatonTests,
+SignatureAddedFirstWins) {
+	Signature sig1 = { 0x40, ANY, 0x42 };
+	Signature sig2 = { 0x38, 0x39 };
+	Signature sig3 = { 0x38, ANY, 0x40 };
+	SignatureAutomaton automaton({ { &sig1, 5 }, { &sig2, 0 }, { &sig3, 0 } });
+	DynamicBuffer matchedBuffer({ 0x38, 0x39, 0x40, 0x41, 0x42, 0x43, 0x44 });
+
+	EXPECT_EQ(0, automaton.match(matchedBuffer, nullptr));
+}
+
+TEST_F(SignatureAutomatonTests,
+SearchDistanceIsRespected) {
+	Signature sig = { 0x42, 0x43 };
+	SignatureAutomaton automaton1({ { &sig, 5 } });
+	SignatureAutomaton automaton2({ { &sig, 4 } });
+	DynamicBuffer matchedBuffer({ 0x38, 0x39, 0x40, 0x41, 0x42, 0x43, 0x44 });
+
+	EXPECT_EQ(0, automaton1.match(matchedBuffer, nullptr));
+	EXPECT_EQ(SignatureAutomaton::NO_MATCH, automaton2.match(matchedBuffer, nullptr));
+}
+
+TEST_F(SignatureAutomatonTests,
+WildcardBitMatchWorks) {
+	Signature sig = { 0x70, ANYB(0x03, 0xF0), 0x71 };
+	SignatureAutomaton automaton({ { &sig, 0 } });
+	DynamicBuffer okBuffer(std::vector<uint8_t>({ 0x70, 0x73, 0x71 }));
+	DynamicBuffer failBuffer(std::vector<uint8_t>({ 0x70, 0x14, 0x71 }));
+
+	EXPECT_EQ(0, automaton.match(okBuffer, nullptr));
+	EXPECT_EQ(SignatureAutomaton::NO_MATCH, automaton.match(failBuffer, nullptr));
+}
+
+TEST_F(SignatureAutomatonTests,
+SignatureWithoutExactBytesWorks) {
+	Signature sig1 = { 0x50, 0x51 };
+	Signature sig2 = { ANYB(0x02, 0xF0), CAP };
+	SignatureAutomaton automaton({ { &sig1, 0 }, { &sig2, 3 } });
+	DynamicBuffer matchedBuffer({ 0x38, 0x39, 0x42, 0x43, 0x44 });
+
+	DynamicBuffer capturedData;
+	EXPECT_EQ(1, automaton.match(matchedBuffer, &capturedData));
+	EXPECT_EQ(std::vector<uint8_t>({ 0x43 }), capturedData.getBuffer());
+}
+
+TEST_F(SignatureAutomatonTests,
+CaptureWorks) {
+	Signature sig1 = { 0x40, CAP, CAP, 0x43 };
+	Signature sig2 = { 0x62, CAP };
+	SignatureAutomaton automaton({ { &sig1, 0 }, { &sig2, 5 } });
+	DynamicBuffer matchedBuffer1({ 0x40, 0xCC, 0xDD, 0x43, 0x44 });
+	DynamicBuffer matchedBuffer2({ 0x60, 0x61, 0x62, 0xEE, 0x64 });
+
+	DynamicBuffer capturedData1, capturedData2;
+	EXPECT_EQ(0, automaton.match(matchedBuffer1, &capturedData1));
+	EXPECT_EQ(1, automaton.match(matchedBuffer2, &capturedData2));
+	EXPECT_EQ(0xDDCC, capturedData1.read<uint16_t>(0));
+	EXPECT_EQ(std::vector<uint8_t>({ 0xEE }), capturedData2.getBuffer());
+}
+
+TEST_F(SignatureAutomatonTests,
+ZeroPaddingIsMatched) {
+	Signature sig = { 0x41, 0x00, CAP };
+	SignatureAutomaton automaton({ { &sig, 2 } });
+	std::vector<uint8_t> data = { 0x40, 0x41 };
+
+	DynamicBuffer capturedData;
+	EXPECT_EQ(SignatureAutomaton::NO_MATCH, automaton.match(data.data(), data.size(), 3, &capturedData));
+	EXPECT_EQ(0, automaton.match(data.data(), data.size(), 4, &capturedData));
+	EXPECT_EQ(std::vector<uint8_t>({ 0x00 }), capturedData.getBuffer());
+}
+
+} // namespace unpacker
+} // namespace retdec
+} // namespace tests
@@ -0,0 +1,100 @@
+/**
+* @file tests/utils/const_pointee_iterator_tests.cpp
+* @brief Tests for the @c const_pointee_iterator module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/const_pointee_iterator.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c const_pointee_iterator module.
+*/
+class ConstPointeeIteratorTests: public Test {};
+
+TEST_F(ConstPointeeIteratorTests,
+SharedPointersAreDereferencedToSharedPointersToConst) {
+	std::vector<std::shared_ptr<int>> v{std::make_shared<int>(1)};
+	using Iterator = ConstPointeeIterator<
+		std::vector<std::shared_ptr<int>>::const_iterator,
+		std::shared_ptr<const int>
+	>;
+
+	Iterator it(v.cbegin());
+
+	static_assert(std::is_same<decltype(*it), std::shared_ptr<const int>>::value,
+		"pointee must not be modifiable");
+	EXPECT_EQ(v[0], *it);
+}
+
+TEST_F(ConstPointeeIteratorTests,
+UniquePointersAreDereferencedToRawPointersToConst) {
+	std::vector<std::unique_ptr<int>> v;
+	v.push_back(std::make_unique<int>(1));
+	using Iterator = ConstPointeeIterator<
+		std::vector<std::unique_ptr<int>>::const_iterator,
+		const int*
+	>;
+
+	Iterator it(v.cbegin());
+
+	static_assert(std::is_same<decltype(*it), const int*>::value,
+		"pointee must not be modifiable");
+	EXPECT_EQ(v[0].get(), *it);
+}
+
+TEST_F(ConstPointeeIteratorTests,
+IterationVisitsAllElementsInOrder) {
+	std::vector<std::unique_ptr<int>> v;
+	for (int i = 0; i < 3; ++i) {
+		v.push_back(std::make_unique<int>(i));
+	}
+	using Iterator = ConstPointeeIterator<
+		std::vector<std::unique_ptr<int>>::const_iterator,
+		const int*
+	>;
+	Iterator begin(v.cbegin()), end(v.cend());
+
+	std::vector<int> values;
+	for (auto it = begin; it != end; ++it) {
+		values.push_back(**it);
+	}
+
+	EXPECT_EQ(std::vector<int>({0, 1, 2}), values);
+}
+
+TEST_F(ConstPointeeIteratorTests,
+IteratorSupportsRandomAccess) {
+	std::vector<std::unique_ptr<int>> v;
+	for (int i = 0; i < 3; ++i) {
+		v.push_back(std::make_unique<int>(i));
+	}
+	using Iterator = ConstPointeeIterator<
+		std::vector<std::unique_ptr<int>>::const_iterator,
+		const int*
+	>;
+	Iterator begin(v.cbegin()), end(v.cend());
+
+	EXPECT_EQ(3, end - begin);
+	EXPECT_TRUE(begin < end);
+	EXPECT_EQ(2, *begin[2]);
+	EXPECT_EQ(2, **(end - 1));
+	EXPECT_EQ(1, **(1 + begin));
+	EXPECT_EQ(end, std::next(begin, 3));
+	EXPECT_EQ(begin, std::prev(end, 3));
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
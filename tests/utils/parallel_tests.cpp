@@ -0,0 +1,92 @@
+/**
+* @file tests/utils/parallel_tests.cpp
+* @brief Tests for the @c parallel module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/parallel.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c parallel module.
+*/
+class ParallelTests: public Test {
+protected:
+	virtual void TearDown() override {
+		setMaxThreadCount(0);
+	}
+
+	/// Run parallelFor() and return IDs of threads which did the work.
+	std::set<std::thread::id> runAndGetThreads(std::size_t count) {
+		std::mutex mutex;
+		std::set<std::thread::id> threads;
+		parallelFor(count, [&](std::size_t) {
+			std::lock_guard<std::mutex> lock(mutex);
+			threads.insert(std::this_thread::get_id());
+		});
+		return threads;
+	}
+};
+
+TEST_F(ParallelTests,
+ParallelForCallsFunctionForEveryIndexOnce) {
+	setMaxThreadCount(8);
+	std::vector<int> calls(1000, 0);
+	parallelFor(calls.size(), [&](std::size_t i) {
+		++calls[i];
+	});
+
+	EXPECT_EQ(std::vector<int>(1000, 1), calls);
+}
+
+TEST_F(ParallelTests,
+ParallelForDoesNothingForNoIndexes) {
+	bool called = false;
+	parallelFor(0, [&](std::size_t) {
+		called = true;
+	});
+
+	EXPECT_FALSE(called);
+}
+
+TEST_F(ParallelTests,
+ParallelForRunsOnlyInCallingThreadWhenThreadingIsTurnedOff) {
+	setMaxThreadCount(1);
+	auto threads = runAndGetThreads(1000);
+
+	ASSERT_EQ(1, threads.size());
+	EXPECT_EQ(std::this_thread::get_id(), *threads.begin());
+}
+
+TEST_F(ParallelTests,
+ParallelForUsesAtMostMaxThreadCountThreads) {
+	setMaxThreadCount(3);
+	auto threads = runAndGetThreads(1000);
+
+	EXPECT_LE(threads.size(), 3);
+}
+
+TEST_F(ParallelTests,
+MaxThreadCountIsAtLeastOne) {
+	setMaxThreadCount(0);
+	EXPECT_GE(getMaxThreadCount(), 1);
+
+	setMaxThreadCount(5);
+	EXPECT_EQ(5, getMaxThreadCount());
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,107 @@
+/**
+* @file tests/yaracpp/yara_rules_cache_tests.cpp
+* @brief Tests for the @c yara_rules_cache module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <chrono>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/yaracpp/yara_rules_cache.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace yaracpp {
+namespace tests {
+
+class YaraRulesCacheTests : public Test
+{
+	protected:
+		fs::path dir;
+
+		void SetUp() override
+		{
+			dir = fs::temp_directory_path() / ("retdec-yara-rules-cache-tests-"
+					+ std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+			fs::create_directories(dir);
+		}
+
+		void TearDown() override
+		{
+			std::error_code ec;
+			fs::remove_all(dir, ec);
+		}
+
+		std::string writeRules(const std::string &name, const std::string &rules)
+		{
+			const auto path = (dir / name).string();
+			std::ofstream(path) << rules;
+			return path;
+		}
+};
+
+TEST_F(YaraRulesCacheTests, SameFilesAreCompiledOnlyOnce)
+{
+	const auto one = writeRules("one.yar", "rule one { strings: $a = \"one\" condition: $a }\n");
+	const auto two = writeRules("two.yar", "rule two { strings: $a = \"two\" condition: $a }\n");
+	YaraRulesCache cache;
+
+	const auto *first = cache.getDetector({{one, "a"}});
+	ASSERT_NE(nullptr, first);
+	EXPECT_EQ(first, cache.getDetector({{one, "a"}}));
+	EXPECT_NE(first, cache.getDetector({{one, "b"}}));
+	EXPECT_NE(first, cache.getDetector({{one, "a"}, {two, "b"}}));
+}
+
+TEST_F(YaraRulesCacheTests, CompiledRulesAreSharedByThreads)
+{
+	const auto one = writeRules("one.yar", "rule one { strings: $a = \"one\" condition: $a }\n");
+	const std::string data = "this is the one";
+	YaraRulesCache cache;
+
+	std::vector<const YaraDetector*> detectors(8, nullptr);
+	std::vector<int> detected(detectors.size(), 0);
+	std::vector<std::thread> threads;
+	for (std::size_t i = 0; i < detectors.size(); ++i)
+	{
+		threads.emplace_back([&, i]() {
+			detectors[i] = cache.getDetector({{one, ""}});
+			std::vector<YaraRule> rules;
+			std::vector<YaraRule> undetected;
+			if (detectors[i] && detectors[i]->analyze(
+					reinterpret_cast<const std::uint8_t*>(data.data()),
+					data.size(), rules, undetected))
+			{
+				detected[i] = static_cast<int>(rules.size());
+			}
+		});
+	}
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+
+	for (std::size_t i = 0; i < detectors.size(); ++i)
+	{
+		EXPECT_NE(nullptr, detectors[i]);
+		EXPECT_EQ(detectors[0], detectors[i]);
+		EXPECT_EQ(1, detected[i]);
+	}
+}
+
+TEST_F(YaraRulesCacheTests, BrokenFilesGiveNoDetector)
+{
+	const auto broken = writeRules("broken.yar", "rule broken { condition: \n");
+	YaraRulesCache cache;
+
+	EXPECT_EQ(nullptr, cache.getDetector({{broken, ""}}));
+	EXPECT_EQ(nullptr, cache.getDetector({{broken, ""}}));
+}
+
+} // namespace tests
+} // namespace yaracpp
+} // namespace retdec
@@ -0,0 +1,186 @@
+/**
+* @file tests/yaracpp/yara_scan_session_tests.cpp
+* @brief Tests for the @c yara_scan_session module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/yaracpp/yara_rules_cache.h"
+#include "retdec/yaracpp/yara_scan_session.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace yaracpp {
+namespace tests {
+
+namespace {
+
+const std::string scannedText = "header MAGIC_ONE body MAGIC_TWO footer";
+
+std::vector<std::string> getNames(const std::vector<YaraRule> &rules)
+{
+	std::vector<std::string> names;
+	for (const auto &rule : rules)
+	{
+		names.push_back(rule.getName());
+	}
+	std::sort(names.begin(), names.end());
+	return names;
+}
+
+} // anonymous namespace
+
+class YaraScanSessionTests : public Test
+{
+	protected:
+		fs::path dir;
+		std::vector<std::uint8_t> data;
+
+		void SetUp() override
+		{
+			dir = fs::temp_directory_path() / ("retdec-yara-scan-session-tests-"
+					+ std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+			fs::create_directories(dir);
+			data.assign(scannedText.begin(), scannedText.end());
+		}
+
+		void TearDown() override
+		{
+			std::error_code ec;
+			fs::remove_all(dir, ec);
+		}
+
+		std::string writeRules(const std::string &name, const std::string &rules)
+		{
+			const auto path = (dir / name).string();
+			std::ofstream(path) << rules;
+			return path;
+		}
+
+		std::string oneRules()
+		{
+			return writeRules("one.yar",
+				"rule one { strings: $a = \"MAGIC_ONE\" condition: $a }\n"
+				"rule missing { strings: $a = \"MAGIC_NONE\" condition: $a }\n");
+		}
+
+		std::string twoRules()
+		{
+			return writeRules("two.yar",
+				"rule two { strings: $a = \"MAGIC_TWO\" condition: $a }\n");
+		}
+
+		std::string brokenRules()
+		{
+			return writeRules("broken.yar", "rule broken { condition: \n");
+		}
+};
+
+TEST_F(YaraScanSessionTests, SetsGetRulesOnlyFromTheirFiles)
+{
+	const auto one = oneRules();
+	const auto two = twoRules();
+	YaraScanSession session(data.data(), data.size());
+	const auto first = session.addRuleSet({one});
+	const auto second = session.addRuleSet({two});
+	const auto both = session.addRuleSet({one, two});
+
+	EXPECT_TRUE(session.scan());
+	EXPECT_EQ(std::vector<std::string>({"one"}), getNames(session.getDetectedRules(first)));
+	EXPECT_EQ(std::vector<std::string>({"two"}), getNames(session.getDetectedRules(second)));
+	EXPECT_EQ(std::vector<std::string>({"one", "two"}), getNames(session.getDetectedRules(both)));
+}
+
+TEST_F(YaraScanSessionTests, SameRuleNameInTwoFilesIsKeptApart)
+{
+	const auto first = writeRules("first.yar",
+		"rule same { strings: $a = \"MAGIC_ONE\" condition: $a }\n");
+	const auto second = writeRules("second.yar",
+		"rule same { strings: $a = \"MAGIC_NONE\" condition: $a }\n");
+	YaraScanSession session(data.data(), data.size());
+	const auto firstSet = session.addRuleSet({first});
+	const auto secondSet = session.addRuleSet({second}, true);
+
+	EXPECT_TRUE(session.scan());
+	EXPECT_EQ(std::vector<std::string>({"same"}), getNames(session.getDetectedRules(firstSet)));
+	EXPECT_TRUE(session.getDetectedRules(secondSet).empty());
+	EXPECT_EQ(std::vector<std::string>({"same"}), getNames(session.getUndetectedRules(secondSet)));
+}
+
+TEST_F(YaraScanSessionTests, UndetectedRulesAreStoredOnlyForSetsWhichWantThem)
+{
+	const auto one = oneRules();
+	YaraScanSession session(data.data(), data.size());
+	const auto all = session.addRuleSet({one}, true);
+	const auto detectedOnly = session.addRuleSet({one});
+
+	EXPECT_TRUE(session.scan());
+	EXPECT_EQ(std::vector<std::string>({"missing"}), getNames(session.getUndetectedRules(all)));
+	EXPECT_TRUE(session.getUndetectedRules(detectedOnly).empty());
+	EXPECT_EQ(std::vector<std::string>({"one"}), getNames(session.getDetectedRules(detectedOnly)));
+}
+
+TEST_F(YaraScanSessionTests, BrokenRuleFileDoesNotBreakOtherFiles)
+{
+	const auto one = oneRules();
+	const auto two = twoRules();
+	const auto broken = brokenRules();
+	YaraScanSession session(data.data(), data.size());
+	const auto first = session.addRuleSet({one});
+	const auto mixed = session.addRuleSet({broken, two});
+
+	EXPECT_FALSE(session.scan());
+	EXPECT_EQ(std::vector<std::string>({"one"}), getNames(session.getDetectedRules(first)));
+	EXPECT_EQ(std::vector<std::string>({"two"}), getNames(session.getDetectedRules(mixed)));
+}
+
+TEST_F(YaraScanSessionTests, BrokenRuleFileDoesNotBreakOtherFilesWithCache)
+{
+	const auto one = oneRules();
+	const auto broken = brokenRules();
+	YaraRulesCache cache;
+	YaraScanSession session(data.data(), data.size(), &cache);
+	const auto first = session.addRuleSet({one});
+	session.addRuleSet({broken});
+
+	EXPECT_FALSE(session.scan());
+	EXPECT_EQ(std::vector<std::string>({"one"}), getNames(session.getDetectedRules(first)));
+}
+
+TEST_F(YaraScanSessionTests, SetsAddedLaterAreScannedByNextScan)
+{
+	const auto one = oneRules();
+	const auto two = twoRules();
+	YaraRulesCache cache;
+	YaraScanSession session(data.data(), data.size(), &cache);
+	const auto first = session.addRuleSet({one});
+	EXPECT_TRUE(session.scan());
+	EXPECT_TRUE(session.isScanned(first));
+
+	const auto second = session.addRuleSet({two, one});
+	EXPECT_FALSE(session.isScanned(second));
+	EXPECT_TRUE(session.scan());
+	EXPECT_TRUE(session.isScanned(second));
+
+	// The first set is not scanned again.
+	EXPECT_EQ(std::vector<std::string>({"one"}), getNames(session.getDetectedRules(first)));
+	EXPECT_EQ(std::vector<std::string>({"one", "two"}), getNames(session.getDetectedRules(second)));
+	EXPECT_TRUE(session.scan());
+}
+
+TEST_F(YaraScanSessionTests, UnknownSetIsNotScanned)
+{
+	YaraScanSession session(data.data(), data.size());
+	EXPECT_TRUE(session.scan());
+	EXPECT_FALSE(session.isScanned(0));
+}
+
+} // namespace tests
+} // namespace yaracpp
+} // namespace retdec